@@ -72,6 +72,9 @@ std::ostream &operator<<(std::ostream &os, MetaServerOpType optype) {
     case MetaServerOpType::UpdateVolumeExtent:
         os << "UpdateVolumeExtent";
         break;
+    case MetaServerOpType::BatchUpdateInodeAttr:
+        os << "BatchUpdateInodeAttr";
+        break;
     default:
         os << "Unknow opType";
     }
@@ -50,6 +50,8 @@ DEFINE_bool(enableCto, true, "acheieve cto consistency");
 DEFINE_bool(useFakeS3, false,
             "Use fake s3 to inject more metadata for testing metaserver");
 DEFINE_bool(supportKVcache, false, "use kvcache to speed up sharing");
+DEFINE_bool(flushInodeAttrDelta, false,
+            "flush attributes changed by writes as deltas in batch");
 
 void InitMdsOption(Configuration *conf, MdsOption *mdsOpt) {
     conf->GetValueFatalIfFail("mdsOpt.mdsMaxRetryMS", &mdsOpt->mdsMaxRetryMS);
@@ -293,6 +295,10 @@ void InitFuseClientOption(Configuration *conf, FuseClientOption *clientOption) {
     conf->GetValueFatalIfFail("fuseClient.disableXattr",
                               &clientOption->disableXattr);
     conf->GetValueFatalIfFail("fuseClient.cto", &FLAGS_enableCto);
+    LOG_IF(WARNING, !conf->GetBoolValue("fuseClient.flushInodeAttrDelta",
+                                        &FLAGS_flushInodeAttrDelta))
+        << "Not found `fuseClient.flushInodeAttrDelta` in conf, use default "
+           "value `" << std::boolalpha << FLAGS_flushInodeAttrDelta << '`';
     conf->GetValueFatalIfFail("fuseClient.downloadMaxRetryTimes",
                               &clientOption->downloadMaxRetryTimes);
     conf->GetValueFatalIfFail("fuseClient.warmupThreadsNum",
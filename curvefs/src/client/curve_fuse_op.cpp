@@ -45,6 +45,7 @@
 #include "curvefs/src/client/warmup/warmup_manager.h"
 
 using ::curve::common::Configuration;
+using ::curvefs::client::CachedDataRef;
 using ::curvefs::client::CURVEFS_ERROR;
 using ::curvefs::client::FuseClient;
 using ::curvefs::client::FuseS3Client;
@@ -85,6 +86,38 @@ void EnableSplice(struct fuse_conn_info* conn) {
     }
 }
 
+// Reply the read with the cached pages directly, the pages are spliced
+// into the fuse device without being copied into an intermediate buffer.
+// Return false if the range is not entirely cached, the caller should
+// fallback to the copy path then.
+bool ReplyReadZeroCopy(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
+                       struct fuse_file_info* fi) {
+    CachedDataRef ref;
+    CURVEFS_ERROR ret =
+        g_ClientInstance->FuseOpReadZeroCopy(req, ino, size, off, fi, &ref);
+    if (ret != CURVEFS_ERROR::OK || ref.iov.empty()) {
+        return false;
+    }
+
+    size_t count = ref.iov.size();
+    std::vector<char> storage(sizeof(struct fuse_bufvec) +
+                              (count - 1) * sizeof(struct fuse_buf));
+    auto* bufvec = reinterpret_cast<struct fuse_bufvec*>(storage.data());
+    bufvec->count = count;
+    bufvec->idx = 0;
+    bufvec->off = 0;
+    for (size_t i = 0; i < count; i++) {
+        bufvec->buf[i].size = ref.iov[i].iov_len;
+        bufvec->buf[i].mem = ref.iov[i].iov_base;
+    }
+
+    // the pages are shared by the read cache, so they are not gifted
+    // to the kernel (no FUSE_BUF_SPLICE_MOVE), and ref keeps them alive
+    // until the reply is sent
+    fuse_reply_data(req, bufvec, static_cast<enum fuse_buf_copy_flags>(0));
+    return true;
+}
+
 int GetFsInfo(const char* fsName, FsInfo* fsInfo) {
     MdsClientImpl mdsClient;
     MDSBaseClient mdsBase;
@@ -477,6 +510,11 @@ void FuseOpRead(fuse_req_t req, fuse_ino_t ino, size_t size, off_t off,
                 struct fuse_file_info *fi) {
     InflightGuard guard(&g_clientOpMetric->opRead.inflightOpNum);
     LatencyUpdater updater(&g_clientOpMetric->opRead.latency);
+    if (g_fuseClientOption->enableFuseSplice &&
+        ReplyReadZeroCopy(req, ino, size, off, fi)) {
+        return;
+    }
+
     std::unique_ptr<char[]> buffer(new char[size]);
     size_t rSize = 0;
     CURVEFS_ERROR ret = g_ClientInstance->FuseOpRead(req, ino, size, off, fi,
@@ -141,6 +141,15 @@ class FuseClient {
                                      struct fuse_file_info* fi, char* buffer,
                                      size_t* rSize) = 0;
 
+    // read by referencing the cached pages, return NOTSUPPORT if the data
+    // can not be referenced and FuseOpRead should be used instead
+    virtual CURVEFS_ERROR FuseOpReadZeroCopy(fuse_req_t req, fuse_ino_t ino,
+                                             size_t size, off_t off,
+                                             struct fuse_file_info* fi,
+                                             CachedDataRef* ref) {
+        return CURVEFS_ERROR::NOTSUPPORT;
+    }
+
     virtual CURVEFS_ERROR FuseOpLookup(fuse_req_t req, fuse_ino_t parent,
                                        const char* name, fuse_entry_param* e);
 
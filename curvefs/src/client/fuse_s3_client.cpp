@@ -265,6 +265,49 @@ CURVEFS_ERROR FuseS3Client::FuseOpRead(fuse_req_t req, fuse_ino_t ino,
     return ret;
 }
 
+CURVEFS_ERROR FuseS3Client::FuseOpReadZeroCopy(fuse_req_t req, fuse_ino_t ino,
+                                               size_t size, off_t off,
+                                               struct fuse_file_info *fi,
+                                               CachedDataRef *ref) {
+    // leave direct io and its alignment check to FuseOpRead
+    if (fi->flags & O_DIRECT) {
+        return CURVEFS_ERROR::NOTSUPPORT;
+    }
+
+    uint64_t start = butil::cpuwide_time_us();
+    std::shared_ptr<InodeWrapper> inodeWrapper;
+    CURVEFS_ERROR ret = inodeManager_->GetInode(ino, inodeWrapper);
+    if (ret != CURVEFS_ERROR::OK) {
+        LOG(ERROR) << "inodeManager get inode fail, ret = " << ret
+                   << ", inodeid = " << ino;
+        return ret;
+    }
+    uint64_t fileSize = inodeWrapper->GetLength();
+    if (fileSize <= off) {
+        return CURVEFS_ERROR::NOTSUPPORT;
+    }
+    size_t len = fileSize < off + size ? fileSize - off : size;
+
+    if (!s3Adaptor_->ReadZeroCopy(ino, off, len, ref)) {
+        return CURVEFS_ERROR::NOTSUPPORT;
+    }
+
+    if (fsMetric_.get() != nullptr) {
+        fsMetric_->userRead.bps.count << ref->len;
+        fsMetric_->userRead.qps.count << 1;
+        uint64_t duration = butil::cpuwide_time_us() - start;
+        fsMetric_->userRead.latency << duration;
+        fsMetric_->userReadIoSize.set_value(ref->len);
+    }
+
+    ::curve::common::UniqueLock lgGuard = inodeWrapper->GetUniqueLock();
+    inodeWrapper->UpdateTimestampLocked(kAccessTime);
+    inodeManager_->ShipToFlush(inodeWrapper);
+
+    VLOG(9) << "read zero copy end, read size = " << ref->len;
+    return CURVEFS_ERROR::OK;
+}
+
 CURVEFS_ERROR FuseS3Client::FuseOpCreate(fuse_req_t req, fuse_ino_t parent,
                                          const char *name, mode_t mode,
                                          struct fuse_file_info *fi,
@@ -87,6 +87,11 @@ class FuseS3Client : public FuseClient {
         char *buffer,
         size_t *rSize) override;
 
+    CURVEFS_ERROR FuseOpReadZeroCopy(fuse_req_t req,
+        fuse_ino_t ino, size_t size, off_t off,
+        struct fuse_file_info *fi,
+        CachedDataRef *ref) override;
+
     CURVEFS_ERROR FuseOpCreate(fuse_req_t req, fuse_ino_t parent,
         const char *name, mode_t mode, struct fuse_file_info *fi,
         fuse_entry_param *e) override;
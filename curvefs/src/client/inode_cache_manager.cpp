@@ -27,7 +27,9 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <set>
 #include <utility>
+#include <vector>
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/client/error_code.h"
 #include "curvefs/src/client/inode_wrapper.h"
@@ -39,6 +41,7 @@ namespace curvefs {
 namespace client {
 namespace common {
 DECLARE_bool(enableCto);
+DECLARE_bool(flushInodeAttrDelta);
 }  // namespace common
 }  // namespace client
 }  // namespace curvefs
@@ -48,6 +51,7 @@ namespace client {
 
 using NameLockGuard = ::curve::common::GenericNameLockGuard<Mutex>;
 using curvefs::client::common::FLAGS_enableCto;
+using curvefs::client::common::FLAGS_flushInodeAttrDelta;
 
 class TrimICacheAsyncDone : public MetaServerClientDone {
  public:
@@ -392,12 +396,83 @@ void InodeCacheManagerImpl::FlushAll() {
     }
 }
 
+namespace {
+class BatchUpdateInodeAttrAsyncDone : public MetaServerClientDone {
+ public:
+    explicit BatchUpdateInodeAttrAsyncDone(
+        std::vector<std::shared_ptr<InodeWrapper>> inodes)
+        : inodes_(std::move(inodes)) {}
+
+    void Run() override {
+        std::unique_ptr<BatchUpdateInodeAttrAsyncDone> self_guard(this);
+        MetaStatusCode ret = GetStatusCode();
+        for (const auto &inode : inodes_) {
+            inode->FinishAttrDelta(ret);
+        }
+    }
+
+ private:
+    std::vector<std::shared_ptr<InodeWrapper>> inodes_;
+};
+}  // namespace
+
+void InodeCacheManagerImpl::FlushInodeAttrDelta(
+    std::map<uint64_t, std::shared_ptr<InodeWrapper>> *inodes) {
+    if (inodes->empty()) {
+        return;
+    }
+
+    std::set<uint64_t> inodeIds;
+    for (const auto &it : *inodes) {
+        inodeIds.emplace(it.first);
+    }
+
+    // group inodes by partition and batch limit, the left inodes
+    // will be flushed one by one if failed
+    uint32_t fsId = inodes->begin()->second->GetFsId();
+    std::vector<std::vector<uint64_t>> inodeGroups;
+    if (!metaClient_->SplitRequestInodes(fsId, inodeIds, &inodeGroups)) {
+        LOG(WARNING) << "Split inodes failed, fall back to flush one by one";
+        return;
+    }
+
+    for (const auto &group : inodeGroups) {
+        std::vector<InodeAttrDelta> deltas;
+        std::vector<std::shared_ptr<InodeWrapper>> taken;
+        for (auto inodeId : group) {
+            auto iter = inodes->find(inodeId);
+            if (iter == inodes->end()) {
+                continue;
+            }
+
+            InodeAttrDelta delta;
+            curve::common::UniqueLock ulk = iter->second->GetUniqueLock();
+            if (iter->second->TakeAttrDeltaLocked(&delta)) {
+                deltas.emplace_back(std::move(delta));
+                taken.emplace_back(std::move(iter->second));
+                inodes->erase(iter);
+            }
+        }
+
+        if (deltas.empty()) {
+            continue;
+        }
+
+        VLOG(9) << "Flush " << deltas.size() << " inode attr deltas in batch";
+        metaClient_->BatchUpdateInodeAttrAsync(
+            fsId, deltas, new BatchUpdateInodeAttrAsyncDone(std::move(taken)));
+    }
+}
+
 void InodeCacheManagerImpl::FlushInodeOnce() {
     std::map<uint64_t, std::shared_ptr<InodeWrapper>> temp_;
     {
         curve::common::LockGuard lg(dirtyMapMutex_);
         temp_.swap(dirtyMap_);
     }
+    if (FLAGS_flushInodeAttrDelta) {
+        FlushInodeAttrDelta(&temp_);
+    }
     for (auto it = temp_.begin(); it != temp_.end(); it++) {
         curve::common::UniqueLock ulk = it->second->GetUniqueLock();
         it->second->Async(nullptr, true);
@@ -292,6 +292,10 @@ class InodeCacheManagerImpl : public InodeCacheManager,
  private:
     virtual void FlushInodeBackground();
     void TrimIcache(uint64_t trimSize);
+    // Flush inodes which only changed by writes as deltas in batch,
+    // flushed inodes are removed from |inodes|
+    void FlushInodeAttrDelta(
+        std::map<uint64_t, std::shared_ptr<InodeWrapper>> *inodes);
     CURVEFS_ERROR RefreshData(std::shared_ptr<InodeWrapper> &inode,  // NOLINT
                               bool streaming = true);
     bool OpenInodeCached(uint64_t inodeId);
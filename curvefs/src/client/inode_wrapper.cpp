@@ -581,6 +581,64 @@ void InodeWrapper::AsyncS3(MetaServerClientDone *done, bool internal) {
     }
 }
 
+bool InodeWrapper::TakeAttrDeltaLocked(InodeAttrDelta *delta) {
+    if (inode_.type() != FsFileType::TYPE_S3 ||
+        (!dirty_ && s3ChunkInfoAdd_.empty())) {
+        return false;
+    }
+
+    InodeAttr others = dirtyAttr_;
+    others.clear_length();
+    others.clear_ctime();
+    others.clear_ctime_ns();
+    others.clear_mtime();
+    others.clear_mtime_ns();
+    others.clear_atime();
+    others.clear_atime_ns();
+    if (others.ByteSizeLong() != 0) {
+        return false;
+    }
+
+    LockSyncingInode();
+    LockSyncingS3ChunkInfo();
+    delta->set_inodeid(inode_.inodeid());
+
+#define TAKE_DIRTY_ATTR(param)                  \
+    if (dirtyAttr_.has_##param()) {             \
+        delta->set_##param(dirtyAttr_.param()); \
+    }
+
+    TAKE_DIRTY_ATTR(length)
+    TAKE_DIRTY_ATTR(ctime)
+    TAKE_DIRTY_ATTR(ctime_ns)
+    TAKE_DIRTY_ATTR(mtime)
+    TAKE_DIRTY_ATTR(mtime_ns)
+    TAKE_DIRTY_ATTR(atime)
+    TAKE_DIRTY_ATTR(atime_ns)
+
+#undef TAKE_DIRTY_ATTR
+
+    if (!s3ChunkInfoAdd_.empty()) {
+        *delta->mutable_s3chunkinfoadd() = std::move(s3ChunkInfoAdd_);
+    }
+    dirtyAttr_.Clear();
+    ClearS3ChunkInfoAdd();
+    return true;
+}
+
+void InodeWrapper::FinishAttrDelta(MetaStatusCode code) {
+    if (code != MetaStatusCode::OK && code != MetaStatusCode::NOT_FOUND) {
+        LOG(ERROR) << "metaClient_ BatchUpdateInodeAttr failed, "
+                   << "MetaStatusCode: " << code
+                   << ", MetaStatusCode_Name: " << MetaStatusCode_Name(code)
+                   << ", inodeid: " << inode_.inodeid();
+        MarkInodeError();
+    }
+    ClearDirty();
+    ReleaseSyncingInode();
+    ReleaseSyncingS3ChunkInfo();
+}
+
 CURVEFS_ERROR InodeWrapper::RefreshVolumeExtent() {
     VolumeExtentList extents;
     auto st = metaClient_->GetVolumeExtent(inode_.fsid(), inode_.inodeid(),
@@ -44,6 +44,7 @@
 using ::curvefs::metaserver::Inode;
 using ::curvefs::metaserver::S3ChunkInfoList;
 using ::curvefs::metaserver::S3ChunkInfo;
+using ::curvefs::metaserver::InodeAttrDelta;
 
 namespace curvefs {
 namespace client {
@@ -232,6 +233,15 @@ class InodeWrapper : public std::enable_shared_from_this<InodeWrapper> {
 
     void AsyncS3(MetaServerClientDone *done, bool internal = false);
 
+    // Take dirty length, timestamps and s3 chunk info as a delta which
+    // metaserver merges into inode without reading it, return false if
+    // inode has nothing to flush or other attributes are dirty.
+    // The syncing locks are held until `FinishAttrDelta()` is invoked.
+    // REQUIRES: |mtx_| is held
+    bool TakeAttrDeltaLocked(InodeAttrDelta *delta);
+
+    void FinishAttrDelta(MetaStatusCode code);
+
     CURVEFS_ERROR SyncAttr(bool internal = false);
 
     void AsyncFlushAttr(MetaServerClientDone *done, bool internal);
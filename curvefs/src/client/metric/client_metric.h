@@ -85,6 +85,7 @@ struct MetaServerClientMetric {
     InterfaceMetric updateInode;
     InterfaceMetric deleteInode;
     InterfaceMetric appendS3ChunkInfo;
+    InterfaceMetric batchUpdateInodeAttr;
 
     // tnx
     InterfaceMetric prepareRenameTx;
@@ -105,6 +106,7 @@ struct MetaServerClientMetric {
           updateInode(prefix, "updateInode"),
           deleteInode(prefix, "deleteInode"),
           appendS3ChunkInfo(prefix, "appendS3ChunkInfo"),
+          batchUpdateInodeAttr(prefix, "batchUpdateInodeAttr"),
           prepareRenameTx(prefix, "prepareRenameTx"),
           updateVolumeExtent(prefix, "updateVolumeExtent"),
           getVolumeExtent(prefix, "getVolumeExtent") {}
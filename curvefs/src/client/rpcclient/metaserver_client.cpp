@@ -48,6 +48,8 @@ using curvefs::metaserver::BatchGetInodeAttrRequest;
 using curvefs::metaserver::BatchGetInodeAttrResponse;
 using curvefs::metaserver::BatchGetXAttrRequest;
 using curvefs::metaserver::BatchGetXAttrResponse;
+using curvefs::metaserver::BatchUpdateInodeAttrRequest;
+using curvefs::metaserver::BatchUpdateInodeAttrResponse;
 
 namespace curvefs {
 namespace client {
@@ -63,6 +65,7 @@ using GetInodeExcutor = TaskExecutor;
 using BatchGetInodeAttrExcutor = TaskExecutor;
 using BatchGetXAttrExcutor = TaskExecutor;
 using GetOrModifyS3ChunkInfoExcutor = TaskExecutor;
+using BatchUpdateInodeAttrExcutor = TaskExecutor;
 using UpdateVolumeExtentExecutor = TaskExecutor;
 using GetVolumeExtentExecutor = TaskExecutor;
 
@@ -993,6 +996,89 @@ void MetaServerClientImpl::UpdateInodeWithOutNlinkAsync(
     UpdateInodeAsync(request, done);
 }
 
+class BatchUpdateInodeAttrRpcDone : public MetaServerClientRpcDoneBase {
+ public:
+    using MetaServerClientRpcDoneBase::MetaServerClientRpcDoneBase;
+
+    void Run() override;
+    BatchUpdateInodeAttrResponse response;
+};
+
+void BatchUpdateInodeAttrRpcDone::Run() {
+    std::unique_ptr<BatchUpdateInodeAttrRpcDone> self_guard(this);
+    brpc::ClosureGuard done_guard(done_);
+    auto taskCtx = done_->GetTaskExcutor()->GetTaskCxt();
+    auto& cntl = taskCtx->cntl_;
+    auto metaCache = done_->GetTaskExcutor()->GetMetaCache();
+    if (cntl.Failed()) {
+        metric_->batchUpdateInodeAttr.eps.count << 1;
+        LOG(WARNING) << "BatchUpdateInodeAttr Failed, errorcode = "
+                     << cntl.ErrorCode()
+                     << ", error content: " << cntl.ErrorText()
+                     << ", log id: " << cntl.log_id();
+        done_->SetRetCode(-cntl.ErrorCode());
+        return;
+    }
+
+    MetaStatusCode ret = response.statuscode();
+    if (ret != MetaStatusCode::OK) {
+        LOG(WARNING) << "BatchUpdateInodeAttr failed"
+                     << ", errcode = " << ret
+                     << ", errmsg = " << MetaStatusCode_Name(ret);
+    } else if (response.has_appliedindex()) {
+        metaCache->UpdateApplyIndex(taskCtx->target.groupID,
+                                    response.appliedindex());
+    } else {
+        LOG(WARNING) << "BatchUpdateInodeAttr ok,"
+                     << " but applyIndex not set in response:"
+                     << response.DebugString();
+        done_->SetRetCode(-1);
+        return;
+    }
+
+    VLOG(6) << "BatchUpdateInodeAttr done, "
+            << "response: " << response.DebugString();
+    done_->SetRetCode(ret);
+}
+
+void MetaServerClientImpl::BatchUpdateInodeAttrAsync(
+    uint32_t fsId,
+    const std::vector<InodeAttrDelta>& deltas,
+    MetaServerClientDone* done) {
+    if (deltas.empty()) {
+        done->SetMetaStatusCode(MetaStatusCode::OK);
+        done->Run();
+        return;
+    }
+
+    auto task = AsyncRPCTask {
+        metric_.batchUpdateInodeAttr.qps.count << 1;
+
+        BatchUpdateInodeAttrRequest request;
+        request.set_poolid(poolID);
+        request.set_copysetid(copysetID);
+        request.set_partitionid(partitionID);
+        request.set_fsid(fsId);
+        *request.mutable_delta() = { deltas.begin(), deltas.end() };
+
+        auto *rpcDone = new BatchUpdateInodeAttrRpcDone(taskExecutorDone,
+                                                        &metric_);
+        curvefs::metaserver::MetaServerService_Stub stub(channel);
+        stub.BatchUpdateInodeAttr(cntl, &request, &rpcDone->response,
+                                  rpcDone);
+        return MetaStatusCode::OK;
+    };
+
+    auto taskCtx = std::make_shared<TaskContext>(
+        MetaServerOpType::BatchUpdateInodeAttr, task, fsId,
+        deltas.front().inodeid());
+    auto excutor = std::make_shared<BatchUpdateInodeAttrExcutor>(opt_,
+        metaCache_, channelManager_, std::move(taskCtx));
+    TaskExecutorDone *taskDone = new TaskExecutorDone(
+        excutor, done);
+    excutor->DoAsyncRPCTask(taskDone);
+}
+
 bool MetaServerClientImpl::ParseS3MetaStreamBuffer(butil::IOBuf* buffer,
                                                    uint64_t* chunkIndex,
                                                    S3ChunkInfoList* list) {
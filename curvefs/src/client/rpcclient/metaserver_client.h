@@ -46,6 +46,7 @@ using ::curvefs::metaserver::Dentry;
 using ::curvefs::metaserver::FsFileType;
 using ::curvefs::metaserver::Inode;
 using ::curvefs::metaserver::InodeAttr;
+using ::curvefs::metaserver::InodeAttrDelta;
 using ::curvefs::metaserver::XAttr;
 using ::curvefs::metaserver::MetaStatusCode;
 using ::curvefs::metaserver::S3ChunkInfoList;
@@ -133,6 +134,13 @@ class MetaServerClient {
         MetaServerClientDone* done,
         DataIndices&& indices = {}) = 0;
 
+    // Send attribute deltas of inodes which belong to the same partition
+    // in one request, see also `SplitRequestInodes`
+    virtual void BatchUpdateInodeAttrAsync(
+        uint32_t fsId,
+        const std::vector<InodeAttrDelta>& deltas,
+        MetaServerClientDone* done) = 0;
+
     virtual MetaStatusCode GetOrModifyS3ChunkInfo(
         uint32_t fsId, uint64_t inodeId,
         const google::protobuf::Map<
@@ -237,6 +245,11 @@ class MetaServerClientImpl : public MetaServerClient {
         MetaServerClientDone* done,
         DataIndices&& indices = {}) override;
 
+    void BatchUpdateInodeAttrAsync(
+        uint32_t fsId,
+        const std::vector<InodeAttrDelta>& deltas,
+        MetaServerClientDone* done) override;
+
     MetaStatusCode GetOrModifyS3ChunkInfo(
         uint32_t fsId, uint64_t inodeId,
         const google::protobuf::Map<
@@ -180,6 +180,24 @@ int S3ClientAdaptorImpl::Read(uint64_t inodeId, uint64_t offset,
     return ret;
 }
 
+bool S3ClientAdaptorImpl::ReadZeroCopy(uint64_t inodeId, uint64_t offset,
+                                       uint64_t length, CachedDataRef *ref) {
+    uint64_t start = butil::cpuwide_time_us();
+    FileCacheManagerPtr fileCacheManager =
+        fsCacheManager_->FindFileCacheManager(inodeId);
+    if (fileCacheManager == nullptr ||
+        !fileCacheManager->ReadZeroCopy(offset, length, ref)) {
+        return false;
+    }
+    if (s3Metric_.get() != nullptr) {
+        CollectMetrics(&s3Metric_->adaptorRead, ref->len, start);
+        s3Metric_->readSize.set_value(length);
+    }
+    VLOG(6) << "read zero copy end offset:" << offset << ", len:" << length
+            << ", fsId:" << fsId_ << ", inodeId:" << inodeId;
+    return true;
+}
+
 CURVEFS_ERROR S3ClientAdaptorImpl::Truncate(InodeWrapper *inodeWrapper,
                                             uint64_t size) {
     const auto *inode = inodeWrapper->GetInodeLocked();
@@ -81,6 +81,12 @@ class S3ClientAdaptor {
                       const char *buf) = 0;
     virtual int Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                      char *buf) = 0;
+    /**
+     * @brief reference the cached pages of the range without copy
+     * @return false if the range is not entirely in the read cache
+     */
+    virtual bool ReadZeroCopy(uint64_t inodeId, uint64_t offset,
+                              uint64_t length, CachedDataRef *ref) = 0;
     virtual CURVEFS_ERROR Truncate(InodeWrapper *inodeWrapper,
                                    uint64_t size) = 0;
     virtual void ReleaseCache(uint64_t inodeId) = 0;
@@ -139,6 +145,8 @@ class S3ClientAdaptorImpl : public S3ClientAdaptor {
     int Write(uint64_t inodeId, uint64_t offset, uint64_t length,
               const char *buf);
     int Read(uint64_t inodeId, uint64_t offset, uint64_t length, char *buf);
+    bool ReadZeroCopy(uint64_t inodeId, uint64_t offset, uint64_t length,
+                      CachedDataRef *ref);
     CURVEFS_ERROR Truncate(InodeWrapper *inodeWrapper, uint64_t size);
     void ReleaseCache(uint64_t inodeId);
     CURVEFS_ERROR Flush(uint64_t inodeId);
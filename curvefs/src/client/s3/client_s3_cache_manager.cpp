@@ -363,6 +363,42 @@ void FileCacheManager::ReadFromMemCache(
         << "greate! memory cache all hit.";
 }
 
+bool FileCacheManager::ReadZeroCopy(uint64_t offset, uint64_t length,
+                                    CachedDataRef *ref) {
+    uint64_t index = 0, chunkPos = 0, chunkSize = 0;
+    GetChunkLoc(offset, &index, &chunkPos, &chunkSize);
+
+    ref->Clear();
+    uint64_t currentReadLen = 0;
+    while (length > 0) {
+        currentReadLen =
+            chunkPos + length > chunkSize ? chunkSize - chunkPos : length;
+
+        // do not create chunk cache manager for a miss, the copy path
+        // will do it when fallback
+        ChunkCacheManagerPtr chunkCacheManager;
+        {
+            ReadLockGuard readLockGuard(rwLock_);
+            auto it = chunkCacheMap_.find(index);
+            if (it != chunkCacheMap_.end()) {
+                chunkCacheManager = it->second;
+            }
+        }
+        if (chunkCacheManager == nullptr ||
+            !chunkCacheManager->ReadChunkZeroCopy(chunkPos, currentReadLen,
+                                                  ref)) {
+            ref->Clear();
+            return false;
+        }
+
+        length -= currentReadLen;
+        index++;
+        chunkPos = (chunkPos + currentReadLen) % chunkSize;
+    }
+
+    return true;
+}
+
 int FileCacheManager::GenerateKVReuqest(
     const std::shared_ptr<InodeWrapper> &inodeWrapper,
     const std::vector<ReadRequest> &readRequest, char *dataBuf,
@@ -1138,6 +1174,83 @@ void ChunkCacheManager::ReadChunk(uint64_t index, uint64_t chunkPos,
     return;
 }
 
+bool ChunkCacheManager::ReadChunkZeroCopy(uint64_t chunkPos,
+                                          uint64_t readLen,
+                                          CachedDataRef *ref) {
+    ReadLockGuard readLockGuard(rwLockChunk_);
+    // data in write cache and flushing cache is still mutable,
+    // so only the range entirely in read cache can be referenced
+    {
+        ReadLockGuard writeCacheLock(rwLockWrite_);
+        auto iter = dataWCacheMap_.upper_bound(chunkPos);
+        if (iter != dataWCacheMap_.begin()) {
+            --iter;
+        }
+        for (; iter != dataWCacheMap_.end(); ++iter) {
+            uint64_t dcChunkPos = iter->second->GetChunkPos();
+            uint64_t dcLen = iter->second->GetLen();
+            if (chunkPos + readLen <= dcChunkPos) {
+                break;
+            }
+            if (dcChunkPos + dcLen > chunkPos) {
+                return false;
+            }
+        }
+    }
+
+    {
+        curve::common::LockGuard lg(flushingDataCacheMtx_);
+        if (!IsFlushDataEmpty()) {
+            uint64_t dcChunkPos = flushingDataCache_->GetChunkPos();
+            uint64_t dcLen = flushingDataCache_->GetLen();
+            if (chunkPos + readLen > dcChunkPos &&
+                chunkPos < dcChunkPos + dcLen) {
+                return false;
+            }
+        }
+    }
+
+    ReadLockGuard readCacheLock(rwLockRead_);
+    auto iter = dataRCacheMap_.upper_bound(chunkPos);
+    if (iter == dataRCacheMap_.begin()) {
+        return false;
+    }
+    --iter;
+
+    std::vector<struct iovec> iov;
+    std::vector<std::list<DataCachePtr>::iterator> hits;
+    uint64_t pos = chunkPos;
+    uint64_t left = readLen;
+    for (; iter != dataRCacheMap_.end() && left > 0; ++iter) {
+        DataCachePtr &dataCache = (*iter->second);
+        uint64_t dcChunkPos = dataCache->GetChunkPos();
+        uint64_t dcLen = dataCache->GetLen();
+        if (pos < dcChunkPos || pos >= dcChunkPos + dcLen) {
+            VLOG(9) << "ReadChunkZeroCopy miss, chunkPos: " << pos
+                    << ", dcChunkPos: " << dcChunkPos << ", dcLen: " << dcLen;
+            return false;
+        }
+
+        uint64_t n = std::min(left, dcChunkPos + dcLen - pos);
+        dataCache->CollectPages(pos - dcChunkPos, n, &iov);
+        hits.emplace_back(iter->second);
+        pos += n;
+        left -= n;
+    }
+
+    if (left > 0) {
+        return false;
+    }
+
+    for (auto &hit : hits) {
+        s3ClientAdaptor_->GetFsCacheManager()->Get(hit);
+        ref->holders.emplace_back(*hit);
+    }
+    ref->iov.insert(ref->iov.end(), iov.begin(), iov.end());
+    ref->len += readLen;
+    return true;
+}
+
 void ChunkCacheManager::ReadByWriteCache(uint64_t chunkPos, uint64_t readLen,
                                          char *dataBuf, uint64_t dataBufOffset,
                                          std::vector<ReadRequest> *requests) {
@@ -2238,6 +2351,57 @@ void DataCache::CopyDataCacheToBuf(uint64_t offset, uint64_t len, char *data) {
     return;
 }
 
+void DataCache::CollectPages(uint64_t offset, uint64_t len,
+                             std::vector<struct iovec> *iov) {
+    assert(offset + len <= len_);
+    uint64_t blockSize = s3ClientAdaptor_->GetBlockSize();
+    uint32_t pageSize = s3ClientAdaptor_->GetPageSize();
+    uint64_t newChunkPos = chunkPos_ + offset;
+    uint64_t blockIndex = newChunkPos / blockSize;
+    uint64_t blockPos = newChunkPos % blockSize;
+    uint64_t pagePos, pageIndex;
+    uint64_t n, m, blockLen;
+
+    while (len > 0) {
+        if (blockPos + len > blockSize) {
+            n = blockSize - blockPos;
+        } else {
+            n = len;
+        }
+        blockLen = n;
+        PageDataMap &pdMap = dataMap_[blockIndex];
+        PageData *pageData = NULL;
+        pageIndex = blockPos / pageSize;
+        pagePos = blockPos % pageSize;
+        while (blockLen > 0) {
+            if (pagePos + blockLen > pageSize) {
+                m = pageSize - pagePos;
+            } else {
+                m = blockLen;
+            }
+
+            assert(pdMap.count(pageIndex));
+            pageData = pdMap[pageIndex];
+            char *base = pageData->data + pagePos;
+            // merge with the previous one if the pages happen to be adjacent
+            if (!iov->empty() &&
+                static_cast<char *>(iov->back().iov_base) +
+                        iov->back().iov_len == base) {
+                iov->back().iov_len += m;
+            } else {
+                iov->push_back({base, m});
+            }
+            pageIndex++;
+            blockLen -= m;
+            pagePos = (pagePos + m) % pageSize;
+        }
+
+        blockIndex++;
+        len -= n;
+        blockPos = (blockPos + n) % blockSize;
+    }
+}
+
 CURVEFS_ERROR DataCache::Flush(uint64_t inodeId, bool toS3) {
     VLOG(9) << "DataCache Flush. chunkPos=" << chunkPos_ << ", len=" << len_
             << ", chunkIndex=" << chunkCacheManager_->GetIndex()
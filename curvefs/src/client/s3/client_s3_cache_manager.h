@@ -22,6 +22,8 @@
 #ifndef CURVEFS_SRC_CLIENT_S3_CLIENT_S3_CACHE_MANAGER_H_
 #define CURVEFS_SRC_CLIENT_S3_CLIENT_S3_CACHE_MANAGER_H_
 
+#include <sys/uio.h>
+
 #include <algorithm>
 #include <cstring>
 #include <list>
@@ -130,6 +132,20 @@ struct PageData {
 };
 using PageDataMap = std::map<uint64_t, PageData *>;
 
+// CachedDataRef references read cache pages instead of copying them,
+// the holders keep the pages alive until the reference is dropped
+struct CachedDataRef {
+    std::vector<struct iovec> iov;
+    std::vector<DataCachePtr> holders;
+    uint64_t len = 0;
+
+    void Clear() {
+        iov.clear();
+        holders.clear();
+        len = 0;
+    }
+};
+
 enum DataCacheStatus {
     Dirty = 1,
     Flush = 2,
@@ -202,6 +218,9 @@ class DataCache : public std::enable_shared_from_this<DataCache> {
         mtx_.unlock();
     }
     void CopyDataCacheToBuf(uint64_t offset, uint64_t len, char *data);
+    // append the pages covering [offset, offset + len) to iov without copy
+    void CollectPages(uint64_t offset, uint64_t len,
+                      std::vector<struct iovec> *iov);
     void MergeDataCacheToDataCache(DataCachePtr mergeDataCache,
                                    uint64_t dataOffset, uint64_t len);
 
@@ -275,6 +294,10 @@ class ChunkCacheManager
     FindWriteableDataCache(uint64_t pos, uint64_t len,
                            std::vector<DataCachePtr> *mergeDataCacheVer,
                            uint64_t inodeId);
+    // ReadChunkZeroCopy: reference the read cache pages of the range,
+    // return false if the range is not entirely in the read cache
+    virtual bool ReadChunkZeroCopy(uint64_t chunkPos, uint64_t readLen,
+                                   CachedDataRef *ref);
     virtual void ReadByWriteCache(uint64_t chunkPos, uint64_t readLen,
                                   char *dataBuf, uint64_t dataBufOffset,
                                   std::vector<ReadRequest> *requests);
@@ -353,6 +376,10 @@ class FileCacheManager {
     virtual int Read(uint64_t inodeId, uint64_t offset, uint64_t length,
                      char *dataBuf);
 
+    // ReadZeroCopy: only hit when the whole range is in the read cache
+    virtual bool ReadZeroCopy(uint64_t offset, uint64_t length,
+                              CachedDataRef *ref);
+
     bool IsEmpty() { return chunkCacheMap_.empty(); }
 
     uint64_t GetInodeId() const { return inode_; }
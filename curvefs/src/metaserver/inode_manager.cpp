@@ -392,6 +392,73 @@ MetaStatusCode InodeManager::UpdateInode(const UpdateInodeRequest& request) {
     return MetaStatusCode::OK;
 }
 
+MetaStatusCode InodeManager::UpdateInodeAttrDelta(
+    uint32_t fsId, const InodeAttrDelta& delta) {
+    const uint64_t inodeId = delta.inodeid();
+    VLOG(9) << "update inode attr delta, fsid: " << fsId
+            << ", inodeid: " << inodeId;
+    NameLockGuard lg(inodeLock_, GetInodeLockName(fsId, inodeId));
+
+    // NOTE: merging into a deleted inode doesn't fail on rocksdb storage,
+    // and the s3 chunk info appended for it would never be cleaned, so check
+    // the inode first, DeleteInode() holds the same inode lock
+    MetaStatusCode ret = inodeStorage_->Exist(Key4Inode(fsId, inodeId));
+    if (ret == MetaStatusCode::NOT_FOUND) {
+        VLOG(3) << "Inode has been deleted, skip merging delta, fsId: "
+                << fsId << ", inodeId: " << inodeId;
+        return ret;
+    } else if (ret != MetaStatusCode::OK) {
+        LOG(ERROR) << "Check inode existence fail, fsId: " << fsId
+                   << ", inodeId: " << inodeId
+                   << ", ret: " << MetaStatusCode_Name(ret);
+        return ret;
+    }
+
+    Inode partial;
+    bool needMerge = false;
+
+#define MERGE_INODE(param)                   \
+    if (delta.has_##param()) {              \
+        partial.set_##param(delta.param()); \
+        needMerge = true;                   \
+    }
+
+    MERGE_INODE(length)
+    MERGE_INODE(ctime)
+    MERGE_INODE(ctime_ns)
+    MERGE_INODE(mtime)
+    MERGE_INODE(mtime_ns)
+    MERGE_INODE(atime)
+    MERGE_INODE(atime_ns)
+
+#undef MERGE_INODE
+
+    if (needMerge) {
+        ret = inodeStorage_->Merge(Key4Inode(fsId, inodeId), partial);
+        if (ret != MetaStatusCode::OK) {
+            LOG(ERROR) << "Merge inode attr delta fail, fsId: " << fsId
+                       << ", inodeId: " << inodeId
+                       << ", ret: " << MetaStatusCode_Name(ret);
+            return ret;
+        }
+    }
+
+    for (const auto &item : delta.s3chunkinfoadd()) {
+        MetaStatusCode rc = inodeStorage_->ModifyInodeS3ChunkInfoList(
+            fsId, inodeId, item.first, &item.second, nullptr);
+        if (rc != MetaStatusCode::OK) {
+            LOG(ERROR) << "Modify inode s3chunkinfo list failed, fsId="
+                       << fsId << ", inodeId=" << inodeId
+                       << ", retCode=" << rc;
+            return rc;
+        }
+    }
+
+    VLOG(9) << "UpdateInodeAttrDelta success, fsId: " << fsId
+            << ", inodeId: " << inodeId;
+    return MetaStatusCode::OK;
+}
+
 MetaStatusCode InodeManager::GetOrModifyS3ChunkInfo(
     uint32_t fsId, uint64_t inodeId,
     const S3ChunkInfoMap& map2add,
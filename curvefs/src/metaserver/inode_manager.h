@@ -90,6 +90,11 @@ class InodeManager {
 
     MetaStatusCode UpdateInode(const UpdateInodeRequest& request);
 
+    // Merge the attributes and s3 chunk info carried by delta into inode,
+    // the inode is only checked for existence but not read before merging
+    MetaStatusCode UpdateInodeAttrDelta(uint32_t fsId,
+                                        const InodeAttrDelta& delta);
+
     MetaStatusCode GetOrModifyS3ChunkInfo(
         uint32_t fsId,
         uint64_t inodeId,
@@ -163,6 +163,22 @@ MetaStatusCode InodeStorage::GetXAttr(const Key4Inode& key, XAttr *xattr) {
     return MetaStatusCode::OK;
 }
 
+MetaStatusCode InodeStorage::Exist(const Key4Inode& key) {
+    ReadLockGuard lg(rwLock_);
+    std::string skey = conv_.SerializeToString(key);
+    Status s = kvStorage_->HExist(table4Inode_, skey);
+    if (s.ok()) {
+        return MetaStatusCode::OK;
+    } else if (s.IsNotFound()) {
+        return MetaStatusCode::NOT_FOUND;
+    } else if (s.IsDBClosed()) {
+        return MetaStatusCode::STORAGE_CLOSED;
+    }
+
+    LOG(ERROR) << "Check inode existence failed, status = " << s.ToString();
+    return MetaStatusCode::STORAGE_INTERNAL_ERROR;
+}
+
 MetaStatusCode InodeStorage::Delete(const Key4Inode& key) {
     WriteLockGuard lg(rwLock_);
     std::string skey = conv_.SerializeToString(key);
@@ -193,6 +209,20 @@ MetaStatusCode InodeStorage::Update(const Inode& inode) {
     return MetaStatusCode::STORAGE_INTERNAL_ERROR;
 }
 
+MetaStatusCode InodeStorage::Merge(const Key4Inode& key, const Inode& delta) {
+    WriteLockGuard lg(rwLock_);
+    std::string skey = conv_.SerializeToString(key);
+
+    Status s = kvStorage_->HMerge(table4Inode_, skey, delta);
+    if (s.ok()) {
+        return MetaStatusCode::OK;
+    } else if (s.IsNotFound()) {
+        return MetaStatusCode::NOT_FOUND;
+    }
+    LOG(ERROR) << "Merge inode failed, status = " << s.ToString();
+    return MetaStatusCode::STORAGE_INTERNAL_ERROR;
+}
+
 std::shared_ptr<Iterator> InodeStorage::GetAllInode() {
     ReadLockGuard lg(rwLock_);
     std::string sprefix = conv_.SerializeToString(Prefix4AllInode());
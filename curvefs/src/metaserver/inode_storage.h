@@ -88,6 +88,13 @@ class InodeStorage {
      */
     MetaStatusCode GetXAttr(const Key4Inode& key, XAttr *xattr);
 
+    /**
+     * @brief check whether inode exists in storage without parsing it
+     * @param[in] key: the key of inode want to check
+     * @return If inode not exist, return NOT_FOUND; else return OK
+     */
+    MetaStatusCode Exist(const Key4Inode& key);
+
     /**
      * @brief delete inode from storage
      * @param[in] key: the key of inode want to delete
@@ -102,6 +109,18 @@ class InodeStorage {
      */
     MetaStatusCode Update(const Inode& inode);
 
+    /**
+     * @brief merge the fields set in delta into inode without reading it
+     * @param[in] key: the key of inode want to merge
+     * @param[in] delta: partial inode whose set fields will overwrite
+     *                   the stored ones
+     * @return If storage reports inode not exist, return NOT_FOUND;
+     *         else merge and return OK
+     * NOTE: rocksdb storage never reports NOT_FOUND, check the inode
+     *       with Exist() before merging
+     */
+    MetaStatusCode Merge(const Key4Inode& key, const Inode& delta);
+
     std::shared_ptr<Iterator> GetAllInode();
 
     bool GetAllInodeId(std::list<uint64_t>* ids);
@@ -585,6 +585,9 @@ void Metaserver::InitStorage() {
                                          &options.maxDiskQuotaBytes));
     LOG_IF(FATAL, !conf_->GetBoolValue("storage.memory.compression",
                                        &options.compression));
+    LOG_IF(FATAL, !conf_->GetUInt32Value(
+        "storage.memory.checkpoint_max_delta_files",
+        &options.maxCheckpointDeltaFiles));
 
     conf_->GetValueFatalIfFail("storage.rocksdb.perf_level",
                                &FLAGS_rocksdb_perf_level);
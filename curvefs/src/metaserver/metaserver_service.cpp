@@ -52,6 +52,7 @@ using ::curvefs::metaserver::copyset::DeletePartitionOperator;
 using ::curvefs::metaserver::copyset::PrepareRenameTxOperator;
 using ::curvefs::metaserver::copyset::GetVolumeExtentOperator;
 using ::curvefs::metaserver::copyset::UpdateVolumeExtentOperator;
+using ::curvefs::metaserver::copyset::BatchUpdateInodeAttrOperator;
 
 namespace {
 
@@ -298,5 +299,16 @@ void MetaServerServiceImpl::UpdateVolumeExtent(
                                                   request->copysetid());
 }
 
+void MetaServerServiceImpl::BatchUpdateInodeAttr(
+    ::google::protobuf::RpcController* controller,
+    const BatchUpdateInodeAttrRequest* request,
+    BatchUpdateInodeAttrResponse* response,
+    ::google::protobuf::Closure* done) {
+    OperatorHelper helper(copysetNodeManager_, inflightThrottle_);
+    helper.operator()<BatchUpdateInodeAttrOperator>(
+        controller, request, response, done, request->poolid(),
+        request->copysetid());
+}
+
 }  // namespace metaserver
 }  // namespace curvefs
@@ -123,6 +123,11 @@ class MetaServerServiceImpl : public MetaServerService {
                             UpdateVolumeExtentResponse* response,
                             ::google::protobuf::Closure* done) override;
 
+    void BatchUpdateInodeAttr(::google::protobuf::RpcController* controller,
+                              const BatchUpdateInodeAttrRequest* request,
+                              BatchUpdateInodeAttrResponse* response,
+                              ::google::protobuf::Closure* done) override;
+
  private:
     CopysetNodeManager* copysetNodeManager_;
     InflightThrottle* inflightThrottle_;
@@ -823,6 +823,36 @@ MetaStatusCode MetaStoreImpl::UpdateVolumeExtent(
     return st;
 }
 
+MetaStatusCode MetaStoreImpl::BatchUpdateInodeAttr(
+    const BatchUpdateInodeAttrRequest* request,
+    BatchUpdateInodeAttrResponse* response) {
+    ReadLockGuard guard(rwLock_);
+    auto partition = GetPartition(request->partitionid());
+    if (!partition) {
+        auto st = MetaStatusCode::PARTITION_NOT_FOUND;
+        response->set_statuscode(st);
+        return st;
+    }
+
+    VLOG(9) << "BatchUpdateInodeAttr, fsId: " << request->fsid()
+            << ", partitionId: " << request->partitionid()
+            << ", delta size: " << request->delta_size();
+
+    // deltas of deleted inodes are dropped, they are stale updates
+    // which need not to be retried by client
+    auto st = MetaStatusCode::OK;
+    for (const auto& delta : request->delta()) {
+        auto rc = partition->UpdateInodeAttrDelta(request->fsid(), delta);
+        if (rc != MetaStatusCode::OK && rc != MetaStatusCode::NOT_FOUND) {
+            st = rc;
+            break;
+        }
+    }
+
+    response->set_statuscode(st);
+    return st;
+}
+
 bool MetaStoreImpl::InitStorage() {
     if (storageOptions_.type == "memory") {
         kvStorage_ = std::make_shared<MemoryStorage>(storageOptions_);
@@ -170,6 +170,10 @@ class MetaStore {
     virtual MetaStatusCode UpdateVolumeExtent(
         const UpdateVolumeExtentRequest* request,
         UpdateVolumeExtentResponse* response) = 0;
+
+    virtual MetaStatusCode BatchUpdateInodeAttr(
+        const BatchUpdateInodeAttrRequest* request,
+        BatchUpdateInodeAttrResponse* response) = 0;
 };
 
 class MetaStoreImpl : public MetaStore {
@@ -255,6 +259,10 @@ class MetaStoreImpl : public MetaStore {
         const UpdateVolumeExtentRequest* request,
         UpdateVolumeExtentResponse* response) override;
 
+    MetaStatusCode BatchUpdateInodeAttr(
+        const BatchUpdateInodeAttrRequest* request,
+        BatchUpdateInodeAttrResponse* response) override;
+
  private:
     FRIEND_TEST(MetastoreTest, partition);
     FRIEND_TEST(MetastoreTest, test_inode);
@@ -406,9 +406,12 @@ bool MetaStoreFStream::Save(const std::string& path,
         }
     }
 
+    // NOTE: the dumpfile only contains partitions and pending transactions,
+    // other metadata is saved by |KVStorage::Checkpoint()|, so we save it
+    // in the current thread instead of forking a child process, fork would
+    // copy the page table and stall all bthreads for large memory storage.
     auto mergeIterator = std::make_shared<MergeIterator>(children);
-    bool background = (kvStorage_->Type() == STORAGE_TYPE::MEMORY_STORAGE);
-    bool succ = SaveToFile(path, mergeIterator, background, done);
+    bool succ = SaveToFile(path, mergeIterator, false, done);
     if (succ) {
         LOG(INFO) << "MetaStoreFStream save success";
     } else {
@@ -318,6 +318,17 @@ MetaStatusCode Partition::UpdateInode(const UpdateInodeRequest& request) {
     return inodeManager_->UpdateInode(request);
 }
 
+MetaStatusCode Partition::UpdateInodeAttrDelta(uint32_t fsId,
+                                               const InodeAttrDelta& delta) {
+    if (!IsInodeBelongs(fsId, delta.inodeid())) {
+        return MetaStatusCode::PARTITION_ID_MISSMATCH;
+    } else if (GetStatus() == PartitionStatus::DELETING) {
+        return MetaStatusCode::PARTITION_DELETING;
+    }
+
+    return inodeManager_->UpdateInodeAttrDelta(fsId, delta);
+}
+
 MetaStatusCode Partition::GetOrModifyS3ChunkInfo(
     uint32_t fsId,
     uint64_t inodeId,
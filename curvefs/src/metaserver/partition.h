@@ -97,6 +97,9 @@ class Partition {
 
     MetaStatusCode UpdateInode(const UpdateInodeRequest& request);
 
+    MetaStatusCode UpdateInodeAttrDelta(uint32_t fsId,
+                                        const InodeAttrDelta& delta);
+
     MetaStatusCode GetOrModifyS3ChunkInfo(uint32_t fsId,
                                           uint64_t inodeId,
                                           const S3ChunkInfoMap& map2add,
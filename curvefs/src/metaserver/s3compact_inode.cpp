@@ -23,7 +23,10 @@
 #include "curvefs/src/metaserver/s3compact_inode.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <deque>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -33,11 +36,14 @@
 #include <vector>
 
 #include "absl/cleanup/cleanup.h"
+#include "bvar/bvar.h"
 #include "curvefs/src/common/s3util.h"
 #include "curvefs/src/metaserver/copyset/copyset_node_manager.h"
 #include "curvefs/src/metaserver/copyset/meta_operator.h"
+#include "src/common/concurrent/count_down_event.h"
 
 using curve::common::Configuration;
+using curve::common::CountDownEvent;
 using curve::common::InitS3AdaptorOptionExceptS3InfoOption;
 using curve::common::S3Adapter;
 using curve::common::S3AdapterOption;
@@ -47,6 +53,10 @@ using curvefs::metaserver::copyset::GetOrModifyS3ChunkInfoOperator;
 namespace curvefs {
 namespace metaserver {
 
+static bvar::Adder<uint64_t> g_s3compact_read_bytes("s3compact_read_bytes");
+static bvar::Adder<uint64_t> g_s3compact_write_bytes("s3compact_write_bytes");
+static bvar::Adder<uint64_t> g_s3compact_reclaimed_bytes(
+    "s3compact_reclaimed_bytes");
 
 std::vector<uint64_t> CompactInodeJob::GetNeedCompact(
     const ::google::protobuf::Map<uint64_t, S3ChunkInfoList>& s3chunkinfoMap,
@@ -242,11 +252,65 @@ void CompactInodeJob::GenS3ReadRequests(
     newChunkInfo->newCompaction = newCompaction;
 }
 
+void CompactInodeJob::RunS3Tasks(
+    const std::vector<std::function<void()>>& tasks) {
+    if (opts_->s3ioPool == nullptr || tasks.size() <= 1) {
+        for (const auto& task : tasks) {
+            task();
+        }
+        return;
+    }
+
+    CountDownEvent done(tasks.size());
+    for (const auto& task : tasks) {
+        opts_->s3ioPool->Enqueue([&done, &task]() {
+            task();
+            done.Signal();
+        });
+    }
+    done.Wait();
+}
+
+int CompactInodeJob::GetObjectWithRetry(const struct S3CompactCtx& ctx,
+                                        const std::string& objName,
+                                        uint64_t off, uint64_t len,
+                                        char* buf) {
+    auto* throttle = opts_->inflightThrottle;
+    const auto maxRetry = opts_->s3ReadMaxRetry;
+    const auto retryInterval = opts_->s3ReadRetryInterval;
+    for (uint64_t retry = 0; retry <= maxRetry; retry++) {
+        // why we need retry
+        // if you enable client's diskcache,
+        // metadata may be newer than data in s3
+        // which means you cannot read data from s3
+        // we have to wait data to be flushed to s3
+        if (throttle != nullptr) {
+            throttle->OnStart(len);
+        }
+        int ret = ctx.s3adapter->GetObject(objName, buf, off, len);
+        if (throttle != nullptr) {
+            throttle->OnComplete(len);
+        }
+        if (ret == 0) {
+            g_s3compact_read_bytes << len;
+            return 0;
+        }
+
+        LOG(WARNING) << "s3compact: get s3 obj " << objName << " failed";
+        if (retry == maxRetry) {
+            break;  // no chance
+        }
+        LOG(WARNING) << "s3compact: will retry after " << retryInterval
+                     << " seconds, current retry time:" << retry + 1;
+        std::this_thread::sleep_for(std::chrono::seconds(retryInterval));
+    }
+    return -1;
+}
+
 int CompactInodeJob::ReadFullChunk(
     const struct S3CompactCtx& ctx, const std::list<struct Node>& validList,
     std::string* fullChunk, struct S3NewChunkInfo* newChunkInfo) {
     std::vector<struct S3Request> s3reqs;
-    std::vector<std::string> readContent;
     // generate s3request first
     GenS3ReadRequests(ctx, validList, &s3reqs, newChunkInfo);
     VLOG(9) << "s3compact: s3 request generated";
@@ -255,62 +319,69 @@ int CompactInodeJob::ReadFullChunk(
                 << ", s3objname:" << s3req.objName << ", off:" << s3req.off
                 << ", len:" << s3req.len;
     }
-    readContent.resize(s3reqs.size());
-    std::unordered_map<std::string, std::vector<struct S3Request*>> objReqs;
-    for (auto& req : s3reqs) {
+
+    // requests are laid out in order, so we can merge the read content in
+    // place, zero requests need nothing to do
+    std::vector<uint64_t> reqPos(s3reqs.size());
+    uint64_t chunkLen = 0;
+    for (const auto& req : s3reqs) {
+        reqPos[req.reqIndex] = chunkLen;
+        chunkLen += req.len;
+    }
+    fullChunk->assign(chunkLen, '\0');
+
+    // one ranged get for all requests of the same object
+    struct ObjRead {
+        uint64_t begin = UINT64_MAX;
+        uint64_t end = 0;
+        std::vector<const struct S3Request*> reqs;
+    };
+    std::map<std::string, ObjRead> objReads;
+    for (const auto& req : s3reqs) {
         if (req.zero) {
-            objReqs["zero"].emplace_back(&req);
-        } else {
-            objReqs[req.objName].emplace_back(&req);
+            continue;
         }
+        auto& read = objReads[req.objName];
+        read.begin = std::min(read.begin, req.off);
+        read.end = std::max(read.end, req.off + req.len);
+        read.reqs.emplace_back(&req);
     }
-    // process zero first and will not fail
-    if (objReqs.find("zero") != objReqs.end()) {
-        for (const auto& req : objReqs["zero"]) {
-            readContent[req->reqIndex] = std::string(req->len, '\0');
-        }
-        objReqs.erase("zero");
-    }
-    // read and process objs one by one
-    uint64_t retry = 0;
-    for (auto it = objReqs.begin(); it != objReqs.end(); it++) {
-        std::string buf;
-        const std::string& objName = it->first;
-        const auto& reqs = it->second;
-        const Aws::String aws_key(objName.c_str(), objName.size());
-        const auto maxRetry = opts_->s3ReadMaxRetry;
-        const auto retryInterval = opts_->s3ReadRetryInterval;
-        while (retry <= maxRetry) {
-            // why we need retry
-            // if you enable client's diskcache,
-            // metadata may be newer than data in s3
-            // which means you cannot read data from s3
-            // we have to wait data to be flushed to s3
-            int ret = ctx.s3adapter->GetObject(aws_key, &buf);
-            if (ret != 0) {
-                LOG(WARNING)
-                    << "s3compact: get s3 obj " << objName << " failed";
-                if (retry == maxRetry) return -1;  // no chance
-                retry++;
-                LOG(WARNING) << "s3compact: will retry after " << retryInterval
-                             << " seconds, current retry time:" << retry;
-                std::this_thread::sleep_for(
-                    std::chrono::seconds(retryInterval));
-                continue;
+
+    std::atomic<bool> failed(false);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(objReads.size());
+    for (const auto& item : objReads) {
+        const auto& objName = item.first;
+        const auto& read = item.second;
+        tasks.emplace_back([&, this]() {
+            if (failed.load(std::memory_order_relaxed)) {
+                return;
             }
-            for (const auto& req : reqs) {
-                readContent[req->reqIndex] = buf.substr(req->off, req->len);
+            const uint64_t len = read.end - read.begin;
+            // read directly into full chunk if it's the only request
+            std::string buf;
+            char* dest = nullptr;
+            if (read.reqs.size() == 1) {
+                dest = &(*fullChunk)[reqPos[read.reqs[0]->reqIndex]];
+            } else {
+                buf.resize(len);
+                dest = &buf[0];
             }
-            break;
-        }
-    }
-
-    // merge all read content
-    for (auto content : readContent) {
-        (*fullChunk) += std::move(content);
+            if (GetObjectWithRetry(ctx, objName, read.begin, len, dest) != 0) {
+                failed.store(true, std::memory_order_relaxed);
+                return;
+            }
+            if (read.reqs.size() > 1) {
+                for (const auto* req : read.reqs) {
+                    memcpy(&(*fullChunk)[reqPos[req->reqIndex]],
+                           buf.data() + req->off - read.begin, req->len);
+                }
+            }
+        });
     }
+    RunS3Tasks(tasks);
 
-    return 0;
+    return failed.load() ? -1 : 0;
 }
 
 MetaStatusCode CompactInodeJob::UpdateInode(
@@ -346,30 +417,61 @@ int CompactInodeJob::WriteFullChunk(
     const auto& newOff = newChunkInfo.newOff;
     uint64_t offRoundDown = newOff / chunkSize * chunkSize;
     uint64_t startIndex = (newOff - newOff / chunkSize * chunkSize) / blockSize;
-    for (uint64_t index = startIndex;
-         index * blockSize + offRoundDown < newOff + chunkLen; index += 1) {
-        std::string objName = curvefs::common::s3util::GenObjName(
+    uint64_t endIndex = startIndex;
+    while (endIndex * blockSize + offRoundDown < newOff + chunkLen) {
+        endIndex++;
+    }
+
+    // put all objs of the chunk concurrently
+    const size_t objNum = endIndex - startIndex;
+    std::vector<std::string> objNames(objNum);
+    std::vector<int> rets(objNum, 0);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(objNum);
+    for (size_t i = 0; i < objNum; i++) {
+        uint64_t index = startIndex + i;
+        objNames[i] = curvefs::common::s3util::GenObjName(
             newChunkInfo.newChunkId, index, newChunkInfo.newCompaction,
             ctx.fsId, ctx.inodeId, ctx.objectPrefix);
-        const Aws::String aws_key(objName.c_str(), objName.size());
-        int ret;
         uint64_t s3objBegin =
             std::max(newOff, offRoundDown + index * blockSize);
         uint64_t s3objEnd = std::min(
             newOff + chunkLen - 1, offRoundDown + (index + 1) * blockSize - 1);
-        VLOG(9) << "s3compact: put " << objName << ", [" << s3objBegin << "-"
-                << s3objEnd << "]";
-        ret = ctx.s3adapter->PutObject(
-            aws_key,
-            fullChunk.substr(s3objBegin - newOff, s3objEnd - s3objBegin + 1));
-        if (ret != 0) {
-            LOG(WARNING) << "s3compact: put s3 object " << objName << " failed";
-            return ret;
+        VLOG(9) << "s3compact: put " << objNames[i] << ", [" << s3objBegin
+                << "-" << s3objEnd << "]";
+        tasks.emplace_back([&, i, s3objBegin, s3objEnd, this]() {
+            const std::string& objName = objNames[i];
+            const Aws::String aws_key(objName.c_str(), objName.size());
+            const uint64_t len = s3objEnd - s3objBegin + 1;
+            auto* throttle = opts_->inflightThrottle;
+            if (throttle != nullptr) {
+                throttle->OnStart(len);
+            }
+            rets[i] = ctx.s3adapter->PutObject(
+                aws_key, fullChunk.substr(s3objBegin - newOff, len));
+            if (throttle != nullptr) {
+                throttle->OnComplete(len);
+            }
+            if (rets[i] == 0) {
+                g_s3compact_write_bytes << len;
+            }
+        });
+    }
+    RunS3Tasks(tasks);
+
+    // objs put successfully are recorded even on failure,
+    // so that the caller can clean them up
+    int ret = 0;
+    for (size_t i = 0; i < objNum; i++) {
+        if (rets[i] != 0) {
+            LOG(WARNING) << "s3compact: put s3 object " << objNames[i]
+                         << " failed";
+            ret = rets[i];
         } else {
-            objsAdded->emplace_back(std::move(objName));
+            objsAdded->emplace_back(std::move(objNames[i]));
         }
     }
-    return 0;
+    return ret;
 }
 
 bool CompactInodeJob::CompactPrecheck(const struct S3CompactTask& task,
@@ -602,8 +704,18 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
     }
     std::vector<int> s3ChunkInfoRemoveIndex;
     s3ChunkInfoRemoveIndex.reserve(s3ChunkInfoRemove.size());
+    uint64_t lenRemoved = 0;
     for (const auto& element : s3ChunkInfoRemove) {
         s3ChunkInfoRemoveIndex.push_back(element.first);
+        for (const auto& chunkinfo : element.second.s3chunks()) {
+            lenRemoved += chunkinfo.len();
+        }
+    }
+    uint64_t lenAdded = 0;
+    for (const auto& element : s3ChunkInfoAdd) {
+        for (const auto& chunkinfo : element.second.s3chunks()) {
+            lenAdded += chunkinfo.len();
+        }
     }
     auto ret =
         UpdateInode(task.copysetNodeWrapper->Get(), compactCtx.pinfo, inodeId,
@@ -627,6 +739,9 @@ void CompactInodeJob::CompactChunks(const S3CompactTask& task) {
         DeleteObjsOfS3ChunkInfoList(compactCtx, l);
     }
     VLOG(6) << "s3compact: finish delete objs";
+    if (lenRemoved > lenAdded) {
+        g_s3compact_reclaimed_bytes << lenRemoved - lenAdded;
+    }
     opts_->s3adapterManager->ReleaseS3Adapter(s3adapterIndex);
     VLOG(6) << "s3compact: compact successfully";
 }
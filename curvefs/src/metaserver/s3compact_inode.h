@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <condition_variable>
 #include <deque>
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -178,6 +179,13 @@ class CompactInodeJob {
     std::list<struct Node> BuildValidList(
         const S3ChunkInfoList& s3chunkinfolist, uint64_t inodeLen,
         uint64_t index, uint64_t chunkSize);
+    // Run |tasks| concurrently in the shared s3 io pool if it's set,
+    // and wait until all of them are done
+    void RunS3Tasks(const std::vector<std::function<void()>>& tasks);
+    // Ranged get [off, off + len) of an object, retry on failure
+    int GetObjectWithRetry(const struct S3CompactCtx& ctx,
+                           const std::string& objName, uint64_t off,
+                           uint64_t len, char* buf);
     void GenS3ReadRequests(const struct S3CompactCtx& ctx,
                            const std::list<struct Node>& validList,
                            std::vector<struct S3Request>* reqs,
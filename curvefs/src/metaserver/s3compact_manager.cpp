@@ -115,8 +115,29 @@ void S3CompactWorkQueueOption::Init(std::shared_ptr<Configuration> conf) {
     conf->GetValueFatalIfFail("s3compactwq.s3_read_max_retry", &s3ReadMaxRetry);
     conf->GetValueFatalIfFail("s3compactwq.s3_read_retry_interval",
                               &s3ReadRetryInterval);
+    conf->GetValueFatalIfFail("s3compactwq.s3_io_thread_num", &s3IoThreadNum);
+    conf->GetValueFatalIfFail("s3compactwq.max_inflight_bytes",
+                              &maxInflightBytes);
 }
 
+S3CompactManager::S3CompactManager()
+    : pendingPartitions_(
+          "s3compact_pending_partitions",
+          [](void* arg) -> uint64_t {
+              auto* ctx = static_cast<S3CompactWorkerContext*>(arg);
+              std::lock_guard<std::mutex> lock(ctx->mtx);
+              return ctx->s3compacts.size();
+          },
+          &workerContext_),
+      inflightBytes_(
+          "s3compact_inflight_bytes",
+          [](void* arg) -> uint64_t {
+              auto* manager = static_cast<S3CompactManager*>(arg);
+              auto* throttle = manager->inflightThrottle_.get();
+              return throttle == nullptr ? 0 : throttle->InflightBytes();
+          },
+          this) {}
+
 void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
     opts_.Init(conf);
     if (opts_.enable) {
@@ -134,9 +155,17 @@ void S3CompactManager::Init(std::shared_ptr<Configuration> conf) {
         s3adapterManager_ =
             absl::make_unique<S3AdapterManager>(opts_.threadNum, opts_.s3opts);
         s3adapterManager_->Init();
+        if (opts_.s3IoThreadNum > 0) {
+            s3ioPool_ = absl::make_unique<TaskThreadPool<>>();
+            s3ioPool_->Start(opts_.s3IoThreadNum);
+        }
+        inflightThrottle_ = absl::make_unique<S3CompactInflightThrottle>(
+            opts_.maxInflightBytes);
 
         workerOptions_.s3adapterManager = s3adapterManager_.get();
         workerOptions_.s3infoCache = s3infoCache_.get();
+        workerOptions_.s3ioPool = s3ioPool_.get();
+        workerOptions_.inflightThrottle = inflightThrottle_.get();
         workerOptions_.maxChunksPerCompact = opts_.maxChunksPerCompact;
         workerOptions_.fragmentThreshold = opts_.fragmentThreshold;
         workerOptions_.s3ReadMaxRetry = opts_.s3ReadMaxRetry;
@@ -207,6 +236,9 @@ void S3CompactManager::Stop() {
         worker->Stop();
     }
 
+    if (s3ioPool_ != nullptr) {
+        s3ioPool_->Stop();
+    }
     s3adapterManager_->Deinit();
 }
 
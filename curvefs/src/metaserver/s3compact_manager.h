@@ -29,6 +29,8 @@
 #include <mutex>
 #include <vector>
 
+#include <bvar/bvar.h>
+
 #include "curvefs/proto/common.pb.h"
 #include "curvefs/src/metaserver/s3compact.h"
 #include "curvefs/src/metaserver/s3infocache.h"
@@ -80,6 +82,8 @@ struct S3CompactWorkQueueOption {
     uint64_t s3infocacheSize;
     uint64_t s3ReadMaxRetry;
     uint64_t s3ReadRetryInterval;
+    uint64_t s3IoThreadNum;
+    uint64_t maxInflightBytes;
 
     void Init(std::shared_ptr<Configuration> conf);
 };
@@ -89,15 +93,20 @@ class S3CompactManager {
     S3CompactWorkQueueOption opts_;
     std::unique_ptr<S3InfoCache> s3infoCache_;
     std::unique_ptr<S3AdapterManager> s3adapterManager_;
+    std::unique_ptr<curve::common::TaskThreadPool<>> s3ioPool_;
+    std::unique_ptr<S3CompactInflightThrottle> inflightThrottle_;
 
     S3CompactWorkerContext workerContext_;
     S3CompactWorkerOptions workerOptions_;
 
     std::vector<std::unique_ptr<S3CompactWorker>> workers_;
 
+    bvar::PassiveStatus<uint64_t> pendingPartitions_;
+    bvar::PassiveStatus<uint64_t> inflightBytes_;
+
     bool inited_{false};
 
-    S3CompactManager() = default;
+    S3CompactManager();
     ~S3CompactManager() = default;
 
  public:
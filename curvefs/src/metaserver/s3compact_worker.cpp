@@ -39,6 +39,27 @@
 namespace curvefs {
 namespace metaserver {
 
+void S3CompactInflightThrottle::OnStart(uint64_t len) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    cond_.wait(lock, [this, len]() {
+        return inflightBytes_ == 0 || inflightBytes_ + len <= maxInflightBytes_;
+    });
+    inflightBytes_ += len;
+}
+
+void S3CompactInflightThrottle::OnComplete(uint64_t len) {
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        inflightBytes_ -= len;
+    }
+    cond_.notify_all();
+}
+
+uint64_t S3CompactInflightThrottle::InflightBytes() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return inflightBytes_;
+}
+
 S3CompactWorker::S3CompactWorker(S3CompactManager* manager,
                                  S3CompactWorkerContext* context,
                                  S3CompactWorkerOptions* options)
@@ -32,6 +32,7 @@
 
 #include "absl/types/optional.h"
 #include "curvefs/src/metaserver/s3compact.h"
+#include "src/common/concurrent/task_thread_pool.h"
 #include "src/common/interruptible_sleeper.h"
 
 namespace curvefs {
@@ -57,10 +58,38 @@ struct S3CompactWorkerContext {
     std::map<uint32_t, S3CompactWorker*> compacting;
 };
 
+// Limit the inflight bytes of s3 requests issued by all compact workers
+class S3CompactInflightThrottle {
+ public:
+    explicit S3CompactInflightThrottle(uint64_t maxInflightBytes)
+        : maxInflightBytes_(maxInflightBytes), inflightBytes_(0) {}
+
+    // Block until there is enough budget, a request larger than the budget
+    // is allowed when nothing else is inflight
+    void OnStart(uint64_t len);
+
+    void OnComplete(uint64_t len);
+
+    uint64_t InflightBytes();
+
+ private:
+    const uint64_t maxInflightBytes_;
+    uint64_t inflightBytes_;
+
+    std::mutex mtx_;
+    std::condition_variable cond_;
+};
+
 struct S3CompactWorkerOptions {
     S3AdapterManager* s3adapterManager;
     S3InfoCache* s3infoCache;
 
+    // shared by all workers to issue s3 requests of a chunk concurrently,
+    // if it's nullptr, requests are issued one by one
+    curve::common::TaskThreadPool<>* s3ioPool = nullptr;
+    // shared by all workers to limit total inflight bytes, can be nullptr
+    S3CompactInflightThrottle* inflightThrottle = nullptr;
+
     uint64_t maxChunksPerCompact;
     uint64_t fragmentThreshold;
     uint64_t s3ReadMaxRetry;
@@ -47,6 +47,10 @@ struct StorageOptions {
     // only memory storage interested the below config item
     bool compression;
 
+    // max number of delta files after a base file in memory checkpoint,
+    // they are merged into a new base file in background once reach it
+    uint32_t maxCheckpointDeltaFiles = 8;
+
     // only rocksdb storage interested the below config item
     uint64_t statsDumpPeriodSec;
 
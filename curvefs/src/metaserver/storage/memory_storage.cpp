@@ -21,18 +21,31 @@
  */
 
 #include <glog/logging.h>
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
+#include "absl/strings/str_cat.h"
+#include "butil/errno.h"
+#include "src/fs/local_filesystem.h"
 #include "curvefs/src/metaserver/storage/utils.h"
+#include "curvefs/src/metaserver/storage/dumpfile.h"
 #include "curvefs/src/metaserver/storage/memory_storage.h"
 
 namespace curvefs {
 namespace metaserver {
 namespace storage {
 
+using ::curve::common::LockGuard;
 using ::curve::common::ReadLockGuard;
+using ::curve::common::StringToUll;
 using ::curve::common::WriteLockGuard;
 using UnorderedContainerType =
     MemoryStorage::UnorderedContainerType;
@@ -44,7 +57,14 @@ using OrderedSeralizedContainerType =
     MemoryStorage::OrderedSeralizedContainerType;
 
 MemoryStorage::MemoryStorage(StorageOptions options)
-    : options_(options) {}
+    : options_(options),
+      checkpointSeq_(0),
+      needFullCheckpoint_(false),
+      compacting_(false) {}
+
+MemoryStorage::~MemoryStorage() {
+    WaitCompaction();
+}
 
 STORAGE_TYPE MemoryStorage::Type() {
     return STORAGE_TYPE::MEMORY_STORAGE;
@@ -55,6 +75,7 @@ bool MemoryStorage::Open() {
 }
 
 bool MemoryStorage::Close() {
+    WaitCompaction();
     return true;
 }
 
@@ -130,6 +151,33 @@ do {                                            \
 } while (0)
 
 
+#define MERGE(TYPE, NAME, KEY, VALUE)                       \
+do {                                                        \
+    auto container = GET_CONTAINER(TYPE, NAME);             \
+    auto iter = container->find(KEY);                       \
+    if (iter == container->end()) {                         \
+        return Status::NotFound();                          \
+    }                                                       \
+    iter->second.MutableMessage()->MergeFrom(VALUE);        \
+    return Status::OK();                                    \
+} while (0)
+
+
+// concatenating serialized messages is equivalent to merging them
+#define MERGE_SERALIZED(TYPE, NAME, KEY, VALUE)             \
+do {                                                        \
+    auto container = GET_CONTAINER(TYPE, NAME);             \
+    auto iter = container->find(KEY);                       \
+    if (iter == container->end()) {                         \
+        return Status::NotFound();                          \
+    }                                                       \
+    if (!VALUE.AppendPartialToString(&iter->second)) {      \
+        return Status::SerializedFailed();                  \
+    }                                                       \
+    return Status::OK();                                    \
+} while (0)
+
+
 #define DEL(TYPE, NAME, KEY)                    \
 do {                                            \
     auto container = GET_CONTAINER(TYPE, NAME); \
@@ -141,6 +189,17 @@ do {                                            \
 } while (0)
 
 
+#define EXIST(TYPE, NAME, KEY)                  \
+do {                                            \
+    auto container = GET_CONTAINER(TYPE, NAME); \
+    auto iter = container->find(KEY);           \
+    if (iter == container->end()) {             \
+        return Status::NotFound();              \
+    }                                           \
+    return Status::OK();                        \
+} while (0)
+
+
 #define SEEK(TYPE, NAME, PREFIX)                                            \
 do {                                                                        \
     auto container = GET_CONTAINER(TYPE, NAME);                             \
@@ -182,6 +241,7 @@ Status MemoryStorage::HGet(const std::string& name,
 Status MemoryStorage::HSet(const std::string& name,
                            const std::string& key,
                            const ValueType& value) {
+    MarkDirty(&hashDirty_, name, key);
     if (options_.compression) {
         SET_SERALIZED(UnorderedSeralizedContainer, name, key, value);
         return Status::OK();
@@ -191,6 +251,7 @@ Status MemoryStorage::HSet(const std::string& name,
 
 Status MemoryStorage::HDel(const std::string& name,
                            const std::string& key) {
+    MarkDirty(&hashDirty_, name, key);
     if (options_.compression) {
         DEL(UnorderedSeralizedContainer, name, key);
         return Status::OK();
@@ -198,6 +259,26 @@ Status MemoryStorage::HDel(const std::string& name,
     DEL(UnorderedContainer, name, key);
 }
 
+Status MemoryStorage::HExist(const std::string& name,
+                             const std::string& key) {
+    if (options_.compression) {
+        EXIST(UnorderedSeralizedContainer, name, key);
+        return Status::OK();
+    }
+    EXIST(UnorderedContainer, name, key);
+}
+
+Status MemoryStorage::HMerge(const std::string& name,
+                             const std::string& key,
+                             const ValueType& value) {
+    MarkDirty(&hashDirty_, name, key);
+    if (options_.compression) {
+        MERGE_SERALIZED(UnorderedSeralizedContainer, name, key, value);
+        return Status::OK();
+    }
+    MERGE(UnorderedContainer, name, key, value);
+}
+
 std::shared_ptr<Iterator> MemoryStorage::HGetAll(const std::string& name) {
     if (options_.compression) {
         GET_ALL(UnorderedSeralizedContainer, name);
@@ -215,6 +296,7 @@ size_t MemoryStorage::HSize(const std::string& name) {
 }
 
 Status MemoryStorage::HClear(const std::string& name) {
+    MarkCleared(&hashDirty_, name);
     if (options_.compression) {
         CLEAR(UnorderedSeralizedContainer, name);
         return Status::OK();
@@ -235,6 +317,7 @@ Status MemoryStorage::SGet(const std::string& name,
 Status MemoryStorage::SSet(const std::string& name,
                            const std::string& key,
                            const ValueType& value) {
+    MarkDirty(&sortedDirty_, name, key);
     if (options_.compression) {
         SET_SERALIZED(OrderedSeralizedContainer, name, key, value);
         return Status::OK();
@@ -243,6 +326,7 @@ Status MemoryStorage::SSet(const std::string& name,
 }
 
 Status MemoryStorage::SDel(const std::string& name, const std::string& key) {
+    MarkDirty(&sortedDirty_, name, key);
     if (options_.compression) {
         DEL(OrderedSeralizedContainer, name, key);
         return Status::OK();
@@ -276,6 +360,7 @@ size_t MemoryStorage::SSize(const std::string& name) {
 }
 
 Status MemoryStorage::SClear(const std::string& name) {
+    MarkCleared(&sortedDirty_, name);
     if (options_.compression) {
         CLEAR(OrderedSeralizedContainer, name);
         return Status::OK();
@@ -299,15 +384,704 @@ StorageOptions MemoryStorage::GetStorageOptions() const {
     return options_;
 }
 
+namespace {
+
+const char* const kMemoryCheckpointPath = "memory_checkpoint";
+const char* const kBaseFilePrefix = "base.";
+const char* const kDeltaFilePrefix = "delta.";
+
+/*
+ * checkpoint entry format:
+ *
+ * key:
+ *   +----+------+----------+---+------+-----+
+ *   | op | kind | name_len | : | name | key |
+ *   +----+------+----------+---+------+-----+
+ *      op:   kOpSet / kOpDel / kOpClear (1-byte)
+ *      kind: kKindHash / kKindSorted (1-byte)
+ *
+ * value of kOpDel / kOpClear is kNoValue, because empty string will be
+ * taken as EOF by dumpfile
+ *
+ * value of kOpSet:
+ *   +----------+---+-----------+-------+
+ *   | type_len | : | type_name | bytes |
+ *   +----------+---+-----------+-------+
+ *      type_name: full name of protobuf message, empty if the value
+ *                 comes from a compressed (serialized) container
+ */
+const char kOpSet = 'S';
+const char kOpDel = 'D';
+const char kOpClear = 'C';
+const char kKindHash = 'h';
+const char kKindSorted = 's';
+const char* const kNoValue = "-";
+
+std::string EncodeKey(char op, bool ordered,
+                      const std::string& name,
+                      const std::string& key) {
+    return absl::StrCat(std::string(1, op),
+                        std::string(1, ordered ? kKindSorted : kKindHash),
+                        name.size(), ":", name, key);
+}
+
+bool DecodeKey(const std::string& ekey, char* op, bool* ordered,
+               std::string* name, std::string* key) {
+    if (ekey.size() < 2) {
+        return false;
+    }
+    auto pos = ekey.find(':', 2);
+    uint64_t length = 0;
+    if (pos == std::string::npos ||
+        !StringToUll(ekey.substr(2, pos - 2), &length) ||
+        pos + 1 + length > ekey.size()) {
+        return false;
+    }
+
+    *op = ekey[0];
+    *ordered = (ekey[1] == kKindSorted);
+    *name = ekey.substr(pos + 1, length);
+    *key = ekey.substr(pos + 1 + length);
+    return true;
+}
+
+bool EncodeValue(const ValueType* message, std::string* evalue) {
+    std::string bytes;
+    if (!message->SerializeToString(&bytes)) {
+        return false;
+    }
+    const auto& typeName = message->GetDescriptor()->full_name();
+    *evalue = absl::StrCat(typeName.size(), ":", typeName, bytes);
+    return true;
+}
+
+std::string EncodeValue(const std::string& bytes) {
+    return absl::StrCat("0:", bytes);
+}
+
+bool DecodeValue(const std::string& evalue,
+                 std::string* typeName,
+                 std::string* bytes) {
+    auto pos = evalue.find(':');
+    uint64_t length = 0;
+    if (pos == std::string::npos ||
+        !StringToUll(evalue.substr(0, pos), &length) ||
+        pos + 1 + length > evalue.size()) {
+        return false;
+    }
+
+    *typeName = evalue.substr(pos + 1, length);
+    *bytes = evalue.substr(pos + 1 + length);
+    return true;
+}
+
+bool ParseCheckpointSeq(const std::string& filename,
+                        const std::string& prefix,
+                        uint64_t* seq) {
+    return StringStartWith(filename, prefix) &&
+           StringToUll(filename.substr(prefix.size()), seq);
+}
+
+// Rewrite entries of a table into checkpoint entries
+class CheckpointEntryIterator : public Iterator {
+ public:
+    CheckpointEntryIterator(bool ordered,
+                            const std::string& name,
+                            std::shared_ptr<Iterator> iterator)
+        : ordered_(ordered),
+          name_(name),
+          iterator_(std::move(iterator)),
+          status_(0) {}
+
+    uint64_t Size() override {
+        return iterator_->Size();
+    }
+
+    bool Valid() override {
+        return status_ == 0 && iterator_->Valid();
+    }
+
+    void SeekToFirst() override {
+        iterator_->SeekToFirst();
+    }
+
+    void Next() override {
+        iterator_->Next();
+    }
+
+    std::string Key() override {
+        return EncodeKey(kOpSet, ordered_, name_, iterator_->Key());
+    }
+
+    std::string Value() override {
+        const ValueType* message = iterator_->RawValue();
+        if (nullptr == message) {
+            return EncodeValue(iterator_->Value());
+        }
+
+        std::string evalue;
+        if (!EncodeValue(message, &evalue)) {
+            status_ = -1;
+        }
+        return evalue;
+    }
+
+    int Status() override {
+        return status_ != 0 ? status_ : iterator_->Status();
+    }
+
+ private:
+    bool ordered_;
+    std::string name_;
+    std::shared_ptr<Iterator> iterator_;
+    int status_;
+};
+
+template <typename ContainerType>
+bool LookupEncodedValue(const std::shared_ptr<ContainerType>& container,
+                        const std::string& key,
+                        std::string* evalue) {
+    auto iter = container->find(key);
+    if (iter == container->end()) {
+        return false;
+    }
+    return EncodeValue(iter->second.Message(), evalue);
+}
+
+template <typename SeralizedContainerType>
+bool LookupEncodedSeralizedValue(
+    const std::shared_ptr<SeralizedContainerType>& container,
+    const std::string& key,
+    std::string* evalue) {
+    auto iter = container->find(key);
+    if (iter == container->end()) {
+        return false;
+    }
+    *evalue = EncodeValue(iter->second);
+    return true;
+}
+
+bool SaveCheckpointFile(LocalFileSystem* fs,
+                        const std::string& pathname,
+                        std::shared_ptr<Iterator> iterator) {
+    // the previous file with same name may be hard linked by a snapshot,
+    // so unlink it instead of overwriting
+    if (fs->FileExists(pathname) && fs->Delete(pathname) != 0) {
+        LOG(ERROR) << "Failed to delete stale checkpoint file: " << pathname;
+        return false;
+    }
+
+    auto dumpfile = DumpFile(pathname);
+    if (dumpfile.Open() != DUMPFILE_ERROR::OK) {
+        LOG(ERROR) << "Failed to open checkpoint file: " << pathname;
+        return false;
+    }
+
+    auto rc = dumpfile.Save(iterator);
+    dumpfile.Close();
+    if (rc != DUMPFILE_ERROR::OK || iterator->Status() != 0) {
+        LOG(ERROR) << "Failed to save checkpoint file: " << pathname
+                   << ", retCode = " << rc;
+        return false;
+    }
+    return true;
+}
+
+// Call |handler| with each entry of the checkpoint file
+bool LoadCheckpointFile(
+    const std::string& pathname,
+    const std::function<bool(const std::string&, const std::string&)>&
+        handler) {
+    auto dumpfile = DumpFile(pathname);
+    if (dumpfile.Open() != DUMPFILE_ERROR::OK) {
+        LOG(ERROR) << "Failed to open checkpoint file: " << pathname;
+        return false;
+    }
+
+    uint64_t nEntry = 0;
+    auto iter = dumpfile.Load();
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+        if (!handler(iter->Key(), iter->Value())) {
+            dumpfile.Close();
+            return false;
+        }
+        nEntry++;
+    }
+    dumpfile.Close();
+
+    if (dumpfile.GetLoadStatus() != DUMPFILE_LOAD_STATUS::COMPLETE) {
+        LOG(ERROR) << "Load checkpoint file " << pathname
+                   << " failed, status = " << dumpfile.GetLoadStatus();
+        return false;
+    }
+
+    LOG(INFO) << "Loaded checkpoint file " << pathname
+              << ", entries: " << nEntry;
+    return true;
+}
+
+template <typename DirtyTables>
+void MergeDirtyTables(const DirtyTables& from, DirtyTables* to) {
+    for (const auto& item : from) {
+        auto& table = (*to)[item.first];
+        table.cleared = table.cleared || item.second.cleared;
+        table.keys.insert(item.second.keys.begin(), item.second.keys.end());
+    }
+}
+
+}  // namespace
+
+void MemoryStorage::MarkDirty(DirtyTables* tables,
+                              const std::string& name,
+                              const std::string& key) {
+    LockGuard lk(dirtyMutex_);
+    (*tables)[name].keys.insert(key);
+}
+
+void MemoryStorage::MarkCleared(DirtyTables* tables,
+                                const std::string& name) {
+    LockGuard lk(dirtyMutex_);
+    auto& table = (*tables)[name];
+    table.cleared = true;
+    table.keys.clear();
+}
+
+void MemoryStorage::ResetDirty() {
+    LockGuard lk(dirtyMutex_);
+    hashDirty_.clear();
+    sortedDirty_.clear();
+}
+
+std::shared_ptr<Iterator> MemoryStorage::NewBaseIterator() {
+    MergeIterator::ChildrenType children;
+
+#define ADD_CHILDREN(TYPE, ORDERED)                                        \
+    for (const auto& item : TYPE##Dict_) {                                 \
+        auto iterator = std::make_shared<TYPE##Iterator<TYPE##Type>>(      \
+            item.second, "");                                              \
+        children.push_back(std::make_shared<CheckpointEntryIterator>(      \
+            ORDERED, item.first, iterator));                               \
+    }
+
+    ReadLockGuard readLockGuard(rwLock_);
+    if (options_.compression) {
+        ADD_CHILDREN(UnorderedSeralizedContainer, false);
+        ADD_CHILDREN(OrderedSeralizedContainer, true);
+    } else {
+        ADD_CHILDREN(UnorderedContainer, false);
+        ADD_CHILDREN(OrderedContainer, true);
+    }
+
+#undef ADD_CHILDREN
+
+    return std::make_shared<MergeIterator>(children);
+}
+
+bool MemoryStorage::GetEncodedValue(bool ordered,
+                                    const std::string& name,
+                                    const std::string& key,
+                                    std::string* evalue) {
+    if (options_.compression) {
+        if (ordered) {
+            return LookupEncodedSeralizedValue(
+                GET_CONTAINER(OrderedSeralizedContainer, name), key, evalue);
+        }
+        return LookupEncodedSeralizedValue(
+            GET_CONTAINER(UnorderedSeralizedContainer, name), key, evalue);
+    }
+
+    if (ordered) {
+        return LookupEncodedValue(
+            GET_CONTAINER(OrderedContainer, name), key, evalue);
+    }
+    return LookupEncodedValue(
+        GET_CONTAINER(UnorderedContainer, name), key, evalue);
+}
+
+std::shared_ptr<Iterator> MemoryStorage::NewDeltaIterator(
+    const DirtyTables& hashDirty, const DirtyTables& sortedDirty) {
+    using EntryList = std::vector<std::pair<std::string, std::string>>;
+    auto entries = std::make_shared<EntryList>();
+
+    // clear must be replayed before the modifications of the table
+    auto addClears = [&](const DirtyTables& tables, bool ordered) {
+        for (const auto& item : tables) {
+            if (item.second.cleared) {
+                entries->emplace_back(
+                    EncodeKey(kOpClear, ordered, item.first, ""), kNoValue);
+            }
+        }
+    };
+
+    auto addModifications = [&](const DirtyTables& tables, bool ordered) {
+        std::string evalue;
+        for (const auto& item : tables) {
+            for (const auto& key : item.second.keys) {
+                if (GetEncodedValue(ordered, item.first, key, &evalue)) {
+                    entries->emplace_back(
+                        EncodeKey(kOpSet, ordered, item.first, key), evalue);
+                } else {
+                    entries->emplace_back(
+                        EncodeKey(kOpDel, ordered, item.first, key), kNoValue);
+                }
+            }
+        }
+    };
+
+    addClears(hashDirty, false);
+    addClears(sortedDirty, true);
+    addModifications(hashDirty, false);
+    addModifications(sortedDirty, true);
+    return std::make_shared<ContainerIterator<EntryList>>(entries);
+}
+
+bool MemoryStorage::LinkCheckpointFiles(const std::string& dir,
+                                        std::vector<std::string>* files) {
+    auto* fs = options_.localFileSystem;
+    const std::string src = options_.dataDir + "/" + kMemoryCheckpointPath;
+    const std::string dest = dir + "/" + kMemoryCheckpointPath;
+    if (fs->Mkdir(dest) != 0) {
+        LOG(ERROR) << "Failed to create checkpoint dir: " << dest;
+        return false;
+    }
+
+    files->reserve(files->size() + checkpointFiles_.size());
+    for (const auto& f : checkpointFiles_) {
+        const std::string from = src + "/" + f;
+        const std::string to = dest + "/" + f;
+        if (::link(from.c_str(), to.c_str()) != 0) {
+            LOG(ERROR) << "Failed to link checkpoint file from `" << from
+                       << "` to `" << to << "`, " << berror();
+            return false;
+        }
+        files->push_back(std::string(kMemoryCheckpointPath) + "/" + f);
+    }
+
+    return true;
+}
+
 bool MemoryStorage::Checkpoint(const std::string& dir,
                                std::vector<std::string>* files) {
-    LOG(WARNING) << "Not supported";
-    return false;
+    auto* fs = options_.localFileSystem;
+    const std::string src = options_.dataDir + "/" + kMemoryCheckpointPath;
+    if (fs->Mkdir(src) != 0) {
+        LOG(ERROR) << "Failed to create checkpoint dir: " << src;
+        return false;
+    }
+
+    DirtyTables hashDirty;
+    DirtyTables sortedDirty;
+    {
+        LockGuard lk(dirtyMutex_);
+        hashDirty.swap(hashDirty_);
+        sortedDirty.swap(sortedDirty_);
+    }
+
+    LockGuard checkpointLock(checkpointMutex_);
+    // the storage is empty when it starts tracking modified keys, so the
+    // first delta contains all the data and can be used as the base file
+    bool base = checkpointFiles_.empty();
+    std::string filename = absl::StrCat(
+        base ? kBaseFilePrefix : kDeltaFilePrefix, checkpointSeq_);
+    auto iterator = needFullCheckpoint_
+                        ? NewBaseIterator()
+                        : NewDeltaIterator(hashDirty, sortedDirty);
+    if (!SaveCheckpointFile(fs, src + "/" + filename, iterator)) {
+        // keep the modifications for the next checkpoint
+        LockGuard lk(dirtyMutex_);
+        MergeDirtyTables(hashDirty, &hashDirty_);
+        MergeDirtyTables(sortedDirty, &sortedDirty_);
+        return false;
+    }
+
+    checkpointSeq_++;
+    needFullCheckpoint_ = false;
+    checkpointFiles_.push_back(filename);
+
+    LOG(INFO) << "Checkpoint memory storage to `" << dir << "` success, "
+              << (base ? "base" : "delta") << " file: " << filename
+              << ", total files: " << checkpointFiles_.size();
+    if (!LinkCheckpointFiles(dir, files)) {
+        return false;
+    }
+
+    if (checkpointFiles_.size() > 1 &&
+        checkpointFiles_.size() > options_.maxCheckpointDeltaFiles &&
+        !compacting_.exchange(true)) {
+        // the previous compaction has finished, join it before reusing
+        if (compactThread_.joinable()) {
+            compactThread_.join();
+        }
+        compactThread_ = std::thread(&MemoryStorage::CompactCheckpointFiles,
+                                     this, checkpointFiles_);
+    }
+    return true;
+}
+
+void MemoryStorage::CompactCheckpointFiles(std::vector<std::string> files) {
+    auto* fs = options_.localFileSystem;
+    const std::string src = options_.dataDir + "/" + kMemoryCheckpointPath;
+
+    // the merged base equals the state of the last delta, so it takes the
+    // sequence number of the last delta, and the deltas after it are
+    // still applied on it when recovering
+    uint64_t seq = 0;
+    if (!ParseCheckpointSeq(files.back(), kDeltaFilePrefix, &seq)) {
+        LOG(ERROR) << "Invalid last checkpoint file: " << files.back();
+        compacting_ = false;
+        return;
+    }
+    const std::string filename = absl::StrCat(kBaseFilePrefix, seq);
+
+    // all kOpSet entries of a table share the prefix encoded by the table,
+    // so clearing a table is erasing a range in the ordered entries
+    using EntryMap = absl::btree_map<std::string, std::string>;
+    auto entries = std::make_shared<EntryMap>();
+    auto merge = [&entries](const std::string& ekey,
+                            const std::string& evalue) {
+        char op;
+        bool ordered;
+        std::string name, key;
+        if (!DecodeKey(ekey, &op, &ordered, &name, &key)) {
+            LOG(ERROR) << "Invalid checkpoint entry key: " << ekey;
+            return false;
+        }
+
+        if (op == kOpSet) {
+            (*entries)[ekey] = evalue;
+        } else if (op == kOpDel) {
+            entries->erase(EncodeKey(kOpSet, ordered, name, key));
+        } else if (op == kOpClear) {
+            const std::string prefix = EncodeKey(kOpSet, ordered, name, "");
+            auto iter = entries->lower_bound(prefix);
+            while (iter != entries->end() &&
+                   StringStartWith(iter->first, prefix)) {
+                iter = entries->erase(iter);
+            }
+        } else {
+            LOG(ERROR) << "Unknown checkpoint entry op: " << op;
+            return false;
+        }
+        return true;
+    };
+
+    bool succ = true;
+    for (const auto& f : files) {
+        if (!LoadCheckpointFile(src + "/" + f, merge)) {
+            succ = false;
+            break;
+        }
+    }
+    succ = succ && SaveCheckpointFile(
+        fs, src + "/" + filename,
+        std::make_shared<ContainerIterator<EntryMap>>(entries));
+    if (!succ) {
+        LOG(ERROR) << "Failed to compact memory checkpoint files into "
+                   << filename << ", retry at next checkpoint";
+        compacting_ = false;
+        return;
+    }
+
+    {
+        // checkpoint files are only removed by compaction, so |files| is
+        // still the prefix of the checkpoint files
+        LockGuard lk(checkpointMutex_);
+        checkpointFiles_.erase(checkpointFiles_.begin(),
+                               checkpointFiles_.begin() + files.size());
+        checkpointFiles_.insert(checkpointFiles_.begin(), filename);
+    }
+
+    // files of previous snapshots are still reachable by hard links
+    for (const auto& f : files) {
+        if (fs->Delete(src + "/" + f) != 0) {
+            LOG(WARNING) << "Failed to delete checkpoint file: " << f;
+        }
+    }
+
+    LOG(INFO) << "Compacted " << files.size() << " memory checkpoint files "
+              << "into " << filename << ", entries: " << entries->size();
+    compacting_ = false;
+}
+
+void MemoryStorage::WaitCompaction() {
+    if (compactThread_.joinable()) {
+        compactThread_.join();
+    }
+}
+
+bool MemoryStorage::LinkRecoveredFiles(
+    const std::string& dir, const std::vector<std::string>& files) {
+    auto* fs = options_.localFileSystem;
+    const std::string src = dir + "/" + kMemoryCheckpointPath;
+    const std::string dest = options_.dataDir + "/" + kMemoryCheckpointPath;
+    if (fs->Mkdir(dest) != 0) {
+        LOG(ERROR) << "Failed to create checkpoint dir: " << dest;
+        return false;
+    }
+
+    for (const auto& f : files) {
+        const std::string from = src + "/" + f;
+        const std::string to = dest + "/" + f;
+        if (fs->FileExists(to) && fs->Delete(to) != 0) {
+            LOG(ERROR) << "Failed to delete stale checkpoint file: " << to;
+            return false;
+        }
+        if (::link(from.c_str(), to.c_str()) != 0) {
+            LOG(ERROR) << "Failed to link checkpoint file from `" << from
+                       << "` to `" << to << "`, " << berror();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MemoryStorage::ApplyCheckpointEntry(const std::string& ekey,
+                                         const std::string& evalue) {
+    char op;
+    bool ordered;
+    std::string name, key;
+    if (!DecodeKey(ekey, &op, &ordered, &name, &key)) {
+        LOG(ERROR) << "Invalid checkpoint entry key: " << ekey;
+        return false;
+    }
+
+    if (op == kOpClear) {
+        return (ordered ? SClear(name) : HClear(name)).ok();
+    } else if (op == kOpDel) {
+        return (ordered ? SDel(name, key) : HDel(name, key)).ok();
+    } else if (op != kOpSet) {
+        LOG(ERROR) << "Unknown checkpoint entry op: " << op;
+        return false;
+    }
+
+    std::string typeName, bytes;
+    if (!DecodeValue(evalue, &typeName, &bytes)) {
+        LOG(ERROR) << "Invalid checkpoint entry value, key: " << ekey;
+        return false;
+    }
+
+    if (typeName.empty()) {
+        // the value is saved from a compressed container, it can only be
+        // recovered to a compressed container
+        if (!options_.compression) {
+            LOG(ERROR) << "Can't recover serialized value into "
+                       << "uncompressed memory storage";
+            return false;
+        }
+        if (ordered) {
+            (*GET_CONTAINER(OrderedSeralizedContainer, name))[key] = bytes;
+        } else {
+            (*GET_CONTAINER(UnorderedSeralizedContainer, name))[key] = bytes;
+        }
+        return true;
+    }
+
+    const auto* descriptor =
+        google::protobuf::DescriptorPool::generated_pool()
+            ->FindMessageTypeByName(typeName);
+    if (nullptr == descriptor) {
+        LOG(ERROR) << "Unknown message type: " << typeName;
+        return false;
+    }
+    std::unique_ptr<ValueType> message(
+        google::protobuf::MessageFactory::generated_factory()
+            ->GetPrototype(descriptor)->New());
+    if (!message->ParseFromString(bytes)) {
+        LOG(ERROR) << "Failed to parse message, type: " << typeName;
+        return false;
+    }
+
+    return (ordered ? SSet(name, key, *message)
+                    : HSet(name, key, *message)).ok();
+}
+
+bool MemoryStorage::ApplyCheckpointFile(const std::string& pathname) {
+    return LoadCheckpointFile(
+        pathname, [this](const std::string& ekey, const std::string& evalue) {
+            return ApplyCheckpointEntry(ekey, evalue);
+        });
 }
 
 bool MemoryStorage::Recover(const std::string& dir) {
-    LOG(WARNING) << "Not supported";
-    return false;
+    LOG(INFO) << "Recovering storage from `" << dir << "`";
+
+    // the compaction may remove the files of the current checkpoint
+    WaitCompaction();
+
+    const std::string src = dir + "/" + kMemoryCheckpointPath;
+    std::vector<std::string> filenames;
+    if (options_.localFileSystem->List(src, &filenames) != 0) {
+        LOG(ERROR) << "Failed to list checkpoint files at `" << src << "`";
+        return false;
+    }
+
+    // a snapshot only contains one base file and the deltas after it
+    bool hasBase = false;
+    uint64_t seq = 0, baseSeq = 0;
+    std::map<uint64_t, std::string> deltas;
+    for (const auto& f : filenames) {
+        if (ParseCheckpointSeq(f, kBaseFilePrefix, &seq)) {
+            if (hasBase) {
+                LOG(ERROR) << "Found multiple base files at `" << src << "`";
+                return false;
+            }
+            hasBase = true;
+            baseSeq = seq;
+        } else if (ParseCheckpointSeq(f, kDeltaFilePrefix, &seq)) {
+            deltas.emplace(seq, f);
+        }
+    }
+
+    if (!hasBase) {
+        LOG(ERROR) << "Base checkpoint file not found at `" << src << "`";
+        return false;
+    }
+
+    {
+        WriteLockGuard writeLockGuard(rwLock_);
+        UnorderedContainerDict_.clear();
+        UnorderedSeralizedContainerDict_.clear();
+        OrderedContainerDict_.clear();
+        OrderedSeralizedContainerDict_.clear();
+    }
+
+    bool succ = ApplyCheckpointFile(
+        src + "/" + absl::StrCat(kBaseFilePrefix, baseSeq));
+    for (auto it = deltas.upper_bound(baseSeq);
+         succ && it != deltas.end(); ++it) {
+        succ = ApplyCheckpointFile(src + "/" + it->second);
+    }
+
+    ResetDirty();
+    LockGuard lk(checkpointMutex_);
+    checkpointFiles_.clear();
+    if (!succ) {
+        LOG(ERROR) << "Failed to recover memory storage from `" << dir << "`";
+        needFullCheckpoint_ = true;
+        return false;
+    }
+
+    // the recovered files are the base of the following checkpoints,
+    // otherwise the next checkpoint has to dump all the data
+    std::vector<std::string> files{absl::StrCat(kBaseFilePrefix, baseSeq)};
+    uint64_t lastSeq = baseSeq;
+    for (auto it = deltas.upper_bound(baseSeq); it != deltas.end(); ++it) {
+        files.push_back(it->second);
+        lastSeq = it->first;
+    }
+    if (LinkRecoveredFiles(dir, files)) {
+        checkpointFiles_.swap(files);
+        checkpointSeq_ = std::max(checkpointSeq_, lastSeq + 1);
+        needFullCheckpoint_ = false;
+    } else {
+        LOG(WARNING) << "Failed to link recovered checkpoint files, "
+                     << "the next checkpoint will be a full one";
+        needFullCheckpoint_ = true;
+    }
+
+    LOG(INFO) << "Recovered memory storage from `" << dir << "`, "
+              << deltas.size() << " delta files";
+    return true;
 }
 
 }  // namespace storage
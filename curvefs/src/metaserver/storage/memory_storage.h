@@ -23,14 +23,18 @@
 #ifndef CURVEFS_SRC_METASERVER_STORAGE_MEMORY_STORAGE_H_
 #define CURVEFS_SRC_METASERVER_STORAGE_MEMORY_STORAGE_H_
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <thread>  // NOLINT
 #include <utility>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "absl/container/btree_map.h"
 #include "src/common/string_util.h"
+#include "src/common/concurrent/concurrent.h"
 #include "src/common/concurrent/rw_lock.h"
 #include "curvefs/proto/metaserver.pb.h"
 #include "curvefs/src/metaserver/storage/common.h"
@@ -42,6 +46,7 @@ namespace curvefs {
 namespace metaserver {
 namespace storage {
 
+using ::curve::common::Mutex;
 using ::curve::common::RWLock;
 using ::curve::common::StringStartWith;
 using ::curvefs::metaserver::Inode;
@@ -67,6 +72,8 @@ class MemoryStorage : public KVStorage, public StorageTransaction {
  public:
     explicit MemoryStorage(StorageOptions options);
 
+    ~MemoryStorage() override;
+
     STORAGE_TYPE Type() override;
 
     bool Open() override;
@@ -85,6 +92,12 @@ class MemoryStorage : public KVStorage, public StorageTransaction {
 
     Status HDel(const std::string& name, const std::string& key) override;
 
+    Status HExist(const std::string& name, const std::string& key) override;
+
+    Status HMerge(const std::string& name,
+                  const std::string& key,
+                  const ValueType& value) override;
+
     std::shared_ptr<Iterator> HGetAll(const std::string& name) override;
 
     size_t HSize(const std::string& name) override;
@@ -118,15 +131,87 @@ class MemoryStorage : public KVStorage, public StorageTransaction {
 
     Status Rollback() override;
 
+    // Checkpoint is incremental: only the keys modified since the previous
+    // checkpoint are dumped into a delta file, the first checkpoint of an
+    // empty storage is a delta on nothing and is saved as the base file.
+    // Once there are |options_.maxCheckpointDeltaFiles| deltas, the base and
+    // deltas are merged into a new base file by a background thread, which
+    // only reads the checkpoint files and never blocks the storage. Files are
+    // kept under |dataDir| and hard linked into |dir|, so the cost scales
+    // with the change rate.
+    // REQUIRES: no concurrent modification while checkpointing
     bool Checkpoint(const std::string& dir,
                     std::vector<std::string>* files) override;
 
+    // Recover storage from the base file and delta files under |dir|, the
+    // files are also linked into |dataDir| as the base of later checkpoints
     bool Recover(const std::string& dir) override;
 
+ private:
+    // Keys of a table modified since the last checkpoint
+    struct DirtyTable {
+        bool cleared = false;
+        std::unordered_set<std::string> keys;
+    };
+
+    using DirtyTables = std::unordered_map<std::string, DirtyTable>;
+
+    void MarkDirty(DirtyTables* tables,
+                   const std::string& name,
+                   const std::string& key);
+
+    void MarkCleared(DirtyTables* tables, const std::string& name);
+
+    void ResetDirty();
+
+    std::shared_ptr<Iterator> NewBaseIterator();
+
+    std::shared_ptr<Iterator> NewDeltaIterator(const DirtyTables& hashDirty,
+                                               const DirtyTables& sortedDirty);
+
+    bool GetEncodedValue(bool ordered,
+                         const std::string& name,
+                         const std::string& key,
+                         std::string* value);
+
+    bool ApplyCheckpointFile(const std::string& pathname);
+
+    bool ApplyCheckpointEntry(const std::string& ekey,
+                              const std::string& evalue);
+
+    bool LinkCheckpointFiles(const std::string& dir,
+                             std::vector<std::string>* files);
+
+    bool LinkRecoveredFiles(const std::string& dir,
+                            const std::vector<std::string>& files);
+
+    void CompactCheckpointFiles(std::vector<std::string> files);
+
+    void WaitCompaction();
+
  private:
     RWLock rwLock_;
     StorageOptions options_;
 
+    // protect hashDirty_ and sortedDirty_
+    Mutex dirtyMutex_;
+    DirtyTables hashDirty_;
+    DirtyTables sortedDirty_;
+
+    // sequence number of the next checkpoint file
+    uint64_t checkpointSeq_;
+    // protect checkpointFiles_
+    Mutex checkpointMutex_;
+    // base file and delta files (in order) of the latest checkpoint
+    std::vector<std::string> checkpointFiles_;
+    // the modified keys don't cover all the data (e.g. recovered from
+    // a snapshot but failed to link its files), the next checkpoint
+    // must dump all tables
+    bool needFullCheckpoint_;
+    // merge checkpoint files into a new base file
+    std::thread compactThread_;
+    std::atomic<bool> compacting_;
+
     std::unordered_map<std::string,
                        std::shared_ptr<UnorderedContainerType>>
         UnorderedContainerDict_;
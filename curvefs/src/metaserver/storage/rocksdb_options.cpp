@@ -24,12 +24,15 @@
 
 #include <gflags/gflags.h>
 
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
 
 #include "curvefs/src/metaserver/storage/rocksdb_event_listener.h"
 #include "curvefs/src/metaserver/storage/rocksdb_storage.h"
 #include "rocksdb/filter_policy.h"
+#include "rocksdb/merge_operator.h"
 #include "rocksdb/statistics.h"
 #include "rocksdb/table.h"
 #include "src/common/gflags_helper.h"
@@ -140,6 +143,51 @@ std::shared_ptr<MetricEventListener> GetMetricEventListener() {
     return metricEventListener;
 }
 
+// Values of unordered column family are serialized protobuf messages, and
+// concatenating serialized messages is equivalent to MergeFrom() when parsing,
+// so merging is simply appending operands to the existing value.
+// Merging into a nonexistent key yields an empty value, which is treated as
+// not found by RocksDBStorage.
+class ProtobufAppendOperator : public rocksdb::MergeOperator {
+ public:
+    bool FullMergeV2(const MergeOperationInput& input,
+                     MergeOperationOutput* output) const override {
+        output->new_value.clear();
+        if (input.existing_value == nullptr ||
+            input.existing_value->empty()) {
+            return true;
+        }
+
+        size_t size = input.existing_value->size();
+        for (const auto& operand : input.operand_list) {
+            size += operand.size();
+        }
+
+        output->new_value.reserve(size);
+        output->new_value.append(input.existing_value->data(),
+                                 input.existing_value->size());
+        for (const auto& operand : input.operand_list) {
+            output->new_value.append(operand.data(), operand.size());
+        }
+        return true;
+    }
+
+    bool PartialMergeMulti(const rocksdb::Slice& /*key*/,
+                           const std::deque<rocksdb::Slice>& operandList,
+                           std::string* newValue,
+                           rocksdb::Logger* /*logger*/) const override {
+        newValue->clear();
+        for (const auto& operand : operandList) {
+            newValue->append(operand.data(), operand.size());
+        }
+        return true;
+    }
+
+    const char* Name() const override {
+        return "CurvefsProtobufAppendOperator";
+    }
+};
+
 }  // namespace
 
 void InitRocksdbOptions(
@@ -207,6 +255,8 @@ void InitRocksdbOptions(
         FLAGS_rocksdb_unordered_cf_write_buffer_size;
     unorderedCfOptions.max_write_buffer_number =
         FLAGS_rocksdb_unordered_cf_max_write_buffer_number;
+    unorderedCfOptions.merge_operator =
+        std::make_shared<ProtobufAppendOperator>();
 
     columnFamilies->push_back(rocksdb::ColumnFamilyDescriptor{
         rocksdb::kDefaultColumnFamilyName, unorderedCfOptions});
@@ -94,6 +94,9 @@ std::ostream& operator<<(std::ostream& os, OPERATOR_TYPE type) {
         case OP_ROLLBACK_TRANSACTION:
             os << "ROLLBACK_TRANSACTION";
             break;
+        case OP_MERGE:
+            os << "MERGE";
+            break;
         default:
             os << "UNKNWON";
     }
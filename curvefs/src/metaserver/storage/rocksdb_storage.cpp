@@ -215,7 +215,10 @@ Status RocksDBStorage::Get(const std::string& name,
         s = InTransaction_ ? txn_->Get(dbReadOptions_, handle, ikey, &svalue) :
                              db_->Get(dbReadOptions_, handle, ikey, &svalue);
     }
-    if (s.ok() && !value->ParseFromString(svalue)) {
+    if (s.ok() && svalue.empty() && !ordered) {
+        // tombstone left by merging into a deleted key
+        return Status::NotFound();
+    } else if (s.ok() && !value->ParseFromString(svalue)) {
         return Status::ParsedFailed();
     }
     return ToStorageStatus(s);
@@ -257,6 +260,56 @@ Status RocksDBStorage::Del(const std::string& name,
     return ToStorageStatus(s);
 }
 
+Status RocksDBStorage::Exist(const std::string& name,
+                             const std::string& key,
+                             bool ordered) {
+    if (!inited_) {
+        return Status::DBClosed();
+    }
+
+    ROCKSDB_NAMESPACE::Status s;
+    ROCKSDB_NAMESPACE::PinnableSlice svalue;
+    std::string ikey = ToInternalKey(name, key, ordered);
+    auto handle = GetColumnFamilyHandle(ordered);
+    {
+        RocksDBPerfGuard guard(OP_GET);
+        s = InTransaction_ ? txn_->Get(dbReadOptions_, handle, ikey, &svalue) :
+                             db_->Get(dbReadOptions_, handle, ikey, &svalue);
+    }
+    if (s.ok() && svalue.empty() && !ordered) {
+        // tombstone left by merging into a deleted key, drop it
+        Status rc = Del(name, key, ordered);
+        return rc.ok() ? Status::NotFound() : rc;
+    }
+    return ToStorageStatus(s);
+}
+
+// NOTE: the value is serialized partially and appended to the stored one by
+// the merge operator of unordered column family, which has the same effect as
+// MergeFrom() after parsing. merging into a nonexistent key results in an
+// empty value, which Get() and iterator treat as not found.
+Status RocksDBStorage::Merge(const std::string& name,
+                             const std::string& key,
+                             const ValueType& value,
+                             bool ordered) {
+    std::string svalue;
+    if (!inited_) {
+        return Status::DBClosed();
+    } else if (ordered) {
+        return Status::NotSupported();
+    } else if (!value.SerializePartialToString(&svalue)) {
+        return Status::SerializedFailed();
+    }
+
+    auto handle = GetColumnFamilyHandle(ordered);
+    std::string ikey = ToInternalKey(name, key, ordered);
+    RocksDBPerfGuard guard(OP_MERGE);
+    ROCKSDB_NAMESPACE::Status s = InTransaction_ ?
+        txn_->Merge(handle, ikey, svalue) :
+        db_->Merge(dbWriteOptions_, handle, ikey, svalue);
+    return ToStorageStatus(s);
+}
+
 std::shared_ptr<Iterator> RocksDBStorage::Seek(const std::string& name,
                                                const std::string& prefix) {
     int status = inited_ ? 0 : -1;
@@ -94,6 +94,12 @@ class RocksDBStorage : public KVStorage, public StorageTransaction {
 
     Status HDel(const std::string& name, const std::string& key) override;
 
+    Status HExist(const std::string& name, const std::string& key) override;
+
+    Status HMerge(const std::string& name,
+                  const std::string& key,
+                  const ValueType& value) override;
+
     std::shared_ptr<Iterator> HGetAll(const std::string& name) override;
 
     size_t HSize(const std::string& name) override;
@@ -160,6 +166,15 @@ class RocksDBStorage : public KVStorage, public StorageTransaction {
                const std::string& key,
                bool ordered);
 
+    Status Exist(const std::string& name,
+                 const std::string& key,
+                 bool ordered);
+
+    Status Merge(const std::string& name,
+                 const std::string& key,
+                 const ValueType& value,
+                 bool ordered);
+
     std::shared_ptr<Iterator> Seek(const std::string& name,
                                    const std::string& prefix);
 
@@ -224,6 +239,17 @@ inline Status RocksDBStorage::HDel(const std::string& name,
     return Del(name, key, false);
 }
 
+inline Status RocksDBStorage::HExist(const std::string& name,
+                                     const std::string& key) {
+    return Exist(name, key, false);
+}
+
+inline Status RocksDBStorage::HMerge(const std::string& name,
+                                     const std::string& key,
+                                     const ValueType& value) {
+    return Merge(name, key, value, false);
+}
+
 inline std::shared_ptr<Iterator> RocksDBStorage::HGetAll(
     const std::string& name) {
     return GetAll(name, false);
@@ -336,11 +362,13 @@ class RocksDBStorageIterator : public Iterator {
 
         RocksDBPerfGuard guard(OP_ITERATOR_SEEK_TO_FIRST);
         iter_->Seek(prefix_);
+        SkipTombstones();
     }
 
     void Next() {
         RocksDBPerfGuard guard(OP_ITERATOR_NEXT);
         iter_->Next();
+        SkipTombstones();
     }
 
     std::string Key() {
@@ -373,6 +401,15 @@ class RocksDBStorageIterator : public Iterator {
         prefixChecking_ = false;
     }
 
+ private:
+    // merging into a deleted key of unordered column family leaves an
+    // empty value behind (see RocksDBStorage::Merge), which is invisible
+    void SkipTombstones() {
+        while (!ordered_ && Valid() && iter_->value().empty()) {
+            iter_->Next();
+        }
+    }
+
  private:
     std::string prefix_;
     uint64_t size_;
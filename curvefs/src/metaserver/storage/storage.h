@@ -53,6 +53,19 @@ class BaseStorage {
 
     virtual Status HDel(const std::string& name, const std::string& key) = 0;
 
+    // Check whether |key| exists without parsing its value,
+    // return Status::NotFound() if not
+    virtual Status HExist(const std::string& name,
+                          const std::string& key) = 0;
+
+    // Merge the fields set in |value| into the existing value of |key| like
+    // protobuf's MergeFrom() does, without reading the existing value if the
+    // storage supports it. |value| may be a partial message, and merging into
+    // a nonexistent key is dropped.
+    virtual Status HMerge(const std::string& name,
+                          const std::string& key,
+                          const ValueType& value) = 0;
+
     virtual std::shared_ptr<Iterator> HGetAll(const std::string& name) = 0;
 
     virtual size_t HSize(const std::string& name) = 0;
@@ -49,6 +49,8 @@ class ValueWrapper {
 
     const ValueType* Message() const { return value_.get(); }
 
+    ValueType* MutableMessage() { return value_.get(); }
+
     friend void swap(ValueWrapper& lhs, ValueWrapper& rhs) noexcept {
         return lhs.Swap(rhs);
     }
@@ -306,6 +306,49 @@ TEST_F(ChunkCacheManagerTest, test_read_by_read_cache) {
     delete dataCacheBuf;
 }
 
+TEST_F(ChunkCacheManagerTest, test_read_chunk_zero_copy) {
+    uint64_t len = 1024 * 1024;
+    char *dataCacheBuf = new char[len];
+    memset(dataCacheBuf, 'a', len);
+    auto dataCache = std::make_shared<DataCache>(
+        s3ClientAdaptor_, chunkCacheManager_, 0, len, dataCacheBuf, nullptr);
+    chunkCacheManager_->AddReadDataCache(dataCache);
+    memset(dataCacheBuf, 'b', len / 2);
+    auto dataCache1 = std::make_shared<DataCache>(
+        s3ClientAdaptor_, chunkCacheManager_, len, len / 2, dataCacheBuf,
+        nullptr);
+    chunkCacheManager_->AddReadDataCache(dataCache1);
+
+    // across two read caches
+    CachedDataRef ref;
+    uint64_t readLen = 768 * 1024;
+    ASSERT_TRUE(chunkCacheManager_->ReadChunkZeroCopy(512 * 1024, readLen,
+                                                      &ref));
+    ASSERT_EQ(readLen, ref.len);
+    ASSERT_EQ(2, ref.holders.size());
+    std::string data;
+    for (const auto &iov : ref.iov) {
+        data.append(static_cast<char *>(iov.iov_base), iov.iov_len);
+    }
+    ASSERT_EQ(std::string(512 * 1024, 'a') + std::string(256 * 1024, 'b'),
+              data);
+
+    // beyond the read cache
+    CachedDataRef missRef;
+    ASSERT_FALSE(chunkCacheManager_->ReadChunkZeroCopy(1024 * 1024 + 256 * 1024,
+                                                       512 * 1024, &missRef));
+    ASSERT_EQ(0, missRef.len);
+    ASSERT_TRUE(missRef.iov.empty());
+
+    // the write cache is mutable and can not be referenced
+    chunkCacheManager_->WriteNewDataCache(s3ClientAdaptor_, 0, 4096,
+                                          dataCacheBuf);
+    ASSERT_FALSE(chunkCacheManager_->ReadChunkZeroCopy(0, 4096, &missRef));
+    ASSERT_TRUE(chunkCacheManager_->ReadChunkZeroCopy(8192, 4096, &missRef));
+
+    delete[] dataCacheBuf;
+}
+
 TEST_F(ChunkCacheManagerTest, test_flush) {
     uint64_t inodeId = 1;
     uint64_t offset = 0;
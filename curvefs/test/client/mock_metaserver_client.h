@@ -119,6 +119,11 @@ class MockMetaServerClient : public MetaServerClient {
                       MetaServerClientDone* done,
                       DataIndices));
 
+    MOCK_METHOD3(BatchUpdateInodeAttrAsync,
+                 void(uint32_t,
+                      const std::vector<InodeAttrDelta>&,
+                      MetaServerClientDone*));
+
     MOCK_METHOD2(UpdateXattrAsync, void(const Inode &inode,
         MetaServerClientDone *done));
 
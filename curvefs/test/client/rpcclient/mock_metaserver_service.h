@@ -116,6 +116,13 @@ class MockMetaServerService : public curvefs::metaserver::MetaServerService {
              const ::curvefs::metaserver::UpdateVolumeExtentRequest *request,
              ::curvefs::metaserver::UpdateVolumeExtentResponse *response,
              ::google::protobuf::Closure *done));
+
+    MOCK_METHOD4(
+        BatchUpdateInodeAttr,
+        void(::google::protobuf::RpcController *controller,
+             const ::curvefs::metaserver::BatchUpdateInodeAttrRequest *request,
+             ::curvefs::metaserver::BatchUpdateInodeAttrResponse *response,
+             ::google::protobuf::Closure *done));
 };
 }  // namespace rpcclient
 }  // namespace client
@@ -146,6 +146,7 @@ TEST_F(MetaOperatorTest, OperatorTypeTest) {
     TEST_OPERATOR_TYPE(CreatePartition);
     TEST_OPERATOR_TYPE(DeletePartition);
     TEST_OPERATOR_TYPE(PrepareRenameTx);
+    TEST_OPERATOR_TYPE(BatchUpdateInodeAttr);
 
 #undef TEST_OPERATOR_TYPE
 }
@@ -193,6 +194,7 @@ TEST_F(MetaOperatorTest, OnApplyErrorTest) {
     OPERATOR_ON_APPLY_TEST(CreatePartition);
     OPERATOR_ON_APPLY_TEST(DeletePartition);
     OPERATOR_ON_APPLY_TEST(PrepareRenameTx);
+    OPERATOR_ON_APPLY_TEST(BatchUpdateInodeAttr);
 
 #undef OPERATOR_ON_APPLY_TEST
 
@@ -311,6 +313,7 @@ TEST_F(MetaOperatorTest, OnApplyFromLogErrorTest) {
     OPERATOR_ON_APPLY_FROM_LOG_TEST(CreatePartition);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(DeletePartition);
     OPERATOR_ON_APPLY_FROM_LOG_TEST(PrepareRenameTx);
+    OPERATOR_ON_APPLY_FROM_LOG_TEST(BatchUpdateInodeAttr);
 
 #undef OPERATOR_ON_APPLY_FROM_LOG_TEST
 
@@ -24,6 +24,7 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <google/protobuf/util/message_differencer.h>
+#include <list>
 #include <memory>
 
 #include "curvefs/test/metaserver/test_helper.h"
@@ -432,6 +433,65 @@ TEST_F(InodeManagerTest, UpdateInode) {
 }
 
 
+TEST_F(InodeManagerTest, UpdateInodeAttrDelta) {
+    uint32_t fsId = 1;
+    uint64_t ino = 2;
+
+    Inode inode;
+    ASSERT_EQ(MetaStatusCode::OK, manager->CreateInode(ino, param_, &inode));
+
+    // CASE 1: merge attributes and s3 chunk info into existing inode
+    InodeAttrDelta delta;
+    delta.set_inodeid(ino);
+    delta.set_length(4096);
+    delta.set_mtime(100);
+    (*delta.mutable_s3chunkinfoadd())[1] = GenS3ChunkInfoList(1, 1);
+    ASSERT_EQ(MetaStatusCode::OK, manager->UpdateInodeAttrDelta(fsId, delta));
+
+    Inode merged;
+    ASSERT_EQ(MetaStatusCode::OK, manager->GetInode(fsId, ino, &merged));
+    inode.set_length(4096);
+    inode.set_mtime(100);
+    ASSERT_TRUE(CompareInode(inode, merged));
+
+    S3ChunkInfoMap empty;
+    std::shared_ptr<Iterator> iterator;
+    ASSERT_EQ(MetaStatusCode::OK, manager->GetOrModifyS3ChunkInfo(
+        fsId, ino, empty, empty, true, &iterator));
+    CHECK_ITERATOR_S3CHUNKINFOLIST(iterator,
+        std::vector<uint64_t>{ 1 },
+        std::vector<S3ChunkInfoList>{ GenS3ChunkInfoList(1, 1) });
+
+    // CASE 2: delta with attributes on a deleted inode
+    S3ChunkInfoMap map2del;
+    map2del[1] = GenS3ChunkInfoList(1, 1);
+    ASSERT_EQ(MetaStatusCode::OK, manager->GetOrModifyS3ChunkInfo(
+        fsId, ino, empty, map2del, false, &iterator));
+    ASSERT_EQ(MetaStatusCode::OK, manager->DeleteInode(fsId, ino));
+
+    (*delta.mutable_s3chunkinfoadd())[2] = GenS3ChunkInfoList(2, 2);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND,
+              manager->UpdateInodeAttrDelta(fsId, delta));
+
+    // CASE 3: delta only with s3 chunk info on a deleted inode
+    delta.clear_length();
+    delta.clear_mtime();
+    (*delta.mutable_s3chunkinfoadd())[3] = GenS3ChunkInfoList(3, 3);
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND,
+              manager->UpdateInodeAttrDelta(fsId, delta));
+
+    // neither the inode nor its s3 chunk info is left in storage
+    ASSERT_EQ(MetaStatusCode::NOT_FOUND,
+              manager->GetInode(fsId, ino, &merged));
+    std::list<uint64_t> inodeIds;
+    ASSERT_TRUE(manager->GetInodeIdList(&inodeIds));
+    ASSERT_TRUE(inodeIds.empty());
+    ASSERT_EQ(MetaStatusCode::OK, manager->GetOrModifyS3ChunkInfo(
+        fsId, ino, empty, empty, true, &iterator));
+    CHECK_ITERATOR_S3CHUNKINFOLIST(iterator, std::vector<uint64_t>{},
+                                   std::vector<S3ChunkInfoList>{});
+}
+
 TEST_F(InodeManagerTest, testGetAttr) {
     // CREATE
     uint32_t fsId = 1;
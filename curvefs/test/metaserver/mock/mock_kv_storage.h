@@ -49,6 +49,13 @@ class MockKVStorage : public KVStorage {
 
     MOCK_METHOD2(HDel, Status(const std::string&, const std::string&));
 
+    MOCK_METHOD2(HExist, Status(const std::string&, const std::string&));
+
+    MOCK_METHOD3(HMerge,
+                 Status(const std::string&,
+                        const std::string&,
+                        const ValueType&));
+
     MOCK_METHOD1(HGetAll, std::shared_ptr<Iterator>(const std::string&));
 
     MOCK_METHOD1(HSize, size_t(const std::string&));
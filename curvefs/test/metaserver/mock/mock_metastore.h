@@ -98,6 +98,10 @@ class MockMetaStore : public curvefs::metaserver::MetaStore {
     MOCK_METHOD2(UpdateVolumeExtent,
                  MetaStatusCode(const UpdateVolumeExtentRequest*,
                                 UpdateVolumeExtentResponse*));
+
+    MOCK_METHOD2(BatchUpdateInodeAttr,
+                 MetaStatusCode(const BatchUpdateInodeAttrRequest*,
+                                BatchUpdateInodeAttrResponse*));
 };
 
 }  // namespace mock
@@ -46,6 +46,7 @@ using ::testing::ReturnRef;
 using ::testing::SaveArg;
 using ::testing::SetArgPointee;
 using ::testing::StrEq;
+using ::curve::common::TaskThreadPool;
 
 using ::curvefs::metaserver::storage::KVStorage;
 using ::curvefs::metaserver::storage::RandomStoragePath;
@@ -496,12 +497,12 @@ TEST_F(S3CompactTest, test_ReadFullChunk) {
     };
 
     EXPECT_CALL(*s3adapter_, DeleteObject(_)).WillRepeatedly(Return(0));
-    auto mock_getobj = [&](const Aws::String& key, std::string* data) {
-        data->clear();
-        data->append(ctx.blockSize, '\0');
+    auto mock_getobj = [&](const std::string& key, char* buf, off_t off,
+                           size_t len) {
+        memset(buf, 'a', len);
         return 0;
     };
-    EXPECT_CALL(*s3adapter_, GetObject(_, _))
+    EXPECT_CALL(*s3adapter_, GetObject(_, _, _, _))
         .WillRepeatedly(testing::Invoke(mock_getobj));
 
     validList.emplace_back(0, 1, 0, 0, 0, 0, true);
@@ -519,12 +520,37 @@ TEST_F(S3CompactTest, test_ReadFullChunk) {
     ASSERT_EQ(newChunkInfo.newChunkId, 2);
     ASSERT_EQ(newChunkInfo.newCompaction, 1);
     ASSERT_EQ(fullChunk.size(), 14);
+    ASSERT_EQ(fullChunk.substr(0, 11), std::string(11, 'a'));
+    ASSERT_EQ(fullChunk.substr(11, 2), std::string(2, '\0'));
+    ASSERT_EQ(fullChunk[13], 'a');
+
+    // objs are read concurrently in s3 io pool
+    TaskThreadPool<> s3ioPool;
+    ASSERT_EQ(0, s3ioPool.Start(4));
+    S3CompactInflightThrottle throttle(4);
+    workerOptions_.s3ioPool = &s3ioPool;
+    workerOptions_.inflightThrottle = &throttle;
+    reset();
+    validList.emplace_back(0, 0, 1, 1, 0, 1, false);
+    validList.emplace_back(1, 10, 0, 0, 1, 11, false);
+    validList.emplace_back(13, 13, 2, 0, 13, 14, false);
+    ret = impl_->ReadFullChunk(ctx, validList, &fullChunk, &newChunkInfo);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(fullChunk.size(), 14);
+    ASSERT_EQ(fullChunk.substr(0, 11), std::string(11, 'a'));
+    ASSERT_EQ(fullChunk.substr(11, 2), std::string(2, '\0'));
+    ASSERT_EQ(fullChunk[13], 'a');
+    ASSERT_EQ(throttle.InflightBytes(), 0);
 
     reset();
-    EXPECT_CALL(*s3adapter_, GetObject(_, _)).WillRepeatedly(Return(-1));
+    EXPECT_CALL(*s3adapter_, GetObject(_, _, _, _))
+        .WillRepeatedly(Return(-1));
     validList.emplace_back(0, 1, 1, 1, 0, 0, false);
     ret = impl_->ReadFullChunk(ctx, validList, &fullChunk, &newChunkInfo);
     ASSERT_EQ(ret, -1);
+    workerOptions_.s3ioPool = nullptr;
+    workerOptions_.inflightThrottle = nullptr;
+    s3ioPool.Stop();
 }
 
 TEST_F(S3CompactTest, test_WriteFullChunk) {
@@ -546,6 +572,21 @@ TEST_F(S3CompactTest, test_WriteFullChunk) {
     EXPECT_CALL(*s3adapter_, PutObject(_, _)).WillRepeatedly(Return(-1));
     ret = impl_->WriteFullChunk(ctx, newChunkInfo, fullChunk, &objsAdded);
     ASSERT_EQ(ret, -1);
+
+    // objs are written concurrently in s3 io pool, keep the order
+    TaskThreadPool<> s3ioPool;
+    ASSERT_EQ(0, s3ioPool.Start(4));
+    workerOptions_.s3ioPool = &s3ioPool;
+    objsAdded.clear();
+    EXPECT_CALL(*s3adapter_, PutObject(_, _)).WillRepeatedly(Return(0));
+    ret = impl_->WriteFullChunk(ctx, newChunkInfo, fullChunk, &objsAdded);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(objsAdded.size(), 3);
+    ASSERT_EQ(objsAdded[0], "1_100_2_0_3");
+    ASSERT_EQ(objsAdded[1], "1_100_2_1_3");
+    ASSERT_EQ(objsAdded[2], "1_100_2_2_3");
+    workerOptions_.s3ioPool = nullptr;
+    s3ioPool.Stop();
 }
 
 TEST_F(S3CompactTest, test_CompactChunks) {
@@ -565,12 +606,12 @@ TEST_F(S3CompactTest, test_CompactChunks) {
         .WillRepeatedly(testing::Invoke(mock_updateinode));
     EXPECT_CALL(*s3adapter_, PutObject(_, _)).WillRepeatedly(Return(0));
     EXPECT_CALL(*s3adapter_, DeleteObject(_)).WillRepeatedly(Return(0));
-    auto mock_getobj = [&](const Aws::String& key, std::string* data) {
-        data->clear();
-        data->append(blockSize, '\0');
+    auto mock_getobj = [&](const std::string& key, char* buf, off_t off,
+                           size_t len) {
+        memset(buf, '\0', len);
         return 0;
     };
-    EXPECT_CALL(*s3adapter_, GetObject(_, _))
+    EXPECT_CALL(*s3adapter_, GetObject(_, _, _, _))
         .WillRepeatedly(testing::Invoke(mock_getobj));
 
     auto* mockCopysetNodeWrapper = mockCopysetNodeWrapper_.get();
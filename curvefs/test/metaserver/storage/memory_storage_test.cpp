@@ -21,9 +21,13 @@
  */
 
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "src/fs/ext4_filesystem_impl.h"
 #include "curvefs/src/metaserver/storage/storage.h"
 #include "curvefs/src/metaserver/storage/memory_storage.h"
 #include "curvefs/test/metaserver/storage/storage_test.h"
@@ -65,6 +69,8 @@ TEST_F(MemoryStorageTest, HSetTest) { TestHSet(kvStorage_);
                                       TestHSet(kvStorage2_); }
 TEST_F(MemoryStorageTest, HDelTest) { TestHDel(kvStorage_);
                                       TestHDel(kvStorage2_); }
+TEST_F(MemoryStorageTest, HMergeTest) { TestHMerge(kvStorage_);
+                                        TestHMerge(kvStorage2_); }
 TEST_F(MemoryStorageTest, HGetAllTest) { TestHGetAll(kvStorage_);
                                          TestHGetAll(kvStorage2_); }
 TEST_F(MemoryStorageTest, HSizeTest) { TestHSize(kvStorage_);
@@ -89,6 +95,118 @@ TEST_F(MemoryStorageTest, SClearTest) { TestSClear(kvStorage_);
 TEST_F(MemoryStorageTest, MixOperatorTest) { TestMixOperator(kvStorage_);
                                              TestMixOperator(kvStorage2_); }
 
+TEST_F(MemoryStorageTest, IncrementalCheckpointAndRecover) {
+    auto localfs = curve::fs::Ext4FileSystemImpl::getInstance();
+    const std::string root = ".memory_storage_test";
+    ASSERT_EQ(0, localfs->Mkdir(root));
+
+    for (auto compression : {false, true}) {
+        StorageOptions options;
+        options.dataDir = root + "/data";
+        options.compression = compression;
+        options.maxCheckpointDeltaFiles = 1;
+        options.localFileSystem = localfs.get();
+        auto kvStorage = std::make_shared<MemoryStorage>(options);
+
+        // the first checkpoint is the base
+        std::vector<std::string> files;
+        ASSERT_TRUE(kvStorage->HSet("hash", "key1", Value("value1")).ok());
+        ASSERT_TRUE(kvStorage->HSet("hash", "key2", Value("value2")).ok());
+        ASSERT_TRUE(kvStorage->SSet("sorted", "key1", Value("value1")).ok());
+        ASSERT_TRUE(localfs->Mkdir(root + "/snap1") == 0);
+        ASSERT_TRUE(kvStorage->Checkpoint(root + "/snap1", &files));
+        ASSERT_EQ(files, std::vector<std::string>{"memory_checkpoint/base.0"});
+
+        // incremental checkpoint
+        files.clear();
+        ASSERT_TRUE(kvStorage->HDel("hash", "key1").ok());
+        ASSERT_TRUE(kvStorage->HSet("hash", "key2", Value("value3")).ok());
+        ASSERT_TRUE(kvStorage->SClear("sorted").ok());
+        ASSERT_TRUE(kvStorage->SSet("sorted", "key2", Value("value2")).ok());
+        ASSERT_TRUE(localfs->Mkdir(root + "/snap2") == 0);
+        ASSERT_TRUE(kvStorage->Checkpoint(root + "/snap2", &files));
+        ASSERT_EQ(files, (std::vector<std::string>{
+                             "memory_checkpoint/base.0",
+                             "memory_checkpoint/delta.1"}));
+
+        // reach max delta files, merge them into a new base in background
+        for (int i = 0; i < 1000 && localfs->FileExists(
+                 root + "/data/memory_checkpoint/delta.1"); ++i) {
+            ::usleep(10 * 1000);
+        }
+        ASSERT_FALSE(
+            localfs->FileExists(root + "/data/memory_checkpoint/base.0"));
+        ASSERT_FALSE(
+            localfs->FileExists(root + "/data/memory_checkpoint/delta.1"));
+
+        files.clear();
+        ASSERT_TRUE(kvStorage->HSet("hash", "key3", Value("value3")).ok());
+        ASSERT_TRUE(localfs->Mkdir(root + "/snap3") == 0);
+        ASSERT_TRUE(kvStorage->Checkpoint(root + "/snap3", &files));
+        ASSERT_EQ(files, (std::vector<std::string>{
+                             "memory_checkpoint/base.1",
+                             "memory_checkpoint/delta.2"}));
+        ASSERT_TRUE(kvStorage->Close());
+
+        // recover from base and delta
+        Dentry value;
+        auto recoveredOptions = options;
+        recoveredOptions.dataDir = root + "/data2";
+        auto recovered = std::make_shared<MemoryStorage>(recoveredOptions);
+        ASSERT_TRUE(recovered->Recover(root + "/snap2"));
+        ASSERT_TRUE(recovered->HGet("hash", "key1", &value).IsNotFound());
+        ASSERT_TRUE(recovered->HGet("hash", "key2", &value).ok());
+        ASSERT_EQ(value, Value("value3"));
+        ASSERT_TRUE(recovered->SGet("sorted", "key1", &value).IsNotFound());
+        ASSERT_TRUE(recovered->SGet("sorted", "key2", &value).ok());
+        ASSERT_EQ(value, Value("value2"));
+        ASSERT_EQ(recovered->HSize("hash"), 1);
+        ASSERT_EQ(recovered->SSize("sorted"), 1);
+
+        // recover from the merged base
+        ASSERT_TRUE(recovered->Recover(root + "/snap3"));
+        ASSERT_TRUE(recovered->HGet("hash", "key1", &value).IsNotFound());
+        ASSERT_TRUE(recovered->HGet("hash", "key3", &value).ok());
+        ASSERT_EQ(value, Value("value3"));
+        ASSERT_TRUE(recovered->SGet("sorted", "key1", &value).IsNotFound());
+        ASSERT_TRUE(recovered->SGet("sorted", "key2", &value).ok());
+        ASSERT_EQ(recovered->HSize("hash"), 2);
+        ASSERT_EQ(recovered->SSize("sorted"), 1);
+
+        // the recovered files are the base of the next checkpoint
+        files.clear();
+        ASSERT_TRUE(recovered->HDel("hash", "key3").ok());
+        ASSERT_TRUE(localfs->Mkdir(root + "/snap4") == 0);
+        ASSERT_TRUE(recovered->Checkpoint(root + "/snap4", &files));
+        ASSERT_EQ(files, (std::vector<std::string>{
+                             "memory_checkpoint/base.1",
+                             "memory_checkpoint/delta.2",
+                             "memory_checkpoint/delta.3"}));
+        ASSERT_TRUE(recovered->Close());
+
+        // snapshot with old base is still available
+        ASSERT_TRUE(recovered->Recover(root + "/snap1"));
+        ASSERT_EQ(recovered->HSize("hash"), 2);
+        ASSERT_TRUE(recovered->SGet("sorted", "key1", &value).ok());
+        ASSERT_EQ(value, Value("value1"));
+        recovered->Close();
+
+        auto recovered2 = std::make_shared<MemoryStorage>(recoveredOptions);
+        ASSERT_TRUE(recovered2->Recover(root + "/snap4"));
+        ASSERT_EQ(recovered2->HSize("hash"), 1);
+        ASSERT_TRUE(recovered2->HGet("hash", "key3", &value).IsNotFound());
+
+        ASSERT_EQ(0, localfs->Delete(root + "/data"));
+        ASSERT_EQ(0, localfs->Delete(root + "/snap1"));
+        ASSERT_EQ(0, localfs->Delete(root + "/snap2"));
+        ASSERT_EQ(0, localfs->Delete(root + "/snap3"));
+        ASSERT_EQ(0, localfs->Delete(root + "/snap4"));
+        ASSERT_EQ(0, localfs->Delete(root + "/data2"));
+    }
+
+    ASSERT_EQ(0, localfs->Delete(root));
+}
+
 }  // namespace storage
 }  // namespace metaserver
 }  // namespace curvefs
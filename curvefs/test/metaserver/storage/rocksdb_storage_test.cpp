@@ -158,6 +158,7 @@ TEST_F(RocksDBStorageTest, MiscTest) {
 TEST_F(RocksDBStorageTest, HGetTest) { TestHGet(kvStorage_); }
 TEST_F(RocksDBStorageTest, HSetTest) { TestHSet(kvStorage_); }
 TEST_F(RocksDBStorageTest, HDelTest) { TestHDel(kvStorage_); }
+TEST_F(RocksDBStorageTest, HMergeTest) { TestHMerge(kvStorage_); }
 TEST_F(RocksDBStorageTest, HGetAllTest) { TestHGetAll(kvStorage_); }
 TEST_F(RocksDBStorageTest, HSizeTest) { TestHSize(kvStorage_); }
 TEST_F(RocksDBStorageTest, HClearTest) { TestHClear(kvStorage_); }
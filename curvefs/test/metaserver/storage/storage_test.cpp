@@ -182,6 +182,75 @@ void TestHDel(std::shared_ptr<KVStorage> kvStorage) {
     ASSERT_TRUE(s.IsNotFound());
 }
 
+void TestHMerge(std::shared_ptr<KVStorage> kvStorage) {
+    Status s;
+    Dentry value;
+    Dentry delta;
+    size_t size;
+    std::shared_ptr<Iterator> iterator;
+
+    // CASE 1: merge set fields into existing value
+    s = kvStorage->HSet(TableName(1), "key1", Value("value1"));
+    ASSERT_TRUE(s.ok());
+    delta.set_txid(2);
+    delta.set_inodeid(100);
+    s = kvStorage->HMerge(TableName(1), "key1", delta);
+    ASSERT_TRUE(s.ok());
+    s = kvStorage->HGet(TableName(1), "key1", &value);
+    ASSERT_TRUE(s.ok());
+    Dentry expect = Value("value1");
+    expect.set_txid(2);
+    expect.set_inodeid(100);
+    ASSERT_EQ(value, expect);
+
+    // CASE 2: merge several times, the latest one wins
+    delta.Clear();
+    delta.set_txid(3);
+    s = kvStorage->HMerge(TableName(1), "key1", delta);
+    ASSERT_TRUE(s.ok());
+    delta.set_txid(4);
+    s = kvStorage->HMerge(TableName(1), "key1", delta);
+    ASSERT_TRUE(s.ok());
+    s = kvStorage->HGet(TableName(1), "key1", &value);
+    ASSERT_TRUE(s.ok());
+    expect.set_txid(4);
+    ASSERT_EQ(value, expect);
+
+    // CASE 3: merging into nonexistent or deleted key is dropped
+    s = kvStorage->HExist(TableName(1), "key1");
+    ASSERT_TRUE(s.ok());
+    s = kvStorage->HMerge(TableName(1), "key2", delta);
+    ASSERT_TRUE(s.ok() || s.IsNotFound());
+    s = kvStorage->HGet(TableName(1), "key2", &value);
+    ASSERT_TRUE(s.IsNotFound());
+    s = kvStorage->HExist(TableName(1), "key2");
+    ASSERT_TRUE(s.IsNotFound());
+
+    s = kvStorage->HDel(TableName(1), "key1");
+    ASSERT_TRUE(s.ok());
+    s = kvStorage->HMerge(TableName(1), "key1", delta);
+    ASSERT_TRUE(s.ok() || s.IsNotFound());
+    s = kvStorage->HGet(TableName(1), "key1", &value);
+    ASSERT_TRUE(s.IsNotFound());
+    s = kvStorage->HExist(TableName(1), "key1");
+    ASSERT_TRUE(s.IsNotFound());
+
+    size = 0;
+    iterator = kvStorage->HGetAll(TableName(1));
+    ASSERT_EQ(iterator->Status(), 0);
+    for (iterator->SeekToFirst(); iterator->Valid(); iterator->Next()) {
+        size++;
+    }
+    ASSERT_EQ(size, 0);
+
+    // CASE 4: set again after dropped merging
+    s = kvStorage->HSet(TableName(1), "key1", Value("value1"));
+    ASSERT_TRUE(s.ok());
+    s = kvStorage->HGet(TableName(1), "key1", &value);
+    ASSERT_TRUE(s.ok());
+    ASSERT_EQ(value, Value("value1"));
+}
+
 void TestHGetAll(std::shared_ptr<KVStorage> kvStorage) {
     Status s;
     size_t size;
@@ -40,6 +40,7 @@ Dentry Value(const std::string& name);
 void TestHGet(std::shared_ptr<KVStorage> kvStorage);
 void TestHSet(std::shared_ptr<KVStorage> kvStorage);
 void TestHDel(std::shared_ptr<KVStorage> kvStorage);
+void TestHMerge(std::shared_ptr<KVStorage> kvStorage);
 void TestHGetAll(std::shared_ptr<KVStorage> kvStorage);
 void TestHSize(std::shared_ptr<KVStorage> kvStorage);
 void TestHClear(std::shared_ptr<KVStorage> kvStorage);
@@ -38,6 +38,7 @@ extern "C" {
 #include <fcntl.h>
 #include <unistd.h>
 #include <aio.h>
+#include <sys/uio.h>
 
 // #define CBD_BACKEND_FAKE
 
@@ -70,6 +71,11 @@ int cbd_ext4_pdiscard(int fd, off_t offset, size_t length);
 int cbd_ext4_aio_pread(int fd, CurveAioContext* context);
 int cbd_ext4_aio_pwrite(int fd, CurveAioContext* context);
 int cbd_ext4_aio_pdiscard(int fd, CurveAioContext* context);
+int cbd_ext4_aio_preadv(int fd, CurveAioContext* context,
+                        const struct iovec* iov, int iovcnt);
+int cbd_ext4_aio_pwritev(int fd, CurveAioContext* context,
+                         const struct iovec* iov, int iovcnt);
+int cbd_ext4_aio_submit_batch(int fd, CurveAioContext** contexts, int count);
 int cbd_ext4_sync(int fd);
 int64_t cbd_ext4_filesize(const char* filename);
 int cbd_ext4_increase_epoch(const char* filename);
@@ -84,6 +90,12 @@ int cbd_libcurve_pdiscard(int fd, off_t offset, size_t length);
 int cbd_libcurve_aio_pread(int fd, CurveAioContext* context);
 int cbd_libcurve_aio_pwrite(int fd, CurveAioContext* context);
 int cbd_libcurve_aio_pdiscard(int fd, CurveAioContext* context);
+int cbd_libcurve_aio_preadv(int fd, CurveAioContext* context,
+                            const struct iovec* iov, int iovcnt);
+int cbd_libcurve_aio_pwritev(int fd, CurveAioContext* context,
+                             const struct iovec* iov, int iovcnt);
+int cbd_libcurve_aio_submit_batch(int fd, CurveAioContext** contexts,
+                                  int count);
 int cbd_libcurve_sync(int fd);
 int64_t cbd_libcurve_filesize(const char* filename);
 int cbd_libcurve_resize(const char* filename, int64_t size);
@@ -100,6 +112,9 @@ int cbd_libcurve_increase_epoch(const char* filename);
 #define cbd_lib_aio_pread       cbd_libcurve_aio_pread
 #define cbd_lib_aio_pwrite      cbd_libcurve_aio_pwrite
 #define cbd_lib_aio_pdiscard    cbd_libcurve_aio_pdiscard
+#define cbd_lib_aio_preadv      cbd_libcurve_aio_preadv
+#define cbd_lib_aio_pwritev     cbd_libcurve_aio_pwritev
+#define cbd_lib_aio_submit_batch    cbd_libcurve_aio_submit_batch
 #define cbd_lib_sync            cbd_libcurve_sync
 #define cbd_lib_filesize        cbd_libcurve_filesize
 #define cbd_lib_resize          cbd_libcurve_resize
@@ -115,6 +130,9 @@ int cbd_libcurve_increase_epoch(const char* filename);
 #define cbd_lib_aio_pread       cbd_ext4_aio_pread
 #define cbd_lib_aio_pwrite      cbd_ext4_aio_pwrite
 #define cbd_lib_aio_pdiscard    cbd_ext4_aio_pdiscard
+#define cbd_lib_aio_preadv      cbd_ext4_aio_preadv
+#define cbd_lib_aio_pwritev     cbd_ext4_aio_pwritev
+#define cbd_lib_aio_submit_batch    cbd_ext4_aio_submit_batch
 #define cbd_lib_sync            cbd_ext4_sync
 #define cbd_lib_filesize        cbd_ext4_filesize
 #define cbd_lib_increase_epoch  cbd_ext4_increase_epoch
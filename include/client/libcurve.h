@@ -25,6 +25,7 @@
 
 #include <unistd.h>
 #include <stdint.h>
+#include <sys/uio.h>
 #include <vector>
 #include <map>
 #include <string>
@@ -194,6 +195,43 @@ int AioWrite(int fd, CurveAioContext* aioctx);
  */
 int AioDiscard(int fd, CurveAioContext* aioctx);
 
+/**
+ * @brief Asynchronous vectored read, data is scattered into iov
+ * @param fd file descriptor
+ * @param aioctx async request context, aioctx->buf is ignored and
+ *        aioctx->length must equal to the total length of iov
+ * @param iov buffers to read into, they must be valid until aioctx->cb is
+ *        called, the iovec array itself can be released after return
+ * @param iovcnt number of iovec
+ * @return 0 means success, otherwise it means failure
+ */
+int AioReadv(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+             int iovcnt);
+
+/**
+ * @brief Asynchronous vectored write, data is gathered from iov
+ * @param fd file descriptor
+ * @param aioctx async request context, aioctx->buf is ignored and
+ *        aioctx->length must equal to the total length of iov
+ * @param iov buffers to write, they must be valid until aioctx->cb is
+ *        called, the iovec array itself can be released after return
+ * @param iovcnt number of iovec
+ * @return 0 means success, otherwise it means failure
+ */
+int AioWritev(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+              int iovcnt);
+
+/**
+ * @brief Submit a batch of asynchronous requests at once
+ * @param fd file descriptor
+ * @param aioctxs async request contexts, aioctxs[i]->op decides the
+ *        request type, each context is completed by its own callback
+ * @param count number of contexts
+ * @return 0 means all requests are submitted, otherwise none of them
+ *         is submitted
+ */
+int AioSubmitBatch(int fd, CurveAioContext** aioctxs, int count);
+
 /**
  * 重命名文件
  * @param: userinfo是用户信息
@@ -480,6 +518,41 @@ class CurveClient {
      */
     virtual int AioDiscard(int fd, CurveAioContext* aioctx);
 
+    /**
+     * @brief Async vectored read, aioctx->length must equal to the total
+     *        length of iov
+     * @param fd file descriptor
+     * @param aioctx async request context
+     * @param iov buffers to read into, valid until aioctx->cb is called
+     * @param iovcnt number of iovec
+     * @return return error code, 0(LIBCURVE_ERROR::OK) means success
+     */
+    virtual int AioReadv(int fd, CurveAioContext* aioctx,
+                         const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Async vectored write, aioctx->length must equal to the total
+     *        length of iov
+     * @param fd file descriptor
+     * @param aioctx async request context
+     * @param iov buffers to write, valid until aioctx->cb is called
+     * @param iovcnt number of iovec
+     * @return return error code, 0(LIBCURVE_ERROR::OK) means success
+     */
+    virtual int AioWritev(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Submit a batch of async requests at once
+     * @param fd file descriptor
+     * @param aioctxs async request contexts, op of each decides its type
+     * @param count number of contexts
+     * @param dataType type of user buffer
+     * @return return error code, 0(LIBCURVE_ERROR::OK) means success
+     */
+    virtual int AioSubmitBatch(int fd, CurveAioContext** aioctxs, int count,
+                               UserDataType dataType);
+
     /**
      * 测试使用，设置fileclient
      * @param client 需要设置的fileclient
@@ -0,0 +1,349 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include "nebd/src/common/shm_ring.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <glog/logging.h>
+
+#include <new>
+
+namespace nebd {
+namespace common {
+
+namespace {
+
+size_t AlignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+bool IsPowerOfTwo(uint32_t n) {
+    return n != 0 && (n & (n - 1)) == 0;
+}
+
+void CloseFd(int* fd) {
+    if (*fd >= 0) {
+        ::close(*fd);
+        *fd = -1;
+    }
+}
+
+}  // namespace
+
+ShmRing::~ShmRing() {
+    Release();
+}
+
+size_t ShmRing::RegionSize(uint32_t depth, uint32_t slotSize) {
+    size_t pageSize = ::getpagesize();
+    size_t metaSize = sizeof(ShmRingHeader) +
+                      sizeof(ShmSubmitEntry) * depth +
+                      sizeof(ShmCompleteEntry) * depth;
+    return AlignUp(metaSize, pageSize) +
+           AlignUp(static_cast<size_t>(depth) * slotSize, pageSize);
+}
+
+int ShmRing::Create(uint32_t depth, uint32_t slotSize) {
+    if (!IsPowerOfTwo(depth) || slotSize == 0) {
+        LOG(ERROR) << "Invalid shm ring option, depth = " << depth
+                   << ", slotSize = " << slotSize;
+        return -1;
+    }
+
+    memFd_ = ::memfd_create("nebd-shm-ring", MFD_CLOEXEC);
+    if (memFd_ < 0) {
+        LOG(ERROR) << "memfd_create failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    size_t size = RegionSize(depth, slotSize);
+    if (::ftruncate(memFd_, size) != 0) {
+        LOG(ERROR) << "ftruncate memfd failed, error: " << strerror(errno);
+        Release();
+        return -1;
+    }
+
+    submitEventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    completeEventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (submitEventFd_ < 0 || completeEventFd_ < 0) {
+        LOG(ERROR) << "create eventfd failed, error: " << strerror(errno);
+        Release();
+        return -1;
+    }
+
+    if (Map(size) != 0) {
+        Release();
+        return -1;
+    }
+
+    header_ = new (region_) ShmRingHeader();
+    header_->magic = kShmRingMagic;
+    header_->version = kShmRingVersion;
+    header_->depth = depth;
+    header_->slotSize = slotSize;
+    header_->sqHead.store(0, std::memory_order_relaxed);
+    header_->sqTail.store(0, std::memory_order_relaxed);
+    header_->cqHead.store(0, std::memory_order_relaxed);
+    header_->cqTail.store(0, std::memory_order_release);
+
+    sq_ = reinterpret_cast<ShmSubmitEntry*>(header_ + 1);
+    cq_ = reinterpret_cast<ShmCompleteEntry*>(sq_ + depth);
+    data_ = static_cast<char*>(region_) + (size - AlignUp(
+        static_cast<size_t>(depth) * slotSize, ::getpagesize()));
+    return 0;
+}
+
+int ShmRing::Attach(int memFd, int submitEventFd, int completeEventFd) {
+    memFd_ = memFd;
+    submitEventFd_ = submitEventFd;
+    completeEventFd_ = completeEventFd;
+
+    struct stat st;
+    if (::fstat(memFd_, &st) != 0 ||
+        static_cast<size_t>(st.st_size) < sizeof(ShmRingHeader)) {
+        LOG(ERROR) << "Invalid shm ring memfd, error: " << strerror(errno);
+        Release();
+        return -1;
+    }
+
+    if (Map(st.st_size) != 0) {
+        Release();
+        return -1;
+    }
+
+    header_ = static_cast<ShmRingHeader*>(region_);
+    uint32_t depth = header_->depth;
+    uint32_t slotSize = header_->slotSize;
+    if (header_->magic != kShmRingMagic ||
+        header_->version != kShmRingVersion ||
+        !IsPowerOfTwo(depth) || slotSize == 0 ||
+        RegionSize(depth, slotSize) != regionSize_) {
+        LOG(ERROR) << "Shm ring header mismatch, magic = " << header_->magic
+                   << ", version = " << header_->version
+                   << ", depth = " << depth << ", slotSize = " << slotSize
+                   << ", region size = " << regionSize_;
+        Release();
+        return -1;
+    }
+
+    sq_ = reinterpret_cast<ShmSubmitEntry*>(header_ + 1);
+    cq_ = reinterpret_cast<ShmCompleteEntry*>(sq_ + depth);
+    data_ = static_cast<char*>(region_) + (regionSize_ - AlignUp(
+        static_cast<size_t>(depth) * slotSize, ::getpagesize()));
+    return 0;
+}
+
+int ShmRing::Map(size_t size) {
+    void* addr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+                        memFd_, 0);
+    if (addr == MAP_FAILED) {
+        LOG(ERROR) << "mmap shm ring failed, size = " << size
+                   << ", error: " << strerror(errno);
+        return -1;
+    }
+
+    region_ = addr;
+    regionSize_ = size;
+    return 0;
+}
+
+void ShmRing::Release() {
+    if (region_ != nullptr) {
+        ::munmap(region_, regionSize_);
+        region_ = nullptr;
+        regionSize_ = 0;
+    }
+
+    header_ = nullptr;
+    sq_ = nullptr;
+    cq_ = nullptr;
+    data_ = nullptr;
+
+    CloseFd(&memFd_);
+    CloseFd(&submitEventFd_);
+    CloseFd(&completeEventFd_);
+}
+
+bool ShmRing::PushSubmit(const ShmSubmitEntry& entry) {
+    uint32_t tail = header_->sqTail.load(std::memory_order_relaxed);
+    uint32_t head = header_->sqHead.load(std::memory_order_acquire);
+    if (tail - head >= header_->depth) {
+        return false;
+    }
+
+    sq_[tail & (header_->depth - 1)] = entry;
+    header_->sqTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool ShmRing::PopSubmit(ShmSubmitEntry* entry) {
+    uint32_t head = header_->sqHead.load(std::memory_order_relaxed);
+    uint32_t tail = header_->sqTail.load(std::memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+
+    *entry = sq_[head & (header_->depth - 1)];
+    header_->sqHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool ShmRing::PushComplete(const ShmCompleteEntry& entry) {
+    uint32_t tail = header_->cqTail.load(std::memory_order_relaxed);
+    uint32_t head = header_->cqHead.load(std::memory_order_acquire);
+    if (tail - head >= header_->depth) {
+        return false;
+    }
+
+    cq_[tail & (header_->depth - 1)] = entry;
+    header_->cqTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool ShmRing::PopComplete(ShmCompleteEntry* entry) {
+    uint32_t head = header_->cqHead.load(std::memory_order_relaxed);
+    uint32_t tail = header_->cqTail.load(std::memory_order_acquire);
+    if (head == tail) {
+        return false;
+    }
+
+    *entry = cq_[head & (header_->depth - 1)];
+    header_->cqHead.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void ShmRing::NotifySubmit() {
+    ::eventfd_write(submitEventFd_, 1);
+}
+
+void ShmRing::NotifyComplete() {
+    ::eventfd_write(completeEventFd_, 1);
+}
+
+bool ShmRing::ConsumeSubmitEvent() {
+    eventfd_t value = 0;
+    return ::eventfd_read(submitEventFd_, &value) == 0;
+}
+
+bool ShmRing::ConsumeCompleteEvent() {
+    eventfd_t value = 0;
+    return ::eventfd_read(completeEventFd_, &value) == 0;
+}
+
+char* ShmRing::SlotBuffer(uint32_t slot) const {
+    return data_ + static_cast<size_t>(slot) * header_->slotSize;
+}
+
+int SendWithFds(int sock, const void* data, size_t len,
+                const int* fds, int nfds) {
+    struct iovec iov;
+    iov.iov_base = const_cast<void*>(data);
+    iov.iov_len = len;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    char control[CMSG_SPACE(sizeof(int) * 4)];
+    if (nfds > 0) {
+        if (nfds > 4) {
+            return -1;
+        }
+        memset(control, 0, sizeof(control));
+        msg.msg_control = control;
+        msg.msg_controllen = CMSG_SPACE(sizeof(int) * nfds);
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int) * nfds);
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * nfds);
+    }
+
+    ssize_t n;
+    do {
+        n = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (n < 0 && errno == EINTR);
+
+    return n == static_cast<ssize_t>(len) ? 0 : -1;
+}
+
+int RecvWithFds(int sock, void* data, size_t len, int* fds, int* nfds) {
+    struct iovec iov;
+    iov.iov_base = data;
+    iov.iov_len = len;
+
+    char control[CMSG_SPACE(sizeof(int) * 4)];
+    memset(control, 0, sizeof(control));
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+        n = ::recvmsg(sock, &msg, MSG_CMSG_CLOEXEC | MSG_WAITALL);
+    } while (n < 0 && errno == EINTR);
+
+    int received = 0;
+    int maxFds = *nfds;
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+
+        int count = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const int* passed = reinterpret_cast<const int*>(CMSG_DATA(cmsg));
+        for (int i = 0; i < count; ++i) {
+            if (received < maxFds) {
+                fds[received++] = passed[i];
+            } else {
+                ::close(passed[i]);
+            }
+        }
+    }
+
+    *nfds = received;
+    if (n != static_cast<ssize_t>(len)) {
+        for (int i = 0; i < received; ++i) {
+            ::close(fds[i]);
+        }
+        *nfds = 0;
+        return -1;
+    }
+
+    return 0;
+}
+
+}  // namespace common
+}  // namespace nebd
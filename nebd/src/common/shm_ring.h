@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef NEBD_SRC_COMMON_SHM_RING_H_
+#define NEBD_SRC_COMMON_SHM_RING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+
+#include "nebd/src/common/uncopyable.h"
+
+namespace nebd {
+namespace common {
+
+const uint32_t kShmRingMagic = 0x4e454244;  // "NEBD"
+const uint32_t kShmRingVersion = 1;
+
+enum class ShmRingOp : uint32_t {
+    READ = 0,
+    WRITE = 1,
+};
+
+// submission entry, filled by part1
+struct ShmSubmitEntry {
+    // index of data slot, also used as request id
+    uint32_t slot;
+    // ShmRingOp
+    uint32_t op;
+    uint64_t offset;
+    uint64_t length;
+};
+
+// ret of a completion entry, io failed in part2 and it is not allowed to
+// return the error, part1 resends the request by rpc
+const int32_t kShmRetryByRpc = 1;
+
+// completion entry, filled by part2
+struct ShmCompleteEntry {
+    uint32_t slot;
+    // 0 on success, kShmRetryByRpc if part1 should resend it by rpc,
+    // otherwise failed
+    int32_t ret;
+};
+
+// sent by part1 together with the memfd and eventfds after connected
+struct ShmHandshakeRequest {
+    uint32_t magic;
+    // fd returned by OpenFile rpc
+    int32_t fd;
+};
+
+struct ShmHandshakeResponse {
+    // 0 on success, otherwise part2 refused to attach
+    int32_t ret;
+};
+
+// part2 accepts ring connections on a socket next to its rpc socket
+inline std::string ShmRingSockPath(const std::string& serverAddress) {
+    return serverAddress + ".shm";
+}
+
+// Head of the shared memory region, the layout of the region is:
+//   | ShmRingHeader | submit entries | complete entries | data slots |
+// Each in-flight request holds a data slot, so neither of the two rings
+// will overflow as long as they have as many entries as data slots.
+struct ShmRingHeader {
+    uint32_t magic;
+    uint32_t version;
+    // number of entries and data slots, must be power of 2
+    uint32_t depth;
+    // size of each data slot
+    uint32_t slotSize;
+
+    alignas(64) std::atomic<uint32_t> sqHead;
+    alignas(64) std::atomic<uint32_t> sqTail;
+    alignas(64) std::atomic<uint32_t> cqHead;
+    alignas(64) std::atomic<uint32_t> cqTail;
+};
+
+/**
+ * Submission/completion ring shared between part1 and part2.
+ * Part1 creates the region and is the only producer of submission entries,
+ * part2 attaches to it and is the only producer of completion entries.
+ * Both directions are notified by an eventfd.
+ * Push/Pop of the same ring are not thread safe, caller should serialize.
+ */
+class ShmRing : public Uncopyable {
+ public:
+    ShmRing() = default;
+    ~ShmRing();
+
+    /**
+     * @brief create a new region backed by memfd and two eventfds
+     * @param depth number of data slots, must be power of 2
+     * @param slotSize size of each data slot
+     * @return 0 on success, -1 on failure
+     */
+    int Create(uint32_t depth, uint32_t slotSize);
+
+    /**
+     * @brief attach to the region created by peer, fds are owned by
+     *        ShmRing after this call, even if it fails
+     * @return 0 on success, -1 on failure
+     */
+    int Attach(int memFd, int submitEventFd, int completeEventFd);
+
+    bool PushSubmit(const ShmSubmitEntry& entry);
+    bool PopSubmit(ShmSubmitEntry* entry);
+
+    bool PushComplete(const ShmCompleteEntry& entry);
+    bool PopComplete(ShmCompleteEntry* entry);
+
+    // wake up peer waiting on the eventfd
+    void NotifySubmit();
+    void NotifyComplete();
+
+    // consume the counter of eventfd, return false if nothing to consume
+    bool ConsumeSubmitEvent();
+    bool ConsumeCompleteEvent();
+
+    char* SlotBuffer(uint32_t slot) const;
+
+    uint32_t Depth() const {
+        return header_ != nullptr ? header_->depth : 0;
+    }
+
+    uint32_t SlotSize() const {
+        return header_ != nullptr ? header_->slotSize : 0;
+    }
+
+    int MemFd() const {
+        return memFd_;
+    }
+
+    int SubmitEventFd() const {
+        return submitEventFd_;
+    }
+
+    int CompleteEventFd() const {
+        return completeEventFd_;
+    }
+
+    static size_t RegionSize(uint32_t depth, uint32_t slotSize);
+
+ private:
+    int Map(size_t size);
+
+    void Release();
+
+ private:
+    int memFd_ = -1;
+    int submitEventFd_ = -1;
+    int completeEventFd_ = -1;
+
+    void* region_ = nullptr;
+    size_t regionSize_ = 0;
+
+    ShmRingHeader* header_ = nullptr;
+    ShmSubmitEntry* sq_ = nullptr;
+    ShmCompleteEntry* cq_ = nullptr;
+    char* data_ = nullptr;
+};
+
+/**
+ * @brief send data together with fds over unix domain socket
+ * @return 0 on success, -1 on failure
+ */
+int SendWithFds(int sock, const void* data, size_t len,
+                const int* fds, int nfds);
+
+/**
+ * @brief receive data together with fds over unix domain socket
+ * @param[in,out] nfds max number of fds to receive, and the number
+ *                     actually received
+ * @return 0 on success, -1 on failure or peer closed
+ */
+int RecvWithFds(int sock, void* data, size_t len, int* fds, int* nfds);
+
+}  // namespace common
+}  // namespace nebd
+
+#endif  // NEBD_SRC_COMMON_SHM_RING_H_
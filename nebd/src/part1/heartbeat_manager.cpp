@@ -61,6 +61,9 @@ void HeartbeatManager::HeartBetaThreadFunc() {
 
     while (running_) {
         SendHeartBeat();
+        if (periodicTask_) {
+            periodicTask_();
+        }
         sleeper_.wait_for(std::chrono::seconds(
             heartbeatOption_.intervalS));
     }
@@ -26,8 +26,10 @@
 #include <brpc/channel.h>
 
 #include <thread>   // NOLINT
+#include <functional>
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "nebd/src/part1/nebd_common.h"
 #include "nebd/src/part1/nebd_metacache.h"
@@ -63,6 +65,14 @@ class HeartbeatManager {
      */
     int Init(const HeartbeatOption& option);
 
+    /**
+     * @brief 设置每次发送心跳后执行的任务，需在Run之前调用
+     * @param task 任务，在心跳线程中执行
+     */
+    void SetPeriodicTask(std::function<void()> task) {
+        periodicTask_ = std::move(task);
+    }
+
  private:
     /**
      * @brief: 心跳线程执行函数，定期发送心跳消息
@@ -81,6 +91,9 @@ class HeartbeatManager {
 
     std::shared_ptr<NebdClientMetaCache>  metaCache_;
 
+    // 每次发送心跳后执行的任务
+    std::function<void()> periodicTask_;
+
     std::thread heartbeatThread_;
     nebd::common::InterruptibleSleeper sleeper_;
 
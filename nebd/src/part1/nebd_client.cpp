@@ -30,6 +30,8 @@
 #include <gflags/gflags.h>
 #include <bthread/bthread.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "nebd/src/part1/async_request_closure.h"
 #include "nebd/src/common/configuration.h"
@@ -107,6 +109,9 @@ int NebdClient::Init(const char* confpath) {
         return -1;
     }
 
+    if (option_.shmOption.enable) {
+        heartbeatMgr_->SetPeriodicTask([this]() { ReattachShmChannels(); });
+    }
     heartbeatMgr_->Run();
 
     // init rpc send exec-queue
@@ -128,6 +133,11 @@ void NebdClient::Uninit() {
         heartbeatMgr_->Stop();
     }
 
+    {
+        nebd::common::WriteLockGuard lk(shmChannelsLock_);
+        shmChannels_.clear();
+    }
+
     // stop exec queue
     for (auto& q : rpcTaskQueues_) {
         bthread::execution_queue_stop(q);
@@ -195,10 +205,13 @@ int NebdClient::Open(const char* filename, const NebdOpenFlags* flags) {
     }
 
     metaCache_->AddFileInfo({fd, filename, fileLock});
+    OpenShmChannel(fd);
     return fd;
 }
 
 int NebdClient::Close(int fd) {
+    CloseShmChannel(fd);
+
     auto task = [&](brpc::Controller* cntl,
                     brpc::Channel* channel,
                     bool* rpcFailed) -> int64_t {
@@ -340,6 +353,16 @@ int NebdClient::Discard(int fd, NebdClientAioContext* aioctx) {
 }
 
 int NebdClient::AioRead(int fd, NebdClientAioContext* aioctx) {
+    auto channel = GetShmChannel(fd);
+    if (channel != nullptr && channel->AioRead(aioctx)) {
+        return 0;
+    }
+
+    AioReadByRpc(fd, aioctx);
+    return 0;
+}
+
+void NebdClient::AioReadByRpc(int fd, NebdClientAioContext* aioctx) {
     auto task = [this, fd, aioctx]() {
         nebd::client::NebdFileService_Stub stub(&channel_);
         nebd::client::ReadRequest request;
@@ -355,13 +378,21 @@ int NebdClient::AioRead(int fd, NebdClientAioContext* aioctx) {
     };
 
     PushAsyncTask(task);
-
-    return 0;
 }
 
 static void EmptyDeleter(void* m) {}
 
 int NebdClient::AioWrite(int fd, NebdClientAioContext* aioctx) {
+    auto channel = GetShmChannel(fd);
+    if (channel != nullptr && channel->AioWrite(aioctx)) {
+        return 0;
+    }
+
+    AioWriteByRpc(fd, aioctx);
+    return 0;
+}
+
+void NebdClient::AioWriteByRpc(int fd, NebdClientAioContext* aioctx) {
     auto task = [this, fd, aioctx]() {
         nebd::client::NebdFileService_Stub stub(&channel_);
         nebd::client::WriteRequest request;
@@ -380,8 +411,6 @@ int NebdClient::AioWrite(int fd, NebdClientAioContext* aioctx) {
     };
 
     PushAsyncTask(task);
-
-    return 0;
 }
 
 int NebdClient::Flush(int fd, NebdClientAioContext* aioctx) {
@@ -535,6 +564,40 @@ int NebdClient::InitNebdClientOption(Configuration* conf) {
     LOG_IF(ERROR, ret != true) << "Load log.path failed";
     RETURN_IF_FALSE(ret);
 
+    return InitShmRingOption(conf);
+}
+
+int NebdClient::InitShmRingOption(Configuration* conf) {
+    ShmRingOption& shmOption = option_.shmOption;
+
+    bool ret = conf->GetBoolValue("shm.enable", &shmOption.enable);
+    LOG_IF(WARNING, ret != true)
+        << "Load shm.enable from config file failed, current value is "
+        << shmOption.enable;
+
+    ret = conf->GetUInt32Value("shm.ringDepth", &shmOption.depth);
+    LOG_IF(WARNING, ret != true)
+        << "Load shm.ringDepth from config file failed, current value is "
+        << shmOption.depth;
+
+    ret = conf->GetUInt32Value("shm.slotSize", &shmOption.slotSize);
+    LOG_IF(WARNING, ret != true)
+        << "Load shm.slotSize from config file failed, current value is "
+        << shmOption.slotSize;
+
+    ret = conf->GetUInt32Value("shm.stopTimeoutMs", &shmOption.stopTimeoutMs);
+    LOG_IF(WARNING, ret != true)
+        << "Load shm.stopTimeoutMs from config file failed, current value is "
+        << shmOption.stopTimeoutMs;
+
+    if (shmOption.enable && (shmOption.depth == 0 ||
+        (shmOption.depth & (shmOption.depth - 1)) != 0 ||
+        shmOption.slotSize == 0)) {
+        LOG(ERROR) << "Invalid shm ring option, depth = " << shmOption.depth
+                   << ", slotSize = " << shmOption.slotSize;
+        return -1;
+    }
+
     return 0;
 }
 
@@ -574,6 +637,107 @@ int NebdClient::InitChannel() {
     return 0;
 }
 
+void NebdClient::OpenShmChannel(int fd) {
+    if (!option_.shmOption.enable) {
+        return;
+    }
+
+    auto channel = CreateShmChannel(fd);
+    if (channel == nullptr) {
+        LOG(WARNING) << "Init shm channel failed, use rpc instead, fd = "
+                     << fd;
+        return;
+    }
+
+    nebd::common::WriteLockGuard lk(shmChannelsLock_);
+    shmChannels_[fd] = channel;
+}
+
+std::shared_ptr<NebdShmChannel> NebdClient::CreateShmChannel(int fd) {
+    // requests left in the ring when part2 exits are resent by rpc
+    auto fallback = [this, fd](NebdClientAioContext* aioctx) {
+        if (aioctx->op == LIBAIO_OP::LIBAIO_OP_READ) {
+            AioReadByRpc(fd, aioctx);
+        } else {
+            AioWriteByRpc(fd, aioctx);
+        }
+    };
+
+    auto channel = std::make_shared<NebdShmChannel>(fd, fallback);
+    int ret = channel->Init(
+        nebd::common::ShmRingSockPath(option_.serverAddress),
+        option_.shmOption);
+    if (ret != 0) {
+        return nullptr;
+    }
+
+    return channel;
+}
+
+void NebdClient::CloseShmChannel(int fd) {
+    std::shared_ptr<NebdShmChannel> channel;
+    {
+        nebd::common::WriteLockGuard lk(shmChannelsLock_);
+        auto iter = shmChannels_.find(fd);
+        if (iter == shmChannels_.end()) {
+            return;
+        }
+        channel = iter->second;
+        shmChannels_.erase(iter);
+    }
+
+    channel->Stop();
+}
+
+void NebdClient::ReattachShmChannels() {
+    std::vector<std::pair<int, std::shared_ptr<NebdShmChannel>>> broken;
+    {
+        nebd::common::ReadLockGuard lk(shmChannelsLock_);
+        for (const auto& item : shmChannels_) {
+            if (item.second->IsBroken()) {
+                broken.emplace_back(item.first, item.second);
+            }
+        }
+    }
+
+    for (auto& item : broken) {
+        int fd = item.first;
+        auto channel = CreateShmChannel(fd);
+        if (channel == nullptr) {
+            // part2 is not ready yet, retry on next heartbeat
+            continue;
+        }
+
+        bool replaced = false;
+        {
+            nebd::common::WriteLockGuard lk(shmChannelsLock_);
+            auto iter = shmChannels_.find(fd);
+            // file may be closed meanwhile
+            if (iter != shmChannels_.end() && iter->second == item.second) {
+                iter->second = channel;
+                replaced = true;
+            }
+        }
+
+        if (replaced) {
+            LOG(INFO) << "Reattach shm channel success, fd = " << fd;
+            item.second->Stop();
+        } else {
+            channel->Stop();
+        }
+    }
+}
+
+std::shared_ptr<NebdShmChannel> NebdClient::GetShmChannel(int fd) {
+    nebd::common::ReadLockGuard lk(shmChannelsLock_);
+    auto iter = shmChannels_.find(fd);
+    if (iter == shmChannels_.end() || iter->second->IsBroken()) {
+        return nullptr;
+    }
+
+    return iter->second;
+}
+
 int64_t NebdClient::ExecuteSyncRpc(RpcTask task) {
     int64_t retryTimes = 0;
     int64_t ret = 0;
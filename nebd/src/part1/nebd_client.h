@@ -29,14 +29,17 @@
 #include <functional>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "nebd/src/part1/nebd_common.h"
 #include "nebd/src/common/configuration.h"
+#include "nebd/src/common/rw_lock.h"
 #include "nebd/proto/client.pb.h"
 #include "nebd/src/part1/libnebd.h"
 #include "nebd/src/part1/heartbeat_manager.h"
 #include "nebd/src/part1/nebd_metacache.h"
+#include "nebd/src/part1/shm_channel.h"
 
 #include "include/curve_compiler_specific.h"
 
@@ -154,6 +157,30 @@ class NebdClient {
 
     int InitChannel();
 
+    int InitShmRingOption(Configuration* conf);
+
+    /**
+     * @brief 为打开的文件建立共享内存ring，失败时该文件的读写仍然走rpc
+     * @param fd：文件的fd
+     */
+    void OpenShmChannel(int fd);
+
+    std::shared_ptr<NebdShmChannel> CreateShmChannel(int fd);
+
+    void CloseShmChannel(int fd);
+
+    /**
+     * @brief 重建已断开的共享内存ring，在心跳线程中定期执行，
+     *        part2重启后读写重新走共享内存
+     */
+    void ReattachShmChannels();
+
+    std::shared_ptr<NebdShmChannel> GetShmChannel(int fd);
+
+    // 通过rpc发送读写请求
+    void AioReadByRpc(int fd, NebdClientAioContext* aioctx);
+    void AioWriteByRpc(int fd, NebdClientAioContext* aioctx);
+
     void InitLogger(const LogOption& logOption);
 
     /**
@@ -176,6 +203,10 @@ class NebdClient {
 
     std::atomic<uint64_t> logId_{1};
 
+    // 已打开文件的共享内存ring
+    nebd::common::RWLock shmChannelsLock_;
+    std::unordered_map<int, std::shared_ptr<NebdShmChannel>> shmChannels_;
+
  private:
     using AsyncRpcTask = std::function<void()>;
 
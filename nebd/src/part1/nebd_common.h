@@ -23,6 +23,8 @@
 #ifndef NEBD_SRC_PART1_NEBD_COMMON_H_
 #define NEBD_SRC_PART1_NEBD_COMMON_H_
 
+#include <stdint.h>
+
 #include <string>
 
 // rpc request配置项
@@ -43,6 +45,18 @@ struct RequestOption {
     uint32_t rpcSendExecQueueNum = 2;
 };
 
+// shared memory ring配置项
+struct ShmRingOption {
+    // 读写请求是否通过共享内存ring发送给part2
+    bool enable = false;
+    // 每个文件的data slot个数，必须是2的幂
+    uint32_t depth = 128;
+    // 每个data slot的大小，超过的请求仍然走rpc
+    uint32_t slotSize = 256 * 1024;
+    // 关闭文件时等待ring中请求完成的最长时间，超时后剩余请求改走rpc
+    uint32_t stopTimeoutMs = 5000;
+};
+
 // 日志配置项
 struct LogOption {
     // 日志存放目录
@@ -59,6 +73,8 @@ struct NebdClientOption {
     RequestOption requestOption;
     // 日志配置项
     LogOption logOption;
+    // shared memory ring配置项
+    ShmRingOption shmOption;
 };
 
 // heartbeat配置项
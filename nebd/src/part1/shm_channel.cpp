@@ -0,0 +1,352 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include "nebd/src/part1/shm_channel.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <glog/logging.h>
+
+#include <chrono>  // NOLINT
+#include <utility>
+
+#include "nebd/src/part1/async_request_closure.h"
+
+namespace nebd {
+namespace client {
+
+using nebd::common::ShmCompleteEntry;
+using nebd::common::ShmHandshakeRequest;
+using nebd::common::ShmHandshakeResponse;
+using nebd::common::ShmSubmitEntry;
+using nebd::common::kShmRingMagic;
+
+namespace {
+
+// timeout of handshake with part2
+const int kHandshakeTimeoutMs = 3000;
+
+int ConnectUnixSocket(const std::string& path) {
+    struct sockaddr_un addr;
+    if (path.size() >= sizeof(addr.sun_path)) {
+        LOG(ERROR) << "Socket path too long, path = " << path;
+        return -1;
+    }
+
+    int sock = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (sock < 0) {
+        LOG(ERROR) << "Create socket failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size());
+    if (::connect(sock, reinterpret_cast<struct sockaddr*>(&addr),
+                  sizeof(addr)) != 0) {
+        LOG(WARNING) << "Connect to " << path
+                     << " failed, error: " << strerror(errno);
+        ::close(sock);
+        return -1;
+    }
+
+    struct timeval tv;
+    tv.tv_sec = kHandshakeTimeoutMs / 1000;
+    tv.tv_usec = (kHandshakeTimeoutMs % 1000) * 1000;
+    ::setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+    return sock;
+}
+
+}  // namespace
+
+NebdShmChannel::NebdShmChannel(int fd, ShmFallbackFunc fallback)
+    : fd_(fd), fallback_(std::move(fallback)) {}
+
+NebdShmChannel::~NebdShmChannel() {
+    Stop();
+
+    if (sock_ >= 0) {
+        ::close(sock_);
+    }
+    if (stopEventFd_ >= 0) {
+        ::close(stopEventFd_);
+    }
+}
+
+int NebdShmChannel::Init(const std::string& sockPath,
+                         const ShmRingOption& option) {
+    if (ring_.Create(option.depth, option.slotSize) != 0) {
+        LOG(ERROR) << "Create shm ring failed, fd = " << fd_;
+        return -1;
+    }
+
+    stopEventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopEventFd_ < 0) {
+        LOG(ERROR) << "Create eventfd failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    sock_ = ConnectUnixSocket(sockPath);
+    if (sock_ < 0) {
+        return -1;
+    }
+
+    ShmHandshakeRequest request;
+    request.magic = kShmRingMagic;
+    request.fd = fd_;
+    int fds[3] = {ring_.MemFd(), ring_.SubmitEventFd(),
+                  ring_.CompleteEventFd()};
+    if (nebd::common::SendWithFds(sock_, &request, sizeof(request),
+                                  fds, 3) != 0) {
+        LOG(ERROR) << "Send shm ring to part2 failed, fd = " << fd_
+                   << ", error: " << strerror(errno);
+        return -1;
+    }
+
+    ShmHandshakeResponse response;
+    response.ret = -1;
+    ssize_t n = ::recv(sock_, &response, sizeof(response), MSG_WAITALL);
+    if (n != sizeof(response) || response.ret != 0) {
+        LOG(ERROR) << "Part2 refused shm ring, fd = " << fd_
+                   << ", received = " << n
+                   << ", ret = " << response.ret;
+        return -1;
+    }
+
+    stopTimeoutMs_ = option.stopTimeoutMs;
+    freeSlots_.reserve(ring_.Depth());
+    for (uint32_t i = ring_.Depth(); i > 0; --i) {
+        freeSlots_.push_back(i - 1);
+    }
+    inflight_.assign(ring_.Depth(), nullptr);
+
+    pollThread_ = std::thread(&NebdShmChannel::PollLoop, this);
+
+    LOG(INFO) << "Init shm channel success, fd = " << fd_
+              << ", depth = " << ring_.Depth()
+              << ", slot size = " << ring_.SlotSize();
+    return 0;
+}
+
+void NebdShmChannel::Stop() {
+    if (!pollThread_.joinable()) {
+        return;
+    }
+
+    bool drained = false;
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        stopping_.store(true, std::memory_order_release);
+        drained = cond_.wait_for(
+            lk, std::chrono::milliseconds(stopTimeoutMs_),
+            [this]() { return inflightCount_ == 0; });
+    }
+
+    // part2 is alive but doesn't complete requests, don't let close hang
+    if (!drained) {
+        LOG(WARNING) << "Wait in-flight requests of shm channel timeout, fd = "
+                     << fd_ << ", timeout = " << stopTimeoutMs_ << "ms";
+        OnBroken();
+    }
+
+    ::eventfd_write(stopEventFd_, 1);
+    pollThread_.join();
+}
+
+bool NebdShmChannel::AioRead(NebdClientAioContext* aioctx) {
+    return Submit(aioctx, ShmRingOp::READ);
+}
+
+bool NebdShmChannel::AioWrite(NebdClientAioContext* aioctx) {
+    return Submit(aioctx, ShmRingOp::WRITE);
+}
+
+bool NebdShmChannel::Submit(NebdClientAioContext* aioctx, ShmRingOp op) {
+    if (aioctx->length == 0 || aioctx->length > ring_.SlotSize()) {
+        return false;
+    }
+
+    uint32_t slot = 0;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (broken_.load(std::memory_order_relaxed) ||
+            stopping_.load(std::memory_order_relaxed) ||
+            freeSlots_.empty()) {
+            return false;
+        }
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+
+    if (op == ShmRingOp::WRITE) {
+        memcpy(ring_.SlotBuffer(slot), aioctx->buf, aioctx->length);
+    }
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        if (broken_.load(std::memory_order_relaxed)) {
+            freeSlots_.push_back(slot);
+            return false;
+        }
+
+        ShmSubmitEntry entry;
+        entry.slot = slot;
+        entry.op = static_cast<uint32_t>(op);
+        entry.offset = aioctx->offset;
+        entry.length = aioctx->length;
+        // never fails, each in-flight request holds a slot
+        ring_.PushSubmit(entry);
+        inflight_[slot] = aioctx;
+        ++inflightCount_;
+    }
+
+    ring_.NotifySubmit();
+    return true;
+}
+
+void NebdShmChannel::PollLoop() {
+    struct pollfd fds[3];
+    fds[0].fd = ring_.CompleteEventFd();
+    fds[0].events = POLLIN;
+    fds[1].fd = sock_;
+    fds[1].events = POLLIN | POLLRDHUP;
+    fds[2].fd = stopEventFd_;
+    fds[2].events = POLLIN;
+
+    while (true) {
+        int ret = ::poll(fds, 3, -1);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG(ERROR) << "Poll shm channel failed, fd = " << fd_
+                       << ", error: " << strerror(errno);
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ring_.ConsumeCompleteEvent();
+            HandleCompletions();
+        }
+
+        // part2 never sends anything after handshake, so any event on
+        // the socket means that it has exited
+        if (fds[1].revents != 0) {
+            HandleCompletions();
+            OnBroken();
+            return;
+        }
+
+        if (fds[2].revents & POLLIN) {
+            HandleCompletions();
+            return;
+        }
+    }
+
+    OnBroken();
+}
+
+void NebdShmChannel::HandleCompletions() {
+    ShmCompleteEntry entry;
+    while (ring_.PopComplete(&entry)) {
+        NebdClientAioContext* aioctx = nullptr;
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            if (entry.slot < inflight_.size()) {
+                aioctx = inflight_[entry.slot];
+                inflight_[entry.slot] = nullptr;
+            }
+            // OnBroken may have taken over the request in Stop
+            if (aioctx != nullptr && --inflightCount_ == 0) {
+                cond_.notify_all();
+            }
+        }
+
+        if (aioctx == nullptr) {
+            LOG(ERROR) << "Unexpected completion of shm ring, fd = " << fd_
+                       << ", slot = " << entry.slot;
+            continue;
+        }
+
+        bool retry = entry.ret == nebd::common::kShmRetryByRpc;
+        // copy out before the slot is reused
+        if (entry.ret == 0 && aioctx->op == LIBAIO_OP::LIBAIO_OP_READ) {
+            memcpy(aioctx->buf, ring_.SlotBuffer(entry.slot),
+                   aioctx->length);
+        }
+
+        {
+            std::lock_guard<std::mutex> lk(mtx_);
+            freeSlots_.push_back(entry.slot);
+        }
+
+        if (retry) {
+            LOG(WARNING) << OpTypeToString(aioctx->op)
+                         << " failed in part2, resend by rpc, fd = " << fd_
+                         << ", offset = " << aioctx->offset
+                         << ", length = " << aioctx->length;
+            fallback_(aioctx);
+            continue;
+        }
+
+        if (entry.ret != 0) {
+            LOG(ERROR) << OpTypeToString(aioctx->op) << " failed, fd = "
+                       << fd_ << ", offset = " << aioctx->offset
+                       << ", length = " << aioctx->length;
+        }
+
+        aioctx->ret = entry.ret == 0 ? 0 : -1;
+        aioctx->cb(aioctx);
+    }
+}
+
+void NebdShmChannel::OnBroken() {
+    std::vector<NebdClientAioContext*> pending;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        broken_.store(true, std::memory_order_release);
+        for (auto& aioctx : inflight_) {
+            if (aioctx != nullptr) {
+                pending.push_back(aioctx);
+                aioctx = nullptr;
+            }
+        }
+        inflightCount_ = 0;
+        cond_.notify_all();
+    }
+
+    LOG(WARNING) << "Shm channel broken, fd = " << fd_
+                 << ", resend " << pending.size() << " requests by rpc";
+
+    for (auto* aioctx : pending) {
+        fallback_(aioctx);
+    }
+}
+
+}  // namespace client
+}  // namespace nebd
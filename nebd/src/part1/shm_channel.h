@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef NEBD_SRC_PART1_SHM_CHANNEL_H_
+#define NEBD_SRC_PART1_SHM_CHANNEL_H_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "nebd/src/common/shm_ring.h"
+#include "nebd/src/common/uncopyable.h"
+#include "nebd/src/part1/libnebd.h"
+#include "nebd/src/part1/nebd_common.h"
+
+namespace nebd {
+namespace client {
+
+using nebd::common::ShmRing;
+using nebd::common::ShmRingOp;
+
+// resend a request through rpc
+using ShmFallbackFunc = std::function<void(NebdClientAioContext*)>;
+
+/**
+ * Transfer reads and writes of one file through a shared memory ring.
+ * Data is copied once into a data slot registered at open time, and part2
+ * is notified by an eventfd instead of an rpc.
+ * If part2 exits, all in-flight requests are resent by the fallback and
+ * later requests go through rpc. A request that failed in part2 without
+ * returning the error is resent by the fallback too.
+ */
+class NebdShmChannel : public nebd::common::Uncopyable {
+ public:
+    NebdShmChannel(int fd, ShmFallbackFunc fallback);
+
+    ~NebdShmChannel();
+
+    /**
+     * @brief create the ring and hand it to part2
+     * @param sockPath socket path part2 accepts ring connections on
+     * @return 0 on success, -1 on failure
+     */
+    int Init(const std::string& sockPath, const ShmRingOption& option);
+
+    /**
+     * @brief wait in-flight requests finish and stop polling, requests
+     *        not finished in time are resent by the fallback
+     */
+    void Stop();
+
+    /**
+     * @brief submit a read request
+     * @return false if request can't go through the ring, such as no free
+     *         slot or channel is broken, caller should send it by rpc
+     */
+    bool AioRead(NebdClientAioContext* aioctx);
+
+    /**
+     * @brief submit a write request
+     * @return same as AioRead
+     */
+    bool AioWrite(NebdClientAioContext* aioctx);
+
+    bool IsBroken() const {
+        return broken_.load(std::memory_order_acquire);
+    }
+
+ private:
+    bool Submit(NebdClientAioContext* aioctx, ShmRingOp op);
+
+    void PollLoop();
+
+    void HandleCompletions();
+
+    // part2 exited, resend all in-flight requests
+    void OnBroken();
+
+ private:
+    // fd returned by part2
+    int fd_;
+    ShmFallbackFunc fallback_;
+
+    // connection to part2, closed by peer when part2 exits
+    int sock_ = -1;
+    // wake up poll thread when stopping
+    int stopEventFd_ = -1;
+
+    ShmRing ring_;
+
+    // protect free slots, in-flight requests and the submission ring
+    std::mutex mtx_;
+    std::condition_variable cond_;
+    std::vector<uint32_t> freeSlots_;
+    // in-flight requests indexed by slot
+    std::vector<NebdClientAioContext*> inflight_;
+    uint32_t inflightCount_ = 0;
+    // max time Stop waits for in-flight requests
+    uint32_t stopTimeoutMs_ = 0;
+
+    std::atomic<bool> broken_{false};
+    std::atomic<bool> stopping_{false};
+
+    std::thread pollThread_;
+};
+
+}  // namespace client
+}  // namespace nebd
+
+#endif  // NEBD_SRC_PART1_SHM_CHANNEL_H_
@@ -122,6 +122,12 @@ const char HEARTBEATTIMEOUTSEC[] = "heartbeat.timeout.sec";
 const char HEARTBEATCHECKINTERVALMS[] = "heartbeat.check.interval.ms";
 const char CURVECLIENTCONFPATH[] = "curveclient.confPath";
 const char RESPONSERETURNRPCWHENIOERROR[] = "response.returnRpcWhenIoError";
+const char SHMENABLE[] = "shm.enable";
+const char SHMMAXCONNECTIONS[] = "shm.maxConnections";
+const char REQUESTMERGEENABLE[] = "request.merge.enable";
+const char REQUESTMERGEWINDOWUS[] = "request.merge.windowUs";
+const char REQUESTMERGEMAXBYTES[] = "request.merge.maxBytes";
+const char REQUESTMERGEMAXREQUESTS[] = "request.merge.maxRequests";
 
 }  // namespace server
 }  // namespace nebd
@@ -148,10 +148,24 @@ bool NebdServer::InitCurveRequestExecutor() {
         return false;
     }
 
-    CurveRequestExecutor::GetInstance().Init(curveClient_);
+    RequestMergeOption mergeOption;
+    InitRequestMergeOption(&mergeOption);
+    CurveRequestExecutor::GetInstance().Init(curveClient_, mergeOption);
     return true;
 }
 
+void NebdServer::InitRequestMergeOption(RequestMergeOption *opt) {
+    conf_.GetBoolValue(REQUESTMERGEENABLE, &opt->enable);
+    conf_.GetUInt32Value(REQUESTMERGEWINDOWUS, &opt->windowUs);
+    conf_.GetUInt32Value(REQUESTMERGEMAXBYTES, &opt->maxBytes);
+    conf_.GetUInt32Value(REQUESTMERGEMAXREQUESTS, &opt->maxRequests);
+
+    LOG(INFO) << "NebdServer request merge enable: " << opt->enable
+              << ", windowUs: " << opt->windowUs
+              << ", maxBytes: " << opt->maxBytes
+              << ", maxRequests: " << opt->maxRequests;
+}
+
 MetaFileManagerPtr NebdServer::InitMetaFileManager() {
     NebdMetaFileManagerOption option;
     option.wrapper = std::make_shared<PosixWrapper>();
@@ -262,13 +276,44 @@ bool NebdServer::StartServer() {
         return false;
     }
 
+    StartShmService(returnRpcWhenIoError);
+
     isRunning_ = true;
     server_.RunUntilAskedToQuit();
 
     isRunning_ = false;
+    if (shmService_ != nullptr) {
+        shmService_->Stop();
+        shmService_.reset();
+    }
     fileLock.ReleaseFileLock();
     return true;
 }
 
+void NebdServer::StartShmService(bool returnRpcWhenIoError) {
+    bool enable = false;
+    if (!conf_.GetBoolValue(SHMENABLE, &enable) || !enable) {
+        LOG(INFO) << "NebdServer shm service is disabled";
+        return;
+    }
+
+    uint32_t maxConnections = 256;
+    LOG_IF(WARNING, !conf_.GetUInt32Value(SHMMAXCONNECTIONS, &maxConnections))
+        << "NebdServer get " << SHMMAXCONNECTIONS
+        << " fail, use default value " << maxConnections;
+
+    auto shmService = std::make_shared<NebdShmService>(
+        fileManager_, returnRpcWhenIoError, maxConnections);
+    int ret = shmService->Start(
+        nebd::common::ShmRingSockPath(listenAddress_));
+    if (ret != 0) {
+        LOG(WARNING) << "NebdServer start shm service fail, "
+                     << "read and write go through rpc only";
+        return;
+    }
+
+    shmService_ = shmService;
+}
+
 }  // namespace server
 }  // namespace nebd
@@ -30,6 +30,7 @@
 #include "nebd/src/part2/file_manager.h"
 #include "nebd/src/part2/heartbeat_manager.h"
 #include "nebd/src/part2/request_executor_curve.h"
+#include "nebd/src/part2/shm_service.h"
 
 namespace nebd {
 namespace server {
@@ -83,6 +84,12 @@ class NebdServer {
      */
     bool InitHeartbeatManagerOption(HeartbeatManagerOption *opt);
 
+    /**
+     * @brief 从配置文件初始化请求合并的配置项, 配置项均为可选
+     * @param[out] opt 请求合并的配置项
+     */
+    void InitRequestMergeOption(RequestMergeOption *opt);
+
     /**
      * @brief 初始化HeartbeatManager
      * @return false-初始化失败 true-初始化成功
@@ -95,6 +102,12 @@ class NebdServer {
      */
     bool StartServer();
 
+    /**
+     * @brief 启动共享内存ring服务，失败时读写请求仍然走rpc
+     * @param returnRpcWhenIoError io出错时是否返回错误
+     */
+    void StartShmService(bool returnRpcWhenIoError);
+
  private:
     // 配置项
     Configuration conf_;
@@ -111,6 +124,8 @@ class NebdServer {
     std::shared_ptr<HeartbeatManager> heartbeatManager_;
     // curveclient
     std::shared_ptr<CurveClient> curveClient_;
+    // 通过共享内存ring接收读写请求
+    std::shared_ptr<NebdShmService> shmService_;
 };
 
 }  // namespace server
@@ -80,8 +80,10 @@ std::string FileNameParser::Parse(const std::string& fileName) {
     return fileName.substr(beginPos, length);
 }
 
-void CurveRequestExecutor::Init(const std::shared_ptr<CurveClient> &client) {
+void CurveRequestExecutor::Init(const std::shared_ptr<CurveClient> &client,
+                                const RequestMergeOption& mergeOption) {
     client_ = client;
+    mergeOption_ = mergeOption;
 }
 
 std::shared_ptr<NebdFileInstance> CurveRequestExecutor::Open(
@@ -97,6 +99,7 @@ std::shared_ptr<NebdFileInstance> CurveRequestExecutor::Open(
         auto curveFileInstance = std::make_shared<CurveFileInstance>();
         curveFileInstance->fd = fd;
         curveFileInstance->fileName = curveFileName;
+        curveFileInstance->merger = NewMerger(fd);
         curveFileInstance->xattr[kSessionAttrKey] = "";
 
         if (openFlags) {
@@ -134,6 +137,7 @@ CurveRequestExecutor::Reopen(const std::string& filename,
         auto curveFileInstance = std::make_shared<CurveFileInstance>();
         curveFileInstance->fd = fd;
         curveFileInstance->fileName = curveFileName;
+        curveFileInstance->merger = NewMerger(fd);
         curveFileInstance->xattr[kSessionAttrKey] = newSessionId;
         if (xattr.count(kOpenFlagsAttrKey)) {
             curveFileInstance->xattr[kOpenFlagsAttrKey] =
@@ -151,6 +155,12 @@ int CurveRequestExecutor::Close(NebdFileInstance* fd) {
         return -1;
     }
 
+    // 提交合并窗口中尚未下发的请求
+    RequestMerger* merger = GetMergerFromNebdFileInstance(fd);
+    if (merger != nullptr) {
+        merger->Flush();
+    }
+
     int res = client_->Close(curveFd);
     if (res != LIBCURVE_ERROR::OK) {
         return -1;
@@ -225,6 +235,11 @@ int CurveRequestExecutor::AioRead(
         return -1;
     }
 
+    RequestMerger* merger = GetMergerFromNebdFileInstance(fd);
+    if (merger != nullptr) {
+        return merger->Add(aioctx);
+    }
+
     CurveAioCombineContext *curveCombineCtx = new CurveAioCombineContext();
     curveCombineCtx->nebdCtx = aioctx;
     int ret = FromNebdCtxToCurveCtx(aioctx, &curveCombineCtx->curveCtx);
@@ -250,6 +265,11 @@ int CurveRequestExecutor::AioWrite(
         return -1;
     }
 
+    RequestMerger* merger = GetMergerFromNebdFileInstance(fd);
+    if (merger != nullptr) {
+        return merger->Add(aioctx);
+    }
+
     CurveAioCombineContext *curveCombineCtx = new CurveAioCombineContext();
     curveCombineCtx->nebdCtx = aioctx;
     int ret = FromNebdCtxToCurveCtx(aioctx, &curveCombineCtx->curveCtx);
@@ -307,6 +327,24 @@ std::string CurveRequestExecutor::GetFileNameFromNebdFileInstance(
     return curveFileInstance->fileName;
 }
 
+std::shared_ptr<RequestMerger> CurveRequestExecutor::NewMerger(int fd) {
+    if (!mergeOption_.enable) {
+        return nullptr;
+    }
+
+    return std::make_shared<RequestMerger>(fd, client_, mergeOption_);
+}
+
+RequestMerger* CurveRequestExecutor::GetMergerFromNebdFileInstance(
+    NebdFileInstance* fd) {
+    auto curveFileInstance = dynamic_cast<CurveFileInstance *>(fd);
+    if (curveFileInstance == nullptr) {
+        return nullptr;
+    }
+
+    return curveFileInstance->merger.get();
+}
+
 int CurveRequestExecutor::FromNebdCtxToCurveCtx(
         NebdServerAioContext *nebdCtx, CurveAioContext *curveCtx) {
     curveCtx->offset = nebdCtx->offset;
@@ -26,6 +26,7 @@
 #include <string>
 #include <memory>
 #include "nebd/src/part2/request_executor.h"
+#include "nebd/src/part2/request_merger.h"
 #include "nebd/src/part2/define.h"
 #include "include/client/libcurve.h"
 
@@ -41,6 +42,8 @@ class CurveFileInstance : public NebdFileInstance {
 
     int fd = -1;
     std::string fileName;
+    // 合并连续读写请求, 未开启时为空
+    std::shared_ptr<RequestMerger> merger;
 };
 
 class CurveAioCombineContext {
@@ -70,7 +73,8 @@ class CurveRequestExecutor : public NebdRequestExecutor {
         return executor;
     }
     ~CurveRequestExecutor() {}
-    void Init(const std::shared_ptr<CurveClient> &client);
+    void Init(const std::shared_ptr<CurveClient> &client,
+              const RequestMergeOption& mergeOption = RequestMergeOption());
     std::shared_ptr<NebdFileInstance> Open(const std::string& filename,
                                            const OpenFlags* openflags) override;
     std::shared_ptr<NebdFileInstance> Reopen(
@@ -121,8 +125,23 @@ class CurveRequestExecutor : public NebdRequestExecutor {
      */
      int FromNebdOpToCurveOp(LIBAIO_OP op, LIBCURVE_OP *out);
 
+    /**
+     * @brief 开启请求合并时为文件创建RequestMerger
+     * @param[in] fd curve_client中文件的fd
+     * @return 未开启合并时返回空
+     */
+    std::shared_ptr<RequestMerger> NewMerger(int fd);
+
+    /**
+     * @brief 获取文件的RequestMerger
+     * @param[in] fd NebdFileInstance类型
+     * @return 未开启合并时返回空
+     */
+    RequestMerger* GetMergerFromNebdFileInstance(NebdFileInstance* fd);
+
  private:
     std::shared_ptr<::curve::client::CurveClient> client_;
+    RequestMergeOption mergeOption_;
 };
 
 }  // namespace server
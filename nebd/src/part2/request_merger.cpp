@@ -0,0 +1,280 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include "nebd/src/part2/request_merger.h"
+
+#include <bthread/unstable.h>
+#include <butil/iobuf.h>
+#include <butil/time.h>
+#include <bvar/bvar.h>
+#include <glog/logging.h>
+
+#include <type_traits>
+#include <utility>
+
+#include "nebd/src/common/timeutility.h"
+#include "nebd/src/part2/request_executor_curve.h"
+
+namespace nebd {
+namespace server {
+
+using nebd::common::TimeUtility;
+
+namespace {
+
+struct RequestMergeMetric {
+    RequestMergeMetric()
+        : mergeCount("nebd_server_request_merge_count"),
+          waitLatency("nebd_server_request_merge_wait") {}
+
+    // number of requests in each libcurve request, i.e. merge ratio
+    bvar::LatencyRecorder mergeCount;
+    // latency added by the merge window, in us
+    bvar::LatencyRecorder waitLatency;
+};
+
+RequestMergeMetric& GetMergeMetric() {
+    static RequestMergeMetric metric;
+    return metric;
+}
+
+// requests combined into one libcurve request
+struct MergedRequests {
+    butil::IOBuf data;
+    std::vector<NebdServerAioContext*> ctxs;
+};
+
+// a libcurve request combined from several contiguous requests.
+// it is standard layout and curveCtx is the first member, so the
+// CurveAioContext passed to the callback can be cast back to it
+struct MergedAioContext {
+    CurveAioContext curveCtx;
+    MergedRequests* requests;
+};
+
+static_assert(std::is_standard_layout<MergedAioContext>::value,
+              "MergedAioContext must be standard layout");
+
+void MergedAioCallback(CurveAioContext* curveCtx) {
+    std::unique_ptr<MergedAioContext> merged(
+        reinterpret_cast<MergedAioContext*>(curveCtx));
+    std::unique_ptr<MergedRequests> requests(merged->requests);
+
+    for (auto* ctx : requests->ctxs) {
+        if (curveCtx->ret < 0) {
+            ctx->ret = curveCtx->ret;
+        } else {
+            if (ctx->op == LIBAIO_OP::LIBAIO_OP_READ) {
+                requests->data.cutn(
+                    reinterpret_cast<butil::IOBuf*>(ctx->buf), ctx->size);
+            }
+            ctx->ret = ctx->size;
+        }
+        ctx->cb(ctx);
+    }
+}
+
+}  // namespace
+
+RequestMerger::RequestMerger(int curveFd,
+                             std::shared_ptr<CurveClient> client,
+                             const RequestMergeOption& option)
+    : curveFd_(curveFd), client_(std::move(client)), option_(option) {}
+
+int RequestMerger::Add(NebdServerAioContext* aioctx) {
+    if (aioctx->op != LIBAIO_OP::LIBAIO_OP_READ &&
+        aioctx->op != LIBAIO_OP::LIBAIO_OP_WRITE) {
+        return -1;
+    }
+
+    int index = BatchIndex(aioctx->op);
+    Batch full;
+    Batch ready;
+    bool startTimer = false;
+    uint64_t seq = 0;
+
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        Batch& batch = batches_[index];
+
+        // not contiguous with pending requests, submit them first
+        if (!batch.ctxs.empty() &&
+            (aioctx->offset !=
+                 static_cast<off_t>(batch.offset + batch.length) ||
+             batch.length + aioctx->size > option_.maxBytes)) {
+            std::swap(full, batch);
+        }
+
+        if (batch.ctxs.empty()) {
+            batch.op = aioctx->op;
+            batch.offset = aioctx->offset;
+            batch.seq = ++nextSeq_;
+            startTimer = true;
+        }
+
+        batch.ctxs.push_back(aioctx);
+        batch.arriveUs.push_back(TimeUtility::GetTimeofDayUs());
+        batch.length += aioctx->size;
+        seq = batch.seq;
+
+        if (batch.length >= option_.maxBytes ||
+            batch.ctxs.size() >= option_.maxRequests) {
+            std::swap(ready, batch);
+            startTimer = false;
+        }
+    }
+
+    if (!full.ctxs.empty()) {
+        Submit(&full);
+    }
+
+    if (startTimer) {
+        StartTimer(index, seq);
+    }
+
+    if (!ready.ctxs.empty()) {
+        Submit(&ready);
+    }
+
+    return 0;
+}
+
+void RequestMerger::Flush() {
+    Batch pending[2];
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        std::swap(pending[0], batches_[0]);
+        std::swap(pending[1], batches_[1]);
+    }
+
+    for (auto& batch : pending) {
+        if (!batch.ctxs.empty()) {
+            Submit(&batch);
+        }
+    }
+}
+
+void RequestMerger::StartTimer(int index, uint64_t seq) {
+    TimerArg* arg = new TimerArg{shared_from_this(), index, seq};
+    bthread_timer_t timer;
+    int ret = bthread_timer_add(
+        &timer, butil::microseconds_from_now(option_.windowUs),
+        &RequestMerger::OnTimer, arg);
+    if (ret != 0) {
+        LOG(WARNING) << "Add merge timer failed, submit immediately, ret = "
+                     << ret;
+        delete arg;
+        FlushIfMatch(index, seq);
+    }
+}
+
+void RequestMerger::OnTimer(void* arg) {
+    std::unique_ptr<TimerArg> timerArg(static_cast<TimerArg*>(arg));
+    timerArg->merger->FlushIfMatch(timerArg->index, timerArg->seq);
+}
+
+void RequestMerger::FlushIfMatch(int index, uint64_t seq) {
+    Batch batch;
+    {
+        std::lock_guard<std::mutex> lk(mtx_);
+        // already submitted by following requests
+        if (batches_[index].seq != seq || batches_[index].ctxs.empty()) {
+            return;
+        }
+        std::swap(batch, batches_[index]);
+    }
+
+    Submit(&batch);
+}
+
+void RequestMerger::Submit(Batch* batch) {
+    auto& metric = GetMergeMetric();
+    uint64_t now = TimeUtility::GetTimeofDayUs();
+    for (auto arrive : batch->arriveUs) {
+        metric.waitLatency << (now - arrive);
+    }
+    metric.mergeCount << batch->ctxs.size();
+
+    bool isRead = batch->op == LIBAIO_OP::LIBAIO_OP_READ;
+
+    // single request, no need to combine buffers
+    if (batch->ctxs.size() == 1) {
+        NebdServerAioContext* aioctx = batch->ctxs[0];
+        CurveAioCombineContext* combineCtx = new CurveAioCombineContext();
+        combineCtx->nebdCtx = aioctx;
+        CurveAioContext* curveCtx = &combineCtx->curveCtx;
+        curveCtx->offset = aioctx->offset;
+        curveCtx->length = aioctx->size;
+        curveCtx->op = isRead ? LIBCURVE_OP_READ : LIBCURVE_OP_WRITE;
+        curveCtx->buf = aioctx->buf;
+        curveCtx->cb = CurveAioCallback;
+
+        int ret = isRead
+                      ? client_->AioRead(curveFd_, curveCtx,
+                                         curve::client::UserDataType::IOBuffer)
+                      : client_->AioWrite(
+                            curveFd_, curveCtx,
+                            curve::client::UserDataType::IOBuffer);
+        if (ret != LIBCURVE_ERROR::OK) {
+            LOG(ERROR) << "Curve client return failed, curve fd: " << curveFd_
+                       << ", ret = " << ret;
+            delete combineCtx;
+            aioctx->ret = -1;
+            aioctx->cb(aioctx);
+        }
+        return;
+    }
+
+    MergedAioContext* merged = new MergedAioContext();
+    merged->requests = new MergedRequests();
+    merged->requests->ctxs = std::move(batch->ctxs);
+    if (!isRead) {
+        for (auto* ctx : merged->requests->ctxs) {
+            merged->requests->data.append(
+                *reinterpret_cast<butil::IOBuf*>(ctx->buf));
+        }
+    }
+
+    CurveAioContext* curveCtx = &merged->curveCtx;
+    curveCtx->offset = batch->offset;
+    curveCtx->length = batch->length;
+    curveCtx->op = isRead ? LIBCURVE_OP_READ : LIBCURVE_OP_WRITE;
+    curveCtx->buf = &merged->requests->data;
+    curveCtx->cb = MergedAioCallback;
+
+    int ret = isRead
+                  ? client_->AioRead(curveFd_, curveCtx,
+                                     curve::client::UserDataType::IOBuffer)
+                  : client_->AioWrite(curveFd_, curveCtx,
+                                      curve::client::UserDataType::IOBuffer);
+    if (ret != LIBCURVE_ERROR::OK) {
+        LOG(ERROR) << "Curve client return failed, curve fd: " << curveFd_
+                   << ", offset: " << batch->offset
+                   << ", length: " << batch->length
+                   << ", ret = " << ret;
+        curveCtx->ret = -1;
+        MergedAioCallback(curveCtx);
+    }
+}
+
+}  // namespace server
+}  // namespace nebd
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef NEBD_SRC_PART2_REQUEST_MERGER_H_
+#define NEBD_SRC_PART2_REQUEST_MERGER_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <mutex>  // NOLINT
+#include <vector>
+
+#include "include/client/libcurve.h"
+#include "nebd/src/part2/define.h"
+
+namespace nebd {
+namespace server {
+
+using ::curve::client::CurveClient;
+
+struct RequestMergeOption {
+    // whether merge contiguous requests of the same file
+    bool enable = false;
+    // max time that a request waits for following requests, in us
+    uint32_t windowUs = 100;
+    // max bytes of a merged request
+    uint32_t maxBytes = 1024 * 1024;
+    // max number of requests in a merged request
+    uint32_t maxRequests = 32;
+};
+
+/**
+ * Merge contiguous reads or writes of one file into a single libcurve
+ * aio request, the completion is split back to the original requests.
+ * A request waits at most windowUs for following requests, so the
+ * merged size and the added latency are both bounded.
+ */
+class RequestMerger : public std::enable_shared_from_this<RequestMerger> {
+ public:
+    RequestMerger(int curveFd,
+                  std::shared_ptr<CurveClient> client,
+                  const RequestMergeOption& option);
+
+    /**
+     * @brief add a read or write request
+     * @return 0 means request is accepted and will be completed by its
+     *         callback, otherwise the request is rejected
+     */
+    int Add(NebdServerAioContext* aioctx);
+
+    /**
+     * @brief submit all pending requests immediately
+     */
+    void Flush();
+
+ private:
+    struct Batch {
+        LIBAIO_OP op = LIBAIO_OP::LIBAIO_OP_UNKNOWN;
+        off_t offset = 0;
+        size_t length = 0;
+        // identify the batch for its timer
+        uint64_t seq = 0;
+        std::vector<NebdServerAioContext*> ctxs;
+        // arrive time of each request, in us
+        std::vector<uint64_t> arriveUs;
+    };
+
+    struct TimerArg {
+        std::shared_ptr<RequestMerger> merger;
+        int index;
+        uint64_t seq;
+    };
+
+    static void OnTimer(void* arg);
+
+    void FlushIfMatch(int index, uint64_t seq);
+
+    void StartTimer(int index, uint64_t seq);
+
+    void Submit(Batch* batch);
+
+    static int BatchIndex(LIBAIO_OP op) {
+        return op == LIBAIO_OP::LIBAIO_OP_READ ? 0 : 1;
+    }
+
+ private:
+    int curveFd_;
+    std::shared_ptr<CurveClient> client_;
+    RequestMergeOption option_;
+
+    std::mutex mtx_;
+    // pending reads and writes
+    Batch batches_[2];
+    uint64_t nextSeq_ = 0;
+};
+
+}  // namespace server
+}  // namespace nebd
+
+#endif  // NEBD_SRC_PART2_REQUEST_MERGER_H_
@@ -0,0 +1,434 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include "nebd/src/part2/shm_service.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <butil/iobuf.h>
+#include <glog/logging.h>
+
+#include <utility>
+
+#include "nebd/src/part2/util.h"
+
+namespace nebd {
+namespace server {
+
+using nebd::common::ShmCompleteEntry;
+using nebd::common::ShmHandshakeRequest;
+using nebd::common::ShmHandshakeResponse;
+using nebd::common::ShmRingOp;
+using nebd::common::ShmSubmitEntry;
+using nebd::common::kShmRingMagic;
+
+namespace {
+
+// timeout of receiving the ring from part1
+const int kHandshakeTimeoutMs = 3000;
+
+void EmptyDeleter(void*) {}
+
+// holds the connection until the request completes, so the data slot
+// stays mapped even if part1 has gone
+struct ShmRequestClosure : public Closure {
+    ShmRequestClosure(std::shared_ptr<NebdShmConnection> conn, uint32_t slot)
+        : conn(std::move(conn)), slot(slot) {}
+
+    void Run() override {
+        std::unique_ptr<ShmRequestClosure> selfGuard(this);
+        conn->Complete(slot, ret);
+    }
+
+    std::shared_ptr<NebdShmConnection> conn;
+    uint32_t slot;
+    int ret = -1;
+};
+
+void NebdShmServiceCallback(NebdServerAioContext* context) {
+    CHECK(context != nullptr);
+    std::unique_ptr<NebdServerAioContext> contextGuard(context);
+    std::unique_ptr<butil::IOBuf> iobufGuard(
+        reinterpret_cast<butil::IOBuf*>(context->buf));
+    std::unique_ptr<ShmRequestClosure> done(
+        static_cast<ShmRequestClosure*>(context->done));
+
+    if (context->ret < 0 && !context->returnRpcWhenIoError) {
+        LOG(ERROR) << *context;
+        // same as rpc, never return io error. the request can't be dropped
+        // like rpc, because part1 has no timeout on the ring, so let part1
+        // resend it by rpc, which retries until success
+        LOG(ERROR) << Op2Str(context->op)
+                   << " file failed and resend the shm request by rpc.";
+        done->ret = nebd::common::kShmRetryByRpc;
+    } else if (context->ret < 0) {
+        LOG(ERROR) << *context;
+        done->ret = -1;
+    } else if (context->op == LIBAIO_OP::LIBAIO_OP_READ) {
+        size_t n = iobufGuard->copy_to(done->conn->SlotBuffer(done->slot),
+                                       context->size);
+        done->ret = n == context->size ? 0 : -1;
+    } else {
+        done->ret = 0;
+    }
+
+    done.release()->Run();
+}
+
+}  // namespace
+
+NebdShmConnection::NebdShmConnection(int sock,
+                                     NebdFileManagerPtr fileManager,
+                                     bool returnRpcWhenIoError)
+    : sock_(sock),
+      fileManager_(std::move(fileManager)),
+      returnRpcWhenIoError_(returnRpcWhenIoError) {}
+
+NebdShmConnection::~NebdShmConnection() {
+    if (sock_ >= 0) {
+        ::close(sock_);
+    }
+}
+
+int NebdShmConnection::Handshake() {
+    struct timeval tv;
+    tv.tv_sec = kHandshakeTimeoutMs / 1000;
+    tv.tv_usec = (kHandshakeTimeoutMs % 1000) * 1000;
+    ::setsockopt(sock_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    ::setsockopt(sock_, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    ShmHandshakeRequest request;
+    int fds[3];
+    int nfds = 3;
+    if (nebd::common::RecvWithFds(sock_, &request, sizeof(request),
+                                  fds, &nfds) != 0) {
+        LOG(ERROR) << "Receive shm ring failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    ShmHandshakeResponse response;
+    response.ret = -1;
+    if (nfds != 3 || request.magic != kShmRingMagic) {
+        LOG(ERROR) << "Invalid shm handshake, nfds = " << nfds
+                   << ", magic = " << request.magic;
+        for (int i = 0; i < nfds; ++i) {
+            ::close(fds[i]);
+        }
+    } else if (ring_.Attach(fds[0], fds[1], fds[2]) != 0) {
+        LOG(ERROR) << "Attach shm ring failed, fd = " << request.fd;
+    } else if (fileManager_->GetFileEntity(request.fd) == nullptr) {
+        LOG(ERROR) << "Attach shm ring failed, file not exist, fd = "
+                   << request.fd;
+    } else {
+        fd_ = request.fd;
+        response.ret = 0;
+    }
+
+    if (::send(sock_, &response, sizeof(response), MSG_NOSIGNAL) !=
+        sizeof(response)) {
+        LOG(ERROR) << "Send shm handshake response failed, fd = "
+                   << request.fd << ", error: " << strerror(errno);
+        return -1;
+    }
+
+    if (response.ret == 0) {
+        LOG(INFO) << "Attach shm ring success, fd = " << fd_
+                  << ", depth = " << ring_.Depth()
+                  << ", slot size = " << ring_.SlotSize();
+    }
+    return response.ret;
+}
+
+void NebdShmConnection::Serve(int stopEventFd) {
+    struct pollfd fds[3];
+    fds[0].fd = ring_.SubmitEventFd();
+    fds[0].events = POLLIN;
+    fds[1].fd = sock_;
+    fds[1].events = POLLIN | POLLRDHUP;
+    fds[2].fd = stopEventFd;
+    fds[2].events = POLLIN;
+
+    while (true) {
+        int ret = ::poll(fds, 3, -1);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG(ERROR) << "Poll shm ring failed, fd = " << fd_
+                       << ", error: " << strerror(errno);
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            ring_.ConsumeSubmitEvent();
+            HandleSubmissions();
+        }
+
+        // part1 sends nothing after handshake, any event means that the
+        // file is closed or part1 has exited
+        if (fds[1].revents != 0 || (fds[2].revents & POLLIN)) {
+            break;
+        }
+    }
+
+    LOG(INFO) << "Shm ring disconnected, fd = " << fd_;
+}
+
+void NebdShmConnection::HandleSubmissions() {
+    ShmSubmitEntry entry;
+    while (ring_.PopSubmit(&entry)) {
+        if (Submit(entry) != 0) {
+            Complete(entry.slot, -1);
+        }
+    }
+}
+
+int NebdShmConnection::Submit(const ShmSubmitEntry& entry) {
+    if (entry.slot >= ring_.Depth() || entry.length > ring_.SlotSize()) {
+        LOG(ERROR) << "Invalid shm request, fd = " << fd_
+                   << ", slot = " << entry.slot
+                   << ", length = " << entry.length;
+        return -1;
+    }
+
+    std::unique_ptr<NebdServerAioContext> aioContext(
+        new NebdServerAioContext());
+    aioContext->offset = entry.offset;
+    aioContext->size = entry.length;
+    aioContext->cb = NebdShmServiceCallback;
+    aioContext->returnRpcWhenIoError = returnRpcWhenIoError_;
+
+    std::unique_ptr<butil::IOBuf> buf(new butil::IOBuf());
+    std::unique_ptr<ShmRequestClosure> done(
+        new ShmRequestClosure(shared_from_this(), entry.slot));
+    aioContext->buf = buf.get();
+    aioContext->done = done.get();
+
+    int rc = -1;
+    switch (static_cast<ShmRingOp>(entry.op)) {
+        case ShmRingOp::READ:
+            aioContext->op = LIBAIO_OP::LIBAIO_OP_READ;
+            rc = fileManager_->AioRead(fd_, aioContext.get());
+            break;
+        case ShmRingOp::WRITE:
+            // slot is not reused by part1 until the request completes
+            aioContext->op = LIBAIO_OP::LIBAIO_OP_WRITE;
+            buf->append_user_data(ring_.SlotBuffer(entry.slot),
+                                  entry.length, EmptyDeleter);
+            rc = fileManager_->AioWrite(fd_, aioContext.get());
+            break;
+        default:
+            LOG(ERROR) << "Unknown shm request op = " << entry.op
+                       << ", fd = " << fd_;
+            return -1;
+    }
+
+    if (rc < 0) {
+        LOG(ERROR) << Op2Str(aioContext->op) << " file failed. "
+                   << "fd: " << fd_
+                   << ", offset: " << entry.offset
+                   << ", size: " << entry.length
+                   << ", return code: " << rc;
+        return -1;
+    }
+
+    aioContext.release();
+    buf.release();
+    done.release();
+    return 0;
+}
+
+void NebdShmConnection::Complete(uint32_t slot, int ret) {
+    ShmCompleteEntry entry;
+    entry.slot = slot;
+    entry.ret = ret;
+
+    {
+        std::lock_guard<std::mutex> lk(completeMtx_);
+        // never fails, part1 holds a slot for each in-flight request
+        ring_.PushComplete(entry);
+    }
+
+    ring_.NotifyComplete();
+}
+
+NebdShmService::NebdShmService(NebdFileManagerPtr fileManager,
+                               bool returnRpcWhenIoError,
+                               uint32_t maxConnections)
+    : fileManager_(std::move(fileManager)),
+      returnRpcWhenIoError_(returnRpcWhenIoError),
+      maxConnections_(maxConnections) {}
+
+NebdShmService::~NebdShmService() {
+    Stop();
+}
+
+int NebdShmService::Start(const std::string& sockPath) {
+    struct sockaddr_un addr;
+    if (sockPath.size() >= sizeof(addr.sun_path)) {
+        LOG(ERROR) << "Socket path too long, path = " << sockPath;
+        return -1;
+    }
+
+    stopEventFd_ = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (stopEventFd_ < 0) {
+        LOG(ERROR) << "Create eventfd failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        LOG(ERROR) << "Create socket failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    // socket file left by last run
+    ::unlink(sockPath.c_str());
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, sockPath.c_str(), sockPath.size());
+    if (::bind(listenFd_, reinterpret_cast<struct sockaddr*>(&addr),
+               sizeof(addr)) != 0 ||
+        ::listen(listenFd_, SOMAXCONN) != 0) {
+        LOG(ERROR) << "Listen on " << sockPath
+                   << " failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    // let everyone can connect to this socket
+    if (::chmod(sockPath.c_str(), 0777) != 0) {
+        LOG(ERROR) << "chmod " << sockPath
+                   << " mode to 0777 failed, error: " << strerror(errno);
+        return -1;
+    }
+
+    sockPath_ = sockPath;
+    acceptThread_ = std::thread(&NebdShmService::AcceptLoop, this);
+    LOG(INFO) << "NebdShmService start at " << sockPath;
+    return 0;
+}
+
+void NebdShmService::Stop() {
+    if (stopEventFd_ >= 0) {
+        // counter is never consumed, so all pollers are woken up
+        ::eventfd_write(stopEventFd_, 1);
+    }
+
+    if (acceptThread_.joinable()) {
+        acceptThread_.join();
+    }
+
+    for (auto& worker : workers_) {
+        worker->thread.join();
+    }
+    workers_.clear();
+
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        ::unlink(sockPath_.c_str());
+    }
+
+    if (stopEventFd_ >= 0) {
+        ::close(stopEventFd_);
+        stopEventFd_ = -1;
+    }
+}
+
+void NebdShmService::AcceptLoop() {
+    struct pollfd fds[2];
+    fds[0].fd = listenFd_;
+    fds[0].events = POLLIN;
+    fds[1].fd = stopEventFd_;
+    fds[1].events = POLLIN;
+
+    while (true) {
+        int ret = ::poll(fds, 2, -1);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG(ERROR) << "Poll shm listen socket failed, error: "
+                       << strerror(errno);
+            return;
+        }
+
+        if (fds[1].revents & POLLIN) {
+            return;
+        }
+
+        if (!(fds[0].revents & POLLIN)) {
+            continue;
+        }
+
+        int sock = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (sock < 0) {
+            LOG(WARNING) << "Accept shm connection failed, error: "
+                         << strerror(errno);
+            continue;
+        }
+
+        ReapFinishedWorkers();
+        if (workers_.size() >= maxConnections_) {
+            // part1 fails the handshake and keeps using rpc
+            LOG(WARNING) << "Too many shm connections, refuse new one, "
+                         << "current = " << workers_.size()
+                         << ", max = " << maxConnections_;
+            ::close(sock);
+            continue;
+        }
+
+        auto conn = std::make_shared<NebdShmConnection>(
+            sock, fileManager_, returnRpcWhenIoError_);
+        std::unique_ptr<Worker> worker(new Worker());
+        Worker* w = worker.get();
+        int stopEventFd = stopEventFd_;
+        w->thread = std::thread([conn, w, stopEventFd]() {
+            if (conn->Handshake() == 0) {
+                conn->Serve(stopEventFd);
+            }
+            w->finished.store(true, std::memory_order_release);
+        });
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void NebdShmService::ReapFinishedWorkers() {
+    for (auto iter = workers_.begin(); iter != workers_.end();) {
+        if ((*iter)->finished.load(std::memory_order_acquire)) {
+            (*iter)->thread.join();
+            iter = workers_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+}  // namespace server
+}  // namespace nebd
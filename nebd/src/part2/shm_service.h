@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef NEBD_SRC_PART2_SHM_SERVICE_H_
+#define NEBD_SRC_PART2_SHM_SERVICE_H_
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+
+#include "nebd/src/common/shm_ring.h"
+#include "nebd/src/part2/define.h"
+#include "nebd/src/part2/file_manager.h"
+
+namespace nebd {
+namespace server {
+
+using nebd::common::ShmRing;
+
+/**
+ * A shared memory ring of one file opened by part1.
+ * A worker thread pops submission entries and issues them to the file
+ * manager, completions are pushed back by the aio callbacks.
+ */
+class NebdShmConnection
+    : public std::enable_shared_from_this<NebdShmConnection> {
+ public:
+    NebdShmConnection(int sock, NebdFileManagerPtr fileManager,
+                      bool returnRpcWhenIoError);
+
+    ~NebdShmConnection();
+
+    /**
+     * @brief receive the ring from part1 and attach to it
+     * @return 0 on success, -1 on failure
+     */
+    int Handshake();
+
+    /**
+     * @brief serve requests until part1 disconnects or stopEventFd is
+     *        notified
+     */
+    void Serve(int stopEventFd);
+
+    /**
+     * @brief push completion of a request, called by aio callbacks
+     */
+    void Complete(uint32_t slot, int ret);
+
+    char* SlotBuffer(uint32_t slot) const {
+        return ring_.SlotBuffer(slot);
+    }
+
+    bool ReturnRpcWhenIoError() const {
+        return returnRpcWhenIoError_;
+    }
+
+    int Fd() const {
+        return fd_;
+    }
+
+ private:
+    void HandleSubmissions();
+
+    int Submit(const nebd::common::ShmSubmitEntry& entry);
+
+ private:
+    int sock_;
+    // fd returned by OpenFile
+    int fd_ = -1;
+    NebdFileManagerPtr fileManager_;
+    bool returnRpcWhenIoError_;
+
+    ShmRing ring_;
+    // serialize producers of the completion ring
+    std::mutex completeMtx_;
+};
+
+/**
+ * Accept shared memory rings from part1.
+ * Reads and writes of these files are transferred by the rings, and other
+ * operations still go through NebdFileServiceImpl.
+ * Each ring is served by its own worker thread, connections beyond
+ * maxConnections are refused and part1 sends their requests by rpc.
+ */
+class NebdShmService {
+ public:
+    NebdShmService(NebdFileManagerPtr fileManager, bool returnRpcWhenIoError,
+                   uint32_t maxConnections);
+
+    ~NebdShmService();
+
+    /**
+     * @brief listen on sockPath and start accepting
+     * @return 0 on success, -1 on failure
+     */
+    int Start(const std::string& sockPath);
+
+    void Stop();
+
+ private:
+    void AcceptLoop();
+
+    void ReapFinishedWorkers();
+
+    struct Worker {
+        std::thread thread;
+        std::atomic<bool> finished{false};
+    };
+
+ private:
+    NebdFileManagerPtr fileManager_;
+    bool returnRpcWhenIoError_;
+    // max number of rings served at the same time
+    uint32_t maxConnections_;
+
+    std::string sockPath_;
+    int listenFd_ = -1;
+    // notify accept thread and all workers to exit
+    int stopEventFd_ = -1;
+
+    std::thread acceptThread_;
+    std::list<std::unique_ptr<Worker>> workers_;
+};
+
+}  // namespace server
+}  // namespace nebd
+
+#endif  // NEBD_SRC_PART2_SHM_SERVICE_H_
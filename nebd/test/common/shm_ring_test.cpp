@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "nebd/src/common/shm_ring.h"
+
+namespace nebd {
+namespace common {
+
+TEST(ShmRingTest, InvalidOptionTest) {
+    ShmRing ring;
+    ASSERT_EQ(-1, ring.Create(3, 4096));
+    ASSERT_EQ(-1, ring.Create(4, 0));
+}
+
+TEST(ShmRingTest, SubmitAndCompleteTest) {
+    ShmRing producer;
+    ASSERT_EQ(0, producer.Create(4, 4096));
+    ASSERT_EQ(4, producer.Depth());
+    ASSERT_EQ(4096, producer.SlotSize());
+
+    // pass fds to peer through unix socket, as part1 does
+    int socks[2];
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_STREAM, 0, socks));
+    int fds[3] = {producer.MemFd(), producer.SubmitEventFd(),
+                  producer.CompleteEventFd()};
+    int payload = 100;
+    ASSERT_EQ(0, SendWithFds(socks[0], &payload, sizeof(payload), fds, 3));
+
+    int received[3];
+    int nfds = 3;
+    int value = 0;
+    ASSERT_EQ(0, RecvWithFds(socks[1], &value, sizeof(value),
+                             received, &nfds));
+    ASSERT_EQ(100, value);
+    ASSERT_EQ(3, nfds);
+    close(socks[0]);
+    close(socks[1]);
+
+    ShmRing consumer;
+    ASSERT_EQ(0, consumer.Attach(received[0], received[1], received[2]));
+    ASSERT_EQ(4, consumer.Depth());
+    ASSERT_EQ(4096, consumer.SlotSize());
+
+    // nothing submitted
+    ShmSubmitEntry sqe;
+    ASSERT_FALSE(consumer.PopSubmit(&sqe));
+    ASSERT_FALSE(consumer.ConsumeSubmitEvent());
+
+    // data written by producer is visible to consumer
+    memset(producer.SlotBuffer(1), 'a', 4096);
+    for (uint32_t i = 0; i < 4; ++i) {
+        ShmSubmitEntry entry{i, static_cast<uint32_t>(ShmRingOp::WRITE),
+                             i * 4096ull, 4096};
+        ASSERT_TRUE(producer.PushSubmit(entry));
+    }
+    ShmSubmitEntry full{0, static_cast<uint32_t>(ShmRingOp::READ), 0, 4096};
+    ASSERT_FALSE(producer.PushSubmit(full));
+    producer.NotifySubmit();
+
+    ASSERT_TRUE(consumer.ConsumeSubmitEvent());
+    for (uint32_t i = 0; i < 4; ++i) {
+        ASSERT_TRUE(consumer.PopSubmit(&sqe));
+        ASSERT_EQ(i, sqe.slot);
+        ASSERT_EQ(i * 4096ull, sqe.offset);
+        ASSERT_EQ(4096, sqe.length);
+    }
+    ASSERT_FALSE(consumer.PopSubmit(&sqe));
+    ASSERT_EQ('a', consumer.SlotBuffer(1)[0]);
+    ASSERT_EQ('a', consumer.SlotBuffer(1)[4095]);
+
+    // ring is reusable after entries are consumed
+    ASSERT_TRUE(producer.PushSubmit(full));
+
+    // completions
+    ShmCompleteEntry cqe;
+    ASSERT_FALSE(producer.PopComplete(&cqe));
+    memset(consumer.SlotBuffer(2), 'b', 4096);
+    ASSERT_TRUE(consumer.PushComplete({2, 0}));
+    ASSERT_TRUE(consumer.PushComplete({3, -1}));
+    consumer.NotifyComplete();
+
+    ASSERT_TRUE(producer.ConsumeCompleteEvent());
+    ASSERT_FALSE(producer.ConsumeCompleteEvent());
+    ASSERT_TRUE(producer.PopComplete(&cqe));
+    ASSERT_EQ(2, cqe.slot);
+    ASSERT_EQ(0, cqe.ret);
+    ASSERT_EQ('b', producer.SlotBuffer(2)[100]);
+    ASSERT_TRUE(producer.PopComplete(&cqe));
+    ASSERT_EQ(3, cqe.slot);
+    ASSERT_EQ(-1, cqe.ret);
+    ASSERT_FALSE(producer.PopComplete(&cqe));
+}
+
+TEST(ShmRingTest, AttachInvalidRegionTest) {
+    int memFd = memfd_create("test", 0);
+    ASSERT_GE(memFd, 0);
+    ASSERT_EQ(0, ftruncate(memFd, 4096));
+
+    ShmRing ring;
+    ASSERT_EQ(-1, ring.Attach(memFd, -1, -1));
+    ASSERT_EQ(-1, ring.MemFd());
+}
+
+}  // namespace common
+}  // namespace nebd
@@ -0,0 +1,339 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "nebd/src/part1/shm_channel.h"
+
+namespace nebd {
+namespace client {
+
+using nebd::common::ShmCompleteEntry;
+using nebd::common::ShmHandshakeRequest;
+using nebd::common::ShmHandshakeResponse;
+using nebd::common::ShmSubmitEntry;
+
+const char kSockPath[] = "./nebd-shm-channel-test.sock";
+const int kFileFd = 10;
+
+std::atomic<int> completeCount{0};
+
+void ShmChannelTestCallback(NebdClientAioContext* ctx) {
+    completeCount.fetch_add(1);
+}
+
+// a fake part2 which serves one ring
+class FakeShmServer {
+ public:
+    int Start(bool autoComplete, int32_t completeRet = 0) {
+        autoComplete_ = autoComplete;
+        completeRet_ = completeRet;
+        ::unlink(kSockPath);
+        listenFd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, kSockPath, sizeof(addr.sun_path) - 1);
+        if (::bind(listenFd_, reinterpret_cast<struct sockaddr*>(&addr),
+                   sizeof(addr)) != 0 ||
+            ::listen(listenFd_, 1) != 0) {
+            return -1;
+        }
+
+        thread_ = std::thread(&FakeShmServer::Serve, this);
+        return 0;
+    }
+
+    // close the connection as if part2 exited
+    void Stop() {
+        stop_.store(true);
+        thread_.join();
+        ::close(sock_);
+        ::close(listenFd_);
+        ::unlink(kSockPath);
+    }
+
+    std::vector<ShmSubmitEntry> Received() {
+        std::lock_guard<std::mutex> lk(mtx_);
+        return received_;
+    }
+
+    std::string written;
+
+ private:
+    void Serve() {
+        sock_ = ::accept(listenFd_, nullptr, nullptr);
+        ShmHandshakeRequest request;
+        int fds[3];
+        int nfds = 3;
+        ASSERT_EQ(0, nebd::common::RecvWithFds(sock_, &request,
+                                               sizeof(request), fds, &nfds));
+        ASSERT_EQ(3, nfds);
+        ASSERT_EQ(kFileFd, request.fd);
+        ASSERT_EQ(0, ring_.Attach(fds[0], fds[1], fds[2]));
+
+        ShmHandshakeResponse response;
+        response.ret = 0;
+        ASSERT_EQ(sizeof(response),
+                  ::send(sock_, &response, sizeof(response), 0));
+
+        struct pollfd pfd;
+        pfd.fd = ring_.SubmitEventFd();
+        pfd.events = POLLIN;
+        while (!stop_.load()) {
+            if (::poll(&pfd, 1, 10) <= 0) {
+                continue;
+            }
+
+            ring_.ConsumeSubmitEvent();
+            ShmSubmitEntry entry;
+            while (ring_.PopSubmit(&entry)) {
+                {
+                    std::lock_guard<std::mutex> lk(mtx_);
+                    received_.push_back(entry);
+                }
+                if (!autoComplete_) {
+                    continue;
+                }
+                if (entry.op == static_cast<uint32_t>(ShmRingOp::READ)) {
+                    memset(ring_.SlotBuffer(entry.slot), 'r', entry.length);
+                } else {
+                    written.assign(ring_.SlotBuffer(entry.slot),
+                                   entry.length);
+                }
+                ring_.PushComplete({entry.slot, completeRet_});
+                ring_.NotifyComplete();
+            }
+        }
+    }
+
+ private:
+    bool autoComplete_ = true;
+    // ret of completions
+    int32_t completeRet_ = 0;
+    int listenFd_ = -1;
+    int sock_ = -1;
+    ShmRing ring_;
+    std::thread thread_;
+    std::atomic<bool> stop_{false};
+    std::mutex mtx_;
+    std::vector<ShmSubmitEntry> received_;
+};
+
+bool WaitComplete(int expected) {
+    for (int i = 0; i < 1000; ++i) {
+        if (completeCount.load() == expected) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+NebdClientAioContext MakeContext(LIBAIO_OP op, void* buf, size_t length) {
+    NebdClientAioContext ctx;
+    ctx.offset = 0;
+    ctx.length = length;
+    ctx.ret = -1;
+    ctx.op = op;
+    ctx.cb = ShmChannelTestCallback;
+    ctx.buf = buf;
+    ctx.retryCount = 0;
+    return ctx;
+}
+
+TEST(NebdShmChannelTest, ConnectFailTest) {
+    ::unlink(kSockPath);
+    ShmRingOption option;
+    NebdShmChannel channel(kFileFd, [](NebdClientAioContext*) {});
+    ASSERT_EQ(-1, channel.Init(kSockPath, option));
+}
+
+TEST(NebdShmChannelTest, ReadWriteTest) {
+    completeCount.store(0);
+    FakeShmServer server;
+    ASSERT_EQ(0, server.Start(true));
+
+    ShmRingOption option;
+    option.depth = 4;
+    option.slotSize = 8192;
+    std::atomic<int> fallbackCount{0};
+    NebdShmChannel channel(kFileFd, [&](NebdClientAioContext*) {
+        fallbackCount.fetch_add(1);
+    });
+    ASSERT_EQ(0, channel.Init(kSockPath, option));
+
+    // write
+    std::string data(4096, 'w');
+    auto writeCtx = MakeContext(LIBAIO_OP::LIBAIO_OP_WRITE, &data[0], 4096);
+    ASSERT_TRUE(channel.AioWrite(&writeCtx));
+    ASSERT_TRUE(WaitComplete(1));
+    ASSERT_EQ(0, writeCtx.ret);
+    ASSERT_EQ(data, server.written);
+
+    // read
+    std::vector<char> buf(8192, 0);
+    auto readCtx = MakeContext(LIBAIO_OP::LIBAIO_OP_READ, buf.data(), 8192);
+    ASSERT_TRUE(channel.AioRead(&readCtx));
+    ASSERT_TRUE(WaitComplete(2));
+    ASSERT_EQ(0, readCtx.ret);
+    ASSERT_EQ('r', buf[0]);
+    ASSERT_EQ('r', buf[8191]);
+
+    // request larger than a slot goes through rpc
+    std::vector<char> large(16384, 0);
+    auto largeCtx = MakeContext(LIBAIO_OP::LIBAIO_OP_READ, large.data(),
+                                large.size());
+    ASSERT_FALSE(channel.AioRead(&largeCtx));
+
+    channel.Stop();
+    // stopped channel refuses new requests
+    ASSERT_FALSE(channel.AioRead(&readCtx));
+    ASSERT_EQ(0, fallbackCount.load());
+    server.Stop();
+}
+
+TEST(NebdShmChannelTest, ResendByRpcWhenBrokenTest) {
+    completeCount.store(0);
+    FakeShmServer server;
+    ASSERT_EQ(0, server.Start(false));
+
+    ShmRingOption option;
+    option.depth = 2;
+    option.slotSize = 4096;
+    std::atomic<int> fallbackCount{0};
+    NebdShmChannel channel(kFileFd, [&](NebdClientAioContext* ctx) {
+        fallbackCount.fetch_add(1);
+        ctx->ret = 0;
+        ctx->cb(ctx);
+    });
+    ASSERT_EQ(0, channel.Init(kSockPath, option));
+
+    std::vector<char> buf(4096, 0);
+    auto ctx1 = MakeContext(LIBAIO_OP::LIBAIO_OP_READ, buf.data(), 4096);
+    auto ctx2 = MakeContext(LIBAIO_OP::LIBAIO_OP_WRITE, buf.data(), 4096);
+    auto ctx3 = MakeContext(LIBAIO_OP::LIBAIO_OP_WRITE, buf.data(), 4096);
+    ASSERT_TRUE(channel.AioRead(&ctx1));
+    ASSERT_TRUE(channel.AioWrite(&ctx2));
+    // no free slot
+    ASSERT_FALSE(channel.AioWrite(&ctx3));
+
+    for (int i = 0; i < 1000 && server.Received().size() < 2; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(2, server.Received().size());
+
+    // part2 exits, pending requests are resent
+    server.Stop();
+    ASSERT_TRUE(WaitComplete(2));
+    ASSERT_EQ(2, fallbackCount.load());
+    ASSERT_TRUE(channel.IsBroken());
+    ASSERT_FALSE(channel.AioRead(&ctx1));
+
+    channel.Stop();
+}
+
+TEST(NebdShmChannelTest, ResendByRpcWhenStopTimeoutTest) {
+    completeCount.store(0);
+    FakeShmServer server;
+    // part2 is alive but never completes requests
+    ASSERT_EQ(0, server.Start(false));
+
+    ShmRingOption option;
+    option.depth = 2;
+    option.slotSize = 4096;
+    option.stopTimeoutMs = 100;
+    std::atomic<int> fallbackCount{0};
+    NebdShmChannel channel(kFileFd, [&](NebdClientAioContext* ctx) {
+        fallbackCount.fetch_add(1);
+        ctx->ret = 0;
+        ctx->cb(ctx);
+    });
+    ASSERT_EQ(0, channel.Init(kSockPath, option));
+
+    std::vector<char> buf(4096, 0);
+    auto ctx = MakeContext(LIBAIO_OP::LIBAIO_OP_WRITE, buf.data(), 4096);
+    ASSERT_TRUE(channel.AioWrite(&ctx));
+
+    // stop returns after timeout and the request is resent by rpc
+    channel.Stop();
+    ASSERT_TRUE(WaitComplete(1));
+    ASSERT_EQ(1, fallbackCount.load());
+    ASSERT_EQ(0, ctx.ret);
+    ASSERT_TRUE(channel.IsBroken());
+    server.Stop();
+}
+
+TEST(NebdShmChannelTest, ResendByRpcWhenIoErrorTest) {
+    completeCount.store(0);
+    FakeShmServer server;
+    // io failed in part2 and the error is not returned
+    ASSERT_EQ(0, server.Start(true, nebd::common::kShmRetryByRpc));
+
+    ShmRingOption option;
+    option.depth = 2;
+    option.slotSize = 4096;
+    std::atomic<int> fallbackCount{0};
+    NebdShmChannel channel(kFileFd, [&](NebdClientAioContext* ctx) {
+        fallbackCount.fetch_add(1);
+        ctx->ret = 0;
+        ctx->cb(ctx);
+    });
+    ASSERT_EQ(0, channel.Init(kSockPath, option));
+
+    std::vector<char> buf(4096, 0);
+    auto ctx1 = MakeContext(LIBAIO_OP::LIBAIO_OP_READ, buf.data(), 4096);
+    auto ctx2 = MakeContext(LIBAIO_OP::LIBAIO_OP_WRITE, buf.data(), 4096);
+    ASSERT_TRUE(channel.AioRead(&ctx1));
+    ASSERT_TRUE(channel.AioWrite(&ctx2));
+
+    // requests are resent by rpc instead of hanging or failing
+    ASSERT_TRUE(WaitComplete(2));
+    ASSERT_EQ(2, fallbackCount.load());
+    ASSERT_EQ(0, ctx1.ret);
+    ASSERT_EQ(0, ctx2.ret);
+
+    // slots are released, channel is still usable
+    ASSERT_FALSE(channel.IsBroken());
+    ASSERT_TRUE(channel.AioRead(&ctx1));
+    ASSERT_TRUE(WaitComplete(3));
+    ASSERT_EQ(3, fallbackCount.load());
+
+    // nothing in-flight, stop doesn't block
+    channel.Stop();
+    server.Stop();
+}
+
+}  // namespace client
+}  // namespace nebd
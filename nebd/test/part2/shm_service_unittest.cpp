@@ -0,0 +1,227 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: nebd
+ * File Created: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <butil/iobuf.h>
+
+#include <memory>
+#include <string>
+
+#include "nebd/src/part2/shm_service.h"
+#include "nebd/test/part2/mock_file_entity.h"
+#include "nebd/test/part2/mock_file_manager.h"
+
+namespace nebd {
+namespace server {
+
+using ::testing::_;
+using ::testing::Invoke;
+using ::testing::Return;
+
+using nebd::common::ShmCompleteEntry;
+using nebd::common::ShmHandshakeRequest;
+using nebd::common::ShmHandshakeResponse;
+using nebd::common::ShmRingOp;
+using nebd::common::ShmSubmitEntry;
+using nebd::common::kShmRetryByRpc;
+using nebd::common::kShmRingMagic;
+
+const char kSockPath[] = "./nebd-shm-service-test.sock";
+const int kFileFd = 10;
+
+// complete the request with io error
+int FailAio(int fd, NebdServerAioContext* context) {
+    context->ret = -1;
+    context->cb(context);
+    return 0;
+}
+
+// complete the request with success, read returns 'r'
+int SucceedAio(int fd, NebdServerAioContext* context) {
+    if (context->op == LIBAIO_OP::LIBAIO_OP_READ) {
+        butil::IOBuf* buf = reinterpret_cast<butil::IOBuf*>(context->buf);
+        buf->resize(context->size, 'r');
+    }
+    context->ret = 0;
+    context->cb(context);
+    return 0;
+}
+
+class ShmServiceTest : public ::testing::Test {
+ public:
+    void SetUp() {
+        fileManager_ = std::make_shared<MockFileManager>();
+        fileEntity_ = std::make_shared<MockFileEntity>();
+        EXPECT_CALL(*fileManager_, GetFileEntity(kFileFd))
+            .WillRepeatedly(Return(fileEntity_));
+    }
+
+    void TearDown() {
+        if (sock_ >= 0) {
+            ::close(sock_);
+            sock_ = -1;
+        }
+    }
+
+    // act as part1, hand a ring to part2
+    void Connect() {
+        ASSERT_EQ(0, ring_.Create(4, 4096));
+
+        sock_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        ASSERT_GE(sock_, 0);
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, kSockPath, sizeof(addr.sun_path) - 1);
+        ASSERT_EQ(0, ::connect(sock_, reinterpret_cast<sockaddr*>(&addr),
+                               sizeof(addr)));
+
+        ShmHandshakeRequest request;
+        request.magic = kShmRingMagic;
+        request.fd = kFileFd;
+        int fds[3] = {ring_.MemFd(), ring_.SubmitEventFd(),
+                      ring_.CompleteEventFd()};
+        ASSERT_EQ(0, nebd::common::SendWithFds(sock_, &request,
+                                               sizeof(request), fds, 3));
+
+        ShmHandshakeResponse response;
+        ASSERT_EQ(sizeof(response),
+                  ::recv(sock_, &response, sizeof(response), MSG_WAITALL));
+        ASSERT_EQ(0, response.ret);
+    }
+
+    void SubmitAndWait(ShmRingOp op, ShmCompleteEntry* complete) {
+        ShmSubmitEntry entry;
+        entry.slot = 1;
+        entry.op = static_cast<uint32_t>(op);
+        entry.offset = 0;
+        entry.length = 4096;
+        ASSERT_TRUE(ring_.PushSubmit(entry));
+        ring_.NotifySubmit();
+
+        struct pollfd pfd;
+        pfd.fd = ring_.CompleteEventFd();
+        pfd.events = POLLIN;
+        ASSERT_EQ(1, ::poll(&pfd, 1, 3000));
+        ring_.ConsumeCompleteEvent();
+        ASSERT_TRUE(ring_.PopComplete(complete));
+        ASSERT_EQ(1u, complete->slot);
+    }
+
+ protected:
+    std::shared_ptr<MockFileManager> fileManager_;
+    std::shared_ptr<MockFileEntity> fileEntity_;
+    ShmRing ring_;
+    int sock_ = -1;
+};
+
+TEST_F(ShmServiceTest, ReadWriteTest) {
+    NebdShmService service(fileManager_, false, 16);
+    ASSERT_EQ(0, service.Start(kSockPath));
+    Connect();
+
+    EXPECT_CALL(*fileManager_, AioWrite(kFileFd, _))
+        .WillOnce(Invoke(SucceedAio));
+    ShmCompleteEntry complete;
+    SubmitAndWait(ShmRingOp::WRITE, &complete);
+    ASSERT_EQ(0, complete.ret);
+
+    EXPECT_CALL(*fileManager_, AioRead(kFileFd, _))
+        .WillOnce(Invoke(SucceedAio));
+    SubmitAndWait(ShmRingOp::READ, &complete);
+    ASSERT_EQ(0, complete.ret);
+    ASSERT_EQ('r', ring_.SlotBuffer(1)[0]);
+    ASSERT_EQ('r', ring_.SlotBuffer(1)[4095]);
+
+    service.Stop();
+}
+
+TEST_F(ShmServiceTest, IoErrorRetryByRpcTest) {
+    // default option, io error is never returned to part1
+    NebdShmService service(fileManager_, false, 16);
+    ASSERT_EQ(0, service.Start(kSockPath));
+    Connect();
+
+    // the request is not dropped, part1 is told to resend it by rpc
+    EXPECT_CALL(*fileManager_, AioWrite(kFileFd, _))
+        .WillOnce(Invoke(FailAio));
+    ShmCompleteEntry complete;
+    SubmitAndWait(ShmRingOp::WRITE, &complete);
+    ASSERT_EQ(kShmRetryByRpc, complete.ret);
+
+    EXPECT_CALL(*fileManager_, AioRead(kFileFd, _))
+        .WillOnce(Invoke(FailAio));
+    SubmitAndWait(ShmRingOp::READ, &complete);
+    ASSERT_EQ(kShmRetryByRpc, complete.ret);
+
+    service.Stop();
+}
+
+TEST_F(ShmServiceTest, IoErrorReturnTest) {
+    NebdShmService service(fileManager_, true, 16);
+    ASSERT_EQ(0, service.Start(kSockPath));
+    Connect();
+
+    EXPECT_CALL(*fileManager_, AioRead(kFileFd, _))
+        .WillOnce(Invoke(FailAio));
+    ShmCompleteEntry complete;
+    SubmitAndWait(ShmRingOp::READ, &complete);
+    ASSERT_EQ(-1, complete.ret);
+
+    service.Stop();
+}
+
+TEST_F(ShmServiceTest, RefuseConnectionBeyondMaxTest) {
+    NebdShmService service(fileManager_, false, 1);
+    ASSERT_EQ(0, service.Start(kSockPath));
+    Connect();
+
+    // the second ring is refused, part1 sees the connection closed
+    int sock = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(sock, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, kSockPath, sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(0, ::connect(sock, reinterpret_cast<sockaddr*>(&addr),
+                           sizeof(addr)));
+    ShmHandshakeResponse response;
+    ASSERT_EQ(0, ::recv(sock, &response, sizeof(response), MSG_WAITALL));
+    ::close(sock);
+
+    // the first ring still works
+    EXPECT_CALL(*fileManager_, AioWrite(kFileFd, _))
+        .WillOnce(Invoke(SucceedAio));
+    ShmCompleteEntry complete;
+    SubmitAndWait(ShmRingOp::WRITE, &complete);
+    ASSERT_EQ(0, complete.ret);
+
+    service.Stop();
+}
+
+}  // namespace server
+}  // namespace nebd
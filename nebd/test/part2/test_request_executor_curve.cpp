@@ -21,6 +21,7 @@
  */
 
 #include <gtest/gtest.h>
+#include <butil/iobuf.h>
 #include "nebd/src/part2/request_executor_curve.h"
 #include "nebd/test/part2/mock_curve_client.h"
 
@@ -59,6 +60,12 @@ void NebdUnitTestCallback(NebdServerAioContext* context) {
     std::cout << "callback" << std::endl;
 }
 
+int mergeCallbackCount = 0;
+
+void NebdMergeTestCallback(NebdServerAioContext* context) {
+    ++mergeCallbackCount;
+}
+
 class TestReuqestExecutorCurve  : public ::testing::Test {
  protected:
     void SetUp() {
@@ -433,6 +440,127 @@ TEST_F(TestReuqestExecutorCurve, test_Flush) {
     ASSERT_EQ(response.retcode(), nebd::client::RetCode::kOK);
 }
 
+TEST_F(TestReuqestExecutorCurve, test_MergeRequest) {
+    auto executor = CurveRequestExecutor::GetInstance();
+    RequestMergeOption option;
+    option.enable = true;
+    // 保证测试过程中合并窗口不会超时
+    option.windowUs = 10 * 1000 * 1000;
+    option.maxRequests = 2;
+    auto curveFileIns = new CurveFileInstance();
+    curveFileIns->fd = 1;
+    curveFileIns->fileName = "/cinder/volume-1234_cinder_";
+    curveFileIns->merger =
+        std::make_shared<RequestMerger>(1, curveClient_, option);
+
+    auto initCtx = [](NebdServerAioContext* ctx, LIBAIO_OP op,
+                      off_t offset, size_t size) {
+        ctx->op = op;
+        ctx->offset = offset;
+        ctx->size = size;
+        ctx->ret = -1;
+        ctx->cb = NebdMergeTestCallback;
+        ctx->buf = new butil::IOBuf();
+    };
+
+    // 1. 连续的写请求合并为一个请求
+    {
+        mergeCallbackCount = 0;
+        NebdServerAioContext ctx1, ctx2;
+        initCtx(&ctx1, LIBAIO_OP::LIBAIO_OP_WRITE, 0, 4096);
+        initCtx(&ctx2, LIBAIO_OP::LIBAIO_OP_WRITE, 4096, 4096);
+        static_cast<butil::IOBuf*>(ctx1.buf)->resize(4096, 'a');
+        static_cast<butil::IOBuf*>(ctx2.buf)->resize(4096, 'b');
+
+        CurveAioContext* curveCtx = nullptr;
+        EXPECT_CALL(*curveClient_, AioWrite(1, _, _))
+            .WillOnce(DoAll(SaveArg<1>(&curveCtx),
+                            Return(LIBCURVE_ERROR::OK)));
+        ASSERT_EQ(0, executor.AioWrite(curveFileIns, &ctx1));
+        ASSERT_EQ(0, executor.AioWrite(curveFileIns, &ctx2));
+        ASSERT_NE(nullptr, curveCtx);
+        ASSERT_EQ(0, curveCtx->offset);
+        ASSERT_EQ(8192, curveCtx->length);
+        auto data = static_cast<butil::IOBuf*>(curveCtx->buf);
+        ASSERT_EQ(std::string(4096, 'a') + std::string(4096, 'b'),
+                  data->to_string());
+
+        curveCtx->ret = curveCtx->length;
+        curveCtx->cb(curveCtx);
+        ASSERT_EQ(2, mergeCallbackCount);
+        ASSERT_EQ(4096, ctx1.ret);
+        ASSERT_EQ(4096, ctx2.ret);
+        delete static_cast<butil::IOBuf*>(ctx1.buf);
+        delete static_cast<butil::IOBuf*>(ctx2.buf);
+    }
+
+    // 2. 连续的读请求合并, 读取的数据拆分给每个请求
+    {
+        mergeCallbackCount = 0;
+        NebdServerAioContext ctx1, ctx2;
+        initCtx(&ctx1, LIBAIO_OP::LIBAIO_OP_READ, 8192, 512);
+        initCtx(&ctx2, LIBAIO_OP::LIBAIO_OP_READ, 8704, 1024);
+
+        CurveAioContext* curveCtx = nullptr;
+        EXPECT_CALL(*curveClient_, AioRead(1, _, _))
+            .WillOnce(DoAll(SaveArg<1>(&curveCtx),
+                            Return(LIBCURVE_ERROR::OK)));
+        ASSERT_EQ(0, executor.AioRead(curveFileIns, &ctx1));
+        ASSERT_EQ(0, executor.AioRead(curveFileIns, &ctx2));
+        ASSERT_NE(nullptr, curveCtx);
+        ASSERT_EQ(8192, curveCtx->offset);
+        ASSERT_EQ(1536, curveCtx->length);
+
+        auto data = static_cast<butil::IOBuf*>(curveCtx->buf);
+        data->resize(512, 'c');
+        data->resize(1536, 'd');
+        curveCtx->ret = curveCtx->length;
+        curveCtx->cb(curveCtx);
+        ASSERT_EQ(2, mergeCallbackCount);
+        ASSERT_EQ(512, ctx1.ret);
+        ASSERT_EQ(1024, ctx2.ret);
+        ASSERT_EQ(std::string(512, 'c'),
+                  static_cast<butil::IOBuf*>(ctx1.buf)->to_string());
+        ASSERT_EQ(std::string(1024, 'd'),
+                  static_cast<butil::IOBuf*>(ctx2.buf)->to_string());
+        delete static_cast<butil::IOBuf*>(ctx1.buf);
+        delete static_cast<butil::IOBuf*>(ctx2.buf);
+    }
+
+    // 3. 不连续的请求分别下发, 合并失败时每个请求都返回错误
+    {
+        mergeCallbackCount = 0;
+        NebdServerAioContext ctx1, ctx2;
+        initCtx(&ctx1, LIBAIO_OP::LIBAIO_OP_WRITE, 0, 4096);
+        initCtx(&ctx2, LIBAIO_OP::LIBAIO_OP_WRITE, 8192, 4096);
+
+        CurveAioContext* curveCtx1 = nullptr;
+        EXPECT_CALL(*curveClient_, AioWrite(1, _, _))
+            .WillOnce(DoAll(SaveArg<1>(&curveCtx1),
+                            Return(LIBCURVE_ERROR::OK)))
+            .WillOnce(Return(LIBCURVE_ERROR::FAILED));
+        ASSERT_EQ(0, executor.AioWrite(curveFileIns, &ctx1));
+        ASSERT_EQ(nullptr, curveCtx1);
+        ASSERT_EQ(0, executor.AioWrite(curveFileIns, &ctx2));
+        ASSERT_NE(nullptr, curveCtx1);
+        ASSERT_EQ(0, curveCtx1->offset);
+        ASSERT_EQ(4096, curveCtx1->length);
+        curveCtx1->ret = curveCtx1->length;
+        curveCtx1->cb(curveCtx1);
+        ASSERT_EQ(1, mergeCallbackCount);
+        ASSERT_EQ(4096, ctx1.ret);
+
+        // close时下发合并窗口中剩余的请求
+        EXPECT_CALL(*curveClient_, Close(1))
+            .WillOnce(Return(LIBCURVE_ERROR::OK));
+        ASSERT_EQ(0, executor.Close(curveFileIns));
+        ASSERT_EQ(2, mergeCallbackCount);
+        ASSERT_EQ(-1, ctx2.ret);
+        delete static_cast<butil::IOBuf*>(ctx1.buf);
+        delete static_cast<butil::IOBuf*>(ctx2.buf);
+    }
+}
+
 TEST_F(TestReuqestExecutorCurve, test_InvalidCache) {
     auto executor = CurveRequestExecutor::GetInstance();
     std::string curveFilename("/cinder/volume-1234_cinder_");
@@ -57,6 +57,11 @@ void ScanChunkClosure::Run() {
     std::unique_ptr<ChunkRequest> requestGuard(request_);
     std::unique_ptr<ChunkResponse> responseGuard(response_);
 
+    if (nullptr != qosScheduler_) {
+        qosScheduler_->OnComplete(IOClass::SCAN,
+            common::TimeUtility::GetTimeofDayUs() - startTimeUs_);
+    }
+
     switch (response_->status()) {
         case CHUNK_OP_STATUS_CHUNK_NOTEXIST:
             LOG(WARNING) << "scan chunk failed, read chunk not exist. "
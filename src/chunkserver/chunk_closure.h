@@ -27,6 +27,8 @@
 #include <memory>
 
 #include "src/chunkserver/op_request.h"
+#include "src/chunkserver/qos_scheduler.h"
+#include "src/common/timeutility.h"
 #include "proto/chunk.pb.h"
 
 namespace curve {
@@ -56,15 +58,26 @@ class ChunkClosure : public braft::Closure {
 class ScanChunkClosure : public google::protobuf::Closure {
  public:
     ScanChunkClosure(ChunkRequest *request, ChunkResponse *response) :
-                     request_(request), response_(response) {}
+                     request_(request), response_(response),
+                     qosScheduler_(nullptr),
+                     startTimeUs_(common::TimeUtility::GetTimeofDayUs()) {}
 
     ~ScanChunkClosure() = default;
 
     void Run() override;
 
+    /**
+     * 请求交给QoS调度器下发，请求完成时通知调度器
+     */
+    void SetQosScheduler(QosScheduler *scheduler) {
+        qosScheduler_ = scheduler;
+    }
+
  public:
     ChunkRequest *request_;
     ChunkResponse *response_;
+    QosScheduler *qosScheduler_;
+    uint64_t startTimeUs_;
 };
 
 class SendScanMapClosure : public google::protobuf::Closure {
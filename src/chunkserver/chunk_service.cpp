@@ -35,6 +35,8 @@
 #include "src/chunkserver/chunkserver_metrics.h"
 #include "src/chunkserver/op_request.h"
 #include "src/chunkserver/chunk_service_closure.h"
+#include "src/chunkserver/qos_scheduler.h"
+#include "src/chunkserver/hot_chunk_tracker.h"
 
 #include "src/common/fast_align.h"
 
@@ -155,7 +157,7 @@ void ChunkServiceImpl::WriteChunk(RpcController *controller,
                                                   request,
                                                   response,
                                                   doneGuard.release());
-    req->Process();
+    ProcessRequest(closure, IOClass::CLIENT, request, req);
 }
 
 void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
@@ -204,7 +206,7 @@ void ChunkServiceImpl::CreateCloneChunk(RpcController *controller,
                                                         request,
                                                         response,
                                                         doneGuard.release());
-    req->Process();
+    ProcessRequest(closure, IOClass::CLONE, request, req);
 }
 
 void ChunkServiceImpl::CreateS3CloneChunk(RpcController* controller,
@@ -265,7 +267,7 @@ void ChunkServiceImpl::ReadChunk(RpcController *controller,
                                            request,
                                            response,
                                            doneGuard.release());
-    req->Process();
+    ProcessRequest(closure, IOClass::CLIENT, request, req);
 }
 
 void ChunkServiceImpl::RecoverChunk(RpcController *controller,
@@ -317,7 +319,7 @@ void ChunkServiceImpl::RecoverChunk(RpcController *controller,
                                            request,
                                            response,
                                            doneGuard.release());
-    req->Process();
+    ProcessRequest(closure, IOClass::CLONE, request, req);
 }
 
 void ChunkServiceImpl::ReadChunkSnapshot(RpcController *controller,
@@ -363,7 +365,7 @@ void ChunkServiceImpl::ReadChunkSnapshot(RpcController *controller,
                                                     request,
                                                     response,
                                                     doneGuard.release());
-    req->Process();
+    ProcessRequest(closure, IOClass::CLIENT, request, req);
 }
 
 void ChunkServiceImpl::DeleteChunkSnapshotOrCorrectSn(
@@ -568,6 +570,64 @@ void ChunkServiceImpl::UpdateEpoch(RpcController *controller,
     }
 }
 
+void ChunkServiceImpl::DeleteChunks(RpcController *controller,
+                                    const DeleteChunksRequest *request,
+                                    DeleteChunksResponse *response,
+                                    Closure *done) {
+    const int count = request->requests_size();
+    for (int i = 0; i < count; ++i) {
+        response->add_responses();
+    }
+
+    // 每个子请求各自走DeleteChunk的流程提交给raft，全部返回之后才回复rpc，
+    // 多出的一个计数在所有子请求都提交之后释放
+    BatchChunkServiceClosure* batchDone =
+        new (std::nothrow) BatchChunkServiceClosure(count + 1, done);
+    CHECK(nullptr != batchDone) << "new batch chunk service closure failed";
+    brpc::ClosureGuard doneGuard(batchDone);
+
+    for (int i = 0; i < count; ++i) {
+        const ChunkRequest& req = request->requests(i);
+        ChunkResponse* resp = response->mutable_responses(i);
+        if (req.optype() != CHUNK_OP_TYPE::CHUNK_OP_DELETE) {
+            resp->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST);
+            LOG(WARNING) << "delete chunks failed, invalid op type: "
+                         << req.ShortDebugString();
+            batchDone->Run();
+            continue;
+        }
+
+        DeleteChunk(controller, &req, resp, batchDone);
+    }
+}
+
+void ChunkServiceImpl::ProcessRequest(ChunkServiceClosure *closure,
+                                      IOClass cls,
+                                      const ChunkRequest *request,
+                                      std::shared_ptr<ChunkOpRequest> req) {
+    HotChunkTracker *tracker = chunkServiceOptions_.hotChunkTracker;
+    if (nullptr != tracker && cls == IOClass::CLIENT) {
+        tracker->Record(request->fileid(), request->logicpoolid(),
+                        request->copysetid(), request->chunkid(),
+                        request->optype() != CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    }
+
+    QosScheduler *scheduler = chunkServiceOptions_.qosScheduler;
+    if (nullptr == scheduler || !scheduler->Enabled()) {
+        req->Process();
+        return;
+    }
+
+    scheduler->Submit(cls, request->fileid(), request->size(),
+                      [req, closure, scheduler, cls](bool scheduled) {
+        // 只有调度器计入的请求完成时需要通知调度器
+        if (scheduled) {
+            closure->SetQosScheduler(scheduler, cls);
+        }
+        req->Process();
+    });
+}
+
 bool ChunkServiceImpl::CheckRequestOffsetAndLength(uint32_t offset,
                                                    uint32_t len) {
     // 检查offset+len是否越界
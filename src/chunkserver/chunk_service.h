@@ -38,6 +38,9 @@ using ::google::protobuf::RpcController;
 using ::google::protobuf::Closure;
 
 class CopysetNodeManager;
+class ChunkServiceClosure;
+class ChunkOpRequest;
+enum class IOClass;
 
 class ChunkServiceImpl : public ChunkService {
  public:
@@ -98,6 +101,11 @@ class ChunkServiceImpl : public ChunkService {
                     UpdateEpochResponse *response,
                     Closure *done);
 
+    void DeleteChunks(RpcController *controller,
+                      const DeleteChunksRequest *request,
+                      DeleteChunksResponse *response,
+                      Closure *done);
+
  private:
     /**
      * 验证op request的offset和length是否越界和对齐
@@ -107,6 +115,18 @@ class ChunkServiceImpl : public ChunkService {
      */
     bool CheckRequestOffsetAndLength(uint32_t offset, uint32_t len);
 
+    /**
+     * 下发请求，配置了QoS调度器时由调度器决定下发的时机
+     * @param closure[in]: 请求的闭包，请求完成时通知调度器
+     * @param cls[in]: 请求的流量类型
+     * @param request[in]: rpc请求
+     * @param req[in]: 待下发的op request
+     */
+    void ProcessRequest(ChunkServiceClosure *closure,
+                        IOClass cls,
+                        const ChunkRequest *request,
+                        std::shared_ptr<ChunkOpRequest> req);
+
  private:
     ChunkServiceOptions chunkServiceOptions_;
     CopysetNodeManager  *copysetNodeManager_;
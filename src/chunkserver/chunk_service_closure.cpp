@@ -42,6 +42,11 @@ void ChunkServiceClosure::Run() {
         OnResonse();
     }
 
+    if (nullptr != qosScheduler_) {
+        qosScheduler_->OnComplete(qosClass_,
+            common::TimeUtility::GetTimeofDayUs() - receivedTimeUs_);
+    }
+
     // closure调用的时候减1，closure创建的什么加1
     // 这一行必须放在brpcDone_调用之后，ut里需要测试inflightio超过限制时的表现
     // 会在传进来的closure里面加一个sleep来控制inflightio个数
@@ -50,6 +55,15 @@ void ChunkServiceClosure::Run() {
     }
 }
 
+void BatchChunkServiceClosure::Run() {
+    if (count_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+
+    std::unique_ptr<BatchChunkServiceClosure> selfGuard(this);
+    brpc::ClosureGuard doneGuard(brpcDone_);
+}
+
 void ChunkServiceClosure::OnRequest() {
     // 如果request或者response为空就不统计metric
     if (request_ == nullptr || response_ == nullptr)
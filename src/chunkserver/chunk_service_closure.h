@@ -24,11 +24,13 @@
 #define SRC_CHUNKSERVER_CHUNK_SERVICE_CLOSURE_H_
 
 #include <brpc/closure_guard.h>
+#include <atomic>
 #include <memory>
 
 #include "proto/chunk.pb.h"
 #include "src/chunkserver/op_request.h"
 #include "src/chunkserver/inflight_throttle.h"
+#include "src/chunkserver/qos_scheduler.h"
 #include "src/common/timeutility.h"
 
 namespace curve {
@@ -46,7 +48,9 @@ class ChunkServiceClosure : public braft::Closure {
         , request_(request)
         , response_(response)
         , brpcDone_(done)
-        , receivedTimeUs_(common::TimeUtility::GetTimeofDayUs()) {
+        , receivedTimeUs_(common::TimeUtility::GetTimeofDayUs())
+        , qosScheduler_(nullptr)
+        , qosClass_(IOClass::CLIENT) {
             // closure创建的什么加1，closure调用的时候减1
             if (nullptr != inflightThrottle_) {
                 inflightThrottle_->Increment();
@@ -64,6 +68,16 @@ class ChunkServiceClosure : public braft::Closure {
      */
     void Run() override;
 
+    /**
+     * 请求交给QoS调度器下发，请求完成时通知调度器
+     * @param scheduler: QoS调度器
+     * @param cls: 请求的流量类型
+     */
+    void SetQosScheduler(QosScheduler* scheduler, IOClass cls) {
+        qosScheduler_ = scheduler;
+        qosClass_ = cls;
+    }
+
  private:
     /**
      * 统计请求数量和速率
@@ -85,6 +99,30 @@ class ChunkServiceClosure : public braft::Closure {
     google::protobuf::Closure *brpcDone_;
     // 接受到请求的时间
     uint64_t receivedTimeUs_;
+    // 下发请求的QoS调度器，为空表示请求没有经过调度器
+    QosScheduler* qosScheduler_;
+    IOClass qosClass_;
+};
+
+/**
+ * 批量请求的闭包，每个子请求返回时调用一次Run，
+ * 所有子请求都返回之后才调用rpc的闭包
+ */
+class BatchChunkServiceClosure : public google::protobuf::Closure {
+ public:
+    BatchChunkServiceClosure(int count, google::protobuf::Closure *done)
+        : count_(count)
+        , brpcDone_(done) {}
+
+    ~BatchChunkServiceClosure() = default;
+
+    void Run() override;
+
+ private:
+    // 还未返回的子请求数量
+    std::atomic<int> count_;
+    // rpc请求回调
+    google::protobuf::Closure *brpcDone_;
 };
 
 }  // namespace chunkserver
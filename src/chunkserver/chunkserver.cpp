@@ -52,6 +52,15 @@ using ::curve::fs::FileSystemType;
 using ::curve::chunkserver::concurrent::ConcurrentApplyModule;
 using ::curve::common::UriParser;
 
+namespace braft {
+DECLARE_bool(raft_enable_leader_lease);
+DECLARE_int32(raft_max_parallel_append_entries_rpc_num);
+DECLARE_bool(raft_enable_append_entries_cache);
+DECLARE_int32(raft_max_append_entries_cache_size);
+DECLARE_int32(raft_max_entries_size);
+DECLARE_int32(raft_max_body_size);
+}  // namespace braft
+
 DEFINE_string(conf, "ChunkServer.conf", "Path of configuration file");
 DEFINE_string(chunkServerIp, "127.0.0.1", "chunkserver ip");
 DEFINE_bool(enableExternalServer, false, "start external server or not");
@@ -115,6 +124,8 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG_IF(FATAL, !common::is_aligned(FLAGS_minIoAlignment, 512))
         << "minIoAlignment should align to 512";
 
+    InitRaftFlags(&conf);
+
     // 优先初始化 metric 收集模块
     ChunkServerMetricOptions metricOptions;
     InitMetricOptions(&conf, &metricOptions);
@@ -284,13 +295,36 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG_IF(FATAL, copysetNodeManager_->Init(copysetNodeOptions) != 0)
         << "Failed to initialize CopysetNodeManager.";
 
+    // init qos scheduler
+    QosSchedulerOptions qosOpts;
+    InitQosSchedulerOptions(&conf, &qosOpts);
+    LOG_IF(FATAL, qosScheduler_.Init(qosOpts) != 0)
+        << "Failed to init qos scheduler.";
+
     // init scan model
     ScanManagerOptions scanOpts;
     InitScanOptions(&conf, &scanOpts);
     scanOpts.copysetNodeManager = copysetNodeManager_;
+    scanOpts.qosScheduler = &qosScheduler_;
     LOG_IF(FATAL, scanManager_.Init(scanOpts) != 0)
         << "Failed to init scan manager.";
 
+    // init flatten manager
+    FlattenManagerOptions flattenOpts;
+    InitFlattenManagerOptions(&conf, &flattenOpts);
+    flattenOpts.sliceSize = sliceSize;
+    flattenOpts.copysetNodeManager = copysetNodeManager_;
+    flattenOpts.cloneManager = &cloneManager_;
+    flattenOpts.qosScheduler = &qosScheduler_;
+    LOG_IF(FATAL, flattenManager_.Init(flattenOpts) != 0)
+        << "Failed to init flatten manager.";
+
+    // init hot chunk tracker
+    HotChunkTrackerOptions hotChunkOpts;
+    InitHotChunkTrackerOptions(&conf, &hotChunkOpts);
+    LOG_IF(FATAL, hotChunkTracker_.Init(hotChunkOpts) != 0)
+        << "Failed to init hot chunk tracker.";
+
     // 心跳模块初始化
     HeartbeatOptions heartbeatOptions;
     InitHeartbeatOptions(&conf, &heartbeatOptions);
@@ -300,6 +334,9 @@ int ChunkServer::Run(int argc, char** argv) {
     heartbeatOptions.chunkserverId = metadata.id();
     heartbeatOptions.chunkserverToken = metadata.token();
     heartbeatOptions.scanManager = &scanManager_;
+    heartbeatOptions.qosScheduler = &qosScheduler_;
+    heartbeatOptions.flattenManager = &flattenManager_;
+    heartbeatOptions.hotChunkTracker = &hotChunkTracker_;
     LOG_IF(FATAL, heartbeat_.Init(heartbeatOptions) != 0)
         << "Failed to init Heartbeat manager.";
 
@@ -338,6 +375,8 @@ int ChunkServer::Run(int argc, char** argv) {
     chunkServiceOptions.copysetNodeManager = copysetNodeManager_;
     chunkServiceOptions.cloneManager = &cloneManager_;
     chunkServiceOptions.inflightThrottle = inflightThrottle;
+    chunkServiceOptions.qosScheduler = &qosScheduler_;
+    chunkServiceOptions.hotChunkTracker = &hotChunkTracker_;
 
     ChunkServiceImpl chunkService(chunkServiceOptions, epochMap);
     ret = server.AddService(&chunkService,
@@ -364,6 +403,8 @@ int ChunkServer::Run(int argc, char** argv) {
     ret = server.RemoveService(service);
     CHECK(0 == ret) << "Fail to remove braft::FileService";
     kCurveFileService.set_snapshot_attachment(new CurveSnapshotAttachment(fs));
+    QosSnapshotReadHook qosReadHook(&qosScheduler_);
+    kCurveFileService.set_read_hook(&qosReadHook);
     ret = server.AddService(&kCurveFileService,
         brpc::SERVER_DOESNT_OWN_SERVICE);
     CHECK(0 == ret) << "Fail to add CurveFileService";
@@ -422,6 +463,8 @@ int ChunkServer::Run(int argc, char** argv) {
      * 将模块启动放到rpc 服务启动后面，主要是为了解决内存增长的问题
      * 控制并发恢复的copyset数量，copyset恢复需要依赖rpc服务先启动
      */
+    LOG_IF(FATAL, qosScheduler_.Run() != 0)
+        << "Failed to start qos scheduler.";
     LOG_IF(FATAL, trash_->Run() != 0)
         << "Failed to start trash.";
     LOG_IF(FATAL, cloneManager_.Run() != 0)
@@ -432,6 +475,8 @@ int ChunkServer::Run(int argc, char** argv) {
         << "Failed to start CopysetNodeManager.";
     LOG_IF(FATAL, scanManager_.Run() != 0)
         << "Failed to start scan manager.";
+    LOG_IF(FATAL, flattenManager_.Run() != 0)
+        << "Failed to start flatten manager.";
     LOG_IF(FATAL, !chunkfilePool->StartCleaning())
         << "Failed to start file pool clean worker.";
 
@@ -443,6 +488,8 @@ int ChunkServer::Run(int argc, char** argv) {
     LOG(INFO) << "ChunkServer is going to quit.";
     LOG_IF(ERROR, scanManager_.Fini() != 0)
         << "Failed to shutdown scan manager.";
+    LOG_IF(ERROR, flattenManager_.Fini() != 0)
+        << "Failed to shutdown flatten manager.";
 
     if (registerOptions.enableExternalServer) {
         externalServer.Stop(0);
@@ -451,9 +498,12 @@ int ChunkServer::Run(int argc, char** argv) {
 
     server.Stop(0);
     server.Join();
+    kCurveFileService.set_read_hook(nullptr);
 
     LOG_IF(ERROR, heartbeat_.Fini() != 0)
         << "Failed to shutdown heartbeat manager.";
+    LOG_IF(ERROR, qosScheduler_.Fini() != 0)
+        << "Failed to shutdown qos scheduler.";
     LOG_IF(ERROR, copysetNodeManager_->Fini() != 0)
         << "Failed to shutdown CopysetNodeManager.";
     LOG_IF(ERROR, cloneManager_.Fini() != 0)
@@ -558,6 +608,51 @@ void ChunkServer::InitWalFilePoolOptions(
     }
 }
 
+void ChunkServer::InitRaftFlags(common::Configuration *conf) {
+    // 开启leader lease之后，lease有效期间的读请求直接读本地数据
+    bool enableLeaseRead = false;
+    LOG_IF(WARNING, !conf->GetBoolValue("copyset.enable_lease_read",
+                                        &enableLeaseRead))
+        << "config no copyset.enable_lease_read info, "
+        << "using default value " << enableLeaseRead;
+    braft::FLAGS_raft_enable_leader_lease = enableLeaseRead;
+
+    // 复制相关的参数，没有配置时使用braft的默认值
+    LOG_IF(WARNING, !conf->GetIntValue(
+        "copyset.max_parallel_append_entries_rpc_num",
+        &braft::FLAGS_raft_max_parallel_append_entries_rpc_num))
+        << "config no copyset.max_parallel_append_entries_rpc_num info, "
+        << "using default value "
+        << braft::FLAGS_raft_max_parallel_append_entries_rpc_num;
+    LOG_IF(WARNING, !conf->GetBoolValue(
+        "copyset.enable_append_entries_cache",
+        &braft::FLAGS_raft_enable_append_entries_cache))
+        << "config no copyset.enable_append_entries_cache info, "
+        << "using default value "
+        << braft::FLAGS_raft_enable_append_entries_cache;
+    LOG_IF(WARNING, !conf->GetIntValue(
+        "copyset.max_append_entries_cache_size",
+        &braft::FLAGS_raft_max_append_entries_cache_size))
+        << "config no copyset.max_append_entries_cache_size info, "
+        << "using default value "
+        << braft::FLAGS_raft_max_append_entries_cache_size;
+    LOG_IF(WARNING, !conf->GetIntValue("copyset.max_entries_size",
+        &braft::FLAGS_raft_max_entries_size))
+        << "config no copyset.max_entries_size info, "
+        << "using default value " << braft::FLAGS_raft_max_entries_size;
+    LOG_IF(WARNING, !conf->GetIntValue("copyset.max_body_size",
+        &braft::FLAGS_raft_max_body_size))
+        << "config no copyset.max_body_size info, "
+        << "using default value " << braft::FLAGS_raft_max_body_size;
+    // pipeline复制时AppendEntries可能乱序到达follower，需要缓存
+    if (braft::FLAGS_raft_max_parallel_append_entries_rpc_num > 1 &&
+        !braft::FLAGS_raft_enable_append_entries_cache) {
+        LOG(WARNING) << "copyset.enable_append_entries_cache should be "
+                     << "enabled when max_parallel_append_entries_rpc_num "
+                     << "is greater than 1";
+    }
+}
+
 void ChunkServer::InitCopysetNodeOptions(
     common::Configuration *conf, CopysetNodeOptions *copysetNodeOptions) {
     LOG_IF(FATAL, !conf->GetStringValue("global.ip", &copysetNodeOptions->ip));
@@ -592,6 +687,10 @@ void ChunkServer::InitCopysetNodeOptions(
         &copysetNodeOptions->pageSize));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.load_concurrency",
         &copysetNodeOptions->loadConcurrency));
+    LOG_IF(WARNING, !conf->GetUInt32Value("copyset.load_chunk_concurrency",
+        &copysetNodeOptions->loadChunkConcurrency))
+        << "config no copyset.load_chunk_concurrency info, "
+        << "using default value " << copysetNodeOptions->loadChunkConcurrency;
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.check_retrytimes",
         &copysetNodeOptions->checkRetryTimes));
     LOG_IF(FATAL, !conf->GetUInt32Value("copyset.finishload_margin",
@@ -634,6 +733,20 @@ void ChunkServer::InitCopyerOptions(
         &disableS3Adapter));
     LOG_IF(FATAL, !conf->GetUInt64Value("curve.curve_file_timeout_s",
         &copyerOptions->curveFileTimeoutSec));
+    LOG_IF(FATAL, !conf->GetUInt32Value("global.chunk_size",
+        &copyerOptions->chunkSize));
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.prefetch_block_size",
+        &copyerOptions->prefetchBlockSize))
+        << "config no clone.prefetch_block_size info, using default value "
+        << copyerOptions->prefetchBlockSize;
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.prefetch_max_blocks",
+        &copyerOptions->prefetchMaxBlocks))
+        << "config no clone.prefetch_max_blocks info, using default value "
+        << copyerOptions->prefetchMaxBlocks;
+    LOG_IF(WARNING, !conf->GetUInt64Value("clone.cache_capacity",
+        &copyerOptions->cacheCapacity))
+        << "config no clone.cache_capacity info, using default value "
+        << copyerOptions->cacheCapacity;
 
     if (disableCurveClient) {
         copyerOptions->curveClient = nullptr;
@@ -672,6 +785,71 @@ void ChunkServer::InitScanOptions(
         &scanOptions->retryIntervalUs));
 }
 
+void ChunkServer::InitQosSchedulerOptions(
+    common::Configuration *conf, QosSchedulerOptions *qosOptions) {
+    LOG_IF(WARNING, !conf->GetBoolValue("chunkserver.qos.enable",
+        &qosOptions->enable))
+        << "config no chunkserver.qos.enable info, using default value "
+        << qosOptions->enable;
+    LOG_IF(WARNING, !conf->GetUInt32Value("chunkserver.qos.max_outstanding",
+        &qosOptions->maxOutstanding))
+        << "config no chunkserver.qos.max_outstanding info, "
+        << "using default value " << qosOptions->maxOutstanding;
+    LOG_IF(WARNING, !conf->GetUInt32Value("chunkserver.qos.cost_unit_bytes",
+        &qosOptions->costUnitBytes))
+        << "config no chunkserver.qos.cost_unit_bytes info, "
+        << "using default value " << qosOptions->costUnitBytes;
+}
+
+void ChunkServer::InitFlattenManagerOptions(
+    common::Configuration *conf, FlattenManagerOptions *flattenOptions) {
+    LOG_IF(WARNING, !conf->GetBoolValue("clone.flatten_enable",
+        &flattenOptions->enable))
+        << "config no clone.flatten_enable info, using default value "
+        << flattenOptions->enable;
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.flatten_interval_sec",
+        &flattenOptions->intervalSec))
+        << "config no clone.flatten_interval_sec info, using default value "
+        << flattenOptions->intervalSec;
+    LOG_IF(WARNING, !conf->GetUInt64Value("clone.flatten_bandwidth_bytes",
+        &flattenOptions->bandwidthBytes))
+        << "config no clone.flatten_bandwidth_bytes info, "
+        << "using default value " << flattenOptions->bandwidthBytes;
+    LOG_IF(WARNING, !conf->GetUInt64Value("clone.flatten_idle_iops",
+        &flattenOptions->idleIops))
+        << "config no clone.flatten_idle_iops info, using default value "
+        << flattenOptions->idleIops;
+    LOG_IF(WARNING, !conf->GetUInt32Value("clone.flatten_timeout_ms",
+        &flattenOptions->requestTimeoutMs))
+        << "config no clone.flatten_timeout_ms info, using default value "
+        << flattenOptions->requestTimeoutMs;
+}
+
+void ChunkServer::InitHotChunkTrackerOptions(
+    common::Configuration *conf, HotChunkTrackerOptions *hotChunkOptions) {
+    LOG_IF(WARNING, !conf->GetBoolValue("chunkserver.hotchunk.enable",
+        &hotChunkOptions->enable))
+        << "config no chunkserver.hotchunk.enable info, "
+        << "using default value " << hotChunkOptions->enable;
+    LOG_IF(WARNING, !conf->GetUInt32Value("chunkserver.hotchunk.sketch_width",
+        &hotChunkOptions->sketchWidth))
+        << "config no chunkserver.hotchunk.sketch_width info, "
+        << "using default value " << hotChunkOptions->sketchWidth;
+    LOG_IF(WARNING, !conf->GetUInt32Value("chunkserver.hotchunk.sketch_depth",
+        &hotChunkOptions->sketchDepth))
+        << "config no chunkserver.hotchunk.sketch_depth info, "
+        << "using default value " << hotChunkOptions->sketchDepth;
+    LOG_IF(WARNING, !conf->GetUInt32Value("chunkserver.hotchunk.top_k",
+        &hotChunkOptions->topK))
+        << "config no chunkserver.hotchunk.top_k info, "
+        << "using default value " << hotChunkOptions->topK;
+    LOG_IF(WARNING, !conf->GetUInt32Value(
+        "chunkserver.hotchunk.decay_interval_sec",
+        &hotChunkOptions->decayIntervalSec))
+        << "config no chunkserver.hotchunk.decay_interval_sec info, "
+        << "using default value " << hotChunkOptions->decayIntervalSec;
+}
+
 void ChunkServer::InitHeartbeatOptions(
     common::Configuration *conf, HeartbeatOptions *heartbeatOptions) {
     LOG_IF(FATAL, !conf->GetStringValue("chunkserver.stor_uri",
@@ -685,6 +863,14 @@ void ChunkServer::InitHeartbeatOptions(
         &heartbeatOptions->intervalSec));
     LOG_IF(FATAL, !conf->GetUInt32Value("mds.heartbeat_timeout",
         &heartbeatOptions->timeout));
+    LOG_IF(WARNING, !conf->GetBoolValue("mds.heartbeat_delta_enable",
+        &heartbeatOptions->enableDeltaHeartbeat))
+        << "config no mds.heartbeat_delta_enable info, using default value "
+        << heartbeatOptions->enableDeltaHeartbeat;
+    LOG_IF(WARNING, !conf->GetUInt32Value("mds.heartbeat_full_interval",
+        &heartbeatOptions->fullHeartbeatInterval))
+        << "config no mds.heartbeat_full_interval info, using default value "
+        << heartbeatOptions->fullHeartbeatInterval;
 }
 
 void ChunkServer::InitRegisterOptions(
@@ -719,6 +905,14 @@ void ChunkServer::InitTrashOptions(
         "trash.expire_afterSec", &trashOptions->expiredAfterSec));
     LOG_IF(FATAL, !conf->GetIntValue(
         "trash.scan_periodSec", &trashOptions->scanPeriodSec));
+    LOG_IF(WARNING, !conf->GetUInt32Value("trash.recycle_batch_size",
+        &trashOptions->recycleBatchSize))
+        << "config no trash.recycle_batch_size info, using default value "
+        << trashOptions->recycleBatchSize;
+    LOG_IF(WARNING, !conf->GetUInt32Value("trash.recycle_files_per_sec",
+        &trashOptions->recycleFilesPerSec))
+        << "config no trash.recycle_files_per_sec info, using default value "
+        << trashOptions->recycleFilesPerSec;
 }
 
 void ChunkServer::InitMetricOptions(
@@ -29,6 +29,9 @@
 #include "src/chunkserver/copyset_node_manager.h"
 #include "src/chunkserver/heartbeat.h"
 #include "src/chunkserver/scan_manager.h"
+#include "src/chunkserver/qos_scheduler.h"
+#include "src/chunkserver/flatten_manager.h"
+#include "src/chunkserver/hot_chunk_tracker.h"
 #include "src/chunkserver/clone_manager.h"
 #include "src/chunkserver/register.h"
 #include "src/chunkserver/trash.h"
@@ -67,6 +70,8 @@ class ChunkServer {
     void InitConcurrentApplyOptions(common::Configuration *conf,
         ConcurrentApplyOption *concurrentApplyOption);
 
+    void InitRaftFlags(common::Configuration *conf);
+
     void InitCopysetNodeOptions(common::Configuration *conf,
         CopysetNodeOptions *copysetNodeOptions);
 
@@ -79,6 +84,15 @@ class ChunkServer {
     void InitScanOptions(common::Configuration *conf,
         ScanManagerOptions *scanOptions);
 
+    void InitQosSchedulerOptions(common::Configuration *conf,
+        QosSchedulerOptions *qosOptions);
+
+    void InitFlattenManagerOptions(common::Configuration *conf,
+        FlattenManagerOptions *flattenOptions);
+
+    void InitHotChunkTrackerOptions(common::Configuration *conf,
+        HotChunkTrackerOptions *hotChunkOptions);
+
     void InitHeartbeatOptions(common::Configuration *conf,
         HeartbeatOptions *heartbeatOptions);
 
@@ -111,6 +125,15 @@ class ChunkServer {
     // scan copyset manager
     ScanManager scanManager_;
 
+    // qosScheduler_ 按mClock调度各类流量的请求
+    QosScheduler qosScheduler_;
+
+    // flattenManager_ 后台拷贝克隆chunk中还没有写过的数据
+    FlattenManager flattenManager_;
+
+    // hotChunkTracker_ 统计chunk的访问热度
+    HotChunkTracker hotChunkTracker_;
+
     // heartbeat_ 负责向mds定期发送心跳，并下发心跳中任务
     Heartbeat heartbeat_;
 
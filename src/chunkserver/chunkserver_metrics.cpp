@@ -26,6 +26,7 @@
 
 #include "src/chunkserver/copyset_node_manager.h"
 #include "src/chunkserver/passive_getfn.h"
+#include "src/chunkserver/raftsnapshot/curve_snapshot_copier.h"
 
 namespace curve {
 namespace chunkserver {
@@ -228,6 +229,7 @@ ChunkServerMetric::ChunkServerMetric()
     , chunkLeft_(nullptr)
     , walSegmentLeft_(nullptr)
     , chunkTrashed_(nullptr)
+    , trashPendingBytes_(nullptr)
     , chunkCount_(nullptr)
     , snapshotCount_(nullptr)
     , cloneChunkCount_(nullptr)
@@ -284,6 +286,9 @@ int ChunkServerMetric::Init(const ChunkServerMetricOptions& option) {
     cloneChunkCount_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
         cloneChunkCountPrefix, GetTotalCloneChunkCountFunc, this);
 
+    // install snapshot的下载进度
+    SnapshotCopyMetric::GetInstance()->Expose(Prefix());
+
     hasInited_ = true;
     LOG(INFO) << "Init chunkserver metric success.";
     return 0;
@@ -296,10 +301,12 @@ int ChunkServerMetric::Fini() {
     chunkLeft_ = nullptr;
     walSegmentLeft_ = nullptr;
     chunkTrashed_ = nullptr;
+    trashPendingBytes_ = nullptr;
     chunkCount_ = nullptr;
     snapshotCount_ = nullptr;
     cloneChunkCount_ = nullptr;
     walSegmentCount_ = nullptr;
+    SnapshotCopyMetric::GetInstance()->Hide();
     copysetMetricMap_.Clear();
     hasInited_ = false;
     return 0;
@@ -412,6 +419,10 @@ void ChunkServerMetric::MonitorTrash(Trash* trash) {
     std::string chunkTrashedPrefix = Prefix() + "_chunk_trashed";
     chunkTrashed_ = std::make_shared<bvar::PassiveStatus<uint32_t>>(
         chunkTrashedPrefix, GetChunkTrashedFunc, trash);
+
+    std::string pendingBytesPrefix = Prefix() + "_trash_pending_reclaim_bytes";
+    trashPendingBytes_ = std::make_shared<bvar::PassiveStatus<uint64_t>>(
+        pendingBytesPrefix, GetTrashPendingReclaimBytesFunc, trash);
 }
 
 void ChunkServerMetric::IncreaseLeaderCount() {
@@ -537,6 +537,12 @@ class ChunkServerMetric : public Uncopyable {
         return chunkTrashed_->get_value();
     }
 
+    uint64_t GetTrashPendingReclaimBytes() const {
+        if (trashPendingBytes_ == nullptr)
+            return 0;
+        return trashPendingBytes_->get_value();
+    }
+
  private:
     ChunkServerMetric();
 
@@ -557,6 +563,8 @@ class ChunkServerMetric : public Uncopyable {
     PassiveStatusPtr<uint32_t> walSegmentLeft_;
     // trash 中的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkTrashed_;
+    // trash 中待归还给 chunkfilepool 的空间
+    PassiveStatusPtr<uint64_t> trashPendingBytes_;
     // chunkserver上的 chunk 的数量
     PassiveStatusPtr<uint32_t> chunkCount_;
     // The total number of WAL segment in chunkserver
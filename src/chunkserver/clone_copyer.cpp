@@ -20,6 +20,9 @@
  * Author: yangyaokai
  */
 
+#include <algorithm>
+#include <atomic>
+
 #include "src/chunkserver/clone_copyer.h"
 #include "src/chunkserver/clone_core.h"
 #include "src/common/timeutility.h"
@@ -27,6 +30,32 @@
 namespace curve {
 namespace chunkserver {
 
+namespace {
+
+// 记录顺序读状态的源chunk的数量上限
+const uint64_t kMaxReadaheadNum = 4096;
+
+void DeleteBlockBuffer(void* ptr) {
+    delete[] static_cast<char*>(ptr);
+}
+
+std::string BlockKey(const std::string& location, uint32_t index) {
+    return location + ":" + std::to_string(index);
+}
+
+}  // namespace
+
+struct BlockReadContext {
+    DownloadClosure* done;
+    // 请求覆盖的第一个块在chunk中的偏移
+    off_t windowOffset;
+    // 请求覆盖的各个块的数据
+    std::vector<butil::IOBuf> blocks;
+    // 还没有就绪的块数
+    std::atomic<uint32_t> pending;
+    std::atomic<bool> failed;
+};
+
 std::ostream& operator<<(std::ostream& out, const AsyncDownloadContext& rhs) {
     out  << "{ location: " << rhs.location
         << ", offset: " << rhs.offset
@@ -36,7 +65,7 @@ std::ostream& operator<<(std::ostream& out, const AsyncDownloadContext& rhs) {
 }
 
 struct CurveAioCombineContext {
-    DownloadClosure* done;
+    DownloadCallback cb;
     CurveAioContext curveCtx;
 };
 
@@ -44,13 +73,11 @@ void CurveAioCallback(struct CurveAioContext* context) {
     auto curveCombineCtx = reinterpret_cast<CurveAioCombineContext *>(
         reinterpret_cast<char *>(context) -
         offsetof(CurveAioCombineContext, curveCtx));
-    DownloadClosure* done = curveCombineCtx->done;
-    if (context->ret < 0) {
-        done->SetFailed();
-    }
+    DownloadCallback cb = std::move(curveCombineCtx->cb);
+    bool success = context->ret >= 0;
     delete curveCombineCtx;
 
-    brpc::ClosureGuard doneGuard(done);
+    cb(success);
 }
 
 void OriginCopyer::DeleteExpiredCurveCache(void* arg) {
@@ -84,7 +111,10 @@ void OriginCopyer::DeleteExpiredCurveCache(void* arg) {
 
 OriginCopyer::OriginCopyer()
     : curveClient_(nullptr)
-    , s3Client_(nullptr) {}
+    , s3Client_(nullptr)
+    , blockSize_(0)
+    , chunkBlocks_(0)
+    , maxBlocks_(1) {}
 
 int OriginCopyer::Init(const CopyerOptions& options) {
     curveFileTimeoutSec_ = options.curveFileTimeoutSec;
@@ -115,6 +145,30 @@ int OriginCopyer::Init(const CopyerOptions& options) {
         LOG(FATAL) << "init curveFile timer thread failed, " << berror(rc);
     }
     timerId_ = bthread::TimerThread::INVALID_TASK_ID;
+
+    blockSize_ = options.prefetchBlockSize;
+    if (blockSize_ != 0) {
+        if (options.chunkSize == 0 || options.chunkSize % blockSize_ != 0 ||
+            options.cacheCapacity < blockSize_) {
+            LOG(WARNING) << "Disable prefetch of origin data, chunk size: "
+                         << options.chunkSize
+                         << ", prefetch block size: " << blockSize_
+                         << ", cache capacity: " << options.cacheCapacity;
+            blockSize_ = 0;
+        } else {
+            chunkBlocks_ = options.chunkSize / blockSize_;
+            maxBlocks_ = std::min(chunkBlocks_,
+                                  std::max(options.prefetchMaxBlocks, 1U));
+            blockCache_.reset(new LRUCache<std::string, butil::IOBuf>(
+                options.cacheCapacity / blockSize_,
+                std::make_shared<CacheMetrics>("chunkserver_clone_cache")));
+            readahead_.reset(new LRUCache<std::string, ReadaheadState>(
+                kMaxReadaheadNum));
+            LOG(INFO) << "Enable prefetch of origin data, block size: "
+                      << blockSize_ << ", max blocks: " << maxBlocks_
+                      << ", cache capacity: " << options.cacheCapacity;
+        }
+    }
     return 0;
 }
 
@@ -140,33 +194,61 @@ int OriginCopyer::Fini() {
 void OriginCopyer::DownloadAsync(DownloadClosure* done) {
     brpc::ClosureGuard doneGuard(done);
     AsyncDownloadContext* context = done->GetDownloadContext();
+    OriginSource source;
+    if (!ParseOrigin(context->location, &source)) {
+        done->SetFailed();
+        return;
+    }
+
+    if (blockSize_ != 0) {
+        DownloadByBlock(source, doneGuard.release());
+        return;
+    }
+
+    Download(source, context->offset, context->size, context->buf,
+             [done](bool success) {
+                 brpc::ClosureGuard doneGuard(done);
+                 if (!success) {
+                     done->SetFailed();
+                 }
+             });
+    doneGuard.release();
+}
+
+bool OriginCopyer::ParseOrigin(const string& location,
+                               OriginSource* source) {
     std::string originPath;
-    OriginType type =
-        LocationOperator::ParseLocation(context->location, &originPath);
-    if (type == OriginType::CurveOrigin) {
-        off_t chunkOffset;
-        std::string fileName;
+    source->type = LocationOperator::ParseLocation(location, &originPath);
+    source->chunkOffset = 0;
+    if (source->type == OriginType::CurveOrigin) {
         bool parseSuccess = LocationOperator::ParseCurveChunkPath(
-            originPath, &fileName, &chunkOffset);
+            originPath, &source->name, &source->chunkOffset);
         if (!parseSuccess) {
             LOG(ERROR) << "Parse curve chunk path failed."
                        << "originPath: " << originPath;
-            done->SetFailed();
-            return;
+            return false;
         }
-        DownloadFromCurve(fileName, chunkOffset + context->offset,
-                          context->size, context->buf,
-                          done);
-        doneGuard.release();
-    } else if (type == OriginType::S3Origin) {
-        DownloadFromS3(originPath, context->offset,
-                       context->size, context->buf,
-                       done);
-        doneGuard.release();
+        return true;
+    } else if (source->type == OriginType::S3Origin) {
+        source->name = originPath;
+        return true;
+    }
+
+    LOG(ERROR) << "Unknown origin location."
+               << "location: " << location;
+    return false;
+}
+
+void OriginCopyer::Download(const OriginSource& source,
+                            off_t off,
+                            size_t size,
+                            char* buf,
+                            const DownloadCallback& cb) {
+    if (source.type == OriginType::CurveOrigin) {
+        DownloadFromCurve(source.name, source.chunkOffset + off,
+                          size, buf, cb);
     } else {
-        LOG(ERROR) << "Unknown origin location."
-                   << "location: " << context->location;
-        done->SetFailed();
+        DownloadFromS3(source.name, off, size, buf, cb);
     }
 }
 
@@ -174,22 +256,18 @@ void OriginCopyer::DownloadFromS3(const string& objectName,
                                  off_t off,
                                  size_t size,
                                  char* buf,
-                                 DownloadClosure* done) {
-    brpc::ClosureGuard doneGuard(done);
+                                 const DownloadCallback& cb) {
     if (s3Client_ == nullptr) {
         LOG(ERROR) << "Failed to get s3 object."
                    << "s3 adapter is disabled";
-        done->SetFailed();
+        cb(false);
         return;
     }
 
-    GetObjectAsyncCallBack cb =
-        [=] (const S3Adapter* adapter,
-             const std::shared_ptr<GetObjectAsyncContext>& context) {
-            brpc::ClosureGuard doneGuard(done);
-            if (context->retCode != 0) {
-                done->SetFailed();
-            }
+    GetObjectAsyncCallBack s3Cb =
+        [cb] (const S3Adapter* adapter,
+              const std::shared_ptr<GetObjectAsyncContext>& context) {
+            cb(context->retCode == 0);
         };
 
     auto context = std::make_shared<GetObjectAsyncContext>();
@@ -197,22 +275,20 @@ void OriginCopyer::DownloadFromS3(const string& objectName,
     context->buf = buf;
     context->offset = off;
     context->len = size;
-    context->cb = cb;
+    context->cb = s3Cb;
 
     s3Client_->GetObjectAsync(context);
-    doneGuard.release();
 }
 
 void OriginCopyer::DownloadFromCurve(const string& fileName,
                                     off_t off,
                                     size_t size,
                                     char* buf,
-                                    DownloadClosure* done) {
-    brpc::ClosureGuard doneGuard(done);
+                                    const DownloadCallback& cb) {
     if (curveClient_ == nullptr) {
         LOG(ERROR) << "Failed to read curve file."
                    << "curve client is disabled";
-        done->SetFailed();
+        cb(false);
         return;
     }
 
@@ -239,7 +315,9 @@ void OriginCopyer::DownloadFromCurve(const string& fileName,
                 LOG(ERROR) << "Open curve file failed."
                         << "file name: " << fileName
                         << " ,return code: " << fd;
-                done->SetFailed();
+                lockTime.unlock();
+                lock.unlock();
+                cb(false);
                 return;
             }
             fdMap_[fileName] = fd;
@@ -255,7 +333,7 @@ void OriginCopyer::DownloadFromCurve(const string& fileName,
     }
 
     CurveAioCombineContext *curveCombineCtx = new CurveAioCombineContext();
-    curveCombineCtx->done = done;
+    curveCombineCtx->cb = cb;
     curveCombineCtx->curveCtx.offset = off;
     curveCombineCtx->curveCtx.length = size;
     curveCombineCtx->curveCtx.buf = buf;
@@ -268,10 +346,195 @@ void OriginCopyer::DownloadFromCurve(const string& fileName,
                    << "file name: " << fileName
                    << " ,error code: " << ret;
         delete curveCombineCtx;
-        done->SetFailed();
+        cb(false);
+    }
+}
+
+void OriginCopyer::DownloadByBlock(const OriginSource& source,
+                                   DownloadClosure* done) {
+    AsyncDownloadContext* context = done->GetDownloadContext();
+    const std::string& location = context->location;
+    uint32_t first = context->offset / blockSize_;
+    uint32_t last = (context->offset + context->size - 1) / blockSize_;
+
+    // 超出chunk范围的请求按原样下载
+    if (context->size == 0 || last >= chunkBlocks_) {
+        Download(source, context->offset, context->size, context->buf,
+                 [done](bool success) {
+                     brpc::ClosureGuard doneGuard(done);
+                     if (!success) {
+                         done->SetFailed();
+                     }
+                 });
+        return;
+    }
+
+    auto ctx = std::make_shared<BlockReadContext>();
+    ctx->done = done;
+    ctx->windowOffset = static_cast<off_t>(first) * blockSize_;
+    ctx->blocks.resize(last - first + 1);
+    ctx->pending = last - first + 1;
+    ctx->failed = false;
+
+    std::vector<std::pair<uint32_t, butil::IOBuf>> hits;
+    std::vector<uint32_t> fetchBlocks;
+    {
+        std::lock_guard<std::mutex> lock(blockMtx_);
+        for (uint32_t i = first; i <= last; ++i) {
+            std::string key = BlockKey(location, i);
+            butil::IOBuf data;
+            if (blockCache_->Get(key, &data)) {
+                hits.emplace_back(i - first, data);
+                continue;
+            }
+            // 同一个块只下载一次，其它请求等待下载完成
+            auto it = inflight_.find(key);
+            if (it == inflight_.end()) {
+                it = inflight_.emplace(key, std::vector<BlockWaiter>()).first;
+                fetchBlocks.push_back(i);
+            }
+            it->second.emplace_back(ctx, i - first);
+        }
+
+        if (!fetchBlocks.empty()) {
+            uint32_t window = ReadaheadWindowLocked(location, first, last);
+            uint32_t end = std::min(chunkBlocks_, first + window);
+            for (uint32_t i = last + 1; i < end; ++i) {
+                std::string key = BlockKey(location, i);
+                butil::IOBuf data;
+                if (inflight_.count(key) != 0 ||
+                    blockCache_->Get(key, &data)) {
+                    break;
+                }
+                inflight_.emplace(key, std::vector<BlockWaiter>());
+                fetchBlocks.push_back(i);
+            }
+            ReadaheadState state;
+            state.nextBlock = std::max(last, fetchBlocks.back()) + 1;
+            state.window = window;
+            readahead_->Put(location, state);
+        }
+    }
+
+    for (auto& hit : hits) {
+        OnBlockReady(ctx, hit.first, hit.second, true);
+    }
+
+    // 连续的块合并成一次下载
+    size_t begin = 0;
+    for (size_t i = 1; i <= fetchBlocks.size(); ++i) {
+        if (i == fetchBlocks.size() ||
+            fetchBlocks[i] != fetchBlocks[i - 1] + 1) {
+            DownloadBlocks(source, location, fetchBlocks[begin], i - begin);
+            begin = i;
+        }
+    }
+}
+
+void OriginCopyer::DownloadBlocks(const OriginSource& source,
+                                  const string& location,
+                                  uint32_t firstBlock,
+                                  uint32_t blockNum) {
+    size_t size = static_cast<size_t>(blockNum) * blockSize_;
+    char* buf = new (std::nothrow) char[size];
+    if (buf == nullptr) {
+        LOG(ERROR) << "Allocate buffer for origin blocks failed, size: "
+                   << size;
+        // 等待这些块的请求都返回失败
+        OnBlocksDownloaded(location, firstBlock, blockNum, nullptr, false);
+        return;
+    }
+    Download(source, static_cast<off_t>(firstBlock) * blockSize_, size, buf,
+             [this, location, firstBlock, blockNum, buf](bool success) {
+                 OnBlocksDownloaded(location, firstBlock, blockNum,
+                                    buf, success);
+             });
+}
+
+void OriginCopyer::OnBlocksDownloaded(const string& location,
+                                      uint32_t firstBlock,
+                                      uint32_t blockNum,
+                                      char* buf,
+                                      bool success) {
+    butil::IOBuf data;
+    if (buf != nullptr) {
+        data.append_user_data(buf, static_cast<size_t>(blockNum) * blockSize_,
+                              DeleteBlockBuffer);
+    }
+
+    std::vector<std::pair<std::vector<BlockWaiter>, butil::IOBuf>> ready;
+    {
+        std::lock_guard<std::mutex> lock(blockMtx_);
+        for (uint32_t i = firstBlock; i < firstBlock + blockNum; ++i) {
+            std::string key = BlockKey(location, i);
+            butil::IOBuf block;
+            if (success) {
+                data.cutn(&block, blockSize_);
+                blockCache_->Put(key, block);
+            }
+            auto it = inflight_.find(key);
+            if (it == inflight_.end()) {
+                continue;
+            }
+            ready.emplace_back(std::move(it->second), block);
+            inflight_.erase(it);
+        }
+    }
+
+    if (!success) {
+        LOG(ERROR) << "Download origin blocks failed, location: " << location
+                   << ", first block: " << firstBlock
+                   << ", block num: " << blockNum;
+    }
+    for (auto& item : ready) {
+        for (auto& waiter : item.first) {
+            OnBlockReady(waiter.first, waiter.second, item.second, success);
+        }
+    }
+}
+
+uint32_t OriginCopyer::ReadaheadWindowLocked(const string& location,
+                                             uint32_t first,
+                                             uint32_t last) {
+    uint32_t window = last - first + 1;
+    ReadaheadState state;
+    // 请求从上次下载结束的位置继续，认为是顺序读，预取窗口加倍
+    if (readahead_->Get(location, &state) &&
+        first <= state.nextBlock && state.nextBlock <= last + 1) {
+        window = std::max(window, std::min(state.window * 2, maxBlocks_));
+    }
+    return window;
+}
+
+void OriginCopyer::OnBlockReady(const std::shared_ptr<BlockReadContext>& ctx,
+                                uint32_t index,
+                                const butil::IOBuf& data,
+                                bool success) {
+    if (success) {
+        ctx->blocks[index] = data;
     } else {
-        doneGuard.release();
+        ctx->failed = true;
+    }
+    if (ctx->pending.fetch_sub(1) != 1) {
+        return;
+    }
+
+    DownloadClosure* done = ctx->done;
+    brpc::ClosureGuard doneGuard(done);
+    if (ctx->failed) {
+        done->SetFailed();
+        return;
+    }
+
+    AsyncDownloadContext* context = done->GetDownloadContext();
+    butil::IOBuf window;
+    for (auto& block : ctx->blocks) {
+        window.append(block);
     }
+    window.copy_to(context->buf, context->size,
+                   context->offset - ctx->windowOffset);
+    context->windowOffset = ctx->windowOffset;
+    context->windowData.swap(window);
 }
 
 }  // namespace chunkserver
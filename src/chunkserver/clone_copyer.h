@@ -24,10 +24,14 @@
 #define SRC_CHUNKSERVER_CLONE_COPYER_H_
 
 #include <glog/logging.h>
+#include <butil/iobuf.h>
+#include <functional>
 #include <memory>
 #include <unordered_map>
 #include <string>
 #include <list>
+#include <utility>
+#include <vector>
 
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/common/location_operator.h"
@@ -36,8 +40,20 @@
 #include "src/client/client_common.h"
 #include "include/client/libcurve.h"
 #include "src/common/s3_adapter.h"
+#include "src/common/lru_cache.h"
 
 namespace curve {
+namespace common {
+
+template<>
+struct CacheTraits<butil::IOBuf> {
+    static uint64_t CountBytes(const butil::IOBuf &v) {
+        return v.size();
+    }
+};
+
+}  // namespace common
+
 namespace chunkserver {
 
 using curve::common::S3Adapter;
@@ -47,9 +63,12 @@ using curve::common::LocationOperator;
 using curve::common::OriginType;
 using curve::common::GetObjectAsyncCallBack;
 using curve::common::GetObjectAsyncContext;
+using curve::common::LRUCache;
+using curve::common::CacheMetrics;
 using std::string;
 
 class DownloadClosure;
+struct BlockReadContext;
 
 struct CopyerOptions {
     // curvefs上的root用户信息
@@ -64,6 +83,14 @@ struct CopyerOptions {
     std::shared_ptr<S3Adapter> s3Client;
     // curve file's time to live
     uint64_t curveFileTimeoutSec;
+    // chunk的大小，预取的范围不会超出所在的chunk
+    uint32_t chunkSize = 0;
+    // 按块预取和缓存源端数据时块的大小，为0时只下载请求的区域
+    uint32_t prefetchBlockSize = 0;
+    // 顺序读时预取窗口最多包含的块数
+    uint32_t prefetchMaxBlocks = 1;
+    // 源端数据缓存的容量，所有克隆chunk共享
+    uint64_t cacheCapacity = 0;
 };
 
 struct AsyncDownloadContext {
@@ -75,8 +102,23 @@ struct AsyncDownloadContext {
     size_t size;
     // 存放下载数据的缓冲区
     char* buf;
+    // 开启预取时，包含请求区域的按块对齐的数据在chunk中的偏移
+    off_t windowOffset = 0;
+    // 开启预取时，包含请求区域的按块对齐的数据，会整体paste到chunk中
+    butil::IOBuf windowData;
 };
 
+struct OriginSource {
+    OriginType type;
+    // s3上的对象名或者curve上的文件名
+    std::string name;
+    // 源chunk在curve文件中的偏移，s3上的对象为0
+    off_t chunkOffset;
+};
+
+// 源端数据下载完成后的回调，参数表示是否下载成功
+using DownloadCallback = std::function<void(bool)>;
+
 struct CurveOpenTimestamp {
     // Opened file id
     int fd;
@@ -118,16 +160,78 @@ class OriginCopyer {
     virtual void DownloadAsync(DownloadClosure* done);
 
  private:
+    // 顺序读的检测状态，用来调整预取窗口的大小
+    struct ReadaheadState {
+        // 上次下载的最后一个块的下一个块
+        uint32_t nextBlock;
+        // 上次预取窗口包含的块数
+        uint32_t window;
+    };
+
+    using BlockWaiter = std::pair<std::shared_ptr<BlockReadContext>, uint32_t>;
+
+    bool ParseOrigin(const string& location, OriginSource* source);
+
+    /**
+     * 从源端下载chunk中的一段数据
+     * @param source: 源端chunk
+     * @param off: 数据在chunk中的偏移
+     * @param size: 数据的长度
+     * @param buf: 存放下载数据的缓冲区
+     * @param cb: 下载完成后的回调
+     */
+    void Download(const OriginSource& source,
+                  off_t off,
+                  size_t size,
+                  char* buf,
+                  const DownloadCallback& cb);
     void DownloadFromS3(const string& objectName,
                        off_t off,
                        size_t size,
                        char* buf,
-                       DownloadClosure* done);
+                       const DownloadCallback& cb);
     void DownloadFromCurve(const string& fileName,
                           off_t off,
                           size_t size,
                           char* buf,
-                          DownloadClosure* done);
+                          const DownloadCallback& cb);
+
+    /**
+     * 按块下载请求的区域，已缓存的块直接使用，正在下载的块等待下载完成，
+     * 缺失的块按顺序读的情况扩大窗口后合并成一次下载
+     */
+    void DownloadByBlock(const OriginSource& source, DownloadClosure* done);
+
+    /**
+     * 下载[firstBlock, firstBlock + blockNum)范围内的块
+     */
+    void DownloadBlocks(const OriginSource& source,
+                        const string& location,
+                        uint32_t firstBlock,
+                        uint32_t blockNum);
+
+    /**
+     * 块下载完成，放入缓存并通知等待这些块的请求
+     * buf分配失败时为nullptr，此时success为false
+     */
+    void OnBlocksDownloaded(const string& location,
+                            uint32_t firstBlock,
+                            uint32_t blockNum,
+                            char* buf,
+                            bool success);
+
+    /**
+     * 计算这次需要预取的块数，连续的缺失按顺序读处理，窗口逐次加倍
+     */
+    uint32_t ReadaheadWindowLocked(const string& location,
+                                   uint32_t first,
+                                   uint32_t last);
+
+    static void OnBlockReady(const std::shared_ptr<BlockReadContext>& ctx,
+                             uint32_t index,
+                             const butil::IOBuf& data,
+                             bool success);
+
     static void DeleteExpiredCurveCache(void* arg);
 
  private:
@@ -151,6 +255,21 @@ class OriginCopyer {
     bthread::TimerThread timer_;
     // timer's task id
     bthread::TimerThread::TaskId timerId_;
+
+    // 预取和缓存的块大小，为0时不预取
+    uint32_t blockSize_;
+    // chunk包含的块数
+    uint32_t chunkBlocks_;
+    // 预取窗口最多包含的块数
+    uint32_t maxBlocks_;
+    // 保护inflight_以及预取状态
+    std::mutex blockMtx_;
+    // 正在下载的块 -> 等待该块的请求
+    std::unordered_map<std::string, std::vector<BlockWaiter>> inflight_;
+    // 源端数据块的缓存，key为"location:块序号"
+    std::unique_ptr<LRUCache<std::string, butil::IOBuf>> blockCache_;
+    // 源chunk location -> 顺序读的检测状态
+    std::unique_ptr<LRUCache<std::string, ReadaheadState>> readahead_;
 };
 
 }  // namespace chunkserver
@@ -93,12 +93,21 @@ void DownloadClosure::Run() {
         return;
     }
 
+    // 开启预取时下载的是按块对齐的窗口，整个窗口一起paste到chunk中，
+    // 后续读取窗口内其它区域的请求就不需要再从源端下载
+    const butil::IOBuf* pasteData = &copyData;
+    off_t pasteOffset = downloadCtx_->offset;
+    if (!downloadCtx_->windowData.empty()) {
+        pasteData = &downloadCtx_->windowData;
+        pasteOffset = downloadCtx_->windowOffset;
+    }
+
     if (CHUNK_OP_TYPE::CHUNK_OP_RECOVER == request->optype()) {
         // release doneGuard，将closure交给paste请求处理
         cloneCore_->PasteCloneData(readRequest_,
-                                   &copyData,
-                                   downloadCtx_->offset,
-                                   downloadCtx_->size,
+                                   pasteData,
+                                   pasteOffset,
+                                   pasteData->size(),
                                    doneGuard.release());
     } else if (CHUNK_OP_TYPE::CHUNK_OP_READ == request->optype()) {
         // 出错或处理结束调用closure返回给用户
@@ -106,9 +115,9 @@ void DownloadClosure::Run() {
 
         // paste clone data是异步操作，很快就能处理完
         cloneCore_->PasteCloneData(readRequest_,
-                                   &copyData,
-                                   downloadCtx_->offset,
-                                   downloadCtx_->size,
+                                   pasteData,
+                                   pasteOffset,
+                                   pasteData->size(),
                                    nullptr);
     }
 }
@@ -41,6 +41,8 @@ using curve::chunkserver::concurrent::ConcurrentApplyModule;
 class FilePool;
 class CopysetNodeManager;
 class CloneManager;
+class QosScheduler;
+class HotChunkTracker;
 
 /**
  * copyset node的配置选项
@@ -111,6 +113,8 @@ struct CopysetNodeOptions {
 
     // 限制chunkserver启动时copyset并发恢复加载的数量,为0表示不限制
     uint32_t loadConcurrency = 0;
+    // 加载一个copyset时并发打开chunk文件、读取metapage的线程数
+    uint32_t loadChunkConcurrency = 1;
     // chunkserver sync_thread_pool number of threads.
     uint32_t syncConcurrency = 20;
     // copyset trigger sync timeout
@@ -144,6 +148,10 @@ struct ChunkServiceOptions {
     CopysetNodeManager *copysetNodeManager;
     CloneManager *cloneManager;
     std::shared_ptr<InflightThrottle> inflightThrottle;
+    // 为空时请求不经过QoS调度，直接下发
+    QosScheduler *qosScheduler = nullptr;
+    // 为空时不统计chunk的访问热度
+    HotChunkTracker *hotChunkTracker = nullptr;
 };
 
 }  // namespace chunkserver
@@ -128,6 +128,7 @@ int CopysetNode::Init(const CopysetNodeOptions &options) {
     dsOptions.chunkSize = options.maxChunkSize;
     dsOptions.pageSize = options.pageSize;
     dsOptions.locationLimit = options.locationLimit;
+    dsOptions.loadConcurrency = options.loadChunkConcurrency;
     dsOptions.enableOdsyncWhenOpenChunkFile =
         options.enableOdsyncWhenOpenChunkFile;
     dataStore_ = std::make_shared<CSDataStore>(options.localFileSystem,
@@ -921,6 +922,23 @@ void CopysetNode::GetStatus(NodeStatus *status) {
     raftNode_->get_status(status);
 }
 
+void CopysetNode::GetLeaderLeaseStatus(braft::LeaderLeaseStatus *status) {
+    raftNode_->get_leader_lease_status(status);
+}
+
+bool CopysetNode::IsLeaseLeader(const braft::LeaderLeaseStatus &status) {
+    int64_t term = leaderTerm_.load(std::memory_order_acquire);
+    // lease是上一个任期的，当前任期的on_leader_start还没有执行或者已经step down
+    if (term <= 0 || term != status.term) {
+        return false;
+    }
+    return status.state == braft::LEASE_VALID;
+}
+
+bool CopysetNode::IsLeaseExpired(const braft::LeaderLeaseStatus &status) {
+    return status.state == braft::LEASE_EXPIRED;
+}
+
 bool CopysetNode::GetLeaderStatus(NodeStatus *leaderStaus) {
     NodeStatus status;
     GetStatus(&status);
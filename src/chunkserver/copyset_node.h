@@ -280,6 +280,27 @@ class CopysetNode : public braft::StateMachine,
      */
     virtual bool GetLeaderStatus(NodeStatus *leaderStaus);
 
+    /**
+     * 获取leader lease的状态，没有开启lease时状态为LEASE_DISABLED
+     * @param status[out]: lease状态
+     */
+    virtual void GetLeaderLeaseStatus(braft::LeaderLeaseStatus *status);
+
+    /**
+     * 判断lease是否有效，lease有效期间不会有其他节点成为leader，
+     * 读请求可以直接读本地数据，不需要经过raft
+     * @param status: GetLeaderLeaseStatus获取的lease状态
+     * @return lease有效且和当前leader任期一致返回true
+     */
+    virtual bool IsLeaseLeader(const braft::LeaderLeaseStatus &status);
+
+    /**
+     * 判断lease是否已经过期，过期说明leader已经和多数节点失联，
+     * 可能已经有新的leader，请求需要重定向
+     * @param status: GetLeaderLeaseStatus获取的lease状态
+     */
+    virtual bool IsLeaseExpired(const braft::LeaderLeaseStatus &status);
+
     /**
      * 返回data store指针
      * @return
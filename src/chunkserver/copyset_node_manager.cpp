@@ -23,6 +23,7 @@
 #include "src/chunkserver/copyset_node_manager.h"
 
 #include <glog/logging.h>
+#include <bvar/bvar.h>
 #include <braft/file_service.h>
 #include <braft/node_manager.h>
 
@@ -51,6 +52,20 @@ using curve::common::TimeUtility;
 
 std::once_flag addServiceFlag;
 
+namespace {
+
+// 启动阶段各步骤的耗时
+// 创建copyset的耗时，包括加载chunk文件和raft日志
+bvar::LatencyRecorder g_copyset_create_latency("chunkserver_copyset_create");
+// copyset创建后追上leader的耗时
+bvar::LatencyRecorder g_copyset_catchup_latency(
+    "chunkserver_copyset_catchup");
+// 加载所有copyset的耗时
+bvar::Status<uint64_t> g_reload_copysets_ms(
+    "chunkserver_reload_copysets_ms", 0);
+
+}  // namespace
+
 int CopysetNodeManager::Init(const CopysetNodeOptions &copysetNodeOptions) {
     copysetNodeOptions_ = copysetNodeOptions;
     CopysetNode::syncTriggerSeconds_ = copysetNodeOptions.syncTriggerSeconds;
@@ -116,6 +131,7 @@ int CopysetNodeManager::Fini() {
 }
 
 int CopysetNodeManager::ReloadCopysets() {
+    uint64_t beginTime = TimeUtility::GetTimeofDayMs();
     std::string datadir = curve::common::UriParser::GetPathFromUri(
         copysetNodeOptions_.chunkDataUri);
     if (!copysetNodeOptions_.localFileSystem->DirExists(datadir)) {
@@ -167,6 +183,9 @@ int CopysetNodeManager::ReloadCopysets() {
         copysetLoader_ = nullptr;
     }
 
+    g_reload_copysets_ms.set_value(TimeUtility::GetTimeofDayMs() - beginTime);
+    LOG(INFO) << "Reload " << items.size() << " copysets, time used (ms): "
+              << g_reload_copysets_ms.get_value();
     return 0;
 }
 
@@ -198,10 +217,14 @@ void CopysetNodeManager::LoadCopyset(const LogicPoolID &logicPoolId,
                    << ToGroupIdString(logicPoolId, copysetId);
         return;
     }
+    uint64_t createdTime = TimeUtility::GetTimeofDayMs();
+    g_copyset_create_latency << (createdTime - beginTime) * 1000;
     if (needCheckLoadFinished) {
         std::shared_ptr<CopysetNode> node =
             GetCopysetNode(logicPoolId, copysetId);
         CheckCopysetUntilLoadFinished(node);
+        g_copyset_catchup_latency <<
+            (TimeUtility::GetTimeofDayMs() - createdTime) * 1000;
     }
     LOG(INFO) << "Load copyset " << ToGroupIdString(logicPoolId, copysetId)
               << " end, time used (ms): "
@@ -135,7 +135,7 @@ class CopysetNodeManager : public curve::common::Uncopyable {
      * 查询所有的copysets
      * @param nodes:出参，返回所有的copyset
      */
-    void GetAllCopysetNodes(std::vector<CopysetNodePtr> *nodes) const;
+    virtual void GetAllCopysetNodes(std::vector<CopysetNodePtr> *nodes) const;
 
     /**
      * 添加RPC service
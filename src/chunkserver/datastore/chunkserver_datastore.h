@@ -30,6 +30,7 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
+#include <utility>
 #include <condition_variable>
 
 #include "include/curve_compiler_specific.h"
@@ -54,6 +55,8 @@ inline void TrivialDeleter(void* /*ptr*/) {}
  * baseDir: Directory path managed by DataStore
  * chunkSize: The size of the chunk file or snapshot file in the DataStore
  * pageSize: the size of the smallest read-write unit
+ * loadConcurrency: number of threads to open chunk files and load their
+ *                  metapages in Initialize
  */
 struct DataStoreOptions {
     std::string                         baseDir;
@@ -61,6 +64,8 @@ struct DataStoreOptions {
     PageSizeType                        pageSize;
     uint32_t                            locationLimit;
     bool                                enableOdsyncWhenOpenChunkFile;
+    // number of threads to load chunk files when initializing
+    uint32_t                            loadConcurrency = 1;
 };
 
 /**
@@ -336,6 +341,14 @@ class CSDataStore {
 
  private:
     CSErrorCode loadChunkFile(ChunkID id);
+    /**
+     * Load chunk files in parallel, and then the snapshot files on them
+     * @param chunkIds: ids of chunk files to load
+     * @param snapshots: chunk id and sequence number of snapshot files
+     * @return: true if all files are loaded
+     */
+    bool loadFiles(const std::vector<ChunkID>& chunkIds,
+        const std::vector<std::pair<ChunkID, SequenceNum>>& snapshots);
     CSErrorCode CreateChunkFile(const ChunkOptions & ops,
                                 CSChunkFilePtr* chunkFile);
 
@@ -359,6 +372,8 @@ class CSDataStore {
     DataStoreMetricPtr metric_;
     // enable O_DSYNC When Open ChunkFile
     bool enableOdsyncWhenOpenChunkFile_;
+    // number of threads to load chunk files when initializing
+    uint32_t loadConcurrency_;
 };
 
 }  // namespace chunkserver
@@ -547,6 +547,37 @@ bool FilePool::WriteMetaPage(const std::string& sourcepath, const char* page) {
     return true;
 }
 
+bool FilePool::CheckRecycleFile(const std::string& chunkpath) {
+    uint64_t chunklen = poolOpt_.fileSize + poolOpt_.metaPageSize;
+    int fd = fsptr_->Open(chunkpath.c_str(), O_RDWR);
+    if (fd < 0) {
+        LOG(ERROR) << "file open failed! delete file dirctly"
+                   << ", filename = " << chunkpath.c_str();
+        return false;
+    }
+
+    struct stat info;
+    int ret = fsptr_->Fstat(fd, &info);
+    if (ret != 0) {
+        LOG(ERROR) << "Fstat file " << chunkpath.c_str()
+                   << "failed, ret = " << ret << ", delete file dirctly";
+        fsptr_->Close(fd);
+        return false;
+    }
+
+    if (info.st_size != chunklen) {
+        LOG(ERROR) << "file size illegal, " << chunkpath.c_str()
+                   << ", delete file dirctly"
+                   << ", standard size = " << chunklen
+                   << ", current file size = " << info.st_size;
+        fsptr_->Close(fd);
+        return false;
+    }
+
+    fsptr_->Close(fd);
+    return true;
+}
+
 int FilePool::RecycleFile(const std::string& chunkpath) {
     if (!poolOpt_.getFileFromPool) {
         int ret = fsptr_->Delete(chunkpath.c_str());
@@ -557,34 +588,10 @@ int FilePool::RecycleFile(const std::string& chunkpath) {
     } else {
         // Check whether the size of the file to be recovered meets the
         // requirements, and delete it if it does not
-        uint64_t chunklen = poolOpt_.fileSize + poolOpt_.metaPageSize;
-        int fd = fsptr_->Open(chunkpath.c_str(), O_RDWR);
-        if (fd < 0) {
-            LOG(ERROR) << "file open failed! delete file dirctly"
-                       << ", filename = " << chunkpath.c_str();
-            return fsptr_->Delete(chunkpath.c_str());
-        }
-
-        struct stat info;
-        int ret = fsptr_->Fstat(fd, &info);
-        if (ret != 0) {
-            LOG(ERROR) << "Fstat file " << chunkpath.c_str()
-                       << "failed, ret = " << ret << ", delete file dirctly";
-            fsptr_->Close(fd);
-            return fsptr_->Delete(chunkpath.c_str());
-        }
-
-        if (info.st_size != chunklen) {
-            LOG(ERROR) << "file size illegal, " << chunkpath.c_str()
-                       << ", delete file dirctly"
-                       << ", standard size = " << chunklen
-                       << ", current file size = " << info.st_size;
-            fsptr_->Close(fd);
+        if (!CheckRecycleFile(chunkpath)) {
             return fsptr_->Delete(chunkpath.c_str());
         }
 
-        fsptr_->Close(fd);
-
         uint64_t newfilenum = 0;
         std::string newfilename;
         {
@@ -595,7 +602,7 @@ int FilePool::RecycleFile(const std::string& chunkpath) {
         }
         std::string targetpath = currentdir_ + "/" + newfilename;
 
-        ret = fsptr_->Rename(chunkpath.c_str(), targetpath.c_str());
+        int ret = fsptr_->Rename(chunkpath.c_str(), targetpath.c_str());
         if (ret < 0) {
             LOG(ERROR) << "file rename failed, " << chunkpath.c_str();
             return -1;
@@ -612,6 +619,70 @@ int FilePool::RecycleFile(const std::string& chunkpath) {
     return 0;
 }
 
+int FilePool::RecycleFiles(const std::vector<std::string>& chunkpaths,
+                           uint32_t* recycled) {
+    *recycled = 0;
+    if (!poolOpt_.getFileFromPool) {
+        for (const auto& chunkpath : chunkpaths) {
+            if (fsptr_->Delete(chunkpath.c_str()) < 0) {
+                LOG(ERROR) << "Recycle chunk failed, " << chunkpath;
+                continue;
+            }
+            ++*recycled;
+        }
+        return *recycled == chunkpaths.size() ? 0 : -1;
+    }
+
+    // Files with illegal size are deleted directly, the others are put
+    // back to the pool
+    std::vector<const std::string*> valid;
+    valid.reserve(chunkpaths.size());
+    for (const auto& chunkpath : chunkpaths) {
+        if (CheckRecycleFile(chunkpath)) {
+            valid.push_back(&chunkpath);
+        } else if (fsptr_->Delete(chunkpath.c_str()) == 0) {
+            ++*recycled;
+        }
+    }
+
+    // Reserve the file numbers of the whole batch at once
+    uint64_t firstfilenum = 0;
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        firstfilenum = currentmaxfilenum_.fetch_add(valid.size()) + 1;
+    }
+
+    std::vector<uint64_t> newfilenums;
+    newfilenums.reserve(valid.size());
+    for (size_t i = 0; i < valid.size(); ++i) {
+        uint64_t newfilenum = firstfilenum + i;
+        std::string targetpath =
+            currentdir_ + "/" + std::to_string(newfilenum);
+        int ret = fsptr_->Rename(valid[i]->c_str(), targetpath.c_str());
+        if (ret < 0) {
+            LOG(ERROR) << "file rename failed, " << *valid[i];
+            continue;
+        }
+        newfilenums.push_back(newfilenum);
+    }
+
+    uint64_t poolsize = 0;
+    {
+        std::unique_lock<std::mutex> lk(mtx_);
+        dirtyChunks_.insert(dirtyChunks_.end(), newfilenums.begin(),
+                            newfilenums.end());
+        currentState_.dirtyChunksLeft += newfilenums.size();
+        currentState_.preallocatedChunksLeft += newfilenums.size();
+        poolsize = currentState_.dirtyChunksLeft;
+    }
+    *recycled += newfilenums.size();
+
+    LOG(INFO) << "Recycle " << newfilenums.size() << " files to pool"
+              << ", failed " << chunkpaths.size() - *recycled
+              << ", now chunkpool size = " << poolsize;
+    return *recycled == chunkpaths.size() ? 0 : -1;
+}
+
 void FilePool::UnInitialize() {
     currentdir_ = "";
 
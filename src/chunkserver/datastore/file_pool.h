@@ -159,6 +159,15 @@ class CURVE_CACHELINE_ALIGNMENT FilePool {
      * @param: chunkpath is the chunk path that needs to be recycled
      */
     virtual int RecycleFile(const std::string& chunkpath);
+    /**
+     * Recycle a batch of chunks, the new file numbers are reserved and the
+     * recycled files are appended to the dirty list under one lock
+     * @param: chunkpaths are the chunk paths that need to be recycled
+     * @param: recycled returns the number of files recycled successfully
+     * @return: return 0 if all files are recycled, otherwise return -1
+     */
+    virtual int RecycleFiles(const std::vector<std::string>& chunkpaths,
+                             uint32_t* recycled);
     /**
      * Get the current chunkfile pool size
      */
@@ -225,6 +234,13 @@ class CURVE_CACHELINE_ALIGNMENT FilePool {
      * @return: return 0 if successful, otherwise return less than 0
      */
     int AllocateChunk(const std::string& chunkpath);
+    /**
+     * Check whether the size of the file to be recycled meets the
+     * requirements
+     * @param: chunkpath is the path of the file to be recycled
+     * @return: return true if the file can be put back to FilePool
+     */
+    bool CheckRecycleFile(const std::string& chunkpath);
 
     /**
      * @brief: Get chunk
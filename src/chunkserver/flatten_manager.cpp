@@ -0,0 +1,396 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/chunkserver/flatten_manager.h"
+
+#include <brpc/closure_guard.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <vector>
+
+#include "src/chunkserver/chunkserver_metrics.h"
+#include "src/chunkserver/op_request.h"
+#include "src/common/bitmap.h"
+#include "src/common/concurrent/count_down_event.h"
+#include "src/common/location_operator.h"
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::BitRange;
+using ::curve::common::Bitmap;
+using ::curve::common::CountDownEvent;
+using ::curve::common::LocationOperator;
+using ::curve::common::LockGuard;
+using ::curve::common::OriginType;
+using ::curve::common::TimeUtility;
+
+namespace {
+
+const uint64_t kUsPerSec = 1000000;
+// 磁盘不空闲时，每隔多久重新检查一次
+const uint32_t kIdleCheckIntervalMs = 100;
+
+/**
+ * recover请求的上下文，请求超时后flatten线程不再等待，
+ * 由closure和flatten线程共同持有，保证请求完成时资源仍然有效
+ */
+struct FlattenContext {
+    ChunkRequest request;
+    ChunkResponse response;
+    CountDownEvent event{1};
+    uint64_t startUs = 0;
+};
+
+class FlattenClosure : public google::protobuf::Closure {
+ public:
+    explicit FlattenClosure(std::shared_ptr<FlattenContext> ctx)
+        : ctx_(ctx), scheduler_(nullptr) {}
+
+    void SetQosScheduler(QosScheduler* scheduler) {
+        scheduler_ = scheduler;
+    }
+
+    void Run() override {
+        std::unique_ptr<FlattenClosure> selfGuard(this);
+        if (scheduler_ != nullptr) {
+            scheduler_->OnComplete(IOClass::CLONE,
+                TimeUtility::GetTimeofDayUs() - ctx_->startUs);
+        }
+        ctx_->event.Signal();
+    }
+
+ private:
+    std::shared_ptr<FlattenContext> ctx_;
+    QosScheduler* scheduler_;
+};
+
+}  // namespace
+
+FlattenManager::FlattenManager()
+    : windowStartUs_(0),
+      windowBytes_(0),
+      isStop_(true),
+      flattenedBytes_("chunkserver_flatten_bytes"),
+      failedRequests_("chunkserver_flatten_failed_requests") {}
+
+FlattenManager::~FlattenManager() {
+    Fini();
+}
+
+int FlattenManager::Init(const FlattenManagerOptions& options) {
+    options_ = options;
+    if (options_.enable && (options_.copysetNodeManager == nullptr ||
+                            options_.cloneManager == nullptr ||
+                            options_.sliceSize == 0)) {
+        LOG(ERROR) << "Invalid flatten manager option, sliceSize: "
+                   << options_.sliceSize;
+        return -1;
+    }
+    LOG(INFO) << "Init flatten manager, enable: " << options_.enable
+              << ", interval: " << options_.intervalSec
+              << "s, bandwidth: " << options_.bandwidthBytes
+              << ", idle iops: " << options_.idleIops;
+    return 0;
+}
+
+int FlattenManager::Run() {
+    if (!options_.enable) {
+        return 0;
+    }
+    if (isStop_.exchange(false)) {
+        sleeper_.init();
+        flattenThread_ = Thread(&FlattenManager::FlattenLoop, this);
+        LOG(INFO) << "Start flatten thread ok.";
+        return 0;
+    }
+    return -1;
+}
+
+int FlattenManager::Fini() {
+    if (!isStop_.exchange(true)) {
+        LOG(INFO) << "stop flatten manager...";
+        sleeper_.interrupt();
+        flattenThread_.join();
+        LOG(INFO) << "stop flatten manager ok.";
+    }
+    return 0;
+}
+
+void FlattenManager::FlattenLoop() {
+    while (sleeper_.wait_for(std::chrono::seconds(options_.intervalSec))) {
+        FlattenOnce();
+    }
+}
+
+std::map<std::string, FlattenProgress> FlattenManager::GetProgress() {
+    LockGuard lk(mtx_);
+    return progress_;
+}
+
+std::string FlattenManager::GetCloneSource(const std::string& location) {
+    std::string originPath;
+    OriginType type = LocationOperator::ParseLocation(location, &originPath);
+    if (type == OriginType::CurveOrigin) {
+        std::string fileName;
+        off_t offset;
+        if (!LocationOperator::ParseCurveChunkPath(originPath, &fileName,
+                                                   &offset)) {
+            return "";
+        }
+        return fileName;
+    } else if (type == OriginType::S3Origin) {
+        // 快照数据的object名称为${filename}-${chunkindex}-${seqnum}
+        size_t pos = originPath.rfind('-');
+        if (pos == std::string::npos || pos == 0) {
+            return "";
+        }
+        pos = originPath.rfind('-', pos - 1);
+        if (pos == std::string::npos || pos == 0) {
+            return "";
+        }
+        return originPath.substr(0, pos);
+    }
+    return "";
+}
+
+void FlattenManager::FlattenOnce() {
+    std::vector<CopysetNodePtr> nodes;
+    options_.copysetNodeManager->GetAllCopysetNodes(&nodes);
+
+    // 只统计leader上的chunk，避免同一个chunk的三个副本被重复统计
+    std::map<std::string, FlattenProgress> progress;
+    for (const auto& node : nodes) {
+        if (!node->IsLeaderTerm()) {
+            continue;
+        }
+        auto dataStore = node->GetDataStore();
+        if (dataStore == nullptr) {
+            continue;
+        }
+        ChunkMap chunkMap = dataStore->GetChunkMap();
+        for (const auto& item : chunkMap) {
+            CSChunkInfo info;
+            item.second->GetInfo(&info);
+            if (!info.isClone || info.bitmap == nullptr) {
+                continue;
+            }
+            std::string source = GetCloneSource(info.location);
+            if (source.empty()) {
+                LOG(WARNING) << "Invalid clone location: " << info.location
+                             << ", chunkid: " << info.chunkId;
+                continue;
+            }
+            FlattenProgress& entry = progress[source];
+            entry.cloneChunkNum++;
+            std::vector<BitRange> clearRanges, setRanges;
+            info.bitmap->Divide(0, info.bitmap->Size() - 1,
+                                &clearRanges, &setRanges);
+            for (const auto& range : clearRanges) {
+                entry.remainingBytes += static_cast<uint64_t>(
+                    range.endIndex - range.beginIndex + 1) * info.pageSize;
+            }
+        }
+    }
+    {
+        LockGuard lk(mtx_);
+        progress_.swap(progress);
+    }
+
+    for (const auto& node : nodes) {
+        if (!node->IsLeaderTerm()) {
+            continue;
+        }
+        if (FlattenCopyset(node)) {
+            return;
+        }
+    }
+}
+
+bool FlattenManager::FlattenCopyset(const CopysetNodePtr& node) {
+    auto dataStore = node->GetDataStore();
+    if (dataStore == nullptr) {
+        return false;
+    }
+
+    ChunkMap chunkMap = dataStore->GetChunkMap();
+    for (const auto& item : chunkMap) {
+        CSChunkInfo info;
+        item.second->GetInfo(&info);
+        if (!info.isClone || info.bitmap == nullptr) {
+            continue;
+        }
+
+        uint32_t pagesPerSlice = std::max<uint32_t>(
+            1, options_.sliceSize / info.pageSize);
+        uint32_t pageNum = info.bitmap->Size();
+        uint32_t index = info.bitmap->NextClearBit(0);
+        while (index != Bitmap::NO_POS && index < pageNum) {
+            // 按slice对齐发送recover请求，和客户端读触发的拷贝范围一致
+            uint32_t begin = index / pagesPerSlice * pagesPerSlice;
+            uint32_t end = std::min(begin + pagesPerSlice, pageNum);
+            uint64_t bytes = static_cast<uint64_t>(end - begin) *
+                             info.pageSize;
+            if (!Throttle(bytes)) {
+                return true;
+            }
+            // 主从切换后不再处理该copyset，由新的leader负责
+            if (!node->IsLeaderTerm()) {
+                return false;
+            }
+            if (RecoverSlice(node, info.chunkId, begin * info.pageSize,
+                             bytes) != 0) {
+                // 跳过这个chunk，下一轮再重试
+                break;
+            }
+            if (end >= pageNum) {
+                break;
+            }
+            index = info.bitmap->NextClearBit(end);
+        }
+    }
+    return false;
+}
+
+int FlattenManager::RecoverSlice(const CopysetNodePtr& node, ChunkID chunkId,
+                                 uint32_t offset, uint32_t size) {
+    auto ctx = std::make_shared<FlattenContext>();
+    ctx->request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_RECOVER);
+    ctx->request.set_logicpoolid(node->GetLogicPoolId());
+    ctx->request.set_copysetid(node->GetCopysetId());
+    ctx->request.set_chunkid(chunkId);
+    ctx->request.set_offset(offset);
+    ctx->request.set_size(size);
+    ctx->startUs = TimeUtility::GetTimeofDayUs();
+
+    QosScheduler* scheduler = options_.qosScheduler;
+    if (scheduler != nullptr && !scheduler->Enabled()) {
+        scheduler = nullptr;
+    }
+    FlattenClosure* done = new FlattenClosure(ctx);
+    if (scheduler != nullptr) {
+        scheduler->Submit(IOClass::CLONE, 0, size,
+                          [this, node, ctx, done, scheduler](bool scheduled) {
+            if (scheduled) {
+                done->SetQosScheduler(scheduler);
+            }
+            ProcessRecover(node, &ctx->request, &ctx->response, done);
+        });
+    } else {
+        ProcessRecover(node, &ctx->request, &ctx->response, done);
+    }
+
+    if (!ctx->event.WaitFor(options_.requestTimeoutMs)) {
+        LOG(WARNING) << "Flatten chunk timeout, "
+                     << ToGroupIdStr(node->GetLogicPoolId(),
+                                     node->GetCopysetId())
+                     << ", chunkid: " << chunkId
+                     << ", offset: " << offset << ", size: " << size;
+        failedRequests_ << 1;
+        return -1;
+    }
+    if (ctx->response.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+        LOG(WARNING) << "Flatten chunk failed, "
+                     << ToGroupIdStr(node->GetLogicPoolId(),
+                                     node->GetCopysetId())
+                     << ", chunkid: " << chunkId
+                     << ", offset: " << offset << ", size: " << size
+                     << ", status: "
+                     << CHUNK_OP_STATUS_Name(ctx->response.status());
+        failedRequests_ << 1;
+        return -1;
+    }
+    flattenedBytes_ << size;
+    return 0;
+}
+
+void FlattenManager::ProcessRecover(const CopysetNodePtr& node,
+                                    ChunkRequest* request,
+                                    ChunkResponse* response,
+                                    google::protobuf::Closure* done) {
+    auto req = std::make_shared<ReadChunkRequest>(node,
+                                                  options_.cloneManager,
+                                                  nullptr,
+                                                  request,
+                                                  response,
+                                                  done);
+    req->Process();
+}
+
+bool FlattenManager::Interrupted() {
+    return !sleeper_.wait_for(std::chrono::milliseconds(0));
+}
+
+bool FlattenManager::IsDiskIdle() {
+    if (options_.idleIops == 0) {
+        return true;
+    }
+    ChunkServerMetric* metric = ChunkServerMetric::GetInstance();
+    IOMetricPtr readMetric = metric->GetIOMetric(CSIOMetricType::READ_CHUNK);
+    IOMetricPtr writeMetric =
+        metric->GetIOMetric(CSIOMetricType::WRITE_CHUNK);
+    if (readMetric == nullptr || writeMetric == nullptr) {
+        return true;
+    }
+    uint64_t iops = readMetric->iops_.get_value(1) +
+                    writeMetric->iops_.get_value(1);
+    return iops <= options_.idleIops;
+}
+
+bool FlattenManager::Throttle(uint64_t bytes) {
+    bool waited = false;
+    while (!IsDiskIdle()) {
+        waited = true;
+        if (!sleeper_.wait_for(
+                std::chrono::milliseconds(kIdleCheckIntervalMs))) {
+            return false;
+        }
+    }
+    if (Interrupted()) {
+        return false;
+    }
+    if (options_.bandwidthBytes == 0) {
+        return true;
+    }
+
+    // 按秒统计拷贝的数据量，等待过磁盘空闲后重新开始计算
+    uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+    if (waited || nowUs >= windowStartUs_ + kUsPerSec) {
+        windowStartUs_ = nowUs;
+        windowBytes_ = 0;
+    }
+    if (windowBytes_ > 0 && windowBytes_ + bytes > options_.bandwidthBytes) {
+        uint64_t waitUs = windowStartUs_ + kUsPerSec - nowUs;
+        if (!sleeper_.wait_for(std::chrono::microseconds(waitUs))) {
+            return false;
+        }
+        windowStartUs_ = TimeUtility::GetTimeofDayUs();
+        windowBytes_ = 0;
+    }
+    windowBytes_ += bytes;
+    return true;
+}
+
+}  // namespace chunkserver
+}  // namespace curve
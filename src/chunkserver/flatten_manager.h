@@ -0,0 +1,191 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_FLATTEN_MANAGER_H_
+#define SRC_CHUNKSERVER_FLATTEN_MANAGER_H_
+
+#include <bvar/bvar.h>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "include/chunkserver/chunkserver_common.h"
+#include "src/chunkserver/clone_manager.h"
+#include "src/chunkserver/copyset_node_manager.h"
+#include "src/chunkserver/qos_scheduler.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/interruptible_sleeper.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::Atomic;
+using ::curve::common::InterruptibleSleeper;
+using ::curve::common::Mutex;
+using ::curve::common::Thread;
+
+struct FlattenManagerOptions {
+    // 是否开启后台flatten
+    bool enable = false;
+    // 两轮flatten之间的间隔
+    uint32_t intervalSec = 60;
+    // 每个recover请求的数据量，和clone.slice_size保持一致
+    uint32_t sliceSize = 1024 * 1024;
+    // 每秒flatten的数据量上限，0表示不限制
+    uint64_t bandwidthBytes = 0;
+    // 客户端读写iops超过该值时认为磁盘不空闲，暂停flatten，0表示不检查
+    uint64_t idleIops = 0;
+    // 单个recover请求的超时时间
+    uint32_t requestTimeoutMs = 30000;
+    CopysetNodeManager* copysetNodeManager = nullptr;
+    CloneManager* cloneManager = nullptr;
+    // 为空时recover请求不经过QoS调度，直接下发
+    QosScheduler* qosScheduler = nullptr;
+};
+
+/**
+ * 克隆源卷的flatten进度
+ */
+struct FlattenProgress {
+    // 还有页面没有从源端拷贝的chunk数量
+    uint64_t cloneChunkNum = 0;
+    // 还没有从源端拷贝的数据量
+    uint64_t remainingBytes = 0;
+};
+
+/**
+ * 后台flatten模块，在磁盘空闲时把克隆chunk中还没有写过的页面从源端拷贝到本地，
+ * 拷贝完成后chunk变为普通chunk，后续读写不再需要判断是否从源端拷贝。
+ *
+ * 只处理本节点为leader的copyset，以recover请求的方式交给CloneManager，
+ * 拷贝的数据通过raft paste到所有副本。每轮开始时统计各克隆源卷的进度，
+ * 通过心跳上报给mds。
+ */
+class FlattenManager {
+ public:
+    FlattenManager();
+    virtual ~FlattenManager();
+
+    /**
+     * @brief 初始化flatten模块
+     * @return 0:成功，非0失败
+     */
+    int Init(const FlattenManagerOptions& options);
+
+    /**
+     * @brief 启动后台flatten线程，没有开启时直接返回成功
+     * @return 0:成功，非0失败
+     */
+    int Run();
+
+    /**
+     * @brief 停止后台flatten线程
+     * @return 0:成功，非0失败
+     */
+    int Fini();
+
+    /**
+     * @brief 执行一轮flatten，统计进度并拷贝所有leader copyset上的克隆chunk
+     */
+    void FlattenOnce();
+
+    /**
+     * @brief 获取上一轮统计的各克隆源卷的flatten进度
+     */
+    std::map<std::string, FlattenProgress> GetProgress();
+
+    /**
+     * @brief 从克隆chunk的location中解析克隆源卷
+     * curve源：${filename}:${offset}@cs，返回filename
+     * s3源：${filename}-${chunkindex}-${seqnum}@s3，返回filename
+     * @return 克隆源卷，location不合法时返回空字符串
+     */
+    static std::string GetCloneSource(const std::string& location);
+
+ protected:
+    /**
+     * @brief 判断磁盘是否空闲，可以在测试中重载
+     */
+    virtual bool IsDiskIdle();
+
+    /**
+     * @brief 把recover请求交给copyset处理，请求完成后调用done，
+     *        可以在测试中重载
+     */
+    virtual void ProcessRecover(const CopysetNodePtr& node,
+                                ChunkRequest* request,
+                                ChunkResponse* response,
+                                google::protobuf::Closure* done);
+
+ private:
+    void FlattenLoop();
+
+    /**
+     * @brief flatten一个copyset中的所有克隆chunk
+     * @return 本轮是否需要停止
+     */
+    bool FlattenCopyset(const CopysetNodePtr& node);
+
+    /**
+     * @brief 通过recover请求拷贝chunk的指定区域，等待请求完成
+     * @return 0:成功，非0失败
+     */
+    int RecoverSlice(const CopysetNodePtr& node, ChunkID chunkId,
+                     uint32_t offset, uint32_t size);
+
+    /**
+     * @brief 等待磁盘空闲以及带宽配额
+     * @param bytes: 即将拷贝的数据量
+     * @return false表示模块已停止
+     */
+    bool Throttle(uint64_t bytes);
+
+    /**
+     * @brief 模块是否已经停止，停止后当前这一轮flatten尽快退出
+     */
+    bool Interrupted();
+
+ private:
+    FlattenManagerOptions options_;
+
+    Mutex mtx_;
+    std::map<std::string, FlattenProgress> progress_;
+
+    // 当前这一秒内已经拷贝的数据量
+    uint64_t windowStartUs_;
+    uint64_t windowBytes_;
+
+    Thread flattenThread_;
+    // false-开始后台任务，true-停止后台任务
+    Atomic<bool> isStop_;
+    InterruptibleSleeper sleeper_;
+
+    // 已经flatten的数据量
+    bvar::Adder<uint64_t> flattenedBytes_;
+    // flatten失败的请求数
+    bvar::Adder<uint64_t> failedRequests_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_FLATTEN_MANAGER_H_
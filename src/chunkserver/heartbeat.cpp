@@ -26,9 +26,11 @@
 #include <brpc/channel.h>
 #include <brpc/controller.h>
 #include <braft/closure_helper.h>
+#include <google/protobuf/util/message_differencer.h>
 
 #include <vector>
 #include <memory>
+#include <utility>
 
 #include "src/fs/fs_common.h"
 #include "src/common/timeutility.h"
@@ -95,6 +97,11 @@ int Heartbeat::Init(const HeartbeatOptions &options) {
 
     // init scanManager
     scanMan_ = options.scanManager;
+
+    hbEpoch_ = 0;
+    ackedEpoch_ = 0;
+    ackedView_.clear();
+    deltaCount_ = 0;
     return 0;
 }
 
@@ -271,6 +278,9 @@ int Heartbeat::BuildRequest(HeartbeatRequest* req) {
     stats->set_chunksizeusedbytes(usedChunkSize+usedWalSegmentSize);
     stats->set_chunksizeleftbytes(leftChunkSize+leftWalSegmentSize);
     stats->set_chunksizetrashedbytes(trashedChunkSize);
+    // 回收站中过期的chunk很快会归还给chunkfilepool，可以被新的chunk使用
+    stats->set_chunksizereclaimablebytes(
+        metric->GetTrashPendingReclaimBytes());
     req->set_allocated_stats(stats);
 
     size_t cap, avail;
@@ -305,9 +315,93 @@ int Heartbeat::BuildRequest(HeartbeatRequest* req) {
     }
     req->set_leadercount(leaders);
 
+    if (options_.flattenManager != nullptr) {
+        for (const auto& item : options_.flattenManager->GetProgress()) {
+            auto info = req->add_flatteninfos();
+            info->set_source(item.first);
+            info->set_clonechunknum(item.second.cloneChunkNum);
+            info->set_remainingbytes(item.second.remainingBytes);
+        }
+    }
+
+    if (options_.hotChunkTracker != nullptr) {
+        for (const auto& item : options_.hotChunkTracker->GetHotChunks()) {
+            auto info = req->add_hotchunks();
+            info->set_fileid(item.fileId);
+            info->set_logicalpoolid(item.logicPoolId);
+            info->set_copysetid(item.copysetId);
+            info->set_chunkid(item.chunkId);
+            info->set_accesscount(item.accessCount);
+            info->set_readcount(item.readCount);
+            info->set_writecount(item.writeCount);
+        }
+    }
+
     return 0;
 }
 
+void Heartbeat::BuildDeltaRequest(HeartbeatRequest* req,
+                                  CopysetView* view) {
+    req->set_hbepoch(++hbEpoch_);
+
+    // 统计信息每次都会变化，不参与比较，由全量心跳定期刷新
+    for (const auto& info : req->copysetinfos()) {
+        auto& reported =
+            (*view)[std::make_pair(info.logicalpoolid(), info.copysetid())];
+        reported = info;
+        reported.clear_stats();
+    }
+
+    // 没有已确认的视图或者达到全量心跳间隔，发送全量心跳
+    if (ackedEpoch_ == 0 || deltaCount_ >= options_.fullHeartbeatInterval) {
+        return;
+    }
+
+    google::protobuf::RepeatedPtrField<curve::mds::heartbeat::CopySetInfo>
+        changed;
+    for (auto& info : *req->mutable_copysetinfos()) {
+        auto key = std::make_pair(info.logicalpoolid(), info.copysetid());
+        auto iter = ackedView_.find(key);
+        if (iter == ackedView_.end() ||
+            !google::protobuf::util::MessageDifferencer::Equals(
+                iter->second, (*view)[key])) {
+            changed.Add()->Swap(&info);
+        }
+    }
+    req->mutable_copysetinfos()->Swap(&changed);
+
+    for (const auto& item : ackedView_) {
+        if (view->count(item.first) == 0) {
+            auto key = req->add_removedcopysets();
+            key->set_logicalpoolid(item.first.first);
+            key->set_copysetid(item.first.second);
+        }
+    }
+
+    req->set_baseepoch(ackedEpoch_);
+}
+
+void Heartbeat::UpdateAckedView(const HeartbeatRequest& req,
+                                const HeartbeatResponse& resp,
+                                CopysetView* view) {
+    // mds没有缓存本次的视图（旧版本mds或者增量心跳的基准不一致），
+    // 下次发送全量心跳
+    if (!resp.has_hbepoch() || resp.hbepoch() != req.hbepoch()) {
+        if (req.has_baseepoch()) {
+            LOG(INFO) << "MDS did not accept delta heartbeat based on epoch "
+                      << req.baseepoch() << ", send full heartbeat next time";
+        }
+        ackedEpoch_ = 0;
+        ackedView_.clear();
+        deltaCount_ = 0;
+        return;
+    }
+
+    ackedEpoch_ = req.hbepoch();
+    ackedView_.swap(*view);
+    deltaCount_ = req.has_baseepoch() ? deltaCount_ + 1 : 0;
+}
+
 void Heartbeat::DumpHeartbeatRequest(const HeartbeatRequest& request) {
     DVLOG(6) << "Heartbeat request: Chunkserver ID: "
              << request.chunkserverid()
@@ -409,6 +503,10 @@ int Heartbeat::SendHeartbeat(const HeartbeatRequest& request,
 }
 
 int Heartbeat::ExecTask(const HeartbeatResponse& response) {
+    if (response.has_qosconf() && nullptr != options_.qosScheduler) {
+        UpdateQosConf(response.qosconf());
+    }
+
     int count = response.needupdatecopysets_size();
     for (int i = 0; i < count; i ++) {
         CopySetConf conf = response.needupdatecopysets(i);
@@ -561,6 +659,28 @@ int Heartbeat::ExecTask(const HeartbeatResponse& response) {
     return 0;
 }
 
+void Heartbeat::UpdateQosConf(const QosConf& conf) {
+    auto toSpec = [](const curve::mds::heartbeat::QosSpec& spec) {
+        QosSpec result;
+        result.reservation = spec.reservation();
+        result.limit = spec.limit();
+        result.weight = spec.has_weight() ? spec.weight() : 1;
+        return result;
+    };
+
+    QosSpec classSpecs[kIOClassNum];
+    for (const auto& classSpec : conf.classspecs()) {
+        int cls = static_cast<int>(classSpec.ioclass());
+        if (cls < 0 || cls >= kIOClassNum) {
+            LOG(WARNING) << "Unknown qos class: " << cls;
+            continue;
+        }
+        classSpecs[cls] = toSpec(classSpec.spec());
+    }
+    QosSpec volumeSpec = toSpec(conf.volumespec());
+    options_.qosScheduler->UpdateSpecs(classSpecs, volumeSpec);
+}
+
 void Heartbeat::HeartbeatWorker() {
     int ret;
     int errorIntervalSec = 2;
@@ -586,6 +706,11 @@ void Heartbeat::HeartbeatWorker() {
             continue;
         }
 
+        CopysetView view;
+        if (options_.enableDeltaHeartbeat) {
+            BuildDeltaRequest(&req, &view);
+        }
+
         LOG(INFO) << "sending heartbeat info";
         ret = SendHeartbeat(req, &resp);
         if (ret != 0) {
@@ -594,6 +719,10 @@ void Heartbeat::HeartbeatWorker() {
             continue;
         }
 
+        if (options_.enableDeltaHeartbeat) {
+            UpdateAckedView(req, resp, &view);
+        }
+
         LOG(INFO) << "executing heartbeat info";
         ret = ExecTask(resp);
         if (ret != 0) {
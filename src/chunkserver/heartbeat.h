@@ -39,6 +39,9 @@
 #include "src/common/wait_interval.h"
 #include "src/common/concurrent/concurrent.h"
 #include "src/chunkserver/scan_manager.h"
+#include "src/chunkserver/qos_scheduler.h"
+#include "src/chunkserver/flatten_manager.h"
+#include "src/chunkserver/hot_chunk_tracker.h"
 #include "proto/heartbeat.pb.h"
 #include "proto/scan.pb.h"
 
@@ -52,8 +55,12 @@ using HeartbeatResponse = curve::mds::heartbeat::ChunkServerHeartbeatResponse;
 using ConfigChangeInfo  = curve::mds::heartbeat::ConfigChangeInfo;
 using CopySetConf       = curve::mds::heartbeat::CopySetConf;
 using CandidateError    = curve::mds::heartbeat::CandidateError;
+using QosConf           = curve::mds::heartbeat::QosConf;
 using TaskStatus        = butil::Status;
 using CopysetNodePtr    = std::shared_ptr<CopysetNode>;
+// 心跳上报的copyset信息，不包括统计信息
+using CopysetView       = std::map<std::pair<LogicPoolID, CopysetID>,
+                                   curve::mds::heartbeat::CopySetInfo>;
 
 /**
  * 心跳子系统选项
@@ -69,9 +76,20 @@ struct HeartbeatOptions {
     uint32_t                timeout;
     CopysetNodeManager*     copysetNodeManager;
     ScanManager*            scanManager;
+    // 为空时忽略mds下发的QoS参数
+    QosScheduler*           qosScheduler = nullptr;
+    // 为空时不上报克隆chunk的flatten进度
+    FlattenManager*         flattenManager = nullptr;
+    // 为空时不上报热点chunk
+    HotChunkTracker*        hotChunkTracker = nullptr;
 
     std::shared_ptr<LocalFileSystem> fs;
     std::shared_ptr<FilePool> chunkFilePool;
+
+    // 是否发送增量心跳，增量心跳只上报相对于mds已确认视图有变化的copyset
+    bool                    enableDeltaHeartbeat = false;
+    // 连续发送多少次增量心跳后发送一次全量心跳
+    uint32_t                fullHeartbeatInterval = 6;
 };
 
 /**
@@ -129,6 +147,20 @@ class Heartbeat {
      */
     int BuildRequest(HeartbeatRequest* request);
 
+    /*
+     * 将全量心跳请求转换为增量心跳请求
+     * @param[in,out] request 全量心跳请求，发送增量心跳时只保留变化的copyset
+     * @param[out] view 本次心跳对应的copyset视图
+     */
+    void BuildDeltaRequest(HeartbeatRequest* request, CopysetView* view);
+
+    /*
+     * 根据mds的回应更新已确认的copyset视图
+     */
+    void UpdateAckedView(const HeartbeatRequest& request,
+                         const HeartbeatResponse& response,
+                         CopysetView* view);
+
     /*
      * 发送心跳消息
      */
@@ -155,6 +187,11 @@ class Heartbeat {
      */
     TaskStatus PurgeCopyset(LogicPoolID poolId, CopysetID copysetId);
 
+    /*
+     * 更新I/O调度器的QoS参数
+     */
+    void UpdateQosConf(const QosConf& conf);
+
  private:
     // 心跳线程
     Thread hbThread_;
@@ -187,6 +224,16 @@ class Heartbeat {
     uint64_t startUpTime_;
 
     ScanManager *scanMan_;
+
+    // 心跳视图序号，每次心跳递增
+    uint64_t hbEpoch_;
+
+    // mds已确认的copyset视图及其序号，序号为0表示没有已确认的视图
+    uint64_t ackedEpoch_;
+    CopysetView ackedView_;
+
+    // 上次全量心跳之后发送的增量心跳次数
+    uint32_t deltaCount_;
 };
 
 }  // namespace chunkserver
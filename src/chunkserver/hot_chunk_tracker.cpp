@@ -0,0 +1,292 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/chunkserver/hot_chunk_tracker.h"
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::LockGuard;
+using curve::common::TimeUtility;
+
+namespace {
+
+// top-K的分片数，分散更新热点chunk时的锁竞争
+const uint32_t kShardNum = 16;
+
+// splitmix64的混淆函数，不同的行使用不同的种子
+uint64_t Mix(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// 不同逻辑池的chunk id可能相同
+uint64_t ChunkKey(LogicPoolID logicPoolId, ChunkID chunkId) {
+    return Mix(chunkId) ^ logicPoolId;
+}
+
+}  // namespace
+
+HotChunkTracker::HotChunkTracker()
+    : lastDecayUs_(0) {}
+
+int HotChunkTracker::Init(const HotChunkTrackerOptions& options) {
+    options_ = options;
+    if (!options_.enable) {
+        LOG(INFO) << "Hot chunk tracker is disabled.";
+        return 0;
+    }
+    if (options_.sketchWidth == 0 || options_.sketchDepth == 0 ||
+        options_.topK == 0) {
+        LOG(ERROR) << "Invalid hot chunk tracker option, sketch width: "
+                   << options_.sketchWidth
+                   << ", sketch depth: " << options_.sketchDepth
+                   << ", top k: " << options_.topK;
+        return -1;
+    }
+
+    size_t size = static_cast<size_t>(options_.sketchWidth) *
+                  options_.sketchDepth;
+    counters_.reset(new std::atomic<uint32_t>[size]);
+    for (size_t i = 0; i < size; ++i) {
+        counters_[i].store(0, std::memory_order_relaxed);
+    }
+    shards_.reset(new Shard[kShardNum]);
+    for (uint32_t i = 0; i < kShardNum; ++i) {
+        shards_[i].topK.reserve(options_.topK);
+    }
+    lastDecayUs_.store(TimeUtility::GetTimeofDayUs());
+
+    hotChunksMetric_.reset(new bvar::PassiveStatus<std::string>(
+        "chunkserver_hot_chunks",
+        [](void* arg) {
+            return static_cast<HotChunkTracker*>(arg)->DumpHotChunks();
+        },
+        this));
+
+    LOG(INFO) << "Init hot chunk tracker, sketch width: "
+              << options_.sketchWidth
+              << ", sketch depth: " << options_.sketchDepth
+              << ", top k: " << options_.topK;
+    return 0;
+}
+
+void HotChunkTracker::Record(uint64_t fileId, LogicPoolID logicPoolId,
+                             CopysetID copysetId, ChunkID chunkId,
+                             bool isRead) {
+    if (!options_.enable) {
+        return;
+    }
+
+    MaybeDecay();
+    uint64_t key = ChunkKey(logicPoolId, chunkId);
+    uint64_t estimate = Increase(key);
+    Shard* shard = &shards_[key % kShardNum];
+    if (estimate < shard->minCount.load(std::memory_order_relaxed)) {
+        return;
+    }
+    UpdateTopK(shard, key, fileId, logicPoolId, copysetId, chunkId, isRead,
+               estimate);
+}
+
+std::vector<HotChunkInfo> HotChunkTracker::GetHotChunks() {
+    std::vector<HotChunkInfo> hotChunks;
+    if (!options_.enable) {
+        return hotChunks;
+    }
+
+    // 全局的top-K一定在各个分片的top-K中
+    for (uint32_t i = 0; i < kShardNum; ++i) {
+        LockGuard lk(shards_[i].mtx);
+        for (const auto& item : shards_[i].topK) {
+            hotChunks.push_back(item.second);
+        }
+    }
+    std::sort(hotChunks.begin(), hotChunks.end(),
+              [](const HotChunkInfo& a, const HotChunkInfo& b) {
+                  return a.accessCount > b.accessCount;
+              });
+    if (hotChunks.size() > options_.topK) {
+        hotChunks.resize(options_.topK);
+    }
+    return hotChunks;
+}
+
+uint64_t HotChunkTracker::Estimate(LogicPoolID logicPoolId, ChunkID chunkId) {
+    if (!options_.enable) {
+        return 0;
+    }
+
+    uint64_t key = ChunkKey(logicPoolId, chunkId);
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (uint32_t row = 0; row < options_.sketchDepth; ++row) {
+        uint64_t value = counters_[Hash(key, row)].load(
+            std::memory_order_relaxed);
+        estimate = std::min(estimate, value);
+    }
+    return estimate;
+}
+
+void HotChunkTracker::Decay() {
+    if (!options_.enable) {
+        return;
+    }
+
+    // 和Record并发时可能丢失少量计数，对热度统计没有影响
+    size_t size = static_cast<size_t>(options_.sketchWidth) *
+                  options_.sketchDepth;
+    for (size_t i = 0; i < size; ++i) {
+        counters_[i].store(counters_[i].load(std::memory_order_relaxed) / 2,
+                           std::memory_order_relaxed);
+    }
+
+    for (uint32_t i = 0; i < kShardNum; ++i) {
+        Shard* shard = &shards_[i];
+        LockGuard lk(shard->mtx);
+        for (auto it = shard->topK.begin(); it != shard->topK.end();) {
+            HotChunkInfo& info = it->second;
+            info.accessCount /= 2;
+            info.readCount /= 2;
+            info.writeCount /= 2;
+            if (info.accessCount == 0) {
+                it = shard->topK.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        UpdateMinCountLocked(shard);
+    }
+}
+
+uint64_t HotChunkTracker::Hash(uint64_t key, uint32_t row) const {
+    uint64_t hash = Mix(key + row * 0x9E3779B97F4A7C15ULL);
+    return static_cast<uint64_t>(row) * options_.sketchWidth +
+           hash % options_.sketchWidth;
+}
+
+uint64_t HotChunkTracker::Increase(uint64_t key) {
+    uint64_t estimate = std::numeric_limits<uint64_t>::max();
+    for (uint32_t row = 0; row < options_.sketchDepth; ++row) {
+        uint64_t value = counters_[Hash(key, row)].fetch_add(
+            1, std::memory_order_relaxed) + 1;
+        estimate = std::min(estimate, value);
+    }
+    return estimate;
+}
+
+void HotChunkTracker::MaybeDecay() {
+    if (options_.decayIntervalSec == 0) {
+        return;
+    }
+
+    uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+    uint64_t lastUs = lastDecayUs_.load(std::memory_order_relaxed);
+    if (nowUs < lastUs + options_.decayIntervalSec * 1000000ULL) {
+        return;
+    }
+    // 只有一个线程执行衰减
+    if (lastDecayUs_.compare_exchange_strong(lastUs, nowUs)) {
+        Decay();
+    }
+}
+
+void HotChunkTracker::UpdateTopK(Shard* shard, uint64_t key,
+                                 uint64_t fileId, LogicPoolID logicPoolId,
+                                 CopysetID copysetId, ChunkID chunkId,
+                                 bool isRead, uint64_t estimate) {
+    LockGuard lk(shard->mtx);
+    auto it = shard->topK.find(key);
+    bool updateMin = false;
+    if (it == shard->topK.end()) {
+        // 新的chunk进入top-K，替换掉访问次数最少的chunk
+        if (shard->topK.size() >= options_.topK) {
+            auto minIt = std::min_element(
+                shard->topK.begin(), shard->topK.end(),
+                [](const std::pair<const uint64_t, HotChunkInfo>& a,
+                   const std::pair<const uint64_t, HotChunkInfo>& b) {
+                    return a.second.accessCount < b.second.accessCount;
+                });
+            if (estimate <= minIt->second.accessCount) {
+                return;
+            }
+            shard->topK.erase(minIt);
+        }
+        it = shard->topK.emplace(key, HotChunkInfo()).first;
+        it->second.logicPoolId = logicPoolId;
+        it->second.chunkId = chunkId;
+        updateMin = true;
+    } else {
+        // 只有最小的chunk的访问次数变化时，最小值才可能变化
+        updateMin = it->second.accessCount <=
+                    shard->minCount.load(std::memory_order_relaxed);
+    }
+
+    HotChunkInfo& info = it->second;
+    info.fileId = fileId;
+    info.copysetId = copysetId;
+    info.accessCount = std::max(info.accessCount, estimate);
+    if (isRead) {
+        info.readCount++;
+    } else {
+        info.writeCount++;
+    }
+    if (updateMin) {
+        UpdateMinCountLocked(shard);
+    }
+}
+
+void HotChunkTracker::UpdateMinCountLocked(Shard* shard) {
+    uint64_t minCount = 0;
+    if (shard->topK.size() >= options_.topK) {
+        minCount = std::numeric_limits<uint64_t>::max();
+        for (const auto& item : shard->topK) {
+            minCount = std::min(minCount, item.second.accessCount);
+        }
+    }
+    shard->minCount.store(minCount, std::memory_order_relaxed);
+}
+
+std::string HotChunkTracker::DumpHotChunks() {
+    std::ostringstream oss;
+    for (const auto& info : GetHotChunks()) {
+        oss << "file: " << info.fileId
+            << ", copyset: " << ToGroupIdString(info.logicPoolId,
+                                                info.copysetId)
+            << ", chunk: " << info.chunkId
+            << ", access: " << info.accessCount
+            << ", read: " << info.readCount
+            << ", write: " << info.writeCount << "\n";
+    }
+    return oss.str();
+}
+
+}  // namespace chunkserver
+}  // namespace curve
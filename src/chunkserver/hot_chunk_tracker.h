@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_HOT_CHUNK_TRACKER_H_
+#define SRC_CHUNKSERVER_HOT_CHUNK_TRACKER_H_
+
+#include <bvar/bvar.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "include/chunkserver/chunkserver_common.h"
+#include "src/common/concurrent/concurrent.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::curve::common::Mutex;
+
+struct HotChunkTrackerOptions {
+    // 是否统计chunk的访问热度
+    bool enable = true;
+    // count-min sketch每行的计数器个数
+    uint32_t sketchWidth = 4096;
+    // count-min sketch的行数，即hash函数的个数
+    uint32_t sketchDepth = 4;
+    // 记录访问次数最多的chunk的个数
+    uint32_t topK = 32;
+    // 每隔decayIntervalSec所有计数减半，使热度反映最近的访问
+    uint32_t decayIntervalSec = 60;
+};
+
+/**
+ * 一个热点chunk的访问统计
+ */
+struct HotChunkInfo {
+    // chunk所属的卷
+    uint64_t fileId = 0;
+    LogicPoolID logicPoolId = 0;
+    CopysetID copysetId = 0;
+    ChunkID chunkId = 0;
+    // sketch估计的衰减后的访问次数
+    uint64_t accessCount = 0;
+    // 进入top-K之后统计的读写次数
+    uint64_t readCount = 0;
+    uint64_t writeCount = 0;
+};
+
+/**
+ * 统计chunk的访问热度。所有chunk的访问次数记录在count-min sketch中，
+ * 计数器都是原子变量，记录一次访问只需要sketchDepth次原子加。
+ * top-K按chunk分到多个分片中，每个分片各自记录top-K，用hash表索引，
+ * 估计值不小于分片中最小值的chunk才会加分片的锁，更新已经在top-K中的chunk
+ * 是O(1)的；GetHotChunks时再合并各个分片，得到全局的top-K。
+ * 每隔decayIntervalSec，sketch和top-K中的计数都减半。
+ */
+class HotChunkTracker {
+ public:
+    HotChunkTracker();
+    ~HotChunkTracker() = default;
+
+    /**
+     * @brief 初始化，并暴露top-K的bvar
+     * @return 0:成功，非0失败
+     */
+    int Init(const HotChunkTrackerOptions& options);
+
+    /**
+     * @brief 记录一次chunk访问
+     * @param fileId: chunk所属的卷
+     * @param isRead: 是否是读请求
+     */
+    void Record(uint64_t fileId, LogicPoolID logicPoolId,
+                CopysetID copysetId, ChunkID chunkId, bool isRead);
+
+    /**
+     * @brief 获取当前访问次数最多的chunk，按访问次数从大到小排列
+     */
+    std::vector<HotChunkInfo> GetHotChunks();
+
+    /**
+     * @brief 估计chunk衰减后的访问次数
+     */
+    uint64_t Estimate(LogicPoolID logicPoolId, ChunkID chunkId);
+
+    /**
+     * @brief 所有计数减半，Record中会按decayIntervalSec自动调用
+     */
+    void Decay();
+
+ private:
+    uint64_t Hash(uint64_t key, uint32_t row) const;
+
+    /**
+     * @brief 把访问记到sketch中，返回更新后的估计值
+     */
+    uint64_t Increase(uint64_t key);
+
+    void MaybeDecay();
+
+    struct Shard {
+        Mutex mtx;
+        // 分片的top-K，key是chunk的hash
+        std::unordered_map<uint64_t, HotChunkInfo> topK;
+        // 分片的top-K中最小的访问次数，估计值小于它的chunk不需要加锁
+        std::atomic<uint64_t> minCount{0};
+    };
+
+    void UpdateTopK(Shard* shard, uint64_t key, uint64_t fileId,
+                    LogicPoolID logicPoolId, CopysetID copysetId,
+                    ChunkID chunkId, bool isRead, uint64_t estimate);
+
+    /**
+     * @brief 重新计算分片top-K中的最小访问次数，top-K未满时为0
+     */
+    void UpdateMinCountLocked(Shard* shard);
+
+    std::string DumpHotChunks();
+
+ private:
+    HotChunkTrackerOptions options_;
+
+    // sketchDepth * sketchWidth个计数器
+    std::unique_ptr<std::atomic<uint32_t>[]> counters_;
+
+    std::unique_ptr<Shard[]> shards_;
+
+    std::atomic<uint64_t> lastDecayUs_;
+
+    // 以文本形式暴露top-K
+    std::unique_ptr<bvar::PassiveStatus<std::string>> hotChunksMetric_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_HOT_CHUNK_TRACKER_H_
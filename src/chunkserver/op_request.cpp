@@ -245,12 +245,19 @@ void ReadChunkRequest::Process() {
         return;
     }
 
+    braft::LeaderLeaseStatus leaseStatus;
+    node_->GetLeaderLeaseStatus(&leaseStatus);
+
     /**
-     * 如果携带了applied index，且小于当前copyset node
-     * 的最新applied index，或者 op类型为CHUNK_OP_RECOVER
-     * 那么不需要走一致性协议
+     * 满足以下任一条件不需要走一致性协议：
+     * 1. lease有效，lease期间不会有其他leader，本地数据就是最新的
+     * 2. 携带了applied index，且小于当前copyset node的最新applied index
+     * 3. op类型为CHUNK_OP_RECOVER
+     * lease还没有生效(例如刚切换完leader，旧leader的lease还没有过期)
+     * 并且没有携带applied index时，仍然走raft一致性协议read
      */
-    if ((request_->has_appliedindex()
+    if (node_->IsLeaseLeader(leaseStatus)
+        || (request_->has_appliedindex()
         && node_->GetAppliedIndex() >= request_->appliedindex())
         || request_->optype() == CHUNK_OP_TYPE::CHUNK_OP_RECOVER) {
         /**
@@ -288,6 +295,15 @@ void ReadChunkRequest::Process() {
         return;
     }
 
+    /**
+     * lease过期说明leader已经和多数节点失联，可能已经选出了新的leader，
+     * propose也无法提交，直接让client重定向
+     */
+    if (node_->IsLeaseExpired(leaseStatus)) {
+        RedirectChunkRequest();
+        return;
+    }
+
     /**
      * 如果没有携带applied index，那么走raft一致性协议read
      */
@@ -97,6 +97,15 @@ uint32_t GetChunkTrashedFunc(void* arg) {
     return chunkTrashed;
 }
 
+uint64_t GetTrashPendingReclaimBytesFunc(void* arg) {
+    Trash* trash = reinterpret_cast<Trash*>(arg);
+    uint64_t pendingBytes = 0;
+    if (trash != nullptr) {
+        pendingBytes = trash->GetPendingReclaimBytes();
+    }
+    return pendingBytes;
+}
+
 uint32_t GetTotalChunkCountFunc(void* arg) {
     uint32_t chunkCount = 0;
     ChunkServerMetric* csMetric = reinterpret_cast<ChunkServerMetric*>(arg);
@@ -87,6 +87,11 @@ namespace chunkserver {
      * @param arg: trash的对象指针
      */
     uint32_t GetChunkTrashedFunc(void* arg);
+    /**
+     * 获取trash中待归还给chunkfilepool的空间
+     * @param arg: trash的对象指针
+     */
+    uint64_t GetTrashPendingReclaimBytesFunc(void* arg);
 
 }  // namespace chunkserver
 }  // namespace curve
@@ -0,0 +1,454 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/chunkserver/qos_scheduler.h"
+
+#include <bthread/bthread.h>
+#include <bthread/countdown_event.h>
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <iterator>
+#include <limits>
+
+#include "src/common/timeutility.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::LockGuard;
+using curve::common::UniqueLock;
+using curve::common::TimeUtility;
+
+namespace {
+
+const double kInfTag = std::numeric_limits<double>::max();
+const uint64_t kUsPerSec = 1000000;
+const uint64_t kGcIntervalUs = kUsPerSec;
+const uint64_t kDefaultWaitUs = 1000;
+
+// 开销为cost的请求在速率rate下需要占用的时间，单位us
+double TagInterval(double cost, uint64_t rate) {
+    return cost * kUsPerSec / rate;
+}
+
+}  // namespace
+
+const char* IOClassName(IOClass cls) {
+    switch (cls) {
+        case IOClass::CLIENT:
+            return "client";
+        case IOClass::RECOVERY:
+            return "recovery";
+        case IOClass::SCAN:
+            return "scan";
+        case IOClass::CLONE:
+            return "clone";
+        default:
+            return "unknown";
+    }
+}
+
+QosScheduler::QosScheduler()
+    : outstanding_(0),
+      queued_(0),
+      runningTasks_(0),
+      lastGcUs_(0),
+      running_(false) {}
+
+QosScheduler::~QosScheduler() {
+    Fini();
+}
+
+int QosScheduler::Init(const QosSchedulerOptions& options) {
+    options_ = options;
+    if (options_.maxOutstanding == 0) {
+        LOG(ERROR) << "Invalid qos scheduler option, maxOutstanding is 0";
+        return -1;
+    }
+    if (options_.costUnitBytes == 0) {
+        options_.costUnitBytes = 1;
+    }
+    clientTags_.spec = options_.classSpecs[static_cast<int>(IOClass::CLIENT)];
+    ExposeMetrics();
+    LOG(INFO) << "Init qos scheduler, enable: " << options_.enable
+              << ", max outstanding: " << options_.maxOutstanding;
+    return 0;
+}
+
+int QosScheduler::Run() {
+    if (!options_.enable) {
+        return 0;
+    }
+    running_.store(true, std::memory_order_release);
+    dispatcher_ = Thread(&QosScheduler::DispatchLoop, this);
+    LOG(INFO) << "Qos scheduler started.";
+    return 0;
+}
+
+int QosScheduler::Fini() {
+    if (!running_.exchange(false)) {
+        return 0;
+    }
+    {
+        LockGuard lk(mtx_);
+        cond_.notify_all();
+    }
+    dispatcher_.join();
+
+    // 剩下的请求直接下发，保证每个请求都会被处理
+    std::deque<Request> remains;
+    {
+        UniqueLock lk(mtx_);
+        // 等待已经在bthread中开始执行的task返回
+        cond_.wait(lk, [this]() { return runningTasks_ == 0; });
+        for (auto& item : queues_) {
+            auto& requests = item.second.requests;
+            metrics_[item.first.first].queueDepth << -static_cast<int64_t>(
+                requests.size());
+            std::move(requests.begin(), requests.end(),
+                      std::back_inserter(remains));
+            requests.clear();
+        }
+        queued_ = 0;
+    }
+    for (auto& request : remains) {
+        request.task(false);
+    }
+    LOG(INFO) << "Qos scheduler stopped.";
+    return 0;
+}
+
+void QosScheduler::Submit(IOClass cls, uint64_t volume, uint64_t bytes,
+                          Task task) {
+    if (!running_.load(std::memory_order_acquire)) {
+        task(false);
+        return;
+    }
+
+    // 只有客户端流量按卷区分队列
+    if (cls != IOClass::CLIENT) {
+        volume = 0;
+    }
+    uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+    double cost = std::max<uint64_t>(
+        1, (bytes + options_.costUnitBytes - 1) / options_.costUnitBytes);
+
+    UniqueLock lk(mtx_);
+    // Fini在停止调度线程之后加锁取走剩下的请求，加锁后再检查一次，
+    // 避免请求在Fini之后入队而永远不被下发
+    if (!running_.load(std::memory_order_acquire)) {
+        lk.unlock();
+        task(false);
+        return;
+    }
+    QueueKey key(static_cast<int>(cls), volume);
+    auto it = queues_.find(key);
+    if (it == queues_.end()) {
+        it = queues_.emplace(key, Queue()).first;
+        it->second.spec = SpecLocked(cls);
+    }
+    Queue& queue = it->second;
+
+    // 队列从空闲变为活跃时，P tag不能落后于其它活跃队列，否则它会一直
+    // 优先于其它队列，直到追上为止
+    if (queue.requests.empty()) {
+        double minPTag = kInfTag;
+        for (auto& item : queues_) {
+            if (!item.second.requests.empty()) {
+                minPTag = std::min(minPTag, item.second.pTag);
+            }
+        }
+        if (minPTag != kInfTag) {
+            queue.pTag = std::max(queue.pTag, minPTag);
+        }
+    }
+
+    queue.requests.push_back(Request{std::move(task), cost, nowUs});
+    queue.lastActiveUs = nowUs;
+    ++queued_;
+    metrics_[key.first].queueDepth << 1;
+    cond_.notify_all();
+}
+
+void QosScheduler::OnComplete(IOClass cls, uint64_t latencyUs) {
+    metrics_[static_cast<int>(cls)].latency << latencyUs;
+    if (!options_.enable) {
+        return;
+    }
+
+    LockGuard lk(mtx_);
+    if (outstanding_ > 0) {
+        --outstanding_;
+    }
+    cond_.notify_all();
+}
+
+void QosScheduler::UpdateSpecs(const QosSpec (&classSpecs)[kIOClassNum],
+                               const QosSpec& volumeSpec) {
+    LockGuard lk(mtx_);
+    for (int i = 0; i < kIOClassNum; ++i) {
+        options_.classSpecs[i] = classSpecs[i];
+    }
+    options_.volumeSpec = volumeSpec;
+    clientTags_.spec = options_.classSpecs[static_cast<int>(IOClass::CLIENT)];
+    for (auto& item : queues_) {
+        item.second.spec = SpecLocked(static_cast<IOClass>(item.first.first));
+    }
+    cond_.notify_all();
+}
+
+uint32_t QosScheduler::GetOutstanding() {
+    LockGuard lk(mtx_);
+    return outstanding_;
+}
+
+void QosScheduler::DispatchLoop() {
+    UniqueLock lk(mtx_);
+    while (running_.load(std::memory_order_acquire)) {
+        if (queued_ == 0 || outstanding_ >= options_.maxOutstanding) {
+            cond_.wait(lk);
+            continue;
+        }
+
+        uint64_t nowUs = TimeUtility::GetTimeofDayUs();
+        RemoveIdleQueuesLocked(nowUs);
+
+        uint64_t waitUs = kDefaultWaitUs;
+        bool byReservation = false;
+        auto it = PickLocked(nowUs, &waitUs, &byReservation);
+        if (it == queues_.end()) {
+            // 所有队列都超过了limit，等到最早的tag到期或者有新的请求
+            cond_.wait_for(lk, std::chrono::microseconds(waitUs));
+            continue;
+        }
+
+        int cls = it->first.first;
+        Request request = PopLocked(static_cast<IOClass>(cls), &it->second,
+                                    nowUs, byReservation);
+        ++outstanding_;
+        --queued_;
+        metrics_[cls].queueDepth << -1;
+        metrics_[cls].queueLatency << nowUs - std::min(nowUs,
+                                                       request.arrivalUs);
+
+        ++runningTasks_;
+
+        // 在bthread中执行task，调度线程只负责选择请求
+        lk.unlock();
+        auto arg = new std::pair<QosScheduler*, Task>(
+            this, std::move(request.task));
+        bthread_t tid;
+        if (bthread_start_background(&tid, nullptr, RunScheduledTask,
+                                     arg) != 0) {
+            LOG(ERROR) << "Start bthread for qos task failed, run it in "
+                       << "dispatcher thread";
+            RunScheduledTask(arg);
+        }
+        lk.lock();
+    }
+}
+
+void* QosScheduler::RunScheduledTask(void* arg) {
+    std::unique_ptr<std::pair<QosScheduler*, Task>> task(
+        static_cast<std::pair<QosScheduler*, Task>*>(arg));
+    QosScheduler* scheduler = task->first;
+    task->second(true);
+
+    LockGuard lk(scheduler->mtx_);
+    if (--scheduler->runningTasks_ == 0) {
+        scheduler->cond_.notify_all();
+    }
+    return nullptr;
+}
+
+void QosScheduler::TagsLocked(const Queue& tags, const Request& request,
+                              double* rTag, double* lTag, double* pTag) {
+    double arrival = request.arrivalUs;
+    const QosSpec& spec = tags.spec;
+
+    *rTag = spec.reservation == 0 ? kInfTag : std::max(
+        tags.rTag + TagInterval(request.cost, spec.reservation), arrival);
+    *lTag = spec.limit == 0 ? arrival : std::max(
+        tags.lTag + TagInterval(request.cost, spec.limit), arrival);
+    *pTag = std::max(tags.pTag + TagInterval(
+        request.cost, std::max<uint32_t>(spec.weight, 1)), arrival);
+}
+
+void QosScheduler::HeadTagsLocked(const Queue& queue, double* rTag,
+                                  double* lTag, double* pTag) {
+    TagsLocked(queue, queue.requests.front(), rTag, lTag, pTag);
+}
+
+std::map<QosScheduler::QueueKey, QosScheduler::Queue>::iterator
+QosScheduler::PickLocked(uint64_t nowUs, uint64_t* waitUs,
+                         bool* byReservation) {
+    double now = nowUs;
+    auto minR = queues_.end();
+    auto minP = queues_.end();
+    double minRTag = kInfTag;
+    double minPTag = kInfTag;
+    double nextTag = kInfTag;
+    // 客户端流量整体的R到期时下发的卷
+    auto clientR = queues_.end();
+    double clientRTag = kInfTag;
+    double clientPTag = kInfTag;
+
+    for (auto it = queues_.begin(); it != queues_.end(); ++it) {
+        if (it->second.requests.empty()) {
+            continue;
+        }
+        double rTag, lTag, pTag;
+        HeadTagsLocked(it->second, &rTag, &lTag, &pTag);
+        if (rTag <= now && rTag < minRTag) {
+            minR = it;
+            minRTag = rTag;
+        }
+        if (it->first.first == static_cast<int>(IOClass::CLIENT)) {
+            double classRTag, classLTag, classPTag;
+            TagsLocked(clientTags_, it->second.requests.front(), &classRTag,
+                       &classLTag, &classPTag);
+            if (classRTag <= now && lTag <= now && pTag < clientPTag) {
+                clientR = it;
+                clientRTag = classRTag;
+                clientPTag = pTag;
+            } else if (classRTag > now) {
+                nextTag = std::min(nextTag, classRTag);
+            }
+            // 客户端流量整体超过limit时不能按权重下发
+            if (classLTag > now) {
+                nextTag = std::min(nextTag, classLTag);
+                lTag = std::max(lTag, classLTag);
+            }
+        }
+        if (lTag <= now) {
+            if (pTag < minPTag) {
+                minP = it;
+                minPTag = pTag;
+            }
+        } else {
+            nextTag = std::min(nextTag, lTag);
+        }
+        if (rTag > now) {
+            nextTag = std::min(nextTag, rTag);
+        }
+    }
+
+    if (clientR != queues_.end() && clientRTag < minRTag) {
+        minR = clientR;
+        minRTag = clientRTag;
+    }
+
+    // 先满足保留的能力，再按权重分配剩余能力
+    if (minR != queues_.end()) {
+        *byReservation = true;
+        return minR;
+    }
+    *byReservation = false;
+    if (minP == queues_.end() && nextTag != kInfTag) {
+        *waitUs = std::max<uint64_t>(1, nextTag - now);
+    }
+    return minP;
+}
+
+QosScheduler::Request QosScheduler::PopLocked(IOClass cls, Queue* queue,
+                                              uint64_t nowUs,
+                                              bool byReservation) {
+    double now = nowUs;
+    double rTag, lTag, pTag;
+    HeadTagsLocked(*queue, &rTag, &lTag, &pTag);
+    if (cls == IOClass::CLIENT) {
+        double classRTag, classLTag, classPTag;
+        TagsLocked(clientTags_, queue->requests.front(), &classRTag,
+                   &classLTag, &classPTag);
+        // 卷自己的R没有到期，是为了满足客户端流量整体的保留能力而下发
+        if (byReservation && rTag > now) {
+            clientTags_.rTag = classRTag;
+        }
+        clientTags_.lTag = classLTag;
+    }
+    // 按权重下发的请求不计入保留的能力
+    if (byReservation && rTag <= now) {
+        queue->rTag = rTag;
+    }
+    queue->lTag = lTag;
+    queue->pTag = pTag;
+
+    Request request = std::move(queue->requests.front());
+    queue->requests.pop_front();
+    return request;
+}
+
+void QosScheduler::RemoveIdleQueuesLocked(uint64_t nowUs) {
+    if (nowUs < lastGcUs_ + kGcIntervalUs) {
+        return;
+    }
+    lastGcUs_ = nowUs;
+
+    uint64_t timeoutUs = options_.idleQueueTimeoutSec * kUsPerSec;
+    for (auto it = queues_.begin(); it != queues_.end();) {
+        const Queue& queue = it->second;
+        if (it->first.first == static_cast<int>(IOClass::CLIENT) &&
+            queue.requests.empty() &&
+            queue.lastActiveUs + timeoutUs < nowUs) {
+            it = queues_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+const QosSpec& QosScheduler::SpecLocked(IOClass cls) const {
+    if (cls == IOClass::CLIENT) {
+        return options_.volumeSpec;
+    }
+    return options_.classSpecs[static_cast<int>(cls)];
+}
+
+void QosScheduler::ExposeMetrics() {
+    for (int i = 0; i < kIOClassNum; ++i) {
+        std::string prefix = std::string("chunkserver_qos_") +
+                             IOClassName(static_cast<IOClass>(i));
+        metrics_[i].latency.expose(prefix);
+        metrics_[i].queueLatency.expose(prefix + "_queue");
+        metrics_[i].queueDepth.expose(prefix + "_queue_depth");
+    }
+}
+
+bool QosSnapshotReadHook::BeforeRead(size_t count) {
+    bthread::CountdownEvent event(1);
+    bool needComplete = false;
+    scheduler_->Submit(IOClass::RECOVERY, 0, count,
+                       [&event, &needComplete](bool scheduled) {
+        needComplete = scheduled;
+        event.signal();
+    });
+    event.wait();
+    return needComplete;
+}
+
+void QosSnapshotReadHook::AfterRead(uint64_t latencyUs) {
+    scheduler_->OnComplete(IOClass::RECOVERY, latencyUs);
+}
+
+}  // namespace chunkserver
+}  // namespace curve
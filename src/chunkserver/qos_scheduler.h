@@ -0,0 +1,293 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_QOS_SCHEDULER_H_
+#define SRC_CHUNKSERVER_QOS_SCHEDULER_H_
+
+#include <bvar/bvar.h>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "src/chunkserver/raftsnapshot/curve_file_service.h"
+#include "src/common/concurrent/concurrent.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::Atomic;
+using curve::common::ConditionVariable;
+using curve::common::Mutex;
+using curve::common::Thread;
+
+/**
+ * 流量类型，不同类型的流量使用各自的QoS参数
+ */
+enum class IOClass {
+    // 客户端读写，按卷分别调度
+    CLIENT = 0,
+    // 副本恢复时leader读取快照文件
+    RECOVERY = 1,
+    // 一致性检查
+    SCAN = 2,
+    // 克隆和从源端恢复数据
+    CLONE = 3,
+};
+
+const int kIOClassNum = 4;
+
+const char* IOClassName(IOClass cls);
+
+/**
+ * mClock的QoS参数，单位都是每秒请求数
+ */
+struct QosSpec {
+    // 保证的最小iops，0表示不保证
+    uint64_t reservation = 0;
+    // iops上限，0表示不限制
+    uint64_t limit = 0;
+    // 按比例分配剩余能力时的权重
+    uint32_t weight = 1;
+};
+
+struct QosSchedulerOptions {
+    // 关闭时请求直接下发，不排队
+    bool enable = false;
+    // 同时下发到下层处理的请求数上限，超过后在调度器中排队
+    uint32_t maxOutstanding = 64;
+    // 按请求大小计算开销，每costUnitBytes字节算一个请求
+    uint32_t costUnitBytes = 65536;
+    // 长时间没有请求的卷的队列会被回收
+    uint32_t idleQueueTimeoutSec = 60;
+    // 各类流量的QoS参数，客户端流量整体只使用reservation和limit，
+    // 权重按卷使用volumeSpec
+    QosSpec classSpecs[kIOClassNum];
+    // 每个卷的QoS参数
+    QosSpec volumeSpec;
+};
+
+/**
+ * 各类流量的统计
+ */
+struct QosClassMetric {
+    // 从提交到完成的延迟
+    bvar::LatencyRecorder latency;
+    // 在调度器中排队的时间
+    bvar::LatencyRecorder queueLatency;
+    // 正在排队的请求数
+    bvar::Adder<int64_t> queueDepth;
+};
+
+/**
+ * 基于mClock的I/O调度器，位于ChunkServiceImpl和ConcurrentApplyModule之间。
+ *
+ * 每个卷的客户端请求以及其它每类流量各占一个队列，按照mClock给队首请求打tag：
+ *  R = max(R' + cost / reservation, arrival)
+ *  L = max(L' + cost / limit, arrival)
+ *  P = max(P' + cost / weight, arrival)
+ * 下发时先满足R <= now的队列（按R从小到大），否则在L <= now的队列中选P最小的；
+ * 按权重下发的请求不推进R，这样保留的能力不会被按权重下发的请求占用。
+ * 客户端流量整体另外按classSpecs[CLIENT]的reservation和limit打tag：
+ * 整体超过limit时所有卷都不能按权重下发，整体的R到期时在没有超过limit的卷中
+ * 选P最小的下发。
+ * 同时下发的请求数不超过maxOutstanding，调度线程只负责打tag和选择请求，
+ * 请求的task在bthread中执行。
+ */
+class QosScheduler {
+ public:
+    /**
+     * 下发请求的任务
+     * @param scheduled: 请求是否经过调度线程下发并计入了outstanding，
+     *        为true时请求完成后必须调用OnComplete，为false表示调度器没有运行，
+     *        请求被直接执行，不能调用OnComplete
+     */
+    using Task = std::function<void(bool scheduled)>;
+
+    QosScheduler();
+    virtual ~QosScheduler();
+
+    /**
+     * @brief 初始化调度器
+     * @return 0:成功，非0失败
+     */
+    int Init(const QosSchedulerOptions& options);
+
+    /**
+     * @brief 启动调度线程
+     * @return 0:成功，非0失败
+     */
+    int Run();
+
+    /**
+     * @brief 停止调度线程，还在排队的请求会直接下发
+     * @return 0:成功，非0失败
+     */
+    int Fini();
+
+    /**
+     * @brief 提交请求，调度器允许时执行task
+     * @param cls: 流量类型
+     * @param volume: 请求所属的卷，只对客户端流量有效
+     * @param bytes: 请求的数据量，用于计算请求的开销
+     * @param task: 下发请求的任务，调度器没有运行时在调用线程中直接执行
+     */
+    virtual void Submit(IOClass cls, uint64_t volume, uint64_t bytes,
+                        Task task);
+
+    /**
+     * @brief 经过调度线程下发的请求处理完成
+     * @param cls: 流量类型
+     * @param latencyUs: 请求从提交到完成的延迟
+     */
+    virtual void OnComplete(IOClass cls, uint64_t latencyUs);
+
+    /**
+     * @brief 更新QoS参数，由mds通过心跳下发
+     */
+    void UpdateSpecs(const QosSpec (&classSpecs)[kIOClassNum],
+                     const QosSpec& volumeSpec);
+
+    /**
+     * @brief 调度线程是否在运行，没有运行时提交的请求直接下发
+     */
+    bool Enabled() const {
+        return running_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief 当前已下发还未完成的请求数
+     */
+    uint32_t GetOutstanding();
+
+    QosClassMetric* GetMetric(IOClass cls) {
+        return &metrics_[static_cast<int>(cls)];
+    }
+
+ private:
+    struct Request {
+        Task task;
+        double cost;
+        uint64_t arrivalUs;
+    };
+
+    struct Queue {
+        QosSpec spec;
+        std::deque<Request> requests;
+        // 上一个下发的请求的tag，单位us
+        double rTag = 0;
+        double lTag = 0;
+        double pTag = 0;
+        uint64_t lastActiveUs = 0;
+    };
+
+    using QueueKey = std::pair<int, uint64_t>;
+
+    void DispatchLoop();
+
+    /**
+     * @brief 在bthread中执行调度线程选出的请求的task
+     * @param arg: 调度器和task
+     */
+    static void* RunScheduledTask(void* arg);
+
+    /**
+     * @brief 按tags的QoS参数和上一个tag计算请求的tag
+     */
+    void TagsLocked(const Queue& tags, const Request& request, double* rTag,
+                    double* lTag, double* pTag);
+
+    /**
+     * @brief 计算队首请求的tag
+     */
+    void HeadTagsLocked(const Queue& queue, double* rTag, double* lTag,
+                        double* pTag);
+
+    /**
+     * @brief 选择下一个下发的队列
+     * @param nowUs: 当前时间
+     * @param[out] waitUs: 没有可以下发的队列时，需要等待的时间
+     * @param[out] byReservation: 是否是为了满足保留的能力而下发
+     * @return 可以下发的队列，没有时返回queues_.end()
+     */
+    std::map<QueueKey, Queue>::iterator PickLocked(uint64_t nowUs,
+                                                   uint64_t* waitUs,
+                                                   bool* byReservation);
+
+    /**
+     * @brief 从队列中取出一个请求，并推进队列的tag，
+     *        客户端请求同时推进客户端流量整体的tag
+     */
+    Request PopLocked(IOClass cls, Queue* queue, uint64_t nowUs,
+                      bool byReservation);
+
+    /**
+     * @brief 回收长时间空闲的卷的队列
+     */
+    void RemoveIdleQueuesLocked(uint64_t nowUs);
+
+    const QosSpec& SpecLocked(IOClass cls) const;
+
+    void ExposeMetrics();
+
+ private:
+    QosSchedulerOptions options_;
+
+    Mutex mtx_;
+    ConditionVariable cond_;
+    std::map<QueueKey, Queue> queues_;
+    // 客户端流量整体的QoS参数和tag，不保存请求
+    Queue clientTags_;
+    uint32_t outstanding_;
+    uint64_t queued_;
+    // 已经下发、task还在执行的请求数，Fini需要等待它们返回
+    uint32_t runningTasks_;
+    uint64_t lastGcUs_;
+
+    Thread dispatcher_;
+    Atomic<bool> running_;
+
+    QosClassMetric metrics_[kIOClassNum];
+};
+
+/**
+ * 把leader读取快照文件的流量按RECOVERY类型交给调度器
+ */
+class QosSnapshotReadHook : public SnapshotReadHook {
+ public:
+    explicit QosSnapshotReadHook(QosScheduler* scheduler)
+        : scheduler_(scheduler) {}
+
+    bool BeforeRead(size_t count) override;
+
+    void AfterRead(uint64_t latencyUs) override;
+
+ private:
+    QosScheduler* scheduler_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_QOS_SCHEDULER_H_
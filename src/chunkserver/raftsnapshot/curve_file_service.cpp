@@ -43,12 +43,71 @@
 #include <brpc/closure_guard.h>
 #include <brpc/controller.h>
 #include <braft/util.h>
+#include <bthread/bthread.h>
+#include <algorithm>
+#include <cstring>
 #include <stack>
 #include "src/chunkserver/raftsnapshot/curve_file_service.h"
+#include "src/chunkserver/raftsnapshot/curve_snapshot_checksum.h"
 
 namespace curve {
 namespace chunkserver {
 
+namespace {
+
+const size_t kChecksumReadSize = 1024 * 1024;
+const int64_t kChecksumThrottleIntervalUs = 100 * 1000;
+const size_t kSparsePageSize = 4096;
+
+// 和全零页比较，memcmp按字长比较，比逐字节检查快
+const char kZeroPage[kSparsePageSize] = {0};
+
+bool IsZero(const butil::IOBuf& buf) {
+    for (size_t i = 0; i < buf.backing_block_num(); ++i) {
+        butil::StringPiece block = buf.backing_block(i);
+        const char* data = block.data();
+        size_t left = block.size();
+        while (left > 0) {
+            size_t len = std::min(left, kSparsePageSize);
+            if (memcmp(data, kZeroPage, len) != 0) {
+                return false;
+            }
+            data += len;
+            left -= len;
+        }
+    }
+    return true;
+}
+
+/**
+ * 按页检查数据，连续的非零页作为一个segment加入seg_data，全零的页不加入。
+ * 接收端需要把segment之间的空洞填零
+ */
+void AppendNonZeroPages(butil::IOBuf* buf, off_t offset,
+                        braft::FileSegData* seg_data) {
+    butil::IOBuf range;
+    off_t range_offset = offset;
+    while (!buf->empty()) {
+        butil::IOBuf page;
+        buf->cutn(&page, std::min(kSparsePageSize, buf->size()));
+        if (IsZero(page)) {
+            if (!range.empty()) {
+                seg_data->append(range, range_offset);
+                range.clear();
+            }
+            range_offset = offset + page.size();
+        } else {
+            range.append(page);
+        }
+        offset += page.size();
+    }
+    if (!range.empty()) {
+        seg_data->append(range, range_offset);
+    }
+}
+
+}  // namespace
+
 CurveFileService& kCurveFileService = CurveFileService::GetInstance();
 
 void CurveFileService::get_file(::google::protobuf::RpcController* controller,
@@ -87,6 +146,7 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
 
     butil::IOBuf buf;
     bool is_eof = false;
+    bool sparse = false;
     size_t read_count = 0;
     // 1. 如果是read attch meta file
     if (request->filename() == BRAFT_SNAPSHOT_ATTACH_META_FILE) {
@@ -148,10 +208,37 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
             is_eof = true;
             read_count = buf.size();
         }
+    } else if (butil::StringPiece(request->filename()).ends_with(
+                                        CURVE_SNAPSHOT_CHECKSUM_SUFFIX)) {
+        // 2. 如果是查询文件的校验码，返回长度和hash组成的校验码，
+        //    校验码在后台计算，没有算完时返回EAGAIN
+        std::string filename = request->filename().substr(0,
+            request->filename().size() -
+            strlen(CURVE_SNAPSHOT_CHECKSUM_SUFFIX));
+        std::string checksum;
+        const int rc = get_checksum(request->reader_id(), reader, filename,
+                                    &checksum);
+        if (rc != 0) {
+            cntl->SetFailed(rc, "Fail to checksum path=%s filename=%s : %s",
+                            reader->path().c_str(), filename.c_str(),
+                            berror(rc));
+            return;
+        }
+        buf.append(checksum);
+        is_eof = true;
+        read_count = buf.size();
     } else {
-        // 2. 否则其它文件下载继续走raft原先的文件下载流程
-        const int rc = reader->read_file(
-                                &buf, request->filename(),
+        // 3. 否则其它文件下载继续走raft原先的文件下载流程，
+        //    如果请求的是稀疏传输，那么全零的页不传输
+        std::string filename = request->filename();
+        if (butil::StringPiece(filename).ends_with(
+                                        CURVE_SNAPSHOT_SPARSE_SUFFIX)) {
+            sparse = true;
+            filename.resize(
+                filename.size() - strlen(CURVE_SNAPSHOT_SPARSE_SUFFIX));
+        }
+        const int rc = read_snapshot_file(
+                                reader.get(), &buf, filename,
                                 request->offset(), request->count(),
                                 request->read_partly(),
                                 &read_count,
@@ -159,7 +246,7 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
         if (rc != 0) {
             cntl->SetFailed(rc, "Fail to read from path=%s filename=%s : %s",
                             reader->path().c_str(),
-                            request->filename().c_str(), berror(rc));
+                            filename.c_str(), berror(rc));
             return;
         }
     }
@@ -172,16 +259,125 @@ void CurveFileService::get_file(::google::protobuf::RpcController* controller,
     }
 
     braft::FileSegData seg_data;
-    seg_data.append(buf, request->offset());
+    if (sparse) {
+        AppendNonZeroPages(&buf, request->offset(), &seg_data);
+    } else {
+        seg_data.append(buf, request->offset());
+    }
     cntl->response_attachment().swap(seg_data.data());
 }
 
+int CurveFileService::get_checksum(
+                        int64_t reader_id,
+                        const scoped_refptr<braft::FileReader>& reader,
+                        const std::string& filename,
+                        std::string* checksum) {
+    std::unique_lock<braft::raft_mutex_t> lck(_mutex);
+    auto key = std::make_pair(reader_id, filename);
+    auto iter = _checksum_map.find(key);
+    if (iter != _checksum_map.end()) {
+        if (!iter->second->done) {
+            return EAGAIN;
+        }
+        int error = iter->second->error;
+        if (error != 0) {
+            // 出错的结果不缓存，下次查询时重新计算
+            _checksum_map.erase(iter);
+            return error;
+        }
+        *checksum = iter->second->value;
+        return 0;
+    }
+
+    std::unique_ptr<ChecksumArg> arg(new ChecksumArg());
+    arg->service = this;
+    arg->reader = reader;
+    arg->filename = filename;
+    arg->task = std::make_shared<ChecksumTask>();
+    _checksum_map[key] = arg->task;
+    bthread_t tid;
+    if (bthread_start_background(&tid, NULL, run_checksum_file,
+                                 arg.get()) != 0) {
+        LOG(ERROR) << "Fail to start bthread to checksum " << filename;
+        _checksum_map.erase(key);
+        return EAGAIN;
+    }
+    arg.release();
+    return EAGAIN;
+}
+
+void* CurveFileService::run_checksum_file(void* arg) {
+    std::unique_ptr<ChecksumArg> checksum_arg(static_cast<ChecksumArg*>(arg));
+    CurveFileService* service = checksum_arg->service;
+    std::string value;
+    const int rc = service->checksum_file(checksum_arg->reader.get(),
+                                          checksum_arg->filename, &value);
+
+    // reader已经被删除时task不在_checksum_map中，结果直接丢弃
+    BAIDU_SCOPED_LOCK(service->_mutex);
+    checksum_arg->task->done = true;
+    checksum_arg->task->error = rc;
+    checksum_arg->task->value = value;
+    return NULL;
+}
+
+int CurveFileService::checksum_file(braft::FileReader* reader,
+                                    const std::string& filename,
+                                    std::string* checksum) {
+    SnapshotChecksum value;
+    off_t offset = 0;
+    bool is_eof = false;
+    while (!is_eof) {
+        butil::IOBuf buf;
+        size_t read_count = 0;
+        const int rc = read_snapshot_file(reader, &buf, filename, offset,
+                                          kChecksumReadSize, true,
+                                          &read_count, &is_eof);
+        // 被限流时等待一段时间后继续读
+        if (rc == EAGAIN) {
+            bthread_usleep(kChecksumThrottleIntervalUs);
+            continue;
+        }
+        if (rc != 0) {
+            return rc;
+        }
+        value.Update(buf);
+        offset += read_count;
+    }
+    *checksum = value.Final();
+    return 0;
+}
+
+int CurveFileService::read_snapshot_file(braft::FileReader* reader,
+                                         butil::IOBuf* buf,
+                                         const std::string& filename,
+                                         off_t offset,
+                                         size_t count,
+                                         bool read_partly,
+                                         size_t* read_count,
+                                         bool* is_eof) {
+    SnapshotReadHook* hook = _read_hook.load(std::memory_order_acquire);
+    if (hook == nullptr) {
+        return reader->read_file(buf, filename, offset, count, read_partly,
+                                 read_count, is_eof);
+    }
+
+    int64_t start = butil::gettimeofday_us();
+    bool needAfterRead = hook->BeforeRead(count);
+    int rc = reader->read_file(buf, filename, offset, count, read_partly,
+                               read_count, is_eof);
+    if (needAfterRead) {
+        hook->AfterRead(butil::gettimeofday_us() - start);
+    }
+    return rc;
+}
+
 void CurveFileService::set_snapshot_attachment(
                 SnapshotAttachment *snapshot_attachment) {
     _snapshot_attachment = snapshot_attachment;
 }
 
-CurveFileService::CurveFileService() {
+CurveFileService::CurveFileService() : _read_hook(nullptr) {
     _next_id = ((int64_t)getpid() << 45) |
             (butil::gettimeofday_us() << 17 >> 17);
 }
@@ -196,6 +392,10 @@ int CurveFileService::add_reader(braft::FileReader* reader,
 
 int CurveFileService::remove_reader(int64_t reader_id) {
     BAIDU_SCOPED_LOCK(_mutex);
+    _checksum_map.erase(
+        _checksum_map.lower_bound(std::make_pair(reader_id, std::string())),
+        _checksum_map.lower_bound(
+            std::make_pair(reader_id + 1, std::string())));
     return _reader_map.erase(reader_id) == 1 ? 0 : -1;
 }
 
@@ -42,10 +42,12 @@
 #include <butil/memory/singleton.h>
 #include <braft/file_service.pb.h>
 #include <braft/util.h>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
 #include <map>
+#include <utility>
 #include "src/chunkserver/raftsnapshot/curve_snapshot_attachment.h"
 #include "src/chunkserver/raftsnapshot/curve_snapshot_file_reader.h"
 #include "src/chunkserver/raftsnapshot/define.h"
@@ -55,6 +57,25 @@ namespace chunkserver {
 
 DECLARE_string(raft_snapshot_dir);
 
+/**
+ * 读取快照文件前后的回调，chunkserver通过它对副本恢复的流量做QoS调度
+ */
+class SnapshotReadHook {
+ public:
+    virtual ~SnapshotReadHook() = default;
+    /**
+     * 读取文件之前调用，可能会阻塞直到允许读取
+     * @param count: 准备读取的字节数
+     * @return 读取完成后是否需要调用AfterRead
+     */
+    virtual bool BeforeRead(size_t count) = 0;
+    /**
+     * BeforeRead返回true时，读取文件之后调用
+     * @param latencyUs: 从调用BeforeRead到读取完成的时间
+     */
+    virtual void AfterRead(uint64_t latencyUs) = 0;
+};
+
 class BAIDU_CACHELINE_ALIGNMENT CurveFileService : public braft::FileService {
  public:
     static CurveFileService& GetInstance() {
@@ -72,15 +93,69 @@ class BAIDU_CACHELINE_ALIGNMENT CurveFileService : public braft::FileService {
         BAIDU_SCOPED_LOCK(_mutex);
         auto ret = _snapshot_attachment.release();
     }
+    void set_read_hook(SnapshotReadHook* hook) {
+        _read_hook.store(hook, std::memory_order_release);
+    }
 
  private:
     CurveFileService();
     ~CurveFileService() {}
+    // 后台计算的文件校验码
+    struct ChecksumTask {
+        bool done = false;
+        int error = 0;
+        std::string value;
+    };
+    struct ChecksumArg {
+        CurveFileService* service;
+        scoped_refptr<braft::FileReader> reader;
+        std::string filename;
+        std::shared_ptr<ChecksumTask> task;
+    };
+    /**
+     * 获取快照文件的校验码，第一次查询时在后台bthread中计算，
+     * 不占用rpc线程，计算完成之前返回EAGAIN，结果缓存到reader被删除
+     * @param reader_id: 快照对应的reader id
+     * @param reader: 快照对应的reader
+     * @param filename: 文件名
+     * @param checksum: 返回的校验码
+     * @return 成功返回0，正在计算返回EAGAIN，否则返回错误码
+     */
+    int get_checksum(int64_t reader_id,
+                     const scoped_refptr<braft::FileReader>& reader,
+                     const std::string& filename,
+                     std::string* checksum);
+    static void* run_checksum_file(void* arg);
+    /**
+     * 计算快照文件的校验码，读文件时受snapshot throttle限制
+     * @param reader: 快照对应的reader
+     * @param filename: 文件名
+     * @param checksum: 返回的校验码
+     * @return 成功返回0，否则返回错误码
+     */
+    int checksum_file(braft::FileReader* reader,
+                      const std::string& filename,
+                      std::string* checksum);
+    /**
+     * 读取快照文件，设置了read hook时在读取前后调用hook
+     */
+    int read_snapshot_file(braft::FileReader* reader,
+                           butil::IOBuf* buf,
+                           const std::string& filename,
+                           off_t offset,
+                           size_t count,
+                           bool read_partly,
+                           size_t* read_count,
+                           bool* is_eof);
     typedef std::map<int64_t, scoped_refptr<braft::FileReader> > Map;
     braft::raft_mutex_t _mutex;
     int64_t _next_id;
     Map _reader_map;
+    // 各个reader的文件校验码，key是reader id和文件名
+    std::map<std::pair<int64_t, std::string>,
+             std::shared_ptr<ChecksumTask>> _checksum_map;
     scoped_refptr<SnapshotAttachment> _snapshot_attachment;
+    std::atomic<SnapshotReadHook*> _read_hook;
 };
 
 extern CurveFileService &kCurveFileService;
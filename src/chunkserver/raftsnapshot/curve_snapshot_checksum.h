@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CHUNKSERVER_RAFTSNAPSHOT_CURVE_SNAPSHOT_CHECKSUM_H_
+#define SRC_CHUNKSERVER_RAFTSNAPSHOT_CURVE_SNAPSHOT_CHECKSUM_H_
+
+#include <butil/iobuf.h>
+#include <butil/third_party/murmurhash3/murmurhash3.h>
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <string>
+
+namespace curve {
+namespace chunkserver {
+
+/**
+ * 快照文件的校验码，由文件长度和128位的murmurhash3组成，
+ * follower用它判断本地的同名chunk能否代替从leader下载
+ */
+class SnapshotChecksum {
+ public:
+    SnapshotChecksum() : length_(0) {
+        butil::MurmurHash3_x64_128_Init(&ctx_, 0);
+    }
+
+    void Update(const butil::IOBuf& buf) {
+        for (size_t i = 0; i < buf.backing_block_num(); ++i) {
+            butil::StringPiece block = buf.backing_block(i);
+            butil::MurmurHash3_x64_128_Update(
+                &ctx_, block.data(), static_cast<int>(block.size()));
+        }
+        length_ += buf.size();
+    }
+
+    /**
+     * @brief 返回"长度:16进制hash"格式的校验码
+     */
+    std::string Final() const {
+        uint64_t hash[2];
+        butil::MurmurHash3_x64_128_Final(hash, &ctx_);
+        char value[64];
+        snprintf(value, sizeof(value), "%" PRIu64 ":%016" PRIx64 "%016" PRIx64,
+                 length_, hash[0], hash[1]);
+        return value;
+    }
+
+ private:
+    butil::MurmurHash3_x64_128_Context ctx_;
+    uint64_t length_;
+};
+
+}  // namespace chunkserver
+}  // namespace curve
+
+#endif  // SRC_CHUNKSERVER_RAFTSNAPSHOT_CURVE_SNAPSHOT_CHECKSUM_H_
@@ -39,11 +39,94 @@
 //          Zheng,Pengfei(zhengpengfei@baidu.com)
 //          Xiong,Kai(xiongkai@baidu.com)
 
+#include <braft/file_service.pb.h>
+#include <braft/util.h>
+#include <butil/strings/string_number_conversions.h>
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
 #include "src/chunkserver/raftsnapshot/curve_snapshot_copier.h"
+#include "src/chunkserver/raftsnapshot/curve_snapshot_checksum.h"
+
+namespace braft {
+DECLARE_int32(raft_max_byte_count_per_rpc);
+DECLARE_bool(raft_enable_throttle_when_install_snapshot);
+}  // namespace braft
+
+DEFINE_uint32(raftSnapshotCopyConcurrency, 4,
+              "number of files copied concurrently when installing snapshot");
+DEFINE_bool(raftSnapshotCopyCheckLocal, true,
+            "use the local chunk instead of downloading it "
+            "if it has the same checksum as the remote one");
+DEFINE_uint32(raftSnapshotCopyRetryTimes, 3,
+              "retry times of a failed get_file request");
+DEFINE_bool(raftSnapshotCopySparse, true,
+            "do not transfer the all-zero pages of snapshot files");
 
 namespace curve {
 namespace chunkserver {
 
+namespace {
+
+const char kRemoteUriPrefix[] = "remote://";
+const int32_t kGetFileTimeoutMs = 10000;
+const int64_t kRetryIntervalUs = 1000 * 1000;
+const int64_t kThrottleIntervalUs = 100 * 1000;
+const size_t kLocalCopyBlockSize = 1024 * 1024;
+
+int write_seg(braft::FileAdaptor* file, const butil::IOBuf& seg,
+              off_t offset) {
+    ssize_t nwritten = file->write(seg, offset);
+    if (nwritten < 0 || static_cast<size_t>(nwritten) != seg.size()) {
+        return -1;
+    }
+    return 0;
+}
+
+// 把[begin, end)填零
+int fill_zero(braft::FileAdaptor* file, off_t begin, off_t end) {
+    butil::IOBuf zero;
+    while (begin < end) {
+        size_t len = std::min(static_cast<size_t>(end - begin),
+                              kLocalCopyBlockSize);
+        zero.clear();
+        zero.resize(len, '\0');
+        if (write_seg(file, zero, begin) != 0) {
+            return -1;
+        }
+        begin += len;
+    }
+    return 0;
+}
+
+}  // namespace
+
+SnapshotCopyMetric* SnapshotCopyMetric::GetInstance() {
+    static SnapshotCopyMetric metric;
+    return &metric;
+}
+
+void SnapshotCopyMetric::Expose(const std::string& prefix) {
+    copyingSnapshots.expose_as(prefix, "snapshot_copying_count");
+    pendingFiles.expose_as(prefix, "snapshot_copy_pending_files");
+    copiedFiles.expose_as(prefix, "snapshot_copied_files");
+    skippedFiles.expose_as(prefix, "snapshot_copy_skipped_files");
+    copiedBytes.expose_as(prefix, "snapshot_copied_bytes");
+    copiedBps.expose_as(prefix, "snapshot_copy_bps");
+    sparseBytes.expose_as(prefix, "snapshot_copy_sparse_bytes");
+}
+
+void SnapshotCopyMetric::Hide() {
+    copyingSnapshots.hide();
+    pendingFiles.hide();
+    copiedFiles.hide();
+    skippedFiles.hide();
+    copiedBytes.hide();
+    copiedBps.hide();
+    sparseBytes.hide();
+}
+
 CurveSnapshotCopier::CurveSnapshotCopier(CurveSnapshotStorage* storage,
                                          bool filter_before_copy_remote,
                                          braft::FileSystemAdaptor* fs,
@@ -57,6 +140,11 @@ CurveSnapshotCopier::CurveSnapshotCopier(CurveSnapshotStorage* storage,
     , _storage(storage)
     , _reader(NULL)
     , _cur_session(NULL)
+    , _reader_id(0)
+    , _copy_list(NULL)
+    , _next_copy(0)
+    , _copy_attach(false)
+    , _sparse_supported(true)
 {}
 
 CurveSnapshotCopier::~CurveSnapshotCopier() {
@@ -70,6 +158,7 @@ void *CurveSnapshotCopier::start_copy(void* arg) {
 }
 
 void CurveSnapshotCopier::copy() {
+    SnapshotCopyMetric::GetInstance()->copyingSnapshots << 1;
     do {
         // 下载snapshot meta中记录的文件
         load_meta_table();
@@ -82,9 +171,7 @@ void CurveSnapshotCopier::copy() {
         }
         std::vector<std::string> files;
         _remote_snapshot.list_files(&files);
-        for (size_t i = 0; i < files.size() && ok(); ++i) {
-            copy_file(files[i]);
-        }
+        copy_files(files, false);
 
         // 下载snapshot attachment文件
         load_attach_meta_table();
@@ -93,10 +180,9 @@ void CurveSnapshotCopier::copy() {
         }
         std::vector<std::string> attachFiles;
         _remote_snapshot.list_attach_files(&attachFiles);
-        for (size_t i = 0; i < attachFiles.size() && ok(); ++i) {
-            copy_file(attachFiles[i], true);
-        }
+        copy_files(attachFiles, true);
     } while (0);
+    SnapshotCopyMetric::GetInstance()->copyingSnapshots << -1;
     if (!ok() && _writer && _writer->ok()) {
         LOG(WARNING) << "Fail to copy, error_code " << error_code()
                      << " error_msg " << error_cstr()
@@ -305,12 +391,72 @@ void CurveSnapshotCopier::filter() {
     }
 }
 
-void CurveSnapshotCopier::copy_file(const std::string& filename, bool attch) {
-    if (_writer->get_file_meta(filename, NULL) == 0) {
-        LOG(INFO) << "Skipped downloading " << filename
-                  << " path: " << _writer->get_path();
+void CurveSnapshotCopier::copy_files(const std::vector<std::string>& files,
+                                     bool attach) {
+    if (files.empty() || !ok()) {
         return;
     }
+    SnapshotCopyMetric* metric = SnapshotCopyMetric::GetInstance();
+    {
+        std::lock_guard<braft::raft_mutex_t> lck(_mutex);
+        _copy_list = &files;
+        _next_copy = 0;
+        _copy_attach = attach;
+    }
+    metric->pendingFiles << files.size();
+
+    // 当前bthread也参与下载
+    size_t concurrency = std::min<size_t>(
+        std::max<uint32_t>(FLAGS_raftSnapshotCopyConcurrency, 1),
+        files.size());
+    std::vector<bthread_t> tids;
+    for (size_t i = 1; i < concurrency; ++i) {
+        bthread_t tid;
+        if (bthread_start_background(&tid, NULL, run_copy_files, this) != 0) {
+            PLOG(WARNING) << "Fail to start bthread";
+            break;
+        }
+        tids.push_back(tid);
+    }
+    run_copy_files(this);
+    for (bthread_t tid : tids) {
+        bthread_join(tid, NULL);
+    }
+
+    std::lock_guard<braft::raft_mutex_t> lck(_mutex);
+    // 出错时剩余的文件不再下载
+    metric->pendingFiles << -static_cast<int64_t>(files.size() - _next_copy);
+    _copy_list = NULL;
+}
+
+void* CurveSnapshotCopier::run_copy_files(void* arg) {
+    CurveSnapshotCopier* c = reinterpret_cast<CurveSnapshotCopier*>(arg);
+    while (true) {
+        std::string filename;
+        bool attach = false;
+        {
+            std::lock_guard<braft::raft_mutex_t> lck(c->_mutex);
+            if (!c->ok() || c->_next_copy >= c->_copy_list->size()) {
+                break;
+            }
+            filename = (*c->_copy_list)[c->_next_copy++];
+            attach = c->_copy_attach;
+        }
+        SnapshotCopyMetric::GetInstance()->pendingFiles << -1;
+        c->copy_file(filename, attach);
+    }
+    return NULL;
+}
+
+void CurveSnapshotCopier::copy_file(const std::string& filename, bool attch) {
+    {
+        std::lock_guard<braft::raft_mutex_t> lck(_writer_mutex);
+        if (_writer->get_file_meta(filename, NULL) == 0) {
+            LOG(INFO) << "Skipped downloading " << filename
+                      << " path: " << _writer->get_path();
+            return;
+        }
+    }
     std::string rfilename = get_rfilename(filename);
     std::string file_path = _writer->get_path() + '/' + rfilename;
     butil::FilePath sub_path(rfilename);
@@ -329,59 +475,326 @@ void CurveSnapshotCopier::copy_file(const std::string& filename, bool attch) {
         if (!rc) {
             LOG(ERROR) << "Fail to create directory for " << file_path
                        << " : " << butil::File::ErrorToString(e);
-            set_error(braft::file_error_to_os_error(e),
-                      "Fail to create directory");
+            set_copy_error(braft::file_error_to_os_error(e),
+                           "Fail to create directory");
+            return;
         }
     }
     braft::LocalFileMeta meta;
     _remote_snapshot.get_file_meta(filename, &meta);
-    std::unique_lock<braft::raft_mutex_t> lck(_mutex);
-    if (_cancelled) {
-        set_error(ECANCELED, "%s", berror(ECANCELED));
-        return;
-    }
-    scoped_refptr<braft::RemoteFileCopier::Session> session
-        = _copier.start_to_copy_to_file(filename, file_path, NULL);
-    if (session == NULL) {
-        LOG(WARNING) << "Fail to copy " << filename
-                     << " path: " << _writer->get_path();
-        set_error(-1, "Fail to copy %s", filename.c_str());
-        return;
-    }
-    _cur_session = session.get();
-    lck.unlock();
-    session->join();
-    lck.lock();
-    _cur_session = NULL;
-    lck.unlock();
-    if (!session->status().ok()) {
+
+    SnapshotCopyMetric* metric = SnapshotCopyMetric::GetInstance();
+    if (!attch && FLAGS_raftSnapshotCopyCheckLocal &&
+        copy_from_local(filename, file_path)) {
+        metric->skippedFiles << 1;
+    } else {
+        // attach文件不在leader的快照文件列表中，不走稀疏传输
+        int rc = fetch_file(filename, file_path, !attch);
         // 如果是文件不存在，那么删除刚开始open的文件
-        if (session->status().error_code() == ENOENT) {
-            bool rc = _fs->delete_file(file_path, false);
-            if (!rc) {
+        if (rc == ENOENT) {
+            if (!_fs->delete_file(file_path, false)) {
                 LOG(ERROR) << "Fail to delete file" << file_path
                            << " : " << ::berror(errno);
-                set_error(errno,
-                          "Fail to create delete file " + file_path);
+                set_copy_error(errno,
+                               "Fail to create delete file " + file_path);
             }
             return;
         }
-
-        set_error(session->status().error_code(),
-                  session->status().error_cstr());
-        return;
+        if (rc != 0) {
+            LOG(WARNING) << "Fail to copy " << filename
+                         << " path: " << _writer->get_path();
+            set_copy_error(rc, "Fail to copy " + filename);
+            return;
+        }
+        metric->copiedFiles << 1;
     }
+
+    std::lock_guard<braft::raft_mutex_t> lck(_writer_mutex);
     // 如果是attach file，那么不需要持久化file meta信息
     if (!attch && _writer->add_file(filename, &meta) != 0) {
-        set_error(EIO, "Fail to add file to writer");
+        set_copy_error(EIO, "Fail to add file to writer");
         return;
     }
     if (_writer->sync() != 0) {
-        set_error(EIO, "Fail to sync writer");
+        set_copy_error(EIO, "Fail to sync writer");
         return;
     }
 }
 
+int CurveSnapshotCopier::fetch_file(const std::string& filename,
+                                    const std::string& file_path,
+                                    bool sparse) {
+    butil::File::Error e;
+    std::unique_ptr<braft::FileAdaptor> file(_fs->open(file_path,
+                        O_TRUNC | O_WRONLY | O_CREAT | O_CLOEXEC, NULL, &e));
+    if (file == nullptr) {
+        LOG(ERROR) << "Fail to open " << file_path
+                   << " : " << butil::File::ErrorToString(e);
+        return braft::file_error_to_os_error(e);
+    }
+
+    SnapshotCopyMetric* metric = SnapshotCopyMetric::GetInstance();
+    off_t offset = 0;
+    uint32_t retry = 0;
+    while (true) {
+        bool use_sparse = sparse && FLAGS_raftSnapshotCopySparse &&
+                          _sparse_supported.load(std::memory_order_relaxed);
+        size_t max_count = acquire_throughput(
+                                    braft::FLAGS_raft_max_byte_count_per_rpc);
+        if (max_count == 0) {
+            return ECANCELED;
+        }
+
+        braft::GetFileRequest request;
+        request.set_reader_id(_reader_id);
+        request.set_filename(use_sparse ?
+                    filename + CURVE_SNAPSHOT_SPARSE_SUFFIX : filename);
+        request.set_count(max_count);
+        request.set_offset(offset);
+        request.set_read_partly(true);
+        braft::GetFileResponse response;
+        brpc::Controller cntl;
+        get_file(&cntl, &request, &response);
+        if (_throttle &&
+            braft::FLAGS_raft_enable_throttle_when_install_snapshot) {
+            _throttle->return_unused_throughput(max_count,
+                cntl.Failed() ? 0 : response.read_size(), cntl.latency_us());
+        }
+
+        if (cntl.Failed()) {
+            int rc = cntl.ErrorCode();
+            // 老版本的leader找不到带稀疏后缀的文件会返回EPERM，退化为完整传输
+            if (use_sparse && rc == EPERM) {
+                LOG(INFO) << "Leader does not support sparse transfer, "
+                          << "get " << filename << " without holes";
+                _sparse_supported.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            // reader或者文件不存在时重试也不会成功，被限流时不计入重试次数
+            if (rc == ENXIO || rc == ENOENT || rc == ECANCELED ||
+                (rc != EAGAIN && ++retry > FLAGS_raftSnapshotCopyRetryTimes)) {
+                LOG(WARNING) << "Fail to get " << filename
+                             << ", offset: " << offset
+                             << ", error: " << cntl.ErrorText();
+                return rc;
+            }
+            // 从已经收到的位置开始重试
+            LOG(INFO) << "Retry getting " << filename << " from offset "
+                      << offset << ", error: " << cntl.ErrorText();
+            bthread_usleep(kRetryIntervalUs);
+            continue;
+        }
+        retry = 0;
+
+        braft::FileSegData data(cntl.response_attachment());
+        uint64_t seg_offset = 0;
+        butil::IOBuf seg;
+        // 稀疏传输时segment之间是全零的页，而从FilePool取出的文件可能有
+        // 旧数据，所以空洞也要填零
+        off_t written = offset;
+        off_t end = offset + response.read_size();
+        uint64_t transferred = 0;
+        while (data.next(&seg_offset, &seg) != 0) {
+            transferred += seg.size();
+            if (fill_zero(file.get(), written,
+                          static_cast<off_t>(seg_offset)) != 0 ||
+                write_seg(file.get(), seg, seg_offset) != 0) {
+                LOG(ERROR) << "Fail to write " << file_path
+                           << " : " << berror();
+                return EIO;
+            }
+            written = seg_offset + seg.size();
+            seg.clear();
+        }
+        if (fill_zero(file.get(), written, end) != 0) {
+            LOG(ERROR) << "Fail to write " << file_path << " : " << berror();
+            return EIO;
+        }
+        metric->copiedBytes << response.read_size();
+        if (response.read_size() > transferred) {
+            metric->sparseBytes << response.read_size() - transferred;
+        }
+        offset = end;
+        if (response.eof()) {
+            break;
+        }
+    }
+
+    if (!file->sync()) {
+        LOG(ERROR) << "Fail to sync " << file_path;
+        return EIO;
+    }
+    return 0;
+}
+
+bool CurveSnapshotCopier::copy_from_local(const std::string& filename,
+                                          const std::string& file_path) {
+    // 数据目录下的文件以相对路径记录在快照中，例如../../data/chunk_1，
+    // 其在本地对应的是本copyset的数据目录下的同名文件
+    if (filename.find("../") == std::string::npos) {
+        return false;
+    }
+    std::string local_path = _writer->get_path() + '/' + filename;
+    if (!_fs->path_exists(local_path)) {
+        return false;
+    }
+
+    // 先让leader在后台开始计算校验码，与本地拷贝同时进行，
+    // leader不支持查询校验码时直接下载
+    std::string remote;
+    int rc = get_remote_checksum(filename, false, &remote);
+    if (rc != 0 && rc != EAGAIN) {
+        return false;
+    }
+
+    butil::File::Error e;
+    std::unique_ptr<braft::FileAdaptor> src(
+                    _fs->open(local_path, O_RDONLY | O_CLOEXEC, NULL, &e));
+    if (src == nullptr) {
+        return false;
+    }
+    std::unique_ptr<braft::FileAdaptor> dest(_fs->open(file_path,
+                        O_TRUNC | O_WRONLY | O_CREAT | O_CLOEXEC, NULL, &e));
+    if (dest == nullptr) {
+        return false;
+    }
+
+    // 拷贝本地文件的同时计算校验码，保证校验的就是最终使用的数据
+    bool success = true;
+    SnapshotChecksum checksum;
+    off_t offset = 0;
+    while (success) {
+        size_t count = acquire_throughput(kLocalCopyBlockSize);
+        if (count == 0) {
+            success = false;
+            break;
+        }
+        butil::IOPortal portal;
+        ssize_t nread = src->read(&portal, offset, count);
+        if (_throttle &&
+            braft::FLAGS_raft_enable_throttle_when_install_snapshot) {
+            _throttle->return_unused_throughput(
+                count, std::max<ssize_t>(nread, 0), 0);
+        }
+        if (nread <= 0) {
+            success = nread == 0;
+            break;
+        }
+        checksum.Update(portal);
+        success = dest->write(portal, offset) == nread;
+        offset += nread;
+    }
+
+    if (success && rc == EAGAIN) {
+        rc = get_remote_checksum(filename, true, &remote);
+    }
+    success = success && rc == 0 && remote == checksum.Final() &&
+              dest->sync();
+    if (!success) {
+        // 校验码不同或者leader不支持查询校验码，从leader下载
+        dest.reset();
+        _fs->delete_file(file_path, false);
+        return false;
+    }
+
+    LOG(INFO) << "Use local file " << local_path << " for " << filename
+              << ", checksum: " << remote
+              << ", path: " << _writer->get_path();
+    return true;
+}
+
+int CurveSnapshotCopier::get_remote_checksum(const std::string& filename,
+                                             bool wait,
+                                             std::string* checksum) {
+    while (true) {
+        braft::GetFileRequest request;
+        request.set_reader_id(_reader_id);
+        request.set_filename(filename + CURVE_SNAPSHOT_CHECKSUM_SUFFIX);
+        request.set_count(1);
+        request.set_offset(0);
+        braft::GetFileResponse response;
+        brpc::Controller cntl;
+        get_file(&cntl, &request, &response);
+        if (cntl.Failed()) {
+            int rc = cntl.ErrorCode();
+            // leader正在后台计算校验码
+            if (rc == EAGAIN && wait) {
+                bthread_usleep(kThrottleIntervalUs);
+                continue;
+            }
+            if (rc != EAGAIN) {
+                LOG(INFO) << "Fail to get checksum of " << filename
+                          << ", error: " << cntl.ErrorText();
+            }
+            return rc;
+        }
+
+        std::string value;
+        braft::FileSegData data(cntl.response_attachment());
+        uint64_t seg_offset = 0;
+        butil::IOBuf seg;
+        while (data.next(&seg_offset, &seg) != 0) {
+            value.append(seg.to_string());
+            seg.clear();
+        }
+        if (value.empty()) {
+            LOG(WARNING) << "Empty checksum of " << filename;
+            return EINVAL;
+        }
+        *checksum = value;
+        return 0;
+    }
+}
+
+void CurveSnapshotCopier::get_file(brpc::Controller* cntl,
+                                   const braft::GetFileRequest* request,
+                                   braft::GetFileResponse* response) {
+    cntl->set_timeout_ms(kGetFileTimeoutMs);
+    std::unique_lock<braft::raft_mutex_t> lck(_mutex);
+    if (_cancelled) {
+        cntl->SetFailed(ECANCELED, "%s", berror(ECANCELED));
+        return;
+    }
+    brpc::CallId call_id = cntl->call_id();
+    _cur_calls.push_back(call_id);
+    lck.unlock();
+
+    braft::FileService_Stub stub(&_channel);
+    stub.get_file(cntl, request, response, NULL);
+
+    lck.lock();
+    _cur_calls.erase(
+        std::find(_cur_calls.begin(), _cur_calls.end(), call_id));
+}
+
+size_t CurveSnapshotCopier::acquire_throughput(size_t count) {
+    while (true) {
+        {
+            std::lock_guard<braft::raft_mutex_t> lck(_mutex);
+            if (_cancelled) {
+                return 0;
+            }
+        }
+        if (!_throttle ||
+            !braft::FLAGS_raft_enable_throttle_when_install_snapshot) {
+            return count;
+        }
+        size_t granted = _throttle->throttled_by_throughput(count);
+        if (granted > 0) {
+            return granted;
+        }
+        bthread_usleep(kThrottleIntervalUs);
+    }
+}
+
+void CurveSnapshotCopier::set_copy_error(int error_code,
+                                         const std::string& error_msg) {
+    std::lock_guard<braft::raft_mutex_t> lck(_mutex);
+    if (ok()) {
+        set_error(error_code, "%s", error_msg.c_str());
+    }
+}
+
 std::string CurveSnapshotCopier::get_rfilename(const std::string& filename) {
     std::string rfilename;
     auto pos = filename.rfind("../");
@@ -414,10 +827,32 @@ void CurveSnapshotCopier::cancel() {
     if (_cur_session) {
         _cur_session->cancel();
     }
+    for (const brpc::CallId& call_id : _cur_calls) {
+        brpc::StartCancel(call_id);
+    }
 }
 
 int CurveSnapshotCopier::init(const std::string& uri) {
-    return _copier.init(uri, _fs, _throttle);
+    int rc = _copier.init(uri, _fs, _throttle);
+    if (rc != 0) {
+        return rc;
+    }
+
+    // uri的格式为remote://ip:port/reader_id，已经由_copier检查过
+    butil::StringPiece uri_str(uri);
+    uri_str.remove_prefix(strlen(kRemoteUriPrefix));
+    size_t slash_pos = uri_str.find('/');
+    butil::StringPiece ip_and_port = uri_str.substr(0, slash_pos);
+    uri_str.remove_prefix(slash_pos + 1);
+    if (!butil::StringToInt64(uri_str, &_reader_id)) {
+        LOG(ERROR) << "Invalid reader_id in uri: " << uri;
+        return -1;
+    }
+    if (_channel.Init(ip_and_port.as_string().c_str(), NULL) != 0) {
+        LOG(ERROR) << "Fail to init channel to " << ip_and_port;
+        return -1;
+    }
+    return 0;
 }
 
 }  // namespace chunkserver
@@ -43,6 +43,9 @@
 #define SRC_CHUNKSERVER_RAFTSNAPSHOT_CURVE_SNAPSHOT_COPIER_H_
 
 #include <braft/storage.h>
+#include <brpc/channel.h>
+#include <bvar/bvar.h>
+#include <atomic>
 #include <vector>
 #include <string>
 #include "src/chunkserver/raftsnapshot/curve_snapshot.h"
@@ -53,6 +56,46 @@ namespace chunkserver {
 
 class CurveSnapshotStorage;
 
+/**
+ * install snapshot的进度统计，所有copier共用，由ChunkServerMetric暴露
+ */
+class SnapshotCopyMetric {
+ public:
+    static SnapshotCopyMetric* GetInstance();
+
+    /**
+     * 以指定前缀暴露统计项
+     * @param prefix: 统计项名字的前缀
+     */
+    void Expose(const std::string& prefix);
+
+    /**
+     * 隐藏统计项
+     */
+    void Hide();
+
+    // 正在下载的快照数量
+    bvar::Adder<int64_t> copyingSnapshots;
+    // 等待下载的文件数量
+    bvar::Adder<int64_t> pendingFiles;
+    // 从远端下载完成的文件数量
+    bvar::Adder<uint64_t> copiedFiles;
+    // 与本地文件校验码相同，不需要下载的文件数量
+    bvar::Adder<uint64_t> skippedFiles;
+    // 从远端下载的字节数及其速率
+    bvar::Adder<uint64_t> copiedBytes;
+    bvar::PerSecond<bvar::Adder<uint64_t>> copiedBps;
+    // 稀疏传输时省去的全零数据字节数
+    bvar::Adder<uint64_t> sparseBytes;
+
+ private:
+    SnapshotCopyMetric() : copiedBps(&copiedBytes) {}
+};
+
+/**
+ * 从leader下载快照。多个文件并发下载，下载失败时从已收到的位置重试；
+ * 对于本地已经存在的chunk，如果与leader上的校验码相同，则直接使用本地数据。
+ */
 class CurveSnapshotCopier : public braft::SnapshotCopier {
  public:
     CurveSnapshotCopier(CurveSnapshotStorage* storage,
@@ -74,7 +117,51 @@ class CurveSnapshotCopier : public braft::SnapshotCopier {
     int filter_before_copy(CurveSnapshotWriter* writer,
                            braft::SnapshotReader* last_snapshot);
     void filter();
+    /**
+     * 并发下载文件，最多同时下载FLAGS_raftSnapshotCopyConcurrency个文件
+     * @param files: 待下载的文件
+     * @param attach: 是否是attachment文件
+     */
+    void copy_files(const std::vector<std::string>& files, bool attach);
+    static void* run_copy_files(void* arg);
     void copy_file(const std::string& filename, bool attach = false);
+    /**
+     * 从远端下载文件，失败时从已经下载的位置开始重试
+     * @param sparse: 是否请求稀疏传输，leader不支持时退化为完整传输
+     * @return 成功返回0，否则返回错误码
+     */
+    int fetch_file(const std::string& filename, const std::string& file_path,
+                   bool sparse);
+    /**
+     * 如果本地存在同名文件，并且与远端的校验码相同，则拷贝本地文件
+     * @return 拷贝了本地文件返回true，否则返回false
+     */
+    bool copy_from_local(const std::string& filename,
+                         const std::string& file_path);
+    /**
+     * 获取远端文件的校验码，由文件长度和128位hash组成，
+     * leader第一次被查询时才在后台开始计算
+     * @param wait: leader还没有算完时是否等待
+     * @return 成功返回0，leader还没有算完并且不等待时返回EAGAIN，
+     *         否则返回错误码
+     */
+    int get_remote_checksum(const std::string& filename, bool wait,
+                            std::string* checksum);
+    /**
+     * 按照throttle申请带宽，被限流时等待
+     * @return 可以读写的字节数，被cancel时返回0
+     */
+    size_t acquire_throughput(size_t count);
+    /**
+     * 并发下载时设置错误，只记录第一个错误
+     */
+    void set_copy_error(int error_code, const std::string& error_msg);
+    /**
+     * 发送get_file请求，发送过程中cancel会取消该请求
+     */
+    void get_file(brpc::Controller* cntl,
+                  const braft::GetFileRequest* request,
+                  braft::GetFileResponse* response);
     // 这里的filename是相对于快照目录的路径，为了先把文件下载到临时目录，需要把前面的..去掉
     std::string get_rfilename(const std::string& filename);
 
@@ -88,8 +175,21 @@ class CurveSnapshotCopier : public braft::SnapshotCopier {
     CurveSnapshotStorage* _storage;
     braft::SnapshotReader* _reader;
     braft::RemoteFileCopier::Session* _cur_session;
+    // 正在进行的get_file请求
+    std::vector<brpc::CallId> _cur_calls;
     CurveSnapshot _remote_snapshot;
     braft::RemoteFileCopier _copier;
+
+    // 并发下载文件时使用
+    brpc::Channel _channel;
+    int64_t _reader_id;
+    // 保护_writer的文件列表
+    braft::raft_mutex_t _writer_mutex;
+    const std::vector<std::string>* _copy_list;
+    size_t _next_copy;
+    bool _copy_attach;
+    // leader是否支持稀疏传输，老版本的leader不认识稀疏传输的文件名
+    std::atomic<bool> _sparse_supported;
 };
 }  // namespace chunkserver
 }  // namespace curve
@@ -37,6 +37,10 @@ const char RAFT_LOG_DIR[]  = "log";
 #define BRAFT_SNAPSHOT_META_FILE        "__raft_snapshot_meta"
 #define BRAFT_SNAPSHOT_ATTACH_META_FILE "__raft_snapshot_attach_meta"
 #define BRAFT_PROTOBUF_FILE_TEMP ".tmp"
+// 在文件名后加上该后缀，用于从leader查询快照文件的校验码
+#define CURVE_SNAPSHOT_CHECKSUM_SUFFIX "@checksum"
+// 在文件名后加上该后缀，表示下载快照文件时不传输全零的页
+#define CURVE_SNAPSHOT_SPARSE_SUFFIX "@sparse"
 
 }  // namespace chunkserver
 }  // namespace curve
@@ -39,6 +39,7 @@ int ScanManager::Init(const ScanManagerOptions &options) {
     // reuse timeout 1000ms as send scan task interval
     scanTaskWaitInterval_.Init(options.timeoutMs);
     copysetNodeManager_ = options.copysetNodeManager;
+    qosScheduler_ = options.qosScheduler;
     chunkSize_ = copysetNodeManager_->GetCopysetNodeOptions().maxChunkSize;
     if (scanSize_ > chunkSize_ || scanSize_ <= 0 ||
         chunkSize_ % scanSize_ != 0) {
@@ -277,7 +278,18 @@ int ScanManager::ScanJobProcess(const std::shared_ptr<ScanJob> job) {
                 std::shared_ptr<ScanChunkRequest> req =
                     std::make_shared<ScanChunkRequest>(nodePtr, this, request,
                                                     response, done);
-                req->Process();
+                if (nullptr != qosScheduler_ && qosScheduler_->Enabled()) {
+                    QosScheduler* scheduler = qosScheduler_;
+                    scheduler->Submit(IOClass::SCAN, 0, request->size(),
+                        [req, done, scheduler](bool scheduled) {
+                            if (scheduled) {
+                                done->SetQosScheduler(scheduler);
+                            }
+                            req->Process();
+                        });
+                } else {
+                    req->Process();
+                }
                 if (!scanChunkMetaPage) {
                     currentOffset += scanSize_;
                 }
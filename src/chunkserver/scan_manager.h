@@ -63,6 +63,8 @@ struct ScanManagerOptions {
     uint32_t retry;
     uint64_t retryIntervalUs;
     CopysetNodeManager* copysetNodeManager;
+    // 为空时scan请求不经过QoS调度，直接下发
+    QosScheduler* qosScheduler = nullptr;
 };
 
 /**
@@ -244,6 +246,7 @@ class ScanManager {
     std::map<ScanKey, std::shared_ptr<ScanJob>> jobs_;
     RWLock jobMapLock_;
     CopysetNodeManager *copysetNodeManager_;
+    QosScheduler *qosScheduler_;
     uint32_t chunkSize_;
     uint32_t chunkMetaPageSize_;
     uint64_t scanSize_;
@@ -22,6 +22,8 @@
 
 #include <time.h>
 #include <glog/logging.h>
+#include <bvar/bvar.h>
+#include <algorithm>
 #include <vector>
 #include "src/chunkserver/trash.h"
 #include "src/common/string_util.h"
@@ -29,15 +31,29 @@
 #include "src/chunkserver/copyset_node.h"
 #include "include/chunkserver/chunkserver_common.h"
 #include "src/common/uri_parser.h"
+#include "src/common/timeutility.h"
 #include "src/chunkserver/raftlog/define.h"
 
 using ::curve::chunkserver::RAFT_DATA_DIR;
 using ::curve::chunkserver::RAFT_META_DIR;
 using ::curve::chunkserver::RAFT_SNAP_DIR;
 using ::curve::chunkserver::RAFT_LOG_DIR;
+using ::curve::common::TimeUtility;
 
 namespace curve {
 namespace chunkserver {
+
+namespace {
+
+// 归还给FilePool的文件个数
+bvar::Adder<uint64_t> g_trash_recycled_files(
+    "chunkserver_trash_recycled_files");
+// 每一批文件归还给FilePool的耗时
+bvar::LatencyRecorder g_trash_recycle_batch_latency(
+    "chunkserver_trash_recycle_batch");
+
+}  // namespace
+
 int Trash::Init(TrashOptions options) {
     isStop_ = true;
 
@@ -58,7 +74,10 @@ int Trash::Init(TrashOptions options) {
     localFileSystem_ = options.localFileSystem;
     chunkFilePool_ = options.chunkFilePool;
     walPool_ = options.walPool;
+    recycleBatchSize_ = std::max(options.recycleBatchSize, 1u);
+    recycleFilesPerSec_ = options.recycleFilesPerSec;
     chunkNum_.store(0);
+    pendingBytes_.store(0);
 
      // 读取trash目录下的所有目录
     std::vector<std::string> files;
@@ -156,7 +175,10 @@ void Trash::DeleteEligibleFileInTrash() {
         return;
     }
 
-    // 遍历trash下的文件
+    // 先收集所有过期copyset中的文件，统计待回收的空间，再分批归还给FilePool，
+    // 避免删除大卷时集中rename影响前台IO
+    std::vector<RecycleTask> tasks;
+    uint32_t pendingFiles = 0;
     for (auto &file : files) {
         // 如果不是copyset目录，跳过
         if (!IsCopysetInTrash(file)) {
@@ -168,16 +190,53 @@ void Trash::DeleteEligibleFileInTrash() {
             continue;
         }
 
-        if (!RecycleChunksAndWALInDir(copysetDir, file)) {
+        RecycleTask task;
+        task.copysetDir = copysetDir;
+        task.listOk = CollectChunksAndWALInDir(copysetDir, file, &task);
+        pendingFiles += task.chunks.size() + task.wals.size();
+        tasks.emplace_back(std::move(task));
+    }
+    if (tasks.empty()) {
+        return;
+    }
+
+    uint64_t chunkFileSize = chunkFilePool_->GetFilePoolOpt().fileSize;
+    uint64_t walFileSize = walPool_ == nullptr ?
+        0 : walPool_->GetFilePoolOpt().fileSize;
+    for (auto &task : tasks) {
+        pendingBytes_.fetch_add(task.chunks.size() * chunkFileSize +
+                                task.wals.size() * walFileSize);
+    }
+    LOG(INFO) << "Trash start recycle " << tasks.size() << " copysets, "
+              << pendingFiles << " files, pending bytes: "
+              << pendingBytes_.load();
+
+    for (auto &task : tasks) {
+        // 模块已经停止，剩下的copyset下次启动后再回收
+        if (!Throttle(0)) {
+            break;
+        }
+
+        bool ret = task.listOk;
+        if (!RecycleFilesInBatch(chunkFilePool_, task.chunks, chunkFileSize)) {
+            ret = false;
+        }
+        if (!RecycleFilesInBatch(walPool_, task.wals, walFileSize)) {
+            ret = false;
+        }
+        if (!ret) {
             continue;
         }
 
         // 删除copyset目录
-        if (0 != localFileSystem_->Delete(copysetDir)) {
-            LOG(ERROR) << "Trash fail to delete " << copysetDir;
-            return;
+        if (0 != localFileSystem_->Delete(task.copysetDir)) {
+            LOG(ERROR) << "Trash fail to delete " << task.copysetDir;
+            break;
         }
     }
+
+    // 没有回收成功的文件下一轮重新统计
+    pendingBytes_.store(0);
 }
 
 bool Trash::IsCopysetInTrash(const std::string &dirName) {
@@ -224,18 +283,17 @@ bool Trash::IsChunkOrSnapShotFile(const std::string &chunkName) {
         FileNameOperator::ParseFileName(chunkName).type;
 }
 
-bool Trash::RecycleChunksAndWALInDir(
-    const std::string &copysetPath, const std::string &filename) {
+bool Trash::CollectChunksAndWALInDir(const std::string &copysetPath,
+    const std::string &filename, RecycleTask *task) {
     bool isDir = localFileSystem_->DirExists(copysetPath);
     // 是文件看是否需要回收
     if (!isDir) {
         if (IsChunkOrSnapShotFile(filename)) {
-            return RecycleChunkfile(copysetPath, filename);
+            task->chunks.emplace_back(copysetPath);
         } else if (IsWALFile(filename)) {
-            return RecycleWAL(copysetPath, filename);
-        } else {
-            return true;
+            task->wals.emplace_back(copysetPath);
         }
+        return true;
     }
 
     // 是目录，继续list
@@ -249,38 +307,54 @@ bool Trash::RecycleChunksAndWALInDir(
     bool ret = true;
     for (auto &file : files) {
         std::string filePath = copysetPath + "/" + file;
-        // recycle 失败不应该中断其他文件的recycle
-        if (!RecycleChunksAndWALInDir(filePath, file)) {
+        // list 失败不应该中断其他文件的recycle
+        if (!CollectChunksAndWALInDir(filePath, file, task)) {
             ret = false;
         }
     }
     return ret;
 }
 
-bool Trash::RecycleChunkfile(
-    const std::string &filepath, const std::string &filename) {
-    LockGuard lg(mtx_);
-    if (0 != chunkFilePool_->RecycleFile(filepath)) {
-        LOG(ERROR) << "Trash  failed recycle chunk " << filepath
-                    << " to FilePool";
-        return false;
-    }
+bool Trash::RecycleFilesInBatch(const std::shared_ptr<FilePool> &pool,
+    const std::vector<std::string> &files, uint64_t fileSize) {
+    bool ret = true;
+    for (size_t start = 0; start < files.size(); start += recycleBatchSize_) {
+        size_t end = std::min(files.size(), start + recycleBatchSize_);
+        std::vector<std::string> batch(files.begin() + start,
+                                       files.begin() + end);
+        uint32_t recycled = batch.size();
+        // FilePool内部有锁，rename期间不持有mtx_，避免阻塞RecycleCopySet
+        uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        if (pool != nullptr && 0 != pool->RecycleFiles(batch, &recycled)) {
+            LOG(ERROR) << "Trash failed recycle "
+                       << batch.size() - recycled
+                       << " of " << batch.size() << " files to pool";
+            ret = false;
+        }
+        g_trash_recycle_batch_latency << TimeUtility::GetTimeofDayUs() -
+                                         startUs;
+        {
+            LockGuard lg(mtx_);
+            chunkNum_.fetch_sub(recycled);
+        }
+        g_trash_recycled_files << recycled;
 
-    chunkNum_.fetch_sub(1);
-    return true;
-}
+        uint64_t bytes = std::min<uint64_t>(batch.size() * fileSize,
+                                            pendingBytes_.load());
+        pendingBytes_.fetch_sub(bytes);
 
-bool Trash::RecycleWAL(
-    const std::string &filepath, const std::string &filename) {
-    LockGuard lg(mtx_);
-    if (walPool_ != nullptr && 0 != walPool_->RecycleFile(filepath)) {
-        LOG(ERROR) << "Trash  failed recycle WAL " << filepath
-                    << " to WALPool";
-        return false;
+        // 模块已经停止，剩下的文件下次启动后再回收
+        if (!Throttle(batch.size())) {
+            return false;
+        }
     }
+    return ret;
+}
 
-    chunkNum_.fetch_sub(1);
-    return true;
+bool Trash::Throttle(uint32_t fileNum) {
+    uint64_t waitMs = recycleFilesPerSec_ == 0 ?
+        0 : 1000ull * fileNum / recycleFilesPerSec_;
+    return sleeper_.wait_for(std::chrono::milliseconds(waitMs));
 }
 
 bool Trash::IsWALFile(const std::string &fileName) {
@@ -25,6 +25,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 #include "src/fs/local_filesystem.h"
 #include "src/chunkserver/datastore/file_pool.h"
 #include "src/common/concurrent/concurrent.h"
@@ -45,6 +46,10 @@ struct TrashOptions{
     int expiredAfterSec;
     // 扫描trash目录的时间间隔
     int scanPeriodSec;
+    // 每批归还给FilePool的文件个数
+    uint32_t recycleBatchSize = 64;
+    // 每秒归还给FilePool的文件个数上限，0表示不限制
+    uint32_t recycleFilesPerSec = 0;
 
     std::shared_ptr<LocalFileSystem> localFileSystem;
     std::shared_ptr<FilePool> chunkFilePool;
@@ -73,7 +78,27 @@ class Trash {
     */
     uint32_t GetChunkNum() {return chunkNum_.load();}
 
+    /*
+    * @brief 获取已经过期、正在等待归还给FilePool的文件占用的空间，
+    *        这部分空间很快就可以被新的chunk使用
+    *
+    * @return 待回收的字节数
+    */
+    uint64_t GetPendingReclaimBytes() {return pendingBytes_.load();}
+
  private:
+    /*
+    * @brief 一个过期copyset目录中待回收的文件
+    */
+    struct RecycleTask {
+        // copyset目录
+        std::string copysetDir;
+        // 目录是否遍历成功，失败时不删除copyset目录
+        bool listOk;
+        std::vector<std::string> chunks;
+        std::vector<std::string> wals;
+    };
+
     /*
     * @brief DeleteEligibleFileInTrashInterval 每隔一段时间进行trash物理空间回收
     */
@@ -108,34 +133,35 @@ class Trash {
     bool IsChunkOrSnapShotFile(const std::string &chunkName);
 
     /*
-    * @brief Recycle Chunkfile and wal file in Copyset
+    * @brief Collect Chunkfile and wal file in Copyset
     *
     * @param[in] copysetDir copyset dir
     * @param[in] filename filename
+    * @param[out] task 收集到的chunk和wal文件
     */
-    bool RecycleChunksAndWALInDir(
-        const std::string &copysetDir, const std::string &filename);
+    bool CollectChunksAndWALInDir(const std::string &copysetDir,
+        const std::string &filename, RecycleTask *task);
 
     /*
-    * @brief Recycle Chunkfile
+    * @brief 分批把文件归还给FilePool，每批之间按recycleFilesPerSec限速
+    *
+    * @param[in] pool 文件归还的池子，为空时只更新统计
+    * @param[in] files 待回收的文件路径
+    * @param[in] fileSize 每个文件占用的空间
     *
-    * @param[in] filepath 文件路径
-    * @param[in] filename 文件名
+    * @return true-全部回收成功
     */
-    bool RecycleChunkfile(
-        const std::string &filepath, const std::string &filename);
+    bool RecycleFilesInBatch(const std::shared_ptr<FilePool> &pool,
+        const std::vector<std::string> &files, uint64_t fileSize);
 
-    /**
-     * @brief Recycle WAL
-     *
-     * @param copysetPath copyset dir
-     * @param filename file name
-     *
-     * @retval true   success
-     * @retval false  failure
-     */
-    bool RecycleWAL(
-        const std::string &filepath, const std::string &filename);
+    /*
+    * @brief 回收了一批文件之后限速
+    *
+    * @param[in] fileNum 这一批的文件个数
+    *
+    * @return false-模块已经停止
+    */
+    bool Throttle(uint32_t fileNum);
 
 
     /**
@@ -166,6 +192,15 @@ class Trash {
     // 回收站中chunk的个数
     Atomic<uint32_t> chunkNum_;
 
+    // 每批归还给FilePool的文件个数
+    uint32_t recycleBatchSize_;
+
+    // 每秒归还给FilePool的文件个数上限
+    uint32_t recycleFilesPerSec_;
+
+    // 待回收的文件占用的空间
+    Atomic<uint64_t> pendingBytes_;
+
     Mutex mtx_;
 
     // 本地文件系统
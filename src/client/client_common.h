@@ -106,6 +106,13 @@ typedef struct LeaseSession {
     uint64_t createTime;
 } LeaseSession_t;
 
+// 批量续约时单个文件的续约信息
+typedef struct RefreshSessionItem {
+    std::string filename;
+    UserInfo_t userinfo;
+    std::string sessionid;
+} RefreshSessionItem_t;
+
 // 保存logicalpool中segment对应的copysetid信息
 typedef struct LogicalPoolCopysetIDInfo {
     LogicPoolID lpid;
@@ -164,6 +164,12 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no mds.refreshTimesPerLease info";
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetBoolValue("mds.batchRefreshSession",
+        &fileServiceOption_.leaseOpt.batchRefresh);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.batchRefreshSession info, using default value "
+        << fileServiceOption_.leaseOpt.batchRefresh;
+
     fileServiceOption_.ioOpt.reqSchdulerOpt.ioSenderOpt =
         fileServiceOption_.ioOpt.ioSenderOpt;
 
@@ -273,6 +279,13 @@ int ClientConfig::Init(const std::string& configpath) {
     LOG_IF(ERROR, ret == false) << "config no discard.taskDelayMs info";
     RETURN_IF_FALSE(ret);
 
+    ret = conf_.GetUInt32Value(
+        "global.segmentPrefetchCount",
+        &fileServiceOption_.ioOpt.ioSplitOpt.segmentPrefetchCount);
+    LOG_IF(WARNING, ret == false)
+        << "config no global.segmentPrefetchCount info, using default value "
+        << fileServiceOption_.ioOpt.ioSplitOpt.segmentPrefetchCount;
+
     ret = conf_.GetUInt32Value(
         "global.alignment.commonVolume",
         &fileServiceOption_.ioOpt.ioSplitOpt.alignment.commonVolume);
@@ -170,10 +170,14 @@ struct MDSClientMetric {
     InterfaceMetric getFile;
     // RefreshSession接口统计信息
     InterfaceMetric refreshSession;
+    // RefreshSessions接口统计信息
+    InterfaceMetric refreshSessions;
     // GetServerList接口统计信息
     InterfaceMetric getServerList;
     // GetOrAllocateSegment接口统计信息
     InterfaceMetric getOrAllocateSegment;
+    // GetOrAllocateSegments接口统计信息
+    InterfaceMetric getOrAllocateSegments;
     // DeAllocateSegment接口统计信息
     InterfaceMetric deAllocateSegment;
     // RenameFile接口统计信息
@@ -211,8 +215,10 @@ struct MDSClientMetric {
           closeFile(prefix, "closeFile"),
           getFile(prefix, "getFileInfo"),
           refreshSession(prefix, "refreshSession"),
+          refreshSessions(prefix, "refreshSessions"),
           getServerList(prefix, "getServerList"),
           getOrAllocateSegment(prefix, "getOrAllocateSegment"),
+          getOrAllocateSegments(prefix, "getOrAllocateSegments"),
           deAllocateSegment(prefix, "deAllocateSegment"),
           renameFile(prefix, "renameFile"),
           extendFile(prefix, "extendFile"),
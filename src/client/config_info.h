@@ -87,6 +87,8 @@ struct MetaServerOption {
  */
 struct LeaseOption {
     uint32_t mdsRefreshTimesPerLease = 5;
+    // 是否将同一个MDSClient上所有文件的续约合并到一个rpc中
+    bool batchRefresh = false;
 };
 
 /**
@@ -224,6 +226,8 @@ struct AlignmentOption {
 struct IOSplitOption {
     uint64_t fileIOSplitMaxSizeKB = 64;
     AlignmentOption alignment;
+    // 写请求分配segment时，顺带预分配后续未分配segment的个数，0表示不预分配
+    uint32_t segmentPrefetchCount = 0;
 };
 
 /**
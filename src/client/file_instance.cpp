@@ -159,6 +159,45 @@ int FileInstance::AioDiscard(CurveAioContext* aioctx) {
     return -1;
 }
 
+int FileInstance::AioReadv(CurveAioContext* aioctx, const struct iovec* iov,
+                           int iovcnt) {
+    DLOG_EVERY_SECOND(INFO) << "begin AioReadv " << finfo_.fullPathName
+                            << ", offset = " << aioctx->offset
+                            << ", len = " << aioctx->length
+                            << ", iovcnt = " << iovcnt;
+    return iomanager4file_.AioReadv(aioctx, iov, iovcnt, mdsclient_.get());
+}
+
+int FileInstance::AioWritev(CurveAioContext* aioctx, const struct iovec* iov,
+                            int iovcnt) {
+    if (readonly_) {
+        DVLOG(9) << "open with read only, do not support write!";
+        return -1;
+    }
+    DLOG_EVERY_SECOND(INFO) << "begin AioWritev " << finfo_.fullPathName
+                            << ", offset = " << aioctx->offset
+                            << ", len = " << aioctx->length
+                            << ", iovcnt = " << iovcnt;
+    return iomanager4file_.AioWritev(aioctx, iov, iovcnt, mdsclient_.get());
+}
+
+int FileInstance::AioSubmitBatch(CurveAioContext** aioctxs, int count,
+                                 UserDataType dataType) {
+    if (readonly_) {
+        for (int i = 0; i < count; ++i) {
+            if (aioctxs[i]->op != LIBCURVE_OP_READ) {
+                LOG(ERROR) << "Open with read only, not support "
+                           << "AioSubmitBatch with op = " << aioctxs[i]->op;
+                return -1;
+            }
+        }
+    }
+    DLOG_EVERY_SECOND(INFO) << "begin AioSubmitBatch " << finfo_.fullPathName
+                            << ", count = " << count;
+    return iomanager4file_.AioSubmitBatch(aioctxs, count, mdsclient_.get(),
+                                          dataType);
+}
+
 // 两种场景会造成在Open的时候返回LIBCURVE_ERROR::FILE_OCCUPIED
 // 1. 强制重启qemu不会调用close逻辑，然后启动的时候原来的文件sessio还没过期.
 //    导致再次去发起open的时候，返回被占用，这种情况可以通过load sessionmap
@@ -192,13 +192,23 @@ void IOTracker::StartAioWrite(CurveAioContext* ctx, MDSClient* mdsclient,
 void IOTracker::DoWrite(MDSClient* mdsclient, const FInfo_t* fileInfo,
                         const FileEpoch* fEpoch,
                         Throttle* throttle) {
-    if (nullptr == data_) {
+    if (nullptr == data_ && userIOVec_.empty()) {
         ReturnOnFail();
         return;
     }
 
     switch (userDataType_) {
         case UserDataType::RawBuffer:
+            if (!userIOVec_.empty()) {
+                for (const auto& iov : userIOVec_) {
+                    if (iov.iov_len == 0) {
+                        continue;
+                    }
+                    writeData_.append_user_data(iov.iov_base, iov.iov_len,
+                                                TrivialDeleter);
+                }
+                break;
+            }
             writeData_.append_user_data(data_, length_,
                                         TrivialDeleter);
             break;
@@ -482,6 +492,16 @@ void IOTracker::Done() {
 
             switch (userDataType_) {
                 case UserDataType::RawBuffer: {
+                    if (!userIOVec_.empty()) {
+                        size_t nc = 0;
+                        for (const auto& iov : userIOVec_) {
+                            nc += readData.cutn(iov.iov_base, iov.iov_len);
+                        }
+                        if (nc != length_) {
+                            errcode_ = LIBCURVE_ERROR::FAILED;
+                        }
+                        break;
+                    }
                     size_t nc = readData.copy_to(data_, readData.size());
                     if (nc != length_) {
                         errcode_ = LIBCURVE_ERROR::FAILED;
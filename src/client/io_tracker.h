@@ -23,6 +23,7 @@
 #define SRC_CLIENT_IO_TRACKER_H_
 
 #include <butil/iobuf.h>
+#include <sys/uio.h>
 
 #include <atomic>
 #include <string>
@@ -210,6 +211,16 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
         userDataType_ = dataType;
     }
 
+    /**
+     * @brief use scattered user buffers instead of aioctx->buf,
+     *        only valid for raw buffers
+     * @param iov user buffers, total length must equal to io length
+     * @param iovcnt number of iovec
+     */
+    void SetUserIOVector(const struct iovec* iov, int iovcnt) {
+        userIOVec_.assign(iov, iov + iovcnt);
+    }
+
     /**
      * @brief prepare space to store read data
      * @param subIoCount #space to store read data
@@ -309,6 +320,9 @@ class CURVE_CACHELINE_ALIGNMENT IOTracker {
     // user data type
     UserDataType userDataType_;
 
+    // scattered user buffers of vectored io, empty if not used
+    std::vector<struct iovec> userIOVec_;
+
     // save write data
     butil::IOBuf writeData_;
 
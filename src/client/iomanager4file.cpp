@@ -23,6 +23,8 @@
 #include <glog/logging.h>
 
 #include <chrono>   // NOLINT
+#include <utility>
+#include <vector>
 
 #include "src/client/metacache.h"
 #include "src/client/iomanager4file.h"
@@ -275,6 +277,131 @@ int IOManager4File::AioDiscard(CurveAioContext* aioctx, MDSClient* mdsclient) {
     return LIBCURVE_ERROR::OK;
 }
 
+int IOManager4File::AioReadv(CurveAioContext* ctx, const struct iovec* iov,
+                             int iovcnt, MDSClient* mdsclient) {
+    MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
+
+    IOTracker* temp = new (std::nothrow)
+        IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+    if (temp == nullptr) {
+        ctx->ret = -LIBCURVE_ERROR::FAILED;
+        ctx->cb(ctx);
+        LOG(ERROR) << "allocate tracker failed!";
+        return LIBCURVE_ERROR::OK;
+    }
+
+    temp->SetUserIOVector(iov, iovcnt);
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, ctx, mdsclient, temp]() {
+        temp->StartAioRead(ctx, mdsclient, this->GetFileInfo(),
+                           throttle_.get());
+    };
+
+    taskPool_.Enqueue(task);
+    return LIBCURVE_ERROR::OK;
+}
+
+int IOManager4File::AioWritev(CurveAioContext* ctx, const struct iovec* iov,
+                              int iovcnt, MDSClient* mdsclient) {
+    MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
+
+    IOTracker* temp = new (std::nothrow)
+        IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+    if (temp == nullptr) {
+        ctx->ret = -LIBCURVE_ERROR::FAILED;
+        ctx->cb(ctx);
+        LOG(ERROR) << "allocate tracker failed!";
+        return LIBCURVE_ERROR::OK;
+    }
+
+    temp->SetUserIOVector(iov, iovcnt);
+    inflightCntl_.IncremInflightNum();
+    auto task = [this, ctx, mdsclient, temp]() {
+        temp->StartAioWrite(ctx, mdsclient, this->GetFileInfo(),
+                            this->GetFileEpoch(),
+                            throttle_.get());
+    };
+
+    taskPool_.Enqueue(task);
+    return LIBCURVE_ERROR::OK;
+}
+
+int IOManager4File::AioSubmitBatch(CurveAioContext** ctxs, int count,
+                                   MDSClient* mdsclient,
+                                   UserDataType dataType) {
+    std::vector<std::pair<CurveAioContext*, IOTracker*>> trackers;
+    trackers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        CurveAioContext* ctx = ctxs[i];
+        switch (ctx->op) {
+            case LIBCURVE_OP_READ:
+                MetricHelper::IncremUserRPSCount(fileMetric_, OpType::READ);
+                break;
+            case LIBCURVE_OP_WRITE:
+                MetricHelper::IncremUserRPSCount(fileMetric_, OpType::WRITE);
+                break;
+            case LIBCURVE_OP_DISCARD:
+                MetricHelper::IncremUserRPSCount(fileMetric_,
+                                                 OpType::DISCARD);
+                if (!IsNeedDiscard(ctx->length)) {
+                    ctx->ret = 0;
+                    ctx->cb(ctx);
+                    continue;
+                }
+                break;
+            default:
+                ctx->ret = -LIBCURVE_ERROR::PARAM_ERROR;
+                ctx->cb(ctx);
+                continue;
+        }
+
+        IOTracker* temp = new (std::nothrow)
+            IOTracker(this, &mc_, scheduler_, fileMetric_, disableStripe_);
+        if (temp == nullptr) {
+            ctx->ret = -LIBCURVE_ERROR::FAILED;
+            ctx->cb(ctx);
+            LOG(ERROR) << "allocate tracker failed!";
+            continue;
+        }
+
+        temp->SetUserDataType(dataType);
+        inflightCntl_.IncremInflightNum();
+        trackers.emplace_back(ctx, temp);
+    }
+
+    if (trackers.empty()) {
+        return LIBCURVE_ERROR::OK;
+    }
+
+    // split and schedule the whole batch in one task, the requests of
+    // adjacent contexts hit the same segments in metacache
+    auto task = [this, mdsclient, trackers]() {
+        for (const auto& item : trackers) {
+            CurveAioContext* ctx = item.first;
+            IOTracker* temp = item.second;
+            switch (ctx->op) {
+                case LIBCURVE_OP_READ:
+                    temp->StartAioRead(ctx, mdsclient, this->GetFileInfo(),
+                                       throttle_.get());
+                    break;
+                case LIBCURVE_OP_WRITE:
+                    temp->StartAioWrite(ctx, mdsclient, this->GetFileInfo(),
+                                        this->GetFileEpoch(),
+                                        throttle_.get());
+                    break;
+                default:
+                    temp->StartAioDiscard(ctx, mdsclient,
+                                          this->GetFileInfo(),
+                                          discardTaskManager_.get());
+                    break;
+            }
+        }
+    };
+
+    taskPool_.Enqueue(task);
+    return LIBCURVE_ERROR::OK;
+}
+
 void IOManager4File::UpdateFileInfo(const FInfo_t& fi) {
     mc_.UpdateFileInfo(fi);
 }
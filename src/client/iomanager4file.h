@@ -127,6 +127,40 @@ class IOManager4File : public IOManager {
      */
     int AioDiscard(CurveAioContext* aioctx, MDSClient* mdsclient);
 
+    /**
+     * @brief Asynchronous vectored read
+     * @param aioctx async request context
+     * @param iov buffers to read into, the array is copied
+     * @param iovcnt number of iovec
+     * @param mdsclient for communicate with MDS
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioReadv(CurveAioContext* aioctx, const struct iovec* iov,
+                 int iovcnt, MDSClient* mdsclient);
+
+    /**
+     * @brief Asynchronous vectored write
+     * @param aioctx async request context
+     * @param iov buffers to write, the array is copied
+     * @param iovcnt number of iovec
+     * @param mdsclient for communicate with MDS
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioWritev(CurveAioContext* aioctx, const struct iovec* iov,
+                  int iovcnt, MDSClient* mdsclient);
+
+    /**
+     * @brief Submit a batch of asynchronous requests, they are split and
+     *        scheduled by one task in order, instead of one task for each
+     * @param aioctxs async request contexts
+     * @param count number of contexts
+     * @param mdsclient for communicate with MDS
+     * @param dataType type of aioctx->buf
+     * @return 0 means success, otherwise it means failure
+     */
+    int AioSubmitBatch(CurveAioContext** aioctxs, int count,
+                       MDSClient* mdsclient, UserDataType dataType);
+
     /**
      * @brief 获取rpc发送令牌
      */
@@ -24,6 +24,7 @@
 #include "src/common/timeutility.h"
 #include "src/client/lease_executor.h"
 #include "src/client/service_helper.h"
+#include "src/client/session_refresher.h"
 
 using curve::common::TimeUtility;
 
@@ -40,9 +41,14 @@ LeaseExecutor::LeaseExecutor(const LeaseOption& leaseOpt,
       leasesession_(),
       isleaseAvaliable_(true),
       failedrefreshcount_(0),
-      task_() {}
+      task_(),
+      refresher_(nullptr) {}
 
 LeaseExecutor::~LeaseExecutor() {
+    if (refresher_ != nullptr) {
+        refresher_->Unregister(this);
+    }
+
     if (task_) {
         task_->Stop();
         task_->WaitTaskExit();
@@ -69,6 +75,20 @@ bool LeaseExecutor::Start(const FInfo_t& fi, const LeaseSession_t& lease) {
     auto interval =
         leasesession_.leaseTime / leaseoption_.mdsRefreshTimesPerLease;
 
+    if (leaseoption_.batchRefresh) {
+        refresher_ = mdsclient_->GetSessionRefresher();
+        if (!refresher_->Register(this, interval)) {
+            refresher_ = nullptr;
+            LOG(ERROR) << "Register to SessionRefresher failed, filename = "
+                       << fullFileName_;
+            return false;
+        }
+
+        LOG(INFO) << "LeaseExecutor for " << fullFileName_
+                  << " started, refreshed in batch";
+        return true;
+    }
+
     task_.reset(new (std::nothrow) RefreshSessionTask(this, interval));
     if (task_ == nullptr) {
         LOG(ERROR) << "Allocate RefreshSessionTask failed, filename = "
@@ -86,15 +106,27 @@ bool LeaseExecutor::Start(const FInfo_t& fi, const LeaseSession_t& lease) {
 }
 
 bool LeaseExecutor::RefreshLease() {
+    PrepareRefresh();
+
+    LeaseRefreshResult response;
+    LIBCURVE_ERROR ret = mdsclient_->RefreshSession(
+        fullFileName_, userinfo_, leasesession_.sessionID, &response);
+
+    return HandleRefreshResult(ret, response);
+}
+
+RefreshSessionItem LeaseExecutor::PrepareRefresh() {
     if (!LeaseValid()) {
         LOG(INFO) << "lease not valid!";
         iomanager_->LeaseTimeoutBlockIO();
     }
 
-    LeaseRefreshResult response;
-    LIBCURVE_ERROR ret = mdsclient_->RefreshSession(
-        fullFileName_, userinfo_, leasesession_.sessionID, &response);
+    return RefreshSessionItem{fullFileName_, userinfo_,
+                              leasesession_.sessionID};
+}
 
+bool LeaseExecutor::HandleRefreshResult(LIBCURVE_ERROR ret,
+                                        const LeaseRefreshResult& response) {
     if (LIBCURVE_ERROR::FAILED == ret) {
         LOG(WARNING) << "Refresh session rpc failed, filename = "
                      << fullFileName_;
@@ -138,6 +170,13 @@ bool LeaseExecutor::RefreshLease() {
 }
 
 void LeaseExecutor::Stop() {
+    if (refresher_ != nullptr) {
+        refresher_->Unregister(this);
+        refresher_ = nullptr;
+
+        LOG(INFO) << "LeaseExecutor for " << fullFileName_ << " stopped";
+    }
+
     if (task_ != nullptr) {
         task_->Stop();
 
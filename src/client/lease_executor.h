@@ -39,6 +39,7 @@ namespace curve {
 namespace client {
 
 class RefreshSessionTask;
+class SessionRefresher;
 
 /**
  * lease refresh结果，session如果不存在就不需要再续约
@@ -115,6 +116,20 @@ class LeaseExecutor : public LeaseExecutorBase {
      */
     bool RefreshLease() override;
 
+    /**
+     * @brief 续约前检查lease是否有效，并返回续约所需的信息
+     */
+    RefreshSessionItem PrepareRefresh();
+
+    /**
+     * @brief 处理续约结果
+     * @param: ret是续约rpc的返回值
+     * @param: response是续约结果
+     * @return 是否继续执行refresh session任务
+     */
+    bool HandleRefreshResult(LIBCURVE_ERROR ret,
+                             const LeaseRefreshResult& response);
+
     /**
      * @brief 测试使用，重置refresh session task
      */
@@ -161,6 +176,9 @@ class LeaseExecutor : public LeaseExecutorBase {
 
     // refresh session定时任务，会间隔固定时间执行一次
     std::unique_ptr<RefreshSessionTask> task_;
+
+    // 批量续约时由SessionRefresher续约，不启动task_
+    SessionRefresher* refresher_;
 };
 
 // RefreshSessin定期任务
@@ -130,6 +130,52 @@ int cbd_ext4_aio_pdiscard(int fd, CurveAioContext* aioctx) {
     return 0;
 }
 
+int cbd_ext4_aio_preadv(int fd, CurveAioContext* context,
+                        const struct iovec* iov, int iovcnt) {
+    // posix aio has no vectored interface, complete it synchronously
+    context->ret = preadv(fd, iov, iovcnt, context->offset);
+    context->cb(context);
+    return 0;
+}
+
+int cbd_ext4_aio_pwritev(int fd, CurveAioContext* context,
+                         const struct iovec* iov, int iovcnt) {
+    context->ret = pwritev(fd, iov, iovcnt, context->offset);
+    context->cb(context);
+    return 0;
+}
+
+int cbd_ext4_aio_submit_batch(int fd, CurveAioContext** contexts, int count) {
+    int i = 0;
+    for (; i < count; ++i) {
+        int ret = -1;
+        switch (contexts[i]->op) {
+            case LIBCURVE_OP_READ:
+                ret = cbd_ext4_aio_pread(fd, contexts[i]);
+                break;
+            case LIBCURVE_OP_WRITE:
+                ret = cbd_ext4_aio_pwrite(fd, contexts[i]);
+                break;
+            case LIBCURVE_OP_DISCARD:
+                ret = cbd_ext4_aio_pdiscard(fd, contexts[i]);
+                break;
+            default:
+                break;
+        }
+        if (ret != 0) {
+            break;
+        }
+    }
+
+    // requests before i are already in flight and can't be taken back,
+    // so complete the rest with error instead of failing the whole batch
+    for (; i < count; ++i) {
+        contexts[i]->ret = -LIBCURVE_ERROR::FAILED;
+        contexts[i]->cb(contexts[i]);
+    }
+    return 0;
+}
+
 int cbd_ext4_sync(int fd) {
     return fsync(fd);
 }
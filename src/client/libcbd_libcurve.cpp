@@ -89,6 +89,21 @@ int cbd_libcurve_aio_pdiscard(int fd, CurveAioContext* context) {
     return AioDiscard(fd, context);
 }
 
+int cbd_libcurve_aio_preadv(int fd, CurveAioContext* context,
+                            const struct iovec* iov, int iovcnt) {
+    return AioReadv(fd, context, iov, iovcnt);
+}
+
+int cbd_libcurve_aio_pwritev(int fd, CurveAioContext* context,
+                             const struct iovec* iov, int iovcnt) {
+    return AioWritev(fd, context, iov, iovcnt);
+}
+
+int cbd_libcurve_aio_submit_batch(int fd, CurveAioContext** contexts,
+                                  int count) {
+    return AioSubmitBatch(fd, contexts, count);
+}
+
 int cbd_libcurve_sync(int fd) {
     // Ignored as it always sync writes to chunkserver currently
     return 0;
@@ -124,6 +124,21 @@ int CurveClient::AioDiscard(int fd, CurveAioContext* aioctx) {
     return fileClient_->AioDiscard(fd, aioctx);
 }
 
+int CurveClient::AioReadv(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt) {
+    return fileClient_->AioReadv(fd, aioctx, iov, iovcnt);
+}
+
+int CurveClient::AioWritev(int fd, CurveAioContext* aioctx,
+                           const struct iovec* iov, int iovcnt) {
+    return fileClient_->AioWritev(fd, aioctx, iov, iovcnt);
+}
+
+int CurveClient::AioSubmitBatch(int fd, CurveAioContext** aioctxs, int count,
+                                UserDataType dataType) {
+    return fileClient_->AioSubmitBatch(fd, aioctxs, count, dataType);
+}
+
 void CurveClient::SetFileClient(FileClient* client) {
     delete fileClient_;
     fileClient_ = client;
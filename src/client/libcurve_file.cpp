@@ -460,6 +460,124 @@ int FileClient::AioDiscard(int fd, CurveAioContext* aioctx) {
     }
 }
 
+bool FileClient::CheckIOVector(const CurveAioContext* aioctx,
+                               const struct iovec* iov, int iovcnt) const {
+    if (iov == nullptr || iovcnt <= 0) {
+        return false;
+    }
+
+    size_t total = 0;
+    for (int i = 0; i < iovcnt; ++i) {
+        total += iov[i].iov_len;
+    }
+
+    return total == aioctx->length;
+}
+
+int FileClient::AioReadv(int fd, CurveAioContext* aioctx,
+                         const struct iovec* iov, int iovcnt) {
+    // 长度为0，直接返回，不做任何操作
+    if (aioctx->length == 0) {
+        return -LIBCURVE_ERROR::OK;
+    }
+
+    if (!CheckIOVector(aioctx, iov, iovcnt)) {
+        LOG(ERROR) << "AioReadv iovec not match, length = " << aioctx->length
+                   << ", iovcnt = " << iovcnt << ", fd = " << fd;
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    if (CheckAligned(aioctx->offset, aioctx->length) == false) {
+        LOG(ERROR) << "AioReadv request not aligned, length = "
+                   << aioctx->length << ", offset = " << aioctx->offset
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::NOT_ALIGNED;
+    }
+
+    ReadLockGuard lk(rwlock_);
+    auto iter = fileserviceMap_.find(fd);
+    if (CURVE_UNLIKELY(iter == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        return -LIBCURVE_ERROR::BAD_FD;
+    }
+
+    return iter->second->AioReadv(aioctx, iov, iovcnt);
+}
+
+int FileClient::AioWritev(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt) {
+    // 长度为0，直接返回，不做任何操作
+    if (aioctx->length == 0) {
+        return -LIBCURVE_ERROR::OK;
+    }
+
+    if (!CheckIOVector(aioctx, iov, iovcnt)) {
+        LOG(ERROR) << "AioWritev iovec not match, length = " << aioctx->length
+                   << ", iovcnt = " << iovcnt << ", fd = " << fd;
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    if (CheckAligned(aioctx->offset, aioctx->length) == false) {
+        LOG(ERROR) << "AioWritev request not aligned, length = "
+                   << aioctx->length << ", offset = " << aioctx->offset
+                   << ", fd = " << fd;
+        return -LIBCURVE_ERROR::NOT_ALIGNED;
+    }
+
+    ReadLockGuard lk(rwlock_);
+    auto iter = fileserviceMap_.find(fd);
+    if (CURVE_UNLIKELY(iter == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        return -LIBCURVE_ERROR::BAD_FD;
+    }
+
+    return iter->second->AioWritev(aioctx, iov, iovcnt);
+}
+
+int FileClient::AioSubmitBatch(int fd, CurveAioContext** aioctxs, int count,
+                               UserDataType dataType) {
+    if (aioctxs == nullptr || count <= 0) {
+        return -LIBCURVE_ERROR::PARAM_ERROR;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const CurveAioContext* aioctx = aioctxs[i];
+        switch (aioctx->op) {
+            case LIBCURVE_OP_READ:
+            case LIBCURVE_OP_WRITE:
+                if (aioctx->length == 0) {
+                    LOG(ERROR) << "AioSubmitBatch empty request, index = "
+                               << i << ", fd = " << fd;
+                    return -LIBCURVE_ERROR::PARAM_ERROR;
+                }
+                if (CheckAligned(aioctx->offset, aioctx->length) == false) {
+                    LOG(ERROR) << "AioSubmitBatch request not aligned"
+                               << ", index = " << i
+                               << ", length = " << aioctx->length
+                               << ", offset = " << aioctx->offset
+                               << ", fd = " << fd;
+                    return -LIBCURVE_ERROR::NOT_ALIGNED;
+                }
+                break;
+            case LIBCURVE_OP_DISCARD:
+                break;
+            default:
+                LOG(ERROR) << "AioSubmitBatch unknown op = " << aioctx->op
+                           << ", index = " << i << ", fd = " << fd;
+                return -LIBCURVE_ERROR::PARAM_ERROR;
+        }
+    }
+
+    ReadLockGuard lk(rwlock_);
+    auto iter = fileserviceMap_.find(fd);
+    if (CURVE_UNLIKELY(iter == fileserviceMap_.end())) {
+        LOG(ERROR) << "invalid fd!";
+        return -LIBCURVE_ERROR::BAD_FD;
+    }
+
+    return iter->second->AioSubmitBatch(aioctxs, count, dataType);
+}
+
 int FileClient::Rename(const UserInfo_t& userinfo,
     const std::string& oldpath, const std::string& newpath) {
     LIBCURVE_ERROR ret;
@@ -886,6 +1004,35 @@ int AioDiscard(int fd, CurveAioContext* aioctx) {
     return globalclient->AioDiscard(fd, aioctx);
 }
 
+int AioReadv(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+             int iovcnt) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    return globalclient->AioReadv(fd, aioctx, iov, iovcnt);
+}
+
+int AioWritev(int fd, CurveAioContext* aioctx, const struct iovec* iov,
+              int iovcnt) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    return globalclient->AioWritev(fd, aioctx, iov, iovcnt);
+}
+
+int AioSubmitBatch(int fd, CurveAioContext** aioctxs, int count) {
+    if (globalclient == nullptr) {
+        LOG(ERROR) << "not inited!";
+        return -LIBCURVE_ERROR::FAILED;
+    }
+
+    return globalclient->AioSubmitBatch(fd, aioctxs, count);
+}
+
 int Create(const char* filename, const C_UserInfo_t* userinfo, size_t size) {
     if (globalclient == nullptr) {
         LOG(ERROR) << "not inited!";
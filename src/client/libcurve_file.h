@@ -171,6 +171,42 @@ class FileClient {
      */
     virtual int AioDiscard(int fd, CurveAioContext* aioctx);
 
+    /**
+     * @brief Asynchronous vectored read
+     * @param fd file descriptor
+     * @param aioctx async request context, aioctx->length must equal to
+     *        the total length of iov
+     * @param iov buffers to read into
+     * @param iovcnt number of iovec
+     * @return 0 means success, otherwise it means failure
+     */
+    virtual int AioReadv(int fd, CurveAioContext* aioctx,
+                         const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Asynchronous vectored write
+     * @param fd file descriptor
+     * @param aioctx async request context, aioctx->length must equal to
+     *        the total length of iov
+     * @param iov buffers to write
+     * @param iovcnt number of iovec
+     * @return 0 means success, otherwise it means failure
+     */
+    virtual int AioWritev(int fd, CurveAioContext* aioctx,
+                          const struct iovec* iov, int iovcnt);
+
+    /**
+     * @brief Submit a batch of asynchronous requests, all contexts are
+     *        checked before any of them is submitted
+     * @param fd file descriptor
+     * @param aioctxs async request contexts
+     * @param count number of contexts
+     * @param dataType type of aioctx->buf
+     * @return 0 means success, otherwise it means failure
+     */
+    virtual int AioSubmitBatch(int fd, CurveAioContext** aioctxs, int count,
+                               UserDataType dataType = UserDataType::RawBuffer);
+
     /**
      * 重命名文件
      * @param: userinfo是用户信息
@@ -304,6 +340,10 @@ class FileClient {
 
     bool CheckAligned(off_t offset, size_t length) const;
 
+    // check whether total length of iov equals to aioctx->length
+    bool CheckIOVector(const CurveAioContext* aioctx,
+                       const struct iovec* iov, int iovcnt) const;
+
  private:
     BthreadRWLock rwlock_;
 
@@ -28,6 +28,7 @@
 #include <algorithm>
 
 #include "src/client/lease_executor.h"
+#include "src/client/session_refresher.h"
 #include "src/common/net_common.h"
 #include "src/common/string_util.h"
 #include "src/common/timeutility.h"
@@ -213,7 +214,11 @@ MDSClient::MDSClient(const std::string &metricPrefix)
     : inited_(false), metaServerOpt_(), mdsClientMetric_(metricPrefix),
       rpcExcutor_() {}
 
-MDSClient::~MDSClient() { UnInitialize(); }
+MDSClient::~MDSClient() {
+    // stop batched refresh before mds client is destroyed
+    sessionRefresher_.reset();
+    UnInitialize();
+}
 
 LIBCURVE_ERROR MDSClient::Initialize(const MetaServerOption &metaServerOpt) {
     if (inited_) {
@@ -689,55 +694,51 @@ LIBCURVE_ERROR MDSClient::RefreshSession(const std::string &filename,
             return -cntl->ErrorCode();
         }
 
+        return ParseRefreshSessionResponse(filename, userinfo, sessionid,
+                                           response, resp, lease);
+    };
+    return ReturnError(
+        rpcExcutor_.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS));
+}
+
+LIBCURVE_ERROR MDSClient::RefreshSessions(
+    const std::vector<RefreshSessionItem>& items,
+    std::vector<LIBCURVE_ERROR>* rets,
+    std::vector<LeaseRefreshResult>* results) {
+    auto task = RPCTaskDefine {
+        RefreshSessionsResponse response;
+        mdsClientMetric_.refreshSessions.qps.count << 1;
+        LatencyGuard lg(&mdsClientMetric_.refreshSessions.latency);
+        MDSClientBase::RefreshSessions(items, &response, cntl, channel);
+        if (cntl->Failed()) {
+            mdsClientMetric_.refreshSessions.eps.count << 1;
+            LOG(WARNING) << "Fail to send RefreshSessionsRequest, "
+                         << cntl->ErrorText()
+                         << ", file count = " << items.size();
+            // mds of old version, no need to retry
+            if (cntl->ErrorCode() == brpc::ENOMETHOD) {
+                return LIBCURVE_ERROR::NOT_SUPPORT;
+            }
+            return -cntl->ErrorCode();
+        }
+
         StatusCode stcode = response.statuscode();
-        if (stcode != StatusCode::kOK) {
-            LOG(WARNING) << "RefreshSession NOT OK: filename = " << filename
-                         << ", owner = " << userinfo.owner
-                         << ", sessionid = " << sessionid
+        if (stcode != StatusCode::kOK ||
+            response.responses_size() != static_cast<int>(items.size())) {
+            LOG(WARNING) << "RefreshSessions NOT OK: file count = "
+                         << items.size() << ", response count = "
+                         << response.responses_size()
                          << ", status code = " << StatusCode_Name(stcode);
-        } else {
-            LOG_EVERY_N(INFO, 100)
-                << "RefreshSession returned: filename = " << filename
-                << ", owner = " << userinfo.owner
-                << ", sessionid = " << sessionid
-                << ", status code = " << StatusCode_Name(stcode);
+            return LIBCURVE_ERROR::FAILED;
         }
 
-        switch (stcode) {
-        case StatusCode::kSessionNotExist:
-        case StatusCode::kFileNotExists:
-            resp->status = LeaseRefreshResult::Status::NOT_EXIST;
-            break;
-        case StatusCode::kOwnerAuthFail:
-            resp->status = LeaseRefreshResult::Status::FAILED;
-            return LIBCURVE_ERROR::AUTHFAIL;
-            break;
-        case StatusCode::kOK:
-            if (response.has_fileinfo()) {
-                FileEpoch_t fEpoch;
-                ServiceHelper::ProtoFileInfo2Local(response.fileinfo(),
-                                                   &resp->finfo,
-                                                   &fEpoch);
-                resp->status = LeaseRefreshResult::Status::OK;
-            } else {
-                LOG(WARNING) << "session response has no fileinfo!";
-                return LIBCURVE_ERROR::FAILED;
-            }
-            if (nullptr != lease) {
-                if (!response.has_protosession()) {
-                    LOG(WARNING) << "session response has no protosession";
-                    return LIBCURVE_ERROR::FAILED;
-                }
-                ProtoSession leasesession = response.protosession();
-                lease->sessionID = leasesession.sessionid();
-                lease->leaseTime = leasesession.leasetime();
-                lease->createTime = leasesession.createtime();
-            }
-            break;
-        default:
-            resp->status = LeaseRefreshResult::Status::FAILED;
-            return LIBCURVE_ERROR::FAILED;
-            break;
+        rets->clear();
+        results->clear();
+        results->resize(items.size());
+        for (size_t i = 0; i < items.size(); ++i) {
+            rets->push_back(ParseRefreshSessionResponse(
+                items[i].filename, items[i].userinfo, items[i].sessionid,
+                response.responses(i), &(*results)[i], nullptr));
         }
         return LIBCURVE_ERROR::OK;
     };
@@ -745,6 +746,71 @@ LIBCURVE_ERROR MDSClient::RefreshSession(const std::string &filename,
         rpcExcutor_.DoRPCTask(task, metaServerOpt_.mdsMaxRetryMS));
 }
 
+SessionRefresher* MDSClient::GetSessionRefresher() {
+    std::lock_guard<std::mutex> lk(refresherMtx_);
+    if (sessionRefresher_ == nullptr) {
+        sessionRefresher_.reset(new SessionRefresher(this));
+    }
+    return sessionRefresher_.get();
+}
+
+LIBCURVE_ERROR MDSClient::ParseRefreshSessionResponse(
+    const std::string& filename, const UserInfo_t& userinfo,
+    const std::string& sessionid, const ReFreshSessionResponse& response,
+    LeaseRefreshResult* resp, LeaseSession* lease) {
+    StatusCode stcode = response.statuscode();
+    if (stcode != StatusCode::kOK) {
+        LOG(WARNING) << "RefreshSession NOT OK: filename = " << filename
+                     << ", owner = " << userinfo.owner
+                     << ", sessionid = " << sessionid
+                     << ", status code = " << StatusCode_Name(stcode);
+    } else {
+        LOG_EVERY_N(INFO, 100)
+            << "RefreshSession returned: filename = " << filename
+            << ", owner = " << userinfo.owner
+            << ", sessionid = " << sessionid
+            << ", status code = " << StatusCode_Name(stcode);
+    }
+
+    switch (stcode) {
+    case StatusCode::kSessionNotExist:
+    case StatusCode::kFileNotExists:
+        resp->status = LeaseRefreshResult::Status::NOT_EXIST;
+        break;
+    case StatusCode::kOwnerAuthFail:
+        resp->status = LeaseRefreshResult::Status::FAILED;
+        return LIBCURVE_ERROR::AUTHFAIL;
+        break;
+    case StatusCode::kOK:
+        if (response.has_fileinfo()) {
+            FileEpoch_t fEpoch;
+            ServiceHelper::ProtoFileInfo2Local(response.fileinfo(),
+                                               &resp->finfo,
+                                               &fEpoch);
+            resp->status = LeaseRefreshResult::Status::OK;
+        } else {
+            LOG(WARNING) << "session response has no fileinfo!";
+            return LIBCURVE_ERROR::FAILED;
+        }
+        if (nullptr != lease) {
+            if (!response.has_protosession()) {
+                LOG(WARNING) << "session response has no protosession";
+                return LIBCURVE_ERROR::FAILED;
+            }
+            ProtoSession leasesession = response.protosession();
+            lease->sessionID = leasesession.sessionid();
+            lease->leaseTime = leasesession.leasetime();
+            lease->createTime = leasesession.createtime();
+        }
+        break;
+    default:
+        resp->status = LeaseRefreshResult::Status::FAILED;
+        return LIBCURVE_ERROR::FAILED;
+        break;
+    }
+    return LIBCURVE_ERROR::OK;
+}
+
 LIBCURVE_ERROR MDSClient::CheckSnapShotStatus(const std::string &filename,
                                               const UserInfo_t &userinfo,
                                               uint64_t seq,
@@ -995,31 +1061,102 @@ LIBCURVE_ERROR MDSClient::GetOrAllocateSegment(bool allocate, uint64_t offset,
             break;
         }
 
-        PageFileSegment pfs = response.pagefilesegment();
-        segInfo->chunksize = pfs.chunksize();
-        segInfo->segmentsize = pfs.segmentsize();
-        segInfo->startoffset = pfs.startoffset();
-        LogicPoolID logicpoolid = pfs.logicalpoolid();
-        segInfo->lpcpIDInfo.lpid = pfs.logicalpoolid();
-
-        int chunksNum = pfs.chunks_size();
-        if (allocate && chunksNum <= 0) {
+        if (allocate && response.pagefilesegment().chunks_size() <= 0) {
             LOG(WARNING) << "MDS allocate segment, but no chunkinfo!";
             // Now, we will retry until allocate segment success
             return -LIBCURVE_ERROR::RETRY_UNTIL_SUCCESS;
         }
 
-        for (int i = 0; i < chunksNum; i++) {
-            ChunkID chunkid = pfs.chunks(i).chunkid();
-            CopysetID copysetid = pfs.chunks(i).copysetid();
-            segInfo->lpcpIDInfo.cpidVec.push_back(copysetid);
-            segInfo->chunkvec.emplace_back(chunkid, logicpoolid, copysetid);
+        ToSegmentInfo(response.pagefilesegment(), segInfo);
+        return LIBCURVE_ERROR::OK;
+    };
+    return ReturnError(rpcExcutor_.DoRPCTask(task, 0));
+}
+
+LIBCURVE_ERROR MDSClient::GetOrAllocateSegments(
+    bool allocate, const std::vector<uint64_t>& segOffsets,
+    const FInfo_t *fi, const FileEpoch_t *fEpoch,
+    std::vector<SegmentInfo> *segInfos) {
+    // don't send rpc to an old mds again and again
+    if (!SupportGetOrAllocateSegments()) {
+        return LIBCURVE_ERROR::NOT_SUPPORT;
+    }
+
+    auto task = RPCTaskDefine {
+        GetOrAllocateSegmentsResponse response;
+        mdsClientMetric_.getOrAllocateSegments.qps.count << 1;
+        LatencyGuard lg(&mdsClientMetric_.getOrAllocateSegments.latency);
+        MDSClientBase::GetOrAllocateSegments(allocate, segOffsets, fi, fEpoch,
+                                             &response, cntl, channel);
+        if (cntl->Failed()) {
+            mdsClientMetric_.getOrAllocateSegments.eps.count << 1;
+            LOG(WARNING) << "allocate segments failed, error code = "
+                         << cntl->ErrorCode()
+                         << ", error content:" << cntl->ErrorText()
+                         << ", first offset:" << segOffsets.front();
+            // mds of old version, no need to retry
+            if (cntl->ErrorCode() == brpc::ENOMETHOD) {
+                segmentsUnsupportedMDSIndex_.store(
+                    addrindex, std::memory_order_relaxed);
+                return LIBCURVE_ERROR::NOT_SUPPORT;
+            }
+            return -cntl->ErrorCode();
+        }
+
+        auto statuscode = response.statuscode();
+        switch (statuscode) {
+        case StatusCode::kParaError:
+            LOG(WARNING) << "GetOrAllocateSegments: error param!";
+            return LIBCURVE_ERROR::FAILED;
+        case StatusCode::kOwnerAuthFail:
+            LOG(WARNING) << "GetOrAllocateSegments: auth failed!";
+            return LIBCURVE_ERROR::AUTHFAIL;
+        case StatusCode::kFileNotExists:
+            LOG(WARNING) << "GetOrAllocateSegments: file not exists!";
+            return LIBCURVE_ERROR::FAILED;
+        case StatusCode::kEpochTooOld:
+            LOG(WARNING) << "GetOrAllocateSegments return epoch too old!";
+            return LIBCURVE_ERROR::EPOCH_TOO_OLD;
+        case StatusCode::kOK:
+            break;
+        default:
+            LOG(WARNING) << "GetOrAllocateSegments failed, statuscode = "
+                         << mds::StatusCode_Name(statuscode);
+            return LIBCURVE_ERROR::FAILED;
+        }
+
+        segInfos->clear();
+        for (const auto& pfs : response.pagefilesegments()) {
+            if (allocate && pfs.chunks_size() <= 0) {
+                LOG(WARNING) << "MDS allocate segment, but no chunkinfo!";
+                return -LIBCURVE_ERROR::RETRY_UNTIL_SUCCESS;
+            }
+
+            segInfos->emplace_back();
+            ToSegmentInfo(pfs, &segInfos->back());
         }
         return LIBCURVE_ERROR::OK;
     };
     return ReturnError(rpcExcutor_.DoRPCTask(task, 0));
 }
 
+void MDSClient::ToSegmentInfo(const PageFileSegment& pfs,
+                              SegmentInfo* segInfo) {
+    segInfo->chunksize = pfs.chunksize();
+    segInfo->segmentsize = pfs.segmentsize();
+    segInfo->startoffset = pfs.startoffset();
+    LogicPoolID logicpoolid = pfs.logicalpoolid();
+    segInfo->lpcpIDInfo.lpid = pfs.logicalpoolid();
+
+    int chunksNum = pfs.chunks_size();
+    for (int i = 0; i < chunksNum; i++) {
+        ChunkID chunkid = pfs.chunks(i).chunkid();
+        CopysetID copysetid = pfs.chunks(i).copysetid();
+        segInfo->lpcpIDInfo.cpidVec.push_back(copysetid);
+        segInfo->chunkvec.emplace_back(chunkid, logicpoolid, copysetid);
+    }
+}
+
 LIBCURVE_ERROR MDSClient::DeAllocateSegment(const FInfo *fileInfo,
                                             uint64_t offset) {
     auto task = RPCTaskDefine {
@@ -26,7 +26,10 @@
 #include <brpc/channel.h>
 #include <brpc/controller.h>
 
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 #include <list>
@@ -158,6 +161,7 @@ class RPCExcutorRetryPolicy {
 
 
 struct LeaseRefreshResult;
+class SessionRefresher;
 
 // MDSClient是client与MDS通信的唯一窗口
 class MDSClient : public MDSClientBase,
@@ -237,6 +241,33 @@ class MDSClient : public MDSClientBase,
                                         const FileEpoch_t *fEpoch,
                                         SegmentInfo *segInfo);
 
+    /**
+     * Get or Alloc several segments in one rpc
+     * @param: allocate  ture for allocate, false for get only
+     * @param: segOffsets  segment start offsets
+     * @param: fi file info
+     * @param: fEpoch  file epoch info
+     * @param[out]: segInfos segments returned, not allocated segments are
+     *              skipped when allocate is false
+     * @return:
+     * return LIBCURVE_ERROR::OK for success,
+     * return LIBCURVE_ERROR::NOT_SUPPORT if mds doesn't support this rpc,
+     * otherwise return other errors like GetOrAllocateSegment
+     */
+    LIBCURVE_ERROR GetOrAllocateSegments(
+        bool allocate, const std::vector<uint64_t>& segOffsets,
+        const FInfo_t *fi, const FileEpoch_t *fEpoch,
+        std::vector<SegmentInfo> *segInfos);
+
+    /**
+     * @brief whether current mds supports GetOrAllocateSegments, the result
+     *        of an old mds is cached until the mds leader changes
+     */
+    bool SupportGetOrAllocateSegments() const {
+        return segmentsUnsupportedMDSIndex_.load(std::memory_order_relaxed) !=
+               rpcExcutor_.GetCurrentWorkIndex();
+    }
+
     /**
      * @brief Send DeAllocateSegment request to current working MDS
      * @param fileInfo current file info
@@ -386,6 +417,25 @@ class MDSClient : public MDSClientBase,
                                   const std::string &sessionid,
                                   LeaseRefreshResult *resp,
                                   LeaseSession *lease = nullptr);
+
+    /**
+     * 在一个rpc中为多个文件续约
+     * @param: items是每个文件的续约信息
+     * @param[out]: rets是每个文件的续约返回值，与RefreshSession的返回值相同
+     * @param[out]: results是每个文件的续约结果
+     * @return:
+     * rpc成功返回LIBCURVE_ERROR::OK，此时rets和results与items一一对应,
+     * mds不支持该rpc返回LIBCURVE_ERROR::NOT_SUPPORT,
+     * 否则返回LIBCURVE_ERROR::FAILED
+     */
+    LIBCURVE_ERROR RefreshSessions(const std::vector<RefreshSessionItem>& items,
+                                   std::vector<LIBCURVE_ERROR>* rets,
+                                   std::vector<LeaseRefreshResult>* results);
+
+    /**
+     * 获取批量续约的执行者，所有使用当前MDSClient的文件共享
+     */
+    SessionRefresher* GetSessionRefresher();
     /**
      * 关闭文件，需要携带sessionid，这样mds端会在数据库删除该session信息
      * @param: filename是要续约的文件名
@@ -542,6 +592,21 @@ class MDSClient : public MDSClientBase,
 
     LIBCURVE_ERROR ReturnError(int retcode);
 
+    /**
+     * 将mds返回的PageFileSegment转换为SegmentInfo
+     */
+    static void ToSegmentInfo(const curve::mds::PageFileSegment& pfs,
+                              SegmentInfo* segInfo);
+
+    /**
+     * 解析单个文件的续约结果，返回值与RefreshSession相同
+     */
+    LIBCURVE_ERROR ParseRefreshSessionResponse(
+        const std::string& filename, const UserInfo_t& userinfo,
+        const std::string& sessionid,
+        const curve::mds::ReFreshSessionResponse& response,
+        LeaseRefreshResult* resp, LeaseSession* lease);
+
  private:
     // 初始化标志，放置重复初始化
     bool inited_ = false;
@@ -553,6 +618,13 @@ class MDSClient : public MDSClientBase,
     MDSClientMetric mdsClientMetric_;
 
     RPCExcutorRetryPolicy rpcExcutor_;
+
+    // 不支持GetOrAllocateSegments的mds地址索引，leader切换后自然失效
+    std::atomic<int> segmentsUnsupportedMDSIndex_{-1};
+
+    // 批量续约的执行者，第一次使用时创建
+    std::mutex refresherMtx_;
+    std::unique_ptr<SessionRefresher> sessionRefresher_;
 };
 
 }  // namespace client
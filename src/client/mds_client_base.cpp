@@ -262,6 +262,28 @@ void MDSClientBase::RefreshSession(const std::string& filename,
     stub.RefreshSession(cntl, &request, response, nullptr);
 }
 
+void MDSClientBase::RefreshSessions(
+    const std::vector<RefreshSessionItem>& items,
+    RefreshSessionsResponse* response,
+    brpc::Controller* cntl,
+    brpc::Channel* channel) {
+    RefreshSessionsRequest request;
+    for (const auto& item : items) {
+        ReFreshSessionRequest* req = request.add_requests();
+        req->set_filename(item.filename);
+        req->set_sessionid(item.sessionid);
+        req->set_clientversion(curve::common::CurveVersion());
+        FillUserInfo(req, item.userinfo);
+        FillClienIpPortIfRegistered(req);
+    }
+
+    LOG_EVERY_N(INFO, 10) << "RefreshSessions: file count = " << items.size()
+                          << ", log id = " << cntl->log_id();
+
+    curve::mds::CurveFSService_Stub stub(channel);
+    stub.RefreshSessions(cntl, &request, response, nullptr);
+}
+
 void MDSClientBase::CheckSnapShotStatus(const std::string& filename,
                                         const UserInfo_t& userinfo,
                                         uint64_t seq,
@@ -396,6 +418,35 @@ void MDSClientBase::GetOrAllocateSegment(bool allocate,
     stub.GetOrAllocateSegment(cntl, &request, response, NULL);
 }
 
+void MDSClientBase::GetOrAllocateSegments(
+    bool allocate,
+    const std::vector<uint64_t>& segOffsets,
+    const FInfo_t* fi,
+    const FileEpoch_t *fEpoch,
+    GetOrAllocateSegmentsResponse* response,
+    brpc::Controller* cntl,
+    brpc::Channel* channel) {
+    GetOrAllocateSegmentsRequest request;
+    request.set_filename(fi->fullPathName);
+    for (auto offset : segOffsets) {
+        request.add_offsets(offset);
+    }
+    request.set_allocateifnotexist(allocate);
+    if (allocate && fEpoch != nullptr && fEpoch->epoch != 0) {
+        request.set_epoch(fEpoch->epoch);
+    }
+    FillUserInfo(&request, fi->userinfo);
+
+    LOG(INFO) << "GetOrAllocateSegments: filename = " << fi->fullPathName
+              << ", allocate = " << allocate << ", owner = " << fi->owner
+              << ", first segment offset = " << segOffsets.front()
+              << ", count = " << segOffsets.size()
+              << ", log id = " << cntl->log_id();
+
+    curve::mds::CurveFSService_Stub stub(channel);
+    stub.GetOrAllocateSegments(cntl, &request, response, NULL);
+}
+
 void MDSClientBase::DeAllocateSegment(const FInfo* fileInfo,
                                       uint64_t segmentOffset,
                                       DeAllocateSegmentResponse* response,
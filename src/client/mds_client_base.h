@@ -59,6 +59,8 @@ using curve::mds::DeleteSnapShotRequest;
 using curve::mds::DeleteSnapShotResponse;
 using curve::mds::ReFreshSessionRequest;
 using curve::mds::ReFreshSessionResponse;
+using curve::mds::RefreshSessionsRequest;
+using curve::mds::RefreshSessionsResponse;
 using curve::mds::ListDirRequest;
 using curve::mds::ListDirResponse;
 using curve::mds::ChangeOwnerRequest;
@@ -71,6 +73,8 @@ using curve::mds::SetCloneFileStatusRequest;
 using curve::mds::SetCloneFileStatusResponse;
 using curve::mds::GetOrAllocateSegmentRequest;
 using curve::mds::GetOrAllocateSegmentResponse;
+using curve::mds::GetOrAllocateSegmentsRequest;
+using curve::mds::GetOrAllocateSegmentsResponse;
 using curve::mds::DeAllocateSegmentRequest;
 using curve::mds::DeAllocateSegmentResponse;
 using curve::mds::CheckSnapShotStatusRequest;
@@ -249,6 +253,18 @@ class MDSClientBase {
                         ReFreshSessionResponse* response,
                         brpc::Controller* cntl,
                         brpc::Channel* channel);
+
+    /**
+     * 在一个rpc中为多个文件续约
+     * @param: items是每个文件的续约信息
+     * @param[out]: response为该rpc的response，提供给外部处理
+     * @param[in|out]: cntl既是入参，也是出参，返回RPC状态
+     * @param[in]:channel是当前与mds建立的通道
+     */
+    void RefreshSessions(const std::vector<RefreshSessionItem>& items,
+                         RefreshSessionsResponse* response,
+                         brpc::Controller* cntl,
+                         brpc::Channel* channel);
     /**
      * 获取快照状态
      * @param: filenam文件名
@@ -350,6 +366,24 @@ class MDSClientBase {
                               brpc::Controller* cntl,
                               brpc::Channel* channel);
 
+    /**
+     * Get or Alloc several segments in one rpc
+     * @param: allocate  ture for allocate, false for get only
+     * @param: segOffsets  segment start offsets
+     * @param: fi file info
+     * @param: fEpoch  file epoch info
+     * @param[out]: reponse  rpc response
+     * @param[in|out]: cntl  rpc controller
+     * @param[in]:channel  rpc channel
+     */
+    void GetOrAllocateSegments(bool allocate,
+                               const std::vector<uint64_t>& segOffsets,
+                               const FInfo_t* fi,
+                               const FileEpoch_t *fEpoch,
+                               GetOrAllocateSegmentsResponse* response,
+                               brpc::Controller* cntl,
+                               brpc::Channel* channel);
+
     void DeAllocateSegment(const FInfo* fileInfo, uint64_t segmentOffset,
                            DeAllocateSegmentResponse* response,
                            brpc::Controller* cntl, brpc::Channel* channel);
@@ -90,6 +90,8 @@ int RequestScheduler::ScheduleRequest(
     const std::vector<RequestContext*>& requests) {
     if (running_.load(std::memory_order_acquire)) {
         /* TODO(wudemiao): 后期考虑 qos */
+        std::vector<BBQItem<RequestContext *>> reqs;
+        reqs.reserve(requests.size());
         for (auto it : requests) {
             // skip the fake request
             if (!it->idinfo_.chunkExist) {
@@ -99,8 +101,11 @@ int RequestScheduler::ScheduleRequest(
                 continue;
             }
 
-            BBQItem<RequestContext *> req(it);
-            queue_.PutBack(req);
+            reqs.emplace_back(it);
+        }
+        // put all requests of one io at once, reduce lock and wakeups
+        if (!reqs.empty()) {
+            queue_.PutBack(reqs);
         }
         return 0;
     }
@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/client/session_refresher.h"
+
+#include <glog/logging.h>
+
+#include <algorithm>
+
+namespace curve {
+namespace client {
+
+namespace {
+
+// max number of files refreshed in one rpc
+const size_t kMaxRefreshSessionsPerRpc = 256;
+
+}  // namespace
+
+SessionRefresher::SessionRefresher(MDSClient* mdsclient)
+    : mdsclient_(mdsclient), batchSupported_(true) {}
+
+SessionRefresher::~SessionRefresher() {
+    std::map<uint64_t, std::unique_ptr<Group>> groups;
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        groups.swap(groups_);
+        executors_.clear();
+    }
+
+    for (auto& item : groups) {
+        item.second->task->Stop();
+        item.second->task->WaitTaskExit();
+    }
+}
+
+bool SessionRefresher::Register(LeaseExecutor* executor,
+                                uint64_t intervalUs) {
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    auto iter = groups_.find(intervalUs);
+    if (iter != groups_.end()) {
+        iter->second->executors.insert(executor);
+        executors_[executor] = iter->second.get();
+        return true;
+    }
+
+    std::unique_ptr<Group> group(new (std::nothrow) Group(this, intervalUs));
+    if (group == nullptr) {
+        LOG(ERROR) << "Allocate refresh group failed";
+        return false;
+    }
+
+    group->task.reset(new (std::nothrow)
+                          RefreshSessionTask(group.get(), intervalUs));
+    if (group->task == nullptr) {
+        LOG(ERROR) << "Allocate RefreshSessionTask failed";
+        return false;
+    }
+
+    group->executors.insert(executor);
+    executors_[executor] = group.get();
+
+    timespec abstime = butil::microseconds_from_now(intervalUs);
+    brpc::PeriodicTaskManager::StartTaskAt(group->task.get(), abstime);
+    groups_.emplace(intervalUs, std::move(group));
+
+    LOG(INFO) << "SessionRefresher started a group, lease interval is "
+              << intervalUs << " us";
+    return true;
+}
+
+void SessionRefresher::Unregister(LeaseExecutor* executor) {
+    std::unique_lock<bthread::Mutex> lk(mtx_);
+    auto iter = executors_.find(executor);
+    if (iter == executors_.end()) {
+        return;
+    }
+
+    Group* group = iter->second;
+    group->executors.erase(executor);
+    executors_.erase(iter);
+
+    // 续约rpc在锁外发送，等待这一轮结束后才能释放executor
+    while (group->refreshing.count(executor) != 0) {
+        cond_.wait(lk);
+    }
+}
+
+bool SessionRefresher::RefreshGroup(Group* group) {
+    std::vector<LeaseExecutor*> all;
+    {
+        std::lock_guard<bthread::Mutex> lk(mtx_);
+        if (group->executors.empty()) {
+            return true;
+        }
+
+        all.assign(group->executors.begin(), group->executors.end());
+        group->refreshing = group->executors;
+    }
+
+    std::vector<LeaseExecutor*> stopped;
+    bool batched = false;
+    if (batchSupported_.load(std::memory_order_relaxed)) {
+        batched = true;
+        for (size_t i = 0; i < all.size(); i += kMaxRefreshSessionsPerRpc) {
+            size_t end = std::min(all.size(), i + kMaxRefreshSessionsPerRpc);
+            std::vector<LeaseExecutor*> batch(all.begin() + i,
+                                              all.begin() + end);
+            if (!RefreshBatch(batch, &stopped)) {
+                batchSupported_.store(false, std::memory_order_relaxed);
+                batched = false;
+                LOG(WARNING) << "mds doesn't support RefreshSessions, "
+                                "refresh files one by one";
+                break;
+            }
+        }
+    }
+
+    if (!batched) {
+        stopped.clear();
+        for (auto* executor : all) {
+            if (!executor->RefreshLease()) {
+                stopped.push_back(executor);
+            }
+        }
+    }
+
+    std::lock_guard<bthread::Mutex> lk(mtx_);
+    // session or file not exists, no longer refresh
+    for (auto* executor : stopped) {
+        auto iter = executors_.find(executor);
+        if (iter != executors_.end() && iter->second == group) {
+            group->executors.erase(executor);
+            executors_.erase(iter);
+        }
+    }
+    group->refreshing.clear();
+    cond_.notify_all();
+
+    return true;
+}
+
+bool SessionRefresher::RefreshBatch(
+    const std::vector<LeaseExecutor*>& executors,
+    std::vector<LeaseExecutor*>* stopped) {
+    std::vector<RefreshSessionItem> items;
+    items.reserve(executors.size());
+    for (auto* executor : executors) {
+        items.emplace_back(executor->PrepareRefresh());
+    }
+
+    std::vector<LIBCURVE_ERROR> rets;
+    std::vector<LeaseRefreshResult> results;
+    LIBCURVE_ERROR ret = mdsclient_->RefreshSessions(items, &rets, &results);
+    if (ret == LIBCURVE_ERROR::NOT_SUPPORT) {
+        return false;
+    }
+
+    for (size_t i = 0; i < executors.size(); ++i) {
+        bool goon = true;
+        if (ret == LIBCURVE_ERROR::OK) {
+            goon = executors[i]->HandleRefreshResult(rets[i], results[i]);
+        } else {
+            goon = executors[i]->HandleRefreshResult(ret,
+                                                     LeaseRefreshResult());
+        }
+
+        if (!goon) {
+            stopped->push_back(executors[i]);
+        }
+    }
+
+    return true;
+}
+
+}   // namespace client
+}   // namespace curve
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_CLIENT_SESSION_REFRESHER_H_
+#define SRC_CLIENT_SESSION_REFRESHER_H_
+
+#include <bthread/condition_variable.h>
+#include <bthread/mutex.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "src/client/lease_executor.h"
+
+namespace curve {
+namespace client {
+
+/**
+ * 批量续约，同一个MDSClient上打开的所有文件按续约间隔分组，
+ * 每组由一个定时任务续约，每次续约只发送一个RefreshSessions rpc，
+ * 而不是每个文件各自发送。
+ * 如果mds不支持RefreshSessions，则退化为逐个文件续约。
+ */
+class SessionRefresher {
+ public:
+    explicit SessionRefresher(MDSClient* mdsclient);
+
+    ~SessionRefresher();
+
+    /**
+     * @brief 加入批量续约，和续约间隔相同的文件一起续约
+     * @param: executor需要续约的文件
+     * @param: intervalUs该文件的续约间隔
+     * @return: 成功返回true，否则返回false
+     */
+    bool Register(LeaseExecutor* executor, uint64_t intervalUs);
+
+    /**
+     * @brief 退出批量续约，返回后不会再回调executor，
+     *        如果executor正在续约，则等待这一轮续约结束
+     */
+    void Unregister(LeaseExecutor* executor);
+
+ private:
+    // 续约间隔相同的一组文件，由同一个定时任务续约
+    struct Group : public LeaseExecutorBase {
+        Group(SessionRefresher* refresher, uint64_t intervalUs)
+            : refresher(refresher), intervalUs(intervalUs) {}
+
+        bool RefreshLease() override {
+            return refresher->RefreshGroup(this);
+        }
+
+        SessionRefresher* refresher;
+        uint64_t intervalUs;
+        std::unordered_set<LeaseExecutor*> executors;
+        // 这一轮正在续约的文件
+        std::unordered_set<LeaseExecutor*> refreshing;
+        std::unique_ptr<RefreshSessionTask> task;
+    };
+
+    /**
+     * @brief 为一组文件续约，续约rpc在锁外发送
+     * @return 总是返回true，继续执行续约任务
+     */
+    bool RefreshGroup(Group* group);
+
+    /**
+     * @brief 在一个rpc中为一组文件续约
+     * @param[out] stopped: 不需要再续约的文件
+     * @return mds不支持批量续约时返回false
+     */
+    bool RefreshBatch(const std::vector<LeaseExecutor*>& executors,
+                      std::vector<LeaseExecutor*>* stopped);
+
+ private:
+    MDSClient* mdsclient_;
+
+    // 保护groups_、executors_和各组的文件集合，续约rpc期间不持有
+    bthread::Mutex mtx_;
+    // 一轮续约结束时通知等待的Unregister
+    bthread::ConditionVariable cond_;
+    // 按续约间隔分组
+    std::map<uint64_t, std::unique_ptr<Group>> groups_;
+    // 已加入的文件及其所在的组
+    std::unordered_map<LeaseExecutor*, Group*> executors_;
+
+    // mds是否支持RefreshSessions
+    std::atomic<bool> batchSupported_;
+};
+
+}   // namespace client
+}   // namespace curve
+
+#endif  // SRC_CLIENT_SESSION_REFRESHER_H_
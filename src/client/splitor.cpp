@@ -234,6 +234,38 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
                                    const FInfo* fileInfo,
                                    const FileEpoch_t *fEpoch,
                                    ChunkIndex chunkidx) {
+    if (allocateIfNotExist && iosplitopt_.segmentPrefetchCount > 0 &&
+        mdsClient->SupportGetOrAllocateSegments()) {
+        std::vector<uint64_t> segOffsets =
+            PrefetchSegmentOffsets(offset, metaCache, fileInfo);
+        if (segOffsets.size() > 1) {
+            std::vector<SegmentInfo> segmentInfos;
+            LIBCURVE_ERROR errCode = mdsClient->GetOrAllocateSegments(
+                true, segOffsets, fileInfo, fEpoch, &segmentInfos);
+            if (errCode == LIBCURVE_ERROR::OK) {
+                for (const auto& segmentInfo : segmentInfos) {
+                    if (!CacheSegmentInfo(segmentInfo, mdsClient, metaCache,
+                                          fileInfo)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            if (errCode == LIBCURVE_ERROR::EPOCH_TOO_OLD) {
+                LOG(WARNING) << "GetOrAllocateSegments epoch too old, "
+                             << "filename: " << fileInfo->filename
+                             << ", offset: " << offset;
+                return false;
+            }
+
+            // fallback to allocate the target segment only
+            LOG(WARNING) << "GetOrAllocateSegments failed, filename: "
+                         << fileInfo->filename << ", offset: " << offset
+                         << ", errCode: " << errCode;
+        }
+    }
+
     SegmentInfo segmentInfo;
     LIBCURVE_ERROR errCode = mdsClient->GetOrAllocateSegment(
         allocateIfNotExist, offset, fileInfo, fEpoch, &segmentInfo);
@@ -258,6 +290,40 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
         }
     }
 
+    return CacheSegmentInfo(segmentInfo, mdsClient, metaCache, fileInfo);
+}
+
+std::vector<uint64_t> Splitor::PrefetchSegmentOffsets(
+    uint64_t offset, MetaCache* metaCache, const FInfo* fileInfo) {
+    const uint64_t segmentsize = fileInfo->segmentsize;
+    const uint64_t chunksize = fileInfo->chunksize;
+    const uint64_t segOffset = offset / segmentsize * segmentsize;
+
+    std::vector<uint64_t> segOffsets{segOffset};
+    for (uint32_t i = 1; i <= iosplitopt_.segmentPrefetchCount; ++i) {
+        uint64_t next = segOffset + i * segmentsize;
+        if (next + segmentsize > fileInfo->length) {
+            break;
+        }
+
+        // skip segments that are already allocated
+        ChunkIDInfo chunkIdInfo;
+        MetaCacheErrorType errCode = metaCache->GetChunkInfoByIndex(
+            next / chunksize, &chunkIdInfo);
+        if (errCode == MetaCacheErrorType::OK && chunkIdInfo.chunkExist) {
+            continue;
+        }
+
+        segOffsets.push_back(next);
+    }
+
+    return segOffsets;
+}
+
+bool Splitor::CacheSegmentInfo(const SegmentInfo& segmentInfo,
+                               MDSClient* mdsClient,
+                               MetaCache* metaCache,
+                               const FInfo* fileInfo) {
     const auto chunksize = fileInfo->chunksize;
     uint32_t count = 0;
     for (const auto& chunkIdInfo : segmentInfo.chunkvec) {
@@ -268,9 +334,9 @@ bool Splitor::GetOrAllocateSegment(bool allocateIfNotExist,
     }
 
     std::vector<CopysetInfo<ChunkServerID>> copysetInfos;
-    errCode = mdsClient->GetServerList(segmentInfo.lpcpIDInfo.lpid,
-                                       segmentInfo.lpcpIDInfo.cpidVec,
-                                       &copysetInfos);
+    LIBCURVE_ERROR errCode = mdsClient->GetServerList(
+        segmentInfo.lpcpIDInfo.lpid, segmentInfo.lpcpIDInfo.cpidVec,
+        &copysetInfos);
 
     if (errCode == LIBCURVE_ERROR::FAILED) {
         std::string failedCopysets;
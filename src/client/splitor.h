@@ -133,6 +133,24 @@ class Splitor {
                                      const FileEpoch_t *fEpoch,
                                      ChunkIndex chunkidx);
 
+    /**
+     * 写请求分配segment时，计算需要一起分配的segment偏移
+     * @param: offset 当前请求的偏移
+     * @param: metaCache 文件缓存信息，已缓存的segment不再分配
+     * @param: fileInfo 文件信息
+     * @return 当前segment及其后续预分配segment的起始偏移
+     */
+    static std::vector<uint64_t> PrefetchSegmentOffsets(
+        uint64_t offset, MetaCache* metaCache, const FInfo* fileInfo);
+
+    /**
+     * 将segment信息及其copyset信息更新到metacache
+     */
+    static bool CacheSegmentInfo(const SegmentInfo& segmentInfo,
+                                 MDSClient* mdsClient,
+                                 MetaCache* metaCache,
+                                 const FInfo* fileInfo);
+
     static int SplitForNormal(IOTracker* iotracker, MetaCache* metaCache,
                               std::vector<RequestContext*>* targetlist,
                               butil::IOBuf* data, off_t offset, size_t length,
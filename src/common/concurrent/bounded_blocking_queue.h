@@ -30,6 +30,7 @@
 #include <mutex>                //NOLINT
 #include <atomic>
 #include <utility>
+#include <vector>
 
 #include "src/common/uncopyable.h"
 
@@ -100,6 +101,28 @@ class BoundedBlockingDeque : public Uncopyable {
         notEmpty_.notify_one();
     }
 
+    // put a batch of elements with one lock, and wake up consumers once
+    // instead of once per element, block when the deque is full
+    void PutBack(const std::vector<T> &xs) {
+        size_t i = 0;
+        std::unique_lock<std::mutex> guard(mutex_);
+        while (i < xs.size()) {
+            while (deque_.size() == capacity_) {
+                notEmpty_.notify_all();
+                notFull_.wait(guard);
+            }
+            size_t before = deque_.size();
+            while (i < xs.size() && deque_.size() < capacity_) {
+                deque_.push_back(xs[i++]);
+            }
+            if (deque_.size() - before == 1) {
+                notEmpty_.notify_one();
+            } else {
+                notEmpty_.notify_all();
+            }
+        }
+    }
+
     void PutFront(const T &x) {
         std::unique_lock<std::mutex> guard(mutex_);
         while (deque_.size() == capacity_) {
@@ -207,6 +207,28 @@ int EtcdClientImp::TxnN(const std::vector<Operation> &ops) {
     return errCode;
 }
 
+int EtcdClientImp::TxnNRewithRevision(const std::vector<Operation> &ops,
+    int64_t *revision) {
+    if (ops.empty()) {
+        LOG(ERROR) << "do not support empty Txn";
+        return EtcdErrCode::EtcdInvalidArgument;
+    }
+
+    bool needRetry = false;
+    int retry = 0;
+    int errCode;
+    do {
+        EtcdClientTxnNRewithRevision_return res = EtcdClientTxnNRewithRevision(
+            timeout_, const_cast<Operation*>(ops.data()), ops.size());
+        if (res.r0 == EtcdErrCode::EtcdOK) {
+            *revision = res.r1;
+        }
+        errCode = res.r0;
+        needRetry = NeedRetry(errCode);
+    } while (needRetry && ++retry <= retryTimes_);
+    return errCode;
+}
+
 int EtcdClientImp::GetCurrentRevision(int64_t *revision) {
     bool needRetry = false;
     int retry = 0;
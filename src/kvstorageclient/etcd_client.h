@@ -120,6 +120,18 @@ class KVStorageClient {
     */
     virtual int TxnN(const std::vector<Operation> &ops) = 0;
 
+    /**
+     * @brief TxnNRewithRevision Operate any number of operations in one
+     *        transaction, in the order of ops[0] ops[1] ...
+     *
+     * @param[in] ops Operation set
+     * @param[out] revision Version number of the transaction
+     *
+     * @return error code
+     */
+    virtual int TxnNRewithRevision(const std::vector<Operation> &ops,
+        int64_t *revision) = 0;
+
     /**
      * @brief CompareAndSwap Transaction, to achieve CAS
      *
@@ -174,6 +186,9 @@ class EtcdClientImp : public KVStorageClient {
 
     int TxnN(const std::vector<Operation> &ops) override;
 
+    int TxnNRewithRevision(const std::vector<Operation> &ops,
+        int64_t *revision) override;
+
     int CompareAndSwap(const std::string &key, const std::string &preV,
         const std::string &target) override;
 
@@ -35,6 +35,8 @@ using ::curve::mds::topology::ONLINE;
 using ::curve::chunkserver::ChunkService_Stub;
 using ::curve::chunkserver::ChunkRequest;
 using ::curve::chunkserver::ChunkResponse;
+using ::curve::chunkserver::DeleteChunksRequest;
+using ::curve::chunkserver::DeleteChunksResponse;
 using ::curve::chunkserver::CHUNK_OP_TYPE;
 using ::curve::chunkserver::CHUNK_OP_STATUS;
 
@@ -228,6 +230,115 @@ int ChunkServerClient::DeleteChunk(ChunkServerIdType leaderId,
     return kMdsSuccess;
 }
 
+int ChunkServerClient::DeleteChunks(ChunkServerIdType leaderId,
+    LogicalPoolID logicalPoolId,
+    CopysetID copysetId,
+    const std::vector<ChunkID>& chunkIds,
+    uint64_t sn) {
+    ChannelPtr channelPtr;
+    int res = GetOrInitChannel(leaderId, &channelPtr);
+    if (res != kMdsSuccess) {
+        return res;
+    }
+    ChunkService_Stub stub(channelPtr.get());
+
+    brpc::Controller cntl;
+    cntl.set_timeout_ms(rpcTimeoutMs_);
+
+    DeleteChunksRequest request;
+    for (auto chunkId : chunkIds) {
+        ChunkRequest* req = request.add_requests();
+        req->set_optype(CHUNK_OP_TYPE::CHUNK_OP_DELETE);
+        req->set_logicpoolid(logicalPoolId);
+        req->set_copysetid(copysetId);
+        req->set_chunkid(chunkId);
+        req->set_sn(sn);
+    }
+
+    DeleteChunksResponse response;
+    uint32_t retry = 0;
+    do {
+        cntl.Reset();
+        cntl.set_timeout_ms(rpcTimeoutMs_);
+        stub.DeleteChunks(&cntl,
+            &request,
+            &response,
+            nullptr);
+        LOG(INFO) << "Send DeleteChunks[log_id=" << cntl.log_id()
+                  << "] from " << cntl.local_side()
+                  << " to " << cntl.remote_side()
+                  << ", logicalPoolId = " << logicalPoolId
+                  << ", copysetId = " << copysetId
+                  << ", chunk num = " << chunkIds.size()
+                  << ", sn = " << sn;
+        if (cntl.ErrorCode() == brpc::ENOMETHOD) {
+            LOG(WARNING) << "DeleteChunks is not supported by chunkserver "
+                         << cntl.remote_side();
+            return kCsClientNotSupport;
+        }
+        if (cntl.Failed()) {
+            LOG(WARNING) << "Send DeleteChunks error, "
+                       << "cntl.errorText = "
+                       << cntl.ErrorText()
+                       << ", retry, time = "
+                       << retry;
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(rpcRetryIntervalMs_));
+        }
+        retry++;
+    } while (cntl.Failed() && retry < rpcRetryTimes_);
+
+    if (cntl.Failed()) {
+        LOG(ERROR) << "Send DeleteChunks error, retry fail,"
+                   << "cntl.errorText = "
+                   << cntl.ErrorText() << std::endl;
+        return kRpcFail;
+    }
+
+    if (response.responses_size() != request.requests_size()) {
+        LOG(ERROR) << "Received DeleteChunks error, response size mismatch"
+                   << ", [log_id=" << cntl.log_id()
+                   << "] from " << cntl.remote_side()
+                   << ", request size = " << request.requests_size()
+                   << ", response size = " << response.responses_size();
+        return kCsClientReturnFail;
+    }
+
+    // deletion is idempotent, so the whole batch is retried by caller
+    // if any of the chunks failed
+    int ret = kMdsSuccess;
+    for (int i = 0; i < response.responses_size(); ++i) {
+        switch (response.responses(i).status()) {
+            case CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS:
+            case CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST:
+                break;
+            case CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED:
+                ret = kCsClientNotLeader;
+                break;
+            default:
+                LOG(ERROR) << "Received DeleteChunks error, [log_id="
+                           << cntl.log_id()
+                           << "] from " << cntl.remote_side()
+                           << ". [ChunkRequest] "
+                           << request.requests(i).ShortDebugString()
+                           << ", [ChunkResponse] "
+                           << response.responses(i).ShortDebugString();
+                return kCsClientReturnFail;
+        }
+    }
+
+    if (ret == kCsClientNotLeader) {
+        LOG(INFO) << "Received DeleteChunks, not leader, redirect."
+                  << " [log_id=" << cntl.log_id()
+                  << "] from " << cntl.remote_side();
+    } else {
+        LOG(INFO) << "Received DeleteChunks[log_id=" << cntl.log_id()
+                  << "] from " << cntl.remote_side()
+                  << ", chunk num = " << response.responses_size();
+    }
+    return ret;
+}
+
 int ChunkServerClient::GetLeader(ChunkServerIdType csId,
     LogicalPoolID logicalPoolId,
     CopysetID copysetId,
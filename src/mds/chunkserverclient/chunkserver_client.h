@@ -28,6 +28,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "src/mds/common/mds_define.h"
 #include "src/mds/topology/topology.h"
@@ -94,6 +95,24 @@ class ChunkServerClient {
         ChunkID chunkId,
         uint64_t sn);
 
+    /**
+     * @brief delete a batch of chunks in the same copyset by one rpc
+     *
+     * @param leaderId
+     * @param logicalPoolId
+     * @param copysetId
+     * @param chunkIds chunk file IDs
+     * @param sn file version number
+     *
+     * @return error code, kMdsSuccess only if all chunks are deleted,
+     *         kCsClientNotSupport if chunkserver doesn't support batch delete
+     */
+    virtual int DeleteChunks(ChunkServerIdType leaderId,
+        LogicalPoolID logicalPoolId,
+        CopysetID copysetId,
+        const std::vector<ChunkID>& chunkIds,
+        uint64_t sn);
+
     /**
      * @brief get the leader
      * @detail
@@ -29,6 +29,7 @@
 #include "src/mds/common/mds_define.h"
 #include "src/mds/topology/topology.h"
 #include "proto/topology.pb.h"
+#include "proto/heartbeat.pb.h"
 
 using ::std::chrono::steady_clock;
 using ::curve::mds::topology::ChunkServerIdType;
@@ -69,6 +70,11 @@ struct HeartbeatOption {
 
     // the time when the mds start (fetch from system)
     steady_clock::time_point mdsStartTime;
+
+    // QoS parameters of the I/O scheduler on chunkservers,
+    // pushed in every heartbeat response if enableQos is set
+    bool enableQos = false;
+    QosConf qosConf;
 };
 
 struct HeartbeatInfo {
@@ -21,6 +21,7 @@
  */
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <utility>
 #include <set>
 #include "src/mds/heartbeat/heartbeat_manager.h"
@@ -36,6 +37,7 @@ using ::curve::mds::topology::UNINTIALIZE_ID;
 using ::curve::mds::topology::ChunkServerStatus;
 using ::curve::mds::topology::ChunkServerStat;
 using ::curve::mds::topology::CopysetStat;
+using ::curve::mds::topology::HotChunkStat;
 using ::curve::mds::topology::SplitPeerId;
 
 namespace curve {
@@ -46,7 +48,10 @@ HeartbeatManager::HeartbeatManager(HeartbeatOption option,
     std::shared_ptr<TopologyStat> topologyStat,
     std::shared_ptr<Coordinator> coordinator)
     : topology_(topology),
-      topologyStat_(topologyStat) {
+      topologyStat_(topologyStat),
+      coordinator_(coordinator),
+      enableQos_(option.enableQos),
+      qosConf_(option.qosConf) {
     healthyChecker_ =
         std::make_shared<ChunkserverHealthyChecker>(option, topology);
 
@@ -119,8 +124,46 @@ void HeartbeatManager::UpdateChunkServerDiskStatus(
     }
 }
 
+void HeartbeatManager::BuildCopysetStat(
+    const ChunkServerHeartbeatRequest &request,
+    const ::curve::mds::heartbeat::CopySetInfo &info, CopysetStat *cstat) {
+    cstat->logicalPoolId = info.logicalpoolid();
+    cstat->copysetId = info.copysetid();
+
+    // TODO(xuchaojie): use id instead when new protocol supported
+    std::string leaderPeer = info.leaderpeer().address();
+    std::string leaderIp;
+    uint32_t leaderPort;
+    if (SplitPeerId(leaderPeer, &leaderIp, &leaderPort)) {
+        cstat->leader =
+            topology_->FindChunkServerNotRetired(leaderIp, leaderPort);
+        if (UNINTIALIZE_ID == cstat->leader) {
+            LOG(INFO) << "hearbeat receive from chunkserver(id:"
+                << request.chunkserverid()
+                << ",ip:"<< request.ip() << ",port:" << request.port()
+                << "), in which copyset(" << cstat->logicalPoolId
+                << "," << cstat->copysetId << ") dose not have leader.";
+        }
+    } else {
+        LOG(ERROR) << "hearbeat failed on SplitPeerId, "
+                   << "peerId string = " << leaderPeer;
+    }
+    if (info.has_stats()) {
+        cstat->readRate = info.stats().readrate();
+        cstat->writeRate = info.stats().writerate();
+        cstat->readIOPS = info.stats().readiops();
+        cstat->writeIOPS = info.stats().writeiops();
+    } else {
+        LOG(WARNING) << "hearbeat manager receive request "
+                     << "copyset {" << cstat->logicalPoolId
+                     << ", " << cstat->copysetId << "} "
+                     << "do not have CopysetStatistics";
+    }
+}
+
 void HeartbeatManager::UpdateChunkServerStatistics(
-    const ChunkServerHeartbeatRequest &request) {
+    const ChunkServerHeartbeatRequest &request,
+    const std::vector<CopysetStat> &copysetStats) {
     ChunkServerStat stat;
     stat.leaderCount = request.leadercount();
     stat.copysetCount = request.copysetcount();
@@ -136,53 +179,94 @@ void HeartbeatManager::UpdateChunkServerStatistics(
         if (request.stats().has_chunkfilepoolsize()) {
             stat.chunkFilepoolSize = request.stats().chunkfilepoolsize();
         }
-
-        for (int i = 0; i < request.copysetinfos_size(); i++) {
-            CopysetStat cstat;
-            cstat.logicalPoolId = request.copysetinfos(i).logicalpoolid();
-            cstat.copysetId = request.copysetinfos(i).copysetid();
-
-            // TODO(xuchaojie): use id instead when new protocol supported
-            std::string leaderPeer =
-                request.copysetinfos(i).leaderpeer().address();
-            std::string leaderIp;
-            uint32_t leaderPort;
-            if (SplitPeerId(leaderPeer, &leaderIp, &leaderPort)) {
-                cstat.leader =
-                    topology_->FindChunkServerNotRetired(
-                    leaderIp, leaderPort);
-                if (UNINTIALIZE_ID == cstat.leader) {
-                    LOG(INFO) << "hearbeat receive from chunkserver(id:"
-                        << request.chunkserverid()
-                        << ",ip:"<< request.ip() << ",port:" << request.port()
-                        << "), in which copyset(" << cstat.logicalPoolId
-                        << "," << cstat.copysetId << ") dose not have leader.";
-                }
-            } else {
-                LOG(ERROR) << "hearbeat failed on SplitPeerId, "
-                           << "peerId string = " << leaderPeer;
-            }
-            if (request.copysetinfos(i).has_stats()) {
-                cstat.readRate = request.copysetinfos(i).stats().readrate();
-                cstat.writeRate = request.copysetinfos(i).stats().writerate();
-                cstat.readIOPS = request.copysetinfos(i).stats().readiops();
-                cstat.writeIOPS = request.copysetinfos(i).stats().writeiops();
-            } else {
-                LOG(WARNING) << "hearbeat manager receive request "
-                             << "copyset {" << cstat.logicalPoolId
-                             << ", " << cstat.copysetId << "} "
-                             << "do not have CopysetStatistics";
-            }
-            stat.copysetStats.push_back(cstat);
+        if (request.stats().has_chunksizereclaimablebytes()) {
+            stat.chunkSizeReclaimableBytes =
+                request.stats().chunksizereclaimablebytes();
         }
-
+        stat.copysetStats = copysetStats;
     } else {
         LOG(WARNING) << "hearbeat manager receive request "
                      << "do not have ChunkServerStatisticInfo";
     }
+    for (const auto &info : request.hotchunks()) {
+        HotChunkStat hotChunk;
+        hotChunk.fileId = info.fileid();
+        hotChunk.logicalPoolId = info.logicalpoolid();
+        hotChunk.copysetId = info.copysetid();
+        hotChunk.chunkId = info.chunkid();
+        hotChunk.accessCount = info.accesscount();
+        hotChunk.readCount = info.readcount();
+        hotChunk.writeCount = info.writecount();
+        stat.hotChunks.push_back(hotChunk);
+    }
     topologyStat_->UpdateChunkServerStat(request.chunkserverid(), stat);
 }
 
+void HeartbeatManager::UpdateFlattenProgress(
+    const ChunkServerHeartbeatRequest &request) {
+    std::map<std::string, FlattenProgress> report;
+    for (const auto &info : request.flatteninfos()) {
+        FlattenProgress &progress = report[info.source()];
+        progress.cloneChunkNum += info.clonechunknum();
+        progress.remainingBytes += info.remainingbytes();
+    }
+
+    LockGuard lk(flattenMtx_);
+    auto &last = flattenReports_[request.chunkserverid()];
+    for (const auto &item : last) {
+        FlattenProgress &total = flattenMetrics_[item.first].total;
+        total.cloneChunkNum -=
+            std::min(total.cloneChunkNum, item.second.cloneChunkNum);
+        total.remainingBytes -=
+            std::min(total.remainingBytes, item.second.remainingBytes);
+    }
+    for (const auto &item : report) {
+        FlattenProgress &total = flattenMetrics_[item.first].total;
+        total.cloneChunkNum += item.second.cloneChunkNum;
+        total.remainingBytes += item.second.remainingBytes;
+    }
+
+    // sources whose chunks are all flattened are removed with their bvars
+    for (const auto &item : last) {
+        auto it = flattenMetrics_.find(item.first);
+        if (it != flattenMetrics_.end() &&
+            it->second.total.cloneChunkNum == 0) {
+            flattenMetrics_.erase(it);
+        }
+    }
+    for (const auto &item : report) {
+        FlattenMetric &metric = flattenMetrics_[item.first];
+        if (metric.cloneChunkNum == nullptr) {
+            std::string prefix = "mds_clone_flatten_" + item.first;
+            metric.cloneChunkNum.reset(new bvar::Status<uint64_t>(
+                prefix, "chunk_num", 0));
+            metric.remainingBytes.reset(new bvar::Status<uint64_t>(
+                prefix, "remaining_bytes", 0));
+        }
+        metric.cloneChunkNum->set_value(metric.total.cloneChunkNum);
+        metric.remainingBytes->set_value(metric.total.remainingBytes);
+    }
+
+    if (report.empty()) {
+        flattenReports_.erase(request.chunkserverid());
+    } else {
+        last.swap(report);
+    }
+}
+
+bool HeartbeatManager::GetFlattenProgress(const std::string &source,
+                                          uint64_t *cloneChunkNum,
+                                          uint64_t *remainingBytes) {
+    LockGuard lk(flattenMtx_);
+    auto it = flattenMetrics_.find(source);
+    if (it == flattenMetrics_.end()) {
+        return false;
+    }
+    *cloneChunkNum = it->second.total.cloneChunkNum;
+    *remainingBytes = it->second.total.remainingBytes;
+    return true;
+}
+
 void HeartbeatManager::ChunkServerHeartbeat(
     const ChunkServerHeartbeatRequest &request,
     ChunkServerHeartbeatResponse *response) {
@@ -207,49 +291,187 @@ void HeartbeatManager::ChunkServerHeartbeat(
 
     UpdateChunkServerDiskStatus(request);
 
-    UpdateChunkServerStatistics(request);
+    UpdateFlattenProgress(request);
+
+    // parameters are pushed every time, so that chunkservers restarted or
+    // mds config changed take effect in one heartbeat interval
+    if (enableQos_) {
+        *response->mutable_qosconf() = qosConf_;
+    }
+
+    if (request.has_baseepoch()) {
+        HandleDeltaHeartbeat(request, response);
+    } else {
+        HandleFullHeartbeat(request, response);
+    }
+}
+
+void HeartbeatManager::HandleFullHeartbeat(
+    const ChunkServerHeartbeatRequest &request,
+    ChunkServerHeartbeatResponse *response) {
+    // chunkserver which doesn't set hbEpoch never sends delta heartbeat
+    std::shared_ptr<ChunkServerView> view;
+    if (request.has_hbepoch()) {
+        view = std::make_shared<ChunkServerView>();
+        view->epoch = request.hbepoch();
+    }
+
+    std::vector<CopysetStat> copysetStats;
+    if (request.has_stats() || view != nullptr) {
+        copysetStats.reserve(request.copysetinfos_size());
+        for (auto &value : request.copysetinfos()) {
+            CopysetStat cstat;
+            BuildCopysetStat(request, value, &cstat);
+            copysetStats.push_back(cstat);
+            if (view != nullptr) {
+                CopySetKey key(value.logicalpoolid(), value.copysetid());
+                view->copysets[key] = ReportedCopySet{value, cstat};
+            }
+        }
+    }
+    UpdateChunkServerStatistics(request, copysetStats);
+
     // no copyset info in the request
     if (request.copysetinfos_size() == 0) {
         response->set_statuscode(HeartbeatStatusCode::hbRequestNoCopyset);
     }
     // dealing with copysets included in the heartbeat request
     for (auto &value : request.copysetinfos()) {
-        // discard copysets of invalid logical pool
-        ::curve::mds::topology::LogicalPool lPool;
-        if (topology_->GetLogicalPool(value.logicalpoolid(), &lPool)) {
-            if (lPool.GetLogicalPoolAvaliableFlag() != true) {
-                continue;
-            }
+        HandleCopySet(request, value, response);
+    }
+
+    SetChunkServerView(request.chunkserverid(), view);
+    if (view != nullptr) {
+        response->set_hbepoch(view->epoch);
+    }
+}
+
+void HeartbeatManager::HandleDeltaHeartbeat(
+    const ChunkServerHeartbeatRequest &request,
+    ChunkServerHeartbeatResponse *response) {
+    auto view = GetChunkServerView(request.chunkserverid());
+    UniqueLock lk;
+    if (view != nullptr) {
+        lk = UniqueLock(view->mtx);
+    }
+    if (view == nullptr || view->epoch != request.baseepoch() ||
+        !request.has_hbepoch()) {
+        LOG(WARNING) << "heartbeatManager receive delta heartbeat from "
+                     << "chunkserver " << request.chunkserverid()
+                     << " based on epoch " << request.baseepoch()
+                     << ", but cached epoch is "
+                     << (view == nullptr ? 0 : view->epoch)
+                     << ", wait for a full heartbeat";
+        // statistics of unreported copysets are unknown, so only the
+        // reported copysets are dealt with
+        for (auto &value : request.copysetinfos()) {
+            HandleCopySet(request, value, response);
         }
-        // convert copysetInfo from heartbeat format to topology format
-        ::curve::mds::topology::CopySetInfo reportCopySetInfo;
-        if (!FromHeartbeatCopySetInfoToTopologyOne(value,
-                &reportCopySetInfo)) {
-            LOG(ERROR) << "heartbeatManager receive copyset("
-                       << value.logicalpoolid() << ","
-                       << value.copysetid()
-                       << ") information, but can not transfer to topology one";
-            response->set_statuscode(
-                            HeartbeatStatusCode::hbAnalyseCopysetError);
-            continue;
+        if (view != nullptr) {
+            SetChunkServerView(request.chunkserverid(), nullptr);
         }
+        return;
+    }
+
+    for (auto &key : request.removedcopysets()) {
+        view->copysets.erase(CopySetKey(key.logicalpoolid(), key.copysetid()));
+    }
+
+    std::set<CopySetKey> reported;
+    for (auto &value : request.copysetinfos()) {
+        CopySetKey key(value.logicalpoolid(), value.copysetid());
+        CopysetStat cstat;
+        BuildCopysetStat(request, value, &cstat);
+        view->copysets[key] = ReportedCopySet{value, cstat};
+        reported.emplace(key);
+    }
+
+    std::vector<CopysetStat> copysetStats;
+    copysetStats.reserve(view->copysets.size());
+    for (auto &item : view->copysets) {
+        copysetStats.push_back(item.second.stat);
+    }
+    UpdateChunkServerStatistics(request, copysetStats);
 
-        // forward reported copyset info to CopysetConfGenerator
-        CopySetConf conf;
-        ConfigChangeInfo configChInfo;
-        if (copysetConfGenerator_->GenCopysetConf(
-                request.chunkserverid(), reportCopySetInfo,
-                value.configchangeinfo(), &conf)) {
-            CopySetConf *res = response->add_needupdatecopysets();
-            *res = conf;
+    for (auto &value : request.copysetinfos()) {
+        HandleCopySet(request, value, response);
+    }
+
+    // copysets not reported are unchanged since last heartbeat, so the
+    // topology is up to date, only operators on leaders need to be dispatched
+    for (auto &item : view->copysets) {
+        if (reported.count(item.first) != 0 ||
+            item.second.stat.leader != request.chunkserverid()) {
+            continue;
+        }
+        if (coordinator_->HasOperator(item.first)) {
+            HandleCopySet(request, item.second.info, response);
         }
+    }
 
-        // if a copyset is the leader, update (e.g. epoch) topology according
-        // to its info
-        if (request.chunkserverid() == reportCopySetInfo.GetLeader()) {
-            topoUpdater_->UpdateTopo(reportCopySetInfo);
+    view->epoch = request.hbepoch();
+    response->set_hbepoch(view->epoch);
+}
+
+void HeartbeatManager::HandleCopySet(
+    const ChunkServerHeartbeatRequest &request,
+    const ::curve::mds::heartbeat::CopySetInfo &value,
+    ChunkServerHeartbeatResponse *response) {
+    // discard copysets of invalid logical pool
+    ::curve::mds::topology::LogicalPool lPool;
+    if (topology_->GetLogicalPool(value.logicalpoolid(), &lPool)) {
+        if (lPool.GetLogicalPoolAvaliableFlag() != true) {
+            return;
         }
     }
+    // convert copysetInfo from heartbeat format to topology format
+    ::curve::mds::topology::CopySetInfo reportCopySetInfo;
+    if (!FromHeartbeatCopySetInfoToTopologyOne(value,
+            &reportCopySetInfo)) {
+        LOG(ERROR) << "heartbeatManager receive copyset("
+                   << value.logicalpoolid() << ","
+                   << value.copysetid()
+                   << ") information, but can not transfer to topology one";
+        response->set_statuscode(
+                        HeartbeatStatusCode::hbAnalyseCopysetError);
+        return;
+    }
+
+    // forward reported copyset info to CopysetConfGenerator
+    CopySetConf conf;
+    ConfigChangeInfo configChInfo;
+    if (copysetConfGenerator_->GenCopysetConf(
+            request.chunkserverid(), reportCopySetInfo,
+            value.configchangeinfo(), &conf)) {
+        CopySetConf *res = response->add_needupdatecopysets();
+        *res = conf;
+    }
+
+    // if a copyset is the leader, update (e.g. epoch) topology according
+    // to its info
+    if (request.chunkserverid() == reportCopySetInfo.GetLeader()) {
+        topoUpdater_->UpdateTopo(reportCopySetInfo);
+    }
+}
+
+std::shared_ptr<HeartbeatManager::ChunkServerView>
+HeartbeatManager::GetChunkServerView(ChunkServerIdType id) {
+    LockGuard guard(viewsMtx_);
+    auto it = views_.find(id);
+    if (it == views_.end()) {
+        return nullptr;
+    }
+    return it->second;
+}
+
+void HeartbeatManager::SetChunkServerView(ChunkServerIdType id,
+    std::shared_ptr<ChunkServerView> view) {
+    LockGuard guard(viewsMtx_);
+    if (view == nullptr) {
+        views_.erase(id);
+    } else {
+        views_[id] = view;
+    }
 }
 
 HeartbeatStatusCode HeartbeatManager::CheckRequest(
@@ -23,11 +23,13 @@
 #ifndef SRC_MDS_HEARTBEAT_HEARTBEAT_MANAGER_H_
 #define SRC_MDS_HEARTBEAT_HEARTBEAT_MANAGER_H_
 
+#include <bvar/bvar.h>
 #include <vector>
 #include <map>
 #include <atomic>
 #include <string>
 #include <memory>
+#include <unordered_map>
 
 #include "src/mds/topology/topology.h"
 #include "src/mds/common/mds_define.h"
@@ -43,6 +45,8 @@
 using ::curve::mds::topology::CopySetInfo;
 using ::curve::mds::topology::PoolIdType;
 using ::curve::mds::topology::CopySetIdType;
+using ::curve::mds::topology::CopySetKey;
+using ::curve::mds::topology::CopysetStat;
 using ::curve::mds::topology::Topology;
 using ::curve::mds::topology::TopologyStat;
 using ::curve::mds::schedule::Coordinator;
@@ -50,6 +54,9 @@ using ::curve::mds::schedule::Coordinator;
 using ::curve::common::Thread;
 using ::curve::common::Atomic;
 using ::curve::common::RWLock;
+using ::curve::common::Mutex;
+using ::curve::common::LockGuard;
+using ::curve::common::UniqueLock;
 using ::curve::common::InterruptibleSleeper;
 
 namespace curve {
@@ -70,6 +77,9 @@ namespace heartbeat {
 // 3. update topology information
 //    - update epoch, copy relationship and other statistical data of topology
 //      according to the copyset information reported by the chunkserver
+// 4. cache the copyset view reported by chunkserver, so that a delta
+//    heartbeat only carries the copysets changed since the last one
+// 5. aggregate flatten progress of clone chunks reported by chunkservers
 
 class HeartbeatManager {
  public:
@@ -110,6 +120,20 @@ class HeartbeatManager {
     void ChunkServerHeartbeat(const ChunkServerHeartbeatRequest &request,
                                 ChunkServerHeartbeatResponse *response);
 
+    /**
+     * @brief Get flatten progress of chunks cloned from a volume, summed
+     *        over the latest reports of all chunkservers
+     *
+     * @param[in] source File name of the clone source volume
+     * @param[out] cloneChunkNum Number of chunks not flattened yet
+     * @param[out] remainingBytes Bytes not copied from the source yet
+     *
+     * @return false if no chunkserver reports chunks cloned from source
+     */
+    bool GetFlattenProgress(const std::string &source,
+                            uint64_t *cloneChunkNum,
+                            uint64_t *remainingBytes);
+
  private:
     /**
      * @brief Update disk status data of chunkserver
@@ -123,10 +147,56 @@ class HeartbeatManager {
      * @brief Update statistical data of chunkserver
      *
      * @param request Heartbeat request
-     * @param response response of heartbeat request
+     * @param copysetStats statistics of all copysets on the chunkserver
      */
     void UpdateChunkServerStatistics(
-        const ChunkServerHeartbeatRequest &request);
+        const ChunkServerHeartbeatRequest &request,
+        const std::vector<CopysetStat> &copysetStats);
+
+    /**
+     * @brief Replace the flatten progress reported by the chunkserver
+     *        last time with the one in request
+     *
+     * @param request Heartbeat request
+     */
+    void UpdateFlattenProgress(const ChunkServerHeartbeatRequest &request);
+
+    /**
+     * @brief Build statistical data of a copyset reported by chunkserver
+     *
+     * @param request Heartbeat request
+     * @param info Copyset info in the request
+     * @param[out] cstat Statistical data of the copyset
+     */
+    void BuildCopysetStat(const ChunkServerHeartbeatRequest &request,
+        const ::curve::mds::heartbeat::CopySetInfo &info, CopysetStat *cstat);
+
+    /**
+     * @brief Deal with a heartbeat that reports all copysets on chunkserver,
+     *        the copyset view is cached if request carries hbEpoch
+     */
+    void HandleFullHeartbeat(const ChunkServerHeartbeatRequest &request,
+                             ChunkServerHeartbeatResponse *response);
+
+    /**
+     * @brief Deal with a heartbeat that only reports the copysets changed
+     *        since view of baseEpoch. If the cached view is not the base one,
+     *        reported copysets are handled, but hbEpoch is not set in
+     *        response, so chunkserver will send a full heartbeat next time
+     */
+    void HandleDeltaHeartbeat(const ChunkServerHeartbeatRequest &request,
+                              ChunkServerHeartbeatResponse *response);
+
+    /**
+     * @brief Generate instruction and update topology for a copyset
+     *
+     * @param request Heartbeat request
+     * @param info Copyset info reported by the chunkserver
+     * @param response Response of heartbeat request
+     */
+    void HandleCopySet(const ChunkServerHeartbeatRequest &request,
+                       const ::curve::mds::heartbeat::CopySetInfo &info,
+                       ChunkServerHeartbeatResponse *response);
 
     /**
      * @brief Background thread for heartbeat timeout inspection
@@ -166,12 +236,47 @@ class HeartbeatManager {
      */
     ChunkServerIdType GetChunkserverIdByPeerStr(std::string peer);
 
+ private:
+    struct ReportedCopySet {
+        ::curve::mds::heartbeat::CopySetInfo info;
+        CopysetStat stat;
+    };
+
+    // copysets of a chunkserver reported by its last accepted heartbeat
+    struct ChunkServerView {
+        Mutex mtx;
+        uint64_t epoch = 0;
+        std::map<CopySetKey, ReportedCopySet> copysets;
+    };
+
+    std::shared_ptr<ChunkServerView> GetChunkServerView(ChunkServerIdType id);
+
+    struct FlattenProgress {
+        uint64_t cloneChunkNum = 0;
+        uint64_t remainingBytes = 0;
+    };
+
+    // flatten progress of a clone source volume summed over chunkservers
+    struct FlattenMetric {
+        FlattenProgress total;
+        std::unique_ptr<bvar::Status<uint64_t>> cloneChunkNum;
+        std::unique_ptr<bvar::Status<uint64_t>> remainingBytes;
+    };
+
+    // set view of chunkserver, nullptr means remove
+    void SetChunkServerView(ChunkServerIdType id,
+                            std::shared_ptr<ChunkServerView> view);
+
  private:
     // Dependencies of heartbeat
     std::shared_ptr<Topology> topology_;
     std::shared_ptr<TopologyStat> topologyStat_;
     std::shared_ptr<Coordinator> coordinator_;
 
+    // QoS parameters pushed to chunkservers
+    bool enableQos_;
+    QosConf qosConf_;
+
     // healthyChecker_ health checker running in background thread
     std::shared_ptr<ChunkserverHealthyChecker> healthyChecker_;
     // topoUpdater_ update epoch, copyset relationship of topology
@@ -189,6 +294,17 @@ class HeartbeatManager {
     Atomic<bool> isStop_;
     InterruptibleSleeper sleeper_;
     int chunkserverHealthyCheckerRunInter_;
+
+    // copyset views of chunkservers which send delta heartbeat
+    Mutex viewsMtx_;
+    std::unordered_map<ChunkServerIdType,
+                       std::shared_ptr<ChunkServerView>> views_;
+
+    // flatten progress reported by each chunkserver, and the sum of them
+    Mutex flattenMtx_;
+    std::unordered_map<ChunkServerIdType,
+                       std::map<std::string, FlattenProgress>> flattenReports_;
+    std::map<std::string, FlattenMetric> flattenMetrics_;
 };
 
 }  // namespace heartbeat
@@ -22,8 +22,65 @@
 
 #include "src/mds/nameserver2/clean_core.h"
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <utility>
+
+#include "src/common/concurrent/count_down_event.h"
+
 namespace curve {
 namespace mds {
+
+using ::curve::common::CountDownEvent;
+using ::curve::common::LeakyBucket;
+using ::curve::common::TaskThreadPool;
+
+CleanCore::CleanCore(std::shared_ptr<NameServerStorage> storage,
+                     std::shared_ptr<CopysetClient> copysetClient,
+                     std::shared_ptr<AllocStatistic> allocStatistic,
+                     const CleanCoreOption& option)
+    : storage_(storage),
+      copysetClient_(copysetClient),
+      allocStatistic_(allocStatistic),
+      option_(option) {
+    if (option_.deleteBatchSize == 0) {
+        option_.deleteBatchSize = 1;
+    }
+    if (option_.segmentsPerRound == 0) {
+        option_.segmentsPerRound = 1;
+    }
+
+    if (option_.deleteConcurrency > 0) {
+        deleteWorkers_.reset(new TaskThreadPool<>());
+        LOG_IF(FATAL, deleteWorkers_->Start(option_.deleteConcurrency) != 0)
+            << "start clean core delete workers failed";
+    }
+
+    if (option_.deleteChunksPerSecond > 0) {
+        deleteThrottle_.reset(new LeakyBucket("mds_clean_delete_chunk"));
+        LOG_IF(FATAL,
+               !deleteThrottle_->SetLimit(option_.deleteChunksPerSecond, 0, 0))
+            << "set clean core delete throttle failed";
+    }
+
+    LOG(INFO) << "init clean core, delete concurrency: "
+              << option_.deleteConcurrency
+              << ", batch size: " << option_.deleteBatchSize
+              << ", chunks per second: " << option_.deleteChunksPerSecond
+              << ", segments per round: " << option_.segmentsPerRound;
+}
+
+CleanCore::~CleanCore() {
+    // let blocked deletions go first, so workers can exit
+    if (deleteThrottle_) {
+        deleteThrottle_->Stop();
+    }
+    if (deleteWorkers_) {
+        deleteWorkers_->Stop();
+    }
+}
+
 StatusCode CleanCore::CleanSnapShotFile(const FileInfo & fileInfo,
                                         TaskProgress* progress) {
     if (fileInfo.segmentsize() == 0) {
@@ -104,23 +161,32 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
 
     int  segmentNum = commonFile.length() / commonFile.segmentsize();
     uint64_t segmentSize = commonFile.segmentsize();
-    for (int i = 0; i != segmentNum; i++) {
-        // load  segment
-        PageFileSegment segment;
-        StoreStatus storeRet = storage_->GetSegment(commonFile.id(),
-                                    i * segmentSize, &segment);
-        if (storeRet == StoreStatus::KeyNotExist) {
-            continue;
-        } else if (storeRet !=  StoreStatus::OK) {
-            LOG(ERROR) << "Clean common File Error: "
-                << "GetSegment Error, inodeid = " << commonFile.id()
-                << ", filename = " << commonFile.filename()
-                << ", offset = " << i * segmentSize;
-            progress->SetStatus(TaskStatus::FAILED);
-            return StatusCode::kCommonFileDeleteError;
+    int segmentsPerRound = option_.segmentsPerRound;
+    for (int i = 0; i < segmentNum; i += segmentsPerRound) {
+        int end = std::min(segmentNum, i + segmentsPerRound);
+
+        // load segments of this round
+        std::vector<PageFileSegment> segments;
+        std::vector<uint64_t> offsets;
+        for (int j = i; j < end; j++) {
+            PageFileSegment segment;
+            StoreStatus storeRet = storage_->GetSegment(commonFile.id(),
+                                        j * segmentSize, &segment);
+            if (storeRet == StoreStatus::KeyNotExist) {
+                continue;
+            } else if (storeRet !=  StoreStatus::OK) {
+                LOG(ERROR) << "Clean common File Error: "
+                    << "GetSegment Error, inodeid = " << commonFile.id()
+                    << ", filename = " << commonFile.filename()
+                    << ", offset = " << j * segmentSize;
+                progress->SetStatus(TaskStatus::FAILED);
+                return StatusCode::kCommonFileDeleteError;
+            }
+            segments.emplace_back(std::move(segment));
+            offsets.push_back(j * segmentSize);
         }
 
-        int ret = DeleteChunksInSegment(segment, commonFile.seqnum());
+        int ret = DeleteChunksInSegments(segments, commonFile.seqnum());
         if (ret != 0) {
             LOG(ERROR) << "Clean common File Error: "
                        << ", ret = " << ret
@@ -131,22 +197,25 @@ StatusCode CleanCore::CleanFile(const FileInfo & commonFile,
             return StatusCode::kCommonFileDeleteError;
         }
 
-        // delete segment
-        int64_t revision;
-        storeRet = storage_->DeleteSegment(
-            commonFile.id(), i * segmentSize, &revision);
-        if (storeRet != StoreStatus::OK) {
-            LOG(ERROR) << "Clean common File Error: "
-            << "DeleteSegment Error, inodeid = " << commonFile.id()
-            << ", filename = " << commonFile.filename()
-            << ", offset = " << i * segmentSize
-            << ", sequenceNum = " << commonFile.seqnum();
-            progress->SetStatus(TaskStatus::FAILED);
-            return StatusCode::kCommonFileDeleteError;
+        // delete segments
+        for (size_t k = 0; k < segments.size(); k++) {
+            const PageFileSegment& segment = segments[k];
+            int64_t revision;
+            StoreStatus storeRet = storage_->DeleteSegment(
+                commonFile.id(), offsets[k], &revision);
+            if (storeRet != StoreStatus::OK) {
+                LOG(ERROR) << "Clean common File Error: "
+                << "DeleteSegment Error, inodeid = " << commonFile.id()
+                << ", filename = " << commonFile.filename()
+                << ", offset = " << offsets[k]
+                << ", sequenceNum = " << commonFile.seqnum();
+                progress->SetStatus(TaskStatus::FAILED);
+                return StatusCode::kCommonFileDeleteError;
+            }
+            allocStatistic_->DeAllocSpace(segment.logicalpoolid(),
+                segment.segmentsize(), revision);
         }
-        allocStatistic_->DeAllocSpace(segment.logicalpoolid(),
-            segment.segmentsize(), revision);
-        progress->SetProgress(100 * (i + 1) / segmentNum);
+        progress->SetProgress(100 * end / segmentNum);
     }
 
     // delete the storage
@@ -183,7 +252,7 @@ StatusCode CleanCore::CleanDiscardSegment(
     timer.start();
 
     // delete chunks
-    int ret = DeleteChunksInSegment(segment, seq);
+    int ret = DeleteChunksInSegments({segment}, seq);
     if (ret != 0) {
         LOG(ERROR) << "CleanDiscardSegment failed, DeleteChunk Error, ret = "
                    << ret << ", filename = " << fileInfo.filename()
@@ -219,21 +288,91 @@ StatusCode CleanCore::CleanDiscardSegment(
     return StatusCode::kOK;
 }
 
-int CleanCore::DeleteChunksInSegment(const PageFileSegment& segment,
-                                     const SeqNum& seq) {
-    const LogicalPoolID logicalPoolId = segment.logicalpoolid();
-    for (int i = 0; i < segment.chunks_size(); ++i) {
-        int ret = copysetClient_->DeleteChunk(
-            logicalPoolId,
-            segment.chunks()[i].copysetid(),
-            segment.chunks()[i].chunkid(),
-            seq);
+int CleanCore::DeleteChunksInSegments(
+    const std::vector<PageFileSegment>& segments, const SeqNum& seq) {
+    // group chunks by copyset, so one rpc deletes a batch of chunks
+    std::map<std::pair<LogicalPoolID, CopysetID>,
+             std::vector<ChunkID>> copysetChunks;
+    for (const auto& segment : segments) {
+        for (int i = 0; i < segment.chunks_size(); ++i) {
+            copysetChunks[{segment.logicalpoolid(),
+                           segment.chunks(i).copysetid()}]
+                .push_back(segment.chunks(i).chunkid());
+        }
+    }
+
+    std::vector<ChunkBatch> batches;
+    for (auto& item : copysetChunks) {
+        const auto& chunkIds = item.second;
+        for (size_t i = 0; i < chunkIds.size();
+             i += option_.deleteBatchSize) {
+            size_t end = std::min<size_t>(chunkIds.size(),
+                                          i + option_.deleteBatchSize);
+            ChunkBatch batch;
+            batch.logicalPoolId = item.first.first;
+            batch.copysetId = item.first.second;
+            batch.chunkIds.assign(chunkIds.begin() + i,
+                                  chunkIds.begin() + end);
+            batches.push_back(std::move(batch));
+        }
+    }
 
+    if (!deleteWorkers_) {
+        for (const auto& batch : batches) {
+            int ret = DeleteChunkBatch(batch, seq);
+            if (ret != 0) {
+                return ret;
+            }
+        }
+        return 0;
+    }
+
+    // batches after the first failure are skipped
+    std::atomic<int> result(0);
+    CountDownEvent event(batches.size());
+    for (const auto& batch : batches) {
+        deleteWorkers_->Enqueue([this, &batch, &seq, &result, &event]() {
+            if (result.load(std::memory_order_acquire) == 0) {
+                int ret = DeleteChunkBatch(batch, seq);
+                if (ret != 0) {
+                    int expected = 0;
+                    result.compare_exchange_strong(expected, ret);
+                }
+            }
+            event.Signal();
+        });
+    }
+    event.Wait();
+
+    return result.load(std::memory_order_acquire);
+}
+
+int CleanCore::DeleteChunkBatch(const ChunkBatch& batch, const SeqNum& seq) {
+    if (deleteThrottle_) {
+        deleteThrottle_->Add(batch.chunkIds.size());
+    }
+
+    if (option_.deleteBatchSize > 1) {
+        int ret = copysetClient_->DeleteChunks(
+            batch.logicalPoolId, batch.copysetId, batch.chunkIds, seq);
+        if (ret != 0) {
+            LOG(ERROR) << "DeleteChunks failed, ret = " << ret
+                       << ", logicalpoolid = " << batch.logicalPoolId
+                       << ", copysetid = " << batch.copysetId
+                       << ", chunk num = " << batch.chunkIds.size()
+                       << ", seq = " << seq;
+        }
+        return ret;
+    }
+
+    for (auto chunkId : batch.chunkIds) {
+        int ret = copysetClient_->DeleteChunk(
+            batch.logicalPoolId, batch.copysetId, chunkId, seq);
         if (ret != 0) {
             LOG(ERROR) << "DeleteChunk failed, ret = " << ret
-                       << ", logicalpoolid = " << logicalPoolId
-                       << ", copysetid = " << segment.chunks()[i].copysetid()
-                       << ", chunkid = " << segment.chunks()[i].chunkid()
+                       << ", logicalpoolid = " << batch.logicalPoolId
+                       << ", copysetid = " << batch.copysetId
+                       << ", chunkid = " << chunkId
                        << ", seq = " << seq;
             return ret;
         }
@@ -25,6 +25,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
+#include "src/common/concurrent/task_thread_pool.h"
+#include "src/common/leaky_bucket.h"
 #include "src/mds/nameserver2/namespace_storage.h"
 #include "src/mds/common/mds_define.h"
 #include "src/mds/nameserver2/task_progress.h"
@@ -38,14 +41,25 @@ using ::curve::mds::topology::Topology;
 namespace curve {
 namespace mds {
 
+struct CleanCoreOption {
+    // 并发删除chunk的线程数，0表示在调用线程中逐个copyset删除
+    uint32_t deleteConcurrency = 0;
+    // 一次DeleteChunks rpc中最多包含的chunk数量，1表示使用DeleteChunk
+    uint32_t deleteBatchSize = 1;
+    // 每秒最多删除的chunk数量，所有删除任务共享，0表示不限制
+    uint64_t deleteChunksPerSecond = 0;
+    // 删除普通文件时，每一轮一起删除chunk的segment数量
+    uint32_t segmentsPerRound = 1;
+};
+
 class CleanCore {
  public:
     CleanCore(std::shared_ptr<NameServerStorage> storage,
         std::shared_ptr<CopysetClient> copysetClient,
-        std::shared_ptr<AllocStatistic> allocStatistic)
-        : storage_(storage),
-          copysetClient_(copysetClient),
-          allocStatistic_(allocStatistic) {}
+        std::shared_ptr<AllocStatistic> allocStatistic,
+        const CleanCoreOption& option = CleanCoreOption());
+
+    ~CleanCore();
 
     /**
      * @brief 删除快照文件，更新task状态
@@ -74,12 +88,32 @@ class CleanCore {
                                    TaskProgress* progress);
 
  private:
-    int DeleteChunksInSegment(const PageFileSegment& segment,
-                              const SeqNum& seq);
+    // 同一个copyset上的一批chunk
+    struct ChunkBatch {
+        LogicalPoolID logicalPoolId;
+        CopysetID copysetId;
+        std::vector<ChunkID> chunkIds;
+    };
+
+    /**
+     * @brief 删除一组segment中的所有chunk，chunk按copyset分组，
+     *        每组拆分成不超过deleteBatchSize的批次并发删除
+     * @return 成功返回0，否则返回第一个失败批次的错误码
+     */
+    int DeleteChunksInSegments(const std::vector<PageFileSegment>& segments,
+                               const SeqNum& seq);
+
+    int DeleteChunkBatch(const ChunkBatch& batch, const SeqNum& seq);
 
     std::shared_ptr<NameServerStorage> storage_;
     std::shared_ptr<CopysetClient> copysetClient_;
     std::shared_ptr<AllocStatistic> allocStatistic_;
+
+    CleanCoreOption option_;
+    // 删除chunk的线程池，deleteConcurrency为0时为空
+    std::unique_ptr<::curve::common::TaskThreadPool<>> deleteWorkers_;
+    // 删除chunk的限流，deleteChunksPerSecond为0时为空
+    std::unique_ptr<::curve::common::LeakyBucket> deleteThrottle_;
 };
 
 }  // namespace mds
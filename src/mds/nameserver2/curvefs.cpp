@@ -1282,6 +1282,105 @@ StatusCode CurveFS::GetOrAllocateSegment(const std::string & filename,
     }
 }
 
+StatusCode CurveFS::GetOrAllocateSegments(const std::string & filename,
+        const std::vector<offset_t> &offsets, bool allocateIfNoExist,
+        std::vector<PageFileSegment> *segments) {
+    assert(segments != nullptr);
+
+    if (offsets.empty() || offsets.size() > kMaxBatchSegments) {
+        LOG(INFO) << "invalid segment count " << offsets.size()
+                  << ", filename = " << filename;
+        return StatusCode::kParaError;
+    }
+
+    FileInfo  fileInfo;
+    auto ret = GetFileInfo(filename, &fileInfo);
+    if (ret != StatusCode::kOK) {
+        LOG(INFO) << "get source file error, errCode = " << ret;
+        return  ret;
+    }
+
+    if (fileInfo.filetype() != FileType::INODE_PAGEFILE) {
+        LOG(INFO) << "not pageFile, can't do this";
+        return StatusCode::kParaError;
+    }
+
+    std::set<offset_t> uniqueOffsets;
+    for (auto offset : offsets) {
+        if (offset % fileInfo.segmentsize() != 0) {
+            LOG(INFO) << "offset not align with segment";
+            return StatusCode::kParaError;
+        }
+
+        // etcd rejects a transaction that puts the same key twice
+        if (!uniqueOffsets.insert(offset).second) {
+            LOG(INFO) << "duplicate segment offset " << offset;
+            return StatusCode::kParaError;
+        }
+
+        if (offset + fileInfo.segmentsize() > fileInfo.length()) {
+            LOG(INFO) << "bigger than file length, first extentFile";
+            return StatusCode::kParaError;
+        }
+    }
+
+    segments->clear();
+    std::vector<PageFileSegment> allocated;
+    for (auto offset : offsets) {
+        PageFileSegment segment;
+        auto storeRet = storage_->GetSegment(fileInfo.id(), offset, &segment);
+        if (storeRet == StoreStatus::OK) {
+            segments->emplace_back(std::move(segment));
+            continue;
+        } else if (storeRet != StoreStatus::KeyNotExist) {
+            return StatusCode::KInternalError;
+        }
+
+        if (allocateIfNoExist == false) {
+            continue;
+        }
+
+        auto ifok = chunkSegAllocator_->AllocateChunkSegment(
+                        fileInfo.filetype(), fileInfo.segmentsize(),
+                        fileInfo.chunksize(), offset, &segment);
+        if (ifok == false) {
+            LOG(ERROR) << "AllocateChunkSegment error";
+            return StatusCode::kSegmentAllocateError;
+        }
+        allocated.emplace_back(std::move(segment));
+    }
+
+    if (allocated.empty()) {
+        return StatusCode::kOK;
+    }
+
+    int64_t revision;
+    if (storage_->PutSegments(fileInfo.id(), allocated, &revision)
+        != StoreStatus::OK) {
+        LOG(ERROR) << "PutSegments fail, fileInfo.id() = " << fileInfo.id()
+                   << ", count = " << allocated.size();
+        return StatusCode::kStorageError;
+    }
+
+    // segments in one transaction share the same revision, so the change
+    // of each logical pool is counted once
+    std::map<PoolIdType, int64_t> allocSize;
+    for (const auto& segment : allocated) {
+        allocSize[segment.logicalpoolid()] += segment.segmentsize();
+    }
+    for (const auto& item : allocSize) {
+        allocStatistic_->AllocSpace(item.first, item.second, revision);
+    }
+
+    LOG(INFO) << "alloc " << allocated.size()
+              << " segments success, fileInfo.id() = " << fileInfo.id()
+              << ", first offset = " << allocated.front().startoffset();
+    segments->insert(segments->end(),
+                     std::make_move_iterator(allocated.begin()),
+                     std::make_move_iterator(allocated.end()));
+    return StatusCode::kOK;
+}
+
 StatusCode CurveFS::DeAllocateSegment(const std::string& fileName,
                                       uint64_t offset) {
     FileInfo fileInfo;
@@ -50,6 +50,10 @@ using curve::common::ChunkServerLocation;
 namespace curve {
 namespace mds {
 
+// max number of segments in a GetOrAllocateSegments request, smaller than
+// the default max operations of an etcd transaction
+const uint32_t kMaxBatchSegments = 64;
+
 struct RootAuthOption {
     std::string rootOwner;
     std::string rootPassword;
@@ -289,6 +293,24 @@ class CurveFS {
         offset_t offset,
         bool allocateIfNoExist, PageFileSegment *segment);
 
+    /**
+     *  @brief query several segments of a file, segments that do not exist
+     *         are allocated in a single transaction if allocateIfNoExist
+     *
+     *  @param filename
+     *  @param offsets: segment offsets, at most kMaxBatchSegments
+     *  @param allocateIfNoExist: If the segment does not exist,
+     *                            whether or not creating a new one
+     *  @param segments: Return the queried segments, not allocated segments
+     *                   are skipped if allocateIfNoExist is false
+     *  @return StatusCode::kOK if succeeded
+     */
+    StatusCode GetOrAllocateSegments(
+        const std::string & filename,
+        const std::vector<offset_t> &offsets,
+        bool allocateIfNoExist,
+        std::vector<PageFileSegment> *segments);
+
     /**
      * @brief deallocate file segment start at offset
      * @param filename
@@ -32,8 +32,46 @@
 namespace curve {
 namespace mds {
 
+namespace {
+
+// number of file record shards
+const uint32_t kFileRecordShardNum = 64;
+// a record times out after not updated for kTimeoutTimes * expiredTime,
+// same as FileRecord::IsTimeout
+const uint64_t kTimeoutTimes = 10;
+
+}  // namespace
+
+FileRecordManager::FileRecordManager() {
+    shards_.reserve(kFileRecordShardNum);
+    for (uint32_t i = 0; i < kFileRecordShardNum; ++i) {
+        shards_.emplace_back(new Shard());
+    }
+}
+
 void FileRecordManager::Init(const FileRecordOptions& fileRecordOptions) {
     fileRecordOptions_ = fileRecordOptions;
+    if (fileRecordOptions_.scanIntervalTimeUs == 0) {
+        fileRecordOptions_.scanIntervalTimeUs = 1;
+    }
+
+    // a scheduled record is at most this number of ticks ahead
+    uint64_t slots =
+        kTimeoutTimes * fileRecordOptions_.fileRecordExpiredTimeUs /
+            fileRecordOptions_.scanIntervalTimeUs + 3;
+    for (auto& shard : shards_) {
+        WriteLockGuard lk(shard->rwlock);
+        shard->wheel.resize(slots);
+    }
+}
+
+uint64_t FileRecordManager::GetOpenFileNum() const {
+    uint64_t num = 0;
+    for (const auto& shard : shards_) {
+        ReadLockGuard lk(shard->rwlock);
+        num += shard->fileRecords.size();
+    }
+    return num;
 }
 
 void FileRecordManager::Start() {
@@ -53,10 +91,11 @@ void FileRecordManager::Stop() {
 
 bool FileRecordManager::GetMinimumFileClientVersion(
     const std::string& fileName, std::string *clientVersion) const {
-    ReadLockGuard lk(rwlock_);
+    Shard* shard = GetShard(fileName);
+    ReadLockGuard lk(shard->rwlock);
 
-    auto it = fileRecords_.find(fileName);
-    if (it == fileRecords_.end()) {
+    auto it = shard->fileRecords.find(fileName);
+    if (it == shard->fileRecords.end()) {
         return false;
     }
 
@@ -87,11 +126,12 @@ void FileRecordManager::UpdateFileRecord(const std::string& fileName,
         return;
     }
 
+    Shard* shard = GetShard(fileName);
     do {
-        ReadLockGuard lk(rwlock_);
+        ReadLockGuard lk(shard->rwlock);
 
-        auto it = fileRecords_.find(fileName);
-        if (it == fileRecords_.end()) {
+        auto it = shard->fileRecords.find(fileName);
+        if (it == shard->fileRecords.end()) {
             break;
         }
 
@@ -111,12 +151,14 @@ void FileRecordManager::UpdateFileRecord(const std::string& fileName,
               << ", clientVersion = " << clientVersion << ", client endpoint = "
               << butil::endpoint2str(clientEp).c_str();
 
-    WriteLockGuard lk(rwlock_);
-    if (fileRecords_.count(fileName) == 0) {
-        fileRecords_.emplace(fileName, std::map<butil::EndPoint, FileRecord>{});
+    WriteLockGuard lk(shard->rwlock);
+    auto ret = shard->fileRecords[fileName].emplace(clientEp, record);
+    if (ret.second) {
+        Schedule(shard, fileName, &ret.first->second);
+    } else {
+        // added by others
+        ret.first->second.Update(clientVersion, clientEp);
     }
-
-    fileRecords_[fileName].emplace(clientEp, record);
 }
 
 void FileRecordManager::RemoveFileRecord(const std::string& filename,
@@ -131,9 +173,11 @@ void FileRecordManager::RemoveFileRecord(const std::string& filename,
         return;
     }
 
-    WriteLockGuard lk(rwlock_);
-    auto it = fileRecords_.find(filename);
-    if (it == fileRecords_.end()) {
+    // its entry in the wheel is dropped when checked
+    Shard* shard = GetShard(filename);
+    WriteLockGuard lk(shard->rwlock);
+    auto it = shard->fileRecords.find(filename);
+    if (it == shard->fileRecords.end()) {
         return;
     }
 
@@ -141,39 +185,85 @@ void FileRecordManager::RemoveFileRecord(const std::string& filename,
 }
 
 void FileRecordManager::Scan() {
+    uint64_t lastTick =
+        ToTick(curve::common::TimeUtility::GetTimeofDayUs());
     while (sleeper_.wait_for(
         std::chrono::microseconds(fileRecordOptions_.scanIntervalTimeUs))) {
-        WriteLockGuard lk(rwlock_);
-
-        auto iter = fileRecords_.begin();
-        while (iter != fileRecords_.end()) {
-            auto recordIter = iter->second.begin();
-            while (recordIter != iter->second.end()) {
-                if (recordIter->second.IsTimeout()) {
-                    LOG(INFO)
-                        << "Remove timeout file record, filename = "
-                        << iter->first << ", last update time = "
-                        << curve::common::TimeUtility::TimeStampToStandard(
-                               recordIter->second.GetUpdateTime() / 1000000)
-                        << ", endpoint = "
-                        << butil::endpoint2str(
-                               recordIter->second.GetClientEndPoint())
-                               .c_str();
-                    recordIter = iter->second.erase(recordIter);
-                } else {
-                    ++recordIter;
-                }
+        uint64_t nowTick =
+            ToTick(curve::common::TimeUtility::GetTimeofDayUs());
+        for (auto& shard : shards_) {
+            ScanShard(shard.get(), lastTick, nowTick);
+        }
+        lastTick = nowTick;
+    }
+}
+
+void FileRecordManager::ScanShard(Shard* shard, uint64_t lastTick,
+                                  uint64_t nowTick) {
+    WriteLockGuard lk(shard->rwlock);
+    const uint64_t slots = shard->wheel.size();
+
+    // each slot is checked at most once
+    uint64_t tick = lastTick + 1;
+    if (nowTick - lastTick > slots) {
+        tick = nowTick - slots + 1;
+    }
+
+    for (; tick <= nowTick; ++tick) {
+        auto& slot = shard->wheel[tick % slots];
+        std::vector<WheelEntry> entries;
+        entries.swap(slot);
+
+        for (auto& entry : entries) {
+            if (entry.tick > nowTick) {
+                slot.emplace_back(std::move(entry));
+                continue;
             }
 
+            auto iter = shard->fileRecords.find(entry.filename);
+            if (iter == shard->fileRecords.end()) {
+                continue;
+            }
+
+            // record is removed, or the entry is outdated
+            auto recordIter = iter->second.find(entry.ep);
+            if (recordIter == iter->second.end() ||
+                recordIter->second.GetExpireTick() != entry.tick) {
+                continue;
+            }
+
+            if (!recordIter->second.IsTimeout()) {
+                // refreshed since scheduled
+                Schedule(shard, entry.filename, &recordIter->second);
+                continue;
+            }
+
+            LOG(INFO) << "Remove timeout file record, filename = "
+                      << entry.filename << ", last update time = "
+                      << curve::common::TimeUtility::TimeStampToStandard(
+                             recordIter->second.GetUpdateTime() / 1000000)
+                      << ", endpoint = "
+                      << butil::endpoint2str(entry.ep).c_str();
+            iter->second.erase(recordIter);
             if (iter->second.empty()) {
-                iter = fileRecords_.erase(iter);
-            } else {
-                ++iter;
+                shard->fileRecords.erase(iter);
             }
         }
     }
 }
 
+void FileRecordManager::Schedule(Shard* shard, const std::string& filename,
+                                 FileRecord* record) {
+    uint64_t expireUs =
+        record->GetUpdateTime() +
+        kTimeoutTimes * fileRecordOptions_.fileRecordExpiredTimeUs;
+    // check it after it times out
+    uint64_t tick = ToTick(expireUs) + 1;
+    record->SetExpireTick(tick);
+    shard->wheel[tick % shard->wheel.size()].push_back(
+        WheelEntry{filename, record->GetClientEndPoint(), tick});
+}
+
 void FileRecordManager::GetRecordParam(ProtoSession* protoSession) const {
     protoSession->set_sessionid("");
     protoSession->set_leasetime(fileRecordOptions_.fileRecordExpiredTimeUs);
@@ -185,9 +275,9 @@ void FileRecordManager::GetRecordParam(ProtoSession* protoSession) const {
 std::set<butil::EndPoint> FileRecordManager::ListAllClient() const {
     std::set<butil::EndPoint> res;
 
-    {
-        ReadLockGuard lk(rwlock_);
-        for (const auto& files : fileRecords_) {
+    for (const auto& shard : shards_) {
+        ReadLockGuard lk(shard->rwlock);
+        for (const auto& files : shard->fileRecords) {
             for (const auto& r : files.second) {
                 const auto& ep = r.second.GetClientEndPoint();
                 if (ep.port != kInvalidPort) {
@@ -202,9 +292,10 @@ std::set<butil::EndPoint> FileRecordManager::ListAllClient() const {
 
 bool FileRecordManager::FindFileMountPoint(
     const std::string& fileName, std::vector<butil::EndPoint>* eps) const {
-    ReadLockGuard lk(rwlock_);
-    auto iter = fileRecords_.find(fileName);
-    if (iter == fileRecords_.end()) {
+    Shard* shard = GetShard(fileName);
+    ReadLockGuard lk(shard->rwlock);
+    auto iter = shard->fileRecords.find(fileName);
+    if (iter == shard->fileRecords.end()) {
         return false;
     }
 
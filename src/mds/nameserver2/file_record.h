@@ -26,6 +26,7 @@
 #include <butil/endpoint.h>
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -63,13 +64,15 @@ class FileRecord {
         : updateTimeUs_(fileRecord.updateTimeUs_),
           timeoutUs_(fileRecord.timeoutUs_),
           clientVersion_(fileRecord.clientVersion_),
-          endPoint_(fileRecord.endPoint_) {}
+          endPoint_(fileRecord.endPoint_),
+          expireTick_(fileRecord.expireTick_) {}
 
     FileRecord& operator=(const FileRecord& fileRecord) {
         updateTimeUs_ = fileRecord.updateTimeUs_;
         timeoutUs_ = fileRecord.timeoutUs_;
         clientVersion_ = fileRecord.clientVersion_;
         endPoint_ = fileRecord.endPoint_;
+        expireTick_ = fileRecord.expireTick_;
         return *this;
     }
 
@@ -122,6 +125,18 @@ class FileRecord {
         return endPoint_;
     }
 
+    /**
+     * @brief Get/Set the tick of expiry wheel that the record is scheduled,
+     *        it's protected by the lock of FileRecordManager
+     */
+    uint64_t GetExpireTick() const {
+        return expireTick_;
+    }
+
+    void SetExpireTick(uint64_t tick) {
+        expireTick_ = tick;
+    }
+
  private:
     // latest update time in μs
     uint64_t updateTimeUs_;
@@ -131,12 +146,25 @@ class FileRecord {
     std::string clientVersion_;
     // client endpoint
     butil::EndPoint endPoint_;
+    // tick of expiry wheel
+    uint64_t expireTick_ = 0;
     // mutex for updating the time
     mutable curve::common::Mutex mtx_;
 };
 
+/**
+ * File records are hashed to shards by filename, so refreshes of different
+ * files don't contend on one lock. Each shard also keeps an expiry wheel,
+ * a record is put into the slot of the tick it may expire at, and Scan()
+ * only checks records in the passed slots. Refreshing a record doesn't
+ * touch the wheel, a refreshed record is rescheduled when its slot is
+ * checked, so the scan cost is proportional to records that may expire
+ * instead of all records.
+ */
 class FileRecordManager {
  public:
+    FileRecordManager();
+
     virtual ~FileRecordManager() = default;
 
     /**
@@ -149,10 +177,7 @@ class FileRecordManager {
      * @brief Get the opened file number
      * @return the number of the opened files
      */
-    uint64_t GetOpenFileNum() const {
-        ReadLockGuard lk(rwlock_);
-        return fileRecords_.size();
-    }
+    uint64_t GetOpenFileNum() const;
 
     /**
      * @brief Get the expired time of the file
@@ -207,20 +232,54 @@ class FileRecordManager {
                                     std::vector<butil::EndPoint>* eps) const;
 
  private:
+    struct WheelEntry {
+        std::string filename;
+        butil::EndPoint ep;
+        uint64_t tick;
+    };
+
+    struct Shard {
+        // file records
+        // There are two scenarios for endpoints of map's key
+        // 1. if client enables register to mds, endpoint is corresponding to
+        //    client host ip and dummy server port
+        // 2. otherwise, ip is equal to rpc's remote_side and port is
+        //    `kInvalidPort'
+        std::unordered_map<std::string, std::map<butil::EndPoint, FileRecord>>
+            fileRecords;
+        // expiry wheel, slot is indexed by tick % wheel.size()
+        std::vector<std::vector<WheelEntry>> wheel;
+        // rwlock for fileRecords and wheel
+        mutable curve::common::RWLock rwlock;
+    };
+
     /**
      * @brief Function for periodic scanning, it deletes timed-out file records
      */
     void Scan();
 
-    // file records
-    // There are two scenarios for endpoints of map's key
-    // 1. if client enables register to mds, endpoint is corresponding to client
-    //    host ip and dummy server port
-    // 2. otherwise, ip is equal to rpc's remote_side and port is `kInvalidPort'
-    std::unordered_map<std::string, std::map<butil::EndPoint, FileRecord>>
-        fileRecords_;
-    // rwlock for fileRecords_
-    mutable curve::common::RWLock rwlock_;
+    /**
+     * @brief check records in the slots of (lastTick, nowTick]
+     */
+    void ScanShard(Shard* shard, uint64_t lastTick, uint64_t nowTick);
+
+    /**
+     * @brief put record into the slot of the tick it may expire at,
+     *        caller must hold the write lock of shard
+     */
+    void Schedule(Shard* shard, const std::string& filename,
+                  FileRecord* record);
+
+    uint64_t ToTick(uint64_t timeUs) const {
+        return timeUs / fileRecordOptions_.scanIntervalTimeUs;
+    }
+
+    Shard* GetShard(const std::string& filename) const {
+        return shards_[std::hash<std::string>{}(filename) % shards_.size()]
+            .get();
+    }
+
+    std::vector<std::unique_ptr<Shard>> shards_;
     // the thread for scanning in backend
     curve::common::Thread scanThread_;
 
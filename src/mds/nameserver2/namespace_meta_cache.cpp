@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include "src/mds/nameserver2/namespace_meta_cache.h"
+
+#include <glog/logging.h>
+
+namespace curve {
+namespace mds {
+
+NameSpaceMetaCache::NameSpaceMetaCache(uint32_t shardNum, uint64_t maxCount,
+                                       std::shared_ptr<CacheMetrics> metrics)
+    : shardNum_(shardNum == 0 ? 1 : shardNum) {
+    // files and segments share the capacity, and each shard holds a part
+    uint64_t shardCount = maxCount / shardNum_ / 2;
+    if (maxCount != 0 && shardCount == 0) {
+        shardCount = 1;
+    }
+
+    files_.reserve(shardNum_);
+    segments_.reserve(shardNum_);
+    for (uint32_t i = 0; i < shardNum_; ++i) {
+        files_.emplace_back(new Shard<FileInfo>(shardCount, metrics));
+        segments_.emplace_back(
+            new Shard<PageFileSegment>(shardCount, metrics));
+    }
+
+    LOG(INFO) << "init namespace meta cache, shard num: " << shardNum_
+              << ", max count per shard: " << shardCount;
+}
+
+void NameSpaceMetaCache::PutFile(const std::string& key,
+                                 const FileInfo& fileInfo) {
+    files_[ShardIndex(key)]->Put(
+        key, std::make_shared<const FileInfo>(fileInfo));
+}
+
+bool NameSpaceMetaCache::GetFile(const std::string& key, FileInfo* fileInfo) {
+    std::shared_ptr<const FileInfo> cached;
+    if (!files_[ShardIndex(key)]->Get(key, &cached)) {
+        return false;
+    }
+
+    fileInfo->CopyFrom(*cached);
+    return true;
+}
+
+void NameSpaceMetaCache::PutSegment(const std::string& key,
+                                    const PageFileSegment& segment) {
+    segments_[ShardIndex(key)]->Put(
+        key, std::make_shared<const PageFileSegment>(segment));
+}
+
+bool NameSpaceMetaCache::GetSegment(const std::string& key,
+                                    PageFileSegment* segment) {
+    std::shared_ptr<const PageFileSegment> cached;
+    if (!segments_[ShardIndex(key)]->Get(key, &cached)) {
+        return false;
+    }
+
+    segment->CopyFrom(*cached);
+    return true;
+}
+
+void NameSpaceMetaCache::Remove(const std::string& key) {
+    size_t index = ShardIndex(key);
+    files_[index]->Remove(key);
+    segments_[index]->Remove(key);
+}
+
+uint64_t NameSpaceMetaCache::Size() {
+    uint64_t size = 0;
+    for (uint32_t i = 0; i < shardNum_; ++i) {
+        size += files_[i]->Size() + segments_[i]->Size();
+    }
+    return size;
+}
+
+}  // namespace mds
+}  // namespace curve
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_MDS_NAMESERVER2_NAMESPACE_META_CACHE_H_
+#define SRC_MDS_NAMESERVER2_NAMESPACE_META_CACHE_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proto/nameserver2.pb.h"
+#include "src/common/lru_cache.h"
+
+namespace curve {
+namespace mds {
+
+using ::curve::common::CacheMetrics;
+
+struct NameSpaceMetaCacheOption {
+    // number of shards, 0 means using the serialized string cache
+    uint32_t shardNum = 0;
+    // max number of cached FileInfo and PageFileSegment
+    uint64_t maxCount = 100000;
+    // whether load all FileInfo by a range scan when mds becomes leader
+    bool warmup = false;
+};
+
+/**
+ * Typed cache of FileInfo and PageFileSegment in front of etcd.
+ * Values are kept decoded, so a hit costs a message copy instead of a
+ * protobuf parse. Keys are hashed to shards, each shard is an independent
+ * LRUCache with its own lock.
+ *
+ * MDS leader is the only writer of namespace metadata and the cache is
+ * write-through, so entries are invalidated by the storage operations
+ * themselves. A new leader fills the cache from a range scan of etcd.
+ */
+class NameSpaceMetaCache {
+ public:
+    NameSpaceMetaCache(uint32_t shardNum, uint64_t maxCount,
+                       std::shared_ptr<CacheMetrics> metrics = nullptr);
+
+    void PutFile(const std::string& key, const FileInfo& fileInfo);
+
+    bool GetFile(const std::string& key, FileInfo* fileInfo);
+
+    void PutSegment(const std::string& key, const PageFileSegment& segment);
+
+    bool GetSegment(const std::string& key, PageFileSegment* segment);
+
+    /**
+     * @brief remove key from cache, key can be either a file or a segment
+     */
+    void Remove(const std::string& key);
+
+    uint64_t Size();
+
+ private:
+    template <typename T>
+    using Shard = ::curve::common::LRUCache<std::string,
+                                            std::shared_ptr<const T>>;
+
+    template <typename T>
+    using Shards = std::vector<std::unique_ptr<Shard<T>>>;
+
+    size_t ShardIndex(const std::string& key) const {
+        return std::hash<std::string>{}(key) % shardNum_;
+    }
+
+ private:
+    uint32_t shardNum_;
+    Shards<FileInfo> files_;
+    Shards<PageFileSegment> segments_;
+};
+
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_NAMESERVER2_NAMESPACE_META_CACHE_H_
@@ -506,6 +506,125 @@ void NameSpaceService::GetOrAllocateSegment(
     return;
 }
 
+void NameSpaceService::GetOrAllocateSegments(
+    ::google::protobuf::RpcController* controller,
+    const ::curve::mds::GetOrAllocateSegmentsRequest* request,
+    ::curve::mds::GetOrAllocateSegmentsResponse* response,
+    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+    ExpiredTime expiredTime;
+
+    uint64_t firstOffset = request->offsets_size() > 0 ?
+                           request->offsets(0) : 0;
+    if (!isPathValid(request->filename())) {
+        response->set_statuscode(StatusCode::kParaError);
+        LOG(ERROR) << "logid = " << cntl->log_id()
+            << ", GetOrAllocateSegments request path is invalid, filename = "
+            << request->filename()
+            << ", first offset = " << firstOffset
+            << ", count = " << request->offsets_size();
+        return;
+    }
+
+    LOG(INFO) << "logid = " << cntl->log_id()
+        << ", GetOrAllocateSegments request, filename = "
+        << request->filename()
+        << ", first offset = " << firstOffset
+        << ", count = " << request->offsets_size()
+        << ", allocateTag = " << request->allocateifnotexist();
+
+    FileWriteLockGuard guard(fileLockManager_, request->filename());
+
+    std::string signature;
+    if (request->has_signature()) {
+        signature = request->signature();
+    }
+
+    StatusCode retCode;
+    retCode = kCurveFS.CheckFileOwner(request->filename(), request->owner(),
+                                      signature, request->date());
+    if (retCode != StatusCode::kOK) {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->owner()
+                << ", statusCode = " << retCode;
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", CheckFileOwner fail, filename = " <<  request->filename()
+                << ", owner = " << request->owner()
+                << ", statusCode = " << retCode;
+        }
+        return;
+    }
+
+    if (request->allocateifnotexist() && request->has_epoch()) {
+        retCode = kCurveFS.CheckEpoch(request->filename(), request->epoch());
+        if (retCode != StatusCode::kOK) {
+            response->set_statuscode(retCode);
+            if (google::ERROR != GetMdsLogLevel(retCode)) {
+                LOG(WARNING) << "logid = " << cntl->log_id()
+                    << ", CheckEpoch fail, filename = " <<  request->filename()
+                    << ", epoch = " << request->epoch()
+                    << ", statusCode = " << retCode;
+            } else {
+                LOG(ERROR) << "logid = " << cntl->log_id()
+                    << ", CheckEpoch fail, filename = " <<  request->filename()
+                    << ", epoch = " << request->epoch()
+                    << ", statusCode = " << retCode;
+            }
+            return;
+        }
+    }
+
+    std::vector<offset_t> offsets(request->offsets().begin(),
+                                  request->offsets().end());
+    std::vector<PageFileSegment> segments;
+    retCode = kCurveFS.GetOrAllocateSegments(request->filename(), offsets,
+                request->allocateifnotexist(), &segments);
+
+    if (retCode != StatusCode::kOK)  {
+        response->set_statuscode(retCode);
+        if (google::ERROR != GetMdsLogLevel(retCode)) {
+            LOG(WARNING) << "logid = " << cntl->log_id()
+                << ", GetOrAllocateSegments fail, filename = "
+                <<  request->filename()
+                << ", first offset = " << firstOffset
+                << ", count = " << request->offsets_size()
+                << ", allocateTag = " << request->allocateifnotexist()
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                << ", cost " << expiredTime.ExpiredMs() << " ms";
+        } else {
+            LOG(ERROR) << "logid = " << cntl->log_id()
+                << ", GetOrAllocateSegments fail, filename = "
+                <<  request->filename()
+                << ", first offset = " << firstOffset
+                << ", count = " << request->offsets_size()
+                << ", allocateTag = " << request->allocateifnotexist()
+                << ", statusCode = " << retCode
+                << ", StatusCode_Name = " << StatusCode_Name(retCode)
+                << ", cost " << expiredTime.ExpiredMs() << " ms";
+        }
+    } else {
+        response->set_statuscode(StatusCode::kOK);
+        for (auto& segment : segments) {
+            response->add_pagefilesegments()->Swap(&segment);
+        }
+        LOG(INFO) << "logid = " << cntl->log_id()
+                  << ", GetOrAllocateSegments ok, filename = "
+                  << request->filename()
+                  << ", first offset = " << firstOffset
+                  << ", count = " << request->offsets_size()
+                  << ", returned = " << response->pagefilesegments_size()
+                  << ", allocateTag = " << request->allocateifnotexist()
+                  << ", cost " << expiredTime.ExpiredMs() << " ms";
+    }
+    return;
+}
+
 void NameSpaceService::DeAllocateSegment(
     ::google::protobuf::RpcController* controller,
     const ::curve::mds::DeAllocateSegmentRequest* request,
@@ -1638,6 +1757,43 @@ void NameSpaceService::RefreshSession(
                     ::google::protobuf::Closure* done) {
     brpc::ClosureGuard doneGuard(done);
     brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+    DoRefreshSession(cntl, request, response);
+}
+
+void NameSpaceService::RefreshSessions(
+                    ::google::protobuf::RpcController* controller,
+                    const ::curve::mds::RefreshSessionsRequest* request,
+                    ::curve::mds::RefreshSessionsResponse* response,
+                    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard doneGuard(done);
+    brpc::Controller* cntl = static_cast<brpc::Controller*>(controller);
+    ExpiredTime expiredTime;
+
+    if (request->requests_size() == 0) {
+        response->set_statuscode(StatusCode::kParaError);
+        LOG(ERROR) << "logid = " << cntl->log_id()
+                   << ", RefreshSessions request is empty, clientip = "
+                   << butil::ip2str(cntl->remote_side().ip).c_str();
+        return;
+    }
+
+    // every file is refreshed separately, one failure doesn't affect others
+    for (const auto& req : request->requests()) {
+        DoRefreshSession(cntl, &req, response->add_responses());
+    }
+    response->set_statuscode(StatusCode::kOK);
+
+    DVLOG(6) << "logid = " << cntl->log_id()
+             << ", RefreshSessions ok, count = " << request->requests_size()
+             << ", clientip = "
+             << butil::ip2str(cntl->remote_side().ip).c_str()
+             << ", cost = " << expiredTime.ExpiredMs() << " ms";
+}
+
+void NameSpaceService::DoRefreshSession(
+                    brpc::Controller* cntl,
+                    const ::curve::mds::ReFreshSessionRequest* request,
+                    ::curve::mds::ReFreshSessionResponse* response) {
     ExpiredTime expiredTime;
 
     std::string clientIP = butil::ip2str(cntl->remote_side().ip).c_str();
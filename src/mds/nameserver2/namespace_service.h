@@ -96,6 +96,12 @@ class NameSpaceService: public CurveFSService {
                        ::curve::mds::GetOrAllocateSegmentResponse* response,
                        ::google::protobuf::Closure* done) override;
 
+    void GetOrAllocateSegments(
+        ::google::protobuf::RpcController* controller,
+        const ::curve::mds::GetOrAllocateSegmentsRequest* request,
+        ::curve::mds::GetOrAllocateSegmentsResponse* response,
+        ::google::protobuf::Closure* done) override;
+
     void DeAllocateSegment(
         ::google::protobuf::RpcController* controller,
         const ::curve::mds::DeAllocateSegmentRequest* request,
@@ -160,6 +166,10 @@ class NameSpaceService: public CurveFSService {
                         const ::curve::mds::ReFreshSessionRequest* request,
                         ::curve::mds::ReFreshSessionResponse* response,
                         ::google::protobuf::Closure* done) override;
+    void RefreshSessions(::google::protobuf::RpcController* controller,
+                        const ::curve::mds::RefreshSessionsRequest* request,
+                        ::curve::mds::RefreshSessionsResponse* response,
+                        ::google::protobuf::Closure* done) override;
     void CreateCloneFile(::google::protobuf::RpcController* controller,
                        const ::curve::mds::CreateCloneFileRequest* request,
                        ::curve::mds::CreateCloneFileResponse* response,
@@ -197,6 +207,15 @@ class NameSpaceService: public CurveFSService {
         ::curve::mds::UpdateFileThrottleParamsResponse* response,
         ::google::protobuf::Closure* done) override;
 
+ private:
+    /**
+     * @brief refresh session of one file, shared by RefreshSession and
+     *        RefreshSessions
+     */
+    void DoRefreshSession(brpc::Controller* cntl,
+                          const ::curve::mds::ReFreshSessionRequest* request,
+                          ::curve::mds::ReFreshSessionResponse* response);
+
  private:
     FileLockManager *fileLockManager_;
 };
@@ -26,6 +26,8 @@
 #include "src/mds/nameserver2/helper/namespace_helper.h"
 #include "src/common/namespace_define.h"
 
+using ::curve::common::FILEINFOKEYPREFIX;
+using ::curve::common::FILEINFOKEYEND;
 using ::curve::common::SNAPSHOTFILEINFOKEYPREFIX;
 using ::curve::common::SNAPSHOTFILEINFOKEYEND;
 using ::curve::common::DISCARDSEGMENTKEYPREFIX;
@@ -40,8 +42,10 @@ std::ostream& operator << (std::ostream & os, StoreStatus &s) {
 }
 
 NameServerStorageImp::NameServerStorageImp(
-    std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache)
-    : client_(client), cache_(cache), discardMetric_() {}
+    std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache,
+    std::shared_ptr<NameSpaceMetaCache> metaCache)
+    : client_(client), cache_(cache), metaCache_(metaCache),
+      discardMetric_() {}
 
 StoreStatus NameServerStorageImp::PutFile(const FileInfo &fileInfo) {
     std::string storeKey;
@@ -65,7 +69,7 @@ StoreStatus NameServerStorageImp::PutFile(const FileInfo &fileInfo) {
                     << errCode;
     } else {
         // update to cache
-        cache_->Put(storeKey, encodeFileInfo);
+        CacheFile(storeKey, fileInfo, encodeFileInfo);
     }
 
     return getErrorCode(errCode);
@@ -81,12 +85,16 @@ StoreStatus NameServerStorageImp::GetFile(InodeID parentid,
         return StoreStatus::InternalError;
     }
 
+    if (metaCache_ != nullptr && metaCache_->GetFile(storeKey, fileInfo)) {
+        return StoreStatus::OK;
+    }
+
     int errCode = EtcdErrCode::EtcdOK;
     std::string out;
-    if (!cache_->Get(storeKey, &out)) {
+    if (metaCache_ != nullptr || !cache_->Get(storeKey, &out)) {
         errCode = client_->Get(storeKey, &out);
 
-        if (errCode == EtcdErrCode::EtcdOK) {
+        if (errCode == EtcdErrCode::EtcdOK && metaCache_ == nullptr) {
             cache_->Put(storeKey, out);
         }
     }
@@ -94,6 +102,9 @@ StoreStatus NameServerStorageImp::GetFile(InodeID parentid,
     if (errCode == EtcdErrCode::EtcdOK) {
         bool decodeOK = NameSpaceStorageCodec::DecodeFileInfo(out, fileInfo);
         if (decodeOK) {
+            if (metaCache_ != nullptr) {
+                metaCache_->PutFile(storeKey, *fileInfo);
+            }
             return StoreStatus::OK;
         } else {
             LOG(ERROR) << "decode info error. parentid: " << parentid
@@ -121,7 +132,7 @@ StoreStatus NameServerStorageImp::DeleteFile(InodeID id,
     }
 
     // delete cache first, then Etcd
-    cache_->Remove(storeKey);
+    RemoveCache(storeKey);
     int resCode = client_->Delete(storeKey);
 
     if (resCode != EtcdErrCode::EtcdOK) {
@@ -141,7 +152,7 @@ StoreStatus NameServerStorageImp::DeleteSnapshotFile(InodeID id,
     }
 
     // delete cache first, then Etcd
-    cache_->Remove(storeKey);
+    RemoveCache(storeKey);
     int resCode = client_->Delete(storeKey);
 
     if (resCode != EtcdErrCode::EtcdOK) {
@@ -187,7 +198,7 @@ StoreStatus NameServerStorageImp::RenameFile(const FileInfo &oldFInfo,
     }
 
     // delete the data in the cache first
-    cache_->Remove(oldStoreKey);
+    RemoveCache(oldStoreKey);
 
     // update Etcd
     Operation op1{
@@ -208,7 +219,7 @@ StoreStatus NameServerStorageImp::RenameFile(const FileInfo &oldFInfo,
                    << errCode;
     } else {
         // update to cache at last
-        cache_->Put(newStoreKey, encodeNewFileInfo);
+        CacheFile(newStoreKey, newFInfo, encodeNewFileInfo);
     }
     return getErrorCode(errCode);
 }
@@ -272,8 +283,8 @@ StoreStatus NameServerStorageImp::ReplaceFileAndRecycleOldFile(
     }
 
     // delete data in cache
-    cache_->Remove(conflictStoreKey);
-    cache_->Remove(oldStoreKey);
+    RemoveCache(conflictStoreKey);
+    RemoveCache(oldStoreKey);
 
     // put recycleFInfo; delete oldFInfo; put newFInfo
     Operation op1{
@@ -299,8 +310,8 @@ StoreStatus NameServerStorageImp::ReplaceFileAndRecycleOldFile(
                    << errCode;
     } else {
         // update to cache
-        cache_->Put(recycleStoreKey, encodeRecycleFInfo);
-        cache_->Put(newStoreKey, encodeNewFInfo);
+        CacheFile(recycleStoreKey, recycleFInfo, encodeRecycleFInfo);
+        CacheFile(newStoreKey, newFInfo, encodeNewFInfo);
     }
     return getErrorCode(errCode);
 }
@@ -334,7 +345,7 @@ StoreStatus NameServerStorageImp::MoveFileToRecycle(
     }
 
     // delete data in cache
-    cache_->Remove(originFileInfoKey);
+    RemoveCache(originFileInfoKey);
 
     // remove originFileInfo from Etcd, and put recycleFileInfo
     Operation op1{
@@ -356,7 +367,7 @@ StoreStatus NameServerStorageImp::MoveFileToRecycle(
                    << errCode;
     } else {
         // update to cache
-        cache_->Put(recycleFileInfoKey, encodeRecycleFInfo);
+        CacheFile(recycleFileInfoKey, recycleFileInfo, encodeRecycleFInfo);
     }
     return getErrorCode(errCode);
 }
@@ -477,7 +488,50 @@ StoreStatus NameServerStorageImp::PutSegment(InodeID id,
         LOG(ERROR) << "put segment of logicalPoolId:"
                    << segment->logicalpoolid() << "err:" << errCode;
     } else {
-        cache_->Put(storeKey, encodeSegment);
+        CacheSegment(storeKey, *segment, encodeSegment);
+    }
+    return getErrorCode(errCode);
+}
+
+StoreStatus NameServerStorageImp::PutSegments(
+    InodeID id, const std::vector<PageFileSegment> &segments,
+    int64_t *revision) {
+    if (segments.size() == 1) {
+        return PutSegment(id, segments[0].startoffset(), &segments[0],
+                          revision);
+    }
+
+    std::vector<std::string> storeKeys;
+    std::vector<std::string> encodeSegments(segments.size());
+    storeKeys.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        storeKeys.emplace_back(NameSpaceStorageCodec::EncodeSegmentStoreKey(
+            id, segments[i].startoffset()));
+        if (!NameSpaceStorageCodec::EncodeSegment(segments[i],
+                                                  &encodeSegments[i])) {
+            return StoreStatus::InternalError;
+        }
+    }
+
+    std::vector<Operation> ops;
+    ops.reserve(segments.size());
+    for (size_t i = 0; i < segments.size(); ++i) {
+        ops.emplace_back(Operation{
+            OpType::OpPut,
+            const_cast<char*>(storeKeys[i].c_str()),
+            const_cast<char*>(encodeSegments[i].c_str()),
+            static_cast<int>(storeKeys[i].size()),
+            static_cast<int>(encodeSegments[i].size())});
+    }
+
+    int errCode = client_->TxnNRewithRevision(ops, revision);
+    if (errCode != EtcdErrCode::EtcdOK) {
+        LOG(ERROR) << "put " << segments.size() << " segments of inodeid: "
+                   << id << " err: " << errCode;
+    } else {
+        for (size_t i = 0; i < segments.size(); ++i) {
+            CacheSegment(storeKeys[i], segments[i], encodeSegments[i]);
+        }
     }
     return getErrorCode(errCode);
 }
@@ -487,15 +541,22 @@ StoreStatus NameServerStorageImp::GetSegment(InodeID id,
                                              PageFileSegment *segment) {
     std::string storeKey =
         NameSpaceStorageCodec::EncodeSegmentStoreKey(id, off);
+    if (metaCache_ != nullptr && metaCache_->GetSegment(storeKey, segment)) {
+        return StoreStatus::OK;
+    }
+
     int errCode = EtcdErrCode::EtcdOK;
     std::string out;
-    if (!cache_->Get(storeKey, &out)) {
+    if (metaCache_ != nullptr || !cache_->Get(storeKey, &out)) {
         errCode = client_->Get(storeKey, &out);
     }
 
     if (errCode == EtcdErrCode::EtcdOK) {
         bool decodeOK = NameSpaceStorageCodec::DecodeSegment(out, segment);
         if (decodeOK) {
+            if (metaCache_ != nullptr) {
+                metaCache_->PutSegment(storeKey, *segment);
+            }
             return StoreStatus::OK;
         } else {
             LOG(ERROR) << "decode segment inodeid: " << id
@@ -518,7 +579,7 @@ StoreStatus NameServerStorageImp::DeleteSegment(
     int errCode = client_->DeleteRewithRevision(storeKey, revision);
 
     // update the cache first, then update Etcd
-    cache_->Remove(storeKey);
+    RemoveCache(storeKey);
     if (errCode != EtcdErrCode::EtcdOK) {
         LOG(ERROR) << "delete segment of inodeid: " << id
                    << "off: " << off << ", err:" << errCode;
@@ -592,7 +653,7 @@ StoreStatus NameServerStorageImp::DiscardSegment(
                    << fileInfo.filename() << ", inodeid = " << inodeId
                    << ", offset: " << offset << ", errCode: " << errCode;
     } else {
-        cache_->Remove(segmentKey);
+        RemoveCache(segmentKey);
         discardMetric_.OnReceiveDiscardRequest(segment.segmentsize());
     }
 
@@ -649,7 +710,7 @@ StoreStatus NameServerStorageImp::SnapShotFile(const FileInfo *originFInfo,
     }
 
     // delete the information in cache first
-    cache_->Remove(originFileKey);
+    RemoveCache(originFileKey);
 
     // then update Etcd
     Operation op1{
@@ -672,8 +733,8 @@ StoreStatus NameServerStorageImp::SnapShotFile(const FileInfo *originFInfo,
                    << ", fileinfo: " << originFInfo->filename() << "err";
     } else {
         // update cache at last
-        cache_->Put(originFileKey, encodeFileInfo);
-        cache_->Put(snapshotFileKey, encodeSnapshot);
+        CacheFile(originFileKey, *originFInfo, encodeFileInfo);
+        CacheFile(snapshotFileKey, *snapshotFInfo, encodeSnapshot);
     }
     return getErrorCode(errCode);
 }
@@ -684,6 +745,60 @@ StoreStatus NameServerStorageImp::LoadSnapShotFile(
                             SNAPSHOTFILEINFOKEYEND, snapshotFiles);
 }
 
+StoreStatus NameServerStorageImp::WarmupCache() {
+    if (metaCache_ == nullptr) {
+        return StoreStatus::OK;
+    }
+
+    std::vector<std::pair<std::string, std::string>> out;
+    int errCode = client_->List(FILEINFOKEYPREFIX, FILEINFOKEYEND, &out);
+    if (errCode != EtcdErrCode::EtcdOK) {
+        LOG(ERROR) << "list file for warmup err: " << errCode;
+        return getErrorCode(errCode);
+    }
+
+    for (const auto& kv : out) {
+        FileInfo fileInfo;
+        if (!NameSpaceStorageCodec::DecodeFileInfo(kv.second, &fileInfo)) {
+            LOG(ERROR) << "decode one fileInfo err";
+            return StoreStatus::InternalError;
+        }
+        metaCache_->PutFile(kv.first, fileInfo);
+    }
+
+    LOG(INFO) << "warmup namespace meta cache with " << out.size()
+              << " files";
+    return StoreStatus::OK;
+}
+
+void NameServerStorageImp::CacheFile(const std::string& key,
+                                     const FileInfo& fileInfo,
+                                     const std::string& encodeFileInfo) {
+    if (metaCache_ != nullptr) {
+        metaCache_->PutFile(key, fileInfo);
+    } else {
+        cache_->Put(key, encodeFileInfo);
+    }
+}
+
+void NameServerStorageImp::CacheSegment(const std::string& key,
+                                        const PageFileSegment& segment,
+                                        const std::string& encodeSegment) {
+    if (metaCache_ != nullptr) {
+        metaCache_->PutSegment(key, segment);
+    } else {
+        cache_->Put(key, encodeSegment);
+    }
+}
+
+void NameServerStorageImp::RemoveCache(const std::string& key) {
+    if (metaCache_ != nullptr) {
+        metaCache_->Remove(key);
+    } else {
+        cache_->Remove(key);
+    }
+}
+
 StoreStatus NameServerStorageImp::getErrorCode(int errCode) {
     switch (errCode) {
         case EtcdErrCode::EtcdOK:
@@ -35,6 +35,7 @@
 #include "src/kvstorageclient/etcd_client.h"
 #include "src/mds/nameserver2/metric.h"
 #include "src/common/lru_cache.h"
+#include "src/mds/nameserver2/namespace_meta_cache.h"
 
 namespace curve {
 namespace mds {
@@ -211,6 +212,20 @@ class NameServerStorage {
                                     const PageFileSegment * segment,
                                     int64_t *revision) = 0;
 
+    /**
+     * @brief PutSegments: Store several segments of a file in a single
+     *                     transaction
+     *
+     * @param[in] id: Inode ID of the target file
+     * @param[in] segments: Segments info, offset is their startoffset
+     * @param[out] revision: The version number of this operation
+     *
+     * @return StoreStatus: error code
+     */
+    virtual StoreStatus PutSegments(
+        InodeID id, const std::vector<PageFileSegment> &segments,
+        int64_t *revision) = 0;
+
     /**
      * @brief DeleteSegment: Delete the specified segment metadata
      *
@@ -279,8 +294,15 @@ class NameServerStorage {
 
 class NameServerStorageImp : public NameServerStorage {
  public:
-    explicit NameServerStorageImp(
-        std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache);
+    /**
+     * @param client: etcd client
+     * @param cache: cache of serialized metadata
+     * @param metaCache: cache of decoded metadata, if it's set, it's used
+     *                   instead of cache
+     */
+    NameServerStorageImp(
+        std::shared_ptr<KVStorageClient> client, std::shared_ptr<Cache> cache,
+        std::shared_ptr<NameSpaceMetaCache> metaCache = nullptr);
     ~NameServerStorageImp() {}
 
     StoreStatus PutFile(const FileInfo & fileInfo) override;
@@ -326,6 +348,10 @@ class NameServerStorageImp : public NameServerStorage {
                             const PageFileSegment * segment,
                             int64_t *revision) override;
 
+    StoreStatus PutSegments(InodeID id,
+                            const std::vector<PageFileSegment> &segments,
+                            int64_t *revision) override;
+
     StoreStatus DeleteSegment(
         InodeID id, uint64_t off, int64_t *revision) override;
 
@@ -344,7 +370,23 @@ class NameServerStorageImp : public NameServerStorage {
 
     StoreStatus LoadSnapShotFile(std::vector<FileInfo> *snapShotFiles) override;
 
+    /**
+     * @brief load all FileInfo into metaCache by a single range scan,
+     *        it's called when mds becomes leader
+     *
+     * @return StoreStatus: error code
+     */
+    StoreStatus WarmupCache();
+
  private:
+    void CacheFile(const std::string& key,
+                   const FileInfo& fileInfo,
+                   const std::string& encodeFileInfo);
+    void CacheSegment(const std::string& key,
+                      const PageFileSegment& segment,
+                      const std::string& encodeSegment);
+    void RemoveCache(const std::string& key);
+
     StoreStatus ListFileInternal(const std::string& startStoreKey,
                                  const std::string& endStoreKey,
                                  std::vector<FileInfo> *files);
@@ -357,6 +399,7 @@ class NameServerStorageImp : public NameServerStorage {
  private:
     // namespace-meta cache
     std::shared_ptr<Cache> cache_;
+    std::shared_ptr<NameSpaceMetaCache> metaCache_;
 
     // underlying storage
     std::shared_ptr<KVStorageClient> client_;
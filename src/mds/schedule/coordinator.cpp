@@ -237,6 +237,11 @@ int Coordinator::QueryChunkServerRecoverStatus(
 
 void Coordinator::RunScheduler(
     const std::shared_ptr<Scheduler> &s, SchedulerType type) {
+    if (conf_.schedulePerLogicalPool) {
+        RunPoolSchedulers(s, type);
+        return;
+    }
+
     while (sleeper_.wait_for(std::chrono::seconds(s->GetRunningInterval()))) {
         if (ScheduleNeedRun(type)) {
             s->Schedule();
@@ -245,6 +250,56 @@ void Coordinator::RunScheduler(
     LOG(INFO) << ScheduleName(type) << " exit.";
 }
 
+void Coordinator::RunPoolSchedulers(
+    const std::shared_ptr<Scheduler> &s, SchedulerType type) {
+    std::map<PoolIdType, common::Thread> poolThreads;
+    do {
+        std::vector<PoolIdType> lids = topo_->GetLogicalpools();
+        std::set<PoolIdType> exists(lids.begin(), lids.end());
+
+        // the thread of a deleted logical pool will exit by itself
+        for (auto it = poolThreads.begin(); it != poolThreads.end();) {
+            if (exists.count(it->first) > 0) {
+                ++it;
+                continue;
+            }
+            it->second.join();
+            it = poolThreads.erase(it);
+        }
+
+        for (auto lid : lids) {
+            if (poolThreads.count(lid) > 0) {
+                continue;
+            }
+            LOG(INFO) << "start " << ScheduleName(type)
+                      << " of logical pool " << lid;
+            poolThreads.emplace(lid, common::Thread(
+                &Coordinator::RunPoolScheduler, this, s, type, lid));
+        }
+    } while (sleeper_.wait_for(
+        std::chrono::seconds(s->GetRunningInterval())));
+
+    for (auto &item : poolThreads) {
+        item.second.join();
+    }
+    LOG(INFO) << ScheduleName(type) << " exit.";
+}
+
+void Coordinator::RunPoolScheduler(const std::shared_ptr<Scheduler> &s,
+                                   SchedulerType type, PoolIdType lid) {
+    ::curve::mds::topology::LogicalPool lpool;
+    while (sleeper_.wait_for(std::chrono::seconds(s->GetRunningInterval()))) {
+        if (!topo_->GetLogicalPool(lid, &lpool)) {
+            break;
+        }
+        if (ScheduleNeedRun(type)) {
+            s->ScheduleLogicalPool(lid);
+        }
+    }
+    LOG(INFO) << ScheduleName(type) << " of logical pool " << lid
+              << " exit.";
+}
+
 bool Coordinator::BuildCopySetConf(
     const CopySetConf &res, ::curve::mds::heartbeat::CopySetConf *out) {
     // build the copysetConf need to be returned in heartbeat
@@ -293,6 +348,11 @@ bool Coordinator::BuildCopySetConf(
     return true;
 }
 
+bool Coordinator::HasOperator(CopySetKey key) {
+    Operator op;
+    return opController_->GetOperatorById(key, &op);
+}
+
 bool Coordinator::ChunkserverGoingToAdd(
     ChunkServerIdType csId, CopySetKey key) {
     Operator op;
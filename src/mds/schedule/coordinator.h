@@ -84,6 +84,13 @@ class Coordinator {
      */
     virtual bool ChunkserverGoingToAdd(ChunkServerIdType csId, CopySetKey key);
 
+    /**
+     * @brief determine whether there's any operator on specified copyset
+     *
+     * @param[in] key Copyset specified
+     */
+    virtual bool HasOperator(CopySetKey key);
+
     /**
      * @brief Initialize the scheduler according to the configuration
      *
@@ -140,6 +147,28 @@ class Coordinator {
      */
     void RunScheduler(const std::shared_ptr<Scheduler> &s, SchedulerType type);
 
+    /**
+     * @brief start one thread for every logical pool to run the scheduler,
+     *        threads are started and stopped as logical pools are
+     *        created and deleted
+     *
+     * @param[in] s Schedulers for running
+     * @param[in] type Scheduler type
+     */
+    void RunPoolSchedulers(
+        const std::shared_ptr<Scheduler> &s, SchedulerType type);
+
+    /**
+     * @brief regular task for running scheduler on specified logical pool,
+     *        exit if the logical pool is deleted
+     *
+     * @param[in] s Schedulers for running
+     * @param[in] type Scheduler type
+     * @param[in] lid Logical pool id
+     */
+    void RunPoolScheduler(const std::shared_ptr<Scheduler> &s,
+                          SchedulerType type, PoolIdType lid);
+
     /**
      * @brief BuildCopySetConf Build copyset configuration for chunkserver
      *
@@ -44,6 +44,13 @@ int CopySetScheduler::Schedule() {
     return oneRoundGenOp;
 }
 
+int CopySetScheduler::ScheduleLogicalPool(PoolIdType lid) {
+    int oneRoundGenOp = DoCopySetSchedule(lid);
+    LOG(INFO) << "schedule: copysetScheduler generate operator num "
+              << oneRoundGenOp << " in logical pool " << lid;
+    return oneRoundGenOp;
+}
+
 int CopySetScheduler::PenddingCopySetSchedule(const std::map<ChunkServerIdType,
                                     std::vector<CopySetInfo>> &distribute) {
     int oneRoundGenOp = 0;
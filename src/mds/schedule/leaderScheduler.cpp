@@ -45,6 +45,13 @@ int LeaderScheduler::Schedule() {
     return oneRoundGenOp;
 }
 
+int LeaderScheduler::ScheduleLogicalPool(PoolIdType lid) {
+    int oneRoundGenOp = DoLeaderSchedule(lid);
+    LOG(INFO) << "schedule: leaderScheduler generate operator num "
+              << oneRoundGenOp << " in logical pool " << lid;
+    return oneRoundGenOp;
+}
+
 int LeaderScheduler::DoLeaderSchedule(PoolIdType lid) {
     int oneRoundGenOp = 0;
 
@@ -55,8 +62,9 @@ int LeaderScheduler::DoLeaderSchedule(PoolIdType lid) {
     int minId = -1;
     std::vector<ChunkServerInfo> csInfos
         = topo_->GetChunkServersInLogicalPool(lid);
-    static std::random_device rd;
-    static std::mt19937 g(rd());
+    // schedulers of different logical pools may run concurrently
+    thread_local std::random_device rd;
+    thread_local std::mt19937 g(rd());
     std::shuffle(csInfos.begin(), csInfos.end(), g);
 
     for (auto csInfo : csInfos) {
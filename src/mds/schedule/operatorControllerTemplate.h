@@ -78,6 +78,13 @@ class OperatorControllerT {
      */
     bool Exceed(IdType id);
 
+    /**
+     * @brief GetMetrics Get metrics of scheduler, may be nullptr
+     */
+    std::shared_ptr<ScheduleMetrics> GetMetrics() {
+        return metrics_;
+    }
+
  private:
     /**
      * @brief update influence of replacing operator
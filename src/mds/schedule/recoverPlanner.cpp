@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <glog/logging.h>
+#include <algorithm>
+#include "src/common/timeutility.h"
+#include "src/mds/schedule/recoverPlanner.h"
+
+using ::curve::common::TimeUtility;
+using ::curve::mds::topology::UNINTIALIZE_ID;
+
+namespace curve {
+namespace mds {
+namespace schedule {
+
+namespace {
+
+const uint64_t kMiB = 1024 * 1024;
+
+// an endpoint without any flow always admits one, so that recovery
+// never stops even if the limit is less than the bandwidth of one flow
+bool Acceptable(uint32_t flows, uint64_t flowBps, uint64_t limit) {
+    return limit == 0 || flows == 0 || (flows + 1) * flowBps <= limit;
+}
+
+}  // namespace
+
+RecoverPlanner::RecoverPlanner(
+    const ScheduleOption &opt, const std::shared_ptr<TopoAdapter> &topo,
+    const std::shared_ptr<OperatorController> &opController)
+    : diskBps_(opt.recoverBandwidthPerDiskMBps * kMiB),
+      hostBps_(opt.recoverBandwidthPerHostMBps * kMiB),
+      flowBps_(0),
+      targetTimeSec_(opt.recoverTargetTimeSec),
+      topo_(topo),
+      opController_(opController),
+      inflightBytes_(0),
+      recoverStartSec_(0) {
+    if (opt.operatorConcurrent > 0) {
+        flowBps_ = diskBps_ / opt.operatorConcurrent;
+    }
+}
+
+void RecoverPlanner::BeginRound(
+    PoolIdType lid, const std::map<PoolIdType, uint64_t> &pendingBytes) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto metrics = opController_->GetMetrics();
+
+    // remove flows whose operator is finished, the data is regarded as
+    // recovered if the target is a member of the copyset now
+    for (auto it = flows_.begin(); it != flows_.end();) {
+        if (lid != UNINTIALIZE_ID && it->first.first != lid) {
+            ++it;
+            continue;
+        }
+
+        Operator op;
+        if (opController_->GetOperatorById(it->first, &op)) {
+            ++it;
+            continue;
+        }
+
+        CopySetInfo info;
+        if (metrics != nullptr && topo_->GetCopySetInfo(it->first, &info) &&
+            info.ContainPeer(it->second.target.id)) {
+            metrics->recoveredBytes << it->second.bytes;
+        }
+        RemoveFlowLocked(it++);
+    }
+
+    if (lid == UNINTIALIZE_ID) {
+        pendingBytes_ = pendingBytes;
+    } else {
+        auto it = pendingBytes.find(lid);
+        pendingBytes_[lid] = it == pendingBytes.end() ? 0 : it->second;
+    }
+
+    if (recoverStartSec_ == 0 && PendingBytesLocked() + inflightBytes_ > 0) {
+        recoverStartSec_ = TimeUtility::GetTimeofDaySec();
+    }
+}
+
+bool RecoverPlanner::Admit(const CopySetKey &key, const PeerInfo &source,
+                           const PeerInfo &target, uint64_t bytes) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    if (flows_.count(key) != 0) {
+        return false;
+    }
+
+    if (Enabled()) {
+        if (!Acceptable(diskFlows_[source.id], flowBps_, diskBps_) ||
+            !Acceptable(diskFlows_[target.id], flowBps_, diskBps_)) {
+            return false;
+        }
+
+        if (!Acceptable(hostFlows_[source.serverId], flowBps_, hostBps_) ||
+            !Acceptable(hostFlows_[target.serverId], flowBps_, hostBps_)) {
+            return false;
+        }
+
+        uint64_t neededBps = NeededBpsLocked();
+        if (neededBps != 0 && !flows_.empty() &&
+            flows_.size() * flowBps_ >= neededBps) {
+            return false;
+        }
+    }
+
+    flows_[key] = Flow{source, target, bytes};
+    diskFlows_[source.id]++;
+    diskFlows_[target.id]++;
+    hostFlows_[source.serverId]++;
+    hostFlows_[target.serverId]++;
+
+    auto &pending = pendingBytes_[key.first];
+    pending -= std::min(pending, bytes);
+    inflightBytes_ += bytes;
+    return true;
+}
+
+void RecoverPlanner::Cancel(const CopySetKey &key) {
+    std::lock_guard<std::mutex> lk(mtx_);
+    auto it = flows_.find(key);
+    if (it == flows_.end()) {
+        return;
+    }
+
+    pendingBytes_[key.first] += it->second.bytes;
+    RemoveFlowLocked(it);
+}
+
+void RecoverPlanner::EndRound() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    uint64_t pending = PendingBytesLocked();
+    if (pending + inflightBytes_ == 0) {
+        recoverStartSec_ = 0;
+    }
+
+    auto metrics = opController_->GetMetrics();
+    if (metrics != nullptr) {
+        metrics->UpdateRecoverMetric(pending, inflightBytes_,
+                                     EtaSecLocked());
+    }
+}
+
+uint64_t RecoverPlanner::GetEtaSec() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return EtaSecLocked();
+}
+
+uint32_t RecoverPlanner::GetFlowNum() {
+    std::lock_guard<std::mutex> lk(mtx_);
+    return flows_.size();
+}
+
+void RecoverPlanner::RemoveFlowLocked(
+    std::map<CopySetKey, Flow>::iterator it) {
+    const Flow &flow = it->second;
+    diskFlows_[flow.source.id]--;
+    diskFlows_[flow.target.id]--;
+    hostFlows_[flow.source.serverId]--;
+    hostFlows_[flow.target.serverId]--;
+    inflightBytes_ -= std::min(inflightBytes_, flow.bytes);
+    flows_.erase(it);
+}
+
+uint64_t RecoverPlanner::NeededBpsLocked() {
+    if (targetTimeSec_ == 0 || recoverStartSec_ == 0) {
+        return 0;
+    }
+
+    uint64_t deadline = recoverStartSec_ + targetTimeSec_;
+    uint64_t now = TimeUtility::GetTimeofDaySec();
+    // already late, recover as fast as possible
+    if (now >= deadline) {
+        return 0;
+    }
+
+    uint64_t remain = PendingBytesLocked() + inflightBytes_;
+    uint64_t left = deadline - now;
+    return (remain + left - 1) / left;
+}
+
+uint64_t RecoverPlanner::PendingBytesLocked() {
+    uint64_t pending = 0;
+    for (const auto &item : pendingBytes_) {
+        pending += item.second;
+    }
+    return pending;
+}
+
+uint64_t RecoverPlanner::EtaSecLocked() {
+    uint64_t remain = PendingBytesLocked() + inflightBytes_;
+    if (remain == 0) {
+        return 0;
+    }
+
+    uint64_t throughput = flows_.size() * flowBps_;
+    auto metrics = opController_->GetMetrics();
+    if (metrics != nullptr) {
+        throughput = std::max<uint64_t>(
+            throughput, metrics->recoverThroughput.get_value());
+    }
+
+    // unknown until some data is recovered
+    if (throughput == 0) {
+        return 0;
+    }
+    return (remain + throughput - 1) / throughput;
+}
+
+}  // namespace schedule
+}  // namespace mds
+}  // namespace curve
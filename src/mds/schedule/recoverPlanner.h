@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#ifndef SRC_MDS_SCHEDULE_RECOVERPLANNER_H_
+#define SRC_MDS_SCHEDULE_RECOVERPLANNER_H_
+
+#include <map>
+#include <memory>
+#include <mutex>  //NOLINT
+#include "src/mds/schedule/operatorController.h"
+#include "src/mds/schedule/schedule_define.h"
+#include "src/mds/schedule/topoAdapter.h"
+
+namespace curve {
+namespace mds {
+namespace schedule {
+
+/**
+ * RecoverPlanner paces the data copy of recovering offline replicas.
+ *
+ * A flow is the copy of one copyset from an online peer to the new peer.
+ * Every flow is planned at recoverBandwidthPerDiskMBps / operatorConcurrent,
+ * and a new flow is admitted only if
+ *  1. the planned bandwidth on its source and target chunkserver does not
+ *     exceed recoverBandwidthPerDiskMBps
+ *  2. the planned bandwidth on its source and target server does not
+ *     exceed recoverBandwidthPerHostMBps
+ *  3. the planned bandwidth of the cluster does not exceed the bandwidth
+ *     needed to finish recovery in recoverTargetTimeSec
+ * An endpoint without any flow always admits one.
+ *
+ * MDS can not throttle the copy itself, which is done by the snapshot
+ * throttle of chunkserver, so recoverBandwidthPerDiskMBps should be the
+ * same as the throttle. Without it the planner only tracks the progress.
+ */
+class RecoverPlanner {
+ public:
+    RecoverPlanner(const ScheduleOption &opt,
+                   const std::shared_ptr<TopoAdapter> &topo,
+                   const std::shared_ptr<OperatorController> &opController);
+
+    /**
+     * @brief whether flows are paced by bandwidth
+     */
+    bool Enabled() const {
+        return flowBps_ > 0;
+    }
+
+    /**
+     * @brief start a round of recover scheduling, flows whose operator is
+     *        finished are removed
+     *
+     * @param[in] lid Logical pool scheduled in this round,
+     *                UNINTIALIZE_ID means all logical pools
+     * @param[in] pendingBytes Bytes of replicas waiting for recovery
+     *                         in every logical pool
+     */
+    void BeginRound(PoolIdType lid,
+                    const std::map<PoolIdType, uint64_t> &pendingBytes);
+
+    /**
+     * @brief try to plan a flow
+     *
+     * @param[in] key Copyset to recover
+     * @param[in] source Peer the data is copied from
+     * @param[in] target Peer the data is copied to
+     * @param[in] bytes Estimated bytes of the copyset
+     *
+     * @return true if the flow is admitted
+     */
+    bool Admit(const CopySetKey &key, const PeerInfo &source,
+               const PeerInfo &target, uint64_t bytes);
+
+    /**
+     * @brief remove an admitted flow whose operator failed to start
+     */
+    void Cancel(const CopySetKey &key);
+
+    /**
+     * @brief finish the round and update recovery metrics
+     */
+    void EndRound();
+
+    /**
+     * @brief estimated time in seconds to finish recovery
+     */
+    uint64_t GetEtaSec();
+
+    /**
+     * @brief number of flows under recovery
+     */
+    uint32_t GetFlowNum();
+
+ private:
+    struct Flow {
+        PeerInfo source;
+        PeerInfo target;
+        uint64_t bytes;
+    };
+
+    void RemoveFlowLocked(std::map<CopySetKey, Flow>::iterator it);
+
+    /**
+     * @brief bandwidth needed to finish recovery in recoverTargetTimeSec,
+     *        0 means no limit
+     */
+    uint64_t NeededBpsLocked();
+
+    uint64_t PendingBytesLocked();
+
+    uint64_t EtaSecLocked();
+
+ private:
+    // bandwidth limit of every chunkserver, in bytes per second
+    uint64_t diskBps_;
+    // bandwidth limit of every server, in bytes per second
+    uint64_t hostBps_;
+    // planned bandwidth of one flow, in bytes per second
+    uint64_t flowBps_;
+    uint32_t targetTimeSec_;
+
+    std::shared_ptr<TopoAdapter> topo_;
+    std::shared_ptr<OperatorController> opController_;
+
+    std::mutex mtx_;
+    std::map<CopySetKey, Flow> flows_;
+    std::map<ChunkServerIdType, uint32_t> diskFlows_;
+    std::map<ServerIdType, uint32_t> hostFlows_;
+    std::map<PoolIdType, uint64_t> pendingBytes_;
+    uint64_t inflightBytes_;
+    // time when current recovery started, 0 if nothing to recover
+    uint64_t recoverStartSec_;
+};
+
+}  // namespace schedule
+}  // namespace mds
+}  // namespace curve
+
+#endif  // SRC_MDS_SCHEDULE_RECOVERPLANNER_H_
@@ -21,6 +21,8 @@
  */
 
 #include <glog/logging.h>
+#include <algorithm>
+#include <utility>
 #include "src/mds/common/mds_define.h"
 #include "src/mds/schedule/scheduler.h"
 #include "src/mds/schedule/operatorFactory.h"
@@ -32,14 +34,57 @@ namespace mds {
 namespace schedule {
 int RecoverScheduler::Schedule() {
     LOG(INFO) << "recoverScheduler begin.";
-    int oneRoundGenOp = 0;
 
     // if over certain amount of chunkserver are downed on a server, these
     // chunkservers will be collected to the set excludes.
     std::set<ChunkServerIdType> excludes;
-    CalculateExcludesChunkServer(&excludes);
+    CalculateExcludesChunkServer(topo_->GetChunkServerInfos(), &excludes);
+
+    int oneRoundGenOp = RecoverCopySets(UNINTIALIZE_ID,
+        topo_->GetCopySetInfos(), excludes,
+        std::map<ChunkServerIdType, ChunkServerInfo>{});
+    LOG(INFO) << "recoverScheduler generate " << oneRoundGenOp
+              << " operators at this round";
+    return 1;
+}
+
+int RecoverScheduler::ScheduleLogicalPool(PoolIdType lid) {
+    ::curve::mds::topology::LogicalPool lpool;
+    if (!topo_->GetLogicalPool(lid, &lpool) ||
+        !lpool.GetLogicalPoolAvaliableFlag()) {
+        return 0;
+    }
+
+    // take one snapshot of the chunkservers in the logical pool, and use it
+    // for both excludes and offline check of every copyset
+    std::vector<ChunkServerInfo> csInfos =
+        topo_->GetChunkServersInLogicalPool(lid);
+    std::set<ChunkServerIdType> excludes;
+    CalculateExcludesChunkServer(csInfos, &excludes);
 
-    for (auto copysetInfo : topo_->GetCopySetInfos()) {
+    std::map<ChunkServerIdType, ChunkServerInfo> chunkservers;
+    for (auto &csInfo : csInfos) {
+        chunkservers.emplace(csInfo.info.id, csInfo);
+    }
+
+    int oneRoundGenOp = RecoverCopySets(lid,
+        topo_->GetCopySetInfosInLogicalPool(lid), excludes, chunkservers);
+    LOG(INFO) << "recoverScheduler generate " << oneRoundGenOp
+              << " operators in logical pool " << lid << " at this round";
+    return oneRoundGenOp;
+}
+
+int RecoverScheduler::RecoverCopySets(
+    PoolIdType lid,
+    const std::vector<CopySetInfo> &copysetInfos,
+    const std::set<ChunkServerIdType> &excludes,
+    const std::map<ChunkServerIdType, ChunkServerInfo> &chunkservers) {
+    // collect copysets that have offline replica to recover
+    std::vector<RecoverCandidate> candidates;
+    // disk used and number of copysets to recover of offline chunkservers,
+    // used to estimate the bytes of every copyset
+    std::map<ChunkServerIdType, std::pair<uint64_t, uint64_t>> offlineUsage;
+    for (auto &copysetInfo : copysetInfos) {
         // skip the copyset under configuration change
         Operator op;
         if (opController_->GetOperatorById(copysetInfo.id, &op)) {
@@ -54,19 +99,32 @@ int RecoverScheduler::Schedule() {
         }
 
         std::set<ChunkServerIdType> offlinelists;
+        std::vector<PeerInfo> onlinePeers;
         // check if there's any offline replica
         for (auto peer : copysetInfo.peers) {
             ChunkServerInfo csInfo;
-            if (!topo_->GetChunkServerInfo(peer.id, &csInfo)) {
+            auto iter = chunkservers.find(peer.id);
+            if (iter != chunkservers.end()) {
+                csInfo = iter->second;
+            } else if (!topo_->GetChunkServerInfo(peer.id, &csInfo)) {
                 LOG(WARNING) << "recover scheduler: can not get " << peer.id
                              << " from topology" << std::endl;
                 continue;
             }
 
             if (!csInfo.IsOffline()) {
+                // copy data from leader if possible
+                if (peer.id == copysetInfo.leader) {
+                    onlinePeers.insert(onlinePeers.begin(), peer);
+                } else {
+                    onlinePeers.emplace_back(peer);
+                }
                 continue;
             } else {
                 offlinelists.emplace(peer.id);
+                auto &usage = offlineUsage[peer.id];
+                usage.first = csInfo.diskUsed;
+                usage.second++;
             }
         }
 
@@ -104,18 +162,50 @@ int RecoverScheduler::Schedule() {
             continue;
         }
 
+        candidates.emplace_back(
+            RecoverCandidate{&copysetInfo, *offlinelists.begin(),
+                             std::move(onlinePeers), 0});
+    }
+
+    // the fewer replicas remain, the higher risk of losing data, so recover
+    // these copysets first
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const RecoverCandidate &a, const RecoverCandidate &b) {
+            return a.onlinePeers.size() < b.onlinePeers.size();
+        });
+
+    std::map<PoolIdType, uint64_t> pendingBytes;
+    for (auto &candidate : candidates) {
+        auto &usage = offlineUsage[candidate.offline];
+        candidate.bytes = usage.first / usage.second;
+        pendingBytes[candidate.info->id.first] += candidate.bytes;
+    }
+    planner_->BeginRound(lid, pendingBytes);
+
+    int oneRoundGenOp = 0;
+    for (auto &candidate : candidates) {
+        const CopySetInfo &copysetInfo = *candidate.info;
         // recover one of the offline replica
         Operator fixRes;
         ChunkServerIdType target;
         // failed to recover the replica
         if (!FixOfflinePeer(
-                copysetInfo, *offlinelists.begin(), &fixRes, &target)) {
+                copysetInfo, candidate.offline, &fixRes, &target)) {
+            continue;
+        }
+
+        // the data is copied to the target, pace it by bandwidth
+        if (target != UNINTIALIZE_ID &&
+            !AdmitRecover(candidate, target)) {
             continue;
+        }
+
         // succeeded but failed to add the operator to the controller
-        } else if (!opController_->AddOperator(fixRes)) {
+        if (!opController_->AddOperator(fixRes)) {
             LOG(WARNING) << "recover scheduler add operator "
                        << fixRes.OpToString() << " on "
                        << copysetInfo.CopySetInfoStr() << " fail";
+            planner_->Cancel(copysetInfo.id);
             continue;
         // succeeded in recovering replica and adding it to the controller
         } else {
@@ -123,7 +213,7 @@ int RecoverScheduler::Schedule() {
                         << fixRes.OpToString() << " for "
                         << copysetInfo.CopySetInfoStr()
                         << ", remove offlinePeer: "
-                        << *offlinelists.begin();
+                        << candidate.offline;
             // if the target returned has the initial value, that means offline
             // replicas are removed directly.
             if (target == UNINTIALIZE_ID) {
@@ -140,14 +230,44 @@ int RecoverScheduler::Schedule() {
                            << " on chunkServer: " << target
                            << " error, delete operator" << fixRes.OpToString();
                 opController_->RemoveOperator(copysetInfo.id);
+                planner_->Cancel(copysetInfo.id);
                 continue;
             }
             oneRoundGenOp++;
         }
     }
-    LOG(INFO) << "recoverScheduler generate " << oneRoundGenOp
-              << " operators at this round";
-    return 1;
+    planner_->EndRound();
+    return oneRoundGenOp;
+}
+
+bool RecoverScheduler::AdmitRecover(const RecoverCandidate &candidate,
+                                    ChunkServerIdType target) {
+    const CopySetInfo &copysetInfo = *candidate.info;
+    PeerInfo source(UNINTIALIZE_ID, UNINTIALIZE_ID, UNINTIALIZE_ID, "", 0);
+    if (!candidate.onlinePeers.empty()) {
+        source = candidate.onlinePeers.front();
+    }
+
+    // location of target is only needed when pacing by bandwidth
+    PeerInfo targetPeer(target, UNINTIALIZE_ID, UNINTIALIZE_ID, "", 0);
+    if (planner_->Enabled()) {
+        ChunkServerInfo csInfo;
+        if (!topo_->GetChunkServerInfo(target, &csInfo)) {
+            LOG(WARNING) << "recover scheduler: can not get " << target
+                         << " from topology";
+            return false;
+        }
+        targetPeer = csInfo.info;
+    }
+
+    if (!planner_->Admit(copysetInfo.id, source, targetPeer,
+                         candidate.bytes)) {
+        VLOG(3) << "recoverScheduler delay recovering "
+                << copysetInfo.CopySetInfoStr() << " to chunkServer "
+                << target << " because of bandwidth limit";
+        return false;
+    }
+    return true;
 }
 
 int64_t RecoverScheduler::GetRunningInterval() {
@@ -193,11 +313,12 @@ bool RecoverScheduler::FixOfflinePeer(
 }
 
 void RecoverScheduler::CalculateExcludesChunkServer(
+    const std::vector<ChunkServerInfo> &csInfos,
     std::set<ChunkServerIdType> *excludes) {
     // calculate the number of offline or pending chunkserver on a server
     std::map<ServerIdType, std::vector<ChunkServerIdType>> unhealthyStateCS;
     std::set<ChunkServerIdType> pendingCS;
-    for (auto cs : topo_->GetChunkServerInfos()) {
+    for (auto &cs : csInfos) {
         // calculate number of pending chunkservers
         if (cs.IsPendding()) {
             LOG(INFO) << "chunkserver " << cs.info.id << " is set pendding";
@@ -31,8 +31,30 @@ namespace mds {
 namespace schedule {
 int ReplicaScheduler::Schedule() {
     LOG(INFO) << "replicaScheduelr begin.";
+    int oneRoundGenOp = CheckReplicaNum(topo_->GetCopySetInfos());
+    LOG(INFO) << "replicaScheduelr generate "
+              << oneRoundGenOp << " at this round";
+    return 1;
+}
+
+int ReplicaScheduler::ScheduleLogicalPool(PoolIdType lid) {
+    ::curve::mds::topology::LogicalPool lpool;
+    if (!topo_->GetLogicalPool(lid, &lpool) ||
+        !lpool.GetLogicalPoolAvaliableFlag()) {
+        return 0;
+    }
+
+    int oneRoundGenOp =
+        CheckReplicaNum(topo_->GetCopySetInfosInLogicalPool(lid));
+    LOG(INFO) << "replicaScheduelr generate " << oneRoundGenOp
+              << " in logical pool " << lid << " at this round";
+    return oneRoundGenOp;
+}
+
+int ReplicaScheduler::CheckReplicaNum(
+    const std::vector<CopySetInfo> &copysetInfos) {
     int oneRoundGenOp = 0;
-    for (auto info : topo_->GetCopySetInfos()) {
+    for (auto &info : copysetInfos) {
         // skip if there's any operator on a copyset
         Operator op;
         if (opController_->GetOperatorById(info.id, &op)) {
@@ -132,9 +154,7 @@ int ReplicaScheduler::Schedule() {
             }
         }
     }
-    LOG(INFO) << "replicaScheduelr generate "
-              << oneRoundGenOp << " at this round";
-    return 1;
+    return oneRoundGenOp;
 }
 
 int64_t ReplicaScheduler::GetRunningInterval() {
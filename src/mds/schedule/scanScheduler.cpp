@@ -34,37 +34,49 @@ namespace schedule {
 int ScanScheduler::Schedule() {
     LOG(INFO) << "ScanScheduler begin.";
 
+    auto count = 0;
+    auto logicPoolIds = topo_->GetLogicalpools();
+    for (const auto& lpid : logicPoolIds) {
+        count += DoScanSchedule(lpid);
+    }
+
+    LOG(INFO) << "ScanScheduelr generate "
+              << count << " operators at this round";
+    return 1;
+}
+
+int ScanScheduler::ScheduleLogicalPool(PoolIdType lid) {
+    auto count = DoScanSchedule(lid);
+    LOG(INFO) << "ScanScheduelr generate " << count
+              << " operators in logical pool " << lid << " at this round";
+    return count;
+}
+
+int ScanScheduler::DoScanSchedule(PoolIdType lpid) {
     auto currentHour = ::curve::common::TimeUtility::GetCurrentHour();
     bool duringScanTime = currentHour >= scanStartHour_ &&
                           currentHour <= scanEndHour_;
 
-    auto count = 0;
+    CopySetInfos copysets2start, copysets2cancel;
     ::curve::mds::topology::LogicalPool lpool;
-    auto logicPoolIds = topo_->GetLogicalpools();
-    for (const auto& lpid : logicPoolIds) {
-        CopySetInfos copysets2start, copysets2cancel;
-        auto copysetInfos = topo_->GetCopySetInfosInLogicalPool(lpid);
-        topo_->GetLogicalPool(lpid, &lpool);
-        if (!duringScanTime || !lpool.ScanEnable()) {
-            for (const auto& copysetInfo : copysetInfos) {
-                if (StartOrReadyToScan(copysetInfo)) {
-                    copysets2cancel.push_back(copysetInfo);
-                }
+    auto copysetInfos = topo_->GetCopySetInfosInLogicalPool(lpid);
+    topo_->GetLogicalPool(lpid, &lpool);
+    if (!duringScanTime || !lpool.ScanEnable()) {
+        for (const auto& copysetInfo : copysetInfos) {
+            if (StartOrReadyToScan(copysetInfo)) {
+                copysets2cancel.push_back(copysetInfo);
             }
-        } else {
-            SelectCopysetsForScan(
-                copysetInfos, &copysets2start, &copysets2cancel);
         }
-
-        count += GenScanOperator(copysets2start,
-                                 ConfigChangeType::START_SCAN_PEER);
-        count += GenScanOperator(copysets2cancel,
-                                 ConfigChangeType::CANCEL_SCAN_PEER);
+    } else {
+        SelectCopysetsForScan(
+            copysetInfos, &copysets2start, &copysets2cancel);
     }
 
-    LOG(INFO) << "ScanScheduelr generate "
-              << count << " operators at this round";
-    return 1;
+    auto count = GenScanOperator(copysets2start,
+                                 ConfigChangeType::START_SCAN_PEER);
+    count += GenScanOperator(copysets2cancel,
+                             ConfigChangeType::CANCEL_SCAN_PEER);
+    return count;
 }
 
 bool ScanScheduler::StartOrReadyToScan(const CopySetInfo& copysetInfo) {
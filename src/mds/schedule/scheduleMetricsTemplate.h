@@ -64,6 +64,14 @@ class ScheduleMetricsT {
           changeOpNum(ScheduleMetricsPrefix, "changePeer_num"),
           normalOpNum(ScheduleMetricsPrefix, "normal_operator_num"),
           highOpNum(ScheduleMetricsPrefix, "high_operator_num"),
+          recoverPendingBytes(ScheduleMetricsPrefix,
+                              "recover_pending_bytes", 0),
+          recoverInflightBytes(ScheduleMetricsPrefix,
+                               "recover_inflight_bytes", 0),
+          recoverEtaSec(ScheduleMetricsPrefix, "recover_eta_sec", 0),
+          recoveredBytes(ScheduleMetricsPrefix, "recovered_bytes"),
+          recoverThroughput(ScheduleMetricsPrefix,
+                            "recover_throughput_bytes", &recoveredBytes, 60),
           topo_(topo) {}
 
     /**
@@ -82,6 +90,21 @@ class ScheduleMetricsT {
      */
     void UpdateRemoveMetric(const Operator &op);
 
+    /**
+     * @brief UpdateRecoverMetric Interface exposed to recover planner for
+     *                            updating progress of recovery
+     *
+     * @param[in] pendingBytes Bytes waiting for recovery
+     * @param[in] inflightBytes Bytes under recovery
+     * @param[in] etaSec Estimated seconds to finish recovery
+     */
+    void UpdateRecoverMetric(uint64_t pendingBytes, uint64_t inflightBytes,
+                             uint64_t etaSec) {
+        recoverPendingBytes.set_value(pendingBytes);
+        recoverInflightBytes.set_value(inflightBytes);
+        recoverEtaSec.set_value(etaSec);
+    }
+
  private:
     /**
      * @brief GetOpPriorityStr Get the name of the priority level in string
@@ -141,6 +164,15 @@ class ScheduleMetricsT {
     bvar::Adder<uint32_t> changeOpNum;
     bvar::Adder<uint32_t> normalOpNum;
     bvar::Adder<uint32_t> highOpNum;
+    // bytes of offline replicas waiting for recovery
+    bvar::Status<uint64_t> recoverPendingBytes;
+    // bytes of replicas under recovery
+    bvar::Status<uint64_t> recoverInflightBytes;
+    // estimated seconds to finish recovery
+    bvar::Status<uint64_t> recoverEtaSec;
+    // bytes of replicas recovered and its throughput in last 60s
+    bvar::Adder<uint64_t> recoveredBytes;
+    bvar::PerSecond<bvar::Adder<uint64_t>> recoverThroughput;
     // specific operator under execution
     std::map<CopySetKey, StringStatus> operators;
 
@@ -101,6 +101,23 @@ struct ScheduleOption {
     // ScanScheduler: maximum number of scan copysets at the same time
     // for every chunkserver
     uint32_t scanConcurrentPerChunkserver;
+
+    // run every scheduler in one thread per logical pool, so that the
+    // logical pools are scheduled in parallel
+    bool schedulePerLogicalPool = false;
+
+    // RecoverScheduler: bandwidth of recovery on every chunkserver in MB/s,
+    // should be the same as the snapshot throttle of chunkserver.
+    // 0 means recovery is not paced by bandwidth
+    uint32_t recoverBandwidthPerDiskMBps = 0;
+
+    // RecoverScheduler: bandwidth of recovery on every server in MB/s,
+    // 0 means no limit
+    uint32_t recoverBandwidthPerHostMBps = 0;
+
+    // RecoverScheduler: expected time to finish recovery, recovery is slowed
+    // down if it can finish earlier. 0 means as fast as possible
+    uint32_t recoverTargetTimeSec = 0;
 };
 
 }  // namespace schedule
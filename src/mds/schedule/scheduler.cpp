@@ -40,6 +40,10 @@ int64_t Scheduler::GetRunningInterval() {
     return 0;
 }
 
+int Scheduler::ScheduleLogicalPool(PoolIdType lid) {
+    return 0;
+}
+
 /**
  * process for SelectBestPlacementChunkServer process description:
  * Purpose: For copyset-m(1, 2, 3), select a chunkserver-n in chunkserverList{1,
@@ -33,6 +33,7 @@
 #include "src/mds/schedule/schedule_define.h"
 #include "src/mds/schedule/topoAdapter.h"
 #include "src/mds/schedule/operatorController.h"
+#include "src/mds/schedule/recoverPlanner.h"
 #include "src/mds/topology/topology.h"
 #include "src/mds/schedule/operator.h"
 
@@ -90,6 +91,17 @@ class Scheduler {
      */
     virtual int64_t GetRunningInterval();
 
+    /**
+     * @brief producing operator according to the status of specified
+     *        logical pool, schedulers of different logical pools can run
+     *        concurrently
+     *
+     * @param[in] lid Logical pool id
+     *
+     * @return number of operators generated
+     */
+    virtual int ScheduleLogicalPool(PoolIdType lid);
+
  protected:
     /**
      * @brief SelectBestPlacementChunkServer Select a healthy chunkserver in
@@ -185,6 +197,15 @@ class CopySetScheduler : public Scheduler {
      */
     int64_t GetRunningInterval() override;
 
+    /**
+     * @brief balance copyset on specified logical pool
+     *
+     * @param[in] lid Logical pool id
+     *
+     * @return operator num generated
+     */
+    int ScheduleLogicalPool(PoolIdType lid) override;
+
  private:
     /**
      * @brief DoCopySetSchedule Operate copyset balancing on
@@ -316,6 +337,15 @@ class LeaderScheduler : public Scheduler {
      */
     int64_t GetRunningInterval() override;
 
+    /**
+     * @brief balance leader on specified logical pool
+     *
+     * @param[in] lid Logical pool id
+     *
+     * @return number of operators generated
+     */
+    int ScheduleLogicalPool(PoolIdType lid) override;
+
  private:
     /**
      * @brief Select a leader copyset randomly on the source chunkserver,
@@ -400,6 +430,7 @@ class RecoverScheduler : public Scheduler {
         : Scheduler(opt, topo, opController) {
         runInterval_ = opt.recoverSchedulerIntervalSec;
         chunkserverFailureTolerance_ = opt.chunkserverFailureTolerance;
+        planner_ = std::make_shared<RecoverPlanner>(opt, topo, opController);
     }
 
     /**
@@ -416,7 +447,46 @@ class RecoverScheduler : public Scheduler {
      */
     int64_t GetRunningInterval() override;
 
+    /**
+     * @brief recovering the offline replica on specified logical pool
+     *
+     * @param[in] lid Logical pool id
+     *
+     * @return the number of operators generated
+     */
+    int ScheduleLogicalPool(PoolIdType lid) override;
+
  private:
+    // copyset that has offline replica to recover
+    struct RecoverCandidate {
+        const CopySetInfo *info;
+        // the offline replica to recover
+        ChunkServerIdType offline;
+        // online replicas, leader is the first one if it is online
+        std::vector<PeerInfo> onlinePeers;
+        // estimated bytes to copy
+        uint64_t bytes;
+    };
+
+    /**
+     * @brief recovering the offline replica of copysets, copysets with
+     *        fewer online replicas are recovered first
+     *
+     * @param[in] lid Logical pool of the copysets,
+     *                UNINTIALIZE_ID means all logical pools
+     * @param[in] copysetInfos Copysets to check
+     * @param[in] excludes Offline chunkservers that will not be recovered
+     * @param[in] chunkservers Chunkserver infos already fetched, chunkserver
+     *                         not in it will be fetched from topology
+     *
+     * @return the number of operators generated
+     */
+    int RecoverCopySets(
+        PoolIdType lid,
+        const std::vector<CopySetInfo> &copysetInfos,
+        const std::set<ChunkServerIdType> &excludes,
+        const std::map<ChunkServerIdType, ChunkServerInfo> &chunkservers);
+
     /**
      * @brief fix the specified replica
      *
@@ -430,21 +500,38 @@ class RecoverScheduler : public Scheduler {
     bool FixOfflinePeer(const CopySetInfo &info, ChunkServerIdType peerId,
         Operator *op, ChunkServerIdType *target);
 
+    /**
+     * @brief check whether the bandwidth allows copying data of the
+     *        candidate to target now
+     *
+     * @param[in] candidate The copyset to be recovered
+     * @param[in] target The replica added
+     *
+     * @return true if the recovery can start now
+     */
+    bool AdmitRecover(const RecoverCandidate &candidate,
+                      ChunkServerIdType target);
+
     /**
      * @brief calculate the number of the chunkserver that has offline
      *        replicas more than a specific number on a server. for those
      *        server, the chunkserver on it will not be recovered.
      *
+     * @param[in] csInfos Chunkservers to calculate
      * @param[out] excludes Chunkservers on the server that has offline
      *                      Chunkserver more than a specified number
      */
-    void CalculateExcludesChunkServer(std::set<ChunkServerIdType> *excludes);
+    void CalculateExcludesChunkServer(
+        const std::vector<ChunkServerInfo> &csInfos,
+        std::set<ChunkServerIdType> *excludes);
 
  private:
     // running interval of RecoverScheduler
     int64_t runInterval_;
     // the threshold of the failing chunkserver that the server will not be recovered //NOLINT
     int32_t chunkserverFailureTolerance_;
+    // pace the data copy of recovery
+    std::shared_ptr<RecoverPlanner> planner_;
 };
 
 // Check replica numbers of the copyset according to the configuration, and
@@ -474,6 +561,26 @@ class ReplicaScheduler : public Scheduler {
      */
     int64_t GetRunningInterval() override;
 
+    /**
+     * @brief check replica number of copysets on specified logical pool
+     *
+     * @param[in] lid Logical pool id
+     *
+     * @return the number of operators generated
+     */
+    int ScheduleLogicalPool(PoolIdType lid) override;
+
+ private:
+    /**
+     * @brief check replica number of copysets, and generate operator for
+     *        adjustment if not satisfied
+     *
+     * @param[in] copysetInfos Copysets to check
+     *
+     * @return the number of operators generated
+     */
+    int CheckReplicaNum(const std::vector<CopySetInfo> &copysetInfos);
+
  private:
     // time interval of replicaScheduler
     int64_t runInterval_;
@@ -587,7 +694,21 @@ class ScanScheduler : public Scheduler {
      */
     int64_t GetRunningInterval() override;
 
+    /**
+     * @brief Generate scan operators for specified logical pool
+     * @param[in] lid Logical pool id
+     * @return number of operators generated
+     */
+    int ScheduleLogicalPool(PoolIdType lid) override;
+
  private:
+    /**
+     * @brief Select copysets to start/cancel scan on specified logical pool
+     * @param[in] lpid Logical pool id
+     * @return number of operators generated
+     */
+    int DoScanSchedule(PoolIdType lpid);
+
     /**
      * @brief Check whether the specify copyset is start/ready to scan
      * @param[in] copysetInfo the specify copyset
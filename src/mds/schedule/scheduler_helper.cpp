@@ -156,8 +156,8 @@ bool SchedulerHelper::SatisfyZoneAndScatterWidthLimit(
 void SchedulerHelper::SortDistribute(
     const std::map<ChunkServerIdType, std::vector<CopySetInfo>> &distribute,
     std::vector<std::pair<ChunkServerIdType, std::vector<CopySetInfo>>> *desc) {
-    static std::random_device rd;
-    static std::mt19937 g(rd());
+    thread_local std::random_device rd;
+    thread_local std::mt19937 g(rd());
 
     for (auto item : distribute) {
         std::shuffle(item.second.begin(), item.second.end(), g);
@@ -202,8 +202,8 @@ void SchedulerHelper::SortChunkServerByCopySetNumAsc(
     }
 
     // randomize chunkserverlist
-    static std::random_device rd;
-    static std::mt19937 g(rd());
+    thread_local std::random_device rd;
+    thread_local std::mt19937 g(rd());
     std::shuffle(transfer.begin(), transfer.end(), g);
 
     // sort
@@ -221,8 +221,8 @@ void SchedulerHelper::SortChunkServerByCopySetNumAsc(
 
 void SchedulerHelper::SortScatterWitAffected(
     std::vector<std::pair<ChunkServerIdType, int>> *candidates) {
-    static std::random_device rd;
-    static std::mt19937 g(rd());
+    thread_local std::random_device rd;
+    thread_local std::mt19937 g(rd());
     std::shuffle(candidates->begin(), candidates->end(), g);
 
     std::sort(candidates->begin(), candidates->end(),
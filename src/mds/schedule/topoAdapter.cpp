@@ -208,9 +208,11 @@ std::vector<CopySetInfo> TopoAdapterImpl::GetCopySetInfosInChunkServer(
 std::vector<CopySetInfo> TopoAdapterImpl::GetCopySetInfosInLogicalPool(
     PoolIdType lid) {
     std::vector<CopySetInfo> infos;
+    // copysets in a logical pool share a small set of chunkservers
+    std::map<ChunkServerIdType, PeerInfo> peers;
     for (auto &copysetInfo : topo_->GetCopySetInfosInLogicalPool(lid)) {
         ::curve::mds::schedule::CopySetInfo out;
-        if (CopySetFromTopoToSchedule(copysetInfo, &out)) {
+        if (ConvertCopySet(copysetInfo, &out, &peers)) {
             infos.emplace_back(out);
         }
     }
@@ -304,7 +306,16 @@ int TopoAdapterImpl::GetAvgScatterWidthInLogicalPool(PoolIdType id) {
     return 0;
 }
 
-bool TopoAdapterImpl::GetPeerInfo(ChunkServerIdType id, PeerInfo *peerInfo) {
+bool TopoAdapterImpl::GetPeerInfo(ChunkServerIdType id, PeerInfo *peerInfo,
+    std::map<ChunkServerIdType, PeerInfo> *cache) {
+    if (cache != nullptr) {
+        auto it = cache->find(id);
+        if (it != cache->end()) {
+            *peerInfo = it->second;
+            return true;
+        }
+    }
+
     ::curve::mds::topology::ChunkServer cs;
     ::curve::mds::topology::Server server;
 
@@ -320,12 +331,23 @@ bool TopoAdapterImpl::GetPeerInfo(ChunkServerIdType id, PeerInfo *peerInfo) {
                    << ") or Server(res:" << canGetServer << ")";
         return false;
     }
+
+    if (cache != nullptr) {
+        cache->emplace(id, *peerInfo);
+    }
     return true;
 }
 
 bool TopoAdapterImpl::CopySetFromTopoToSchedule(
     const ::curve::mds::topology::CopySetInfo &origin,
     ::curve::mds::schedule::CopySetInfo *out) {
+    return ConvertCopySet(origin, out, nullptr);
+}
+
+bool TopoAdapterImpl::ConvertCopySet(
+    const ::curve::mds::topology::CopySetInfo &origin,
+    ::curve::mds::schedule::CopySetInfo *out,
+    std::map<ChunkServerIdType, PeerInfo> *cache) {
     assert(out != nullptr);
 
     out->id.first = origin.GetLogicalPoolId();
@@ -337,7 +359,7 @@ bool TopoAdapterImpl::CopySetFromTopoToSchedule(
 
     for (auto id : origin.GetCopySetMembers()) {
         PeerInfo peerInfo;
-        if (GetPeerInfo(id, &peerInfo)) {
+        if (GetPeerInfo(id, &peerInfo, cache)) {
             out->peers.emplace_back(peerInfo);
         } else {
             return false;
@@ -346,7 +368,7 @@ bool TopoAdapterImpl::CopySetFromTopoToSchedule(
 
     if (origin.HasCandidate()) {
         PeerInfo peerInfo;
-        if (GetPeerInfo(origin.GetCandidate(), &peerInfo)) {
+        if (GetPeerInfo(origin.GetCandidate(), &peerInfo, cache)) {
             out->candidatePeerInfo = peerInfo;
         } else {
             return false;
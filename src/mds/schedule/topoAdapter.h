@@ -394,7 +394,25 @@ class TopoAdapterImpl : public TopoAdapter {
         std::map<ChunkServerIdType, int> *out) override;
 
  private:
-    bool GetPeerInfo(ChunkServerIdType id, PeerInfo *peerInfo);
+    /**
+     * @brief get peer info of chunkserver
+     *
+     * @param[in] id Chunkserver id
+     * @param[out] peerInfo Peer info
+     * @param[in,out] cache Peer infos already fetched, can be nullptr
+     */
+    bool GetPeerInfo(ChunkServerIdType id, PeerInfo *peerInfo,
+                     std::map<ChunkServerIdType, PeerInfo> *cache = nullptr);
+
+    /**
+     * @brief same as CopySetFromTopoToSchedule, but peer infos are looked
+     *        up in cache first, it saves the chunkserver and server lookup
+     *        when converting all copysets of a logical pool
+     */
+    bool ConvertCopySet(
+        const ::curve::mds::topology::CopySetInfo &origin,
+        ::curve::mds::schedule::CopySetInfo *out,
+        std::map<ChunkServerIdType, PeerInfo> *cache);
 
  private:
     std::shared_ptr<Topology> topo_;
@@ -55,6 +55,7 @@ void MDS::InitMdsOptions(std::shared_ptr<Configuration> conf) {
     InitTopologyOption(&options_.topologyOption);
     InitCopysetOption(&options_.copysetOption);
     InitChunkServerClientOption(&options_.chunkServerClientOption);
+    InitCleanCoreOption(&options_.cleanCoreOption);
     InitSnapshotCloneClientOption(&options_.snapshotCloneClientOption);
 
     conf_->GetValueFatalIfFail(
@@ -65,6 +66,10 @@ void MDS::InitMdsOptions(std::shared_ptr<Configuration> conf) {
 
     // cache size of namestorage
     conf_->GetValueFatalIfFail("mds.cache.count", &options_.mdsCacheCount);
+    options_.metaCacheOption.maxCount = options_.mdsCacheCount;
+    conf_->GetUInt32Value("mds.cache.shardNum",
+                          &options_.metaCacheOption.shardNum);
+    conf_->GetBoolValue("mds.cache.warmup", &options_.metaCacheOption.warmup);
 
     conf_->GetValueFatalIfFail("mds.listen.addr", &options_.mdsListenAddr);
 
@@ -121,7 +126,7 @@ void MDS::StartCompaginLeader() {
 void MDS::Init() {
     InitSegmentAllocStatistic(options_.retryInterTimes,
                               options_.periodicPersistInterMs);
-    InitNameServerStorage(options_.mdsCacheCount);
+    InitNameServerStorage(options_.mdsCacheCount, options_.metaCacheOption);
     InitTopology(options_.topologyOption);
     InitTopologyStat();
     InitTopologyChunkAllocator(options_.topologyOption);
@@ -401,16 +406,31 @@ void MDS::InitTopologyChunkAllocator(const TopologyOption& option) {
     LOG(INFO) << "init topologyChunkAllocator success.";
 }
 
-void MDS::InitNameServerStorage(int mdsCacheCount) {
+void MDS::InitNameServerStorage(int mdsCacheCount,
+                                const NameSpaceMetaCacheOption& option) {
     // init LRUCache
 
     auto cache = std::make_shared<LRUCache>(mdsCacheCount,
         std::make_shared<CacheMetrics>("mds_nameserver_cache_metric"));
     LOG(INFO) << "init LRUCache success.";
 
+    // init typed cache, it takes the place of LRUCache if enabled
+    std::shared_ptr<NameSpaceMetaCache> metaCache;
+    if (option.shardNum > 0) {
+        metaCache = std::make_shared<NameSpaceMetaCache>(
+            option.shardNum, option.maxCount,
+            std::make_shared<CacheMetrics>(
+                "mds_nameserver_meta_cache_metric"));
+    }
+
     // init NameServerStorage
-    nameServerStorage_ = std::make_shared<NameServerStorageImp>(etcdClient_,
-                                                                cache);
+    auto storage = std::make_shared<NameServerStorageImp>(
+        etcdClient_, cache, metaCache);
+    if (metaCache != nullptr && option.warmup) {
+        LOG_IF(WARNING, storage->WarmupCache() != StoreStatus::OK)
+            << "warmup namespace meta cache fail, load on demand.";
+    }
+    nameServerStorage_ = storage;
     LOG(INFO) << "init NameServerStorage success.";
 }
 
@@ -541,7 +561,8 @@ void MDS::InitCleanManager() {
 
     auto cleanCore = std::make_shared<CleanCore>(nameServerStorage_,
                                                  copysetClient,
-                                                 segmentAllocStatistic_);
+                                                 segmentAllocStatistic_,
+                                                 options_.cleanCoreOption);
 
     // init dlock options
     auto dlockOpts = std::make_shared<DLockOpts>();
@@ -567,6 +588,29 @@ void MDS::InitChunkServerClientOption(ChunkServerClientOption *option) {
         &option->updateLeaderRetryIntervalMs);
 }
 
+void MDS::InitCleanCoreOption(CleanCoreOption *option) {
+    bool ret = conf_->GetUInt32Value("mds.clean.deleteConcurrency",
+                                     &option->deleteConcurrency);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.clean.deleteConcurrency info, using default value "
+        << option->deleteConcurrency;
+    ret = conf_->GetUInt32Value("mds.clean.deleteBatchSize",
+                                &option->deleteBatchSize);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.clean.deleteBatchSize info, using default value "
+        << option->deleteBatchSize;
+    ret = conf_->GetUInt64Value("mds.clean.deleteChunksPerSecond",
+                                &option->deleteChunksPerSecond);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.clean.deleteChunksPerSecond info, "
+        << "using default value " << option->deleteChunksPerSecond;
+    ret = conf_->GetUInt32Value("mds.clean.segmentsPerRound",
+                                &option->segmentsPerRound);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.clean.segmentsPerRound info, using default value "
+        << option->segmentsPerRound;
+}
+
 void MDS::InitCoordinator() {
     // init option
     ScheduleOption scheduleOption;
@@ -633,6 +677,32 @@ void MDS::InitScheduleOption(ScheduleOption *scheduleOption) {
         &scheduleOption->scanConcurrentPerPool);
     conf_->GetValueFatalIfFail("mds.scheduler.scan.concurrent.per.chunkserver",
         &scheduleOption->scanConcurrentPerChunkserver);
+
+    bool ret = conf_->GetBoolValue("mds.scheduler.perLogicalPool",
+                                   &scheduleOption->schedulePerLogicalPool);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.scheduler.perLogicalPool info, using default value "
+        << scheduleOption->schedulePerLogicalPool;
+
+    ret = conf_->GetUInt32Value("mds.scheduler.recover.bandwidthPerDiskMBps",
+                                &scheduleOption->recoverBandwidthPerDiskMBps);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.scheduler.recover.bandwidthPerDiskMBps info, "
+        << "using default value "
+        << scheduleOption->recoverBandwidthPerDiskMBps;
+
+    ret = conf_->GetUInt32Value("mds.scheduler.recover.bandwidthPerHostMBps",
+                                &scheduleOption->recoverBandwidthPerHostMBps);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.scheduler.recover.bandwidthPerHostMBps info, "
+        << "using default value "
+        << scheduleOption->recoverBandwidthPerHostMBps;
+
+    ret = conf_->GetUInt32Value("mds.scheduler.recover.targetTimeSec",
+                                &scheduleOption->recoverTargetTimeSec);
+    LOG_IF(WARNING, ret == false)
+        << "config no mds.scheduler.recover.targetTimeSec info, "
+        << "using default value " << scheduleOption->recoverTargetTimeSec;
 }
 
 void MDS::InitHeartbeatManager() {
@@ -656,6 +726,54 @@ void MDS::InitHeartbeatOption(HeartbeatOption* heartbeatOption) {
                         &heartbeatOption->offLineTimeOutMs);
     conf_->GetValueFatalIfFail("mds.heartbeat.clean_follower_afterMs",
                         &heartbeatOption->cleanFollowerAfterMs);
+
+    InitQosConf(&heartbeatOption->enableQos, &heartbeatOption->qosConf);
+}
+
+void MDS::InitQosConf(bool* enableQos, QosConf* qosConf) {
+    *enableQos = conf_->GetBoolValue("mds.qos.enable", false);
+    if (!*enableQos) {
+        return;
+    }
+
+    InitQosSpec("mds.qos.volume", 100, qosConf->mutable_volumespec());
+    const struct {
+        QosClass ioClass;
+        std::string prefix;
+        uint32_t defaultWeight;
+    } classes[] = {
+        // the weight of client traffic is given per volume
+        {QosClass::QOS_CLASS_CLIENT, "mds.qos.client", 1},
+        {QosClass::QOS_CLASS_RECOVERY, "mds.qos.recovery", 20},
+        {QosClass::QOS_CLASS_SCAN, "mds.qos.scan", 10},
+        {QosClass::QOS_CLASS_CLONE, "mds.qos.clone", 20},
+    };
+    for (const auto& cls : classes) {
+        QosClassSpec* classSpec = qosConf->add_classspecs();
+        classSpec->set_ioclass(cls.ioClass);
+        InitQosSpec(cls.prefix, cls.defaultWeight,
+                    classSpec->mutable_spec());
+    }
+}
+
+void MDS::InitQosSpec(const std::string& prefix, uint32_t defaultWeight,
+                      QosSpec* spec) {
+    uint64_t reservation = 0;
+    uint64_t limit = 0;
+    uint32_t weight = defaultWeight;
+    LOG_IF(WARNING, !conf_->GetUInt64Value(prefix + ".reservationIops",
+                                           &reservation))
+        << "config no " << prefix << ".reservationIops info, "
+        << "using default value " << reservation;
+    LOG_IF(WARNING, !conf_->GetUInt64Value(prefix + ".limitIops", &limit))
+        << "config no " << prefix << ".limitIops info, "
+        << "using default value " << limit;
+    LOG_IF(WARNING, !conf_->GetUInt32Value(prefix + ".weight", &weight))
+        << "config no " << prefix << ".weight info, "
+        << "using default value " << weight;
+    spec->set_reservation(reservation);
+    spec->set_limit(limit);
+    spec->set_weight(weight);
 }
 }  // namespace mds
 }  // namespace curve
@@ -72,6 +72,10 @@ using ::curve::mds::copyset::CopysetManager;
 using ::curve::mds::copyset::CopysetOption;
 using ::curve::mds::heartbeat::HeartbeatServiceImpl;
 using ::curve::mds::heartbeat::HeartbeatOption;
+using ::curve::mds::heartbeat::QosClass;
+using ::curve::mds::heartbeat::QosClassSpec;
+using ::curve::mds::heartbeat::QosConf;
+using ::curve::mds::heartbeat::QosSpec;
 using ::curve::mds::schedule::TopoAdapterImpl;
 using ::curve::mds::schedule::TopoAdapter;
 using ::curve::mds::schedule::ScheduleOption;
@@ -97,6 +101,8 @@ struct MDSOptions {
     uint64_t periodicPersistInterMs;
     // cache size of namestorage
     int mdsCacheCount;
+    // typed cache of namestorage
+    NameSpaceMetaCacheOption metaCacheOption;
     int mdsFilelockBucketNum;
 
     FileRecordOptions fileRecordOptions;
@@ -108,6 +114,7 @@ struct MDSOptions {
     CopysetOption copysetOption;
     ChunkServerClientOption chunkServerClientOption;
     SnapshotCloneClientOption snapshotCloneClientOption;
+    CleanCoreOption cleanCoreOption;
 };
 
 class MDS {
@@ -159,6 +166,11 @@ class MDS {
 
     void InitHeartbeatOption(HeartbeatOption* heartbeatOption);
 
+    void InitQosConf(bool* enableQos, QosConf* qosConf);
+
+    void InitQosSpec(const std::string& prefix, uint32_t defaultWeight,
+                     QosSpec* spec);
+
     void InitEtcdConf(EtcdConf* etcdConf);
 
     void InitMdsLeaderElectionOption(LeaderElectionOptions* electionOp);
@@ -169,6 +181,8 @@ class MDS {
 
     void InitChunkServerClientOption(ChunkServerClientOption *option);
 
+    void InitCleanCoreOption(CleanCoreOption *option);
+
     void InitSnapshotCloneClientOption(SnapshotCloneClientOption *option);
 
     void InitEtcdClient(const EtcdConf& etcdConf,
@@ -180,7 +194,8 @@ class MDS {
     void InitSegmentAllocStatistic(uint64_t retryInterTimes,
                                    uint64_t periodicPersistInterMs);
 
-    void InitNameServerStorage(int mdsCacheCount);
+    void InitNameServerStorage(int mdsCacheCount,
+                               const NameSpaceMetaCacheOption& option);
 
     void StartServer();
 
@@ -82,6 +82,8 @@ void TopologyMetricService::UpdateTopologyMetrics() {
                 csStat.chunkSizeLeftBytes);
             it->second->chunkSizeTrashedBytes.set_value(
                 csStat.chunkSizeTrashedBytes);
+            it->second->chunkSizeReclaimableBytes.set_value(
+                csStat.chunkSizeReclaimableBytes);
             it->second->chunkSizeTotalBytes.set_value(
                 csStat.chunkSizeUsedBytes +
                 csStat.chunkSizeLeftBytes +
@@ -74,6 +74,8 @@ struct ChunkServerMetric {
     bvar::Status<uint64_t> chunkSizeLeftBytes;
     // disk capacity of recycle bin occupied by chunks
     bvar::Status<uint64_t> chunkSizeTrashedBytes;
+    // disk capacity of expired chunks being returned to chunkfilepool
+    bvar::Status<uint64_t> chunkSizeReclaimableBytes;
     // total capacity
     bvar::Status<uint64_t> chunkSizeTotalBytes;
 
@@ -106,6 +108,8 @@ struct ChunkServerMetric {
             std::to_string(csId) + "_chunkSizeLeftBytes", 0),
         chunkSizeTrashedBytes(kTopologyChunkServerMetricPrefix,
             std::to_string(csId) + "_chunkSizeTrashedBytes", 0),
+        chunkSizeReclaimableBytes(kTopologyChunkServerMetricPrefix,
+            std::to_string(csId) + "_chunkSizeReclaimableBytes", 0),
         chunkSizeTotalBytes(kTopologyChunkServerMetricPrefix,
             std::to_string(csId) + "_chunkSizeTotalBytes", 0) {}
 };
@@ -48,14 +48,18 @@ void TopologyStatImpl::UpdateChunkServerStat(ChunkServerIdType csId,
                    << csId;
         return;
     }
+    // expired chunks in recycle bin will be returned to chunkfilepool soon,
+    // so they are available for allocation as well
+    uint64_t poolSize = stat.chunkFilepoolSize + stat.chunkSizeReclaimableBytes;
     auto it = chunkServerStats_.find(csId);
     if (it != chunkServerStats_.end()) {
-        int64_t diff = stat.chunkFilepoolSize - it->second.chunkFilepoolSize;
+        int64_t diff = poolSize - (it->second.chunkFilepoolSize +
+                                   it->second.chunkSizeReclaimableBytes);
         ChunkPoolSize_[belongPhysicalPoolId] += diff;
         it->second = stat;
     } else {
         chunkServerStats_.emplace(csId, stat);
-        ChunkPoolSize_[belongPhysicalPoolId] += stat.chunkFilepoolSize;
+        ChunkPoolSize_[belongPhysicalPoolId] += poolSize;
     }
     return;
 }
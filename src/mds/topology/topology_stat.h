@@ -64,6 +64,28 @@ struct CopysetStat {
         writeIOPS(0) {}
 };
 
+// A frequently accessed chunk reported by chunkserver
+struct HotChunkStat {
+    // Volume the chunk belongs to
+    uint64_t fileId;
+    PoolIdType logicalPoolId;
+    CopySetIdType copysetId;
+    ChunkIdType chunkId;
+    // Access count decayed over time on chunkserver
+    uint64_t accessCount;
+    // Decayed read and write counts since the chunk became hot
+    uint64_t readCount;
+    uint64_t writeCount;
+    HotChunkStat() :
+        fileId(0),
+        logicalPoolId(UNINTIALIZE_ID),
+        copysetId(UNINTIALIZE_ID),
+        chunkId(0),
+        accessCount(0),
+        readCount(0),
+        writeCount(0) {}
+};
+
 struct ChunkServerStat {
     // Leader number the heartbeat reported
     uint32_t leaderCount;
@@ -85,9 +107,13 @@ struct ChunkServerStat {
     uint64_t chunkSizeTrashedBytes;
     // Size of chunkfilepool
     uint64_t chunkFilepoolSize;
+    // Size of expired chunks in recycle bin being returned to chunkfilepool
+    uint64_t chunkSizeReclaimableBytes;
 
     // Copyset statistic
     std::vector<CopysetStat> copysetStats;
+    // Most frequently accessed chunks, in descending order of access count
+    std::vector<HotChunkStat> hotChunks;
 
     ChunkServerStat() :
         leaderCount(0),
@@ -95,7 +121,8 @@ struct ChunkServerStat {
         readRate(0),
         writeRate(0),
         readIOPS(0),
-        writeIOPS(0) {}
+        writeIOPS(0),
+        chunkSizeReclaimableBytes(0) {}
 };
 
 /**
@@ -127,6 +154,7 @@ class TopologyStat {
         ChunkServerStat *stat) = 0;
     /**
      * @brief fetch the statistic information of chunkPool size that sent by heartbeat
+     *        chunks being returned from recycle bin are counted as chunkPool
      *
      * @param pId physicalId
      * @param chunkpoolsize the size of chunkpool
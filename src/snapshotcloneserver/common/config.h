@@ -71,6 +71,8 @@ struct SnapshotCloneServerOptions {
     uint32_t mdsSessionTimeUs;
     // ReadChunkSnapshot同时进行的异步请求数量
     uint32_t readChunkSnapshotConcurrency;
+    // 是否跳过全零chunk的转储
+    bool skipZeroChunk = false;
 
     // 用于Lazy克隆元数据部分的线程池线程数
     int stage1PoolThreadNum;
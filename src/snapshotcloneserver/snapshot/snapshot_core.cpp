@@ -826,6 +826,9 @@ int SnapshotCoreImpl::TransferSnapshotData(
     }
 
     auto tracker = std::make_shared<TaskTracker>();
+    // 开启skipZeroChunk时，记录转储任务以便收集全零chunk
+    std::vector<std::shared_ptr<TransferSnapshotDataChunkTaskInfo>>
+        transferTaskInfos;
     for (auto &chunkIndex : chunkIndexVec) {
         ChunkDataName chunkDataName;
         indexData.GetChunkDataName(chunkIndex, &chunkDataName);
@@ -842,7 +845,11 @@ int SnapshotCoreImpl::TransferSnapshotData(
                         chunkDataName, chunkSize, cidInfo, chunkSplitSize_,
                         clientAsyncMethodRetryTimeSec_,
                         clientAsyncMethodRetryIntervalMs_,
-                        readChunkSnapshotConcurrency_);
+                        readChunkSnapshotConcurrency_,
+                        skipZeroChunk_);
+                if (skipZeroChunk_) {
+                    transferTaskInfos.push_back(taskInfo);
+                }
                 UUID taskId = UUIDGenerator().GenerateUUID();
                 auto task = new TransferSnapshotDataChunkTask(
                     taskId,
@@ -886,6 +893,36 @@ int SnapshotCoreImpl::TransferSnapshotData(
         return ret;
     }
 
+    // 全零chunk没有转储数据对象，从索引中移除，
+    // 克隆和恢复时未分配的chunk读出即为全零。
+    // 在这之前进程退出时快照仍为pending，索引中的全零chunk没有数据对象，
+    // 恢复任务时按ChunkDataExist过滤会重新读取它们，再次跳过并移除；
+    // 快照在索引重写之后才会变为done，不会从残缺的索引克隆或恢复
+    std::vector<ChunkIndexType> zeroChunks;
+    for (auto &taskInfo : transferTaskInfos) {
+        if (taskInfo->isZeroChunk_) {
+            zeroChunks.push_back(taskInfo->name_.chunkIndex_);
+        }
+    }
+    if (!zeroChunks.empty()) {
+        ChunkIndexData newIndexData = indexData;
+        for (auto chunkIndex : zeroChunks) {
+            newIndexData.EraseChunkDataName(chunkIndex);
+        }
+        ChunkIndexDataName name(info.GetFileName(), info.GetSeqNum());
+        ret = dataStore_->PutChunkIndexData(name, newIndexData);
+        if (ret < 0) {
+            LOG(ERROR) << "PutChunkIndexData error after skip zero chunk"
+                       << ", ret = " << ret
+                       << ", uuid = " << task->GetUuid();
+            return ret;
+        }
+        LOG(INFO) << "TransferSnapshotData skip zero chunk"
+                  << ", zeroChunkNum = " << zeroChunks.size()
+                  << ", transferChunkNum = " << transferTaskInfos.size()
+                  << ", uuid = " << task->GetUuid();
+    }
+
     return kErrCodeSuccess;
 }
 
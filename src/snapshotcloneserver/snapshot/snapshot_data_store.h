@@ -136,6 +136,10 @@ class ChunkIndexData {
         chunkMap_.emplace(name.chunkIndex_, name.chunkSeqNum_);
     }
 
+    void EraseChunkDataName(ChunkIndexType index) {
+        chunkMap_.erase(index);
+    }
+
     bool GetChunkDataName(ChunkIndexType index, ChunkDataName* nameOut) const;
 
     bool IsExistChunkDataName(const ChunkDataName &name) const;
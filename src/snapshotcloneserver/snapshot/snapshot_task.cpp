@@ -20,6 +20,7 @@
  * Author: xuchaojie
  */
 
+#include <cstring>
 #include <list>
 
 #include "src/common/timeutility.h"
@@ -28,6 +29,15 @@
 namespace curve {
 namespace snapshotcloneserver {
 
+namespace {
+
+bool IsZeroBuffer(const char *buf, uint64_t len) {
+    return len == 0 ||
+        (buf[0] == 0 && std::memcmp(buf, buf + 1, len - 1) == 0);
+}
+
+}  // namespace
+
 void ReadChunkSnapshotClosure::Run() {
     std::unique_ptr<ReadChunkSnapshotClosure> self_guard(this);
     context_->retCode = GetRetCode();
@@ -56,6 +66,8 @@ void ReadChunkSnapshotClosure::Run() {
  *  4. 重复2、3直到所有分片转储完成，调用DataChunkTranferComplete结束转储任务
  *  5. 中间如有读取或转储发生错误，则调用DataChunkTranferAbort放弃转储，
  *  并返回错误码
+ *  6. 开启skipZeroChunk时，若chunk全零则调用DataChunkTranferAbort放弃转储，
+ *  并设置isZeroChunk_，由调用方从索引中移除该chunk
  *
  * @return 错误码
  */
@@ -122,6 +134,17 @@ int TransferSnapshotDataChunkTask::TransferSnapshotDataChunk() {
                 break;
             }
         } while (true);
+        if (ret >= 0 && !hasData_) {
+            // 整个chunk全零，放弃转储，由调用方从索引中移除该chunk
+            int ret2 = dataStore_->DataChunkTranferAbort(name, transferTask);
+            if (ret2 < 0) {
+                LOG(WARNING) << "DataChunkTranferAbort fail"
+                             << ", ret = " << ret2
+                             << ", chunkDataName = " << name.ToDataChunkKey();
+            }
+            taskInfo_->isZeroChunk_ = true;
+            return kErrCodeSuccess;
+        }
         if (ret >= 0) {
             ret =
                 dataStore_->DataChunkTranferComplete(name, transferTask);
@@ -211,18 +234,8 @@ int TransferSnapshotDataChunkTask::HandleReadChunkSnapshotResultsAndRetry(
                 return ret;
             }
         } else {
-            ret = dataStore_->DataChunkTranferAddPart(
-                taskInfo_->name_,
-                transferTask,
-                context->partIndex,
-                context->len,
-                context->buf.get());
+            ret = AddPart(transferTask, context);
             if (ret < 0) {
-                LOG(ERROR) << "DataChunkTranferAddPart fail"
-                           << ", ret = " << ret
-                           << ", chunkDataName = "
-                           << taskInfo_->name_.ToDataChunkKey()
-                           << ", index = " << context->partIndex;
                 return ret;
             }
         }
@@ -230,5 +243,56 @@ int TransferSnapshotDataChunkTask::HandleReadChunkSnapshotResultsAndRetry(
     return ret;
 }
 
+int TransferSnapshotDataChunkTask::AddPart(
+    std::shared_ptr<TransferTask> transferTask,
+    const ReadChunkSnapshotContextPtr &context) {
+    if (!taskInfo_->skipZeroChunk_) {
+        hasData_ = true;
+    } else if (!hasData_) {
+        if (IsZeroBuffer(context->buf.get(), context->len)) {
+            pendingZeroParts_.push_back(context->partIndex);
+            return kErrCodeSuccess;
+        }
+        hasData_ = true;
+        // 出现非零分片，补上之前延迟的全零分片
+        if (!pendingZeroParts_.empty()) {
+            std::unique_ptr<char[]> zeroBuf(new char[context->len]());
+            for (auto partIndex : pendingZeroParts_) {
+                int ret = dataStore_->DataChunkTranferAddPart(
+                    taskInfo_->name_,
+                    transferTask,
+                    partIndex,
+                    context->len,
+                    zeroBuf.get());
+                if (ret < 0) {
+                    LOG(ERROR) << "DataChunkTranferAddPart fail"
+                               << ", ret = " << ret
+                               << ", chunkDataName = "
+                               << taskInfo_->name_.ToDataChunkKey()
+                               << ", index = " << partIndex;
+                    return ret;
+                }
+            }
+            pendingZeroParts_.clear();
+        }
+    }
+
+    int ret = dataStore_->DataChunkTranferAddPart(
+        taskInfo_->name_,
+        transferTask,
+        context->partIndex,
+        context->len,
+        context->buf.get());
+    if (ret < 0) {
+        LOG(ERROR) << "DataChunkTranferAddPart fail"
+                   << ", ret = " << ret
+                   << ", chunkDataName = "
+                   << taskInfo_->name_.ToDataChunkKey()
+                   << ", index = " << context->partIndex;
+        return ret;
+    }
+    return kErrCodeSuccess;
+}
+
 }  // namespace snapshotcloneserver
 }  // namespace curve
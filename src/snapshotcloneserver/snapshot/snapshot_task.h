@@ -26,6 +26,7 @@
 #include <string>
 #include <memory>
 #include <list>
+#include <vector>
 
 #include "src/snapshotcloneserver/snapshot/snapshot_core.h"
 #include "src/common/snapshotclone/snapshotclone_define.h"
@@ -215,6 +216,10 @@ struct TransferSnapshotDataChunkTaskInfo : public TaskInfo {
     uint64_t clientAsyncMethodRetryTimeSec_;
     uint64_t clientAsyncMethodRetryIntervalMs_;
     uint32_t readChunkSnapshotConcurrency_;
+    // 是否跳过全零chunk的转储
+    bool skipZeroChunk_;
+    // 转储结果，chunk数据全零未转储
+    bool isZeroChunk_;
 
     TransferSnapshotDataChunkTaskInfo(const ChunkDataName &name,
         uint64_t chunkSize,
@@ -222,14 +227,17 @@ struct TransferSnapshotDataChunkTaskInfo : public TaskInfo {
         uint64_t chunkSplitSize,
         uint64_t clientAsyncMethodRetryTimeSec,
         uint64_t clientAsyncMethodRetryIntervalMs,
-        uint32_t readChunkSnapshotConcurrency)
+        uint32_t readChunkSnapshotConcurrency,
+        bool skipZeroChunk = false)
         : name_(name),
           chunkSize_(chunkSize),
           cidInfo_(cidInfo),
           chunkSplitSize_(chunkSplitSize),
           clientAsyncMethodRetryTimeSec_(clientAsyncMethodRetryTimeSec),
           clientAsyncMethodRetryIntervalMs_(clientAsyncMethodRetryIntervalMs),
-          readChunkSnapshotConcurrency_(readChunkSnapshotConcurrency) {}
+          readChunkSnapshotConcurrency_(readChunkSnapshotConcurrency),
+          skipZeroChunk_(skipZeroChunk),
+          isZeroChunk_(false) {}
 };
 
 class TransferSnapshotDataChunkTask : public TrackerTask {
@@ -241,7 +249,8 @@ class TransferSnapshotDataChunkTask : public TrackerTask {
         : TrackerTask(taskId),
           taskInfo_(taskInfo),
           client_(client),
-          dataStore_(dataStore) {}
+          dataStore_(dataStore),
+          hasData_(false) {}
 
     std::shared_ptr<TransferSnapshotDataChunkTaskInfo> GetTaskInfo() const {
         return taskInfo_;
@@ -287,10 +296,26 @@ class TransferSnapshotDataChunkTask : public TrackerTask {
         std::shared_ptr<TransferTask> transferTask,
         const std::list<ReadChunkSnapshotContextPtr> &results);
 
+    /**
+     * @brief 转储一个分片，开启skipZeroChunk时全零分片延迟到
+     *        出现非零分片后再转储
+     *
+     * @param transferTask 转储任务
+     * @param context ReadChunkSnapshot上下文
+     *
+     * @return 错误码
+     */
+    int AddPart(std::shared_ptr<TransferTask> transferTask,
+        const ReadChunkSnapshotContextPtr &context);
+
  protected:
     std::shared_ptr<TransferSnapshotDataChunkTaskInfo> taskInfo_;
     std::shared_ptr<CurveFsClient> client_;
     std::shared_ptr<SnapshotDataStore> dataStore_;
+    // 是否已读到非零分片
+    bool hasData_;
+    // 延迟转储的全零分片
+    std::vector<uint64_t> pendingZeroParts_;
 };
 
 
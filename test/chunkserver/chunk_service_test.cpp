@@ -328,6 +328,31 @@ TEST_F(ChunkserverTest, normal_read_write_test) {
                 ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN,
                           response.status());
             }
+            /* 批量 delete，非 delete 请求单独返回失败 */
+            {
+                brpc::Controller cntl;
+                cntl.set_timeout_ms(rpcTimeoutMs);
+                DeleteChunksRequest request;
+                DeleteChunksResponse response;
+                ChunkRequest* req = request.add_requests();
+                req->set_optype(CHUNK_OP_TYPE::CHUNK_OP_READ);
+                req->set_logicpoolid(logicPoolId);
+                req->set_copysetid(copysetId);
+                req->set_chunkid(chunkId);
+                req = request.add_requests();
+                req->set_optype(CHUNK_OP_TYPE::CHUNK_OP_DELETE);
+                req->set_logicpoolid(logicPoolId);
+                req->set_copysetid(copysetId);
+                req->set_chunkid(chunkId);
+                req->set_sn(sn);
+                stub.DeleteChunks(&cntl, &request, &response, nullptr);
+                ASSERT_FALSE(cntl.Failed());
+                ASSERT_EQ(2, response.responses_size());
+                ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_INVALID_REQUEST,
+                          response.responses(0).status());
+                ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN,
+                          response.responses(1).status());
+            }
             /* Read 一个不存在的 Chunk */
             {
                 brpc::Controller cntl;
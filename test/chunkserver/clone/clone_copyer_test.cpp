@@ -23,6 +23,8 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <glog/logging.h>
+#include <cstring>
+#include <vector>
 
 #include "include/client/libcurve.h"
 #include "src/chunkserver/clone_copyer.h"
@@ -364,5 +366,121 @@ TEST_F(CloneCopyerTest, ExpiredTest) {
     ASSERT_EQ(0, copyer.Fini());
 }
 
+TEST_F(CloneCopyerTest, PrefetchTest) {
+    OriginCopyer copyer;
+    CopyerOptions options;
+    options.curveConf = CURVE_CONF;
+    options.s3Conf = S3_CONF;
+    options.curveUser.owner = ROOT_OWNER;
+    options.curveUser.password = ROOT_PWD;
+    options.curveClient = nullptr;
+    options.s3Client = s3Client_;
+    options.curveFileTimeoutSec = EXPIRED_USE;
+    options.chunkSize = 16 * 4096;
+    options.prefetchBlockSize = 4096;
+    options.prefetchMaxBlocks = 4;
+    options.cacheCapacity = 16 * 4096;
+    ASSERT_EQ(0, copyer.Init(options));
+
+    // 暂存s3请求，由用例控制下载完成的时机
+    std::vector<std::shared_ptr<GetObjectAsyncContext>> s3Contexts;
+    EXPECT_CALL(*s3Client_, GetObjectAsync(_))
+        .WillRepeatedly(Invoke(
+            [&] (const std::shared_ptr<GetObjectAsyncContext>& context) {
+                s3Contexts.push_back(context);
+            }));
+    auto finishS3 = [&](int retCode) {
+        auto context = s3Contexts.front();
+        s3Contexts.erase(s3Contexts.begin());
+        memset(context->buf, 'a', context->len);
+        context->retCode = retCode;
+        context->cb(s3Client_.get(), context);
+    };
+
+    char buf1[1024];
+    char buf2[1024];
+    AsyncDownloadContext context1;
+    context1.location = "test@s3";
+    context1.offset = 1024;
+    context1.size = 1024;
+    context1.buf = buf1;
+    MockDownloadClosure closure1(&context1);
+    AsyncDownloadContext context2 = context1;
+    context2.offset = 2048;
+    context2.buf = buf2;
+    MockDownloadClosure closure2(&context2);
+
+    /* 用例:两个请求落在同一个块上
+     * 预期:只下载一次整个块，两个请求都拿到数据
+     */
+    copyer.DownloadAsync(&closure1);
+    copyer.DownloadAsync(&closure2);
+    ASSERT_EQ(1, s3Contexts.size());
+    ASSERT_EQ(0, s3Contexts[0]->offset);
+    ASSERT_EQ(4096, s3Contexts[0]->len);
+    ASSERT_FALSE(closure1.IsRun());
+    finishS3(0);
+    ASSERT_TRUE(closure1.IsRun());
+    ASSERT_FALSE(closure1.IsFailed());
+    ASSERT_TRUE(closure2.IsRun());
+    ASSERT_EQ('a', buf1[0]);
+    ASSERT_EQ('a', buf2[1023]);
+    ASSERT_EQ(0, context1.windowOffset);
+    ASSERT_EQ(4096, context1.windowData.size());
+
+    /* 用例:再次读取同一个块
+     * 预期:从缓存中读取，不访问s3
+     */
+    closure1.Reset();
+    context1.windowData.clear();
+    copyer.DownloadAsync(&closure1);
+    ASSERT_EQ(0, s3Contexts.size());
+    ASSERT_TRUE(closure1.IsRun());
+    ASSERT_EQ(4096, context1.windowData.size());
+
+    /* 用例:顺序读取下一个块
+     * 预期:预取窗口加倍，一次下载两个块
+     */
+    closure1.Reset();
+    context1.offset = 4096;
+    copyer.DownloadAsync(&closure1);
+    ASSERT_EQ(1, s3Contexts.size());
+    ASSERT_EQ(4096, s3Contexts[0]->offset);
+    ASSERT_EQ(2 * 4096, s3Contexts[0]->len);
+    finishS3(0);
+    ASSERT_TRUE(closure1.IsRun());
+    ASSERT_EQ(4096, context1.windowOffset);
+
+    // 预取的块已经在缓存中
+    closure1.Reset();
+    context1.offset = 2 * 4096;
+    copyer.DownloadAsync(&closure1);
+    ASSERT_EQ(0, s3Contexts.size());
+    ASSERT_TRUE(closure1.IsRun());
+
+    /* 用例:下载失败
+     * 预期:等待该块的请求都返回失败，数据不放入缓存
+     */
+    closure1.Reset();
+    closure2.Reset();
+    context1.location = "test2@s3";
+    context2.location = "test2@s3";
+    copyer.DownloadAsync(&closure1);
+    copyer.DownloadAsync(&closure2);
+    ASSERT_EQ(1, s3Contexts.size());
+    finishS3(-1);
+    ASSERT_TRUE(closure1.IsFailed());
+    ASSERT_TRUE(closure2.IsFailed());
+    closure1.Reset();
+    copyer.DownloadAsync(&closure1);
+    ASSERT_EQ(1, s3Contexts.size());
+    finishS3(0);
+    ASSERT_FALSE(closure1.IsFailed());
+
+    EXPECT_CALL(*s3Client_, Deinit())
+        .Times(1);
+    ASSERT_EQ(0, copyer.Fini());
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -649,7 +649,8 @@ TEST_F(OpRequestTest, ReadChunkTest) {
      * 测试Process
      * 用例： node_->IsLeaderTerm() == true,
      *       请求的 apply index 小于等于 node的 apply index
-     * 预期： 不会走一致性协议，请求提交给concurrentApplyModule_处理
+     * 预期： 不会走一致性协议，也不需要检查lease是否过期，
+     *       请求提交给concurrentApplyModule_处理
      */
     {
         // 重置closure
@@ -660,6 +661,8 @@ TEST_F(OpRequestTest, ReadChunkTest) {
         // 设置预期
         EXPECT_CALL(*node_, IsLeaderTerm())
             .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsLeaseExpired(_))
+            .Times(0);
         EXPECT_CALL(*node_, Propose(_))
             .Times(0);
 
@@ -689,6 +692,86 @@ TEST_F(OpRequestTest, ReadChunkTest) {
         ASSERT_TRUE(closure->isDone_);
     }
 
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == true, lease有效,
+     *       请求没有携带 apply index
+     * 预期： 不会走一致性协议，请求提交给concurrentApplyModule_处理
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->clear_appliedindex();
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsLeaseExpired(_))
+            .Times(0);
+        EXPECT_CALL(*node_, IsLeaseLeader(_))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        info.isClone = false;
+        EXPECT_CALL(*datastore_, GetChunkInfo(_, _))
+            .WillOnce(
+                DoAll(SetArgPointee<1>(info), Return(CSErrorCode::Success)));
+
+        char chunkData[length];  // NOLINT
+        memset(chunkData, 'a', length);
+        EXPECT_CALL(*datastore_, ReadChunk(_, _, _, offset, length))
+            .WillOnce(DoAll(SetArrayArgument<2>(chunkData, chunkData + length),
+                            Return(CSErrorCode::Success)));
+        EXPECT_CALL(*node_, UpdateAppliedIndex(_)).Times(1);
+
+        opReq->Process();
+
+        int retry = 10;
+        while (retry-- > 0) {
+            if (closure->isDone_) {
+                break;
+            }
+
+            ::sleep(1);
+        }
+
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS,
+                  closure->response_->status());
+    }
+
+    /**
+     * 测试Process
+     * 用例： node_->IsLeaderTerm() == true, lease已经过期,
+     *       请求没有携带 apply index
+     * 预期： 不会propose，要求转发请求，返回CHUNK_OP_STATUS_REDIRECTED
+     */
+    {
+        // 重置closure
+        closure->Reset();
+
+        request->clear_appliedindex();
+
+        // 设置预期
+        EXPECT_CALL(*node_, IsLeaderTerm())
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*node_, IsLeaseLeader(_))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*node_, IsLeaseExpired(_))
+            .WillOnce(Return(true));
+        EXPECT_CALL(*node_, Propose(_))
+            .Times(0);
+
+        opReq->Process();
+
+        // 验证结果
+        ASSERT_TRUE(closure->isDone_);
+        ASSERT_EQ(CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED,
+                  closure->response_->status());
+    }
+
     /**
      * 测试OnApply
      * 用例：请求的 chunk 不是 clone chunk
@@ -1083,5 +1083,59 @@ TEST_F(CopysetNodeTest, get_leader_status) {
     }
 }
 
+TEST_F(CopysetNodeTest, leader_lease_status) {
+    LogicPoolID logicPoolID = 1;
+    CopysetID copysetID = 1;
+    Configuration conf;
+    std::shared_ptr<MockNode> mockNode
+            = std::make_shared<MockNode>(logicPoolID,
+                                         copysetID);
+    CopysetNode copysetNode(logicPoolID, copysetID, conf);
+    ASSERT_EQ(0, copysetNode.Init(defaultOptions_));
+    copysetNode.SetCopysetNode(mockNode);
+
+    braft::LeaderLeaseStatus leaseStatus;
+    leaseStatus.term = 8;
+    leaseStatus.state = braft::LEASE_VALID;
+    EXPECT_CALL(*mockNode, get_leader_lease_status(_))
+        .WillOnce(SetArgPointee<0>(leaseStatus));
+    braft::LeaderLeaseStatus status;
+    copysetNode.GetLeaderLeaseStatus(&status);
+    ASSERT_EQ(braft::LEASE_VALID, status.state);
+
+    // 还没有成为leader
+    ASSERT_FALSE(copysetNode.IsLeaseLeader(status));
+
+    // lease有效且任期一致
+    copysetNode.on_leader_start(8);
+    ASSERT_TRUE(copysetNode.IsLeaseLeader(status));
+    ASSERT_FALSE(copysetNode.IsLeaseExpired(status));
+
+    // lease是上一个任期的
+    status.term = 7;
+    ASSERT_FALSE(copysetNode.IsLeaseLeader(status));
+
+    // 新leader需要等待旧leader的lease过期
+    status.term = 8;
+    status.state = braft::LEASE_NOT_READY;
+    ASSERT_FALSE(copysetNode.IsLeaseLeader(status));
+    ASSERT_FALSE(copysetNode.IsLeaseExpired(status));
+
+    // 没有开启lease
+    status.state = braft::LEASE_DISABLED;
+    ASSERT_FALSE(copysetNode.IsLeaseLeader(status));
+    ASSERT_FALSE(copysetNode.IsLeaseExpired(status));
+
+    // lease过期
+    status.state = braft::LEASE_EXPIRED;
+    ASSERT_FALSE(copysetNode.IsLeaseLeader(status));
+    ASSERT_TRUE(copysetNode.IsLeaseExpired(status));
+
+    // step down之后lease不再有效
+    status.state = braft::LEASE_VALID;
+    copysetNode.on_leader_stop(butil::Status::OK());
+    ASSERT_FALSE(copysetNode.IsLeaseLeader(status));
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -381,6 +381,36 @@ TEST_F(CSDataStore_test, InitializeTest5) {
         .Times(1);
 }
 
+/**
+ * InitializeTest
+ * case:多个线程并发加载chunk文件
+ * 预期结果:所有chunk和快照都被加载，返回true
+ */
+TEST_F(CSDataStore_test, InitializeTest6) {
+    DataStoreOptions options;
+    options.baseDir = baseDir;
+    options.chunkSize = CHUNK_SIZE;
+    options.pageSize = PAGE_SIZE;
+    options.locationLimit = kLocationLimit;
+    options.enableOdsyncWhenOpenChunkFile = true;
+    options.loadConcurrency = 4;
+    dataStore = std::make_shared<CSDataStore>(lfs_, fpool_, options);
+
+    FakeEnv();
+    EXPECT_TRUE(dataStore->Initialize());
+    DataStoreStatus status = dataStore->GetStatus();
+    ASSERT_EQ(2, status.chunkFileCount);
+    CSChunkInfo info;
+    ASSERT_EQ(CSErrorCode::Success, dataStore->GetChunkInfo(1, &info));
+    ASSERT_EQ(1, info.snapSn);
+    EXPECT_CALL(*lfs_, Close(1))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(2))
+        .Times(1);
+    EXPECT_CALL(*lfs_, Close(3))
+        .Times(1);
+}
+
 /**
  * InitializeErrorTest
  * case:data目录不存在，创建目录时失败
@@ -311,6 +311,50 @@ TEST_F(CSFilePool_test, RecycleFileTest) {
     ASSERT_EQ(0, fsptr->Delete(filePoolPath + "4"));
 }
 
+TEST_F(CSFilePool_test, RecycleFilesTest) {
+    std::string filePool = "./cspooltest/filePool.meta";
+    const std::string filePoolPath = FILEPOOL_DIR;
+    FilePoolOptions cfop;
+    cfop.fileSize = 4096;
+    cfop.metaPageSize = 4096;
+    memcpy(cfop.metaPath, filePool.c_str(), filePool.size());
+
+    chunkFilePoolPtr_->Initialize(cfop);
+    ASSERT_EQ(100, chunkFilePoolPtr_->Size());
+
+    char metapage[4096];
+    memset(metapage, '1', 4096);
+    ASSERT_EQ(0, chunkFilePoolPtr_->GetFile("./new1", metapage));
+    ASSERT_EQ(0, chunkFilePoolPtr_->GetFile("./new2", metapage));
+    ASSERT_EQ(98, chunkFilePoolPtr_->Size());
+
+    // file with illegal size is deleted directly
+    int fd = fsptr->Open("./new3", O_RDWR | O_CREAT);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(0, fsptr->Close(fd));
+
+    uint32_t recycled = 0;
+    ASSERT_EQ(0, chunkFilePoolPtr_->RecycleFiles(
+        {"./new1", "./new2", "./new3"}, &recycled));
+    ASSERT_EQ(3, recycled);
+    ASSERT_EQ(100, chunkFilePoolPtr_->Size());
+    FilePoolState_t currentStat = chunkFilePoolPtr_->GetState();
+    ASSERT_EQ(50, currentStat.dirtyChunksLeft);
+    ASSERT_EQ(50, currentStat.cleanChunksLeft);
+
+    ASSERT_FALSE(fsptr->FileExists("./new1"));
+    ASSERT_FALSE(fsptr->FileExists("./new2"));
+    ASSERT_FALSE(fsptr->FileExists("./new3"));
+    ASSERT_TRUE(fsptr->FileExists(filePoolPath + "4"));
+    ASSERT_TRUE(fsptr->FileExists(filePoolPath + "5"));
+    ASSERT_EQ(0, fsptr->Delete(filePoolPath + "4"));
+    ASSERT_EQ(0, fsptr->Delete(filePoolPath + "5"));
+
+    // file not exist
+    ASSERT_EQ(-1, chunkFilePoolPtr_->RecycleFiles({"./new4"}, &recycled));
+    ASSERT_EQ(0, recycled);
+}
+
 TEST_F(CSFilePool_test, UsePoolConcurrentGetAndRecycle) {
     std::string filePool = "./cspooltest/filePool.meta";
     const std::string filePoolPath = FILEPOOL_DIR;
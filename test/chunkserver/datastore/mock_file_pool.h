@@ -27,6 +27,7 @@
 #include <gmock/gmock.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "src/chunkserver/datastore/file_pool.h"
 
@@ -50,6 +51,18 @@ class MockFilePool : public FilePool {
                 bool needClean = false) override {
         return GetFileImpl(chunkpath, metapage);
     };
+
+    // 批量回收逐个交给RecycleFile，方便按文件设置期望
+    int RecycleFiles(const std::vector<std::string>& chunkpaths,
+                     uint32_t* recycled) override {
+        *recycled = 0;
+        for (const auto& chunkpath : chunkpaths) {
+            if (RecycleFile(chunkpath) == 0) {
+                ++*recycled;
+            }
+        }
+        return *recycled == chunkpaths.size() ? 0 : -1;
+    }
 };
 
 }  // namespace chunkserver
@@ -0,0 +1,466 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "src/chunkserver/flatten_manager.h"
+#include "src/common/bitmap.h"
+#include "src/common/timeutility.h"
+#include "test/chunkserver/datastore/mock_datastore.h"
+#include "test/chunkserver/mock_copyset_node.h"
+#include "test/chunkserver/mock_copyset_node_manager.h"
+#include "test/fs/mock_local_filesystem.h"
+
+namespace curve {
+namespace chunkserver {
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::NotNull;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::SetArrayArgument;
+using ::curve::common::Bitmap;
+using ::curve::common::TimeUtility;
+using ::curve::fs::MockLocalFileSystem;
+
+const uint32_t kPageSize = 4096;
+// 每个chunk 18个页面，最后一个slice不满
+const uint32_t kChunkSize = 18 * kPageSize;
+// 每个recover请求4个页面
+const uint32_t kSliceSize = 4 * kPageSize;
+
+struct RecoverRecord {
+    ChunkID chunkId;
+    uint32_t offset;
+    uint32_t size;
+
+    bool operator<(const RecoverRecord& other) const {
+        return chunkId < other.chunkId ||
+               (chunkId == other.chunkId && offset < other.offset);
+    }
+};
+
+/**
+ * 记录下发的recover请求，并按设置的结果完成请求，不走真实的copyset
+ */
+class FakeFlattenManager : public FlattenManager {
+ public:
+    enum class Result {
+        SUCCESS,
+        FAILURE,
+        // 请求不返回，由测试在结束前完成
+        HANG,
+    };
+
+    FakeFlattenManager() : idleChecks_(0), busyChecks_(0) {}
+
+    ~FakeFlattenManager() {
+        for (auto done : hangs_) {
+            done->Run();
+        }
+    }
+
+    void SetResult(ChunkID chunkId, Result result) {
+        results_[chunkId] = result;
+    }
+
+    // 前n次检查磁盘时返回不空闲
+    void SetBusyChecks(int n) {
+        busyChecks_ = n;
+    }
+
+    int GetIdleChecks() const {
+        return idleChecks_;
+    }
+
+    std::vector<RecoverRecord> GetRecords() const {
+        return records_;
+    }
+
+ protected:
+    bool IsDiskIdle() override {
+        idleChecks_++;
+        if (busyChecks_ > 0) {
+            busyChecks_--;
+            return false;
+        }
+        return true;
+    }
+
+    void ProcessRecover(const CopysetNodePtr& node,
+                        ChunkRequest* request,
+                        ChunkResponse* response,
+                        google::protobuf::Closure* done) override {
+        ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_RECOVER, request->optype());
+        records_.push_back({request->chunkid(),
+                            static_cast<uint32_t>(request->offset()),
+                            request->size()});
+        Result result = Result::SUCCESS;
+        if (results_.count(request->chunkid()) > 0) {
+            result = results_[request->chunkid()];
+        }
+        switch (result) {
+        case Result::SUCCESS:
+            response->set_status(CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+            done->Run();
+            break;
+        case Result::FAILURE:
+            response->set_status(
+                CHUNK_OP_STATUS::CHUNK_OP_STATUS_FAILURE_UNKNOWN);
+            done->Run();
+            break;
+        case Result::HANG:
+            hangs_.push_back(done);
+            break;
+        }
+    }
+
+ private:
+    int idleChecks_;
+    int busyChecks_;
+    std::map<ChunkID, Result> results_;
+    std::vector<RecoverRecord> records_;
+    std::vector<google::protobuf::Closure*> hangs_;
+};
+
+class FlattenManagerTest : public ::testing::Test {
+ protected:
+    void SetUp() {
+        copysetNodeManager_ = new MockCopysetNodeManager();
+        options_.enable = true;
+        options_.intervalSec = 1;
+        options_.sliceSize = kSliceSize;
+        options_.copysetNodeManager = copysetNodeManager_;
+        options_.cloneManager = &cloneManager_;
+
+        lfs_ = std::make_shared<MockLocalFileSystem>();
+        EXPECT_CALL(*lfs_, Close(_)).WillRepeatedly(Return(0));
+        dataStore_ = std::make_shared<MockDataStore>();
+        leader_ = std::make_shared<MockCopysetNode>();
+        follower_ = std::make_shared<MockCopysetNode>();
+        EXPECT_CALL(*leader_, GetDataStore())
+            .WillRepeatedly(Return(dataStore_));
+        EXPECT_CALL(*follower_, IsLeaderTerm())
+            .WillRepeatedly(Return(false));
+        // 不是leader的copyset不统计也不flatten
+        EXPECT_CALL(*follower_, GetDataStore()).Times(0);
+    }
+
+    void TearDown() {
+        delete copysetNodeManager_;
+    }
+
+    /**
+     * 构造chunk文件，location为空时是普通chunk，
+     * 否则是克隆chunk，bitmap中被设置的页面表示已经拷贝过
+     */
+    CSChunkFilePtr MakeChunk(ChunkID id,
+                             const std::string& location,
+                             const std::vector<uint32_t>& setPages) {
+        ChunkFileMetaPage metaPage;
+        metaPage.version = FORMAT_VERSION;
+        metaPage.sn = 1;
+        metaPage.location = location;
+        if (!location.empty()) {
+            metaPage.bitmap =
+                std::make_shared<Bitmap>(kChunkSize / kPageSize);
+            for (auto page : setPages) {
+                metaPage.bitmap->Set(page);
+            }
+        }
+        char buf[kPageSize] = {0};
+        metaPage.encode(buf);
+
+        int fd = static_cast<int>(id);
+        struct stat fileInfo;
+        fileInfo.st_size = kChunkSize + kPageSize;
+        EXPECT_CALL(*lfs_, Open(_, _)).WillOnce(Return(fd));
+        EXPECT_CALL(*lfs_, Fstat(fd, NotNull()))
+            .WillOnce(DoAll(SetArgPointee<1>(fileInfo), Return(0)));
+        EXPECT_CALL(*lfs_, Read(fd, NotNull(), 0, kPageSize))
+            .WillOnce(DoAll(SetArrayArgument<1>(buf, buf + kPageSize),
+                            Return(kPageSize)));
+
+        ChunkOptions options;
+        options.id = id;
+        options.sn = 1;
+        options.baseDir = "/data";
+        options.location = location;
+        options.chunkSize = kChunkSize;
+        options.pageSize = kPageSize;
+        auto chunk = std::make_shared<CSChunkFile>(lfs_, nullptr, options);
+        EXPECT_EQ(CSErrorCode::Success, chunk->Open(false));
+        return chunk;
+    }
+
+    void SetCopysets(const std::vector<CopysetNodePtr>& nodes) {
+        EXPECT_CALL(*copysetNodeManager_, GetAllCopysetNodes(NotNull()))
+            .WillRepeatedly(SetArgPointee<0>(nodes));
+    }
+
+    void SetChunks(const ChunkMap& chunkMap) {
+        EXPECT_CALL(*dataStore_, GetChunkMap())
+            .WillRepeatedly(Return(chunkMap));
+    }
+
+    // 一个拷贝了部分页面的克隆chunk，剩余9个页面，需要下发3个recover请求
+    ChunkMap PartialCloneChunk() {
+        ChunkMap chunkMap;
+        chunkMap[1] = MakeChunk(1, "/vol1:0@cs",
+                                {0, 1, 2, 3, 5, 12, 13, 14, 15});
+        return chunkMap;
+    }
+
+ protected:
+    FlattenManagerOptions options_;
+    MockCopysetNodeManager* copysetNodeManager_;
+    CloneManager cloneManager_;
+    std::shared_ptr<MockLocalFileSystem> lfs_;
+    std::shared_ptr<MockDataStore> dataStore_;
+    std::shared_ptr<MockCopysetNode> leader_;
+    std::shared_ptr<MockCopysetNode> follower_;
+};
+
+TEST_F(FlattenManagerTest, GetCloneSourceTest) {
+    // curve源
+    ASSERT_EQ("/vol1",
+              FlattenManager::GetCloneSource("/vol1:1073741824@cs"));
+    ASSERT_EQ("/dir/vol-1",
+              FlattenManager::GetCloneSource("/dir/vol-1:0@cs"));
+    // s3源
+    ASSERT_EQ("/vol1", FlattenManager::GetCloneSource("/vol1-3-1@s3"));
+    ASSERT_EQ("/dir/vol-1",
+              FlattenManager::GetCloneSource("/dir/vol-1-16-2@s3"));
+    // 不合法的location
+    ASSERT_EQ("", FlattenManager::GetCloneSource("/vol1-3@s3"));
+    ASSERT_EQ("", FlattenManager::GetCloneSource("-3-1@s3"));
+    ASSERT_EQ("", FlattenManager::GetCloneSource("/vol1@cs"));
+    ASSERT_EQ("", FlattenManager::GetCloneSource("/vol1:0@xx"));
+    ASSERT_EQ("", FlattenManager::GetCloneSource(""));
+}
+
+TEST_F(FlattenManagerTest, InitTest) {
+    FlattenManager manager;
+    options_.sliceSize = 0;
+    ASSERT_NE(0, manager.Init(options_));
+    options_.sliceSize = 1024 * 1024;
+    options_.cloneManager = nullptr;
+    ASSERT_NE(0, manager.Init(options_));
+
+    // 没有开启时不检查参数，也不启动后台线程
+    options_.enable = false;
+    ASSERT_EQ(0, manager.Init(options_));
+    ASSERT_EQ(0, manager.Run());
+    ASSERT_EQ(0, manager.Fini());
+}
+
+TEST_F(FlattenManagerTest, RunTest) {
+    FlattenManager manager;
+    ASSERT_EQ(0, manager.Init(options_));
+    ASSERT_EQ(0, manager.Run());
+    // 重复启动失败
+    ASSERT_NE(0, manager.Run());
+    ::sleep(2);
+    ASSERT_TRUE(manager.GetProgress().empty());
+    ASSERT_EQ(0, manager.Fini());
+    ASSERT_EQ(0, manager.Fini());
+
+    // 停止后可以重新启动
+    ASSERT_EQ(0, manager.Run());
+    ASSERT_EQ(0, manager.Fini());
+}
+
+TEST_F(FlattenManagerTest, FlattenOnceTest) {
+    FlattenManager manager;
+    ASSERT_EQ(0, manager.Init(options_));
+    // 没有copyset时进度为空
+    manager.FlattenOnce();
+    ASSERT_TRUE(manager.GetProgress().empty());
+}
+
+TEST_F(FlattenManagerTest, FlattenCloneChunkTest) {
+    ChunkMap chunkMap = PartialCloneChunk();
+    // 普通chunk不需要flatten
+    chunkMap[2] = MakeChunk(2, "", {});
+    // 已经全部拷贝过的克隆chunk只统计数量
+    std::vector<uint32_t> allPages;
+    for (uint32_t i = 0; i < kChunkSize / kPageSize; ++i) {
+        allPages.push_back(i);
+    }
+    chunkMap[3] = MakeChunk(3, "/vol2-0-1@s3", allPages);
+    // 还没有拷贝过的克隆chunk
+    chunkMap[4] = MakeChunk(4, "/vol1:16777216@cs", {});
+    SetChunks(chunkMap);
+    SetCopysets({follower_, leader_});
+    EXPECT_CALL(*leader_, IsLeaderTerm()).WillRepeatedly(Return(true));
+
+    FakeFlattenManager manager;
+    ASSERT_EQ(0, manager.Init(options_));
+    manager.FlattenOnce();
+
+    auto progress = manager.GetProgress();
+    ASSERT_EQ(2, progress.size());
+    ASSERT_EQ(2, progress["/vol1"].cloneChunkNum);
+    ASSERT_EQ((9 + 18) * kPageSize, progress["/vol1"].remainingBytes);
+    ASSERT_EQ(1, progress["/vol2"].cloneChunkNum);
+    ASSERT_EQ(0, progress["/vol2"].remainingBytes);
+
+    // 按slice对齐下发，跳过已经拷贝过的slice，最后一个slice不满
+    auto records = manager.GetRecords();
+    std::sort(records.begin(), records.end());
+    std::vector<RecoverRecord> expected = {
+        {1, 4 * kPageSize, kSliceSize},
+        {1, 8 * kPageSize, kSliceSize},
+        {1, 16 * kPageSize, 2 * kPageSize},
+        {4, 0, kSliceSize},
+        {4, 4 * kPageSize, kSliceSize},
+        {4, 8 * kPageSize, kSliceSize},
+        {4, 12 * kPageSize, kSliceSize},
+        {4, 16 * kPageSize, 2 * kPageSize},
+    };
+    ASSERT_EQ(expected.size(), records.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i].chunkId, records[i].chunkId);
+        ASSERT_EQ(expected[i].offset, records[i].offset);
+        ASSERT_EQ(expected[i].size, records[i].size);
+    }
+}
+
+TEST_F(FlattenManagerTest, LeaderChangeTest) {
+    SetChunks(PartialCloneChunk());
+    SetCopysets({leader_});
+    // 统计和开始flatten时是leader，下发第一个请求后发生主从切换
+    EXPECT_CALL(*leader_, IsLeaderTerm())
+        .WillOnce(Return(true))
+        .WillOnce(Return(true))
+        .WillOnce(Return(true))
+        .WillRepeatedly(Return(false));
+
+    FakeFlattenManager manager;
+    ASSERT_EQ(0, manager.Init(options_));
+    manager.FlattenOnce();
+    ASSERT_EQ(9 * kPageSize, manager.GetProgress()["/vol1"].remainingBytes);
+    auto records = manager.GetRecords();
+    ASSERT_EQ(1, records.size());
+    ASSERT_EQ(4 * kPageSize, records[0].offset);
+}
+
+TEST_F(FlattenManagerTest, RecoverFailTest) {
+    ChunkMap chunkMap = PartialCloneChunk();
+    chunkMap[4] = MakeChunk(4, "/vol1:16777216@cs", {});
+    SetChunks(chunkMap);
+    SetCopysets({leader_});
+    EXPECT_CALL(*leader_, IsLeaderTerm()).WillRepeatedly(Return(true));
+
+    // 请求失败后跳过这个chunk，其他chunk不受影响
+    FakeFlattenManager manager;
+    manager.SetResult(1, FakeFlattenManager::Result::FAILURE);
+    ASSERT_EQ(0, manager.Init(options_));
+    manager.FlattenOnce();
+    auto records = manager.GetRecords();
+    std::sort(records.begin(), records.end());
+    ASSERT_EQ(6, records.size());
+    ASSERT_EQ(1, records[0].chunkId);
+    ASSERT_EQ(4 * kPageSize, records[0].offset);
+    for (size_t i = 1; i < records.size(); ++i) {
+        ASSERT_EQ(4, records[i].chunkId);
+    }
+}
+
+TEST_F(FlattenManagerTest, RecoverTimeoutTest) {
+    ChunkMap chunkMap = PartialCloneChunk();
+    chunkMap[4] = MakeChunk(4, "/vol1:16777216@cs", {});
+    SetChunks(chunkMap);
+    SetCopysets({leader_});
+    EXPECT_CALL(*leader_, IsLeaderTerm()).WillRepeatedly(Return(true));
+
+    // 请求超时后不再等待，跳过这个chunk，请求在manager析构时才返回
+    options_.requestTimeoutMs = 100;
+    FakeFlattenManager manager;
+    manager.SetResult(4, FakeFlattenManager::Result::HANG);
+    ASSERT_EQ(0, manager.Init(options_));
+    uint64_t startMs = TimeUtility::GetTimeofDayMs();
+    manager.FlattenOnce();
+    ASSERT_GE(TimeUtility::GetTimeofDayMs() - startMs, 100);
+    auto records = manager.GetRecords();
+    std::sort(records.begin(), records.end());
+    ASSERT_EQ(4, records.size());
+    for (size_t i = 0; i < 3; ++i) {
+        ASSERT_EQ(1, records[i].chunkId);
+    }
+    ASSERT_EQ(4, records[3].chunkId);
+    ASSERT_EQ(0, records[3].offset);
+}
+
+TEST_F(FlattenManagerTest, ThrottleTest) {
+    SetChunks(PartialCloneChunk());
+    SetCopysets({leader_});
+    EXPECT_CALL(*leader_, IsLeaderTerm()).WillRepeatedly(Return(true));
+
+    // 磁盘不空闲时等待，每100ms检查一次
+    {
+        FakeFlattenManager manager;
+        manager.SetBusyChecks(3);
+        ASSERT_EQ(0, manager.Init(options_));
+        uint64_t startMs = TimeUtility::GetTimeofDayMs();
+        manager.FlattenOnce();
+        ASSERT_GE(TimeUtility::GetTimeofDayMs() - startMs, 300);
+        ASSERT_EQ(3 + 3, manager.GetIdleChecks());
+        ASSERT_EQ(3, manager.GetRecords().size());
+    }
+
+    // 每秒只能拷贝一个slice，三个请求至少需要等待两秒
+    {
+        options_.bandwidthBytes = kSliceSize;
+        FakeFlattenManager manager;
+        ASSERT_EQ(0, manager.Init(options_));
+        uint64_t startMs = TimeUtility::GetTimeofDayMs();
+        manager.FlattenOnce();
+        ASSERT_GE(TimeUtility::GetTimeofDayMs() - startMs, 1900);
+        ASSERT_EQ(3, manager.GetRecords().size());
+    }
+
+    // 模块停止后不再下发请求，但仍然统计进度
+    {
+        options_.bandwidthBytes = 0;
+        FakeFlattenManager manager;
+        ASSERT_EQ(0, manager.Init(options_));
+        ASSERT_EQ(0, manager.Run());
+        ASSERT_EQ(0, manager.Fini());
+        manager.FlattenOnce();
+        ASSERT_EQ(9 * kPageSize,
+                  manager.GetProgress()["/vol1"].remainingBytes);
+        ASSERT_TRUE(manager.GetRecords().empty());
+    }
+}
+
+}  // namespace chunkserver
+}  // namespace curve
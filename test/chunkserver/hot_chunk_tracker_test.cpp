@@ -0,0 +1,158 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/chunkserver/hot_chunk_tracker.h"
+
+namespace curve {
+namespace chunkserver {
+
+class HotChunkTrackerTest : public testing::Test {
+ protected:
+    void SetUp() {
+        options_.sketchWidth = 1024;
+        options_.sketchDepth = 4;
+        options_.topK = 4;
+        options_.decayIntervalSec = 0;
+    }
+
+    void Access(ChunkID chunkId, int times, bool isRead = true) {
+        for (int i = 0; i < times; ++i) {
+            tracker_.Record(chunkId / 100, 1, chunkId % 10, chunkId, isRead);
+        }
+    }
+
+    HotChunkTrackerOptions options_;
+    HotChunkTracker tracker_;
+};
+
+TEST_F(HotChunkTrackerTest, disabled) {
+    options_.enable = false;
+    ASSERT_EQ(0, tracker_.Init(options_));
+    Access(1, 10);
+    ASSERT_TRUE(tracker_.GetHotChunks().empty());
+    ASSERT_EQ(0, tracker_.Estimate(1, 1));
+}
+
+TEST_F(HotChunkTrackerTest, invalid_option) {
+    options_.sketchWidth = 0;
+    ASSERT_NE(0, tracker_.Init(options_));
+    options_.sketchWidth = 1024;
+    options_.topK = 0;
+    ASSERT_NE(0, tracker_.Init(options_));
+}
+
+TEST_F(HotChunkTrackerTest, top_k) {
+    ASSERT_EQ(0, tracker_.Init(options_));
+
+    // 100个冷chunk各访问一次，4个热chunk访问次数各不相同
+    for (ChunkID id = 1000; id < 1100; ++id) {
+        Access(id, 1);
+    }
+    Access(1, 50);
+    Access(2, 40, false);
+    Access(3, 30);
+    Access(4, 20);
+
+    auto hotChunks = tracker_.GetHotChunks();
+    ASSERT_EQ(4, hotChunks.size());
+    ASSERT_EQ(1, hotChunks[0].chunkId);
+    ASSERT_EQ(2, hotChunks[1].chunkId);
+    ASSERT_EQ(3, hotChunks[2].chunkId);
+    ASSERT_EQ(4, hotChunks[3].chunkId);
+
+    // count-min sketch只会高估
+    ASSERT_GE(hotChunks[0].accessCount, 50);
+    ASSERT_GE(tracker_.Estimate(1, 1), 50);
+    ASSERT_EQ(0, hotChunks[0].fileId);
+    ASSERT_EQ(1, hotChunks[0].logicPoolId);
+    ASSERT_EQ(1, hotChunks[0].copysetId);
+    // 进入top-K之后才开始统计读写次数
+    ASSERT_EQ(0, hotChunks[1].readCount);
+    ASSERT_GE(hotChunks[1].writeCount, 39);
+    ASSERT_LE(hotChunks[1].writeCount, 40);
+
+    // 新的热点chunk替换掉访问次数最少的chunk
+    Access(5, 60);
+    hotChunks = tracker_.GetHotChunks();
+    ASSERT_EQ(4, hotChunks.size());
+    ASSERT_EQ(5, hotChunks[0].chunkId);
+    ASSERT_EQ(3, hotChunks[3].chunkId);
+}
+
+TEST_F(HotChunkTrackerTest, merge_shards) {
+    ASSERT_EQ(0, tracker_.Init(options_));
+
+    // chunk分散在各个分片中，被记录的chunk多于topK，合并后只取最热的topK个
+    for (ChunkID id = 1; id <= 40; ++id) {
+        Access(id, id * 2);
+    }
+    auto hotChunks = tracker_.GetHotChunks();
+    ASSERT_EQ(4, hotChunks.size());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_EQ(40 - i, hotChunks[i].chunkId);
+    }
+}
+
+TEST_F(HotChunkTrackerTest, decay) {
+    ASSERT_EQ(0, tracker_.Init(options_));
+    Access(1, 40);
+    Access(2, 1);
+    ASSERT_EQ(2, tracker_.GetHotChunks().size());
+
+    tracker_.Decay();
+    auto hotChunks = tracker_.GetHotChunks();
+    ASSERT_EQ(1, hotChunks.size());
+    ASSERT_EQ(1, hotChunks[0].chunkId);
+    ASSERT_EQ(20, hotChunks[0].accessCount);
+    ASSERT_EQ(20, hotChunks[0].readCount);
+    ASSERT_EQ(20, tracker_.Estimate(1, 1));
+}
+
+TEST_F(HotChunkTrackerTest, concurrent_record) {
+    ASSERT_EQ(0, tracker_.Init(options_));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([this]() {
+            Access(1, 1000);
+            Access(2, 500, false);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    ASSERT_EQ(4000, tracker_.Estimate(1, 1));
+    auto hotChunks = tracker_.GetHotChunks();
+    ASSERT_EQ(2, hotChunks.size());
+    ASSERT_EQ(1, hotChunks[0].chunkId);
+    ASSERT_EQ(4000, hotChunks[0].readCount);
+    ASSERT_EQ(2000, hotChunks[1].writeCount);
+}
+
+}  // namespace chunkserver
+}  // namespace curve
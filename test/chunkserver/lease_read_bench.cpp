@@ -0,0 +1,295 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+/**
+ * 测试leader切换过程中读请求的延时，需要先启动3个chunkserver，
+ * 分别在copyset.enable_lease_read=true/false时运行，对比两种情况下的p99:
+ *   ./lease-read-bench --confs=127.0.0.1:8200:0,127.0.0.1:8201:0,...
+ * 读请求不携带applied index，lease无效时会走raft一致性协议read
+ */
+
+#include <glog/logging.h>
+#include <gflags/gflags.h>
+#include <brpc/channel.h>
+#include <brpc/controller.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/chunkserver/cli.h"
+#include "src/common/concurrent/concurrent.h"
+#include "src/common/timeutility.h"
+#include "proto/chunk.pb.h"
+#include "proto/copyset.pb.h"
+
+DEFINE_string(confs,
+              "127.0.0.1:8200:0,127.0.0.1:8201:0,127.0.0.1:8202:0",
+              "Configuration of the raft group");
+DEFINE_int32(request_size, 4096, "Size of each request");
+DEFINE_int32(thread_num, 8, "Number of threads sending read requests");
+DEFINE_int32(run_time_s, 60, "Time of the test");
+DEFINE_int32(transfer_interval_s, 10, "Interval between leader transfers");
+DEFINE_int32(timeout_ms, 1000, "Timeout for each request");
+DEFINE_int32(election_timeout_ms, 1000, "election timeout ms");
+
+using curve::chunkserver::ChunkRequest;
+using curve::chunkserver::ChunkResponse;
+using curve::chunkserver::ChunkService_Stub;
+using curve::chunkserver::CopysetRequest;
+using curve::chunkserver::CopysetResponse;
+using curve::chunkserver::CopysetService_Stub;
+using curve::chunkserver::PeerId;
+using curve::chunkserver::LogicPoolID;
+using curve::chunkserver::CopysetID;
+using curve::chunkserver::Configuration;
+using curve::chunkserver::CHUNK_OP_TYPE;
+using curve::chunkserver::CHUNK_OP_STATUS;
+using curve::chunkserver::COPYSET_OP_STATUS;
+using curve::common::LockGuard;
+using curve::common::Mutex;
+using curve::common::TimeUtility;
+
+namespace {
+
+const LogicPoolID kLogicPoolId = 1;
+const CopysetID kCopysetId = 100001;
+const uint64_t kChunkId = 1;
+
+Configuration conf;
+
+Mutex leaderMtx;
+PeerId leader;
+
+std::atomic<bool> stop(false);
+// 最近一次leader切换开始的时间，切换开始后election_timeout_ms内发起的
+// 读请求计入切换期间的延时
+std::atomic<uint64_t> transferStartUs(0);
+
+PeerId GetCachedLeader() {
+    LockGuard lk(leaderMtx);
+    return leader;
+}
+
+void RefreshLeader() {
+    PeerId newLeader;
+    butil::Status status = curve::chunkserver::GetLeader(
+        kLogicPoolId, kCopysetId, conf, &newLeader);
+    if (status.ok()) {
+        LockGuard lk(leaderMtx);
+        leader = newLeader;
+    }
+}
+
+void CreateCopyset() {
+    std::vector<PeerId> peers;
+    conf.list_peers(&peers);
+    CopysetRequest request;
+    request.set_logicpoolid(kLogicPoolId);
+    request.set_copysetid(kCopysetId);
+    for (const auto& peer : peers) {
+        request.add_peerid(peer.to_string());
+    }
+
+    for (const auto& peer : peers) {
+        brpc::Channel channel;
+        if (0 != channel.Init(peer.addr, NULL)) {
+            LOG(FATAL) << "channel init failed: " << strerror(errno);
+        }
+        brpc::Controller cntl;
+        cntl.set_timeout_ms(FLAGS_timeout_ms);
+        CopysetResponse response;
+        CopysetService_Stub stub(&channel);
+        stub.CreateCopysetNode(&cntl, &request, &response, nullptr);
+        if (cntl.Failed()) {
+            LOG(FATAL) << "create copyset failed: " << cntl.ErrorText();
+        }
+        COPYSET_OP_STATUS st = response.status();
+        if (st != COPYSET_OP_STATUS::COPYSET_OP_STATUS_SUCCESS &&
+            st != COPYSET_OP_STATUS::COPYSET_OP_STATUS_EXIST) {
+            LOG(FATAL) << "create copyset failed: " << st;
+        }
+    }
+}
+
+void WriteChunk() {
+    brpc::Channel channel;
+    PeerId peer = GetCachedLeader();
+    if (0 != channel.Init(peer.addr, NULL)) {
+        LOG(FATAL) << "channel init failed: " << strerror(errno);
+    }
+    ChunkService_Stub stub(&channel);
+    brpc::Controller cntl;
+    cntl.set_timeout_ms(FLAGS_timeout_ms);
+    ChunkRequest request;
+    ChunkResponse response;
+    request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_WRITE);
+    request.set_logicpoolid(kLogicPoolId);
+    request.set_copysetid(kCopysetId);
+    request.set_chunkid(kChunkId);
+    request.set_sn(1);
+    request.set_offset(0);
+    request.set_size(FLAGS_request_size);
+    cntl.request_attachment().resize(FLAGS_request_size, 'a');
+    stub.WriteChunk(&cntl, &request, &response, nullptr);
+    if (cntl.Failed() ||
+        response.status() != CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+        LOG(FATAL) << "write chunk failed: " << cntl.ErrorText()
+                   << ", status: " << response.status();
+    }
+}
+
+/**
+ * 读一次chunk，遇到重定向或者rpc失败时刷新leader后重试，直到成功
+ */
+void ReadChunk() {
+    while (!stop.load()) {
+        PeerId peer = GetCachedLeader();
+        brpc::Channel channel;
+        if (0 != channel.Init(peer.addr, NULL)) {
+            RefreshLeader();
+            continue;
+        }
+        ChunkService_Stub stub(&channel);
+        brpc::Controller cntl;
+        cntl.set_timeout_ms(FLAGS_timeout_ms);
+        ChunkRequest request;
+        ChunkResponse response;
+        request.set_optype(CHUNK_OP_TYPE::CHUNK_OP_READ);
+        request.set_logicpoolid(kLogicPoolId);
+        request.set_copysetid(kCopysetId);
+        request.set_chunkid(kChunkId);
+        request.set_sn(1);
+        request.set_offset(0);
+        request.set_size(FLAGS_request_size);
+        stub.ReadChunk(&cntl, &request, &response, nullptr);
+        if (!cntl.Failed() &&
+            response.status() == CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS) {
+            return;
+        }
+        RefreshLeader();
+    }
+}
+
+void ReadLoop(std::vector<uint64_t>* all, std::vector<uint64_t>* transfer) {
+    uint64_t windowUs = FLAGS_election_timeout_ms * 1000ULL;
+    while (!stop.load()) {
+        uint64_t startUs = TimeUtility::GetTimeofDayUs();
+        ReadChunk();
+        uint64_t latencyUs = TimeUtility::GetTimeofDayUs() - startUs;
+        all->push_back(latencyUs);
+        uint64_t transferUs = transferStartUs.load();
+        if (transferUs != 0 && startUs >= transferUs &&
+            startUs < transferUs + windowUs) {
+            transfer->push_back(latencyUs);
+        }
+    }
+}
+
+void TransferLeader() {
+    std::vector<PeerId> peers;
+    conf.list_peers(&peers);
+    PeerId current = GetCachedLeader();
+    auto it = std::find(peers.begin(), peers.end(), current);
+    PeerId target = peers[0];
+    if (it != peers.end()) {
+        target = peers[(it - peers.begin() + 1) % peers.size()];
+    }
+
+    transferStartUs.store(TimeUtility::GetTimeofDayUs());
+    braft::cli::CliOptions options;
+    options.timeout_ms = FLAGS_timeout_ms;
+    butil::Status status = curve::chunkserver::TransferLeader(
+        kLogicPoolId, kCopysetId, conf, target, options);
+    LOG_IF(WARNING, !status.ok()) << "transfer leader to " << target
+                                  << " failed: " << status.error_str();
+}
+
+void PrintLatency(const char* name, std::vector<uint64_t>* latencies) {
+    if (latencies->empty()) {
+        LOG(INFO) << name << ": no request";
+        return;
+    }
+    std::sort(latencies->begin(), latencies->end());
+    auto percentile = [latencies](double ratio) {
+        size_t index = static_cast<size_t>(latencies->size() * ratio);
+        return (*latencies)[std::min(index, latencies->size() - 1)];
+    };
+    LOG(INFO) << name << ": count " << latencies->size()
+              << ", p50 " << percentile(0.5) << "us"
+              << ", p99 " << percentile(0.99) << "us"
+              << ", p999 " << percentile(0.999) << "us"
+              << ", max " << latencies->back() << "us";
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+    if (0 != conf.parse_from(FLAGS_confs)) {
+        LOG(FATAL) << "conf parse failed: " << FLAGS_confs;
+    }
+
+    CreateCopyset();
+    {
+        LockGuard lk(leaderMtx);
+        butil::Status status = curve::chunkserver::WaitLeader(
+            kLogicPoolId, kCopysetId, conf, &leader,
+            FLAGS_election_timeout_ms);
+        if (!status.ok()) {
+            LOG(FATAL) << "wait leader failed: " << status.error_str();
+        }
+    }
+    WriteChunk();
+
+    std::vector<std::vector<uint64_t>> all(FLAGS_thread_num);
+    std::vector<std::vector<uint64_t>> transfer(FLAGS_thread_num);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < FLAGS_thread_num; ++i) {
+        threads.emplace_back(ReadLoop, &all[i], &transfer[i]);
+    }
+
+    uint64_t endUs = TimeUtility::GetTimeofDayUs() +
+                     FLAGS_run_time_s * 1000000ULL;
+    while (TimeUtility::GetTimeofDayUs() < endUs) {
+        ::sleep(FLAGS_transfer_interval_s);
+        TransferLeader();
+    }
+    stop.store(true);
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    std::vector<uint64_t> allLatency;
+    std::vector<uint64_t> transferLatency;
+    for (int i = 0; i < FLAGS_thread_num; ++i) {
+        allLatency.insert(allLatency.end(), all[i].begin(), all[i].end());
+        transferLatency.insert(transferLatency.end(),
+                               transfer[i].begin(), transfer[i].end());
+    }
+    PrintLatency("all reads", &allLatency);
+    PrintLatency("reads during leader transfer", &transferLatency);
+    return 0;
+}
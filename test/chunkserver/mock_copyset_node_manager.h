@@ -37,6 +37,7 @@ class MockCopysetNodeManager : public CopysetNodeManager {
     MOCK_CONST_METHOD0(GetCopysetNodeOptions, const CopysetNodeOptions&());
     MOCK_CONST_METHOD2(GetCopysetNode, CopysetNodePtr(const LogicPoolID&,
                        const CopysetID&));
+    MOCK_CONST_METHOD1(GetAllCopysetNodes, void(std::vector<CopysetNodePtr>*));
 };
 }  // namespace chunkserver
 }  // namespace curve
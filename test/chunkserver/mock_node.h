@@ -67,6 +67,7 @@ class MockNode : public RaftNode {
     MOCK_METHOD2(read_committed_user_log, butil::Status(const int64_t,
                                                         UserLog*));
     MOCK_METHOD1(get_status, void(NodeStatus*));
+    MOCK_METHOD1(get_leader_lease_status, void(braft::LeaderLeaseStatus*));
     MOCK_METHOD0(enter_readonly_mode, void(void));
     MOCK_METHOD0(leave_readonly_mode, void(void));
     MOCK_METHOD0(readonly, bool());
@@ -21,6 +21,14 @@
  *          2018/08/30  Wenyu Zhou   Initial version
  */
 
+/*
+ * 在多个copyset上并发写，可以用来对比复制相关参数的效果，例如在chunkserver
+ * 分别配置copyset.max_parallel_append_entries_rpc_num=1/4时运行:
+ *   ./multi-copyset-io-test --copyset_num=256 --io_mode=async --iodepth=64
+ *     --raftconf=127.0.0.1:8200:0,127.0.0.1:8201:0,127.0.0.1:8202:0
+ * p99延时统计的是最近一个bvar窗口(默认10s)内的请求
+ */
+
 #include <sched.h>
 #include <gflags/gflags.h>
 #include <bthread/bthread.h>
@@ -193,6 +201,7 @@ void update_stats(ThreadInfo *tinfo, IoContext *ioCxt) {
     tinfo->io_time = time_diff(tinfo->start_time, now);
     tinfo->io_count++;
     tinfo->latency_all += ioCxt->cntl->latency_us();
+    g_latency_recorder << ioCxt->cntl->latency_us();
 }
 
 void destroy_io_context(IoContext *ioCxt) {
@@ -811,6 +820,10 @@ int main(int argc, char *argv[]) {
                   / total_info.io_time << ", "
               << "avarage latency(us): "
               << total_info.latency_all / total_info.io_count << ", "
+              << "p99 latency(us): "
+              << g_latency_recorder.latency_percentile(0.99) << ", "
+              << "p999 latency(us): "
+              << g_latency_recorder.latency_percentile(0.999) << ", "
               << "error count: " << total_info.errors;
 
     LOG_IF(INFO, FLAGS_verbose)
@@ -0,0 +1,371 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <bthread/countdown_event.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <vector>
+
+#include "src/chunkserver/qos_scheduler.h"
+
+namespace curve {
+namespace chunkserver {
+
+using curve::common::LockGuard;
+
+class QosSchedulerTest : public testing::Test {
+ protected:
+    void SetUp() {
+        options_.enable = true;
+        options_.maxOutstanding = 1;
+        options_.costUnitBytes = 4096;
+    }
+
+    void TearDown() {
+        scheduler_.Fini();
+    }
+
+    // 占住调度线程，直到Release，用于让后面提交的请求都在队列中排队
+    void Block() {
+        scheduler_.Submit(IOClass::CLONE, 0, 0, [this](bool) {
+            blocked_.signal();
+            gate_.wait();
+        });
+        blocked_.wait();
+    }
+
+    void Release() {
+        gate_.signal();
+        scheduler_.OnComplete(IOClass::CLONE, 0);
+    }
+
+    // 提交一个记录下发顺序的请求，下发后立即完成
+    void SubmitRecord(IOClass cls, uint64_t volume, int id) {
+        scheduler_.Submit(cls, volume, 4096, [this, cls, id](bool) {
+            {
+                LockGuard lk(mtx_);
+                order_.push_back(id);
+            }
+            scheduler_.OnComplete(cls, 0);
+        });
+    }
+
+    void WaitDispatched(size_t count) {
+        for (int i = 0; i < 500; ++i) {
+            {
+                LockGuard lk(mtx_);
+                if (order_.size() >= count) {
+                    return;
+                }
+            }
+            ::usleep(10 * 1000);
+        }
+    }
+
+    std::vector<int> GetOrder() {
+        LockGuard lk(mtx_);
+        return order_;
+    }
+
+    QosSchedulerOptions options_;
+    QosScheduler scheduler_;
+    bthread::CountdownEvent blocked_{1};
+    bthread::CountdownEvent gate_{1};
+    curve::common::Mutex mtx_;
+    std::vector<int> order_;
+};
+
+TEST_F(QosSchedulerTest, disabled) {
+    options_.enable = false;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+    ASSERT_FALSE(scheduler_.Enabled());
+
+    // 没有开启时请求直接下发
+    bool done = false;
+    scheduler_.Submit(IOClass::CLIENT, 1, 4096, [&done](bool scheduled) {
+        done = !scheduled;
+    });
+    ASSERT_TRUE(done);
+    scheduler_.OnComplete(IOClass::CLIENT, 100);
+    ASSERT_EQ(0, scheduler_.GetOutstanding());
+}
+
+TEST_F(QosSchedulerTest, invalid_option) {
+    options_.maxOutstanding = 0;
+    ASSERT_NE(0, scheduler_.Init(options_));
+}
+
+TEST_F(QosSchedulerTest, max_outstanding) {
+    options_.maxOutstanding = 2;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+    ASSERT_TRUE(scheduler_.Enabled());
+
+    std::atomic<int> dispatched(0);
+    for (int i = 0; i < 4; ++i) {
+        scheduler_.Submit(IOClass::CLIENT, 1, 4096,
+                          [&dispatched](bool) { dispatched++; });
+    }
+    ::usleep(100 * 1000);
+    ASSERT_EQ(2, dispatched.load());
+    ASSERT_EQ(2, scheduler_.GetOutstanding());
+
+    // 完成一个请求之后才会下发下一个
+    scheduler_.OnComplete(IOClass::CLIENT, 100);
+    ::usleep(100 * 1000);
+    ASSERT_EQ(3, dispatched.load());
+    scheduler_.OnComplete(IOClass::CLIENT, 100);
+    scheduler_.OnComplete(IOClass::CLIENT, 100);
+    ::usleep(100 * 1000);
+    ASSERT_EQ(4, dispatched.load());
+}
+
+TEST_F(QosSchedulerTest, weight) {
+    options_.volumeSpec.weight = 1;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    QosSpec classSpecs[kIOClassNum];
+    QosSpec volumeSpec;
+    volumeSpec.weight = 2;
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // 卷1和卷2的权重都是2，SCAN的权重是1
+    classSpecs[static_cast<int>(IOClass::SCAN)].weight = 1;
+    scheduler_.UpdateSpecs(classSpecs, volumeSpec);
+
+    Block();
+    const int count = 30;
+    for (int i = 0; i < count; ++i) {
+        SubmitRecord(IOClass::CLIENT, 1, 1);
+        SubmitRecord(IOClass::CLIENT, 2, 2);
+        SubmitRecord(IOClass::SCAN, 0, 3);
+    }
+    Release();
+    WaitDispatched(3 * count);
+
+    auto order = GetOrder();
+    ASSERT_EQ(3 * count, static_cast<int>(order.size()));
+    int dispatched[4] = {0};
+    for (int i = 0; i < count; ++i) {
+        dispatched[order[i]]++;
+    }
+    // 前30个请求按2:2:1分配
+    ASSERT_NEAR(12, dispatched[1], 2);
+    ASSERT_NEAR(12, dispatched[2], 2);
+    ASSERT_NEAR(6, dispatched[3], 2);
+}
+
+TEST_F(QosSchedulerTest, limit) {
+    options_.maxOutstanding = 64;
+    options_.volumeSpec.limit = 50;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    const int count = 20;
+    for (int i = 0; i < count; ++i) {
+        SubmitRecord(IOClass::CLIENT, 1, 1);
+        SubmitRecord(IOClass::CLIENT, 2, 2);
+    }
+    // 每个卷各自限制，每20ms下发一个请求
+    ::usleep(200 * 1000);
+    auto order = GetOrder();
+    int dispatched[3] = {0};
+    for (auto id : order) {
+        dispatched[id]++;
+    }
+    ASSERT_GT(dispatched[1], 5);
+    ASSERT_LT(dispatched[1], 15);
+    ASSERT_GT(dispatched[2], 5);
+    ASSERT_LT(dispatched[2], 15);
+
+    WaitDispatched(2 * count);
+    ASSERT_EQ(2 * count, static_cast<int>(GetOrder().size()));
+}
+
+TEST_F(QosSchedulerTest, reservation) {
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+    QosSpec classSpecs[kIOClassNum];
+    QosSpec volumeSpec;
+    volumeSpec.weight = 1000;
+    classSpecs[static_cast<int>(IOClass::SCAN)].weight = 1;
+    classSpecs[static_cast<int>(IOClass::SCAN)].reservation = 100;
+    scheduler_.UpdateSpecs(classSpecs, volumeSpec);
+
+    Block();
+    const int count = 200;
+    for (int i = 0; i < count; ++i) {
+        scheduler_.Submit(IOClass::CLIENT, 1, 4096, [this](bool) {
+            {
+                LockGuard lk(mtx_);
+                order_.push_back(1);
+            }
+            ::usleep(1000);
+            scheduler_.OnComplete(IOClass::CLIENT, 1000);
+        });
+    }
+    for (int i = 0; i < 10; ++i) {
+        SubmitRecord(IOClass::SCAN, 0, 2);
+    }
+    Release();
+    WaitDispatched(count + 10);
+
+    // 按权重几乎轮不到scan，但是保留的能力是每10ms一个请求
+    auto order = GetOrder();
+    int scanDispatched = 0;
+    for (int i = 0; i < 100; ++i) {
+        if (order[i] == 2) {
+            scanDispatched++;
+        }
+    }
+    ASSERT_GE(scanDispatched, 3);
+}
+
+TEST_F(QosSchedulerTest, client_class_limit) {
+    options_.maxOutstanding = 64;
+    options_.classSpecs[static_cast<int>(IOClass::CLIENT)].limit = 50;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    const int count = 10;
+    for (int i = 0; i < count; ++i) {
+        SubmitRecord(IOClass::CLIENT, 1, 1);
+        SubmitRecord(IOClass::CLIENT, 2, 2);
+    }
+    // 卷不限制，但是所有卷加起来每20ms下发一个请求
+    ::usleep(200 * 1000);
+    int dispatched = GetOrder().size();
+    ASSERT_GT(dispatched, 5);
+    ASSERT_LT(dispatched, 15);
+
+    WaitDispatched(2 * count);
+    ASSERT_EQ(2 * count, static_cast<int>(GetOrder().size()));
+}
+
+TEST_F(QosSchedulerTest, client_class_reservation) {
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+    QosSpec classSpecs[kIOClassNum];
+    QosSpec volumeSpec;
+    volumeSpec.weight = 1;
+    classSpecs[static_cast<int>(IOClass::SCAN)].weight = 1000;
+    classSpecs[static_cast<int>(IOClass::CLIENT)].reservation = 100;
+    scheduler_.UpdateSpecs(classSpecs, volumeSpec);
+
+    Block();
+    const int count = 200;
+    for (int i = 0; i < count; ++i) {
+        scheduler_.Submit(IOClass::SCAN, 0, 4096, [this](bool) {
+            {
+                LockGuard lk(mtx_);
+                order_.push_back(1);
+            }
+            ::usleep(1000);
+            scheduler_.OnComplete(IOClass::SCAN, 1000);
+        });
+    }
+    for (int i = 0; i < 5; ++i) {
+        SubmitRecord(IOClass::CLIENT, 1, 2);
+        SubmitRecord(IOClass::CLIENT, 2, 3);
+    }
+    Release();
+    WaitDispatched(count + 10);
+
+    // 按权重几乎轮不到客户端，但是所有卷共享每10ms一个请求的保留能力
+    auto order = GetOrder();
+    int clientDispatched[4] = {0};
+    for (int i = 0; i < 100; ++i) {
+        clientDispatched[order[i]]++;
+    }
+    ASSERT_GE(clientDispatched[2] + clientDispatched[3], 3);
+    ASSERT_GE(clientDispatched[2], 1);
+    ASSERT_GE(clientDispatched[3], 1);
+}
+
+TEST_F(QosSchedulerTest, fini_dispatch_remains) {
+    options_.volumeSpec.limit = 1;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    std::atomic<int> dispatched(0);
+    for (int i = 0; i < 5; ++i) {
+        scheduler_.Submit(IOClass::CLIENT, 1, 4096,
+                          [&dispatched](bool) { dispatched++; });
+    }
+    ASSERT_EQ(0, scheduler_.Fini());
+    // 已经下发的请求在bthread中执行，可能稍晚完成
+    for (int i = 0; i < 100 && dispatched.load() < 5; ++i) {
+        ::usleep(10 * 1000);
+    }
+    ASSERT_EQ(5, dispatched.load());
+    ASSERT_FALSE(scheduler_.Enabled());
+
+    // 停止后提交的请求直接执行，不计入outstanding
+    bool scheduled = true;
+    scheduler_.Submit(IOClass::CLIENT, 1, 4096,
+                      [&scheduled](bool s) { scheduled = s; });
+    ASSERT_FALSE(scheduled);
+    ASSERT_EQ(0, scheduler_.GetOutstanding());
+}
+
+TEST_F(QosSchedulerTest, task_run_out_of_dispatcher) {
+    options_.maxOutstanding = 2;
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    // 第一个请求阻塞不影响第二个请求的下发
+    Block();
+    bthread::CountdownEvent event(1);
+    bool scheduled = false;
+    scheduler_.Submit(IOClass::CLIENT, 1, 4096,
+                      [&event, &scheduled](bool s) {
+        scheduled = s;
+        event.signal();
+    });
+    ASSERT_EQ(0, event.timed_wait(butil::milliseconds_from_now(1000)));
+    ASSERT_TRUE(scheduled);
+    ASSERT_EQ(2, scheduler_.GetOutstanding());
+    scheduler_.OnComplete(IOClass::CLIENT, 0);
+    Release();
+    ASSERT_EQ(0, scheduler_.GetOutstanding());
+}
+
+TEST_F(QosSchedulerTest, snapshot_read_hook) {
+    ASSERT_EQ(0, scheduler_.Init(options_));
+    ASSERT_EQ(0, scheduler_.Run());
+
+    QosSnapshotReadHook hook(&scheduler_);
+    ASSERT_TRUE(hook.BeforeRead(1024 * 1024));
+    ASSERT_EQ(1, scheduler_.GetOutstanding());
+    hook.AfterRead(1000);
+    ASSERT_EQ(0, scheduler_.GetOutstanding());
+    ASSERT_EQ(1, scheduler_.GetMetric(IOClass::RECOVERY)->latency.count());
+
+    // 调度器停止后不需要AfterRead
+    ASSERT_EQ(0, scheduler_.Fini());
+    ASSERT_FALSE(hook.BeforeRead(1024 * 1024));
+}
+
+}  // namespace chunkserver
+}  // namespace curve
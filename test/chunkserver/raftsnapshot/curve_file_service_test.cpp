@@ -24,8 +24,10 @@
 #include <glog/logging.h>
 #include <brpc/controller.h>
 #include <brpc/server.h>
+#include <bthread/bthread.h>
 #include "src/chunkserver/raftsnapshot/curve_file_service.h"
 #include "src/chunkserver/raftsnapshot/curve_filesystem_adaptor.h"
+#include "src/chunkserver/raftsnapshot/curve_snapshot_checksum.h"
 #include "test/chunkserver/raftsnapshot/mock_file_reader.h"
 #include "test/chunkserver/raftsnapshot/mock_snapshot_attachment.h"
 
@@ -206,6 +208,137 @@ TEST_F(CurveFileServiceTest, snapshot_attachment_not_set) {
     kCurveFileService.remove_reader(reader_id);
 }
 
+TEST_F(CurveFileServiceTest, success_checksum_file) {
+    int64_t reader_id;
+    ASSERT_EQ(0, kCurveFileService.add_reader(reader_, &reader_id));
+    std::string path = "/test";
+    EXPECT_CALL(*reader_, path())
+        .WillRepeatedly(ReturnRef(path));
+    butil::IOBuf part1;
+    part1.append("hello ");
+    butil::IOBuf part2;
+    part2.append("world");
+    // throttled once, and then read the file in two parts
+    EXPECT_CALL(*reader_, read_file(_, "../data/chunk_1", 0, _, true, _, _))
+        .WillOnce(Return(EAGAIN))
+        .WillOnce(DoAll(SetArgPointee<0>(part1),
+                        SetArgPointee<5>(part1.size()),
+                        SetArgPointee<6>(false),
+                        Return(0)));
+    EXPECT_CALL(*reader_, read_file(_, "../data/chunk_1", 6, _, true, _, _))
+        .WillOnce(DoAll(SetArgPointee<0>(part2),
+                        SetArgPointee<5>(part2.size()),
+                        SetArgPointee<6>(true),
+                        Return(0)));
+    brpc::Channel channel;
+    brpc::Controller cntl;
+    ASSERT_EQ(channel.Init(serverAddr, nullptr), 0);
+    braft::FileService_Stub stub(&channel);
+    braft::GetFileRequest request;
+    request.set_reader_id(reader_id);
+    request.set_filename(std::string("../data/chunk_1") +
+                         CURVE_SNAPSHOT_CHECKSUM_SUFFIX);
+    request.set_count(1);
+    request.set_offset(0);
+    braft::GetFileResponse response;
+    // the checksum is computed in background, EAGAIN until it is done
+    auto getChecksum = [&]() {
+        while (true) {
+            cntl.Reset();
+            stub.get_file(&cntl, &request, &response, nullptr);
+            if (!cntl.Failed() || cntl.ErrorCode() != EAGAIN) {
+                return;
+            }
+            bthread_usleep(10 * 1000);
+        }
+    };
+    getChecksum();
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_TRUE(response.eof());
+
+    SnapshotChecksum expected;
+    butil::IOBuf content;
+    content.append("hello world");
+    expected.Update(content);
+    braft::FileSegData data(cntl.response_attachment());
+    uint64_t offset = 0;
+    butil::IOBuf seg;
+    ASSERT_NE(0, data.next(&offset, &seg));
+    ASSERT_EQ(expected.Final(), seg.to_string());
+    ASSERT_EQ(0, seg.to_string().find("11:"));
+
+    // the result is cached, the file is not read again
+    getChecksum();
+    ASSERT_FALSE(cntl.Failed());
+
+    // read error is returned and not cached
+    EXPECT_CALL(*reader_, read_file(_, "../data/chunk_2", 0, _, true, _, _))
+        .WillOnce(Return(EPERM))
+        .WillOnce(DoAll(SetArgPointee<0>(content),
+                        SetArgPointee<5>(content.size()),
+                        SetArgPointee<6>(true),
+                        Return(0)));
+    request.set_filename(std::string("../data/chunk_2") +
+                         CURVE_SNAPSHOT_CHECKSUM_SUFFIX);
+    getChecksum();
+    ASSERT_TRUE(cntl.Failed());
+    ASSERT_EQ(EPERM, cntl.ErrorCode());
+    getChecksum();
+    ASSERT_FALSE(cntl.Failed());
+    kCurveFileService.remove_reader(reader_id);
+}
+
+TEST_F(CurveFileServiceTest, success_sparse_file) {
+    int64_t reader_id;
+    ASSERT_EQ(0, kCurveFileService.add_reader(reader_, &reader_id));
+    std::string path = "/test";
+    EXPECT_CALL(*reader_, path())
+        .WillRepeatedly(ReturnRef(path));
+    // zero page, data page, zero page, partial data page
+    const size_t pageSize = 4096;
+    butil::IOBuf buf;
+    buf.append(std::string(pageSize, '\0'));
+    buf.append(std::string(pageSize, 'a'));
+    buf.append(std::string(pageSize, '\0'));
+    buf.append(std::string(100, 'b'));
+    const off_t offset = 2 * pageSize;
+    EXPECT_CALL(*reader_, read_file(_, "../data/chunk_1", offset, _, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<0>(buf),
+                        SetArgPointee<5>(buf.size()),
+                        SetArgPointee<6>(true),
+                        Return(0)));
+    brpc::Channel channel;
+    brpc::Controller cntl;
+    ASSERT_EQ(channel.Init(serverAddr, nullptr), 0);
+    braft::FileService_Stub stub(&channel);
+    braft::GetFileRequest request;
+    request.set_reader_id(reader_id);
+    request.set_filename(std::string("../data/chunk_1") +
+                         CURVE_SNAPSHOT_SPARSE_SUFFIX);
+    request.set_count(buf.size());
+    request.set_offset(offset);
+    braft::GetFileResponse response;
+    stub.get_file(&cntl, &request, &response, nullptr);
+    ASSERT_FALSE(cntl.Failed());
+    ASSERT_TRUE(response.eof());
+    ASSERT_EQ(buf.size(), response.read_size());
+
+    // only the data pages are transferred
+    braft::FileSegData data(cntl.response_attachment());
+    uint64_t segOffset = 0;
+    butil::IOBuf seg;
+    ASSERT_NE(0, data.next(&segOffset, &seg));
+    ASSERT_EQ(offset + pageSize, segOffset);
+    ASSERT_EQ(std::string(pageSize, 'a'), seg.to_string());
+    seg.clear();
+    ASSERT_NE(0, data.next(&segOffset, &seg));
+    ASSERT_EQ(offset + 3 * pageSize, segOffset);
+    ASSERT_EQ(std::string(100, 'b'), seg.to_string());
+    seg.clear();
+    ASSERT_EQ(0, data.next(&segOffset, &seg));
+    kCurveFileService.remove_reader(reader_id);
+}
+
 TEST(getCurveRaftBaseDir, test) {
     const struct {
         std::string first;
@@ -27,11 +27,13 @@
 #include <memory>
 
 #include "src/chunkserver/copyset_node.h"
+#include "src/common/timeutility.h"
 #include "test/chunkserver/datastore/mock_file_pool.h"
 #include "test/fs/mock_local_filesystem.h"
 
 using ::testing::_;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using ::testing::ElementsAre;
 using ::testing::Ge;
 using ::testing::Gt;
@@ -44,6 +46,7 @@ using ::testing::SetArgPointee;
 using ::testing::SetArrayArgument;
 using ::testing::Truly;
 
+using curve::common::TimeUtility;
 using curve::fs::MockLocalFileSystem;
 
 namespace curve {
@@ -760,5 +763,61 @@ TEST_F(TrashTest, test_chunk_num_statistic) {
     ASSERT_EQ(7, trash->GetChunkNum());
 }
 
+TEST_F(TrashTest, recycle_in_batch_with_throttle) {
+    // 每批2个文件，每秒最多20个文件
+    ops.recycleBatchSize = 2;
+    ops.recycleFilesPerSec = 20;
+    trash = std::make_shared<Trash>();
+    EXPECT_CALL(*lfs, List("./runlog/trash_test0/trash", _))
+        .WillOnce(Return(0));
+    ASSERT_EQ(0, trash->Init(ops));
+
+    std::string trashPath = "./runlog/trash_test0/trash";
+    std::string copysetDir = trashPath + "/4294967493.55555";
+    std::string dataDir = copysetDir + "/data";
+    std::vector<std::string> files{"4294967493.55555"};
+    std::vector<std::string> dirs{"data"};
+    std::vector<std::string> chunks{"chunk_1", "chunk_2", "chunk_3"};
+
+    EXPECT_CALL(*lfs, DirExists(trashPath)).WillOnce(Return(true));
+    EXPECT_CALL(*lfs, DirExists(copysetDir)).WillOnce(Return(true));
+    EXPECT_CALL(*lfs, DirExists(dataDir)).WillOnce(Return(true));
+    EXPECT_CALL(*lfs, List(trashPath, _))
+        .WillOnce(DoAll(SetArgPointee<1>(files), Return(0)));
+    EXPECT_CALL(*lfs, List(copysetDir, _))
+        .WillOnce(DoAll(SetArgPointee<1>(dirs), Return(0)));
+    EXPECT_CALL(*lfs, List(dataDir, _))
+        .WillOnce(DoAll(SetArgPointee<1>(chunks), Return(0)));
+    SetCopysetNeedDelete(copysetDir, true);
+
+    FilePoolOptions poolOpt;
+    poolOpt.fileSize = 4096;
+    EXPECT_CALL(*pool, GetFilePoolOpt()).WillOnce(Return(poolOpt));
+    EXPECT_CALL(*walPool, GetFilePoolOpt()).WillOnce(Return(poolOpt));
+
+    // 记录每个文件回收时待回收的空间
+    std::vector<uint64_t> pendingBytes;
+    for (auto& chunk : chunks) {
+        EXPECT_CALL(*lfs, DirExists(dataDir + "/" + chunk))
+            .WillOnce(Return(false));
+        EXPECT_CALL(*pool, RecycleFile(dataDir + "/" + chunk))
+            .WillOnce(Invoke([&](const std::string&) {
+                pendingBytes.push_back(trash->GetPendingReclaimBytes());
+                return 0;
+            }));
+    }
+    EXPECT_CALL(*lfs, Delete(copysetDir)).WillOnce(Return(0));
+
+    uint64_t startUs = TimeUtility::GetTimeofDayUs();
+    trash->DeleteEligibleFileInTrash();
+    uint64_t costUs = TimeUtility::GetTimeofDayUs() - startUs;
+
+    // 同一批的文件一起归还，归还之后待回收的空间才减少
+    ASSERT_THAT(pendingBytes, ElementsAre(3 * 4096, 3 * 4096, 4096));
+    ASSERT_EQ(0, trash->GetPendingReclaimBytes());
+    // 3个文件至少需要150ms
+    ASSERT_GE(costUs, 140 * 1000);
+}
+
 }  // namespace chunkserver
 }  // namespace curve
@@ -555,6 +555,171 @@ TEST_F(IOTrackerSplitorTest, ManagerAsyncStartWrite) {
     ASSERT_EQ('c', writebuffer[aioctx->length - 1]);
 }
 
+TEST_F(IOTrackerSplitorTest, ManagerAsyncStartReadv) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+
+    // read data is cut into three user buffers along the chunk boundary
+    std::unique_ptr<char[]> head(new char[4 * 1024]);
+    std::unique_ptr<char[]> body(new char[chunk_size]);
+    std::unique_ptr<char[]> tail(new char[4 * 1024]);
+    struct iovec iov[3];
+    iov[0].iov_base = head.get();
+    iov[0].iov_len = 4 * 1024;
+    iov[1].iov_base = body.get();
+    iov[1].iov_len = chunk_size;
+    iov[2].iov_base = tail.get();
+    iov[2].iov_len = 4 * 1024;
+
+    CurveAioContext aioctx;
+    aioctx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    aioctx.length = 4 * 1024 * 1024 + 8 * 1024;
+    aioctx.ret = LIBCURVE_ERROR::OK;
+    aioctx.cb = readcallback;
+    aioctx.buf = nullptr;
+    aioctx.op = LIBCURVE_OP::LIBCURVE_OP_READ;
+
+    ioreadflag = false;
+    ASSERT_EQ(LIBCURVE_ERROR::OK,
+              ioctxmana->AioReadv(&aioctx, iov, 3, mdsclient_.get()));
+
+    {
+        std::unique_lock<std::mutex> lk(readmtx);
+        readcv.wait(lk, []()->bool{return ioreadflag;});
+    }
+    ASSERT_EQ(static_cast<int>(aioctx.length), aioctx.ret);
+    ASSERT_EQ('a', head[0]);
+    ASSERT_EQ('a', head[4 * 1024 - 1]);
+    ASSERT_EQ('b', body[0]);
+    ASSERT_EQ('e', body[chunk_size - 1]);
+    ASSERT_EQ('f', tail[0]);
+    ASSERT_EQ('f', tail[4 * 1024 - 1]);
+}
+
+TEST_F(IOTrackerSplitorTest, ManagerAsyncStartWritev) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+
+    // user buffers don't have to be aligned with the chunk boundary
+    std::unique_ptr<char[]> head(new char[4 * 1024 + 512]);
+    std::unique_ptr<char[]> tail(new char[chunk_size + 4 * 1024 - 512]);
+    memset(head.get(), 'a', 4 * 1024);
+    memset(head.get() + 4 * 1024, 'b', 512);
+    memset(tail.get(), 'b', chunk_size - 512);
+    memset(tail.get() + chunk_size - 512, 'c', 4 * 1024);
+    struct iovec iov[2];
+    iov[0].iov_base = head.get();
+    iov[0].iov_len = 4 * 1024 + 512;
+    iov[1].iov_base = tail.get();
+    iov[1].iov_len = chunk_size + 4 * 1024 - 512;
+
+    CurveAioContext aioctx;
+    aioctx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    aioctx.length = 4 * 1024 * 1024 + 8 * 1024;
+    aioctx.ret = LIBCURVE_ERROR::OK;
+    aioctx.cb = writecallback;
+    aioctx.buf = nullptr;
+    aioctx.op = LIBCURVE_OP::LIBCURVE_OP_WRITE;
+
+    iowriteflag = false;
+    ASSERT_EQ(LIBCURVE_ERROR::OK,
+              ioctxmana->AioWritev(&aioctx, iov, 2, mdsclient_.get()));
+
+    {
+        std::unique_lock<std::mutex> lk(writemtx);
+        writecv.wait(lk, []()->bool{return iowriteflag;});
+    }
+
+    ASSERT_EQ(static_cast<int>(aioctx.length), aioctx.ret);
+    std::unique_ptr<char[]> writebuffer(new char[aioctx.length]);
+    memcpy(writebuffer.get(), writeData.to_string().c_str(), aioctx.length);
+
+    ASSERT_EQ('a', writebuffer[0]);
+    ASSERT_EQ('a', writebuffer[4 * 1024 - 1]);
+    ASSERT_EQ('b', writebuffer[4 * 1024]);
+    ASSERT_EQ('b', writebuffer[4 * 1024 + chunk_size - 1]);
+    ASSERT_EQ('c', writebuffer[4 * 1024 + chunk_size]);
+    ASSERT_EQ('c', writebuffer[aioctx.length - 1]);
+}
+
+TEST_F(IOTrackerSplitorTest, ManagerAioSubmitBatch) {
+    MockRequestScheduler* mockschuler = new MockRequestScheduler;
+    mockschuler->DelegateToFake();
+
+    auto ioctxmana = fileinstance_->GetIOManager4File();
+    ioctxmana->SetRequestScheduler(mockschuler);
+
+    CurveAioContext writectx;
+    writectx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    writectx.length = 4 * 1024 * 1024 + 8 * 1024;
+    writectx.ret = LIBCURVE_ERROR::OK;
+    writectx.cb = writecallback;
+    writectx.buf = new char[writectx.length];
+    writectx.op = LIBCURVE_OP::LIBCURVE_OP_WRITE;
+    char* writebuf = static_cast<char*>(writectx.buf);
+    memset(writebuf, 'a', 4 * 1024);
+    memset(writebuf + 4 * 1024, 'b', chunk_size);
+    memset(writebuf + 4 * 1024 + chunk_size, 'c', 4 * 1024);
+
+    CurveAioContext readctx;
+    readctx.offset = 4 * 1024 * 1024 - 4 * 1024;
+    readctx.length = 4 * 1024 * 1024 + 8 * 1024;
+    readctx.ret = LIBCURVE_ERROR::OK;
+    readctx.cb = readcallback;
+    readctx.buf = new char[readctx.length];
+    readctx.op = LIBCURVE_OP::LIBCURVE_OP_READ;
+    char* readbuf = static_cast<char*>(readctx.buf);
+
+    // invalid op is completed with error before the batch is scheduled,
+    // the other requests are not affected
+    CurveAioContext invalidctx;
+    invalidctx.offset = 0;
+    invalidctx.length = 4096;
+    invalidctx.ret = LIBCURVE_ERROR::OK;
+    invalidctx.buf = nullptr;
+    invalidctx.op = LIBCURVE_OP::LIBCURVE_OP_MAX;
+    invalidctx.cb = [](CurveAioContext* ctx) {};
+
+    CurveAioContext* ctxs[] = {&writectx, &invalidctx, &readctx};
+
+    iowriteflag = false;
+    ioreadflag = false;
+    ASSERT_EQ(LIBCURVE_ERROR::OK,
+              ioctxmana->AioSubmitBatch(ctxs, 3, mdsclient_.get(),
+                                        UserDataType::RawBuffer));
+    ASSERT_EQ(-LIBCURVE_ERROR::PARAM_ERROR, invalidctx.ret);
+
+    {
+        std::unique_lock<std::mutex> lk(writemtx);
+        writecv.wait(lk, []()->bool{return iowriteflag;});
+    }
+    {
+        std::unique_lock<std::mutex> lk(readmtx);
+        readcv.wait(lk, []()->bool{return ioreadflag;});
+    }
+
+    ASSERT_EQ(static_cast<int>(writectx.length), writectx.ret);
+    std::unique_ptr<char[]> writebuffer(new char[writectx.length]);
+    memcpy(writebuffer.get(), writeData.to_string().c_str(), writectx.length);
+    ASSERT_EQ('a', writebuffer[0]);
+    ASSERT_EQ('b', writebuffer[4 * 1024]);
+    ASSERT_EQ('c', writebuffer[writectx.length - 1]);
+
+    ASSERT_EQ(static_cast<int>(readctx.length), readctx.ret);
+    ASSERT_EQ('a', readbuf[0]);
+    ASSERT_EQ('b', readbuf[4 * 1024]);
+    ASSERT_EQ('f', readbuf[readctx.length - 1]);
+
+    delete[] writebuf;
+    delete[] readbuf;
+}
+
 /*
 TEST_F(IOTrackerSplitorTest, ManagerAsyncStartWriteReadGetSegmentFail) {
     MockRequestScheduler* mockschuler = new MockRequestScheduler;
@@ -25,6 +25,8 @@
 #include <gtest/gtest.h>
 #include <brpc/server.h>
 
+#include <atomic>
+
 #include "src/client/iomanager4file.h"
 #include "src/client/lease_executor.h"
 #include "src/client/mds_client.h"
@@ -52,6 +54,24 @@ static void MockRefreshSession(::google::protobuf::RpcController* controller,
     response->set_sessionid("");
 }
 
+static void MockRefreshSessions(
+    ::google::protobuf::RpcController* controller,
+    const curve::mds::RefreshSessionsRequest* request,
+    curve::mds::RefreshSessionsResponse* response,
+    ::google::protobuf::Closure* done) {
+    brpc::ClosureGuard guard(done);
+
+    response->set_statuscode(curve::mds::StatusCode::kOK);
+    for (const auto& req : request->requests()) {
+        auto* resp = response->add_responses();
+        resp->set_statuscode(curve::mds::StatusCode::kOK);
+        resp->set_sessionid(req.sessionid());
+        curve::mds::FileInfo* fileInfo = resp->mutable_fileinfo();
+        fileInfo->set_filename(req.filename());
+        fileInfo->set_filestatus(curve::mds::FileStatus::kFileCreated);
+    }
+}
+
 class LeaseExecutorTest : public ::testing::Test {
  protected:
     void SetUp() override {
@@ -177,5 +197,46 @@ TEST_F(LeaseExecutorTest, TestNoStop) {
     // ASSERT_NO_FATAL_FAILURE(exec.Stop());
 }
 
+TEST_F(LeaseExecutorTest, TestBatchRefresh) {
+    // all files are refreshed by RefreshSessions
+    std::atomic<int> refreshedFiles{0};
+    EXPECT_CALL(curveFsService_, RefreshSession(_, _, _, _)).Times(0);
+    EXPECT_CALL(curveFsService_, RefreshSessions(_, _, _, _))
+        .WillRepeatedly(
+            Invoke([&](::google::protobuf::RpcController* controller,
+                       const curve::mds::RefreshSessionsRequest* request,
+                       curve::mds::RefreshSessionsResponse* response,
+                       ::google::protobuf::Closure* done) {
+                refreshedFiles.fetch_add(request->requests_size());
+                MockRefreshSessions(controller, request, response, done);
+            }));
+
+    leaseOpt_.mdsRefreshTimesPerLease = 10;
+    leaseOpt_.batchRefresh = true;
+    lease_.leaseTime = 1000000;
+    fi_.filestatus = FileStatus::Created;
+
+    fi_.fullPathName = "/TestBatchRefresh1";
+    LeaseExecutor exec1(leaseOpt_, userInfo_, &mdsClient_, &io4File_);
+    ASSERT_TRUE(exec1.Start(fi_, lease_));
+
+    fi_.fullPathName = "/TestBatchRefresh2";
+    LeaseExecutor exec2(leaseOpt_, userInfo_, &mdsClient_, &io4File_);
+    ASSERT_TRUE(exec2.Start(fi_, lease_));
+
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    ASSERT_TRUE(exec1.LeaseValid());
+    ASSERT_TRUE(exec2.LeaseValid());
+
+    ASSERT_GT(refreshedFiles.load(), 2);
+
+    ASSERT_NO_FATAL_FAILURE(exec1.Stop());
+    int refreshed = refreshedFiles.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    ASSERT_GT(refreshedFiles.load(), refreshed);
+
+    ASSERT_NO_FATAL_FAILURE(exec2.Stop());
+}
+
 }  // namespace client
 }  // namespace curve
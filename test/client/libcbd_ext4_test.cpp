@@ -168,6 +168,117 @@ TEST(TestLibcbdExt4, AioReadWriteTest) {
     ASSERT_EQ(ret, 0);
 }
 
+TEST(TestLibcbdExt4, AioVectoredReadWriteTest) {
+    int ret;
+    int fd;
+    int i;
+#define BUFSIZE 4 * 1024
+#define FILESIZE 1 * 1024 * 1024
+    char head[BUFSIZE / 2];
+    char tail[BUFSIZE / 2];
+    struct iovec iov[2];
+    std::string filename = "test.img";
+    CurveOptions opt;
+    CurveAioContext aioCtx;
+
+    iov[0].iov_base = head;
+    iov[0].iov_len = sizeof(head);
+    iov[1].iov_base = tail;
+    iov[1].iov_len = sizeof(tail);
+
+    aioCtx.buf = nullptr;
+    aioCtx.offset = 0;
+    aioCtx.length = BUFSIZE;
+    aioCtx.cb = LibcbdExt4TestCallback;
+
+    memset(&opt, 0, sizeof(opt));
+    memset(head, 'a', sizeof(head));
+    memset(tail, 'b', sizeof(tail));
+
+    opt.datahome = ".";
+    ret = cbd_lib_init(&opt);
+    ASSERT_EQ(ret, 0);
+
+    fd = cbd_lib_open(filename.c_str());
+    ASSERT_GE(fd, 0);
+
+    ret = fallocate(fd, 0, 0, FILESIZE);
+    ASSERT_GE(fd, 0);
+
+    aioCtx.op = LIBCURVE_OP_WRITE;
+    ret = cbd_lib_aio_pwritev(fd, &aioCtx, iov, 2);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(aioCtx.op, LIBCURVE_OP_MAX);
+    ASSERT_EQ(aioCtx.ret, BUFSIZE);
+
+    memset(head, 0, sizeof(head));
+    memset(tail, 0, sizeof(tail));
+
+    aioCtx.op = LIBCURVE_OP_READ;
+    ret = cbd_lib_aio_preadv(fd, &aioCtx, iov, 2);
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(aioCtx.op, LIBCURVE_OP_MAX);
+    ASSERT_EQ(aioCtx.ret, BUFSIZE);
+
+    for (i = 0; i < BUFSIZE / 2; i++) {
+        if (head[i] != 'a' || tail[i] != 'b') {
+            break;
+        }
+    }
+    ASSERT_EQ(i, BUFSIZE / 2);
+
+    ret = cbd_lib_close(fd);
+    ASSERT_EQ(ret, 0);
+
+    ret = cbd_lib_fini();
+    ASSERT_EQ(ret, 0);
+}
+
+TEST(TestLibcbdExt4, AioSubmitBatchPartialFailTest) {
+    int ret;
+    int fd;
+    std::string filename = "test.img";
+    CurveOptions opt;
+    CurveAioContext aioCtx[3];
+    CurveAioContext* ctxs[3];
+
+    for (int i = 0; i < 3; i++) {
+        aioCtx[i].buf = nullptr;
+        aioCtx[i].offset = i * 4096;
+        aioCtx[i].length = 4096;
+        aioCtx[i].ret = 0;
+        aioCtx[i].op = LIBCURVE_OP_DISCARD;
+        aioCtx[i].cb = LibcbdExt4TestCallback;
+        ctxs[i] = &aioCtx[i];
+    }
+    // unsupported op fails to submit, the request after it
+    // should be completed with error too
+    aioCtx[1].op = LIBCURVE_OP_MAX;
+
+    memset(&opt, 0, sizeof(opt));
+    opt.datahome = ".";
+    ret = cbd_lib_init(&opt);
+    ASSERT_EQ(ret, 0);
+
+    fd = cbd_lib_open(filename.c_str());
+    ASSERT_GE(fd, 0);
+
+    ret = cbd_lib_aio_submit_batch(fd, ctxs, 3);
+    ASSERT_EQ(ret, 0);
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(aioCtx[i].op, LIBCURVE_OP_MAX);
+    }
+    ASSERT_EQ(aioCtx[0].ret, 4096);
+    ASSERT_EQ(aioCtx[1].ret, -LIBCURVE_ERROR::FAILED);
+    ASSERT_EQ(aioCtx[2].ret, -LIBCURVE_ERROR::FAILED);
+
+    ret = cbd_lib_close(fd);
+    ASSERT_EQ(ret, 0);
+
+    ret = cbd_lib_fini();
+    ASSERT_EQ(ret, 0);
+}
+
 TEST(TestLibcbdExt4, IncreaseEpochTest) {
     int ret;
     CurveOptions opt;
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>   //NOLINT
+#include <vector>
+
+#include "src/common/concurrent/bounded_blocking_queue.h"
+
+namespace curve {
+namespace common {
+
+TEST(BoundedBlockingDequeTest, PutBackBatch) {
+    BoundedBlockingDeque<int> deque;
+    ASSERT_EQ(0, deque.Init(8));
+
+    std::vector<int> xs{1, 2, 3, 4};
+    deque.PutBack(xs);
+    deque.PutBack(5);
+    ASSERT_EQ(5, deque.Size());
+    for (int i = 1; i <= 5; ++i) {
+        ASSERT_EQ(i, deque.TakeFront());
+    }
+
+    // empty batch does nothing
+    deque.PutBack(std::vector<int>{});
+    ASSERT_TRUE(deque.Empty());
+}
+
+TEST(BoundedBlockingDequeTest, PutBackBatchLargerThanCapacity) {
+    BoundedBlockingDeque<int> deque;
+    ASSERT_EQ(0, deque.Init(4));
+
+    const int count = 100;
+    std::vector<int> xs;
+    for (int i = 0; i < count; ++i) {
+        xs.push_back(i);
+    }
+
+    // the batch blocks when the deque is full, and is put in order
+    // as consumers take elements out
+    std::thread producer([&deque, &xs]() {
+        deque.PutBack(xs);
+    });
+
+    std::vector<int> taken;
+    for (int i = 0; i < count; ++i) {
+        taken.push_back(deque.TakeFront());
+        ASSERT_LE(deque.Size(), deque.Capacity());
+    }
+    producer.join();
+
+    ASSERT_EQ(xs, taken);
+    ASSERT_TRUE(deque.Empty());
+}
+
+TEST(BoundedBlockingDequeTest, PutBackBatchMultiConsumers) {
+    BoundedBlockingDeque<int> deque;
+    ASSERT_EQ(0, deque.Init(16));
+
+    const int consumerNum = 4;
+    const int perConsumer = 64;
+    std::vector<int> xs(consumerNum * perConsumer, 1);
+
+    // one batch wakes up all waiting consumers
+    std::vector<std::thread> consumers;
+    std::vector<int> sums(consumerNum, 0);
+    for (int i = 0; i < consumerNum; ++i) {
+        consumers.emplace_back([&deque, &sums, i]() {
+            for (int j = 0; j < perConsumer; ++j) {
+                sums[i] += deque.TakeFront();
+            }
+        });
+    }
+
+    deque.PutBack(xs);
+    for (auto& t : consumers) {
+        t.join();
+    }
+
+    for (int i = 0; i < consumerNum; ++i) {
+        ASSERT_EQ(perConsumer, sums[i]);
+    }
+    ASSERT_TRUE(deque.Empty());
+}
+
+}  // namespace common
+}  // namespace curve
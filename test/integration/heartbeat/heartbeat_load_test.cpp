@@ -0,0 +1,347 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <atomic>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "test/integration/heartbeat/common.h"
+
+// default scale is a large cluster, about 60 copysets per chunkserver
+DEFINE_uint32(hb_load_chunkserver_num, 6000,
+              "number of simulated chunkservers, spread over 3 zones");
+DEFINE_uint32(hb_load_copyset_num, 120000, "number of copysets");
+DEFINE_uint32(hb_load_rounds, 12, "heartbeat rounds of each mode");
+DEFINE_uint32(hb_load_full_interval, 6,
+              "delta heartbeats between two full heartbeats");
+DEFINE_uint32(hb_load_change_permille, 10,
+              "permille of copysets changed in each round");
+DEFINE_uint32(hb_load_threads, 16, "threads sending heartbeats");
+
+using ::curve::mds::heartbeat::HeartbeatStatusCode;
+using ::curve::common::TimeUtility;
+
+namespace curve {
+namespace mds {
+
+// ids of simulated chunkservers and their servers start from kIdBase
+const ChunkServerIdType kIdBase = 100;
+
+// Load generator for heartbeat module, it simulates thousands of
+// chunkservers sending heartbeats to a local mds, and compares the
+// cost of full heartbeat and delta heartbeat
+class HeartbeatLoadTest : public ::testing::Test {
+ protected:
+    struct SimChunkServer {
+        ChunkServerIdType id;
+        std::string ip;
+        uint32_t port;
+        std::vector<CopySetIdType> copysets;
+        // copysets changed since last accepted heartbeat
+        std::set<CopySetIdType> dirty;
+        uint64_t hbEpoch = 0;
+        uint64_t ackedEpoch = 0;
+        uint32_t deltaCount = 0;
+    };
+
+    struct SimCopySet {
+        std::vector<ChunkServerIdType> members;
+        uint64_t lastScanSec = 0;
+    };
+
+    struct RoundStat {
+        std::atomic<uint64_t> requestBytes{0};
+        std::atomic<uint64_t> reportedCopysets{0};
+        std::atomic<uint64_t> rpcUs{0};
+        std::atomic<uint64_t> rejected{0};
+    };
+
+    void InitConfiguration(Configuration *conf) {
+        conf->SetIntValue("mds.topology.ChunkServerStateUpdateSec", 0);
+
+        conf->SetIntValue("mds.heartbeat.intervalMs", 1000);
+        conf->SetIntValue("mds.heartbeat.misstimeoutMs", 600000);
+        conf->SetIntValue("mds.heartbeat.offlinetimeoutMs", 1800000);
+        conf->SetIntValue("mds.heartbeat.clean_follower_afterMs", 0);
+
+        conf->SetStringValue("mds.listen.addr", "127.0.0.1:6881");
+
+        conf->SetBoolValue("mds.enable.copyset.scheduler", false);
+        conf->SetBoolValue("mds.enable.leader.scheduler", false);
+        conf->SetBoolValue("mds.enable.recover.scheduler", false);
+        conf->SetBoolValue("mds.replica.replica.scheduler", false);
+
+        conf->SetIntValue("mds.copyset.scheduler.intervalSec", 300);
+        conf->SetIntValue("mds.leader.scheduler.intervalSec", 300);
+        conf->SetIntValue("mds.recover.scheduler.intervalSec", 300);
+        conf->SetIntValue("mds.replica.scheduler.intervalSec", 300);
+
+        conf->SetIntValue("mds.schduler.operator.concurrent", 4);
+        conf->SetIntValue("mds.schduler.transfer.limitSec", 10);
+        conf->SetIntValue("mds.scheduler.add.limitSec", 10);
+        conf->SetIntValue("mds.scheduler.remove.limitSec", 10);
+        conf->SetDoubleValue("mds.scheduler.copysetNumRangePercent", 0.05);
+        conf->SetDoubleValue("mds.schduler.scatterWidthRangePerent", 0.2);
+        conf->SetIntValue("mds.scheduler.minScatterWidth", 50);
+    }
+
+    void SetUp() override {
+        Configuration conf;
+        InitConfiguration(&conf);
+        hbtest_ = std::make_shared<HeartbeatIntegrationCommon>(conf);
+        hbtest_->BuildBasicCluster();
+        PrepareLoadCluster();
+    }
+
+    void TearDown() override {
+        ASSERT_EQ(0, hbtest_->server_.Stop(100));
+        ASSERT_EQ(0, hbtest_->server_.Join());
+    }
+
+    // add simulated chunkservers and copysets to the basic cluster,
+    // chunkserver i is placed in zone (i % 3 + 1) of physical pool 1
+    void PrepareLoadCluster() {
+        const uint32_t csNum = FLAGS_hb_load_chunkserver_num / 3 * 3;
+        ASSERT_GT(csNum, 0);
+        std::vector<std::vector<uint32_t>> zones(3);
+        for (uint32_t i = 0; i < csNum; i++) {
+            SimChunkServer cs;
+            cs.id = kIdBase + i;
+            cs.ip = "10.0." + std::to_string(i / 250) + "." +
+                    std::to_string(i % 250 + 1);
+            cs.port = 8200;
+            ZoneIdType zoneId = i % 3 + 1;
+            Server server(kIdBase + i, "load" + std::to_string(i), cs.ip, 0,
+                          cs.ip, 0, zoneId, 1, "");
+            hbtest_->PrepareAddServer(server);
+            ChunkServer chunkserver(cs.id, "testToken", "nvme",
+                                    kIdBase + i, cs.ip, cs.port, "/");
+            hbtest_->PrepareAddChunkServer(chunkserver);
+            zones[i % 3].push_back(i);
+            chunkservers_.push_back(cs);
+        }
+
+        std::mt19937 gen(0);
+        copysets_.resize(FLAGS_hb_load_copyset_num);
+        for (uint32_t c = 0; c < FLAGS_hb_load_copyset_num; c++) {
+            std::set<ChunkServerIdType> members;
+            for (auto &zone : zones) {
+                uint32_t index = zone[gen() % zone.size()];
+                copysets_[c].members.push_back(chunkservers_[index].id);
+                chunkservers_[index].copysets.push_back(CopysetId(c));
+                members.emplace(chunkservers_[index].id);
+            }
+            hbtest_->PrepareAddCopySet(CopysetId(c), 1, members);
+        }
+    }
+
+    CopySetIdType CopysetId(uint32_t index) {
+        // copyset 1 belongs to the basic cluster
+        return index + 2;
+    }
+
+    const SimChunkServer &GetChunkServer(ChunkServerIdType id) {
+        return chunkservers_[id - kIdBase];
+    }
+
+    void AddCopySetToRequest(CopySetIdType id,
+                             ChunkServerHeartbeatRequest *req) {
+        const SimCopySet &copyset = copysets_[id - 2];
+        auto info = req->add_copysetinfos();
+        info->set_logicalpoolid(1);
+        info->set_copysetid(id);
+        info->set_epoch(0);
+        for (auto member : copyset.members) {
+            const SimChunkServer &peer = GetChunkServer(member);
+            std::string addr =
+                peer.ip + ":" + std::to_string(peer.port) + ":0";
+            info->add_peers()->set_address(addr);
+            if (member == copyset.members[0]) {
+                info->mutable_leaderpeer()->set_address(addr);
+            }
+        }
+        info->set_lastscansec(copyset.lastScanSec);
+        auto stats = info->mutable_stats();
+        stats->set_readrate(100);
+        stats->set_writerate(100);
+        stats->set_readiops(100);
+        stats->set_writeiops(100);
+    }
+
+    void BuildRequest(SimChunkServer *cs, bool delta,
+                      ChunkServerHeartbeatRequest *req) {
+        req->set_chunkserverid(cs->id);
+        req->set_token("testToken");
+        req->set_ip(cs->ip);
+        req->set_port(cs->port);
+        req->mutable_diskstate()->set_errtype(0);
+        req->mutable_diskstate()->set_errmsg("disk ok");
+        req->set_diskcapacity(100);
+        req->set_diskused(50);
+        req->set_copysetcount(cs->copysets.size());
+        uint32_t leaders = 0;
+        for (auto id : cs->copysets) {
+            if (copysets_[id - 2].members[0] == cs->id) {
+                leaders++;
+            }
+        }
+        req->set_leadercount(leaders);
+        auto stats = req->mutable_stats();
+        stats->set_readrate(100);
+        stats->set_writerate(100);
+        stats->set_readiops(100);
+        stats->set_writeiops(100);
+        stats->set_chunksizeusedbytes(100);
+        stats->set_chunksizeleftbytes(100);
+        stats->set_chunksizetrashedbytes(100);
+
+        if (!delta) {
+            for (auto id : cs->copysets) {
+                AddCopySetToRequest(id, req);
+            }
+            return;
+        }
+
+        req->set_hbepoch(++cs->hbEpoch);
+        if (cs->ackedEpoch == 0 ||
+            cs->deltaCount >= FLAGS_hb_load_full_interval) {
+            for (auto id : cs->copysets) {
+                AddCopySetToRequest(id, req);
+            }
+        } else {
+            for (auto id : cs->dirty) {
+                AddCopySetToRequest(id, req);
+            }
+            req->set_baseepoch(cs->ackedEpoch);
+        }
+    }
+
+    void SendHeartbeat(SimChunkServer *cs, bool delta, RoundStat *stat) {
+        ChunkServerHeartbeatRequest req;
+        ChunkServerHeartbeatResponse resp;
+        BuildRequest(cs, delta, &req);
+
+        brpc::Channel channel;
+        ASSERT_EQ(0, channel.Init(hbtest_->listenAddr_.c_str(), NULL));
+        HeartbeatService_Stub stub(&channel);
+        brpc::Controller cntl;
+        cntl.set_timeout_ms(10000);
+        stub.ChunkServerHeartbeat(&cntl, &req, &resp, NULL);
+        ASSERT_FALSE(cntl.Failed()) << cntl.ErrorText();
+        ASSERT_EQ(HeartbeatStatusCode::hbOK, resp.statuscode());
+
+        stat->requestBytes += req.ByteSizeLong();
+        stat->reportedCopysets += req.copysetinfos_size();
+        stat->rpcUs += cntl.latency_us();
+
+        if (!delta) {
+            return;
+        }
+        if (resp.has_hbepoch() && resp.hbepoch() == req.hbepoch()) {
+            cs->ackedEpoch = req.hbepoch();
+            cs->deltaCount = req.has_baseepoch() ? cs->deltaCount + 1 : 0;
+            cs->dirty.clear();
+        } else {
+            stat->rejected++;
+            cs->ackedEpoch = 0;
+            cs->deltaCount = 0;
+        }
+    }
+
+    // update lastScanSec of some copysets, so that they will be reported
+    // by delta heartbeat
+    void ChangeCopysets(std::mt19937 *gen, uint64_t round) {
+        uint64_t count = static_cast<uint64_t>(FLAGS_hb_load_copyset_num) *
+                         FLAGS_hb_load_change_permille / 1000;
+        for (uint64_t i = 0; i < count; i++) {
+            uint32_t index = (*gen)() % copysets_.size();
+            copysets_[index].lastScanSec = round;
+            for (auto member : copysets_[index].members) {
+                chunkservers_[member - kIdBase].dirty.emplace(
+                    CopysetId(index));
+            }
+        }
+    }
+
+    // returns the average time of rounds in ms
+    uint64_t RunRounds(bool delta) {
+        std::mt19937 gen(1);
+        uint64_t totalMs = 0;
+        RoundStat stat;
+        for (uint32_t round = 1; round <= FLAGS_hb_load_rounds; round++) {
+            ChangeCopysets(&gen, round);
+            auto start = TimeUtility::GetTimeofDayMs();
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < FLAGS_hb_load_threads; t++) {
+                threads.emplace_back([this, t, delta, &stat]() {
+                    for (size_t i = t; i < chunkservers_.size();
+                         i += FLAGS_hb_load_threads) {
+                        SendHeartbeat(&chunkservers_[i], delta, &stat);
+                    }
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+            totalMs += TimeUtility::GetTimeofDayMs() - start;
+        }
+
+        uint64_t requests =
+            static_cast<uint64_t>(FLAGS_hb_load_rounds) * chunkservers_.size();
+        LOG(INFO) << (delta ? "delta" : "full") << " heartbeat of "
+                  << chunkservers_.size() << " chunkservers and "
+                  << copysets_.size() << " copysets, rounds: "
+                  << FLAGS_hb_load_rounds
+                  << ", avg round time: " << totalMs / FLAGS_hb_load_rounds
+                  << "ms, avg rpc latency: " << stat.rpcUs / requests
+                  << "us, avg request bytes: " << stat.requestBytes / requests
+                  << ", avg reported copysets: "
+                  << stat.reportedCopysets / requests
+                  << ", rejected delta: " << stat.rejected;
+        EXPECT_EQ(0, stat.rejected);
+        return totalMs / FLAGS_hb_load_rounds;
+    }
+
+ protected:
+    std::shared_ptr<HeartbeatIntegrationCommon> hbtest_;
+    std::vector<SimChunkServer> chunkservers_;
+    std::vector<SimCopySet> copysets_;
+};
+
+TEST_F(HeartbeatLoadTest, FullAndDeltaHeartbeat) {
+    // full heartbeat first, so that the topology is up to date with the
+    // reported copysets before comparing
+    uint64_t fullMs = RunRounds(false);
+    uint64_t deltaMs = RunRounds(true);
+    LOG(INFO) << "avg round time, full: " << fullMs
+              << "ms, delta: " << deltaMs << "ms";
+}
+
+}  // namespace mds
+}  // namespace curve
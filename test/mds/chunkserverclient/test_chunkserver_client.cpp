@@ -49,6 +49,8 @@ using ::curve::chunkserver::MockChunkService;
 using ::curve::chunkserver::MockCliService;
 using ::curve::chunkserver::ChunkRequest;
 using ::curve::chunkserver::ChunkResponse;
+using ::curve::chunkserver::DeleteChunksRequest;
+using ::curve::chunkserver::DeleteChunksResponse;
 using ::curve::chunkserver::CHUNK_OP_TYPE;
 using ::curve::chunkserver::CHUNK_OP_STATUS;
 using ::curve::chunkserver::CHUNK_OP_STATUS_FAILURE_UNKNOWN;
@@ -793,7 +795,86 @@ TEST_F(TestChunkServerClient, TestDeleteChunkReturnNotLeader) {
     ASSERT_EQ(kCsClientNotLeader, ret);
 }
 
+TEST_F(TestChunkServerClient, TestDeleteChunksSuccess) {
+    uint32_t port = listenAddr_.port;
+    ChunkServerIdType csId = 0x01;
+    LogicalPoolID logicalPoolId = 0x11;
+    CopysetID copysetId = 0x21;
+    std::vector<ChunkID> chunkIds = {0x31, 0x32};
+    uint64_t sn = 100;
+
+    ChunkServer chunkserver(
+        csId, "", "", 0x101, "127.0.0.1", port, "", READWRITE);
+    ChunkServerState csState;
+    csState.SetDiskState(DISKNORMAL);
+    chunkserver.SetOnlineState(ONLINE);
+    chunkserver.SetChunkServerState(csState);
+
+    EXPECT_CALL(*topo_, GetChunkServer(csId, _))
+        .WillOnce(DoAll(SetArgPointee<1>(chunkserver),
+            Return(true)));
+    EXPECT_CALL(*chunkService, DeleteChunks(_, _, _, _))
+        .WillOnce(Invoke([&](RpcController *controller,
+                             const DeleteChunksRequest *request,
+                             DeleteChunksResponse *response,
+                             Closure *done){
+                    brpc::ClosureGuard doneGuard(done);
+                    ASSERT_EQ(2, request->requests_size());
+                    for (int i = 0; i < request->requests_size(); ++i) {
+                        ASSERT_EQ(CHUNK_OP_TYPE::CHUNK_OP_DELETE,
+                                  request->requests(i).optype());
+                        ASSERT_EQ(chunkIds[i],
+                                  request->requests(i).chunkid());
+                        ASSERT_EQ(sn, request->requests(i).sn());
+                    }
+                    response->add_responses()->set_status(
+                        CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+                    response->add_responses()->set_status(
+                        CHUNK_OP_STATUS::CHUNK_OP_STATUS_CHUNK_NOTEXIST);
+                }));
+
+    int ret = client_->DeleteChunks(
+        csId, logicalPoolId, copysetId, chunkIds, sn);
+    ASSERT_EQ(kMdsSuccess, ret);
+}
+
+TEST_F(TestChunkServerClient, TestDeleteChunksReturnNotLeader) {
+    uint32_t port = listenAddr_.port;
+    ChunkServerIdType csId = 0x01;
+    LogicalPoolID logicalPoolId = 0x11;
+    CopysetID copysetId = 0x21;
+    std::vector<ChunkID> chunkIds = {0x31, 0x32};
+    uint64_t sn = 100;
+
+    ChunkServer chunkserver(
+        csId, "", "", 0x101, "127.0.0.1", port, "", READWRITE);
+    ChunkServerState csState;
+    csState.SetDiskState(DISKNORMAL);
+    chunkserver.SetOnlineState(ONLINE);
+    chunkserver.SetChunkServerState(csState);
+
+    EXPECT_CALL(*topo_, GetChunkServer(csId, _))
+        .WillOnce(DoAll(SetArgPointee<1>(chunkserver),
+            Return(true)));
+    DeleteChunksResponse response;
+    response.add_responses()->set_status(
+        CHUNK_OP_STATUS::CHUNK_OP_STATUS_SUCCESS);
+    response.add_responses()->set_status(
+        CHUNK_OP_STATUS::CHUNK_OP_STATUS_REDIRECTED);
+    EXPECT_CALL(*chunkService, DeleteChunks(_, _, _, _))
+        .WillOnce(DoAll(SetArgPointee<2>(response),
+                Invoke([](RpcController *controller,
+                          const DeleteChunksRequest *request,
+                          DeleteChunksResponse *response,
+                          Closure *done){
+                          brpc::ClosureGuard doneGuard(done);
+                    })));
+
+    int ret = client_->DeleteChunks(
+        csId, logicalPoolId, copysetId, chunkIds, sn);
+    ASSERT_EQ(kCsClientNotLeader, ret);
+}
+
 }  // namespace chunkserverclient
 }  // namespace mds
 }  // namespace curve
-
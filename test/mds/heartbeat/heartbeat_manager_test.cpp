@@ -34,6 +34,7 @@
 using ::testing::Return;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
+using ::testing::SaveArg;
 using ::testing::_;
 using ::curve::mds::topology::MockTopology;
 using ::curve::mds::topology::MockTopologyStat;
@@ -934,6 +935,214 @@ TEST_F(TestHeartbeatManager, test_patrol_copySetInfo_return_order) {
     ASSERT_EQ(TRANSFER_LEADER, response.needupdatecopysets(0).type());
     ASSERT_EQ(3, response.needupdatecopysets(0).peers_size());
 }
+
+TEST_F(TestHeartbeatManager, test_delta_heartbeat) {
+    ::curve::mds::topology::ChunkServer chunkServer1(
+        1, "hello", "", 1, "192.168.10.1", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    ::curve::mds::topology::ChunkServer chunkServer2(
+        2, "hello", "", 1, "192.168.10.2", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    ::curve::mds::topology::ChunkServer chunkServer3(
+        3, "hello", "", 1, "192.168.10.3", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    EXPECT_CALL(*topology_, GetChunkServer(1, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkServer1), Return(true)));
+    EXPECT_CALL(*topology_, GetChunkServerNotRetired("192.168.10.1", _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(chunkServer1), Return(true)));
+    EXPECT_CALL(*topology_, GetChunkServerNotRetired("192.168.10.2", _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(chunkServer2), Return(true)));
+    EXPECT_CALL(*topology_, GetChunkServerNotRetired("192.168.10.3", _, _))
+        .WillRepeatedly(DoAll(SetArgPointee<2>(chunkServer3), Return(true)));
+    EXPECT_CALL(*topology_, FindChunkServerNotRetired(_, _))
+        .WillRepeatedly(Return(1));
+    ::curve::mds::topology::CopySetInfo copySetInfo;
+    copySetInfo.SetEpoch(10);
+    copySetInfo.SetLeader(1);
+    copySetInfo.SetCopySetMembers({1, 2, 3});
+    EXPECT_CALL(*topology_, GetCopySet(_, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(copySetInfo), Return(true)));
+    ::curve::mds::topology::ChunkServerStat stat;
+    EXPECT_CALL(*topologyStat_, UpdateChunkServerStat(1, _))
+        .WillRepeatedly(SaveArg<1>(&stat));
+
+    // 1. full heartbeat with hbEpoch, view of two copysets is cached
+    auto request = GetChunkServerHeartbeatRequestForTest();
+    auto info = request.add_copysetinfos();
+    *info = request.copysetinfos(0);
+    info->set_copysetid(2);
+    request.set_hbepoch(1);
+    ChunkServerHeartbeatResponse response;
+    EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(::curve::mds::topology::UNINTIALIZE_ID));
+    heartbeatManager_->ChunkServerHeartbeat(request, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_EQ(1, response.hbepoch());
+    ASSERT_EQ(2, stat.copysetStats.size());
+
+    // 2. delta heartbeat removes copyset 2, copyset 1 is unchanged and
+    //    is checked only when there is an operator on it
+    auto deltaRequest = GetChunkServerHeartbeatRequestForTest();
+    deltaRequest.clear_copysetinfos();
+    deltaRequest.set_hbepoch(2);
+    deltaRequest.set_baseepoch(1);
+    auto removed = deltaRequest.add_removedcopysets();
+    removed->set_logicalpoolid(1);
+    removed->set_copysetid(2);
+    response.Clear();
+    EXPECT_CALL(*coordinator_, HasOperator(CopySetKey(1, 1)))
+        .WillOnce(Return(true));
+    EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+        .WillOnce(Return(::curve::mds::topology::UNINTIALIZE_ID));
+    heartbeatManager_->ChunkServerHeartbeat(deltaRequest, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_EQ(2, response.hbepoch());
+    ASSERT_EQ(1, stat.copysetStats.size());
+    ASSERT_EQ(1, stat.copysetStats[0].copysetId);
+
+    // 3. delta heartbeat based on a stale view is not accepted, and the
+    //    cached view is dropped
+    deltaRequest.set_hbepoch(3);
+    deltaRequest.set_baseepoch(1);
+    response.Clear();
+    EXPECT_CALL(*topologyStat_, UpdateChunkServerStat(1, _)).Times(0);
+    heartbeatManager_->ChunkServerHeartbeat(deltaRequest, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_FALSE(response.has_hbepoch());
+
+    deltaRequest.set_hbepoch(4);
+    deltaRequest.set_baseepoch(2);
+    response.Clear();
+    heartbeatManager_->ChunkServerHeartbeat(deltaRequest, &response);
+    ASSERT_FALSE(response.has_hbepoch());
+
+    // 4. full heartbeat without hbEpoch from old chunkserver
+    request = GetChunkServerHeartbeatRequestForTest();
+    response.Clear();
+    EXPECT_CALL(*topologyStat_, UpdateChunkServerStat(1, _)).Times(1);
+    EXPECT_CALL(*coordinator_, CopySetHeartbeat(_, _, _))
+        .WillOnce(Return(::curve::mds::topology::UNINTIALIZE_ID));
+    heartbeatManager_->ChunkServerHeartbeat(request, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_FALSE(response.has_hbepoch());
+}
+
+TEST_F(TestHeartbeatManager, test_flatten_progress) {
+    ::curve::mds::topology::ChunkServer chunkServer1(
+        1, "hello", "", 1, "192.168.10.1", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    ::curve::mds::topology::ChunkServer chunkServer2(
+        2, "hello", "", 1, "192.168.10.2", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    EXPECT_CALL(*topology_, GetChunkServer(1, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkServer1), Return(true)));
+    EXPECT_CALL(*topology_, GetChunkServer(2, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkServer2), Return(true)));
+    EXPECT_CALL(*topologyStat_, UpdateChunkServerStat(_, _))
+        .WillRepeatedly(Return());
+
+    auto request1 = GetChunkServerHeartbeatRequestForTest();
+    request1.clear_copysetinfos();
+    auto info = request1.add_flatteninfos();
+    info->set_source("/vol1");
+    info->set_clonechunknum(2);
+    info->set_remainingbytes(4096);
+    info = request1.add_flatteninfos();
+    info->set_source("/vol2");
+    info->set_clonechunknum(1);
+    info->set_remainingbytes(1024);
+    auto request2 = GetChunkServerHeartbeatRequestForTest();
+    request2.clear_copysetinfos();
+    request2.set_chunkserverid(2);
+    request2.set_ip("192.168.10.2");
+    info = request2.add_flatteninfos();
+    info->set_source("/vol1");
+    info->set_clonechunknum(3);
+    info->set_remainingbytes(8192);
+
+    // 1. progress of chunkservers is summed by source
+    ChunkServerHeartbeatResponse response;
+    heartbeatManager_->ChunkServerHeartbeat(request1, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    heartbeatManager_->ChunkServerHeartbeat(request2, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    uint64_t chunkNum = 0;
+    uint64_t remaining = 0;
+    ASSERT_TRUE(heartbeatManager_->GetFlattenProgress(
+        "/vol1", &chunkNum, &remaining));
+    ASSERT_EQ(5, chunkNum);
+    ASSERT_EQ(12288, remaining);
+    ASSERT_TRUE(heartbeatManager_->GetFlattenProgress(
+        "/vol2", &chunkNum, &remaining));
+    ASSERT_EQ(1, chunkNum);
+    ASSERT_EQ(1024, remaining);
+    ASSERT_FALSE(heartbeatManager_->GetFlattenProgress(
+        "/vol3", &chunkNum, &remaining));
+
+    // 2. a new report replaces the last one of the same chunkserver
+    request1.mutable_flatteninfos(0)->set_clonechunknum(1);
+    request1.mutable_flatteninfos(0)->set_remainingbytes(1024);
+    request1.mutable_flatteninfos()->RemoveLast();
+    heartbeatManager_->ChunkServerHeartbeat(request1, &response);
+    ASSERT_TRUE(heartbeatManager_->GetFlattenProgress(
+        "/vol1", &chunkNum, &remaining));
+    ASSERT_EQ(4, chunkNum);
+    ASSERT_EQ(9216, remaining);
+    ASSERT_FALSE(heartbeatManager_->GetFlattenProgress(
+        "/vol2", &chunkNum, &remaining));
+
+    // 3. source is removed after all chunks are flattened
+    request1.clear_flatteninfos();
+    request2.clear_flatteninfos();
+    heartbeatManager_->ChunkServerHeartbeat(request1, &response);
+    heartbeatManager_->ChunkServerHeartbeat(request2, &response);
+    ASSERT_FALSE(heartbeatManager_->GetFlattenProgress(
+        "/vol1", &chunkNum, &remaining));
+}
+
+TEST_F(TestHeartbeatManager, test_hot_chunks) {
+    ::curve::mds::topology::ChunkServer chunkServer1(
+        1, "hello", "", 1, "192.168.10.1", 9000, "",
+        ::curve::mds::topology::ChunkServerStatus::READWRITE);
+    EXPECT_CALL(*topology_, GetChunkServer(1, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkServer1), Return(true)));
+    ::curve::mds::topology::ChunkServerStat stat;
+    EXPECT_CALL(*topologyStat_, UpdateChunkServerStat(1, _))
+        .WillOnce(SaveArg<1>(&stat));
+
+    auto request = GetChunkServerHeartbeatRequestForTest();
+    request.clear_copysetinfos();
+    auto hotChunk = request.add_hotchunks();
+    hotChunk->set_fileid(10);
+    hotChunk->set_logicalpoolid(1);
+    hotChunk->set_copysetid(2);
+    hotChunk->set_chunkid(100);
+    hotChunk->set_accesscount(1000);
+    hotChunk->set_readcount(600);
+    hotChunk->set_writecount(400);
+    hotChunk = request.add_hotchunks();
+    hotChunk->set_fileid(11);
+    hotChunk->set_logicalpoolid(1);
+    hotChunk->set_copysetid(3);
+    hotChunk->set_chunkid(200);
+    hotChunk->set_accesscount(500);
+
+    ChunkServerHeartbeatResponse response;
+    heartbeatManager_->ChunkServerHeartbeat(request, &response);
+    ASSERT_EQ(HeartbeatStatusCode::hbOK, response.statuscode());
+    ASSERT_EQ(2, stat.hotChunks.size());
+    ASSERT_EQ(10, stat.hotChunks[0].fileId);
+    ASSERT_EQ(1, stat.hotChunks[0].logicalPoolId);
+    ASSERT_EQ(2, stat.hotChunks[0].copysetId);
+    ASSERT_EQ(100, stat.hotChunks[0].chunkId);
+    ASSERT_EQ(1000, stat.hotChunks[0].accessCount);
+    ASSERT_EQ(600, stat.hotChunks[0].readCount);
+    ASSERT_EQ(400, stat.hotChunks[0].writeCount);
+    ASSERT_EQ(200, stat.hotChunks[1].chunkId);
+    ASSERT_EQ(500, stat.hotChunks[1].accessCount);
+    ASSERT_EQ(0, stat.hotChunks[1].readCount);
+}
 }  // namespace heartbeat
 }  // namespace mds
 }  // namespace curve
@@ -23,6 +23,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <glog/logging.h>
+
+#include <atomic>
+#include <vector>
+
 #include "src/mds/nameserver2/clean_core.h"
 #include "test/mds/nameserver2/mock/mock_namespace_storage.h"
 #include "test/mds/mock/mock_topology.h"
@@ -34,6 +38,7 @@ using ::testing::_;
 using ::testing::Return;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
+using ::testing::Invoke;
 using curve::mds::topology::MockTopology;
 using ::curve::mds::chunkserverclient::ChunkServerClientOption;
 using ::curve::mds::chunkserverclient::MockChunkServerClient;
@@ -380,5 +385,88 @@ TEST_F(CleanCoreTest, TestCleanDiscardSegment) {
     }
 }
 
+TEST_F(CleanCoreTest, TestCleanFileParallelBatchDelete) {
+    const int kDefaultChunkSize = 16 * 1024 * 1024;
+    const int kCopysetNum = 4;
+    const int segmentNum = kMiniFileLength / DefaultSegmentSize;
+    const int chunkNum = DefaultSegmentSize / kDefaultChunkSize;
+
+    CleanCoreOption option;
+    option.deleteConcurrency = 4;
+    option.deleteBatchSize = 64;
+    option.segmentsPerRound = 4;
+    cleanCore_ = std::make_shared<CleanCore>(storage_, client_,
+                                             allocStatistic_, option);
+    client_->SetChunkServerClient(csClient_);
+
+    PageFileSegment segment;
+    segment.set_logicalpoolid(1);
+    segment.set_segmentsize(DefaultSegmentSize);
+    segment.set_chunksize(kDefaultChunkSize);
+    for (int i = 0; i < chunkNum; ++i) {
+        auto* chunk = segment.add_chunks();
+        chunk->set_copysetid(i % kCopysetNum);
+        chunk->set_chunkid(i);
+    }
+
+    EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(segmentNum)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(segment),
+                              Return(StoreStatus::OK)));
+
+    CopySetInfo copyset;
+    copyset.SetLeader(1);
+    EXPECT_CALL(*topology_, GetCopySet(_, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(copyset), Return(true)));
+
+    // chunks of a round are grouped by copyset
+    std::atomic<int> deletedChunks(0);
+    const int rounds = (segmentNum + option.segmentsPerRound - 1) /
+                       option.segmentsPerRound;
+    EXPECT_CALL(*csClient_, DeleteChunks(_, _, _, _, _))
+        .Times(rounds * kCopysetNum)
+        .WillRepeatedly(Invoke([&](ChunkServerIdType, LogicalPoolID,
+                                   CopysetID,
+                                   const std::vector<ChunkID>& chunkIds,
+                                   uint64_t) {
+            deletedChunks.fetch_add(chunkIds.size());
+            return kMdsSuccess;
+        }));
+    EXPECT_CALL(*csClient_, DeleteChunk(_, _, _, _, _))
+        .Times(0);
+
+    EXPECT_CALL(*storage_, DeleteSegment(_, _, _))
+        .Times(segmentNum)
+        .WillRepeatedly(Return(StoreStatus::OK));
+    EXPECT_CALL(*allocStatistic_, DeAllocSpace(_, _, _))
+        .Times(segmentNum);
+    EXPECT_CALL(*storage_, DeleteFile(_, _))
+        .WillOnce(Return(StoreStatus::OK));
+
+    FileInfo cleanFile;
+    cleanFile.set_length(kMiniFileLength);
+    cleanFile.set_segmentsize(DefaultSegmentSize);
+    TaskProgress progress;
+    ASSERT_EQ(StatusCode::kOK, cleanCore_->CleanFile(cleanFile, &progress));
+    ASSERT_EQ(segmentNum * chunkNum, deletedChunks.load());
+    ASSERT_EQ(100, progress.GetProgress());
+    ASSERT_EQ(TaskStatus::SUCCESS, progress.GetStatus());
+
+    // delete failed
+    EXPECT_CALL(*storage_, GetSegment(_, _, _))
+        .Times(option.segmentsPerRound)
+        .WillRepeatedly(DoAll(SetArgPointee<2>(segment),
+                              Return(StoreStatus::OK)));
+    EXPECT_CALL(*csClient_, DeleteChunks(_, _, _, _, _))
+        .WillRepeatedly(Return(kCsClientReturnFail));
+    EXPECT_CALL(*storage_, DeleteSegment(_, _, _))
+        .Times(0);
+
+    TaskProgress failedProgress;
+    ASSERT_EQ(StatusCode::kCommonFileDeleteError,
+              cleanCore_->CleanFile(cleanFile, &failedProgress));
+    ASSERT_EQ(TaskStatus::FAILED, failedProgress.GetStatus());
+}
+
 }  // namespace mds
 }  // namespace curve
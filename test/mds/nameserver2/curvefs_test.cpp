@@ -2380,6 +2380,127 @@ TEST_F(CurveFSTest, testGetOrAllocateSegment) {
     }
 }
 
+TEST_F(CurveFSTest, testGetOrAllocateSegments) {
+    FileInfo fileInfo1;
+    fileInfo1.set_filetype(FileType::INODE_DIRECTORY);
+
+    FileInfo fileInfo2;
+    fileInfo2.set_filetype(FileType::INODE_PAGEFILE);
+    fileInfo2.set_length(4 * DefaultSegmentSize);
+    fileInfo2.set_segmentsize(DefaultSegmentSize);
+
+    std::vector<offset_t> offsets{0, DefaultSegmentSize,
+                                  2 * DefaultSegmentSize};
+
+    // too many segments
+    {
+        std::vector<PageFileSegment> segments;
+        std::vector<offset_t> tooMany(kMaxBatchSegments + 1, 0);
+        ASSERT_EQ(StatusCode::kParaError,
+                  curvefs_->GetOrAllocateSegments("/user1/file2", tooMany,
+                                                  true, &segments));
+    }
+
+    // offset beyond file length
+    {
+        std::vector<PageFileSegment> segments;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+            .Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                            Return(StoreStatus::OK)))
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                            Return(StoreStatus::OK)));
+        std::vector<offset_t> beyond{0, 4 * DefaultSegmentSize};
+        ASSERT_EQ(StatusCode::kParaError,
+                  curvefs_->GetOrAllocateSegments("/user1/file2", beyond,
+                                                  true, &segments));
+    }
+
+    // get only, not allocated segments are skipped
+    {
+        std::vector<PageFileSegment> segments;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+            .Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                            Return(StoreStatus::OK)))
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                            Return(StoreStatus::OK)));
+        PageFileSegment exist;
+        exist.set_startoffset(0);
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+            .Times(3)
+            .WillOnce(DoAll(SetArgPointee<2>(exist),
+                            Return(StoreStatus::OK)))
+            .WillRepeatedly(Return(StoreStatus::KeyNotExist));
+        EXPECT_CALL(*storage_, PutSegments(_, _, _)).Times(0);
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->GetOrAllocateSegments("/user1/file2", offsets,
+                                                  false, &segments));
+        ASSERT_EQ(1, segments.size());
+        ASSERT_EQ(0, segments[0].startoffset());
+    }
+
+    // allocate not exist segments in one transaction
+    {
+        std::vector<PageFileSegment> segments;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+            .Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                            Return(StoreStatus::OK)))
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                            Return(StoreStatus::OK)));
+        PageFileSegment exist;
+        exist.set_startoffset(0);
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+            .Times(3)
+            .WillOnce(DoAll(SetArgPointee<2>(exist),
+                            Return(StoreStatus::OK)))
+            .WillRepeatedly(Return(StoreStatus::KeyNotExist));
+        PageFileSegment allocated;
+        allocated.set_logicalpoolid(1);
+        allocated.set_segmentsize(DefaultSegmentSize);
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(DoAll(SetArgPointee<4>(allocated),
+                                  Return(true)));
+        std::vector<PageFileSegment> putSegments;
+        EXPECT_CALL(*storage_, PutSegments(_, _, _))
+            .WillOnce(DoAll(SaveArg<1>(&putSegments),
+                            SetArgPointee<2>(100),
+                            Return(StoreStatus::OK)));
+        EXPECT_CALL(*allocStatistic_,
+                    AllocSpace(1, 2 * DefaultSegmentSize, 100))
+            .Times(1);
+        ASSERT_EQ(StatusCode::kOK,
+                  curvefs_->GetOrAllocateSegments("/user1/file2", offsets,
+                                                  true, &segments));
+        ASSERT_EQ(2, putSegments.size());
+        ASSERT_EQ(3, segments.size());
+    }
+
+    // put segments fail
+    {
+        std::vector<PageFileSegment> segments;
+        EXPECT_CALL(*storage_, GetFile(_, _, _))
+            .Times(2)
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo1),
+                            Return(StoreStatus::OK)))
+            .WillOnce(DoAll(SetArgPointee<2>(fileInfo2),
+                            Return(StoreStatus::OK)));
+        EXPECT_CALL(*storage_, GetSegment(_, _, _))
+            .Times(3)
+            .WillRepeatedly(Return(StoreStatus::KeyNotExist));
+        EXPECT_CALL(*mockChunkAllocator_, AllocateChunkSegment(_, _, _, _, _))
+            .Times(3)
+            .WillRepeatedly(Return(true));
+        EXPECT_CALL(*storage_, PutSegments(_, _, _))
+            .WillOnce(Return(StoreStatus::InternalError));
+        ASSERT_EQ(StatusCode::kStorageError,
+                  curvefs_->GetOrAllocateSegments("/user1/file2", offsets,
+                                                  true, &segments));
+    }
+}
+
 TEST_F(CurveFSTest, TestDeAllocateSegment) {
     const std::string filename = "/TestDeAllocateSegment";
     const uint64_t offset = 1ull * 1024 * 1024 * 1024;
@@ -389,6 +389,19 @@ class FakeNameServerStorage : public NameServerStorage {
         return StoreStatus::OK;
     }
 
+    StoreStatus PutSegments(InodeID id,
+                            const std::vector<PageFileSegment> &segments,
+                            int64_t *revision) override {
+        std::lock_guard<std::mutex> guard(lock_);
+        for (const auto& segment : segments) {
+            std::string storeKey = NameSpaceStorageCodec::EncodeSegmentStoreKey(
+                id, segment.startoffset());
+            memKvMap_.insert(std::move(std::pair<std::string, std::string>
+                (storeKey, segment.SerializeAsString())));
+        }
+        return StoreStatus::OK;
+    }
+
     StoreStatus DeleteSegment(
         InodeID id, uint64_t off, int64_t *revision) override {
         std::lock_guard<std::mutex> guard(lock_);
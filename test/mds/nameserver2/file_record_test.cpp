@@ -156,5 +156,50 @@ TEST(FileRecordManagerTest, open_file_num_test) {
     fileRecordManager.Stop();
 }
 
+TEST(FileRecordManagerTest, remove_and_readd_test) {
+    FileRecordOptions fileRecordOptions;
+    fileRecordOptions.scanIntervalTimeUs = 1 * 1000;
+    fileRecordOptions.fileRecordExpiredTimeUs = 4 * 1000;
+
+    FileRecordManager fileRecordManager;
+    fileRecordManager.Init(fileRecordOptions);
+    fileRecordManager.Start();
+
+    // 大量文件分布在不同分片
+    for (int i = 0; i < 1000; ++i) {
+        fileRecordManager.UpdateFileRecord("file" + std::to_string(i), "",
+                                           "127.0.0.1", 1234);
+    }
+    ASSERT_EQ(1000, fileRecordManager.GetOpenFileNum());
+
+    // 关闭后重新打开，之前的过期检查不影响新记录
+    fileRecordManager.RemoveFileRecord("file0", "127.0.0.1", 1234);
+    fileRecordManager.UpdateFileRecord("file0", "", "127.0.0.1", 1234);
+
+    bool running = true;
+    std::thread th([&]() {
+        while (running) {
+            fileRecordManager.UpdateFileRecord("file0", "", "127.0.0.1",
+                                               1234);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    // 除file0外都已超时
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    ASSERT_EQ(1, fileRecordManager.GetOpenFileNum());
+    std::vector<butil::EndPoint> clients;
+    ASSERT_TRUE(fileRecordManager.FindFileMountPoint("file0", &clients));
+    ASSERT_EQ(1, clients.size());
+
+    running = false;
+    th.join();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(80));
+    ASSERT_EQ(0, fileRecordManager.GetOpenFileNum());
+
+    fileRecordManager.Stop();
+}
+
 }  // namespace mds
 }  // namespace curve
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+#include "src/mds/nameserver2/namespace_meta_cache.h"
+
+namespace curve {
+namespace mds {
+
+TEST(NameSpaceMetaCacheTest, FileAndSegmentTest) {
+    NameSpaceMetaCache cache(4, 1000);
+
+    FileInfo fileInfo;
+    ASSERT_FALSE(cache.GetFile("file", &fileInfo));
+
+    fileInfo.set_id(1);
+    fileInfo.set_filename("file");
+    fileInfo.set_length(10ull << 30);
+    cache.PutFile("file", fileInfo);
+
+    FileInfo cachedFile;
+    ASSERT_TRUE(cache.GetFile("file", &cachedFile));
+    ASSERT_EQ(1, cachedFile.id());
+    ASSERT_EQ("file", cachedFile.filename());
+    ASSERT_EQ(10ull << 30, cachedFile.length());
+
+    PageFileSegment segment;
+    segment.set_startoffset(1ull << 30);
+    segment.add_chunks()->set_chunkid(1);
+    cache.PutSegment("segment", segment);
+
+    // file and segment are cached separately
+    PageFileSegment cachedSegment;
+    ASSERT_FALSE(cache.GetSegment("file", &cachedSegment));
+    ASSERT_FALSE(cache.GetFile("segment", &cachedFile));
+    ASSERT_TRUE(cache.GetSegment("segment", &cachedSegment));
+    ASSERT_EQ(1ull << 30, cachedSegment.startoffset());
+    ASSERT_EQ(1, cachedSegment.chunks_size());
+    ASSERT_EQ(2, cache.Size());
+
+    // update
+    fileInfo.set_length(20ull << 30);
+    cache.PutFile("file", fileInfo);
+    ASSERT_TRUE(cache.GetFile("file", &cachedFile));
+    ASSERT_EQ(20ull << 30, cachedFile.length());
+    ASSERT_EQ(2, cache.Size());
+
+    // remove
+    cache.Remove("file");
+    cache.Remove("segment");
+    ASSERT_FALSE(cache.GetFile("file", &cachedFile));
+    ASSERT_FALSE(cache.GetSegment("segment", &cachedSegment));
+    ASSERT_EQ(0, cache.Size());
+}
+
+TEST(NameSpaceMetaCacheTest, EvictTest) {
+    // each shard holds one file and one segment
+    NameSpaceMetaCache cache(1, 2);
+
+    FileInfo fileInfo;
+    fileInfo.set_id(1);
+    cache.PutFile("file1", fileInfo);
+    fileInfo.set_id(2);
+    cache.PutFile("file2", fileInfo);
+
+    FileInfo cachedFile;
+    ASSERT_FALSE(cache.GetFile("file1", &cachedFile));
+    ASSERT_TRUE(cache.GetFile("file2", &cachedFile));
+    ASSERT_EQ(2, cachedFile.id());
+    ASSERT_EQ(1, cache.Size());
+}
+
+}  // namespace mds
+}  // namespace curve
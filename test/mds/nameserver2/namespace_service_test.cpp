@@ -1133,6 +1133,32 @@ TEST_F(NameSpaceServiceTest, test1) {
         ASSERT_TRUE(false);
     }
 
+    // RefreshSessions case1. 请求为空
+    {
+        cntl.Reset();
+        RefreshSessionsRequest request;
+        RefreshSessionsResponse response;
+        stub.RefreshSessions(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kParaError, response.statuscode());
+    }
+
+    // RefreshSessions case2. 每个文件的结果单独返回
+    {
+        cntl.Reset();
+        RefreshSessionsRequest request;
+        RefreshSessionsResponse response;
+        request.add_requests()->CopyFrom(request15);
+        request.add_requests()->CopyFrom(request18);
+        stub.RefreshSessions(&cntl, &request, &response, NULL);
+        ASSERT_FALSE(cntl.Failed());
+        ASSERT_EQ(StatusCode::kOK, response.statuscode());
+        ASSERT_EQ(2, response.responses_size());
+        ASSERT_EQ(StatusCode::kFileNotExists,
+                  response.responses(0).statuscode());
+        ASSERT_EQ(StatusCode::kParaError, response.responses(1).statuscode());
+    }
+
     // end session test
 
     server.Stop(10);
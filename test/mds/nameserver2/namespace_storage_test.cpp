@@ -34,6 +34,7 @@ using ::testing::Return;
 using ::testing::AtLeast;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
+using ::testing::SaveArg;
 using ::testing::Matcher;
 
 namespace curve {
@@ -397,6 +398,34 @@ TEST_F(TestNameServerStorageImp, test_getSegment) {
     ASSERT_EQ(segment.chunks_size(), getSegment.chunks_size());
 }
 
+TEST_F(TestNameServerStorageImp, test_putSegments) {
+    PageFileSegment segment;
+    std::string key;
+    GetPageFileSegmentForTest(&key, &segment);
+    std::vector<PageFileSegment> segments(3, segment);
+    for (int i = 0; i < 3; ++i) {
+        segments[i].set_startoffset(i * segment.segmentsize());
+    }
+
+    // 1. put in one transaction fail
+    int64_t revision = 0;
+    EXPECT_CALL(*client_, TxnNRewithRevision(_, _))
+        .WillOnce(Return(EtcdErrCode::EtcdDeadlineExceeded));
+    EXPECT_CALL(*cache_, Put(_, _)).Times(0);
+    ASSERT_EQ(StoreStatus::InternalError,
+        storage_->PutSegments(0, segments, &revision));
+
+    // 2. put ok, all segments are cached
+    std::vector<Operation> ops;
+    EXPECT_CALL(*client_, TxnNRewithRevision(_, _))
+        .WillOnce(DoAll(SaveArg<0>(&ops), SetArgPointee<1>(10),
+                        Return(EtcdErrCode::EtcdOK)));
+    EXPECT_CALL(*cache_, Put(_, _)).Times(3);
+    ASSERT_EQ(StoreStatus::OK, storage_->PutSegments(0, segments, &revision));
+    ASSERT_EQ(3, ops.size());
+    ASSERT_EQ(10, revision);
+}
+
 TEST_F(TestNameServerStorageImp, test_deleteSegment) {
     EXPECT_CALL(*client_, DeleteRewithRevision(_, _))
         .WillOnce(Return(EtcdErrCode::EtcdOK))
@@ -573,5 +602,74 @@ TEST_F(TestNameServerStorageImp, test_ListDiscardSegment) {
     }
 }
 
+TEST_F(TestNameServerStorageImp, test_MetaCache) {
+    auto metaCache = std::make_shared<NameSpaceMetaCache>(4, 1000);
+    storage_ = std::make_shared<NameServerStorageImp>(client_, cache_,
+                                                      metaCache);
+    // serialized cache is not used any more
+    EXPECT_CALL(*cache_, Get(_, _)).Times(0);
+    EXPECT_CALL(*cache_, Put(_, _)).Times(0);
+    EXPECT_CALL(*cache_, Remove(_)).Times(0);
+
+    FileInfo fileinfo;
+    GetFileInfoForTest(&fileinfo);
+    std::string encodeFileinfo;
+    ASSERT_TRUE(NameSpaceStorageCodec::EncodeFileInfo(fileinfo,
+                                                      &encodeFileinfo));
+
+    // 1. put file, then get file from cache
+    EXPECT_CALL(*client_, Put(_, _)).WillOnce(Return(EtcdErrCode::EtcdOK));
+    ASSERT_EQ(StoreStatus::OK, storage_->PutFile(fileinfo));
+    EXPECT_CALL(*client_, Get(_, _)).Times(0);
+    FileInfo getInfo;
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo));
+    ASSERT_EQ(fileinfo.id(), getInfo.id());
+    ASSERT_EQ(fileinfo.length(), getInfo.length());
+
+    // 2. delete file, then get file from etcd
+    EXPECT_CALL(*client_, Delete(_)).WillOnce(Return(EtcdErrCode::EtcdOK));
+    ASSERT_EQ(StoreStatus::OK, storage_->DeleteFile(fileinfo.parentid(),
+                                                    fileinfo.filename()));
+    EXPECT_CALL(*client_, Get(_, _))
+        .WillOnce(Return(EtcdErrCode::EtcdKeyNotExist));
+    ASSERT_EQ(StoreStatus::KeyNotExist, storage_->GetFile(fileinfo.parentid(),
+                                                          fileinfo.filename(),
+                                                          &getInfo));
+
+    // 3. segment read from etcd is cached
+    std::string segmentKey;
+    PageFileSegment segment;
+    GetPageFileSegmentForTest(&segmentKey, &segment);
+    std::string encodeSegment;
+    ASSERT_TRUE(NameSpaceStorageCodec::EncodeSegment(segment,
+                                                     &encodeSegment));
+    EXPECT_CALL(*client_, Get(_, _))
+        .WillOnce(DoAll(SetArgPointee<1>(encodeSegment),
+                        Return(EtcdErrCode::EtcdOK)));
+    PageFileSegment getSegment;
+    ASSERT_EQ(StoreStatus::OK, storage_->GetSegment(1, 0, &getSegment));
+    getSegment.Clear();
+    ASSERT_EQ(StoreStatus::OK, storage_->GetSegment(1, 0, &getSegment));
+    ASSERT_EQ(segment.chunks_size(), getSegment.chunks_size());
+
+    // 4. warmup fills cache by a range scan
+    std::string storeKey = NameSpaceStorageCodec::EncodeFileStoreKey(
+        fileinfo.parentid(), fileinfo.filename());
+    std::vector<std::pair<std::string, std::string>> kvs{
+        {storeKey, encodeFileinfo}};
+    EXPECT_CALL(
+        *client_,
+        List(_, _,
+             Matcher<std::vector<std::pair<std::string, std::string>>*>(_)))
+        .WillOnce(DoAll(SetArgPointee<2>(kvs), Return(EtcdErrCode::EtcdOK)));
+    ASSERT_EQ(StoreStatus::OK, storage_->WarmupCache());
+    ASSERT_EQ(StoreStatus::OK, storage_->GetFile(fileinfo.parentid(),
+                                                 fileinfo.filename(),
+                                                 &getInfo));
+    ASSERT_EQ(fileinfo.id(), getInfo.id());
+}
+
 }  // namespace mds
 }  // namespace curve
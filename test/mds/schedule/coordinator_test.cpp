@@ -30,6 +30,7 @@
 using ::curve::mds::topology::MockTopology;
 using ::curve::mds::schedule::ScheduleOption;
 using ::testing::Return;
+using ::testing::AtLeast;
 using ::testing::SetArgPointee;
 using ::testing::DoAll;
 using ::testing::_;
@@ -467,6 +468,38 @@ TEST(CoordinatorTest, test_SchedulerSwitch) {
     coordinator->Stop();
 }
 
+TEST(CoordinatorTest, test_SchedulePerLogicalPool) {
+    auto topo = std::make_shared<MockTopology>();
+    auto metric = std::make_shared<ScheduleMetrics>(topo);
+    auto topoAdapter = std::make_shared<MockTopoAdapter>();
+    auto coordinator = std::make_shared<Coordinator>(topoAdapter);
+    ScheduleOption scheduleOption = GetScheduleOption();
+    scheduleOption.enableRecoverScheduler = true;
+    scheduleOption.schedulePerLogicalPool = true;
+    coordinator->InitScheduler(scheduleOption, metric);
+
+    // every logical pool is scheduled in its own thread,
+    // and never scheduled by the whole cluster scan
+    EXPECT_CALL(*topoAdapter, GetCopySetInfos()).Times(0);
+    EXPECT_CALL(*topoAdapter, GetChunkServerInfos()).Times(0);
+    EXPECT_CALL(*topoAdapter, GetLogicalpools())
+        .WillRepeatedly(Return(std::vector<PoolIdType>{1, 2}));
+    auto lpool = GetPageFileLogicalPoolForTest();
+    lpool.SetLogicalPoolAvaliableFlag(false);
+    EXPECT_CALL(*topoAdapter, GetLogicalPool(1, _))
+        .Times(AtLeast(1))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(lpool), Return(true)));
+    EXPECT_CALL(*topoAdapter, GetLogicalPool(2, _))
+        .Times(AtLeast(1))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(lpool), Return(true)));
+
+    gflags::SetCommandLineOption("enableRecoverScheduler", "true");
+    coordinator->Run();
+    ::sleep(1);
+    coordinator->Stop();
+    gflags::SetCommandLineOption("enableRecoverScheduler", "false");
+}
+
 TEST(CoordinatorTest, test_RapidLeaderSchedule) {
     auto topo = std::make_shared<MockTopology>();
     auto metric = std::make_shared<ScheduleMetrics>(topo);
@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+#include "src/mds/schedule/recoverPlanner.h"
+#include "src/mds/schedule/scheduleMetrics.h"
+#include "test/mds/mock/mock_topology.h"
+#include "test/mds/schedule/mock_topoAdapter.h"
+#include "test/mds/schedule/common.h"
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::SetArgPointee;
+using ::testing::DoAll;
+
+using ::curve::mds::topology::MockTopology;
+
+namespace curve {
+namespace mds {
+namespace schedule {
+
+const uint64_t kMiB = 1024 * 1024;
+
+class TestRecoverPlanner : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        auto topo = std::make_shared<MockTopology>();
+        metrics_ = std::make_shared<ScheduleMetrics>(topo);
+        opController_ = std::make_shared<OperatorController>(2, metrics_);
+        topoAdapter_ = std::make_shared<MockTopoAdapter>();
+
+        opt_.operatorConcurrent = 2;
+        opt_.recoverBandwidthPerDiskMBps = 40;
+        opt_.recoverBandwidthPerHostMBps = 0;
+        opt_.recoverTargetTimeSec = 0;
+    }
+
+    std::shared_ptr<RecoverPlanner> NewPlanner() {
+        return std::make_shared<RecoverPlanner>(
+            opt_, topoAdapter_, opController_);
+    }
+
+    static PeerInfo Peer(ChunkServerIdType id, ServerIdType sid) {
+        return PeerInfo(id, sid, sid, "192.168.10.1", 9000 + id);
+    }
+
+ protected:
+    ScheduleOption opt_;
+    std::shared_ptr<ScheduleMetrics> metrics_;
+    std::shared_ptr<MockTopoAdapter> topoAdapter_;
+    std::shared_ptr<OperatorController> opController_;
+};
+
+TEST_F(TestRecoverPlanner, test_disabled) {
+    opt_.recoverBandwidthPerDiskMBps = 0;
+    auto planner = NewPlanner();
+    ASSERT_FALSE(planner->Enabled());
+
+    planner->BeginRound(UNINTIALIZE_ID, {{1, 10 * kMiB}});
+    for (int i = 1; i <= 10; i++) {
+        ASSERT_TRUE(planner->Admit(CopySetKey(1, i), Peer(1, 1),
+                                   Peer(2, 2), kMiB));
+    }
+    // same copyset can not be admitted twice
+    ASSERT_FALSE(planner->Admit(CopySetKey{1, 1}, Peer(1, 1),
+                                Peer(2, 2), kMiB));
+    ASSERT_EQ(10, planner->GetFlowNum());
+    planner->EndRound();
+    ASSERT_EQ(0, metrics_->recoverPendingBytes.get_value());
+    ASSERT_EQ(10 * kMiB, metrics_->recoverInflightBytes.get_value());
+}
+
+TEST_F(TestRecoverPlanner, test_disk_bandwidth) {
+    auto planner = NewPlanner();
+    ASSERT_TRUE(planner->Enabled());
+
+    planner->BeginRound(UNINTIALIZE_ID, {{1, 4 * kMiB}});
+    // every flow is planned at 20MB/s, so one disk holds two flows
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 1}, Peer(1, 1),
+                               Peer(4, 4), kMiB));
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 2}, Peer(1, 1),
+                               Peer(5, 5), kMiB));
+    ASSERT_FALSE(planner->Admit(CopySetKey{1, 3}, Peer(1, 1),
+                                Peer(6, 6), kMiB));
+    // target is busy
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 3}, Peer(2, 2),
+                               Peer(4, 4), kMiB));
+    ASSERT_FALSE(planner->Admit(CopySetKey{1, 4}, Peer(3, 3),
+                                Peer(4, 4), kMiB));
+    ASSERT_EQ(3, planner->GetFlowNum());
+
+    // cancel releases the bandwidth
+    planner->Cancel(CopySetKey{1, 1});
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 4}, Peer(3, 3),
+                               Peer(4, 4), kMiB));
+    planner->EndRound();
+    ASSERT_EQ(kMiB, metrics_->recoverPendingBytes.get_value());
+    ASSERT_EQ(3 * kMiB, metrics_->recoverInflightBytes.get_value());
+    // three flows at 20MB/s
+    ASSERT_EQ(1, metrics_->recoverEtaSec.get_value());
+}
+
+TEST_F(TestRecoverPlanner, test_host_bandwidth) {
+    opt_.recoverBandwidthPerHostMBps = 40;
+    auto planner = NewPlanner();
+
+    planner->BeginRound(UNINTIALIZE_ID, {{1, 3 * kMiB}});
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 1}, Peer(1, 1),
+                               Peer(4, 4), kMiB));
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 2}, Peer(2, 1),
+                               Peer(5, 5), kMiB));
+    // server 1 is busy although chunkserver 3 is idle
+    ASSERT_FALSE(planner->Admit(CopySetKey{1, 3}, Peer(3, 1),
+                                Peer(6, 6), kMiB));
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 3}, Peer(3, 2),
+                               Peer(6, 6), kMiB));
+    planner->EndRound();
+}
+
+TEST_F(TestRecoverPlanner, test_target_time) {
+    // one flow at 100MB/s is enough to recover 5000MB in 100s
+    opt_.operatorConcurrent = 1;
+    opt_.recoverBandwidthPerDiskMBps = 100;
+    opt_.recoverTargetTimeSec = 100;
+    auto planner = NewPlanner();
+
+    planner->BeginRound(UNINTIALIZE_ID, {{1, 5000 * kMiB}});
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 1}, Peer(1, 1),
+                               Peer(4, 4), 16 * kMiB));
+    ASSERT_FALSE(planner->Admit(CopySetKey{1, 2}, Peer(2, 2),
+                                Peer(5, 5), 16 * kMiB));
+    planner->EndRound();
+
+    // without target time it recovers as fast as possible
+    opt_.recoverTargetTimeSec = 0;
+    planner = NewPlanner();
+    planner->BeginRound(UNINTIALIZE_ID, {{1, 5000 * kMiB}});
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 1}, Peer(1, 1),
+                               Peer(4, 4), 16 * kMiB));
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 2}, Peer(2, 2),
+                               Peer(5, 5), 16 * kMiB));
+    planner->EndRound();
+}
+
+TEST_F(TestRecoverPlanner, test_finish_flow) {
+    auto planner = NewPlanner();
+    CopySetInfo copyset = GetCopySetInfoForTest();
+
+    planner->BeginRound(1, {{1, 2 * kMiB}, {2, kMiB}});
+    ASSERT_TRUE(planner->Admit(copyset.id, Peer(1, 1), Peer(3, 3), kMiB));
+    ASSERT_TRUE(planner->Admit(CopySetKey{1, 2}, Peer(1, 1),
+                               Peer(4, 4), kMiB));
+    planner->EndRound();
+    // logical pool 2 is not scheduled in this round
+    ASSERT_EQ(0, metrics_->recoverPendingBytes.get_value());
+
+    // no operator exists, copyset 1 has the target but copyset 2 does not
+    CopySetInfo other = copyset;
+    other.id = CopySetKey{1, 2};
+    EXPECT_CALL(*topoAdapter_, GetCopySetInfo(copyset.id, _))
+        .WillOnce(DoAll(SetArgPointee<1>(copyset), Return(true)));
+    EXPECT_CALL(*topoAdapter_, GetCopySetInfo(CopySetKey{1, 2}, _))
+        .WillOnce(DoAll(SetArgPointee<1>(other), Return(true)));
+    planner->BeginRound(UNINTIALIZE_ID, {});
+    ASSERT_EQ(0, planner->GetFlowNum());
+    ASSERT_EQ(kMiB, metrics_->recoveredBytes.get_value());
+    planner->EndRound();
+    ASSERT_EQ(0, metrics_->recoverInflightBytes.get_value());
+    ASSERT_EQ(0, metrics_->recoverEtaSec.get_value());
+}
+
+}  // namespace schedule
+}  // namespace mds
+}  // namespace curve
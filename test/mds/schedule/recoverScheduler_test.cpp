@@ -333,6 +333,53 @@ TEST_F(TestRecoverSheduler, test_all_chunkServer_online_offline) {
         ASSERT_EQ(0, opController_->GetOperators().size());
     }
 }
+
+TEST_F(TestRecoverSheduler, test_schedule_logical_pool) {
+    auto testCopySetInfo = GetCopySetInfoForTest();
+    ChunkServerInfo csInfo1(testCopySetInfo.peers[0], OnlineState::OFFLINE,
+                            DiskState::DISKNORMAL, ChunkServerStatus::READWRITE,
+                            2, 100, 100, ChunkServerStatisticInfo{});
+    ChunkServerInfo csInfo2(testCopySetInfo.peers[1], OnlineState::ONLINE,
+                            DiskState::DISKNORMAL, ChunkServerStatus::READWRITE,
+                            2, 100, 100, ChunkServerStatisticInfo{});
+    ChunkServerInfo csInfo3(testCopySetInfo.peers[2], OnlineState::ONLINE,
+                            DiskState::DISKNORMAL, ChunkServerStatus::READWRITE,
+                            2, 100, 100, ChunkServerStatisticInfo{});
+    auto lpool = GetPageFileLogicalPoolForTest();
+
+    {
+        // 1. logical pool is not available
+        lpool.SetLogicalPoolAvaliableFlag(false);
+        EXPECT_CALL(*topoAdapter_, GetLogicalPool(1, _))
+            .WillOnce(DoAll(SetArgPointee<1>(lpool), Return(true)));
+        EXPECT_CALL(*topoAdapter_, GetCopySetInfosInLogicalPool(_))
+            .Times(0);
+        ASSERT_EQ(0, recoverScheduler_->ScheduleLogicalPool(1));
+        ASSERT_EQ(0, opController_->GetOperators().size());
+    }
+
+    {
+        // 2. the state of chunkservers come from the logical pool only
+        lpool.SetLogicalPoolAvaliableFlag(true);
+        EXPECT_CALL(*topoAdapter_, GetLogicalPool(1, _))
+            .WillOnce(DoAll(SetArgPointee<1>(lpool), Return(true)));
+        EXPECT_CALL(*topoAdapter_, GetChunkServersInLogicalPool(1))
+            .WillOnce(Return(std::vector<ChunkServerInfo>{
+                csInfo1, csInfo2, csInfo3}));
+        EXPECT_CALL(*topoAdapter_, GetCopySetInfosInLogicalPool(1))
+            .WillOnce(Return(std::vector<CopySetInfo>({testCopySetInfo})));
+        EXPECT_CALL(*topoAdapter_, GetCopySetInfos()).Times(0);
+        EXPECT_CALL(*topoAdapter_, GetChunkServerInfos()).Times(0);
+        EXPECT_CALL(*topoAdapter_, GetChunkServerInfo(_, _)).Times(0);
+        EXPECT_CALL(*topoAdapter_, GetStandardReplicaNumInLogicalPool(1))
+            .WillOnce(Return(2));
+        ASSERT_EQ(1, recoverScheduler_->ScheduleLogicalPool(1));
+        Operator op;
+        ASSERT_TRUE(opController_->GetOperatorById(testCopySetInfo.id, &op));
+        ASSERT_TRUE(dynamic_cast<RemovePeer *>(op.step.get()) != nullptr);
+        ASSERT_EQ(std::chrono::seconds(100), op.timeLimit);
+    }
+}
 }  // namespace schedule
 }  // namespace mds
 }  // namespace curve
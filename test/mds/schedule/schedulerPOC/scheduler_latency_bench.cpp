@@ -0,0 +1,376 @@
+/*
+ *  Copyright (c) 2020 NetEase Inc.
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+/*
+ * Project: curve
+ * Created Date: 2026-10-18
+ * Author: agent
+ */
+
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "src/common/timeutility.h"
+#include "src/mds/copyset/copyset_manager.h"
+#include "src/mds/schedule/operatorController.h"
+#include "src/mds/schedule/scheduleMetrics.h"
+#include "src/mds/schedule/scheduler.h"
+#include "src/mds/schedule/topoAdapter.h"
+#include "src/mds/topology/topology.h"
+#include "src/mds/topology/topology_service_manager.h"
+#include "src/mds/topology/topology_stat.h"
+#include "test/mds/schedule/schedulerPOC/mock_topology.h"
+
+DEFINE_uint32(sched_bench_chunkserver_num, 10000,
+              "number of chunkservers in the cluster");
+DEFINE_uint32(sched_bench_chunkserver_per_server, 20,
+              "number of chunkservers on every server");
+DEFINE_uint32(sched_bench_pool_num, 4,
+              "number of logical pools, one physical pool for each");
+DEFINE_uint32(sched_bench_copyset_per_chunkserver, 30,
+              "number of copyset replicas on every chunkserver");
+DEFINE_uint32(sched_bench_rounds, 3, "schedule rounds of each scheduler");
+
+using ::curve::common::TimeUtility;
+using ::curve::mds::copyset::CopysetManager;
+using ::curve::mds::copyset::CopysetOption;
+using ::curve::mds::topology::ChunkServerStat;
+using ::curve::mds::topology::ChunkServerStatus;
+using ::curve::mds::topology::DiskState;
+using ::curve::mds::topology::LogicalPoolType;
+using ::curve::mds::topology::OnlineState;
+using ::curve::mds::topology::TopologyImpl;
+using ::curve::mds::topology::TopologyServiceManager;
+using ::curve::mds::topology::TopologyStat;
+using ::testing::NiceMock;
+
+namespace curve {
+namespace mds {
+namespace schedule {
+
+class BenchTopologyStat : public TopologyStat {
+ public:
+    void UpdateChunkServerStat(ChunkServerIdType csId,
+                               const ChunkServerStat &stat) override {}
+
+    bool GetChunkServerStat(ChunkServerIdType csId,
+                            ChunkServerStat *stat) override {
+        auto it = leaderCount_.find(csId);
+        stat->leaderCount = it == leaderCount_.end() ? 0 : it->second;
+        return true;
+    }
+
+    bool GetChunkPoolSize(PoolIdType pId, uint64_t *chunkPoolSize) override {
+        return true;
+    }
+
+    // only written before schedulers start
+    std::map<ChunkServerIdType, uint32_t> leaderCount_;
+};
+
+class BenchTopologyServiceManager : public TopologyServiceManager {
+ public:
+    BenchTopologyServiceManager(const std::shared_ptr<Topology> &topo,
+                                const std::shared_ptr<TopologyStat> &stat)
+        : TopologyServiceManager(topo, stat, nullptr,
+              std::make_shared<CopysetManager>(CopysetOption{}), nullptr) {}
+
+    bool CreateCopysetNodeOnChunkServer(
+        ChunkServerIdType csId,
+        const std::vector<::curve::mds::topology::CopySetInfo> &cs) override {
+        return true;
+    }
+};
+
+// Measures the latency of every scheduler on a cluster with 10K
+// chunkservers, scheduling the whole cluster in one thread versus
+// scheduling every logical pool in its own thread.
+class SchedulerLatencyBench : public ::testing::Test {
+ protected:
+    void SetUp() override {
+        storage_ = std::make_shared<NiceMock<MockStorage>>();
+        ON_CALL(*storage_, StoragePhysicalPool(_)).WillByDefault(Return(true));
+        ON_CALL(*storage_, StorageLogicalPool(_)).WillByDefault(Return(true));
+        ON_CALL(*storage_, StorageZone(_)).WillByDefault(Return(true));
+        ON_CALL(*storage_, StorageServer(_)).WillByDefault(Return(true));
+        ON_CALL(*storage_, StorageChunkServer(_)).WillByDefault(Return(true));
+        ON_CALL(*storage_, StorageCopySet(_)).WillByDefault(Return(true));
+
+        topo_ = std::make_shared<TopologyImpl>(
+            std::make_shared<MockIdGenerator>(),
+            std::make_shared<MockTokenGenerator>(), storage_);
+        stat_ = std::make_shared<BenchTopologyStat>();
+        BuildTopology();
+
+        topoAdapter_ = std::make_shared<TopoAdapterImpl>(topo_,
+            std::make_shared<BenchTopologyServiceManager>(topo_, stat_),
+            stat_);
+
+        opt_.transferLeaderTimeLimitSec = 10;
+        opt_.removePeerTimeLimitSec = 100;
+        opt_.addPeerTimeLimitSec = 1000;
+        opt_.changePeerTimeLimitSec = 1000;
+        opt_.scanPeerTimeLimitSec = 100;
+        opt_.copysetSchedulerIntervalSec = 1;
+        opt_.leaderSchedulerIntervalSec = 1;
+        opt_.recoverSchedulerIntervalSec = 1;
+        opt_.replicaSchedulerIntervalSec = 1;
+        opt_.scanSchedulerIntervalSec = 1;
+        opt_.operatorConcurrent = 10;
+        opt_.copysetNumRangePercent = 0.05;
+        opt_.scatterWithRangePerent = 0.2;
+        opt_.chunkserverFailureTolerance = 3;
+        opt_.chunkserverCoolingTimeSec = 0;
+        opt_.scanStartHour = 0;
+        opt_.scanEndHour = 23;
+        opt_.scanIntervalSec = 0;
+        opt_.scanConcurrentPerPool = 10;
+        opt_.scanConcurrentPerChunkserver = 1;
+    }
+
+    void BuildTopology() {
+        uint32_t poolNum = FLAGS_sched_bench_pool_num;
+        uint32_t csPerServer = FLAGS_sched_bench_chunkserver_per_server;
+        uint32_t serverNum = FLAGS_sched_bench_chunkserver_num / csPerServer;
+        constexpr uint32_t zoneNum = 3;
+
+        for (PoolIdType pid = 1; pid <= poolNum; pid++) {
+            ASSERT_EQ(0, topo_->AddPhysicalPool(
+                PhysicalPool(pid, "pool" + std::to_string(pid), "")));
+            for (uint32_t z = 0; z < zoneNum; z++) {
+                ZoneIdType zid = (pid - 1) * zoneNum + z + 1;
+                ASSERT_EQ(0, topo_->AddZone(
+                    Zone(zid, "zone" + std::to_string(zid), pid, "")));
+            }
+        }
+
+        // servers are spread over physical pools and their zones in turn,
+        // poolZoneCs[pool][zone] are the chunkservers in that zone
+        std::map<PoolIdType, std::vector<std::vector<ChunkServerIdType>>>
+            poolZoneCs;
+        for (ServerIdType sid = 1; sid <= serverNum; sid++) {
+            PoolIdType pid = (sid - 1) % poolNum + 1;
+            uint32_t z = ((sid - 1) / poolNum) % zoneNum;
+            ZoneIdType zid = (pid - 1) * zoneNum + z + 1;
+            std::string ip = "10.0." + std::to_string(sid / 256) + "." +
+                             std::to_string(sid % 256);
+            ASSERT_EQ(0, topo_->AddServer(Server(sid, "server", ip, 0, ip, 0,
+                                                 zid, pid, "")));
+            poolZoneCs[pid].resize(zoneNum);
+            for (uint32_t j = 0; j < csPerServer; j++) {
+                ChunkServerIdType csid = (sid - 1) * csPerServer + j + 1;
+                ChunkServer cs(csid, "", "nvme", sid, ip, 8200 + j, "",
+                               ChunkServerStatus::READWRITE,
+                               OnlineState::ONLINE);
+                ChunkServerState state;
+                state.SetDiskState(DiskState::DISKNORMAL);
+                state.SetDiskCapacity(1ull << 40);
+                state.SetDiskUsed(1ull << 30);
+                cs.SetChunkServerState(state);
+                ASSERT_EQ(0, topo_->AddChunkServer(cs));
+                poolZoneCs[pid][z].push_back(csid);
+            }
+        }
+
+        // every copyset has one replica in each zone
+        std::mt19937 gen(2023);
+        for (auto &item : poolZoneCs) {
+            PoolIdType pid = item.first;
+            uint32_t csNum = 0;
+            for (auto &zoneCs : item.second) {
+                csNum += zoneCs.size();
+            }
+            uint32_t copysetNum =
+                csNum * FLAGS_sched_bench_copyset_per_chunkserver / zoneNum;
+
+            LogicalPool::RedundanceAndPlaceMentPolicy rap;
+            rap.pageFileRAP.replicaNum = zoneNum;
+            rap.pageFileRAP.zoneNum = zoneNum;
+            rap.pageFileRAP.copysetNum = copysetNum;
+            LogicalPool lpool(pid, "lpool" + std::to_string(pid), pid,
+                              LogicalPoolType::PAGEFILE, rap,
+                              LogicalPool::UserPolicy{}, 0, true, false);
+            lpool.SetScatterWidth(100);
+            ASSERT_EQ(0, topo_->AddLogicalPool(lpool));
+
+            for (CopySetIdType id = 1; id <= copysetNum; id++) {
+                std::set<ChunkServerIdType> members;
+                for (auto &zoneCs : item.second) {
+                    members.emplace(zoneCs[gen() % zoneCs.size()]);
+                }
+                ::curve::mds::topology::CopySetInfo info(pid, id);
+                info.SetCopySetMembers(members);
+                info.SetLeader(*members.begin());
+                stat_->leaderCount_[*members.begin()]++;
+                ASSERT_EQ(0, topo_->AddCopySet(info));
+            }
+            copysetNum_ += copysetNum;
+        }
+    }
+
+    std::shared_ptr<Scheduler> NewScheduler(
+        SchedulerType type,
+        const std::shared_ptr<OperatorController> &opController) {
+        switch (type) {
+            case SchedulerType::CopySetSchedulerType:
+                return std::make_shared<CopySetScheduler>(
+                    opt_, topoAdapter_, opController);
+            case SchedulerType::LeaderSchedulerType:
+                return std::make_shared<LeaderScheduler>(
+                    opt_, topoAdapter_, opController);
+            case SchedulerType::RecoverSchedulerType:
+                return std::make_shared<RecoverScheduler>(
+                    opt_, topoAdapter_, opController);
+            case SchedulerType::ReplicaSchedulerType:
+                return std::make_shared<ReplicaScheduler>(
+                    opt_, topoAdapter_, opController);
+            case SchedulerType::ScanSchedulerType:
+                return std::make_shared<ScanScheduler>(
+                    opt_, topoAdapter_, opController);
+            default:
+                return nullptr;
+        }
+    }
+
+    std::shared_ptr<OperatorController> NewOpController() {
+        return std::make_shared<OperatorController>(opt_.operatorConcurrent,
+            std::make_shared<ScheduleMetrics>(topo_));
+    }
+
+    // average latency of scheduling the whole cluster in one thread
+    uint64_t SerialScheduleUs(SchedulerType type) {
+        uint64_t totalUs = 0;
+        for (uint32_t i = 0; i < FLAGS_sched_bench_rounds; i++) {
+            auto s = NewScheduler(type, NewOpController());
+            uint64_t start = TimeUtility::GetTimeofDayUs();
+            s->Schedule();
+            totalUs += TimeUtility::GetTimeofDayUs() - start;
+        }
+        return totalUs / FLAGS_sched_bench_rounds;
+    }
+
+    // average latency of scheduling every logical pool in its own thread,
+    // *slowestPoolUs is the average latency of the slowest pool
+    uint64_t ParallelScheduleUs(SchedulerType type, uint64_t *slowestPoolUs) {
+        uint64_t totalUs = 0;
+        *slowestPoolUs = 0;
+        auto lids = topo_->GetLogicalPoolInCluster();
+        for (uint32_t i = 0; i < FLAGS_sched_bench_rounds; i++) {
+            auto s = NewScheduler(type, NewOpController());
+            std::vector<uint64_t> poolUs(lids.size(), 0);
+            std::vector<std::thread> threads;
+            uint64_t start = TimeUtility::GetTimeofDayUs();
+            for (size_t j = 0; j < lids.size(); j++) {
+                threads.emplace_back([&, j]() {
+                    uint64_t poolStart = TimeUtility::GetTimeofDayUs();
+                    s->ScheduleLogicalPool(lids[j]);
+                    poolUs[j] = TimeUtility::GetTimeofDayUs() - poolStart;
+                });
+            }
+            for (auto &t : threads) {
+                t.join();
+            }
+            totalUs += TimeUtility::GetTimeofDayUs() - start;
+            *slowestPoolUs +=
+                *std::max_element(poolUs.begin(), poolUs.end());
+        }
+        *slowestPoolUs /= FLAGS_sched_bench_rounds;
+        return totalUs / FLAGS_sched_bench_rounds;
+    }
+
+    // average latency of scheduling only one logical pool
+    uint64_t PoolScheduleUs(SchedulerType type, PoolIdType lid) {
+        uint64_t totalUs = 0;
+        for (uint32_t i = 0; i < FLAGS_sched_bench_rounds; i++) {
+            auto s = NewScheduler(type, NewOpController());
+            uint64_t start = TimeUtility::GetTimeofDayUs();
+            s->ScheduleLogicalPool(lid);
+            totalUs += TimeUtility::GetTimeofDayUs() - start;
+        }
+        return totalUs / FLAGS_sched_bench_rounds;
+    }
+
+ protected:
+    std::shared_ptr<NiceMock<MockStorage>> storage_;
+    std::shared_ptr<TopologyImpl> topo_;
+    std::shared_ptr<BenchTopologyStat> stat_;
+    std::shared_ptr<TopoAdapterImpl> topoAdapter_;
+    ScheduleOption opt_;
+    uint64_t copysetNum_ = 0;
+};
+
+TEST_F(SchedulerLatencyBench, ScheduleLatency) {
+    LOG(INFO) << "cluster has " << topo_->GetChunkServerInCluster().size()
+              << " chunkservers, " << FLAGS_sched_bench_pool_num
+              << " logical pools and " << copysetNum_ << " copysets";
+
+    const std::map<SchedulerType, std::string> types = {
+        {SchedulerType::CopySetSchedulerType, "CopySetScheduler"},
+        {SchedulerType::LeaderSchedulerType, "LeaderScheduler"},
+        {SchedulerType::RecoverSchedulerType, "RecoverScheduler"},
+        {SchedulerType::ReplicaSchedulerType, "ReplicaScheduler"},
+        {SchedulerType::ScanSchedulerType, "ScanScheduler"},
+    };
+
+    for (auto &type : types) {
+        uint64_t serialUs = SerialScheduleUs(type.first);
+        uint64_t slowestPoolUs = 0;
+        uint64_t parallelUs = ParallelScheduleUs(type.first, &slowestPoolUs);
+        LOG(INFO) << type.second << " avg latency of whole cluster: "
+                  << serialUs << "us, per logical pool in parallel: "
+                  << parallelUs << "us, slowest pool: " << slowestPoolUs
+                  << "us";
+    }
+}
+
+TEST_F(SchedulerLatencyBench, RecoverLatencyAfterChunkServerFailure) {
+    // one chunkserver of the first logical pool goes offline
+    PoolIdType lid = topo_->GetLogicalPoolInCluster().front();
+    ChunkServerIdType failed = topo_->GetChunkServerInLogicalPool(lid).front();
+    ASSERT_EQ(0, topo_->UpdateChunkServerOnlineState(
+        OnlineState::OFFLINE, failed));
+    uint32_t affected = topo_->GetCopySetsInChunkServer(failed).size();
+
+    uint64_t serialUs =
+        SerialScheduleUs(SchedulerType::RecoverSchedulerType);
+    uint64_t poolUs =
+        PoolScheduleUs(SchedulerType::RecoverSchedulerType, lid);
+    LOG(INFO) << "chunkserver " << failed << " with " << affected
+              << " copysets offline, recover decision latency of whole"
+              << " cluster: " << serialUs << "us, of logical pool " << lid
+              << ": " << poolUs << "us";
+
+    // recover operators are limited by operatorConcurrent of chunkserver
+    auto opController = NewOpController();
+    auto s = NewScheduler(SchedulerType::RecoverSchedulerType, opController);
+    ASSERT_LT(0, s->ScheduleLogicalPool(lid));
+    ASSERT_LT(0, opController->GetOperators().size());
+}
+
+}  // namespace schedule
+}  // namespace mds
+}  // namespace curve
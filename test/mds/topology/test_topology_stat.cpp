@@ -149,6 +149,31 @@ TEST_F(TestTopologyStat, TestUpdateAndGetChunkServerStat) {
     ASSERT_EQ(false, testObj_->GetChunkPoolSize(9, &chunkPoolSize));
 }
 
+TEST_F(TestTopologyStat, TestChunkPoolSizeWithReclaimableBytes) {
+    EXPECT_CALL(*topology_, GetBelongPhysicalPoolId(_, _))
+        .WillRepeatedly(DoAll(SetArgPointee<1>(2),
+                            Return(kTopoErrCodeSuccess)));
+    ChunkServerStat stat;
+    stat.chunkFilepoolSize = 10;
+    stat.chunkSizeReclaimableBytes = 4;
+    testObj_->UpdateChunkServerStat(1, stat);
+    uint64_t size = 0;
+    ASSERT_TRUE(testObj_->GetChunkPoolSize(2, &size));
+    ASSERT_EQ(14, size);
+
+    // total stays the same after trashed chunks are returned to chunkfilepool
+    stat.chunkFilepoolSize = 14;
+    stat.chunkSizeReclaimableBytes = 0;
+    testObj_->UpdateChunkServerStat(1, stat);
+    ASSERT_TRUE(testObj_->GetChunkPoolSize(2, &size));
+    ASSERT_EQ(14, size);
+
+    stat.chunkFilepoolSize = 6;
+    testObj_->UpdateChunkServerStat(1, stat);
+    ASSERT_TRUE(testObj_->GetChunkPoolSize(2, &size));
+    ASSERT_EQ(6, size);
+}
+
 }  // namespace topology
 }  // namespace mds
 }  // namespace curve
@@ -40,6 +40,7 @@ using ::testing::AllOf;
 using ::testing::SetArgPointee;
 using ::testing::Invoke;
 using ::testing::DoAll;
+using ::testing::SaveArg;
 
 class TestSnapshotCoreImpl : public ::testing::Test {
  public:
@@ -518,6 +519,182 @@ TEST_F(TestSnapshotCoreImpl,
     ASSERT_EQ(Status::done, task->GetSnapshotInfo().GetStatus());
 }
 
+TEST_F(TestSnapshotCoreImpl,
+    TestHandleCreateSnapshotTaskSkipZeroChunkSuccess) {
+    option.skipZeroChunk = true;
+    core_ = std::make_shared<SnapshotCoreImpl>(client_,
+            metaStore_,
+            dataStore_,
+            snapshotRef_,
+            option);
+    ASSERT_EQ(core_->Init(), 0);
+
+
+    UUID uuid = "uuid1";
+    std::string user = "user1";
+    std::string fileName = "file1";
+    std::string desc = "snap1";
+    uint64_t seqNum = 100;
+
+    SnapshotInfo info(uuid, user, fileName, desc);
+    info.SetStatus(Status::pending);
+
+    auto snapshotInfoMetric = std::make_shared<SnapshotInfoMetric>(uuid);
+    std::shared_ptr<SnapshotTaskInfo> task =
+        std::make_shared<SnapshotTaskInfo>(info, snapshotInfoMetric);
+
+    EXPECT_CALL(*client_, CreateSnapshot(fileName, user, _))
+        .WillOnce(DoAll(
+                    SetArgPointee<2>(seqNum),
+                    Return(LIBCURVE_ERROR::OK)));
+
+    FInfo snapInfo;
+    snapInfo.seqnum = 100;
+    snapInfo.chunksize = 2 * option.chunkSplitSize;
+    snapInfo.segmentsize = 2 * snapInfo.chunksize;
+    snapInfo.length = 2 * snapInfo.segmentsize;
+    snapInfo.ctime = 10;
+    EXPECT_CALL(*client_, GetSnapshot(fileName, user, seqNum, _))
+        .WillOnce(DoAll(
+                    SetArgPointee<3>(snapInfo),
+                    Return(LIBCURVE_ERROR::OK)));
+
+
+    EXPECT_CALL(*metaStore_, CASSnapshot(_, _))
+        .WillOnce(Return(kErrCodeSuccess));
+    EXPECT_CALL(*metaStore_, UpdateSnapshot(_))
+        .WillOnce(Return(kErrCodeSuccess));
+
+    LogicPoolID lpid1 = 1;
+    CopysetID cpid1 = 1;
+    ChunkID chunkId1 = 1;
+    LogicPoolID lpid2 = 2;
+    CopysetID cpid2 = 2;
+    ChunkID chunkId2 = 2;
+
+    SegmentInfo segInfo1;
+    segInfo1.chunkvec.push_back(
+        ChunkIDInfo(chunkId1, lpid1, cpid1));
+    segInfo1.chunkvec.push_back(
+        ChunkIDInfo(chunkId2, lpid2, cpid2));
+
+    LogicPoolID lpid3 = 3;
+    CopysetID cpid3 = 3;
+    ChunkID chunkId3 = 3;
+    LogicPoolID lpid4 = 4;
+    CopysetID cpid4 = 4;
+    ChunkID chunkId4 = 4;
+
+    SegmentInfo segInfo2;
+    segInfo2.chunkvec.push_back(
+        ChunkIDInfo(chunkId3, lpid3, cpid3));
+    segInfo2.chunkvec.push_back(
+        ChunkIDInfo(chunkId4, lpid4, cpid4));
+
+    EXPECT_CALL(*client_, GetSnapshotSegmentInfo(fileName,
+          user,
+          seqNum,
+            _,
+            _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<4>(segInfo1),
+                    Return(LIBCURVE_ERROR::OK)))
+        .WillOnce(DoAll(SetArgPointee<4>(segInfo2),
+                    Return(kErrCodeSuccess)));
+
+    uint64_t chunkSn = 100;
+    ChunkInfoDetail chunkInfo;
+    chunkInfo.chunkSn.push_back(chunkSn);
+    EXPECT_CALL(*client_, GetChunkInfo(_, _))
+        .Times(4)
+        .WillRepeatedly(DoAll(SetArgPointee<1>(chunkInfo),
+                    Return(LIBCURVE_ERROR::OK)));
+
+    // the second one removes the zero chunks from index
+    ChunkIndexData newIndexData;
+    EXPECT_CALL(*dataStore_, PutChunkIndexData(_, _))
+        .WillOnce(Return(kErrCodeSuccess))
+        .WillOnce(DoAll(SaveArg<1>(&newIndexData),
+                        Return(kErrCodeSuccess)));
+
+    UUID uuid2 = "uuid2";
+    std::string desc2 = "desc2";
+
+    std::vector<SnapshotInfo> snapInfos;
+    SnapshotInfo info2(uuid2, user, fileName, desc2);
+    info.SetSeqNum(seqNum);
+    info2.SetSeqNum(seqNum - 1);
+    info2.SetStatus(Status::done);
+    snapInfos.push_back(info);
+    snapInfos.push_back(info2);
+
+    // pending task
+    SnapshotInfo info3("uuid3", user, fileName, "snap3");
+    snapInfos.push_back(info3);
+
+    EXPECT_CALL(*metaStore_, GetSnapshotList(fileName, _))
+        .Times(2)
+        .WillRepeatedly(DoAll(
+                    SetArgPointee<1>(snapInfos),
+                    Return(kErrCodeSuccess)));
+
+    ChunkIndexData indexData;
+    indexData.PutChunkDataName(ChunkDataName(fileName, 1, 0));
+    EXPECT_CALL(*dataStore_, GetChunkIndexData(_, _))
+        .WillOnce(DoAll(
+                    SetArgPointee<1>(indexData),
+                    Return(kErrCodeSuccess)));
+
+    EXPECT_CALL(*dataStore_, DataChunkTranferInit(_, _))
+        .Times(4)
+        .WillRepeatedly(Return(kErrCodeSuccess));
+
+    EXPECT_CALL(*client_, ReadChunkSnapshot(_, _, _, _, _, _))
+        .Times(8)
+        .WillRepeatedly(DoAll(
+                    Invoke([](ChunkIDInfo cidinfo,
+                        uint64_t seq,
+                        uint64_t offset,
+                        uint64_t len,
+                        char *buf,
+                        SnapCloneClosure* scc){
+                        // only chunk 1 has data
+                        memset(buf, cidinfo.cid_ == 1 ? 'x' : 0, len);
+                        scc->SetRetCode(LIBCURVE_ERROR::OK);
+                        scc->Run();
+                        }),
+                    Return(LIBCURVE_ERROR::OK)));
+
+    EXPECT_CALL(*dataStore_, DataChunkTranferAddPart(_, _, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Return(kErrCodeSuccess));
+
+    EXPECT_CALL(*dataStore_, DataChunkTranferComplete(_, _))
+        .Times(1)
+        .WillRepeatedly(Return(kErrCodeSuccess));
+
+    EXPECT_CALL(*dataStore_, DataChunkTranferAbort(_, _))
+        .Times(3)
+        .WillRepeatedly(Return(kErrCodeSuccess));
+
+
+    EXPECT_CALL(*client_, DeleteSnapshot(fileName, user, seqNum))
+        .WillOnce(Return(LIBCURVE_ERROR::OK));
+
+    EXPECT_CALL(*client_, CheckSnapShotStatus(_, _, _, _))
+        .Times(2)
+        .WillOnce(DoAll(SetArgPointee<3>(FileStatus::Deleting),
+                        Return(LIBCURVE_ERROR::OK)))
+        .WillOnce(Return(-LIBCURVE_ERROR::NOTEXIST));
+
+    core_->HandleCreateSnapshotTask(task);
+
+    ASSERT_TRUE(task->IsFinish());
+    ASSERT_EQ(Status::done, task->GetSnapshotInfo().GetStatus());
+    ASSERT_EQ(1, newIndexData.GetAllChunkIndex().size());
+    ASSERT_EQ(0, newIndexData.GetAllChunkIndex()[0]);
+}
+
 TEST_F(TestSnapshotCoreImpl,
     TestHandleCreateSnapshotTask_CreateSnapshotFail) {
     UUID uuid = "uuid1";